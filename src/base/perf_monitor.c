@@ -244,6 +244,11 @@ PSTAT_METADATA pstat_Metadata[] = {
   /* TODO: Count and timer */
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_LK_NUM_WAITED_ON_OBJECTS, "Num_object_locks_waits"),
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_LK_NUM_WAITED_TIME_ON_OBJECTS, "Num_object_locks_time_waited_usec"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_LK_NUM_ESCALATIONS, "Num_lock_escalations"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_LK_NUM_PRESSURE_ESCALATIONS, "Num_lock_escalations_by_memory"),
+  PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_LK_ENTRY_MEMORY, "Lock_entry_memory_bytes"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_LK_NUM_WAITS_SPUN, "Num_lock_waits_ended_spinning"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_LK_NUM_WAITS_PARKED, "Num_lock_waits_parked"),
 
   /* Execution statistics for transactions */
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_TRAN_NUM_COMMITS, "Num_tran_commits"),
@@ -330,6 +335,10 @@ PSTAT_METADATA pstat_Metadata[] = {
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_VAC_NUM_TO_VACUUM_LOG_PAGES, "Num_vacuum_log_pages_to_vacuum"),
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_VAC_NUM_PREFETCH_REQUESTS_LOG_PAGES, "Num_vacuum_prefetch_requests_log_pages"),
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_VAC_NUM_PREFETCH_HITS_LOG_PAGES, "Num_vacuum_prefetch_hits_log_pages"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_VAC_NUM_VERSIONS_PRODUCED, "Num_vacuum_versions_produced"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_VAC_NUM_VERSIONS_VACUUMED, "Num_vacuum_versions_vacuumed"),
+  PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_VAC_NUM_BACKLOG_BLOCKS, "Num_vacuum_backlog_blocks"),
+  PSTAT_METADATA_INIT_SINGLE_PEEK (PSTAT_VAC_OLDEST_VISIBLE_MVCCID_LAG, "Num_vacuum_oldest_visible_mvccid_lag"),
 
   /* Track heap modify counters. */
   /* Make a complex entry for heap stats */
@@ -355,6 +364,7 @@ PSTAT_METADATA pstat_Metadata[] = {
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_HEAP_REL_TO_REL_UPDATES, "Num_heap_rel_to_rel_updates"),
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_HEAP_REL_TO_BIG_UPDATES, "Num_heap_rel_to_big_updates"),
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_HEAP_BIG_UPDATES, "Num_heap_big_updates"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_HEAP_HOT_UPDATES, "Num_heap_hot_updates"),
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_HEAP_HOME_VACUUMS, "Num_heap_home_vacuums"),
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_HEAP_BIG_VACUUMS, "Num_heap_big_vacuums"),
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_HEAP_REL_VACUUMS, "Num_heap_rel_vacuums"),
@@ -1793,6 +1803,10 @@ perfmon_server_calc_stats (UINT64 * stats)
 		    &(stats[pstat_Metadata[PSTAT_PB_LFCQ_PRV_NUM].start_offset]),
 		    &(stats[pstat_Metadata[PSTAT_PB_LFCQ_SHR_NUM].start_offset]));
 
+  vacuum_peek_stats (&(stats[pstat_Metadata[PSTAT_VAC_NUM_BACKLOG_BLOCKS].start_offset]),
+		     &(stats[pstat_Metadata[PSTAT_VAC_OLDEST_VISIBLE_MVCCID_LAG].start_offset]));
+  lock_peek_stats (&(stats[pstat_Metadata[PSTAT_LK_ENTRY_MEMORY].start_offset]));
+
   css_get_thread_stats (&stats[pstat_Metadata[PSTAT_THREAD_STATS].start_offset]);
   perfmon_peek_thread_daemon_stats (stats);
   // *INDENT-OFF*
@@ -320,6 +320,11 @@ typedef enum
   PSTAT_LK_NUM_WAITED_ON_OBJECTS,
   PSTAT_LK_NUM_WAITED_TIME_ON_OBJECTS,	/* include this to avoid client-server compat issue even if extended stats are
 					 * disabled */
+  PSTAT_LK_NUM_ESCALATIONS,
+  PSTAT_LK_NUM_PRESSURE_ESCALATIONS,
+  PSTAT_LK_ENTRY_MEMORY,
+  PSTAT_LK_NUM_WAITS_SPUN,
+  PSTAT_LK_NUM_WAITS_PARKED,
 
   /* Execution statistics for transactions */
   PSTAT_TRAN_NUM_COMMITS,
@@ -404,6 +409,10 @@ typedef enum
   PSTAT_VAC_NUM_TO_VACUUM_LOG_PAGES,
   PSTAT_VAC_NUM_PREFETCH_REQUESTS_LOG_PAGES,
   PSTAT_VAC_NUM_PREFETCH_HITS_LOG_PAGES,
+  PSTAT_VAC_NUM_VERSIONS_PRODUCED,
+  PSTAT_VAC_NUM_VERSIONS_VACUUMED,
+  PSTAT_VAC_NUM_BACKLOG_BLOCKS,
+  PSTAT_VAC_OLDEST_VISIBLE_MVCCID_LAG,
 
   /* Track heap modify counters. */
   PSTAT_HEAP_HOME_INSERTS,
@@ -428,6 +437,7 @@ typedef enum
   PSTAT_HEAP_REL_TO_REL_UPDATES,
   PSTAT_HEAP_REL_TO_BIG_UPDATES,
   PSTAT_HEAP_BIG_UPDATES,
+  PSTAT_HEAP_HOT_UPDATES,
   PSTAT_HEAP_HOME_VACUUMS,
   PSTAT_HEAP_BIG_VACUUMS,
   PSTAT_HEAP_REL_VACUUMS,
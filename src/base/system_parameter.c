@@ -413,6 +413,36 @@ static const char sysprm_ha_conf_file_name[] = "cubrid_ha.conf";
 
 #define PRM_NAME_JAVA_STORED_PROCEDURE_RESERVE_02 "java_stored_procedure_reserve_02"
 
+#define PRM_NAME_USE_RUNTIME_JOIN_FILTER "use_runtime_join_filter"
+
+#define PRM_NAME_IB_THREAD_COUNT "index_load_thread_count"
+
+#define PRM_NAME_INDEX_INSERT_BATCH_SIZE "index_insert_batch_size"
+
+#define PRM_NAME_HEAP_ZONE_MAP_MAX_RANGES "heap_zone_map_max_ranges"
+
+#define PRM_NAME_BTREE_ADAPTIVE_HASH "btree_adaptive_hash"
+
+#define PRM_NAME_INDEX_SCAN_THREAD_COUNT "index_scan_thread_count"
+
+#define PRM_NAME_INDEX_SCAN_PARALLEL_MIN_PAGES "index_scan_parallel_min_pages"
+
+#define PRM_NAME_INDEX_SCAN_PREFETCH_MIN_PAGES "index_scan_prefetch_min_pages"
+
+#define PRM_NAME_MVCC_CSN_SNAPSHOT "mvcc_csn_snapshot"
+
+#define PRM_NAME_LK_FAST_PATH "lock_fast_path"
+
+#define PRM_NAME_LK_DEADLOCK_DETECT_ON_WAIT "deadlock_detection_on_wait"
+
+#define PRM_NAME_VACUUM_HEAP_SHARD_PAGES "vacuum_heap_shard_pages"
+
+#define PRM_NAME_LK_MEMORY_BUDGET_IN_MB "lock_memory_budget_in_mbytes"
+
+#define PRM_NAME_LK_WAIT_SPIN_USECS "lock_wait_spin_usecs"
+
+#define PRM_NAME_HEAP_FREE_SPACE_MAP "heap_free_space_map"
+
 #define PRM_NAME_COMPAT_PRIMARY_KEY "compat_primary_key"
 
 #define PRM_NAME_INTL_MBS_SUPPORT "intl_mbs_support"
@@ -2289,6 +2319,84 @@ bool PRM_JAVA_STORED_PROCEDURE_RESERVE_02 = false;
 static bool prm_java_stored_procedure_reserve_02_default = false;
 static unsigned int prm_java_stored_procedure_reserve_02_flag = 0;
 
+bool PRM_USE_RUNTIME_JOIN_FILTER = true;
+static bool prm_use_runtime_join_filter_default = true;
+static unsigned int prm_use_runtime_join_filter_flag = 0;
+
+int PRM_IB_THREAD_COUNT = 0;
+static int prm_ib_thread_count_default = 0;
+static int prm_ib_thread_count_lower = 0;
+static int prm_ib_thread_count_upper = 16;
+static unsigned int prm_ib_thread_count_flag = 0;
+
+int PRM_INDEX_INSERT_BATCH_SIZE = 10000;
+static int prm_index_insert_batch_size_default = 10000;
+static int prm_index_insert_batch_size_lower = 0;
+static int prm_index_insert_batch_size_upper = 1000000;
+static unsigned int prm_index_insert_batch_size_flag = 0;
+
+int PRM_HEAP_ZONE_MAP_MAX_RANGES = 4096;
+static int prm_heap_zone_map_max_ranges_default = 4096;
+static int prm_heap_zone_map_max_ranges_lower = 0;
+static int prm_heap_zone_map_max_ranges_upper = 1048576;
+static unsigned int prm_heap_zone_map_max_ranges_flag = 0;
+
+bool PRM_BTREE_ADAPTIVE_HASH = true;
+static bool prm_btree_adaptive_hash_default = true;
+static unsigned int prm_btree_adaptive_hash_flag = 0;
+
+int PRM_INDEX_SCAN_THREAD_COUNT = 0;
+static int prm_index_scan_thread_count_default = 0;
+static int prm_index_scan_thread_count_lower = 0;
+static int prm_index_scan_thread_count_upper = 16;
+static unsigned int prm_index_scan_thread_count_flag = 0;
+
+int PRM_INDEX_SCAN_PARALLEL_MIN_PAGES = 256;
+static int prm_index_scan_parallel_min_pages_default = 256;
+static int prm_index_scan_parallel_min_pages_lower = 1;
+static int prm_index_scan_parallel_min_pages_upper = 1000000;
+static unsigned int prm_index_scan_parallel_min_pages_flag = 0;
+
+int PRM_INDEX_SCAN_PREFETCH_MIN_PAGES = 8;
+static int prm_index_scan_prefetch_min_pages_default = 8;
+static int prm_index_scan_prefetch_min_pages_lower = 0;
+static int prm_index_scan_prefetch_min_pages_upper = 10000;
+static unsigned int prm_index_scan_prefetch_min_pages_flag = 0;
+
+bool PRM_MVCC_CSN_SNAPSHOT = false;
+static bool prm_mvcc_csn_snapshot_default = false;
+static unsigned int prm_mvcc_csn_snapshot_flag = 0;
+
+bool PRM_LK_FAST_PATH = true;
+static bool prm_lk_fast_path_default = true;
+static unsigned int prm_lk_fast_path_flag = 0;
+
+bool PRM_LK_DEADLOCK_DETECT_ON_WAIT = true;
+static bool prm_lk_deadlock_detect_on_wait_default = true;
+static unsigned int prm_lk_deadlock_detect_on_wait_flag = 0;
+
+int PRM_VACUUM_HEAP_SHARD_PAGES = 256;
+static int prm_vacuum_heap_shard_pages_default = 256;
+static int prm_vacuum_heap_shard_pages_lower = 0;
+static int prm_vacuum_heap_shard_pages_upper = 65536;
+static unsigned int prm_vacuum_heap_shard_pages_flag = 0;
+
+int PRM_LK_MEMORY_BUDGET_IN_MB = 512;
+static int prm_lk_memory_budget_in_mb_default = 512;
+static int prm_lk_memory_budget_in_mb_lower = 0;
+static int prm_lk_memory_budget_in_mb_upper = 1048576;
+static unsigned int prm_lk_memory_budget_in_mb_flag = 0;
+
+int PRM_LK_WAIT_SPIN_USECS = 40;
+static int prm_lk_wait_spin_usecs_default = 40;
+static int prm_lk_wait_spin_usecs_lower = 0;
+static int prm_lk_wait_spin_usecs_upper = 10000;
+static unsigned int prm_lk_wait_spin_usecs_flag = 0;
+
+bool PRM_HEAP_FREE_SPACE_MAP = true;
+static bool prm_heap_free_space_map_default = true;
+static unsigned int prm_heap_free_space_map_flag = 0;
+
 typedef int (*DUP_PRM_FUNC) (void *, SYSPRM_DATATYPE, void *, SYSPRM_DATATYPE);
 
 static int prm_size_to_io_pages (void *out_val, SYSPRM_DATATYPE out_type, void *in_val, SYSPRM_DATATYPE in_type);
@@ -5889,6 +5997,171 @@ static SYSPRM_PARAM prm_Def[] = {
    (char *) NULL,
    (DUP_PRM_FUNC) NULL,
    (DUP_PRM_FUNC) NULL},
+  {PRM_ID_USE_RUNTIME_JOIN_FILTER,
+   PRM_NAME_USE_RUNTIME_JOIN_FILTER,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE | PRM_HIDDEN),
+   PRM_BOOLEAN,
+   &prm_use_runtime_join_filter_flag,
+   (void *) &prm_use_runtime_join_filter_default,
+   (void *) &PRM_USE_RUNTIME_JOIN_FILTER,
+   (void *) NULL, (void *) NULL,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_IB_THREAD_COUNT,
+   PRM_NAME_IB_THREAD_COUNT,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE),
+   PRM_INTEGER,
+   &prm_ib_thread_count_flag,
+   (void *) &prm_ib_thread_count_default,
+   (void *) &PRM_IB_THREAD_COUNT,
+   (void *) &prm_ib_thread_count_upper, (void *) &prm_ib_thread_count_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_INDEX_INSERT_BATCH_SIZE,
+   PRM_NAME_INDEX_INSERT_BATCH_SIZE,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE),
+   PRM_INTEGER,
+   &prm_index_insert_batch_size_flag,
+   (void *) &prm_index_insert_batch_size_default,
+   (void *) &PRM_INDEX_INSERT_BATCH_SIZE,
+   (void *) &prm_index_insert_batch_size_upper, (void *) &prm_index_insert_batch_size_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_HEAP_ZONE_MAP_MAX_RANGES,
+   PRM_NAME_HEAP_ZONE_MAP_MAX_RANGES,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE),
+   PRM_INTEGER,
+   &prm_heap_zone_map_max_ranges_flag,
+   (void *) &prm_heap_zone_map_max_ranges_default,
+   (void *) &PRM_HEAP_ZONE_MAP_MAX_RANGES,
+   (void *) &prm_heap_zone_map_max_ranges_upper, (void *) &prm_heap_zone_map_max_ranges_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_BTREE_ADAPTIVE_HASH,
+   PRM_NAME_BTREE_ADAPTIVE_HASH,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE),
+   PRM_BOOLEAN,
+   &prm_btree_adaptive_hash_flag,
+   (void *) &prm_btree_adaptive_hash_default,
+   (void *) &PRM_BTREE_ADAPTIVE_HASH,
+   (void *) NULL, (void *) NULL,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_INDEX_SCAN_THREAD_COUNT,
+   PRM_NAME_INDEX_SCAN_THREAD_COUNT,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE),
+   PRM_INTEGER,
+   &prm_index_scan_thread_count_flag,
+   (void *) &prm_index_scan_thread_count_default,
+   (void *) &PRM_INDEX_SCAN_THREAD_COUNT,
+   (void *) &prm_index_scan_thread_count_upper, (void *) &prm_index_scan_thread_count_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_INDEX_SCAN_PARALLEL_MIN_PAGES,
+   PRM_NAME_INDEX_SCAN_PARALLEL_MIN_PAGES,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE),
+   PRM_INTEGER,
+   &prm_index_scan_parallel_min_pages_flag,
+   (void *) &prm_index_scan_parallel_min_pages_default,
+   (void *) &PRM_INDEX_SCAN_PARALLEL_MIN_PAGES,
+   (void *) &prm_index_scan_parallel_min_pages_upper, (void *) &prm_index_scan_parallel_min_pages_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_INDEX_SCAN_PREFETCH_MIN_PAGES,
+   PRM_NAME_INDEX_SCAN_PREFETCH_MIN_PAGES,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE),
+   PRM_INTEGER,
+   &prm_index_scan_prefetch_min_pages_flag,
+   (void *) &prm_index_scan_prefetch_min_pages_default,
+   (void *) &PRM_INDEX_SCAN_PREFETCH_MIN_PAGES,
+   (void *) &prm_index_scan_prefetch_min_pages_upper, (void *) &prm_index_scan_prefetch_min_pages_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_MVCC_CSN_SNAPSHOT,
+   PRM_NAME_MVCC_CSN_SNAPSHOT,
+   (PRM_FOR_SERVER),
+   PRM_BOOLEAN,
+   &prm_mvcc_csn_snapshot_flag,
+   (void *) &prm_mvcc_csn_snapshot_default,
+   (void *) &PRM_MVCC_CSN_SNAPSHOT,
+   (void *) NULL, (void *) NULL,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_LK_FAST_PATH,
+   PRM_NAME_LK_FAST_PATH,
+   (PRM_FOR_SERVER),
+   PRM_BOOLEAN,
+   &prm_lk_fast_path_flag,
+   (void *) &prm_lk_fast_path_default,
+   (void *) &PRM_LK_FAST_PATH,
+   (void *) NULL, (void *) NULL,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_LK_DEADLOCK_DETECT_ON_WAIT,
+   PRM_NAME_LK_DEADLOCK_DETECT_ON_WAIT,
+   (PRM_FOR_SERVER),
+   PRM_BOOLEAN,
+   &prm_lk_deadlock_detect_on_wait_flag,
+   (void *) &prm_lk_deadlock_detect_on_wait_default,
+   (void *) &PRM_LK_DEADLOCK_DETECT_ON_WAIT,
+   (void *) NULL, (void *) NULL,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_VACUUM_HEAP_SHARD_PAGES,
+   PRM_NAME_VACUUM_HEAP_SHARD_PAGES,
+   (PRM_FOR_SERVER),
+   PRM_INTEGER,
+   &prm_vacuum_heap_shard_pages_flag,
+   (void *) &prm_vacuum_heap_shard_pages_default,
+   (void *) &PRM_VACUUM_HEAP_SHARD_PAGES,
+   (void *) &prm_vacuum_heap_shard_pages_upper, (void *) &prm_vacuum_heap_shard_pages_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_LK_MEMORY_BUDGET_IN_MB,
+   PRM_NAME_LK_MEMORY_BUDGET_IN_MB,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE),
+   PRM_INTEGER,
+   &prm_lk_memory_budget_in_mb_flag,
+   (void *) &prm_lk_memory_budget_in_mb_default,
+   (void *) &PRM_LK_MEMORY_BUDGET_IN_MB,
+   (void *) &prm_lk_memory_budget_in_mb_upper, (void *) &prm_lk_memory_budget_in_mb_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_LK_WAIT_SPIN_USECS,
+   PRM_NAME_LK_WAIT_SPIN_USECS,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE),
+   PRM_INTEGER,
+   &prm_lk_wait_spin_usecs_flag,
+   (void *) &prm_lk_wait_spin_usecs_default,
+   (void *) &PRM_LK_WAIT_SPIN_USECS,
+   (void *) &prm_lk_wait_spin_usecs_upper, (void *) &prm_lk_wait_spin_usecs_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_HEAP_FREE_SPACE_MAP,
+   PRM_NAME_HEAP_FREE_SPACE_MAP,
+   (PRM_FOR_SERVER),
+   PRM_BOOLEAN,
+   &prm_heap_free_space_map_flag,
+   (void *) &prm_heap_free_space_map_default,
+   (void *) &PRM_HEAP_FREE_SPACE_MAP,
+   (void *) NULL, (void *) NULL,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
 };
 
 #define NUM_PRM ((int)(sizeof(prm_Def)/sizeof(prm_Def[0])))
@@ -444,9 +444,24 @@ enum param_id
   PRM_ID_JAVA_STORED_PROCEDURE_JVM_OPTIONS,
   PRM_ID_JAVA_STORED_PROCEDURE_RESERVE_01,
   PRM_ID_JAVA_STORED_PROCEDURE_RESERVE_02,
+  PRM_ID_USE_RUNTIME_JOIN_FILTER,
+  PRM_ID_IB_THREAD_COUNT,
+  PRM_ID_INDEX_INSERT_BATCH_SIZE,
+  PRM_ID_HEAP_ZONE_MAP_MAX_RANGES,
+  PRM_ID_BTREE_ADAPTIVE_HASH,
+  PRM_ID_INDEX_SCAN_THREAD_COUNT,
+  PRM_ID_INDEX_SCAN_PARALLEL_MIN_PAGES,
+  PRM_ID_INDEX_SCAN_PREFETCH_MIN_PAGES,
+  PRM_ID_MVCC_CSN_SNAPSHOT,
+  PRM_ID_LK_FAST_PATH,
+  PRM_ID_LK_DEADLOCK_DETECT_ON_WAIT,
+  PRM_ID_VACUUM_HEAP_SHARD_PAGES,
+  PRM_ID_LK_MEMORY_BUDGET_IN_MB,
+  PRM_ID_LK_WAIT_SPIN_USECS,
+  PRM_ID_HEAP_FREE_SPACE_MAP,
 
   /* change PRM_LAST_ID when adding new system parameters */
-  PRM_LAST_ID = PRM_ID_JAVA_STORED_PROCEDURE_RESERVE_02
+  PRM_LAST_ID = PRM_ID_HEAP_FREE_SPACE_MAP
 };
 typedef enum param_id PARAM_ID;
 
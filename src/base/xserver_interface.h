@@ -156,6 +156,7 @@ extern void xlogtb_set_suppress_repl_on_transaction (THREAD_ENTRY * thread_p, in
 
 extern int xlogtb_reset_wait_msecs (THREAD_ENTRY * thread_p, int wait_msecs);
 extern int xlogtb_reset_isolation (THREAD_ENTRY * thread_p, TRAN_ISOLATION isolation);
+extern int xlogtb_set_read_only (THREAD_ENTRY * thread_p, bool read_only);
 
 extern LOG_LSA *log_get_final_restored_lsa (void);
 extern float log_get_db_compatibility (void);
@@ -178,6 +179,8 @@ extern BTID *xbtree_load_online_index (THREAD_ENTRY * thread_p, BTID * btid, con
 				       int func_col_id, int func_attr_index_start, int ib_thread_count);
 
 extern int xbtree_delete_index (THREAD_ENTRY * thread_p, BTID * btid);
+extern int xbtree_compact_index (THREAD_ENTRY * thread_p, BTID * btid, int *merged, int *fill_before,
+				 int *fill_after);
 extern BTREE_SEARCH xbtree_find_unique (THREAD_ENTRY * thread_p, BTID * btid, SCAN_OPERATION_TYPE scan_op_type,
 					DB_VALUE * key, OID * class_oid, OID * oid, bool is_all_class_srch);
 extern int xbtree_class_test_unique (THREAD_ENTRY * thread_p, char *buf, int buf_size);
@@ -699,6 +699,11 @@ ux_set_default_setting ()
       ux_set_lock_timeout (cas_default_lock_timeout);
     }
 
+  if (ux_get_read_only ())
+    {
+      ux_set_read_only (false, NULL);
+    }
+
   if (cas_db_sys_param[0])
     {
       db_set_system_parameters (cas_db_sys_param);
@@ -2487,6 +2492,29 @@ ux_set_lock_timeout (int lock_timeout)
   (void) tran_reset_wait_times (lock_timeout);
 }
 
+int
+ux_set_read_only (bool read_only, T_NET_BUF * net_buf)
+{
+  int err_code;
+
+  err_code = db_set_tran_read_only (read_only);
+  if (err_code < 0)
+    {
+      errors_in_transaction++;
+      err_code = ERROR_INFO_SET (err_code, DBMS_ERROR_INDICATOR);
+      NET_BUF_ERR_SET (net_buf);
+      return err_code;
+    }
+
+  return 0;
+}
+
+int
+ux_get_read_only (void)
+{
+  return db_is_tran_read_only () ? 1 : 0;
+}
+
 void
 ux_set_cas_change_mode (int mode, T_NET_BUF * net_buf)
 {
@@ -853,6 +853,16 @@ fn_get_db_parameter (SOCKET sock_fd, int argc, void **argv, T_NET_BUF * net_buf,
       net_buf_cp_int (net_buf, 0, NULL);
       net_buf_cp_int (net_buf, no_backslash_escapes, NULL);
     }
+  else if (param_name == CCI_PARAM_READ_ONLY)
+    {
+      int read_only;
+
+      read_only = ux_get_read_only ();
+      cas_log_write (0, true, "get_db_parameter read_only %d", read_only);
+
+      net_buf_cp_int (net_buf, 0, NULL);
+      net_buf_cp_int (net_buf, read_only, NULL);
+    }
   else
     {
       ERROR_INFO_SET (CAS_ER_PARAM_NAME, CAS_ERROR_INDICATOR);
@@ -945,6 +955,19 @@ fn_set_db_parameter (SOCKET sock_fd, int argc, void **argv, T_NET_BUF * net_buf,
 
       net_buf_cp_int (net_buf, 0, NULL);
     }
+  else if (param_name == CCI_PARAM_READ_ONLY)
+    {
+      int read_only;
+
+      net_arg_get_int (&read_only, argv[1]);
+
+      cas_log_write (0, true, "set_db_parameter read_only %d", read_only);
+
+      if (ux_set_read_only (read_only ? true : false, net_buf) < 0)
+	return FN_KEEP_CONN;
+
+      net_buf_cp_int (net_buf, 0, NULL);	/* res code */
+    }
   else
     {
       ERROR_INFO_SET (CAS_ER_PARAM_NAME, CAS_ERROR_INDICATOR);
@@ -1774,7 +1774,7 @@ cci_get_db_parameter (int mapped_conn_id, T_CCI_DB_PARAM param_name, void *value
     }
   reset_error_buffer (&(con_handle->err_buf));
 
-  if (param_name < CCI_PARAM_FIRST || param_name > CCI_PARAM_LAST)
+  if (!CCI_IS_USER_DB_PARAM (param_name))
     {
       error = CCI_ER_PARAM_NAME;
       goto ret;
@@ -1980,7 +1980,7 @@ cci_set_db_parameter (int mapped_conn_id, T_CCI_DB_PARAM param_name, void *value
     }
   reset_error_buffer (&(con_handle->err_buf));
 
-  if (param_name < CCI_PARAM_FIRST || param_name > CCI_PARAM_LAST)
+  if (!CCI_IS_USER_DB_PARAM (param_name))
     {
       error = CCI_ER_PARAM_NAME;
       goto ret;
@@ -5160,6 +5160,8 @@ dbg_db_param_str (T_CCI_DB_PARAM db_param)
       return "CCI_PARAM_LOCK_TIMEOUT";
     case CCI_PARAM_MAX_STRING_LENGTH:
       return "CCI_PARAM_MAX_STRING_LENGTH";
+    case CCI_PARAM_READ_ONLY:
+      return "CCI_PARAM_READ_ONLY";
     default:
       return "***";
     }
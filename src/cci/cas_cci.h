@@ -397,12 +397,16 @@ typedef enum
   CCI_PARAM_LOCK_TIMEOUT = 2,
   CCI_PARAM_MAX_STRING_LENGTH = 3,
   CCI_PARAM_AUTO_COMMIT = 4,
-  CCI_PARAM_LAST = CCI_PARAM_AUTO_COMMIT,
+  CCI_PARAM_READ_ONLY = 6,
+  CCI_PARAM_LAST = CCI_PARAM_READ_ONLY,
 
   /* below parameters are used internally */
   CCI_PARAM_NO_BACKSLASH_ESCAPES = 5
 } T_CCI_DB_PARAM;
 
+#define CCI_IS_USER_DB_PARAM(name) \
+  ((name) >= CCI_PARAM_FIRST && (name) <= CCI_PARAM_LAST && (name) != CCI_PARAM_NO_BACKSLASH_ESCAPES)
+
 typedef enum
 {
   CCI_SCH_FIRST = 1,
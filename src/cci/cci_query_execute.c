@@ -1160,6 +1160,7 @@ qe_set_db_parameter (T_CON_HANDLE * con_handle, T_CCI_DB_PARAM param_name, void
     {
     case CCI_PARAM_ISOLATION_LEVEL:
     case CCI_PARAM_LOCK_TIMEOUT:
+    case CCI_PARAM_READ_ONLY:
       {
 	int i_val;
 	i_val = *((int *) value);
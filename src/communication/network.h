@@ -241,6 +241,10 @@ enum net_server_request
   NET_SERVER_LD_INTERRUPT,
   NET_SERVER_LD_UPDATE_STATS,
 
+  NET_SERVER_BTREE_COMPACT,
+
+  NET_SERVER_LOG_SET_READ_ONLY,
+
   /*
    * This is the last entry. It is also used for the end of an
    * array of statistics information on client/server communication.
@@ -646,6 +646,10 @@ net_histo_setup_names (void)
   net_Req_buffer[NET_SERVER_LD_DESTROY].name = "NET_SERVER_LD_DESTROY";
   net_Req_buffer[NET_SERVER_LD_INTERRUPT].name = "NET_SERVER_LD_INTERRUPT";
   net_Req_buffer[NET_SERVER_LD_UPDATE_STATS].name = "NET_SERVER_LD_UPDATE_STATS";
+
+  net_Req_buffer[NET_SERVER_BTREE_COMPACT].name = "NET_SERVER_BTREE_COMPACT";
+
+  net_Req_buffer[NET_SERVER_LOG_SET_READ_ONLY].name = "NET_SERVER_LOG_SET_READ_ONLY";
 }
 
 /*
@@ -2096,6 +2096,52 @@ log_reset_isolation (TRAN_ISOLATION isolation)
 #endif /* !CS_MODE */
 }
 
+/*
+ * log_set_read_only -
+ *
+ * return: error code
+ *
+ *   read_only(in): true for read-only transactions
+ *
+ * NOTE:
+ */
+int
+log_set_read_only (bool read_only)
+{
+#if defined(CS_MODE)
+  int req_error, error_code = ER_NET_CLIENT_DATA_RECEIVE;
+  OR_ALIGNED_BUF (OR_INT_SIZE) a_request;
+  char *request;
+  OR_ALIGNED_BUF (OR_INT_SIZE) a_reply;
+  char *reply;
+
+  request = OR_ALIGNED_BUF_START (a_request);
+  reply = OR_ALIGNED_BUF_START (a_reply);
+
+  (void) or_pack_int (request, read_only ? 1 : 0);
+
+  req_error =
+    net_client_request (NET_SERVER_LOG_SET_READ_ONLY, request, OR_ALIGNED_BUF_SIZE (a_request), reply,
+			OR_ALIGNED_BUF_SIZE (a_reply), NULL, 0, NULL, 0);
+  if (!req_error)
+    {
+      or_unpack_int (reply, &error_code);
+    }
+
+  return error_code;
+#else /* CS_MODE */
+  int error_code = NO_ERROR;
+
+  THREAD_ENTRY *thread_p = enter_server ();
+
+  error_code = xlogtb_set_read_only (thread_p, read_only);
+
+  exit_server (*thread_p);
+
+  return error_code;
+#endif /* !CS_MODE */
+}
+
 /*
  * log_set_interrupt -
  *
@@ -5705,6 +5751,61 @@ btree_delete_index (BTID * btid)
 #endif /* !CS_MODE */
 }
 
+/*
+ * btree_compact_index - merge sparse leaves of an index in place
+ *
+ * return: error code
+ *
+ *   btid(in): index to compact
+ *   merged(out): number of merged leaves
+ *   fill_before(out): leaf fill factor before compaction (percent)
+ *   fill_after(out): leaf fill factor after compaction (percent)
+ */
+int
+btree_compact_index (BTID * btid, int *merged, int *fill_before, int *fill_after)
+{
+#if defined(CS_MODE)
+  int req_error, status = NO_ERROR;
+  OR_ALIGNED_BUF (OR_BTID_ALIGNED_SIZE) a_request;
+  char *request;
+  OR_ALIGNED_BUF (OR_INT_SIZE * 4) a_reply;
+  char *reply;
+  char *ptr;
+
+  request = OR_ALIGNED_BUF_START (a_request);
+  reply = OR_ALIGNED_BUF_START (a_reply);
+
+  (void) or_pack_btid (request, btid);
+
+  req_error =
+    net_client_request (NET_SERVER_BTREE_COMPACT, request, OR_ALIGNED_BUF_SIZE (a_request), reply,
+			OR_ALIGNED_BUF_SIZE (a_reply), NULL, 0, NULL, 0);
+  if (!req_error)
+    {
+      ptr = or_unpack_int (reply, &status);
+      ptr = or_unpack_int (ptr, merged);
+      ptr = or_unpack_int (ptr, fill_before);
+      ptr = or_unpack_int (ptr, fill_after);
+    }
+  else
+    {
+      status = req_error;
+    }
+
+  return status;
+#else /* CS_MODE */
+  int error;
+
+  THREAD_ENTRY *thread_p = enter_server ();
+
+  error = xbtree_compact_index (thread_p, btid, merged, fill_before, fill_after);
+
+  exit_server (*thread_p);
+
+  return error;
+#endif /* !CS_MODE */
+}
+
 /*
  * locator_log_force_nologging -
  *
@@ -7772,7 +7873,7 @@ btree_get_statistics (BTID * btid, BTREE_STATS * stat_info)
   int req_error, status = ER_FAILED;
   OR_ALIGNED_BUF (OR_BTID_ALIGNED_SIZE) a_request;
   char *request;
-  OR_ALIGNED_BUF (OR_INT_SIZE * 5) a_reply;
+  OR_ALIGNED_BUF (OR_INT_SIZE * 6) a_reply;
   char *reply;
   char *ptr;
 
@@ -7791,6 +7892,7 @@ btree_get_statistics (BTID * btid, BTREE_STATS * stat_info)
       ptr = or_unpack_int (ptr, &stat_info->pages);
       ptr = or_unpack_int (ptr, &stat_info->height);
       ptr = or_unpack_int (ptr, &stat_info->keys);
+      ptr = or_unpack_int (ptr, &stat_info->fill_factor);
 
       assert_release (stat_info->leafs > 0);
       assert_release (stat_info->pages > 0);
@@ -128,6 +128,7 @@ extern char *disk_get_remarks (VOLID volid);
 extern char *disk_get_fullname (VOLID volid, char *vol_fullname);
 extern int log_reset_wait_msecs (int wait_msecs);
 extern int log_reset_isolation (TRAN_ISOLATION isolation);
+extern int log_set_read_only (bool read_only);
 extern void log_set_interrupt (int set);
 extern int log_checkpoint (void);
 extern void log_dump_stat (FILE * outfp);
@@ -226,6 +227,7 @@ extern int btree_load_index (BTID * btid, const char *bt_name, TP_DOMAIN * key_t
 			     char *pred_stream, int pred_stream_size, char *expr_stream, int expr_stream_size,
 			     int func_col_id, int func_attr_index_start, SM_INDEX_STATUS index_status);
 extern int btree_delete_index (BTID * btid);
+extern int btree_compact_index (BTID * btid, int *merged, int *fill_before, int *fill_after);
 extern int locator_log_force_nologging (void);
 extern int locator_remove_class_from_index (OID * oid, BTID * btid, HFID * hfid);
 extern BTREE_SEARCH btree_find_unique (BTID * btid, DB_VALUE * key, OID * class_oid, OID * oid);
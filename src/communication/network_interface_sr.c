@@ -1961,6 +1961,37 @@ slogtb_reset_isolation (THREAD_ENTRY * thread_p, unsigned int rid, char *request
   css_send_data_to_client (thread_p->conn_entry, rid, reply, OR_ALIGNED_BUF_SIZE (a_reply));
 }
 
+/*
+ * slogtb_set_read_only -
+ *
+ * return:
+ *
+ *   rid(in):
+ *   request(in):
+ *   reqlen(in):
+ *
+ * NOTE:
+ */
+void
+slogtb_set_read_only (THREAD_ENTRY * thread_p, unsigned int rid, char *request, int reqlen)
+{
+  int read_only, error_code;
+  OR_ALIGNED_BUF (OR_INT_SIZE) a_reply;
+  char *reply = OR_ALIGNED_BUF_START (a_reply);
+
+  (void) or_unpack_int (request, &read_only);
+
+  error_code = xlogtb_set_read_only (thread_p, read_only != 0);
+
+  if (error_code != NO_ERROR)
+    {
+      (void) return_error_to_client (thread_p, rid);
+    }
+
+  (void) or_pack_int (reply, error_code);
+  css_send_data_to_client (thread_p->conn_entry, rid, reply, OR_ALIGNED_BUF_SIZE (a_reply));
+}
+
 /*
  * slogpb_dump_stat -
  *
@@ -3965,6 +3996,42 @@ sbtree_delete_index (THREAD_ENTRY * thread_p, unsigned int rid, char *request, i
   css_send_data_to_client (thread_p->conn_entry, rid, reply, OR_ALIGNED_BUF_SIZE (a_reply));
 }
 
+/*
+ * sbtree_compact_index -
+ *
+ * return:
+ *
+ *   rid(in):
+ *   request(in):
+ *   reqlen(in):
+ *
+ * NOTE:
+ */
+void
+sbtree_compact_index (THREAD_ENTRY * thread_p, unsigned int rid, char *request, int reqlen)
+{
+  BTID btid;
+  int error;
+  int merged = 0, fill_before = 0, fill_after = 0;
+  OR_ALIGNED_BUF (OR_INT_SIZE * 4) a_reply;
+  char *reply = OR_ALIGNED_BUF_START (a_reply);
+  char *ptr;
+
+  (void) or_unpack_btid (request, &btid);
+
+  error = xbtree_compact_index (thread_p, &btid, &merged, &fill_before, &fill_after);
+  if (error != NO_ERROR)
+    {
+      (void) return_error_to_client (thread_p, rid);
+    }
+
+  ptr = or_pack_int (reply, error);
+  ptr = or_pack_int (ptr, merged);
+  ptr = or_pack_int (ptr, fill_before);
+  ptr = or_pack_int (ptr, fill_after);
+  css_send_data_to_client (thread_p->conn_entry, rid, reply, OR_ALIGNED_BUF_SIZE (a_reply));
+}
+
 /*
  * slocator_remove_class_from_index -
  *
@@ -7174,7 +7241,7 @@ sbtree_get_statistics (THREAD_ENTRY * thread_p, unsigned int rid, char *request,
 {
   BTREE_STATS stat_info;
   int success;
-  OR_ALIGNED_BUF (OR_INT_SIZE * 5) a_reply;
+  OR_ALIGNED_BUF (OR_INT_SIZE * 6) a_reply;
   char *reply = OR_ALIGNED_BUF_START (a_reply);
   char *ptr;
 
@@ -7196,6 +7263,7 @@ sbtree_get_statistics (THREAD_ENTRY * thread_p, unsigned int rid, char *request,
   ptr = or_pack_int (ptr, stat_info.pages);
   ptr = or_pack_int (ptr, stat_info.height);
   ptr = or_pack_int (ptr, stat_info.keys);
+  ptr = or_pack_int (ptr, stat_info.fill_factor);
 
   css_send_data_to_client (thread_p->conn_entry, rid, reply, OR_ALIGNED_BUF_SIZE (a_reply));
 }
@@ -71,6 +71,7 @@ extern void slogtb_set_suppress_repl_on_transaction (THREAD_ENTRY * thread_p, un
 						     int reqlen);
 extern void slogtb_reset_wait_msecs (THREAD_ENTRY * thread_p, unsigned int rid, char *request, int reqlen);
 extern void slogtb_reset_isolation (THREAD_ENTRY * thread_p, unsigned int rid, char *request, int reqlen);
+extern void slogtb_set_read_only (THREAD_ENTRY * thread_p, unsigned int rid, char *request, int reqlen);
 extern void slogpb_dump_stat (THREAD_ENTRY * thread_p, unsigned int rid, char *request, int reqlen);
 extern void slog_find_lob_locator (THREAD_ENTRY * thread_p, unsigned int rid, char *request, int reqlen);
 extern void slog_add_lob_locator (THREAD_ENTRY * thread_p, unsigned int rid, char *request, int reqlen);
@@ -118,6 +119,7 @@ extern void sqst_update_all_statistics (THREAD_ENTRY * thread_p, unsigned int ri
 extern void sbtree_add_index (THREAD_ENTRY * thread_p, unsigned int rid, char *request, int reqlen);
 extern void sbtree_load_index (THREAD_ENTRY * thread_p, unsigned int rid, char *request, int reqlen);
 extern void sbtree_delete_index (THREAD_ENTRY * thread_p, unsigned int rid, char *request, int reqlen);
+extern void sbtree_compact_index (THREAD_ENTRY * thread_p, unsigned int rid, char *request, int reqlen);
 extern void slocator_remove_class_from_index (THREAD_ENTRY * thread_p, unsigned int rid, char *request, int reqlen);
 extern void sbtree_find_unique (THREAD_ENTRY * thread_p, unsigned int rid, char *request, int reqlen);
 extern void sbtree_find_multi_uniques (THREAD_ENTRY * thread_p, unsigned int rid, char *request, int reqlen);
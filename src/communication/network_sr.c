@@ -863,6 +863,15 @@ net_server_init (void)
   req_p->processing_function = sloaddb_update_stats;
   req_p->name = "NET_SERVER_LD_UPDATE_STATS";
 
+  req_p = &net_Requests[NET_SERVER_BTREE_COMPACT];
+  req_p->action_attribute = (CHECK_DB_MODIFICATION | IN_TRANSACTION);
+  req_p->processing_function = sbtree_compact_index;
+  req_p->name = "NET_SERVER_BTREE_COMPACT";
+
+  req_p = &net_Requests[NET_SERVER_LOG_SET_READ_ONLY];
+  req_p->processing_function = slogtb_set_read_only;
+  req_p->name = "NET_SERVER_LOG_SET_READ_ONLY";
+
   /* checksumdb replication */
   req_p = &net_Requests[NET_SERVER_CHKSUM_REPL];
   req_p->action_attribute = IN_TRANSACTION;
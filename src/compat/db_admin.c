@@ -1543,6 +1543,38 @@ db_set_isolation (DB_TRAN_ISOLATION isolation)
   return (retval);
 }
 
+/*
+ * db_set_tran_read_only() - Set the access mode for present and future client
+ *     transactions. A read-only transaction cannot modify the database. The
+ *     access mode cannot become read-only after the transaction has updated
+ *     the database.
+ *
+ * return        : error code.
+ * read_only(in) : true for READ ONLY, false for READ WRITE.
+ */
+int
+db_set_tran_read_only (bool read_only)
+{
+  int retval;
+
+  CHECK_CONNECT_MINUSONE ();
+
+  retval = tran_reset_read_only (read_only);
+  return (retval);
+}
+
+/*
+ * db_is_tran_read_only() - Is the access mode of client transactions read-only?
+ * return : true if read-only, false otherwise.
+ */
+bool
+db_is_tran_read_only (void)
+{
+  CHECK_CONNECT_FALSE ();
+
+  return tran_is_read_only ();
+}
+
 /*
  * db_get_tran_settings() - Retrieve transaction settings.
  * return : none
@@ -128,6 +128,8 @@ extern "C"
 
   extern int db_set_lock_timeout (int seconds);
   extern int db_set_isolation (DB_TRAN_ISOLATION isolation);
+  extern int db_set_tran_read_only (bool read_only);
+  extern bool db_is_tran_read_only (void);
   extern void db_synchronize_cache (void);
   extern void db_get_tran_settings (int *lock_wait, DB_TRAN_ISOLATION * tran_isolation);
 
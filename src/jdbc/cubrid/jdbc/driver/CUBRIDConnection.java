@@ -302,11 +302,34 @@ public class CUBRIDConnection implements Connection {
 
 	public synchronized void setReadOnly(boolean readOnly) throws SQLException {
 		checkIsOpen();
+
+		synchronized (u_con) {
+			if (u_con.isReadOnly() == readOnly) {
+				return;
+			}
+			if (u_con.isActive()) {
+				throw createCUBRIDException(
+						CUBRIDJDBCErrorCode.read_only_in_transaction, null);
+			}
+
+			u_con.setReadOnly(readOnly);
+			error = u_con.getRecentError();
+		}
+
+		switch (error.getErrorCode()) {
+		case UErrorCode.ER_NO_ERROR:
+			break;
+		default:
+			throw createCUBRIDException(error);
+		}
 	}
 
 	public synchronized boolean isReadOnly() throws SQLException {
 		checkIsOpen();
-		return false;
+
+		synchronized (u_con) {
+			return u_con.isReadOnly();
+		}
 	}
 
 	public synchronized void setCatalog(String catalog) throws SQLException {
@@ -83,6 +83,7 @@ public class CUBRIDJDBCErrorCode {
 	public static int lob_pos_invalid = -21139;
 	public static int lob_is_not_writable = -21140;
 	public static int request_timeout = -21141;
+	public static int read_only_in_transaction = -21142;
 
 	private static Hashtable<Integer, String> messageString;
 
@@ -172,6 +173,8 @@ public class CUBRIDJDBCErrorCode {
 			"Lob is not writable.");
 		messageString.put(new Integer(request_timeout), 
 			"Request timed out.");
+		messageString.put(new Integer(read_only_in_transaction), 
+			"Cannot change the read-only mode while a transaction is active.");
 	}
 
 	public static String getMessage(int code) {
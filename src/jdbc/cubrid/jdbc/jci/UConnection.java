@@ -115,7 +115,8 @@ public class UConnection {
 			INSERT_ELEMENT_INTO_SEQUENCE = 6, PUT_ELEMENT_ON_SEQUENCE = 7;
 	@SuppressWarnings("unused")
 	private final static int DB_PARAM_ISOLATION_LEVEL = 1,
-			DB_PARAM_LOCK_TIMEOUT = 2, DB_PARAM_AUTO_COMMIT = 4;
+			DB_PARAM_LOCK_TIMEOUT = 2, DB_PARAM_AUTO_COMMIT = 4,
+			DB_PARAM_READ_ONLY = 6;
 
 	/* end_tran constants */
 	private final static byte END_TRAN_COMMIT = 1;
@@ -197,6 +198,7 @@ public class UConnection {
 	private byte[] dbInfo;
 	private int lastIsolationLevel;
 	private int lastLockTimeout = LOCK_TIMEOUT_NOT_USED;
+	private boolean lastReadOnly = false;
 	private boolean lastAutoCommit = true;
 	String dbname = "";
 	String user = "";
@@ -1244,6 +1246,44 @@ public class UConnection {
 		}
 	}
 	
+	synchronized public void setReadOnly(boolean readOnly) {
+		errorHandler = new UError(this);
+
+		if (lastReadOnly == readOnly) {
+			return;
+		}
+
+		if (isClosed == true) {
+			errorHandler.setErrorCode(UErrorCode.ER_IS_CLOSED);
+			return;
+		}
+
+		try {
+			setBeginTime();
+			checkReconnect();
+			if (errorHandler.getErrorCode() != UErrorCode.ER_NO_ERROR)
+				return;
+
+			outBuffer.newRequest(output, UFunctionCode.SET_DB_PARAMETER);
+			outBuffer.addInt(DB_PARAM_READ_ONLY);
+			outBuffer.addInt(readOnly ? 1 : 0);
+
+			send_recv_msg();
+
+			lastReadOnly = readOnly;
+		} catch (UJciException e) {
+			logException(e);
+			e.toUError(errorHandler);
+		} catch (IOException e) {
+			logException(e);
+			errorHandler.setErrorCode(UErrorCode.ER_COMMUNICATION);
+		}
+	}
+
+	synchronized public boolean isReadOnly() {
+		return lastReadOnly;
+	}
+
 	synchronized public int setCASChangeMode(int mode) {
 		errorHandler = new UError(this);
 
@@ -1480,6 +1520,7 @@ public class UConnection {
 		cubridcon = con;
 		lastIsolationLevel = CUBRIDIsolationLevel.TRAN_UNKNOWN_ISOLATION;
 		lastLockTimeout = LOCK_TIMEOUT_NOT_USED;
+		lastReadOnly = false;
 	}
 
 	public CUBRIDConnection getCUBRIDConnection() {
@@ -1908,6 +1949,10 @@ public class UConnection {
 	    setIsolationLevel(lastIsolationLevel);
 	if (lastLockTimeout != LOCK_TIMEOUT_NOT_USED)
 	    setLockTimeout(lastLockTimeout);
+	if (lastReadOnly) {
+	    lastReadOnly = false;
+	    setReadOnly(true);
+	}
 	/*
 	 * if(!lastAutoCommit) setAutoCommit(lastAutoCommit);
 	 */
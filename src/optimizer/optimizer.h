@@ -166,6 +166,7 @@ extern bool qo_plan_skip_orderby (QO_PLAN * plan);
 extern bool qo_plan_skip_groupby (QO_PLAN * plan);
 extern bool qo_is_index_covering_scan (QO_PLAN * plan);
 extern bool qo_is_index_iss_scan (QO_PLAN * plan);
+extern bool qo_is_index_bitmap_scan (QO_PLAN * plan);
 extern bool qo_is_index_loose_scan (QO_PLAN * plan);
 extern bool qo_is_index_mro_scan (QO_PLAN * plan);
 extern bool qo_plan_multi_range_opt (QO_PLAN * plan);
@@ -176,6 +177,8 @@ extern void qo_set_cost (DB_OBJECT * target, DB_VALUE * result, DB_VALUE * plan,
  */
 extern int qo_xasl_get_num_terms (QO_XASL_INDEX_INFO * info);
 extern PT_NODE **qo_xasl_get_terms (QO_XASL_INDEX_INFO *);
+extern QO_XASL_INDEX_INFO *qo_get_xasl_bitmap_index_info (QO_ENV * env, QO_PLAN * plan, int idx);
+extern void qo_free_xasl_index_info (QO_ENV * env, QO_XASL_INDEX_INFO * info);
 extern PT_NODE *qo_check_nullable_expr (PARSER_CONTEXT * parser, PT_NODE * node, void *arg, int *continue_walk);
 extern PT_NODE *mq_optimize (PARSER_CONTEXT * parser, PT_NODE * statement);
 
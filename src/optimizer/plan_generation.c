@@ -81,7 +81,6 @@ static int is_follow_if_term (QO_TERM *);
 static int is_always_true (QO_TERM *);
 
 static QO_XASL_INDEX_INFO *qo_get_xasl_index_info (QO_ENV * env, QO_PLAN * plan);
-static void qo_free_xasl_index_info (QO_ENV * env, QO_XASL_INDEX_INFO * info);
 
 static bool qo_validate_regu_var_for_limit (REGU_VARIABLE * var_p);
 static bool qo_get_limit_from_instnum_pred (PARSER_CONTEXT * parser, PRED_EXPR * pred, REGU_PTR_LIST * lower,
@@ -2500,6 +2499,29 @@ qo_is_index_covering_scan (QO_PLAN * plan)
   return false;
 }
 
+/*
+ * qo_is_index_bitmap_scan () - check the plan info for bitmap index scan
+ *   return: true/false
+ *   plan(in): QO_PLAN
+ */
+bool
+qo_is_index_bitmap_scan (QO_PLAN * plan)
+{
+  assert (plan != NULL);
+
+  if (qo_is_iscan (plan) && plan->plan_un.scan.bitmap_n > 0)
+    {
+      assert (plan->plan_un.scan.bitmap_n >= 2);
+      assert (plan->plan_un.scan.index == plan->plan_un.scan.bitmap_index[0]);
+      assert (bitset_is_empty (&(plan->plan_un.scan.terms)));
+      assert (plan->multi_range_opt_use != PLAN_MULTI_RANGE_OPT_USE);
+
+      return true;
+    }
+
+  return false;
+}
+
 /*
  * qo_is_index_iss_scan () - check the plan info for index skip scan
  *   return: true/false
@@ -2661,6 +2683,12 @@ qo_get_xasl_index_info (QO_ENV * env, QO_PLAN * plan)
 
   assert (plan->plan_un.scan.index != NULL);
 
+  if (qo_is_index_bitmap_scan (plan))
+    {
+      /* the scan is driven by the first index; the others are fetched by qo_get_xasl_bitmap_index_info () */
+      return qo_get_xasl_bitmap_index_info (env, plan, 0);
+    }
+
   bitset_init (&multi_col_segs, env);
   bitset_init (&multi_col_range_segs, env);
   bitset_init (&index_segs, env);
@@ -2865,6 +2893,51 @@ error:
   return NULL;
 }
 
+/*
+ * qo_get_xasl_bitmap_index_info () - index information of one of the indexes
+ *				      combined by a bitmap index scan
+ *   return: QO_XASL_INDEX_INFO structure or NULL
+ *   env(in): The environment
+ *   plan(in): The bitmap index scan plan
+ *   idx(in): position of the index in the plan
+ *
+ * Note: each index contributes a single key range on its first column.
+ */
+QO_XASL_INDEX_INFO *
+qo_get_xasl_bitmap_index_info (QO_ENV * env, QO_PLAN * plan, int idx)
+{
+  QO_XASL_INDEX_INFO *index_infop;
+
+  assert (qo_is_index_bitmap_scan (plan));
+  assert (idx >= 0 && idx < plan->plan_un.scan.bitmap_n);
+
+  index_infop = (QO_XASL_INDEX_INFO *) malloc (sizeof (QO_XASL_INDEX_INFO));
+  if (index_infop == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, sizeof (QO_XASL_INDEX_INFO));
+      return NULL;
+    }
+
+  index_infop->nterms = 1;
+  index_infop->ni_entry = plan->plan_un.scan.bitmap_index[idx];
+  index_infop->need_copy_multi_range_term = -1;
+  index_infop->need_copy_to_sarg_term = false;
+
+  index_infop->term_exprs = (PT_NODE **) malloc (sizeof (PT_NODE *));
+  index_infop->multi_col_pos = (int *) malloc (sizeof (int));
+  if (index_infop->term_exprs == NULL || index_infop->multi_col_pos == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, sizeof (PT_NODE *));
+      qo_free_xasl_index_info (env, index_infop);
+      return NULL;
+    }
+
+  index_infop->term_exprs[0] = plan->plan_un.scan.bitmap_expr[idx];
+  index_infop->multi_col_pos[0] = -1;
+
+  return index_infop;
+}
+
 /*
  * qo_free_xasl_index_info () -
  *   return: void
@@ -2873,7 +2946,7 @@ error:
  *
  * Note: Free the memory occupied by the QO_XASL_INDEX_INFO
  */
-static void
+void
 qo_free_xasl_index_info (QO_ENV * env, QO_XASL_INDEX_INFO * info)
 {
   if (info)
@@ -3504,7 +3577,7 @@ qo_check_iscan_for_multi_range_opt (QO_PLAN * plan)
       return false;
     }
 
-  if (!qo_is_iscan (plan))
+  if (!qo_is_iscan (plan) || qo_is_index_bitmap_scan (plan))
     {
       return false;
     }
@@ -140,6 +140,7 @@ static void qo_plan_compute_cost (QO_PLAN *);
 static void qo_plan_compute_subquery_cost (PT_NODE *, double *, double *);
 static void qo_sscan_cost (QO_PLAN *);
 static void qo_iscan_cost (QO_PLAN *);
+static void qo_bitmap_iscan_cost (QO_PLAN *);
 static void qo_sort_cost (QO_PLAN *);
 static void qo_mjoin_cost (QO_PLAN *);
 static void qo_follow_cost (QO_PLAN *);
@@ -197,6 +198,13 @@ static int qo_generate_join_index_scan (QO_INFO *, JOIN_TYPE, QO_PLAN *, QO_INFO
 static void qo_generate_seq_scan (QO_INFO *, QO_NODE *);
 static int qo_generate_index_scan (QO_INFO *, QO_NODE *, QO_NODE_INDEX_ENTRY *, int);
 static int qo_generate_loose_index_scan (QO_INFO *, QO_NODE *, QO_NODE_INDEX_ENTRY *);
+static int qo_generate_bitmap_index_scans (QO_INFO *, QO_NODE *);
+static int qo_generate_bitmap_and_scan (QO_INFO *, QO_NODE *);
+static int qo_generate_bitmap_or_scan (QO_INFO *, QO_NODE *);
+static bool qo_is_bitmap_index_candidate (QO_NODE_INDEX_ENTRY *);
+static bool qo_is_bitmap_term (QO_TERM *);
+static int qo_get_bitmap_disjunct_seg (QO_ENV *, QO_NODE *, PT_NODE *);
+static QO_NODE_INDEX_ENTRY *qo_find_bitmap_index (QO_NODE *, int);
 static int qo_generate_sort_limit_plan (QO_ENV *, QO_INFO *, QO_PLAN *);
 static void qo_plan_add_to_free_list (QO_PLAN *, void *ignore);
 static void qo_nljoin_cost (QO_PLAN *);
@@ -224,6 +232,8 @@ static QO_PLAN *qo_join_new (QO_INFO *, JOIN_TYPE, QO_JOINMETHOD, QO_PLAN *, QO_
 static QO_PLAN *qo_sort_new (QO_PLAN *, QO_EQCLASS *, SORT_TYPE);
 static QO_PLAN *qo_seq_scan_new (QO_INFO *, QO_NODE *);
 static QO_PLAN *qo_index_scan_new (QO_INFO *, QO_NODE *, QO_NODE_INDEX_ENTRY *, QO_SCANMETHOD, BITSET *, BITSET *);
+static QO_PLAN *qo_bitmap_index_scan_new (QO_INFO *, QO_NODE *, int, QO_NODE_INDEX_ENTRY **, PT_NODE **, double *,
+					  bool);
 static int qo_has_is_not_null_term (QO_NODE * node);
 
 static bool qo_validate_index_term_notnull (QO_ENV * env, QO_INDEX_ENTRY * index_entryp);
@@ -279,6 +289,17 @@ static QO_PLAN_VTBL qo_index_scan_plan_vtbl = {
   "Index scan"
 };
 
+static QO_PLAN_VTBL qo_bitmap_index_scan_plan_vtbl = {
+  "bitmap-iscan",
+  qo_scan_fprint,
+  qo_scan_walk,
+  qo_scan_free,
+  qo_bitmap_iscan_cost,
+  qo_bitmap_iscan_cost,
+  qo_scan_info,
+  "Bitmap index scan"
+};
+
 static QO_PLAN_VTBL qo_sort_plan_vtbl = {
   "temp",
   qo_sort_fprint,
@@ -359,6 +380,7 @@ static QO_PLAN_VTBL qo_worst_plan_vtbl = {
 QO_PLAN_VTBL *all_vtbls[] = {
   &qo_seq_scan_plan_vtbl,
   &qo_index_scan_plan_vtbl,
+  &qo_bitmap_index_scan_plan_vtbl,
   &qo_sort_plan_vtbl,
   &qo_nl_join_plan_vtbl,
   &qo_idx_join_plan_vtbl,
@@ -735,6 +757,10 @@ qo_set_use_desc (QO_PLAN * plan)
   switch (plan->plan_type)
     {
     case QO_PLANTYPE_SCAN:
+      if (qo_is_index_bitmap_scan (plan))
+	{
+	  break;
+	}
       if (((qo_is_iscan (plan) || qo_is_iscan_from_groupby (plan))
 	   && plan->plan_un.scan.index->head->groupby_skip == true)
 	  || ((qo_is_iscan (plan) || qo_is_iscan_from_orderby (plan))
@@ -812,7 +838,7 @@ qo_unset_multi_range_optimization (QO_PLAN * plan, void *arg)
 static int
 qo_set_orderby_skip (QO_PLAN * plan, void *arg)
 {
-  if (qo_is_iscan (plan) || qo_is_iscan_from_orderby (plan))
+  if ((qo_is_iscan (plan) || qo_is_iscan_from_orderby (plan)) && !qo_is_index_bitmap_scan (plan))
     {
       bool yn = *((bool *) arg);
       plan->plan_un.scan.index->head->orderby_skip = yn;
@@ -1406,6 +1432,8 @@ qo_scan_new (QO_INFO * info, QO_NODE * node, QO_SCANMETHOD scan_method)
   plan->plan_un.scan.index_iss = false;
   plan->plan_un.scan.index_loose = false;
   plan->plan_un.scan.index = NULL;
+  plan->plan_un.scan.bitmap_n = 0;
+  plan->plan_un.scan.bitmap_or = false;
 
   plan->multi_range_opt_use = PLAN_MULTI_RANGE_OPT_NO;
   bitset_init (&(plan->plan_un.scan.multi_col_range_segs), info->env);
@@ -1811,6 +1839,54 @@ qo_index_scan_new (QO_INFO * info, QO_NODE * node, QO_NODE_INDEX_ENTRY * ni_entr
   return plan;
 }
 
+/*
+ * qo_bitmap_index_scan_new () - make a scan plan that combines the OID sets of several indexes
+ *   return: new plan or NULL
+ *   info(in):
+ *   node(in):
+ *   n(in): number of indexes to combine
+ *   ni_entries(in): indexes; the first one is the primary index of the scan
+ *   exprs(in): key range predicate of each index
+ *   sels(in): selectivity of each key range predicate
+ *   is_or(in): true to union the OID sets, false to intersect them
+ *
+ * Note: no term is moved out of sarged_terms; the combined OID set only
+ *       narrows the heap pages to visit and every predicate is rechecked
+ *       by the data filter.
+ */
+static QO_PLAN *
+qo_bitmap_index_scan_new (QO_INFO * info, QO_NODE * node, int n, QO_NODE_INDEX_ENTRY ** ni_entries, PT_NODE ** exprs,
+			  double *sels, bool is_or)
+{
+  QO_PLAN *plan;
+  int i;
+
+  assert (n >= 2 && n <= QO_BITMAP_MAX_INDEXES);
+
+  plan = qo_scan_new (info, node, QO_SCANMETHOD_INDEX_SCAN);
+  if (plan == NULL)
+    {
+      return NULL;
+    }
+
+  plan->vtbl = &qo_bitmap_index_scan_plan_vtbl;
+  plan->plan_un.scan.index = ni_entries[0];
+  plan->plan_un.scan.bitmap_n = n;
+  plan->plan_un.scan.bitmap_or = is_or;
+  for (i = 0; i < n; i++)
+    {
+      plan->plan_un.scan.bitmap_index[i] = ni_entries[i];
+      plan->plan_un.scan.bitmap_expr[i] = exprs[i];
+      plan->plan_un.scan.bitmap_sel[i] = sels[i];
+    }
+
+  qo_plan_compute_cost (plan);
+
+  plan = qo_top_plan_new (plan);
+
+  return plan;
+}
+
 /*
  * qo_iscan_cost () -
  *   return:
@@ -2079,6 +2155,77 @@ qo_iscan_cost (QO_PLAN * planp)
     }
 }
 
+/*
+ * qo_bitmap_iscan_cost () - cost of a bitmap index scan
+ *   return:
+ *   planp(in):
+ *
+ * Note: every index pays its own descent and leaf pages; the heap is then
+ *       read in page order, so each selected page is fetched only once.
+ */
+static void
+qo_bitmap_iscan_cost (QO_PLAN * planp)
+{
+  QO_NODE *nodep;
+  QO_ATTR_CUM_STATS *cum_statsp;
+  double sel, sel_i, height, objects, collected, opages;
+  double object_IO, index_IO;
+  int i;
+
+  nodep = planp->plan_un.scan.node;
+
+  assert (planp->plan_un.scan.bitmap_n >= 2);
+
+  sel = planp->plan_un.scan.bitmap_or ? 0.0 : 1.0;
+  index_IO = 0.0;
+  collected = 0.0;
+
+  for (i = 0; i < planp->plan_un.scan.bitmap_n; i++)
+    {
+      cum_statsp = &(planp->plan_un.scan.bitmap_index[i]->cum_stats);
+      sel_i = MIN (MAX (planp->plan_un.scan.bitmap_sel[i], 0.0), 1.0);
+
+      height = (double) cum_statsp->height - 1;
+      if (height < 0)
+	{
+	  height = 0;
+	}
+      index_IO += height + ceil (sel_i * (double) cum_statsp->leafs);
+      collected += sel_i * (double) QO_NODE_NCARD (nodep);
+
+      if (planp->plan_un.scan.bitmap_or)
+	{
+	  sel = sel + sel_i - sel * sel_i;
+	}
+      else
+	{
+	  sel *= sel_i;
+	}
+    }
+
+  /* number of objects to be selected */
+  objects = sel * (double) QO_NODE_NCARD (nodep);
+  /* total number of pages occupied by objects */
+  opages = (double) QO_NODE_TCARD (nodep);
+
+  /* pages are visited in physical order and at most once; expected number of distinct pages hit */
+  if (opages > 1.0)
+    {
+      object_IO = opages * (1.0 - pow (1.0 - 1.0 / opages, objects));
+    }
+  else
+    {
+      object_IO = opages;
+    }
+  object_IO = MAX (1.0, object_IO);
+
+  /* collecting and sorting the OID sets is paid before the first row is returned */
+  planp->fixed_cpu_cost = collected * (double) QO_CPU_WEIGHT *ISCAN_OVERHEAD_FACTOR;
+  planp->fixed_io_cost = index_IO;
+  planp->variable_cpu_cost = objects * (double) QO_CPU_WEIGHT;
+  planp->variable_io_cost = object_IO;
+}
+
 
 static void
 qo_scan_fprint (QO_PLAN * plan, FILE * f, int howfar)
@@ -2104,6 +2251,27 @@ qo_scan_fprint (QO_PLAN * plan, FILE * f, int howfar)
 
   qo_node_fprint (plan->plan_un.scan.node, f);
 
+  if (qo_is_index_bitmap_scan (plan))
+    {
+      PARSER_CONTEXT *parser = QO_ENV_PARSER (plan->info->env);
+      PT_NODE *expr, *save_or_next;
+      int i;
+
+      fprintf (f, "\n" INDENTED_TITLE_FMT, (int) howfar, ' ', "bitmap: ");
+      for (i = 0; i < plan->plan_un.scan.bitmap_n; i++)
+	{
+	  expr = plan->plan_un.scan.bitmap_expr[i];
+	  save_or_next = expr->or_next;
+	  expr->or_next = NULL;
+
+	  fprintf (f, "%s%s(%s)", (i == 0) ? "" : (plan->plan_un.scan.bitmap_or ? " OR " : " AND "),
+		   plan->plan_un.scan.bitmap_index[i]->head->constraints->name, parser_print_tree (parser, expr));
+
+	  expr->or_next = save_or_next;
+	}
+      return;
+    }
+
   if (qo_is_interesting_order_scan (plan))
     {
       fprintf (f, "\n" INDENTED_TITLE_FMT, (int) howfar, ' ', "index: ");
@@ -3718,7 +3886,7 @@ qo_plan_cmp (QO_PLAN * a, QO_PLAN * b)
 	  return PLAN_COMP_GT;
 	}
 
-      if (!qo_is_index_iss_scan (a) && !qo_is_index_loose_scan (a))
+      if (!qo_is_index_iss_scan (a) && !qo_is_index_loose_scan (a) && !qo_is_index_bitmap_scan (a))
 	{
 	  if (a->plan_un.scan.index && a->plan_un.scan.index->head->groupby_skip)
 	    {
@@ -3756,7 +3924,7 @@ qo_plan_cmp (QO_PLAN * a, QO_PLAN * b)
 	  return PLAN_COMP_LT;
 	}
 
-      if (!qo_is_index_iss_scan (b) && !qo_is_index_loose_scan (b))
+      if (!qo_is_index_iss_scan (b) && !qo_is_index_loose_scan (b) && !qo_is_index_bitmap_scan (b))
 	{
 	  if (b->plan_un.scan.index && b->plan_un.scan.index->head->groupby_skip)
 	    {
@@ -3815,7 +3983,7 @@ qo_plan_cmp (QO_PLAN * a, QO_PLAN * b)
       if (qo_is_interesting_order_scan (a) && qo_is_interesting_order_scan (b))
 	{
 	  if (!qo_is_index_iss_scan (a) && !qo_is_index_loose_scan (a) && !qo_is_index_iss_scan (b)
-	      && !qo_is_index_loose_scan (b))
+	      && !qo_is_index_loose_scan (b) && !qo_is_index_bitmap_scan (a) && !qo_is_index_bitmap_scan (b))
 	    {
 	      if (a->plan_un.scan.index->head->orderby_skip && b->plan_un.scan.index->head->groupby_skip)
 		{
@@ -3867,6 +4035,12 @@ qo_plan_cmp (QO_PLAN * a, QO_PLAN * b)
       goto cost_cmp;		/* give up */
     }
 
+  /* a bitmap index scan has no key range of its own to compare by rule */
+  if (qo_is_index_bitmap_scan (a) || qo_is_index_bitmap_scan (b))
+    {
+      goto cost_cmp;
+    }
+
   /* check multi range optimization */
   temp_res = qo_multi_range_opt_plans_cmp (a, b);
   if (temp_res == PLAN_COMP_LT)
@@ -7707,6 +7881,425 @@ qo_generate_seq_scan (QO_INFO * infop, QO_NODE * nodep)
     }
 }
 
+/*
+ * qo_is_bitmap_index_candidate () - check whether an index may contribute
+ *				     its OID set to a bitmap index scan
+ *   return: true/false
+ *   ni_entryp(in):
+ *
+ * Note: only a plain range on the first key column is used, so indexes that
+ *       change the meaning of a key range are left out.
+ */
+static bool
+qo_is_bitmap_index_candidate (QO_NODE_INDEX_ENTRY * ni_entryp)
+{
+  QO_INDEX_ENTRY *index_entryp = ni_entryp->head;
+
+  if (ni_entryp->n != 1 || index_entryp->force < 0 || index_entryp->seg_idxs[0] == -1)
+    {
+      return false;
+    }
+
+  if (index_entryp->constraints->filter_predicate != NULL || index_entryp->constraints->func_index_info != NULL
+      || qo_is_prefix_index (index_entryp) || index_entryp->key_limit != NULL)
+    {
+      return false;
+    }
+
+  return true;
+}
+
+/*
+ * qo_is_bitmap_term () - check whether a sarg term can be the key range of
+ *			  one index of a bitmap AND scan
+ *   return: true/false
+ *   termp(in):
+ */
+static bool
+qo_is_bitmap_term (QO_TERM * termp)
+{
+  PT_NODE *expr = QO_TERM_PT_EXPR (termp);
+
+  if (QO_TERM_CLASS (termp) != QO_TC_SARG || QO_TERM_IS_FLAGED (termp, QO_TERM_NON_IDX_SARG_COLL)
+      || QO_TERM_IS_FLAGED (termp, QO_TERM_MULTI_COLL_PRED) || !bitset_is_empty (&(QO_TERM_SUBQUERIES (termp)))
+      || bitset_cardinality (&(QO_TERM_SEGS (termp))) != 1)
+    {
+      return false;
+    }
+
+  if (expr == NULL || expr->node_type != PT_EXPR || expr->or_next != NULL)
+    {
+      return false;
+    }
+
+  switch (expr->info.expr.op)
+    {
+    case PT_EQ:
+    case PT_GT:
+    case PT_GE:
+    case PT_LT:
+    case PT_LE:
+    case PT_BETWEEN:
+    case PT_IS_IN:
+    case PT_EQ_SOME:
+    case PT_RANGE:
+      return true;
+
+    default:
+      return false;
+    }
+}
+
+/*
+ * qo_get_bitmap_disjunct_seg () - find the segment a disjunct of an OR term
+ *				   ranges over
+ *   return: segment index or -1 if the disjunct is not a simple key range
+ *   env(in):
+ *   nodep(in):
+ *   expr(in): one disjunct
+ */
+static int
+qo_get_bitmap_disjunct_seg (QO_ENV * env, QO_NODE * nodep, PT_NODE * expr)
+{
+  PT_NODE *arg1, *arg2, *name = NULL;
+  QO_SEGMENT *segp;
+
+  if (expr == NULL || expr->node_type != PT_EXPR)
+    {
+      return -1;
+    }
+
+  arg1 = expr->info.expr.arg1;
+  arg2 = expr->info.expr.arg2;
+
+  switch (expr->info.expr.op)
+    {
+    case PT_EQ:
+    case PT_GT:
+    case PT_GE:
+    case PT_LT:
+    case PT_LE:
+      if (PT_IS_NAME_NODE (arg1) && arg2 != NULL && (PT_IS_VALUE_NODE (arg2) || PT_IS_HOSTVAR (arg2)))
+	{
+	  name = arg1;
+	}
+      else if (PT_IS_NAME_NODE (arg2) && arg1 != NULL && (PT_IS_VALUE_NODE (arg1) || PT_IS_HOSTVAR (arg1)))
+	{
+	  name = arg2;
+	}
+      break;
+
+    case PT_BETWEEN:
+      if (PT_IS_NAME_NODE (arg1) && arg2 != NULL && arg2->node_type == PT_EXPR
+	  && arg2->info.expr.op == PT_BETWEEN_AND && arg2->info.expr.arg1 != NULL && arg2->info.expr.arg2 != NULL
+	  && (PT_IS_VALUE_NODE (arg2->info.expr.arg1) || PT_IS_HOSTVAR (arg2->info.expr.arg1))
+	  && (PT_IS_VALUE_NODE (arg2->info.expr.arg2) || PT_IS_HOSTVAR (arg2->info.expr.arg2)))
+	{
+	  name = arg1;
+	}
+      break;
+
+    case PT_IS_IN:
+    case PT_EQ_SOME:
+      if (PT_IS_NAME_NODE (arg1) && arg2 != NULL && PT_IS_VALUE_NODE (arg2))
+	{
+	  name = arg1;
+	}
+      break;
+
+    case PT_RANGE:
+      if (PT_IS_NAME_NODE (arg1) && arg2 != NULL)
+	{
+	  PT_NODE *range;
+
+	  for (range = arg2; range != NULL; range = range->or_next)
+	    {
+	      if (range->node_type != PT_EXPR
+		  || (range->info.expr.arg1 != NULL && !PT_IS_VALUE_NODE (range->info.expr.arg1)
+		      && !PT_IS_HOSTVAR (range->info.expr.arg1))
+		  || (range->info.expr.arg2 != NULL && !PT_IS_VALUE_NODE (range->info.expr.arg2)
+		      && !PT_IS_HOSTVAR (range->info.expr.arg2)))
+		{
+		  break;
+		}
+	    }
+	  if (range == NULL)
+	    {
+	      name = arg1;
+	    }
+	}
+      break;
+
+    default:
+      break;
+    }
+
+  if (name == NULL || name->info.name.spec_id != QO_NODE_ENTITY_SPEC (nodep)->info.spec.id)
+    {
+      return -1;
+    }
+
+  segp = lookup_seg (nodep, name, env);
+
+  return (segp != NULL) ? QO_SEG_IDX (segp) : -1;
+}
+
+/*
+ * qo_find_bitmap_index () - find the narrowest candidate index whose first
+ *			     key column is the given segment
+ *   return: node index entry or NULL
+ *   nodep(in):
+ *   seg_idx(in):
+ */
+static QO_NODE_INDEX_ENTRY *
+qo_find_bitmap_index (QO_NODE * nodep, int seg_idx)
+{
+  QO_NODE_INDEX *node_indexp = QO_NODE_INDEXES (nodep);
+  QO_NODE_INDEX_ENTRY *ni_entryp, *found = NULL;
+  int i;
+
+  for (i = 0; i < QO_NI_N (node_indexp); i++)
+    {
+      ni_entryp = QO_NI_ENTRY (node_indexp, i);
+      if (!qo_is_bitmap_index_candidate (ni_entryp) || ni_entryp->head->seg_idxs[0] != seg_idx)
+	{
+	  continue;
+	}
+
+      if (found == NULL || ni_entryp->head->col_num < found->head->col_num)
+	{
+	  found = ni_entryp;
+	}
+    }
+
+  return found;
+}
+
+/*
+ * qo_generate_bitmap_and_scan () - generate a bitmap scan intersecting the
+ *				    OID sets of the most selective indexes
+ *   return: num of plans kept
+ *   infop(in):
+ *   nodep(in):
+ */
+static int
+qo_generate_bitmap_and_scan (QO_INFO * infop, QO_NODE * nodep)
+{
+  QO_ENV *env = infop->env;
+  QO_NODE_INDEX *node_indexp = QO_NODE_INDEXES (nodep);
+  QO_NODE_INDEX_ENTRY *ni_entryp;
+  QO_NODE_INDEX_ENTRY *ni_entries[QO_BITMAP_MAX_INDEXES];
+  PT_NODE *exprs[QO_BITMAP_MAX_INDEXES];
+  double sels[QO_BITMAP_MAX_INDEXES];
+  int first_segs[QO_BITMAP_MAX_INDEXES];
+  QO_INDEX_ENTRY *index_entryp;
+  QO_TERM *termp, *best_termp;
+  BITSET first_col_terms;
+  BITSET_ITERATOR iter;
+  double sel;
+  int i, j, k, t, n = 0;
+
+  bitset_init (&first_col_terms, env);
+
+  for (j = 0; j < QO_NI_N (node_indexp); j++)
+    {
+      ni_entryp = QO_NI_ENTRY (node_indexp, j);
+      if (!qo_is_bitmap_index_candidate (ni_entryp))
+	{
+	  continue;
+	}
+      index_entryp = ni_entryp->head;
+
+      /* the key range of each index is its most selective term on the first key column */
+      bitset_assign (&first_col_terms, &(index_entryp->seg_equal_terms[0]));
+      bitset_union (&first_col_terms, &(index_entryp->seg_other_terms[0]));
+      bitset_intersect (&first_col_terms, &(QO_NODE_SARGS (nodep)));
+
+      best_termp = NULL;
+      for (t = bitset_iterate (&first_col_terms, &iter); t != -1; t = bitset_next_member (&iter))
+	{
+	  termp = QO_ENV_TERM (env, t);
+	  if (qo_is_bitmap_term (termp)
+	      && (best_termp == NULL || QO_TERM_SELECTIVITY (termp) < QO_TERM_SELECTIVITY (best_termp)))
+	    {
+	      best_termp = termp;
+	    }
+	}
+      if (best_termp == NULL)
+	{
+	  continue;
+	}
+      sel = QO_TERM_SELECTIVITY (best_termp);
+
+      /* keep a single index per first key column */
+      for (i = 0; i < n; i++)
+	{
+	  if (first_segs[i] == index_entryp->seg_idxs[0])
+	    {
+	      break;
+	    }
+	}
+      if (i < n)
+	{
+	  if (sel >= sels[i])
+	    {
+	      continue;
+	    }
+	  for (k = i; k < n - 1; k++)
+	    {
+	      ni_entries[k] = ni_entries[k + 1];
+	      exprs[k] = exprs[k + 1];
+	      sels[k] = sels[k + 1];
+	      first_segs[k] = first_segs[k + 1];
+	    }
+	  n--;
+	}
+
+      /* keep the candidates ordered by selectivity; the most selective one is the primary index */
+      for (i = n; i > 0 && sels[i - 1] > sel; i--)
+	{
+	  ;
+	}
+      if (i >= QO_BITMAP_MAX_INDEXES)
+	{
+	  continue;
+	}
+      for (k = MIN (n, QO_BITMAP_MAX_INDEXES - 1); k > i; k--)
+	{
+	  ni_entries[k] = ni_entries[k - 1];
+	  exprs[k] = exprs[k - 1];
+	  sels[k] = sels[k - 1];
+	  first_segs[k] = first_segs[k - 1];
+	}
+      ni_entries[i] = ni_entryp;
+      exprs[i] = QO_TERM_PT_EXPR (best_termp);
+      sels[i] = sel;
+      first_segs[i] = index_entryp->seg_idxs[0];
+      n = MIN (n + 1, QO_BITMAP_MAX_INDEXES);
+    }
+
+  bitset_delset (&first_col_terms);
+
+  if (n < 2)
+    {
+      return 0;
+    }
+
+  return qo_check_plan_on_info (infop, qo_bitmap_index_scan_new (infop, nodep, n, ni_entries, exprs, sels, false));
+}
+
+/*
+ * qo_generate_bitmap_or_scan () - generate bitmap scans that union the OID
+ *				   sets of the disjuncts of an OR term
+ *   return: num of plans kept
+ *   infop(in):
+ *   nodep(in):
+ */
+static int
+qo_generate_bitmap_or_scan (QO_INFO * infop, QO_NODE * nodep)
+{
+  QO_ENV *env = infop->env;
+  QO_NODE_INDEX_ENTRY *ni_entries[QO_BITMAP_MAX_INDEXES];
+  PT_NODE *exprs[QO_BITMAP_MAX_INDEXES];
+  double sels[QO_BITMAP_MAX_INDEXES];
+  QO_TERM *termp;
+  PT_NODE *expr, *disjunct, *save_or_next;
+  BITSET_ITERATOR iter;
+  int t, n, seg_idx, plan_n = 0;
+
+  for (t = bitset_iterate (&(QO_NODE_SARGS (nodep)), &iter); t != -1; t = bitset_next_member (&iter))
+    {
+      termp = QO_ENV_TERM (env, t);
+      expr = QO_TERM_PT_EXPR (termp);
+
+      if (QO_TERM_CLASS (termp) != QO_TC_SARG || QO_TERM_IS_FLAGED (termp, QO_TERM_NON_IDX_SARG_COLL)
+	  || !bitset_is_empty (&(QO_TERM_SUBQUERIES (termp))) || expr == NULL || expr->or_next == NULL)
+	{
+	  continue;
+	}
+
+      /* every disjunct needs an index of its own, or the whole heap has to be read anyway */
+      n = 0;
+      for (disjunct = expr; disjunct != NULL; disjunct = disjunct->or_next)
+	{
+	  if (n == QO_BITMAP_MAX_INDEXES)
+	    {
+	      break;
+	    }
+
+	  seg_idx = qo_get_bitmap_disjunct_seg (env, nodep, disjunct);
+	  if (seg_idx == -1)
+	    {
+	      break;
+	    }
+
+	  ni_entries[n] = qo_find_bitmap_index (nodep, seg_idx);
+	  if (ni_entries[n] == NULL)
+	    {
+	      break;
+	    }
+
+	  save_or_next = disjunct->or_next;
+	  disjunct->or_next = NULL;
+	  sels[n] = qo_expr_selectivity (env, disjunct);
+	  disjunct->or_next = save_or_next;
+
+	  exprs[n] = disjunct;
+	  n++;
+	}
+
+      if (disjunct != NULL || n < 2)
+	{
+	  continue;
+	}
+
+      plan_n +=
+	qo_check_plan_on_info (infop, qo_bitmap_index_scan_new (infop, nodep, n, ni_entries, exprs, sels, true));
+    }
+
+  return plan_n;
+}
+
+/*
+ * qo_generate_bitmap_index_scans () - generate bitmap index scan plans
+ *   return: num of plans kept
+ *   infop(in): pointer to QO_INFO (environment info node which holds plans)
+ *   nodep(in): pointer to QO_NODE (node in the join graph)
+ *
+ * Note: a bitmap index scan collects the OID sets of several single-column
+ *       key ranges, combines them and visits the heap in physical order.
+ *       The plans compete with the ordinary ones on cost only.
+ */
+static int
+qo_generate_bitmap_index_scans (QO_INFO * infop, QO_NODE * nodep)
+{
+  QO_NODE_INDEX *node_indexp = QO_NODE_INDEXES (nodep);
+  PT_NODE *tree;
+  int i;
+
+  if (node_indexp == NULL || QO_NI_N (node_indexp) < 1 || QO_NODE_IS_CLASS_HIERARCHY (nodep))
+    {
+      return 0;
+    }
+
+  tree = QO_ENV_PT_TREE (infop->env);
+  if (tree == NULL || tree->node_type != PT_SELECT || tree->info.query.q.select.connect_by != NULL)
+    {
+      return 0;
+    }
+
+  /* an index hint asks for that index alone */
+  for (i = 0; i < QO_NI_N (node_indexp); i++)
+    {
+      if (QO_NI_ENTRY (node_indexp, i)->head->force > 0)
+	{
+	  return 0;
+	}
+    }
+
+  return qo_generate_bitmap_and_scan (infop, nodep) + qo_generate_bitmap_or_scan (infop, nodep);
+}
+
 /*
  * qo_is_iscan ()
  *   return: true/false
@@ -8259,6 +8852,8 @@ qo_search_planner (QO_PLANNER * planner)
 	  qo_generate_seq_scan (info, node);
 	}
 
+      qo_generate_bitmap_index_scans (info, node);
+
       if (QO_ENV_USE_SORT_LIMIT (planner->env) && QO_NODE_SORT_LIMIT_CANDIDATE (node))
 	{
 	  /* generate a stop plan over the current best plan of the */
@@ -10823,6 +11418,11 @@ qo_plan_compute_iscan_sort_list (QO_PLAN * root, PT_NODE * group_by, bool * is_i
       /* exclude class hierarchy scan */
       goto exit_on_end;		/* nop */
     }
+  else if (qo_is_index_bitmap_scan (plan))
+    {
+      /* rows come back in physical order, not in key order */
+      goto exit_on_end;		/* nop */
+    }
 
   /* check for index scan plan */
   if (!qo_is_interesting_order_scan (plan) || (env = (plan->info)->env) == NULL
@@ -11203,6 +11803,19 @@ qo_plan_scan_print_json (QO_PLAN * plan)
     case QO_SCANMETHOD_INDEX_ORDERBY_SCAN:
     case QO_SCANMETHOD_INDEX_GROUPBY_SCAN:
     case QO_SCANMETHOD_INDEX_SCAN_INSPECT:
+      if (qo_is_index_bitmap_scan (plan))
+	{
+	  scan_string = "BITMAP INDEX SCAN";
+	  range = json_array ();
+	  for (i = 0; i < plan->plan_un.scan.bitmap_n; i++)
+	    {
+	      json_array_append_new (range, json_string (plan->plan_un.scan.bitmap_index[i]->head->constraints->name));
+	    }
+	  json_object_set_new (scan, "index", range);
+	  json_object_set_new (scan, "combine", json_string (plan->plan_un.scan.bitmap_or ? "OR" : "AND"));
+	  break;
+	}
+
       scan_string = "INDEX SCAN";
       json_object_set_new (scan, "index", json_string (plan->plan_un.scan.index->head->constraints->name));
 
@@ -11521,6 +12134,18 @@ qo_plan_scan_print_text (FILE * fp, QO_PLAN * plan, int indent)
     case QO_SCANMETHOD_INDEX_ORDERBY_SCAN:
     case QO_SCANMETHOD_INDEX_GROUPBY_SCAN:
     case QO_SCANMETHOD_INDEX_SCAN_INSPECT:
+      if (qo_is_index_bitmap_scan (plan))
+	{
+	  fprintf (fp, "BITMAP INDEX SCAN (%s.", class_name);
+	  for (i = 0; i < plan->plan_un.scan.bitmap_n; i++)
+	    {
+	      fprintf (fp, "%s%s", (i == 0) ? "" : (plan->plan_un.scan.bitmap_or ? " OR " : " AND "),
+		       plan->plan_un.scan.bitmap_index[i]->head->constraints->name);
+	    }
+	  fprintf (fp, ")");
+	  break;
+	}
+
       fprintf (fp, "INDEX SCAN (%s.%s)", class_name, plan->plan_un.scan.index->head->constraints->name);
 
       env = (plan->info)->env;
@@ -43,6 +43,8 @@ namespace cubxasl
 
 #define QO_CPU_WEIGHT   0.0025
 
+#define QO_BITMAP_MAX_INDEXES	4	/* maximum number of indexes combined by a bitmap index scan */
+
 typedef enum
 {
   QO_PLANTYPE_SCAN,
@@ -156,6 +158,11 @@ struct qo_plan
       bool index_loose;		/* loose index scan flag */
       QO_NODE_INDEX_ENTRY *index;
       BITSET multi_col_range_segs;	/* range condition segs for multi_col_term */
+      int bitmap_n;		/* number of indexes combined by a bitmap index scan; 0 if not a bitmap scan */
+      bool bitmap_or;		/* unite the OID sets of the indexes instead of intersecting them */
+      QO_NODE_INDEX_ENTRY *bitmap_index[QO_BITMAP_MAX_INDEXES];	/* indexes of a bitmap index scan; [0] == index */
+      PT_NODE *bitmap_expr[QO_BITMAP_MAX_INDEXES];	/* key range expression of each index */
+      double bitmap_sel[QO_BITMAP_MAX_INDEXES];	/* selectivity of each key range expression */
     } scan;
 
     /*
@@ -644,6 +644,7 @@ int g_original_buffer_len;
 %type <number> opt_paren_plus
 %type <number> opt_with_fullscan
 %type <number> opt_with_online
+%type <boolean> opt_rebuild_online
 %type <number> comp_op
 %type <number> opt_of_all_some_any
 %type <number> set_op
@@ -3555,6 +3556,7 @@ alter_stmt
 	  opt_where_clause				/* 11 */
 	  opt_comment_spec			/* 12 */
 	  REBUILD					/* 13 */
+	  opt_rebuild_online			/* 14 */
 		{{
 
 			PT_NODE *node = parser_pop_hint_node ();
@@ -3617,6 +3619,8 @@ alter_stmt
 			    node->info.index.where = $11;
 			    node->info.index.comment = $12;
 
+			    node->info.index.compact = $14;
+
 			    $$ = node;
 			    PARSER_SAVE_ERR_CONTEXT ($$, @$.buffer_pos)
 			  }
@@ -4397,6 +4401,21 @@ opt_with_online
 		DBG_PRINT}}
 	;
 
+opt_rebuild_online
+	: /* empty */
+		{{
+
+			$$ = false;
+
+		DBG_PRINT}}
+	| ONLINE
+		{{
+
+			$$ = true;
+
+		DBG_PRINT}}
+	;
+
 opt_of_to_eq
 	: /* empty */
 	| TO
@@ -7109,6 +7128,18 @@ show_type
 		{{
 			$$ = SHOWSTMT_THREADS;
 		}}
+	| VACUUM STATUS
+		{{
+			$$ = SHOWSTMT_VACUUM_STATUS;
+		}}
+	| VACUUM TABLES
+		{{
+			$$ = SHOWSTMT_VACUUM_TABLES;
+		}}
+	| VACUUM THREADS
+		{{
+			$$ = SHOWSTMT_VACUUM_THREADS;
+		}}
 	;
 
 show_type_of_like
@@ -7151,6 +7182,18 @@ show_type_of_where
 		{{
 			$$ = SHOWSTMT_THREADS;
 		}}
+	| VACUUM STATUS
+		{{
+			$$ = SHOWSTMT_VACUUM_STATUS;
+		}}
+	| VACUUM TABLES
+		{{
+			$$ = SHOWSTMT_VACUUM_TABLES;
+		}}
+	| VACUUM THREADS
+		{{
+			$$ = SHOWSTMT_VACUUM_THREADS;
+		}}
 	;
 
 show_type_arg1
@@ -10668,6 +10711,34 @@ transaction_mode
 			$$ = tm;
 			PARSER_SAVE_ERR_CONTEXT ($$, @$.buffer_pos)
 
+		DBG_PRINT}}
+	| READ ONLY
+		{{
+
+			PT_NODE *tm = parser_new_node (this_parser, PT_TRAN_ACCESS_MODE);
+
+			if (tm)
+			  {
+			    tm->info.tran_access_mode.read_only = true;
+			  }
+
+			$$ = tm;
+			PARSER_SAVE_ERR_CONTEXT ($$, @$.buffer_pos)
+
+		DBG_PRINT}}
+	| READ WRITE
+		{{
+
+			PT_NODE *tm = parser_new_node (this_parser, PT_TRAN_ACCESS_MODE);
+
+			if (tm)
+			  {
+			    tm->info.tran_access_mode.read_only = false;
+			  }
+
+			$$ = tm;
+			PARSER_SAVE_ERR_CONTEXT ($$, @$.buffer_pos)
+
 		DBG_PRINT}}
 	;
 
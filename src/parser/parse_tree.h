@@ -909,6 +909,7 @@ enum pt_node_type
   PT_JSON_TABLE,
   PT_JSON_TABLE_NODE,
   PT_JSON_TABLE_COLUMN,
+  PT_TRAN_ACCESS_MODE,
 
   PT_NODE_NUMBER,		/* This is the number of node types */
   PT_LAST_NODE_NUMBER = PT_NODE_NUMBER
@@ -1636,6 +1637,7 @@ typedef struct pt_showstmt_info PT_SHOWSTMT_INFO;
 typedef struct pt_killstmt_info PT_KILLSTMT_INFO;
 typedef struct pt_sort_spec_info PT_SORT_SPEC_INFO;
 typedef struct pt_timeout_info PT_TIMEOUT_INFO;
+typedef struct pt_tran_access_mode_info PT_TRAN_ACCESS_MODE_INFO;
 typedef struct pt_trigger_action_info PT_TRIGGER_ACTION_INFO;
 typedef struct pt_trigger_spec_list_info PT_TRIGGER_SPEC_LIST_INFO;
 typedef struct pt_update_info PT_UPDATE_INFO;
@@ -1960,6 +1962,7 @@ struct pt_index_info
   int func_no_args;		/* number of arguments in the function index expression */
   bool reverse;			/* REVERSE */
   bool unique;			/* UNIQUE specified? */
+  bool compact;			/* REBUILD ONLINE: merge sparse leaves in place */
   SM_INDEX_STATUS index_status;	/* Index status : NORMAL / ONLINE / INVISIBLE */
   int ib_threads;
 };
@@ -2815,7 +2818,7 @@ struct pt_set_sys_params_info
 /* Info for Set Transaction statement */
 struct pt_set_xaction_info
 {
-  PT_NODE *xaction_modes;	/* PT_ISOLATION_LVL, PT_TIMEOUT (list) */
+  PT_NODE *xaction_modes;	/* PT_ISOLATION_LVL, PT_TIMEOUT, PT_TRAN_ACCESS_MODE (list) */
 };
 
 /* Info for Set Trigger statement */
@@ -2853,6 +2856,12 @@ struct pt_timeout_info
   PT_NODE *val;			/* PT_VALUE */
 };
 
+/* Info for READ ONLY / READ WRITE transaction mode */
+struct pt_tran_access_mode_info
+{
+  bool read_only;
+};
+
 /* Info for Trigger Action */
 struct pt_trigger_action_info
 {
@@ -3362,6 +3371,7 @@ union pt_statement_info
   PT_SPEC_INFO spec;
   PT_TABLE_OPTION_INFO table_option;
   PT_TIMEOUT_INFO timeout;
+  PT_TRAN_ACCESS_MODE_INFO tran_access_mode;
   PT_TRIGGER_ACTION_INFO trigger_action;
   PT_TRIGGER_SPEC_LIST_INFO trigger_spec_list;
   PT_TRUNCATE_INFO truncate;
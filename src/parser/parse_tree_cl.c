@@ -184,6 +184,7 @@ static PT_NODE *pt_apply_sp_parameter (PARSER_CONTEXT * parser, PT_NODE * p, PT_
 static PT_NODE *pt_apply_stored_procedure (PARSER_CONTEXT * parser, PT_NODE * p, PT_NODE_FUNCTION g, void *arg);
 static PT_NODE *pt_apply_prepare (PARSER_CONTEXT * parser, PT_NODE * p, PT_NODE_FUNCTION g, void *arg);
 static PT_NODE *pt_apply_timeout (PARSER_CONTEXT * parser, PT_NODE * p, PT_NODE_FUNCTION g, void *arg);
+static PT_NODE *pt_apply_tran_access_mode (PARSER_CONTEXT * parser, PT_NODE * p, PT_NODE_FUNCTION g, void *arg);
 static PT_NODE *pt_apply_trigger_action (PARSER_CONTEXT * parser, PT_NODE * p, PT_NODE_FUNCTION g, void *arg);
 static PT_NODE *pt_apply_trigger_spec_list (PARSER_CONTEXT * parser, PT_NODE * p, PT_NODE_FUNCTION g, void *arg);
 static PT_NODE *pt_apply_alter_index (PARSER_CONTEXT * parser, PT_NODE * p, PT_NODE_FUNCTION g, void *arg);
@@ -287,6 +288,7 @@ static PT_NODE *pt_init_sp_parameter (PT_NODE * p);
 static PT_NODE *pt_init_stored_procedure (PT_NODE * p);
 static PT_NODE *pt_init_prepare (PT_NODE * p);
 static PT_NODE *pt_init_timeout (PT_NODE * p);
+static PT_NODE *pt_init_tran_access_mode (PT_NODE * p);
 static PT_NODE *pt_init_trigger_action (PT_NODE * p);
 static PT_NODE *pt_init_trigger_spec_list (PT_NODE * p);
 static PT_NODE *pt_init_alter_index (PT_NODE * p);
@@ -443,6 +445,7 @@ static PARSER_VARCHAR *pt_print_spec (PARSER_CONTEXT * parser, PT_NODE * p);
 static PARSER_VARCHAR *pt_print_sp_parameter (PARSER_CONTEXT * parser, PT_NODE * p);
 static PARSER_VARCHAR *pt_print_table_option (PARSER_CONTEXT * parser, PT_NODE * p);
 static PARSER_VARCHAR *pt_print_timeout (PARSER_CONTEXT * parser, PT_NODE * p);
+static PARSER_VARCHAR *pt_print_tran_access_mode (PARSER_CONTEXT * parser, PT_NODE * p);
 static PARSER_VARCHAR *pt_print_trigger_action (PARSER_CONTEXT * parser, PT_NODE * p);
 static PARSER_VARCHAR *pt_print_trigger_spec_list (PARSER_CONTEXT * parser, PT_NODE * p);
 static PARSER_VARCHAR *pt_print_truncate (PARSER_CONTEXT * parser, PT_NODE * p);
@@ -3051,6 +3054,8 @@ pt_show_node_type (PT_NODE * node)
       return "SPEC";
     case PT_TIMEOUT:
       return "TIMEOUT";
+    case PT_TRAN_ACCESS_MODE:
+      return "TRAN_ACCESS_MODE";
     case PT_TRIGGER_ACTION:
       return "TRIGGER_ACTION";
     case PT_TRIGGER_SPEC_LIST:
@@ -4959,6 +4964,7 @@ pt_init_apply_f (void)
   pt_apply_func_array[PT_JSON_TABLE] = pt_apply_json_table;
   pt_apply_func_array[PT_JSON_TABLE_NODE] = pt_apply_json_table_node;
   pt_apply_func_array[PT_JSON_TABLE_COLUMN] = pt_apply_json_table_column;
+  pt_apply_func_array[PT_TRAN_ACCESS_MODE] = pt_apply_tran_access_mode;
 
   pt_apply_f = pt_apply_func_array;
 }
@@ -5078,6 +5084,7 @@ pt_init_init_f (void)
   pt_init_func_array[PT_JSON_TABLE] = pt_init_json_table;
   pt_init_func_array[PT_JSON_TABLE_NODE] = pt_init_json_table_node;
   pt_init_func_array[PT_JSON_TABLE_COLUMN] = pt_init_json_table_column;
+  pt_init_func_array[PT_TRAN_ACCESS_MODE] = pt_init_tran_access_mode;
 
   pt_init_f = pt_init_func_array;
 }
@@ -5195,6 +5202,7 @@ pt_init_print_f (void)
   pt_print_func_array[PT_JSON_TABLE] = pt_print_json_table;
   pt_print_func_array[PT_JSON_TABLE_NODE] = pt_print_json_table_node;
   pt_print_func_array[PT_JSON_TABLE_COLUMN] = pt_print_json_table_columns;
+  pt_print_func_array[PT_TRAN_ACCESS_MODE] = pt_print_tran_access_mode;
 
   pt_print_f = pt_print_func_array;
 }
@@ -6300,6 +6308,11 @@ pt_print_alter_index (PARSER_CONTEXT * parser, PT_NODE * p)
   if (p->info.index.code == PT_REBUILD_INDEX)
     {
       b = pt_append_nulstring (parser, b, "rebuild");
+
+      if (p->info.index.compact)
+	{
+	  b = pt_append_nulstring (parser, b, " online");
+	}
     }
 
   return b;
@@ -15348,6 +15361,55 @@ pt_print_timeout (PARSER_CONTEXT * parser, PT_NODE * p)
   return b;
 }
 
+/* TRAN_ACCESS_MODE */
+/*
+ * pt_apply_tran_access_mode () -
+ *   return:
+ *   parser(in):
+ *   p(in):
+ *   g(in):
+ *   arg(in):
+ */
+static PT_NODE *
+pt_apply_tran_access_mode (PARSER_CONTEXT * parser, PT_NODE * p, PT_NODE_FUNCTION g, void *arg)
+{
+  return p;
+}
+
+/*
+ * pt_init_tran_access_mode () -
+ *   return:
+ *   p(in):
+ */
+static PT_NODE *
+pt_init_tran_access_mode (PT_NODE * p)
+{
+  p->info.tran_access_mode.read_only = false;
+  return (p);
+}
+
+/*
+ * pt_print_tran_access_mode () -
+ *   return:
+ *   parser(in):
+ *   p(in):
+ */
+static PARSER_VARCHAR *
+pt_print_tran_access_mode (PARSER_CONTEXT * parser, PT_NODE * p)
+{
+  PARSER_VARCHAR *b = NULL;
+
+  if (p->info.tran_access_mode.read_only)
+    {
+      b = pt_append_nulstring (parser, b, "read only");
+    }
+  else
+    {
+      b = pt_append_nulstring (parser, b, "read write");
+    }
+  return b;
+}
+
 /* TRIGGER_ACTION */
 /*
  * pt_apply_trigger_action () -
@@ -689,6 +689,94 @@ metadata_of_threads (void)
   return &md;
 }
 
+static SHOWSTMT_METADATA *
+metadata_of_vacuum_status (void)
+{
+  static const SHOWSTMT_COLUMN cols[] = {
+    {"Backlog_blocks", "bigint"},
+    {"Backlog_log_pages", "bigint"},
+    {"Oldest_unvacuumed_mvccid", "bigint"},
+    {"Oldest_visible_mvccid", "bigint"},
+    {"Next_mvccid", "bigint"},
+    {"Blocking_tran_index", "int"},
+    {"Blocking_tran_id", "int"},
+    {"Blocking_mvccid", "bigint"},
+    {"Blocking_user", "varchar(32)"},
+    {"Blocking_host", "varchar(64)"},
+    {"Blocking_program", "varchar(32)"},
+    {"Blocking_pid", "int"},
+    {"Workers", "int"},
+    {"Active_workers", "int"},
+    {"Jobs", "bigint"},
+    {"Versions_vacuumed", "bigint"},
+    {"Records_removed", "bigint"},
+    {"Versions_cleaned", "bigint"}
+  };
+
+  static const SHOWSTMT_COLUMN_ORDERBY orderby[] = {
+    {1, ORDER_ASC}
+  };
+
+  static SHOWSTMT_METADATA md = {
+    SHOWSTMT_VACUUM_STATUS, true /* only_for_dba */ , "show vacuum status",
+    cols, DIM (cols), orderby, DIM (orderby), NULL, 0, NULL, NULL
+  };
+  return &md;
+}
+
+static SHOWSTMT_METADATA *
+metadata_of_vacuum_tables (void)
+{
+  static const SHOWSTMT_COLUMN cols[] = {
+    {"Class_name", "varchar(255)"},
+    {"Volume_id", "int"},
+    {"File_id", "int"},
+    {"Header_page_id", "int"},
+    {"Mvcc_inserts", "bigint"},
+    {"Mvcc_updates", "bigint"},
+    {"Mvcc_deletes", "bigint"},
+    {"Versions_produced", "bigint"},
+    {"Versions_vacuumed", "bigint"},
+    {"Records_removed", "bigint"},
+    {"Versions_cleaned", "bigint"},
+    {"Pending_versions", "bigint"}
+  };
+
+  static const SHOWSTMT_COLUMN_ORDERBY orderby[] = {
+    {12, ORDER_DESC}
+  };
+
+  static SHOWSTMT_METADATA md = {
+    SHOWSTMT_VACUUM_TABLES, true /* only_for_dba */ , "show vacuum tables",
+    cols, DIM (cols), orderby, DIM (orderby), NULL, 0, NULL, NULL
+  };
+  return &md;
+}
+
+static SHOWSTMT_METADATA *
+metadata_of_vacuum_threads (void)
+{
+  static const SHOWSTMT_COLUMN cols[] = {
+    {"Worker_index", "int"},
+    {"State", "varchar(16)"},
+    {"Jobs", "bigint"},
+    {"Log_pages", "bigint"},
+    {"Versions_vacuumed", "bigint"},
+    {"Records_removed", "bigint"},
+    {"Versions_cleaned", "bigint"}
+  };
+
+  static const SHOWSTMT_COLUMN_ORDERBY orderby[] = {
+    {1, ORDER_ASC}
+  };
+
+  static SHOWSTMT_METADATA md = {
+    SHOWSTMT_VACUUM_THREADS, true /* only_for_dba */ , "show vacuum threads",
+    cols, DIM (cols), orderby, DIM (orderby), NULL, 0, NULL, NULL
+  };
+  return &md;
+}
+
 /*
  * showstmt_get_metadata() -  return show statement column infos
  *   return:-
@@ -930,6 +1018,9 @@ showstmt_metadata_init (void)
   show_Metas[SHOWSTMT_FULL_TIMEZONES] = metadata_of_full_timezones ();
   show_Metas[SHOWSTMT_TRAN_TABLES] = metadata_of_tran_tables ();
   show_Metas[SHOWSTMT_THREADS] = metadata_of_threads ();
+  show_Metas[SHOWSTMT_VACUUM_STATUS] = metadata_of_vacuum_status ();
+  show_Metas[SHOWSTMT_VACUUM_TABLES] = metadata_of_vacuum_tables ();
+  show_Metas[SHOWSTMT_VACUUM_THREADS] = metadata_of_vacuum_threads ();
 
   for (i = 0; i < DIM (show_Metas); i++)
     {
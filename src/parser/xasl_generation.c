@@ -346,6 +346,8 @@ static int pt_instnum_to_key_limit (PARSER_CONTEXT * parser, QO_PLAN * plan, XAS
 static int pt_ordbynum_to_key_limit_multiple_ranges (PARSER_CONTEXT * parser, QO_PLAN * plan, XASL_NODE * xasl);
 static INDX_INFO *pt_to_index_info (PARSER_CONTEXT * parser, DB_OBJECT * class_, PRED_EXPR * where_pred, QO_PLAN * plan,
 				    QO_XASL_INDEX_INFO * qo_index_infop);
+static int pt_to_bitmap_index_info (PARSER_CONTEXT * parser, DB_OBJECT * class_, PRED_EXPR * where_pred, QO_PLAN * plan,
+				    INDX_INFO * indx_infop);
 static ACCESS_SPEC_TYPE *pt_to_class_spec_list (PARSER_CONTEXT * parser, PT_NODE * spec, PT_NODE * where_key_part,
 						PT_NODE * where_part, QO_PLAN * plan, QO_XASL_INDEX_INFO * index_pred);
 static ACCESS_SPEC_TYPE *pt_to_subquery_table_spec_list (PARSER_CONTEXT * parser, PT_NODE * spec, PT_NODE * subquery,
@@ -11647,6 +11649,62 @@ pt_get_mvcc_reev_range_data (PARSER_CONTEXT * parser, TABLE_INFO * table_info, P
   return NO_ERROR;
 }
 
+/*
+ * pt_to_bitmap_index_info () - Create the INDX_INFO of the other indexes of
+ *	a bitmap index scan and chain them to the one of its first index
+ *   return: NO_ERROR or error code
+ *   parser(in):
+ *   class_(in):
+ *   where_pred(in):
+ *   plan(in): bitmap index scan plan
+ *   indx_infop(in/out): INDX_INFO of the first index
+ */
+static int
+pt_to_bitmap_index_info (PARSER_CONTEXT * parser, DB_OBJECT * class_, PRED_EXPR * where_pred, QO_PLAN * plan,
+			 INDX_INFO * indx_infop)
+{
+  QO_XASL_INDEX_INFO *qo_index_infop;
+  INDX_INFO *curr_infop, *next_infop;
+  int i;
+
+  assert (qo_is_index_bitmap_scan (plan));
+
+  indx_infop->bitmap_op = plan->plan_un.scan.bitmap_or ? BITMAP_OP_OR : BITMAP_OP_AND;
+
+  curr_infop = indx_infop;
+  for (i = 1; i < plan->plan_un.scan.bitmap_n; i++)
+    {
+      qo_index_infop = qo_get_xasl_bitmap_index_info (plan->info->env, plan, i);
+      if (qo_index_infop == NULL)
+	{
+	  PT_INTERNAL_ERROR (parser, "index plan generation - memory alloc");
+	  return ER_FAILED;
+	}
+
+      next_infop = pt_to_index_info (parser, class_, where_pred, plan, qo_index_infop);
+      qo_free_xasl_index_info (plan->info->env, qo_index_infop);
+      if (next_infop == NULL)
+	{
+	  return ER_FAILED;
+	}
+
+      next_infop->bitmap_op = indx_infop->bitmap_op;
+      curr_infop->bitmap_next = next_infop;
+      curr_infop = next_infop;
+    }
+
+  /* the OID sets come back in physical order; no index order can be relied on */
+  for (curr_infop = indx_infop; curr_infop != NULL; curr_infop = curr_infop->bitmap_next)
+    {
+      curr_infop->coverage = 0;
+      curr_infop->use_desc_index = 0;
+      curr_infop->orderby_skip = 0;
+      curr_infop->groupby_skip = 0;
+    }
+
+  return NO_ERROR;
+}
+
 /*
  * pt_to_class_spec_list () - Convert a PT_NODE flat class list to
  *     an ACCESS_SPEC_LIST list of representing the classes to be selected from
@@ -12009,6 +12067,10 @@ pt_to_class_spec_list (PARSER_CONTEXT * parser, PT_NODE * spec, PT_NODE * where_
 	       * return values here.
 	       */
 	      index_info = pt_to_index_info (parser, class_->info.name.db_object, where, plan, index_pred);
+	      if (index_info != NULL && qo_is_index_bitmap_scan (plan))
+		{
+		  (void) pt_to_bitmap_index_info (parser, class_->info.name.db_object, where, plan, index_info);
+		}
 
 	      if (pt_has_error (parser))
 		{
@@ -224,6 +224,8 @@ regu_init (indx_info &ii)
   ii.iss_range.range = NA_NA;
   ii.iss_range.key1 = NULL;
   ii.iss_range.key2 = NULL;
+  ii.bitmap_op = BITMAP_OP_NONE;
+  ii.bitmap_next = NULL;
 }
 
 void
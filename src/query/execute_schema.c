@@ -3387,6 +3387,122 @@ error_exit:
   goto end;
 }
 
+/*
+ * do_alter_index_compact() - Merges the sparse leaves of an index in place
+ *                            (ALTER INDEX ... REBUILD ONLINE).
+ *   return: Error code if it fails
+ *   parser(in): Parser context
+ *   statement(in): Parse tree of a alter index statement
+ *
+ * Note: Unlike do_alter_index_rebuild, the index is neither dropped nor
+ *       recreated, so only a read lock on the class is required and the
+ *       index stays usable by concurrent transactions. On a partitioned class
+ *       the local index of every partition is compacted.
+ */
+static int
+do_alter_index_compact (PARSER_CONTEXT * parser, const PT_NODE * statement)
+{
+  int error = NO_ERROR;
+  DB_OBJECT *obj;
+  PT_NODE *cls = NULL;
+  SM_CLASS *smcls;
+  SM_CLASS_CONSTRAINT *idx = NULL;
+  const char *index_name = NULL;
+  int partition_type = DB_NOT_PARTITIONED_CLASS;
+  MOP *sub_partitions = NULL;
+  BTID btid;
+  int i, merged, fill_before, fill_after;
+  int total_merged = 0, total_fill_before = 0, total_fill_after = 0, n_indexes = 0;
+
+  CHECK_MODIFICATION_ERROR ();
+
+  index_name = statement->info.index.index_name ? statement->info.index.index_name->info.name.original : NULL;
+  assert (index_name != NULL);
+
+  if (statement->info.index.indexed_class)
+    {
+      cls = statement->info.index.indexed_class->info.spec.flat_entity_list;
+    }
+  assert (cls != NULL);
+
+  obj = db_find_class (cls->info.name.resolved);
+  if (obj == NULL)
+    {
+      ASSERT_ERROR_AND_SET (error);
+      return error;
+    }
+
+  error = au_fetch_class (obj, &smcls, AU_FETCH_READ, AU_INDEX);
+  if (error != NO_ERROR)
+    {
+      return error;
+    }
+
+  idx = classobj_find_class_index (smcls, index_name);
+  if (idx == NULL)
+    {
+      error = ER_SM_NO_INDEX;
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, error, 1, index_name);
+      return error;
+    }
+
+  error = sm_partitioned_class_type (obj, &partition_type, NULL, &sub_partitions);
+  if (error != NO_ERROR)
+    {
+      return error;
+    }
+
+  if (partition_type != DB_PARTITIONED_CLASS)
+    {
+      error = btree_compact_index (&idx->index_btid, &merged, &fill_before, &fill_after);
+      if (error == NO_ERROR)
+	{
+	  total_merged = merged;
+	  total_fill_before = fill_before;
+	  total_fill_after = fill_after;
+	  n_indexes = 1;
+	}
+    }
+  else
+    {
+      for (i = 0; error == NO_ERROR && sub_partitions[i] != NULL; i++)
+	{
+	  if (sm_exist_index (sub_partitions[i], index_name, &btid) != NO_ERROR)
+	    {
+	      /* primary key and unique constraints are global */
+	      continue;
+	    }
+
+	  error = btree_compact_index (&btid, &merged, &fill_before, &fill_after);
+	  if (error == NO_ERROR)
+	    {
+	      total_merged += merged;
+	      total_fill_before += fill_before;
+	      total_fill_after += fill_after;
+	      n_indexes++;
+	    }
+	}
+    }
+
+  if (sub_partitions != NULL)
+    {
+      free_and_init (sub_partitions);
+    }
+
+  if (error != NO_ERROR)
+    {
+      return error;
+    }
+
+  if (n_indexes > 0)
+    {
+      er_set (ER_NOTIFICATION_SEVERITY, ARG_FILE_LINE, ER_BTREE_COMPACTED, 4, index_name, total_merged,
+	      total_fill_before / n_indexes, total_fill_after / n_indexes);
+    }
+
+  return NO_ERROR;
+}
+
 #if defined (ENABLE_RENAME_CONSTRAINT)
 /*
  * do_alter_index_rename() - renames an index on a class.
@@ -3620,7 +3736,11 @@ do_alter_index (PARSER_CONTEXT * parser, const PT_NODE * statement)
 
   CHECK_MODIFICATION_ERROR ();
 
-  if (statement->info.index.code == PT_REBUILD_INDEX)
+  if (statement->info.index.code == PT_REBUILD_INDEX && statement->info.index.compact)
+    {
+      error = do_alter_index_compact (parser, statement);
+    }
+  else if (statement->info.index.code == PT_REBUILD_INDEX)
     {
       error = do_alter_index_rebuild (parser, statement);
     }
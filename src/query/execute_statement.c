@@ -4654,8 +4654,8 @@ do_get_xaction (PARSER_CONTEXT * parser, PT_NODE * statement)
 }
 
 /*
- * do_set_xaction() - Sets the isolation level and/or timeout value for
- *      	      a transaction
+ * do_set_xaction() - Sets the isolation level, timeout value and/or access
+ *      	      mode for a transaction
  *   return: Error code if it fails
  *   parser(in): Parser context
  *   statement(in): Parse tree of a set transaction statement
@@ -4729,6 +4729,9 @@ do_set_xaction (PARSER_CONTEXT * parser, PT_NODE * statement)
 	      (void) tran_reset_wait_times ((int) wait_secs);
 	    }
 	  break;
+	case PT_TRAN_ACCESS_MODE:
+	  error = tran_reset_read_only (mode->info.tran_access_mode.read_only);
+	  break;
 	default:
 	  return ER_GENERIC_ERROR;
 	}
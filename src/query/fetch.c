@@ -3782,6 +3782,16 @@ fetch_peek_dbval (THREAD_ENTRY * thread_p, REGU_VARIABLE * regu_var, val_descr *
       /* is not constant */
       REGU_VARIABLE_SET_FLAG (regu_var, REGU_VARIABLE_FETCH_NOT_CONST);
       assert (!REGU_VARIABLE_IS_FLAGED (regu_var, REGU_VARIABLE_FETCH_ALL_CONST));
+      if (regu_var->value.attr_descr.cache_attrinfo != NULL
+	  && regu_var->value.attr_descr.cache_attrinfo->num_deferred > 0)
+	{
+	  /* the attribute may only be located; decode it now */
+	  if (heap_attrinfo_read_deferred_value (regu_var->value.attr_descr.id,
+						 regu_var->value.attr_descr.cache_attrinfo) != NO_ERROR)
+	    {
+	      goto exit_on_error;
+	    }
+	}
       *peek_dbval = regu_var->value.attr_descr.cache_dbvalp;
       if (*peek_dbval != NULL)
 	{
@@ -32,7 +32,8 @@ typedef enum
   HEAP_READ_ATTRVALUE,
   HEAP_WRITTEN_ATTRVALUE,
   HEAP_UNINIT_ATTRVALUE,
-  HEAP_WRITTEN_LOB_ATTRVALUE
+  HEAP_WRITTEN_LOB_ATTRVALUE,
+  HEAP_DEFERRED_ATTRVALUE	/* located in deferred_recdes, decoded on first access */
 } HEAP_ATTRVALUE_STATE;
 
 typedef enum
@@ -69,6 +70,8 @@ struct heap_cache_attrinfo
   int inst_chn;			/* Current chn of instance object */
   int num_values;		/* Number of desired attribute values */
   HEAP_ATTRVALUE *values;	/* Value for the attributes */
+  RECDES deferred_recdes;	/* Record of the values that are not decoded yet */
+  int num_deferred;		/* Number of values that are not decoded yet */
 };
 
 #else /* !defined (SERVER_MODE) && !defined (SA_MODE) */
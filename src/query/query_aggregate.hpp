@@ -98,6 +98,12 @@ namespace cubquery
     aggregate_hash_value *curr_part_value;	/* current partial value */
     aggregate_hash_value *temp_part_value;	/* temporary partial value */
     int sorted_count;
+
+    /* hash partition spill stuff */
+    bool use_partitions;		/* spill groups to hash partitions instead of falling back to sort */
+    int spill_count;		/* number of times the hash table was spilled to partitions */
+    qfile_list_id **spill_tuple_lists;	/* first tuples of spilled groups, one list per partition */
+    qfile_list_id **spill_part_lists;	/* partial accumulators of spilled groups, one list per partition */
   };
 
 
@@ -2999,6 +2999,10 @@ qdump_print_stats_json (xasl_node * xasl_p, json_t * parent)
 	{
 	  json_object_set_new (groupby, "hash", json_string ("partial"));
 	}
+      else if (gstats->groupby_hash == HS_PARTITIONED)
+	{
+	  json_object_set_new (groupby, "hash", json_string ("partitioned"));
+	}
       else
 	{
 	  json_object_set_new (groupby, "hash", json_false ());
@@ -3265,6 +3269,10 @@ qdump_print_stats_text (FILE * fp, xasl_node * xasl_p, int indent)
 	{
 	  fprintf (fp, ", hash: partial");
 	}
+      else if (gstats->groupby_hash == HS_PARTITIONED)
+	{
+	  fprintf (fp, ", hash: partitioned");
+	}
       else
 	{
 	  fprintf (fp, ", hash: false");
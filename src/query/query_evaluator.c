@@ -2695,6 +2695,7 @@ eval_data_filter (THREAD_ENTRY * thread_p, OID * oid, RECDES * recdesp, HEAP_SCA
   SCAN_PRED *scan_predp;
   SCAN_ATTRS *scan_attrsp;
   DB_LOGICAL ev_res;
+  bool is_deferred = false;
 
   if (!filterp)
     {
@@ -2710,8 +2711,20 @@ eval_data_filter (THREAD_ENTRY * thread_p, OID * oid, RECDES * recdesp, HEAP_SCA
 
   if (scan_attrsp != NULL && scan_attrsp->attr_cache != NULL && scan_predp->regu_list != NULL)
     {
+      if (oid != NULL && recdesp != NULL && recdesp->data != NULL && scan_predp->pred_expr != NULL
+	  && scan_predp->pred_expr->type == T_PRED && scan_attrsp->attr_cache->num_values > 1)
+	{
+	  /* The predicate is a conjunction or a disjunction that may be decided by its first terms. Only locate the
+	   * predicate values and let each term decode the attributes it references, so that a rejected row does not
+	   * pay for decoding the attributes of the terms that were never evaluated. */
+	  if (heap_attrinfo_read_dbvalues_deferred (thread_p, oid, recdesp, scan_attrsp->attr_cache) != NO_ERROR)
+	    {
+	      return V_ERROR;
+	    }
+	  is_deferred = true;
+	}
       /* read the predicate values from the heap into the attribute cache */
-      if (heap_attrinfo_read_dbvalues (thread_p, oid, recdesp, scan_cache, scan_attrsp->attr_cache) != NO_ERROR)
+      else if (heap_attrinfo_read_dbvalues (thread_p, oid, recdesp, scan_cache, scan_attrsp->attr_cache) != NO_ERROR)
 	{
 	  return V_ERROR;
 	}
@@ -2745,6 +2758,24 @@ eval_data_filter (THREAD_ENTRY * thread_p, OID * oid, RECDES * recdesp, HEAP_SCA
       return ev_res;
     }
 
+  if (is_deferred)
+    {
+      if (ev_res == V_TRUE)
+	{
+	  /* the row qualified; decode the predicate values that were skipped while the record is still at hand */
+	  if (heap_attrinfo_read_deferred_dbvalues (scan_attrsp->attr_cache) != NO_ERROR)
+	    {
+	      return V_ERROR;
+	    }
+	}
+      else
+	{
+	  /* the record may not outlive its page, which the caller unfixes for a rejected row; nothing may be decoded
+	   * from it later */
+	  heap_attrinfo_reset_deferred_dbvalues (scan_attrsp->attr_cache);
+	}
+    }
+
   if (ev_res == V_TRUE && scan_predp->regu_list && filterp->val_list)
     {
       /*
@@ -127,6 +127,20 @@ struct xasl_state
 /* maximum selectivity allowed for hash aggregate evaluation */
 #define HASH_AGGREGATE_VH_SELECTIVITY_THRESHOLD         0.5f
 
+/* number of partitions groups are spilled to when the hash table is full */
+#define HASH_AGGREGATE_SPILL_PARTITIONS                 16
+
+/* number of key hash bits consumed by each partitioning level */
+#define HASH_AGGREGATE_SPILL_PARTITION_BITS             4
+
+/* partitions at this depth are aggregated in memory even if they exceed the memory limit */
+#define HASH_AGGREGATE_SPILL_MAX_DEPTH                  4
+
+/* partition of a group key on a given partitioning level */
+#define HASH_AGGREGATE_SPILL_PARTITION(key, depth) \
+  ((qdata_hash_agg_hkey ((key), INT_MAX) >> ((depth) * HASH_AGGREGATE_SPILL_PARTITION_BITS)) \
+   & (HASH_AGGREGATE_SPILL_PARTITIONS - 1))
+
 
 #define QEXEC_CLEAR_AGG_LIST_VALUE(agg_list) \
   do \
@@ -446,6 +460,21 @@ static int qexec_gby_finalize_group_dim (THREAD_ENTRY * thread_p, GROUPBY_STATE
 static void qexec_gby_finalize_group (THREAD_ENTRY * thread_p, GROUPBY_STATE * gbstate, int N, bool keep_list_file);
 static SORT_STATUS qexec_hash_gby_get_next (THREAD_ENTRY * thread_p, RECDES * recdes, void *arg);
 static int qexec_hash_gby_put_next (THREAD_ENTRY * thread_p, const RECDES * recdes, void *arg);
+static int qexec_hash_gby_open_partitions (THREAD_ENTRY * thread_p, QFILE_TUPLE_VALUE_TYPE_LIST * tuple_type_list,
+					   QFILE_TUPLE_VALUE_TYPE_LIST * part_type_list, QUERY_ID query_id,
+					   QFILE_LIST_ID ** tuple_lists, QFILE_LIST_ID ** part_lists);
+static void qexec_hash_gby_destroy_partitions (THREAD_ENTRY * thread_p, QFILE_LIST_ID ** tuple_lists,
+					       QFILE_LIST_ID ** part_lists);
+static int qexec_hash_gby_spill_htable (THREAD_ENTRY * thread_p, AGGREGATE_HASH_CONTEXT * context,
+					QFILE_TUPLE_VALUE_TYPE_LIST * tuple_type_list, QUERY_ID query_id);
+static int qexec_hash_gby_unspill_partitions (THREAD_ENTRY * thread_p, AGGREGATE_HASH_CONTEXT * context,
+					      QFILE_LIST_ID * tuple_list_id);
+static int qexec_hash_gby_output_htable (THREAD_ENTRY * thread_p, GROUPBY_STATE * gbstate);
+static int qexec_hash_gby_finalize_partitions (THREAD_ENTRY * thread_p, GROUPBY_STATE * gbstate);
+static int qexec_hash_gby_process_partition (THREAD_ENTRY * thread_p, GROUPBY_STATE * gbstate,
+					     QFILE_LIST_ID * tuple_list, QFILE_LIST_ID * part_list, int depth);
+static int qexec_hash_gby_repartition (THREAD_ENTRY * thread_p, GROUPBY_STATE * gbstate, QFILE_LIST_ID * tuple_list,
+				       QFILE_LIST_ID * part_list, int depth);
 static SORT_STATUS qexec_gby_get_next (THREAD_ENTRY * thread_p, RECDES * recdes, void *arg);
 static int qexec_gby_put_next (THREAD_ENTRY * thread_p, const RECDES * recdes, void *arg);
 static int qexec_groupby (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state,
@@ -665,12 +694,20 @@ static int qexec_evaluate_partition_aggregates (THREAD_ENTRY * thread_p, ACCESS_
 						AGGREGATE_TYPE * agg_list, bool * is_scan_needed);
 
 static int qexec_setup_topn_proc (THREAD_ENTRY * thread_p, XASL_NODE * xasl, VAL_DESCR * vd);
+static int qexec_setup_join_filter (THREAD_ENTRY * thread_p, XASL_NODE * build_xasl, int *build_columns,
+				    XASL_NODE * probe_xasl, int *probe_columns, int column_cnt);
+static ATTR_ID qexec_get_fetched_attr_id (REGU_VARIABLE_LIST regu_list, DB_VALUE * dbval);
+static TOPN_TUPLES *qexec_alloc_topn_tuples (THREAD_ENTRY * thread_p, SORT_LIST * sort_items, int ubound,
+					     int values_count, UINT64 max_size);
+static void qexec_free_topn_tuples (THREAD_ENTRY * thread_p, TOPN_TUPLES * topn_items);
+static int qexec_orderby_topn_list (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state,
+				    OUTPTR_LIST * outptr_list, bool * is_done);
 static BH_CMP_RESULT qexec_topn_compare (const void *left, const void *right, BH_CMP_ARG arg);
 static BH_CMP_RESULT qexec_topn_cmpval (DB_VALUE * left, DB_VALUE * right, SORT_LIST * sort_spec);
 static TOPN_STATUS qexec_add_tuple_to_topn (THREAD_ENTRY * thread_p, TOPN_TUPLES * sort_stop,
 					    QFILE_TUPLE_DESCRIPTOR * tpldescr);
 static int qexec_topn_tuples_to_list_id (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state,
-					 bool is_final);
+					 OUTPTR_LIST * outptr_list, bool is_final);
 static void qexec_clear_topn_tuple (THREAD_ENTRY * thread_p, TOPN_TUPLE * tuple, int count);
 static int qexec_get_orderbynum_upper_bound (THREAD_ENTRY * tread_p, PRED_EXPR * pred, VAL_DESCR * vd,
 					     DB_VALUE * ubound);
@@ -686,6 +723,8 @@ static void qexec_set_xasl_trace_to_session (THREAD_ENTRY * thread_p, XASL_NODE
 #endif /* SERVER_MODE */
 
 static int qexec_alloc_agg_hash_context (THREAD_ENTRY * thread_p, BUILDLIST_PROC_NODE * proc, XASL_STATE * xasl_state);
+static QFILE_LIST_ID *qexec_open_agg_hash_part_list (THREAD_ENTRY * thread_p, QFILE_TUPLE_VALUE_TYPE_LIST * type_list,
+						     QUERY_ID query_id);
 static void qexec_free_agg_hash_context (THREAD_ENTRY * thread_p, BUILDLIST_PROC_NODE * proc);
 static int qexec_build_agg_hkey (THREAD_ENTRY * thread_p, XASL_STATE * xasl_state, REGU_VARIABLE_LIST regu_list,
 				 QFILE_TUPLE tpl, AGGREGATE_HASH_KEY * key);
@@ -1201,7 +1240,7 @@ qexec_end_one_iteration (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE *
 		{
 		  GOTO_EXIT_ON_ERROR;
 		}
-	      if (qexec_topn_tuples_to_list_id (thread_p, xasl, xasl_state, false) != NO_ERROR)
+	      if (qexec_topn_tuples_to_list_id (thread_p, xasl, xasl_state, xasl->outptr_list, false) != NO_ERROR)
 		{
 		  GOTO_EXIT_ON_ERROR;
 		}
@@ -1262,7 +1301,7 @@ qexec_end_one_iteration (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE *
       if (xasl->topn_items != NULL && tpldescr_status != QPROC_TPLDESCR_SUCCESS)
 	{
 	  /* abandon top-n processing */
-	  if (qexec_topn_tuples_to_list_id (thread_p, xasl, xasl_state, false) != NO_ERROR)
+	  if (qexec_topn_tuples_to_list_id (thread_p, xasl, xasl_state, xasl->outptr_list, false) != NO_ERROR)
 	    {
 	      GOTO_EXIT_ON_ERROR;
 	    }
@@ -1826,6 +1865,12 @@ qexec_clear_access_spec_list (THREAD_ENTRY * thread_p, XASL_NODE * xasl_p, ACCES
       pg_cnt += qexec_clear_pred (thread_p, xasl_p, p->where_key, is_final);
       pg_cnt += qexec_clear_pred (thread_p, xasl_p, p->where_range, is_final);
       pr_clear_value (p->s_id.join_dbval);
+      if (p->join_filter != NULL)
+	{
+	  scan_join_filter_destroy (thread_p, p->join_filter);
+	  p->join_filter = NULL;
+	  p->s_id.join_filter = NULL;
+	}
       switch (p->s_id.type)
 	{
 	case S_HEAP_SCAN:
@@ -1955,7 +2000,7 @@ qexec_clear_access_spec_list (THREAD_ENTRY * thread_p, XASL_NODE * xasl_p, ACCES
 	  pg_cnt += qexec_clear_regu_list (thread_p, xasl_p, p->s.cls_node.cls_regu_list_rest, is_final);
 	  if (p->access == ACCESS_METHOD_INDEX)
 	    {
-	      INDX_INFO *indx_info;
+	      INDX_INFO *indx_info, *bitmap_info;
 
 	      indx_info = p->indexptr;
 	      if (indx_info)
@@ -1979,6 +2024,18 @@ qexec_clear_access_spec_list (THREAD_ENTRY * thread_p, XASL_NODE * xasl_p, ACCES
 		      pg_cnt += qexec_clear_regu_var (thread_p, xasl_p, indx_info->key_info.key_limit_u, is_final);
 		    }
 
+		  /* key ranges of the other indexes of a bitmap index scan */
+		  for (bitmap_info = indx_info->bitmap_next; bitmap_info != NULL; bitmap_info = bitmap_info->bitmap_next)
+		    {
+		      for (i = 0; i < bitmap_info->key_info.key_cnt; i++)
+			{
+			  pg_cnt +=
+			    qexec_clear_regu_var (thread_p, xasl_p, bitmap_info->key_info.key_ranges[i].key1, is_final);
+			  pg_cnt +=
+			    qexec_clear_regu_var (thread_p, xasl_p, bitmap_info->key_info.key_ranges[i].key2, is_final);
+			}
+		    }
+
 		  /* Restore the BTID for future usages (needed for partition cases). */
 		  /* XASL comes from the client with the btid set to the root class of the partitions hierarchy.
 		   * Scan begins and starts with the rootclass, then jumps to a partition and sets the btid in the
@@ -2275,26 +2332,8 @@ qexec_clear_xasl (THREAD_ENTRY * thread_p, xasl_node * xasl, bool is_final)
 	}
       if (xasl->topn_items != NULL)
 	{
-	  int i;
-	  BINARY_HEAP *heap;
-
-	  heap = xasl->topn_items->heap;
-	  for (i = 0; i < heap->element_count; i++)
-	    {
-	      qexec_clear_topn_tuple (thread_p, QEXEC_GET_BH_TOPN_TUPLE (heap, i), xasl->topn_items->values_count);
-	    }
-
-	  if (heap != NULL)
-	    {
-	      bh_destroy (thread_p, heap);
-	    }
-
-	  if (xasl->topn_items->tuples != NULL)
-	    {
-	      db_private_free_and_init (thread_p, xasl->topn_items->tuples);
-	    }
-
-	  db_private_free_and_init (thread_p, xasl->topn_items);
+	  qexec_free_topn_tuples (thread_p, xasl->topn_items);
+	  xasl->topn_items = NULL;
 	}
 
       // clear trace stats
@@ -3145,7 +3184,7 @@ qexec_orderby_distinct (THREAD_ENTRY * thread_p, XASL_NODE * xasl, QUERY_OPTIONS
   if (xasl->topn_items != NULL)
     {
       /* already sorted, just dump tuples to list */
-      error = qexec_topn_tuples_to_list_id (thread_p, xasl, xasl_state, true);
+      error = qexec_topn_tuples_to_list_id (thread_p, xasl, xasl_state, xasl->outptr_list, true);
     }
   else
     {
@@ -3241,6 +3280,24 @@ qexec_orderby_distinct_by_sorting (THREAD_ENTRY * thread_p, XASL_NODE * xasl, QU
 
   memset (&ordby_info, 0, sizeof (ORDBYNUM_INFO));
 
+  if (option != Q_DISTINCT && ordbynum_val != NULL)
+    {
+      bool is_done = false;
+
+      /* ORDER BY ... LIMIT over a list that was not produced through the top-N heap (grouped or analytic results,
+       * or plans for which qexec_setup_topn_proc gave up): try to keep only the first tuples in memory. */
+      error = qexec_orderby_topn_list (thread_p, xasl, xasl_state, outptr_list, &is_done);
+      if (error != NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
+      if (is_done)
+	{
+	  xasl->orderby_stats.orderby_filesort = false;
+	  return NO_ERROR;
+	}
+    }
+
   /* sort the result list file */
   /* form the linked list of sort type items */
   if (option != Q_DISTINCT)
@@ -3836,7 +3893,17 @@ qexec_hash_gby_agg_tuple (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE
     }
 
   /* keep hash table within memory limit */
-  while (context->hash_size > (int) mem_limit)
+  if (context->use_partitions && context->hash_size > (int) mem_limit)
+    {
+      /* spill all groups to hash partitions; they are aggregated one partition at a time in qexec_groupby */
+      rc = qexec_hash_gby_spill_htable (thread_p, context, &groupby_list->type_list, xasl_state->query_id);
+      if (rc != NO_ERROR)
+	{
+	  return rc;
+	}
+    }
+
+  while (!context->use_partitions && context->hash_size > (int) mem_limit)
     {
       /* get least recently used entry */
       hentry = context->hash_table->lru_head;
@@ -3876,8 +3943,8 @@ qexec_hash_gby_agg_tuple (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE
       mht_rem (context->hash_table, key, qdata_free_agg_hentry, NULL);
     }
 
-  /* check very high selectivity case */
-  if (context->tuple_count > HASH_AGGREGATE_VH_SELECTIVITY_TUPLE_THRESHOLD)
+  /* check very high selectivity case; partitioned aggregation handles it by spilling */
+  if (!context->use_partitions && context->tuple_count > HASH_AGGREGATE_VH_SELECTIVITY_TUPLE_THRESHOLD)
     {
       float selectivity = (float) context->group_count / context->tuple_count;
       if (selectivity > HASH_AGGREGATE_VH_SELECTIVITY_THRESHOLD)
@@ -4072,627 +4139,1268 @@ qexec_hash_gby_put_next (THREAD_ENTRY * thread_p, const RECDES * recdes, void *a
 }
 
 /*
- * qexec_gby_get_next () -
- *   return:
- *   recdes(in) :
- *   arg(in)    :
+ * qexec_hash_gby_open_partitions () - open list files for hash aggregate partitions
+ *   return: error code or NO_ERROR
+ *   thread_p(in): thread
+ *   tuple_type_list(in): type list of first tuples list files
+ *   part_type_list(in): type list of partial accumulators list files
+ *   query_id(in): query identifier
+ *   tuple_lists(out): first tuples list files, one for each partition
+ *   part_lists(out): partial accumulators list files, one for each partition
  */
-static SORT_STATUS
-qexec_gby_get_next (THREAD_ENTRY * thread_p, RECDES * recdes, void *arg)
+static int
+qexec_hash_gby_open_partitions (THREAD_ENTRY * thread_p, QFILE_TUPLE_VALUE_TYPE_LIST * tuple_type_list,
+				QFILE_TUPLE_VALUE_TYPE_LIST * part_type_list, QUERY_ID query_id,
+				QFILE_LIST_ID ** tuple_lists, QFILE_LIST_ID ** part_lists)
 {
-  GROUPBY_STATE *gbstate;
+  int i, error_code = NO_ERROR;
 
-  gbstate = (GROUPBY_STATE *) arg;
+  for (i = 0; i < HASH_AGGREGATE_SPILL_PARTITIONS; i++)
+    {
+      tuple_lists[i] = NULL;
+      part_lists[i] = NULL;
+    }
 
-  return qfile_make_sort_key (thread_p, &gbstate->key_info, recdes, gbstate->input_scan, &gbstate->input_tpl);
+  for (i = 0; i < HASH_AGGREGATE_SPILL_PARTITIONS; i++)
+    {
+      tuple_lists[i] = qfile_open_list (thread_p, tuple_type_list, NULL, query_id, 0);
+      part_lists[i] = qexec_open_agg_hash_part_list (thread_p, part_type_list, query_id);
+      if (tuple_lists[i] == NULL || part_lists[i] == NULL)
+	{
+	  qexec_hash_gby_destroy_partitions (thread_p, tuple_lists, part_lists);
+
+	  ASSERT_ERROR_AND_SET (error_code);
+	  return error_code;
+	}
+    }
+
+  return NO_ERROR;
 }
 
 /*
- * qexec_gby_put_next () -
- *   return:
- *   recdes(in) :
- *   arg(in)    :
+ * qexec_hash_gby_destroy_partitions () - destroy list files of hash aggregate partitions
+ *   thread_p(in): thread
+ *   tuple_lists(in/out): first tuples list files
+ *   part_lists(in/out): partial accumulators list files
  */
-static int
-qexec_gby_put_next (THREAD_ENTRY * thread_p, const RECDES * recdes, void *arg)
+static void
+qexec_hash_gby_destroy_partitions (THREAD_ENTRY * thread_p, QFILE_LIST_ID ** tuple_lists, QFILE_LIST_ID ** part_lists)
 {
-  GROUPBY_STATE *info;
-  SORT_REC *key;
-  char *data;
-  PAGE_PTR page;
-  VPID vpid;
-  int peek, i, rollup_level;
-  QFILE_LIST_ID *list_idp;
+  int i;
 
-  QFILE_TUPLE_RECORD dummy;
-  int status;
+  for (i = 0; i < HASH_AGGREGATE_SPILL_PARTITIONS; i++)
+    {
+      if (tuple_lists[i] != NULL)
+	{
+	  qfile_close_list (thread_p, tuple_lists[i]);
+	  qfile_destroy_list (thread_p, tuple_lists[i]);
+	  QFILE_FREE_AND_INIT_LIST_ID (tuple_lists[i]);
+	}
 
-  info = (GROUPBY_STATE *) arg;
-  list_idp = &(info->input_scan->list_id);
+      if (part_lists[i] != NULL)
+	{
+	  qfile_close_list (thread_p, part_lists[i]);
+	  qfile_destroy_list (thread_p, part_lists[i]);
+	  QFILE_FREE_AND_INIT_LIST_ID (part_lists[i]);
+	}
+    }
+}
 
-  data = NULL;
-  page = NULL;
+/*
+ * qexec_hash_gby_spill_htable () - move all groups of the hash table to hash partitions
+ *   return: error code or NO_ERROR
+ *   thread_p(in): thread
+ *   context(in): hash context
+ *   tuple_type_list(in): type list of the tuples stored as first tuples of groups
+ *   query_id(in): query identifier
+ *
+ * NOTE: Each group is spilled as its first tuple and, if other tuples were aggregated already, its partial
+ *       accumulators. Both go to the partition chosen by the lowest bits of the key hash, so all the information
+ *       about a group key is found in the same partition, no matter how many times it was spilled. The hash table
+ *       is cleared.
+ */
+static int
+qexec_hash_gby_spill_htable (THREAD_ENTRY * thread_p, AGGREGATE_HASH_CONTEXT * context,
+			     QFILE_TUPLE_VALUE_TYPE_LIST * tuple_type_list, QUERY_ID query_id)
+{
+  AGGREGATE_HASH_KEY *key;
+  AGGREGATE_HASH_VALUE *value;
+  HENTRY_PTR head;
+  int part, rc;
 
-  /* Traverse next link */
-  for (key = (SORT_REC *) recdes->data; key; key = key->next)
+  assert (context->use_partitions);
+
+  if (context->spill_tuple_lists == NULL)
     {
-      if (info->state != NO_ERROR)
+      /* first spill; create partitions */
+      context->spill_tuple_lists =
+	(QFILE_LIST_ID **) db_private_alloc (thread_p, sizeof (QFILE_LIST_ID *) * HASH_AGGREGATE_SPILL_PARTITIONS);
+      context->spill_part_lists =
+	(QFILE_LIST_ID **) db_private_alloc (thread_p, sizeof (QFILE_LIST_ID *) * HASH_AGGREGATE_SPILL_PARTITIONS);
+      if (context->spill_tuple_lists == NULL || context->spill_part_lists == NULL)
 	{
-	  goto exit_on_error;
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
+		  sizeof (QFILE_LIST_ID *) * HASH_AGGREGATE_SPILL_PARTITIONS);
+	  return ER_OUT_OF_VIRTUAL_MEMORY;
 	}
 
-      peek = COPY;		/* default */
-      if (info->key_info.use_original)
-	{			/* P_sort_key */
-	  /*
-	   * Retrieve the original tuple.  This will be the case if the
-	   * original tuple had more fields than we were sorting on.
-	   */
-	  vpid.pageid = key->s.original.pageid;
-	  vpid.volid = key->s.original.volid;
+      rc = qexec_hash_gby_open_partitions (thread_p, tuple_type_list, &context->part_list_id->type_list, query_id,
+					   context->spill_tuple_lists, context->spill_part_lists);
+      if (rc != NO_ERROR)
+	{
+	  db_private_free_and_init (thread_p, context->spill_tuple_lists);
+	  db_private_free_and_init (thread_p, context->spill_part_lists);
+	  return rc;
+	}
+    }
 
-#if 0				/* SortCache */
-	  /* check if page is already fixed */
-	  if (VPID_EQ (&(info->fixed_vpid), &vpid))
+  for (head = context->hash_table->act_head; head != NULL; head = head->act_next)
+    {
+      key = (AGGREGATE_HASH_KEY *) head->key;
+      value = (AGGREGATE_HASH_VALUE *) head->data;
+      part = HASH_AGGREGATE_SPILL_PARTITION (key, 0);
+
+      /* groups are always created with their first tuple when partitions are used */
+      assert (value->first_tuple.tpl != NULL);
+      rc = qfile_add_tuple_to_list (thread_p, context->spill_tuple_lists[part], value->first_tuple.tpl);
+      if (rc != NO_ERROR)
+	{
+	  return rc;
+	}
+
+      if (value->tuple_count > 0)
+	{
+	  rc = qdata_save_agg_hentry_to_list (thread_p, key, value, context->temp_dbval_array,
+					      context->spill_part_lists[part]);
+	  if (rc != NO_ERROR)
 	    {
-	      /* use cached page pointer */
-	      page = info->fixed_page;
+	      return rc;
 	    }
-	  else
-	    {
-	      /* free currently fixed page */
-	      if (info->fixed_page != NULL)
-		{
-		  qmgr_free_old_page_and_init (info->fixed_page, list_idp->tfile_vfid);
-		}
+	}
+    }
 
-	      /* fix page and cache fixed vpid */
-	      page = qmgr_get_old_page (&vpid, list_idp->tfile_vfid);
-	      if (page == NULL)
-		{
-		  goto exit_on_error;
-		}
+#if !defined(NDEBUG)
+  er_log_debug (ARG_FILE_LINE, "hash aggregation overflow: spilled %d groups (%.2fKB) to partitions",
+		mht_count (context->hash_table), context->hash_size / 1024.0f);
+#endif
 
-	      /* save page pointer */
-	      info->fixed_vpid = vpid;
-	      info->fixed_page = page;
-	    }			/* else */
-#else
-	  page = qmgr_get_old_page (thread_p, &vpid, list_idp->tfile_vfid);
-	  if (page == NULL)
+  rc = mht_clear (context->hash_table, qdata_free_agg_hentry, (void *) thread_p);
+  if (rc != NO_ERROR)
+    {
+      return rc;
+    }
+
+  context->hash_size = 0;
+  context->spill_count++;
+  context->state = HS_PARTITIONED;
+
+  return NO_ERROR;
+}
+
+/*
+ * qexec_hash_gby_unspill_partitions () - move the content of hash partitions to the lists used by sort-based
+ *                                        aggregation
+ *   return: error code or NO_ERROR
+ *   thread_p(in): thread
+ *   context(in): hash context
+ *   tuple_list_id(in): unsorted list, opened in append mode
+ *
+ * NOTE: This is the fallback used when the unsorted list is not empty (e.g. tuples with set types or big records
+ *       skipped hash aggregation) and the output has to be generated by sorting anyway.
+ */
+static int
+qexec_hash_gby_unspill_partitions (THREAD_ENTRY * thread_p, AGGREGATE_HASH_CONTEXT * context,
+				   QFILE_LIST_ID * tuple_list_id)
+{
+  QFILE_LIST_SCAN_ID scan_id;
+  QFILE_TUPLE_RECORD tuple_rec = { NULL, 0 };
+  QFILE_LIST_ID *src_list, *dest_list;
+  SCAN_CODE sc;
+  int i, j, rc = NO_ERROR;
+
+  if (context->spill_tuple_lists == NULL)
+    {
+      return NO_ERROR;
+    }
+
+  for (i = 0; i < HASH_AGGREGATE_SPILL_PARTITIONS && rc == NO_ERROR; i++)
+    {
+      for (j = 0; j < 2 && rc == NO_ERROR; j++)
+	{
+	  src_list = (j == 0 ? context->spill_tuple_lists[i] : context->spill_part_lists[i]);
+	  dest_list = (j == 0 ? tuple_list_id : context->part_list_id);
+	  if (src_list->tuple_cnt == 0)
 	    {
-	      goto exit_on_error;
+	      continue;
 	    }
-#endif
 
-	  QFILE_GET_OVERFLOW_VPID (&vpid, page);
-	  data = page + key->s.original.offset;
-	  if (vpid.pageid != NULL_PAGEID)
+	  qfile_close_list (thread_p, src_list);
+	  if (qfile_open_list_scan (src_list, &scan_id) != NO_ERROR)
 	    {
-	      /*
-	       * This sucks; why do we need two different structures to
-	       * accomplish exactly the same goal?
-	       */
-	      dummy.size = info->gby_rec.area_size;
-	      dummy.tpl = info->gby_rec.data;
-	      status = qfile_get_tuple (thread_p, page, data, &dummy, list_idp);
+	      ASSERT_ERROR_AND_SET (rc);
+	      break;
+	    }
 
-	      if (dummy.tpl != info->gby_rec.data)
-		{
-		  /*
-		   * DON'T FREE THE BUFFER!  qfile_get_tuple() already did
-		   * that, and what you have here in gby_rec is a dangling
-		   * pointer.
-		   */
-		  info->gby_rec.area_size = dummy.size;
-		  info->gby_rec.data = dummy.tpl;
-		}
-	      if (status != NO_ERROR)
+	  while ((sc = qfile_scan_list_next (thread_p, &scan_id, &tuple_rec, PEEK)) == S_SUCCESS)
+	    {
+	      rc = qfile_add_tuple_to_list (thread_p, dest_list, tuple_rec.tpl);
+	      if (rc != NO_ERROR)
 		{
-		  goto exit_on_error;
+		  break;
 		}
-
-	      data = info->gby_rec.data;
-	    }
-	  else
-	    {
-	      peek = PEEK;	/* avoid unnecessary COPY */
 	    }
-	}
-      else
-	{			/* A_sort_key */
-	  /*
-	   * We didn't record the original vpid, and we should just
-	   * reconstruct the original record from this sort key (rather
-	   * than pressure the page buffer pool by reading in the original
-	   * page to get the original tuple).
-	   */
-	  if (qfile_generate_sort_tuple (&info->key_info, key, &info->gby_rec) == NULL)
+	  if (sc == S_ERROR)
 	    {
-	      goto exit_on_error;
+	      ASSERT_ERROR_AND_SET (rc);
 	    }
-	  data = info->gby_rec.data;
+
+	  qfile_close_scan (thread_p, &scan_id);
 	}
+    }
 
-      if (info->input_recs == 0)
-	{
-	  /*
-	   * First record we've seen; put it out and set up the group
-	   * comparison key(s).
-	   */
-	  qexec_gby_start_group_dim (thread_p, info, recdes);
+  qexec_hash_gby_destroy_partitions (thread_p, context->spill_tuple_lists, context->spill_part_lists);
+  db_private_free_and_init (thread_p, context->spill_tuple_lists);
+  db_private_free_and_init (thread_p, context->spill_part_lists);
 
-	  /* check partial list file */
-	  if (info->hash_eligible && info->agg_hash_context->part_scan_code == S_SUCCESS)
-	    {
-	      AGGREGATE_HASH_VALUE *hvalue = info->agg_hash_context->curr_part_value;
-	      bool found = false;
+  return rc;
+}
 
-	      /* build key for current */
-	      if (qexec_build_agg_hkey (thread_p, info->xasl_state, info->g_hk_regu_list, data,
-					info->agg_hash_context->temp_key) != NO_ERROR)
-		{
-		  goto exit_on_error;
-		}
-
-	      /* search in partial list */
-	      if (qexec_locate_agg_hentry_in_list (thread_p, info->agg_hash_context, info->agg_hash_context->temp_key,
-						   &found) != NO_ERROR)
-		{
-		  goto exit_on_error;
-		}
-
-	      /* if found, load it */
-	      if (found)
-		{
-		  /* increment record count */
-		  info->input_recs += hvalue->tuple_count;
-
-		  /* replace aggregate accumulators */
-		  qdata_load_agg_hvalue_in_agg_list (hvalue, info->g_dim[0].d_agg_list, false);
+/*
+ * qexec_hash_gby_output_htable () - generate output groups from the hash table
+ *   return: error code or NO_ERROR
+ *   thread_p(in): thread
+ *   gbstate(in): group by state
+ *
+ * NOTE: All groups must have their first tuple stored in the hash table, which is the case when the unsorted list
+ *       file is empty.
+ */
+static int
+qexec_hash_gby_output_htable (THREAD_ENTRY * thread_p, GROUPBY_STATE * gbstate)
+{
+  HENTRY_PTR head = gbstate->agg_hash_context->hash_table->act_head;
+  AGGREGATE_HASH_VALUE *value = NULL;
 
-		  if (info->with_rollup)
-		    {
-		      for (i = 1; i < info->g_dim_levels; i++)
-			{
-			  /* replace accumulators for restarted rollup groups */
-			  qdata_load_agg_hvalue_in_agg_list (hvalue, info->g_dim[i].d_agg_list, true);
-			}
-		    }
-		}
-	    }
-	}
-      else if ((*info->cmp_fn) (&info->current_key.data, &key, &info->key_info) == 0)
+  while (head)
+    {
+      /* load entry into aggregate list */
+      value = (AGGREGATE_HASH_VALUE *) head->data;
+      if (value == NULL)
 	{
-	  /*
-	   * Still in the same group; accumulate the tuple and proceed,
-	   * leaving the group key the same.
-	   */
+	  /* should not happen */
+	  assert (false);
+	  return ER_FAILED;
 	}
-      else
-	{
-	  /*
-	   * We got a new group; finalize the group we were accumulating,
-	   * and start a new group using the current key as the group key.
-	   */
-	  rollup_level = qexec_gby_finalize_group_dim (thread_p, info, recdes);
-	  if (info->state == SORT_PUT_STOP)
-	    {
-	      goto wrapup;
-	    }
-
-	  /* check partial list file */
-	  if (info->hash_eligible && info->agg_hash_context->part_scan_code == S_SUCCESS)
-	    {
-	      AGGREGATE_HASH_VALUE *hvalue = info->agg_hash_context->curr_part_value;
-	      bool found = false;
-
-	      /* build key for current */
-	      if (qexec_build_agg_hkey (thread_p, info->xasl_state, info->g_hk_regu_list, data,
-					info->agg_hash_context->temp_key) != NO_ERROR)
-		{
-		  goto exit_on_error;
-		}
-
-	      /* search in partial list */
-	      if (qexec_locate_agg_hentry_in_list (thread_p, info->agg_hash_context, info->agg_hash_context->temp_key,
-						   &found) != NO_ERROR)
-		{
-		  goto exit_on_error;
-		}
 
-	      /* if found, load it */
-	      if (found)
-		{
-		  /* increment record count */
-		  info->input_recs += hvalue->tuple_count;
+      if (value->first_tuple.tpl == NULL)
+	{
+	  /* empty unsorted list and no first tuple? this should not happen ... */
+	  assert (false);
+	  return ER_FAILED;
+	}
 
-		  /* replace aggregate accumulators */
-		  qdata_load_agg_hvalue_in_agg_list (hvalue, info->g_dim[0].d_agg_list, false);
+      /* start new group and aggregate tuple; since unsorted list is empty we don't have rollup groups */
+      qexec_gby_start_group_dim (thread_p, gbstate, NULL);
 
-		  if (info->with_rollup)
-		    {
-		      /* replace accumulators for restarted rollup groups */
-		      for (i = rollup_level; i < info->g_dim_levels; i++)
-			{
-			  qdata_load_agg_hvalue_in_agg_list (hvalue, info->g_dim[i].d_agg_list, true);
-			}
+      /* load values in list and aggregate first tuple */
+      qdata_load_agg_hvalue_in_agg_list (value, gbstate->g_dim[0].d_agg_list, false);
+      qexec_gby_agg_tuple (thread_p, gbstate, value->first_tuple.tpl, PEEK);
 
-		      /* compose accumulators for active rollup groups */
-		      for (i = 1; i < rollup_level; i++)
-			{
-			  AGGREGATE_ACCUMULATOR *acc = hvalue->accumulators;
-			  AGGREGATE_TYPE *ru_agg_list = info->g_dim[i].d_agg_list;
-			  int j = 0;
+      /* finalize */
+      qexec_gby_finalize_group_dim (thread_p, gbstate, NULL);
+      if (gbstate->state != NO_ERROR)
+	{
+	  return gbstate->state;
+	}
 
-			  while (ru_agg_list)
-			    {
-			      if (qdata_aggregate_accumulator_to_accumulator (thread_p, &ru_agg_list->accumulator,
-									      &ru_agg_list->accumulator_domain,
-									      ru_agg_list->function,
-									      ru_agg_list->domain, &acc[j]) != NO_ERROR)
-				{
-				  goto exit_on_error;
-				}
+      /* next entry */
+      head = head->act_next;
+      gbstate->input_recs += value->tuple_count + 1;
+    }
 
-			      ru_agg_list = ru_agg_list->next;
-			      j++;
-			    }
-			}
-		    }
-		}
-	    }
-	}
+  return NO_ERROR;
+}
 
-      /* aggregate tuple */
-      qexec_gby_agg_tuple (thread_p, info, data, peek);
+/*
+ * qexec_hash_gby_finalize_partitions () - generate output groups from hash partitions
+ *   return: error code or NO_ERROR
+ *   thread_p(in): thread
+ *   gbstate(in): group by state
+ */
+static int
+qexec_hash_gby_finalize_partitions (THREAD_ENTRY * thread_p, GROUPBY_STATE * gbstate)
+{
+  AGGREGATE_HASH_CONTEXT *context = gbstate->agg_hash_context;
+  int i, rc = NO_ERROR;
 
-      info->input_recs++;
+  assert (context->spill_count > 0 && context->spill_tuple_lists != NULL);
 
-#if 1				/* SortCache */
-      if (page)
+  /* groups still in memory are spilled too, each partition is then aggregated separately */
+  if (mht_count (context->hash_table) > 0)
+    {
+      rc = qexec_hash_gby_spill_htable (thread_p, context, &gbstate->xasl->list_id->type_list,
+					gbstate->xasl_state->query_id);
+      if (rc != NO_ERROR)
 	{
-	  qmgr_free_old_page_and_init (thread_p, page, list_idp->tfile_vfid);
+	  return rc;
 	}
-#endif
-
-    }				/* for (key = (SORT_REC *) recdes->data; ...) */
+    }
 
-wrapup:
-#if 1				/* SortCache */
-  if (page)
+  for (i = 0; i < HASH_AGGREGATE_SPILL_PARTITIONS; i++)
     {
-      qmgr_free_old_page_and_init (thread_p, page, list_idp->tfile_vfid);
+      rc = qexec_hash_gby_process_partition (thread_p, gbstate, context->spill_tuple_lists[i],
+					     context->spill_part_lists[i], 1);
+      if (rc != NO_ERROR)
+	{
+	  break;
+	}
     }
-#endif
 
-  return info->state;
+  qexec_hash_gby_destroy_partitions (thread_p, context->spill_tuple_lists, context->spill_part_lists);
+  db_private_free_and_init (thread_p, context->spill_tuple_lists);
+  db_private_free_and_init (thread_p, context->spill_part_lists);
 
-exit_on_error:
-  assert (er_errid () != NO_ERROR);
-  info->state = er_errid ();
-  goto wrapup;
+  return rc;
 }
 
 /*
- * qexec_groupby () -
- *   return: NO_ERROR, or ER_code
- *   xasl(in)   :
- *   xasl_state(in)     : XASL tree state information
- *   tplrec(out) : Tuple record descriptor to store result tuples
+ * qexec_hash_gby_process_partition () - aggregate the groups of a hash partition and output them
+ *   return: error code or NO_ERROR
+ *   thread_p(in): thread
+ *   gbstate(in): group by state
+ *   tuple_list(in): first tuples of groups in partition
+ *   part_list(in): partial accumulators of groups in partition
+ *   depth(in): partitioning depth
  *
- * Note: Apply the group_by clause to the given list file to group it
- * using the specified group_by parameters.
+ * NOTE: If the groups of the partition do not fit in memory, the partition is split again using the next bits
+ *       of the key hash and the resulting partitions are processed recursively.
  */
 static int
-qexec_groupby (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state, QFILE_TUPLE_RECORD * tplrec)
+qexec_hash_gby_process_partition (THREAD_ENTRY * thread_p, GROUPBY_STATE * gbstate, QFILE_LIST_ID * tuple_list,
+				  QFILE_LIST_ID * part_list, int depth)
 {
-  QFILE_LIST_ID *list_id = xasl->list_id;
-  BUILDLIST_PROC_NODE *buildlist = &xasl->proc.buildlist;
-  GROUPBY_STATE gbstate;
-  QFILE_LIST_SCAN_ID input_scan_id;
-  int ls_flag = 0;
-  int estimated_pages;
-
-  TSC_TICKS start_tick, end_tick;
-  TSCTIMEVAL tv_diff;
-
-  UINT64 old_sort_pages = 0, old_sort_ioreads = 0;
+  AGGREGATE_HASH_CONTEXT *context = gbstate->agg_hash_context;
+  BUILDLIST_PROC_NODE *proc = &gbstate->xasl->proc.buildlist;
+  XASL_STATE *xasl_state = gbstate->xasl_state;
+  UINT64 mem_limit = prm_get_bigint_value (PRM_ID_MAX_AGG_HASH_SIZE);
+  QFILE_LIST_SCAN_ID scan_id;
+  QFILE_TUPLE_RECORD tuple_rec = { NULL, 0 };
+  AGGREGATE_HASH_KEY *key = context->temp_key;
+  AGGREGATE_HASH_VALUE *value;
+  AGGREGATE_TYPE *agg_list;
+  SCAN_CODE sc;
+  bool overflow = false;
+  int i, rc = NO_ERROR;
 
-  if (buildlist->groupby_list == NULL)
+  if (tuple_list->tuple_cnt == 0)
     {
+      /* no groups in this partition */
+      assert (part_list->tuple_cnt == 0);
       return NO_ERROR;
     }
 
-  if (thread_is_on_trace (thread_p))
-    {
-      tsc_getticks (&start_tick);
-      xasl->groupby_stats.run_groupby = true;
-      xasl->groupby_stats.rows = 0;
-    }
+  assert (mht_count (context->hash_table) == 0);
 
-  /* initialize groupby_num() value */
-  if (buildlist->g_grbynum_val && DB_IS_NULL (buildlist->g_grbynum_val))
+  /* load first tuples of groups; a key spilled several times comes with several first tuples, only one is kept as
+   * first tuple and the others are aggregated */
+  qfile_close_list (thread_p, tuple_list);
+  if (qfile_open_list_scan (tuple_list, &scan_id) != NO_ERROR)
     {
-      db_make_bigint (buildlist->g_grbynum_val, 0);
+      ASSERT_ERROR_AND_SET (rc);
+      return rc;
     }
 
-  /* clear group by limit flags when skip group by is not used */
-  if (buildlist->g_grbynum_flag & XASL_G_GRBYNUM_FLAG_LIMIT_LT)
+  while ((sc = qfile_scan_list_next (thread_p, &scan_id, &tuple_rec, PEEK)) == S_SUCCESS)
     {
-      buildlist->g_grbynum_flag &= ~XASL_G_GRBYNUM_FLAG_LIMIT_LT;
+      rc = qexec_build_agg_hkey (thread_p, xasl_state, gbstate->g_hk_regu_list, tuple_rec.tpl, key);
+      if (rc != NO_ERROR)
+	{
+	  break;
+	}
+
+      value = (AGGREGATE_HASH_VALUE *) mht_get (context->hash_table, (void *) key);
+      if (value == NULL)
+	{
+	  AGGREGATE_HASH_KEY *new_key;
+	  int tuple_size = QFILE_GET_TUPLE_LENGTH (tuple_rec.tpl);
+
+	  new_key = qdata_copy_agg_hkey (thread_p, key);
+	  if (new_key == NULL)
+	    {
+	      ASSERT_ERROR_AND_SET (rc);
+	      break;
+	    }
+
+	  value = qdata_alloc_agg_hvalue (thread_p, proc->g_func_count, proc->g_agg_list);
+	  if (value == NULL)
+	    {
+	      qdata_free_agg_hkey (thread_p, new_key);
+	      ASSERT_ERROR_AND_SET (rc);
+	      break;
+	    }
+
+	  value->first_tuple.tpl = (QFILE_TUPLE) db_private_alloc (thread_p, tuple_size);
+	  if (value->first_tuple.tpl == NULL)
+	    {
+	      qdata_free_agg_hkey (thread_p, new_key);
+	      qdata_free_agg_hvalue (thread_p, value);
+	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, tuple_size);
+	      rc = ER_OUT_OF_VIRTUAL_MEMORY;
+	      break;
+	    }
+	  memcpy (value->first_tuple.tpl, tuple_rec.tpl, tuple_size);
+	  value->first_tuple.size = tuple_size;
+
+	  mht_put (context->hash_table, (void *) new_key, (void *) value);
+
+	  context->hash_size += qdata_get_agg_hkey_size (new_key);
+	  context->hash_size += qdata_get_agg_hvalue_size (value, false);
+	}
+      else
+	{
+	  /* aggregate tuple */
+	  rc = fetch_val_list (thread_p, gbstate->g_regu_list, &xasl_state->vd, NULL, NULL, tuple_rec.tpl, PEEK);
+	  if (rc == NO_ERROR)
+	    {
+	      rc = qdata_evaluate_aggregate_list (thread_p, proc->g_agg_list, &xasl_state->vd, value->accumulators);
+	    }
+	  if (rc != NO_ERROR)
+	    {
+	      break;
+	    }
+
+	  value->tuple_count++;
+	  context->hash_size += qdata_get_agg_hvalue_size (value, true);
+	}
+
+      if (context->hash_size > (int) mem_limit && depth < HASH_AGGREGATE_SPILL_MAX_DEPTH)
+	{
+	  /* partition does not fit in memory */
+	  overflow = true;
+	  break;
+	}
     }
-  if (buildlist->g_grbynum_flag & XASL_G_GRBYNUM_FLAG_LIMIT_GT_LT)
+  if (sc == S_ERROR)
     {
-      buildlist->g_grbynum_flag &= ~XASL_G_GRBYNUM_FLAG_LIMIT_GT_LT;
+      ASSERT_ERROR_AND_SET (rc);
     }
+  qfile_close_scan (thread_p, &scan_id);
 
-  /* late binding : resolve group_by (buildlist) */
-  if (xasl->outptr_list != NULL)
+  if (rc != NO_ERROR || overflow)
     {
-      qexec_resolve_domains_for_group_by (buildlist, xasl->outptr_list);
+      (void) mht_clear (context->hash_table, qdata_free_agg_hentry, (void *) thread_p);
+      context->hash_size = 0;
+
+      if (rc != NO_ERROR)
+	{
+	  return rc;
+	}
+
+#if !defined(NDEBUG)
+      er_log_debug (ARG_FILE_LINE, "hash aggregation: partition at depth %d does not fit in memory, split it", depth);
+#endif
+
+      return qexec_hash_gby_repartition (thread_p, gbstate, tuple_list, part_list, depth);
     }
 
-  if (qexec_initialize_groupby_state (&gbstate, buildlist->groupby_list, buildlist->g_having_pred,
-				      buildlist->g_grbynum_pred, buildlist->g_grbynum_val, buildlist->g_grbynum_flag,
-				      buildlist->eptr_list, buildlist->g_agg_list, buildlist->g_regu_list,
-				      buildlist->g_val_list, buildlist->g_outptr_list, buildlist->g_hk_sort_regu_list,
-				      buildlist->g_with_rollup != 0, buildlist->g_hash_eligible,
-				      buildlist->agg_hash_context, xasl, xasl_state, &list_id->type_list,
-				      tplrec) == NULL)
+  /* merge partial accumulators of spilled groups */
+  if (part_list->tuple_cnt > 0)
     {
-      GOTO_EXIT_ON_ERROR;
-    }
-
-  /*
-   * Create a new listfile to receive the results.
-   */
-  {
-    QFILE_TUPLE_VALUE_TYPE_LIST output_type_list;
-    QFILE_LIST_ID *output_list_id;
-
-    if (qdata_get_valptr_type_list (thread_p, buildlist->g_outptr_list, &output_type_list) != NO_ERROR)
-      {
-	GOTO_EXIT_ON_ERROR;
-      }
-    /* If it does not have 'order by'(xasl->orderby_list), then the list file to be open at here will be the last one.
-     * Otherwise, the last list file will be open at qexec_orderby_distinct(). (Note that only one that can have 'group
-     * by' is BUILDLIST_PROC type.) And, the top most XASL is the other condition for the list file to be the last
-     * result file. */
-
-    QFILE_SET_FLAG (ls_flag, QFILE_FLAG_ALL);
-    if (XASL_IS_FLAGED (xasl, XASL_TOP_MOST_XASL) && XASL_IS_FLAGED (xasl, XASL_TO_BE_CACHED)
-	&& (xasl->orderby_list == NULL || XASL_IS_FLAGED (xasl, XASL_SKIP_ORDERBY_LIST)) && xasl->option != Q_DISTINCT)
-      {
-	QFILE_SET_FLAG (ls_flag, QFILE_FLAG_RESULT_FILE);
-      }
-
-    output_list_id =
-      qfile_open_list (thread_p, &output_type_list, buildlist->after_groupby_list, xasl_state->query_id, ls_flag);
-    if (output_list_id == NULL)
-      {
-	if (output_type_list.domp)
-	  {
-	    db_private_free_and_init (thread_p, output_type_list.domp);
-	  }
-
-	GOTO_EXIT_ON_ERROR;
-      }
-
-    if (output_type_list.domp)
-      {
-	db_private_free_and_init (thread_p, output_type_list.domp);
-      }
-
-    gbstate.output_file = output_list_id;
-  }
-
-  /* check for quick finalization scenarios */
-  if (list_id->tuple_cnt == 0)
-    {
-      if (!gbstate.hash_eligible || gbstate.agg_hash_context->tuple_count == 0)
+      qfile_close_list (thread_p, part_list);
+      if (qfile_open_list_scan (part_list, &scan_id) != NO_ERROR)
 	{
-	  /* no tuples hash aggregated and empty unsorted list; no reason to continue */
-	  qfile_destroy_list (thread_p, list_id);
-	  qfile_close_list (thread_p, gbstate.output_file);
-	  qfile_copy_list_id (list_id, gbstate.output_file, true);
-	  qexec_clear_groupby_state (thread_p, &gbstate);
-
-	  return NO_ERROR;
+	  ASSERT_ERROR_AND_SET (rc);
+	  goto cleanup;
 	}
-      else if (gbstate.agg_hash_context->part_list_id->tuple_cnt == 0
-	       && !prm_get_bool_value (PRM_ID_AGG_HASH_RESPECT_ORDER))
+
+      while ((sc = qdata_load_agg_hentry_from_list (thread_p, &scan_id, context->temp_part_key,
+						    context->temp_part_value, context->key_domains,
+						    context->accumulator_domains)) == S_SUCCESS)
 	{
-	  HENTRY_PTR head = gbstate.agg_hash_context->hash_table->act_head;
-	  AGGREGATE_HASH_VALUE *value = NULL;
+	  value = (AGGREGATE_HASH_VALUE *) mht_get (context->hash_table, (void *) context->temp_part_key);
+	  if (value == NULL)
+	    {
+	      /* the first tuple of a group is always spilled to the same partition as its accumulators */
+	      assert (false);
+	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_QPROC_INVALID_XASLNODE, 0);
+	      rc = ER_QPROC_INVALID_XASLNODE;
+	      break;
+	    }
 
-	  /* empty unsorted list and empty partial list; we can generate the output from the hash table */
-	  while (head)
+	  for (agg_list = gbstate->g_output_agg_list, i = 0; agg_list != NULL; agg_list = agg_list->next, i++)
 	    {
-	      /* load entry into aggregate list */
-	      value = (AGGREGATE_HASH_VALUE *) head->data;
-	      if (value == NULL)
+	      rc = qdata_aggregate_accumulator_to_accumulator (thread_p, &value->accumulators[i],
+							       &agg_list->accumulator_domain, agg_list->function,
+							       agg_list->domain, &context->temp_part_value->accumulators[i]);
+	      if (rc != NO_ERROR)
 		{
-		  /* should not happen */
-		  GOTO_EXIT_ON_ERROR;
+		  break;
 		}
+	    }
+	  if (rc != NO_ERROR)
+	    {
+	      break;
+	    }
 
-	      if (value->first_tuple.tpl == NULL)
-		{
-		  /* empty unsorted list and no first tuple? this should not happen ... */
-		  GOTO_EXIT_ON_ERROR;
-		}
+	  value->tuple_count += context->temp_part_value->tuple_count;
+	}
+      if (sc == S_ERROR)
+	{
+	  ASSERT_ERROR_AND_SET (rc);
+	}
+      qfile_close_scan (thread_p, &scan_id);
 
-	      /* start new group and aggregate tuple; since unsorted list is empty we don't have rollup groups */
-	      qexec_gby_start_group_dim (thread_p, &gbstate, NULL);
+      if (rc != NO_ERROR)
+	{
+	  goto cleanup;
+	}
+    }
 
-	      /* load values in list and aggregate first tuple */
-	      qdata_load_agg_hvalue_in_agg_list (value, gbstate.g_dim[0].d_agg_list, false);
-	      qexec_gby_agg_tuple (thread_p, &gbstate, value->first_tuple.tpl, PEEK);
+  /* all groups of partition are complete */
+  rc = qexec_hash_gby_output_htable (thread_p, gbstate);
 
-	      /* finalize */
-	      qexec_gby_finalize_group_dim (thread_p, &gbstate, NULL);
+cleanup:
+  (void) mht_clear (context->hash_table, qdata_free_agg_hentry, (void *) thread_p);
+  context->hash_size = 0;
 
-	      /* next entry */
-	      head = head->act_next;
-	      gbstate.input_recs += value->tuple_count + 1;
-	    }
+  return rc;
+}
 
-	  /* output generated; finalize */
-	  qfile_destroy_list (thread_p, list_id);
-	  qfile_close_list (thread_p, gbstate.output_file);
-	  qfile_copy_list_id (list_id, gbstate.output_file, true);
+/*
+ * qexec_hash_gby_repartition () - split a hash partition that does not fit in memory
+ *   return: error code or NO_ERROR
+ *   thread_p(in): thread
+ *   gbstate(in): group by state
+ *   tuple_list(in): first tuples of groups in partition
+ *   part_list(in): partial accumulators of groups in partition
+ *   depth(in): depth of partition being split
+ */
+static int
+qexec_hash_gby_repartition (THREAD_ENTRY * thread_p, GROUPBY_STATE * gbstate, QFILE_LIST_ID * tuple_list,
+			    QFILE_LIST_ID * part_list, int depth)
+{
+  AGGREGATE_HASH_CONTEXT *context = gbstate->agg_hash_context;
+  QFILE_LIST_ID *sub_tuple_lists[HASH_AGGREGATE_SPILL_PARTITIONS];
+  QFILE_LIST_ID *sub_part_lists[HASH_AGGREGATE_SPILL_PARTITIONS];
+  QFILE_LIST_SCAN_ID scan_id;
+  QFILE_TUPLE_RECORD tuple_rec = { NULL, 0 };
+  SCAN_CODE sc;
+  int i, part, rc;
 
-	  goto wrapup;
-	}
+  rc = qexec_hash_gby_open_partitions (thread_p, &tuple_list->type_list, &part_list->type_list,
+				       gbstate->xasl_state->query_id, sub_tuple_lists, sub_part_lists);
+  if (rc != NO_ERROR)
+    {
+      return rc;
     }
 
-  if (thread_is_on_trace (thread_p))
+  /* split first tuples */
+  if (qfile_open_list_scan (tuple_list, &scan_id) != NO_ERROR)
     {
-      xasl->groupby_stats.groupby_sort = true;
-      old_sort_pages = perfmon_get_from_statistic (thread_p, PSTAT_SORT_NUM_DATA_PAGES);
-      old_sort_ioreads = perfmon_get_from_statistic (thread_p, PSTAT_SORT_NUM_IO_PAGES);
+      ASSERT_ERROR_AND_SET (rc);
+      goto cleanup;
     }
 
-  /* unsorted list is not empty; dump hash table to partial list */
-  if (gbstate.hash_eligible && gbstate.agg_hash_context->tuple_count > 0
-      && mht_count (gbstate.agg_hash_context->hash_table) > 0)
+  while ((sc = qfile_scan_list_next (thread_p, &scan_id, &tuple_rec, PEEK)) == S_SUCCESS)
     {
-      /* reopen unsorted list to accept new tuples */
-      if (qfile_reopen_list_as_append_mode (thread_p, list_id) != NO_ERROR)
+      rc = qexec_build_agg_hkey (thread_p, gbstate->xasl_state, gbstate->g_hk_regu_list, tuple_rec.tpl,
+				 context->temp_key);
+      if (rc != NO_ERROR)
 	{
-	  GOTO_EXIT_ON_ERROR;
+	  break;
 	}
 
-      /* save hash table */
-      if (qdata_save_agg_htable_to_list (thread_p, gbstate.agg_hash_context->hash_table, list_id,
-					 gbstate.agg_hash_context->part_list_id,
-					 gbstate.agg_hash_context->temp_dbval_array) != NO_ERROR)
+      part = HASH_AGGREGATE_SPILL_PARTITION (context->temp_key, depth);
+      rc = qfile_add_tuple_to_list (thread_p, sub_tuple_lists[part], tuple_rec.tpl);
+      if (rc != NO_ERROR)
 	{
-	  GOTO_EXIT_ON_ERROR;
+	  break;
 	}
-
-      /* close unsorted list */
-      qfile_close_list (thread_p, list_id);
     }
-
-  /* sort partial list and open a scan on it */
-  if (gbstate.hash_eligible && gbstate.agg_hash_context->part_list_id->tuple_cnt > 0)
+  if (sc == S_ERROR)
     {
-      SORT_CMP_FUNC *cmp_fn;
-
-      /* open scan on partial list */
-      if (qfile_open_list_scan (gbstate.agg_hash_context->part_list_id, &gbstate.agg_hash_context->part_scan_id) !=
-	  NO_ERROR)
-	{
-	  GOTO_EXIT_ON_ERROR;
-	}
+      ASSERT_ERROR_AND_SET (rc);
+    }
+  qfile_close_scan (thread_p, &scan_id);
 
-      estimated_pages =
-	qfile_get_estimated_pages_for_sorting (gbstate.agg_hash_context->part_list_id,
-					       &gbstate.agg_hash_context->sort_key);
+  if (rc != NO_ERROR)
+    {
+      goto cleanup;
+    }
 
-      /* choose appripriate sort function */
-      if (gbstate.agg_hash_context->sort_key.use_original)
-	{
-	  cmp_fn = &qfile_compare_partial_sort_record;
-	}
-      else
+  /* split partial accumulators */
+  if (part_list->tuple_cnt > 0)
+    {
+      qfile_close_list (thread_p, part_list);
+      if (qfile_open_list_scan (part_list, &scan_id) != NO_ERROR)
 	{
-	  cmp_fn = &qfile_compare_all_sort_record;
+	  ASSERT_ERROR_AND_SET (rc);
+	  goto cleanup;
 	}
 
-      /* sort and aggregate partial results */
-      if (sort_listfile (thread_p, NULL_VOLID, estimated_pages, &qexec_hash_gby_get_next, &gbstate,
-			 &qexec_hash_gby_put_next, &gbstate, cmp_fn, &gbstate.agg_hash_context->sort_key, SORT_DUP,
-			 NO_SORT_LIMIT) != NO_ERROR)
+      while ((sc = qfile_scan_list_next (thread_p, &scan_id, &tuple_rec, PEEK)) == S_SUCCESS)
 	{
-	  GOTO_EXIT_ON_ERROR;
-	}
+	  rc = qdata_load_agg_hentry_from_tuple (thread_p, tuple_rec.tpl, context->temp_part_key,
+						 context->temp_part_value, context->key_domains,
+						 context->accumulator_domains);
+	  if (rc != NO_ERROR)
+	    {
+	      break;
+	    }
 
-      /* write last group */
-      if (gbstate.agg_hash_context->sorted_count > 0)
-	{
-	  /* different key, write current accumulators */
-	  if (qdata_save_agg_hentry_to_list (thread_p, gbstate.agg_hash_context->curr_part_key,
-					     gbstate.agg_hash_context->curr_part_value,
-					     gbstate.agg_hash_context->temp_dbval_array,
-					     gbstate.agg_hash_context->sorted_part_list_id) != NO_ERROR)
+	  part = HASH_AGGREGATE_SPILL_PARTITION (context->temp_part_key, depth);
+	  rc = qfile_add_tuple_to_list (thread_p, sub_part_lists[part], tuple_rec.tpl);
+	  if (rc != NO_ERROR)
 	    {
-	      GOTO_EXIT_ON_ERROR;
+	      break;
 	    }
 	}
-
-      /* close scan */
-      qfile_close_scan (thread_p, &gbstate.agg_hash_context->part_scan_id);
-
-      /* partial list is no longer necessary */
-      qfile_close_list (thread_p, gbstate.agg_hash_context->part_list_id);
-      qfile_destroy_list (thread_p, gbstate.agg_hash_context->part_list_id);
-      qfile_free_list_id (gbstate.agg_hash_context->part_list_id);
-      gbstate.agg_hash_context->part_list_id = NULL;
-
-      /* reopen scan on newly sorted list */
-      if (qfile_open_list_scan (gbstate.agg_hash_context->sorted_part_list_id, &gbstate.agg_hash_context->part_scan_id)
-	  != NO_ERROR)
+      if (sc == S_ERROR)
 	{
-	  GOTO_EXIT_ON_ERROR;
+	  ASSERT_ERROR_AND_SET (rc);
 	}
+      qfile_close_scan (thread_p, &scan_id);
 
-      /* load first key */
-      gbstate.agg_hash_context->part_scan_code =
-	qdata_load_agg_hentry_from_list (thread_p, &gbstate.agg_hash_context->part_scan_id,
-					 gbstate.agg_hash_context->curr_part_key,
-					 gbstate.agg_hash_context->curr_part_value,
-					 gbstate.agg_hash_context->key_domains,
-					 gbstate.agg_hash_context->accumulator_domains);
-    }
-  else
-    {
-      /* empty partial list; probably set types or big records */
-      gbstate.agg_hash_context->part_scan_code = S_END;
+      if (rc != NO_ERROR)
+	{
+	  goto cleanup;
+	}
     }
 
-  /*
-   * Open a scan on the unsorted input file
-   */
-  if (qfile_open_list_scan (list_id, &input_scan_id) != NO_ERROR)
+  /* aggregate each sub-partition */
+  for (i = 0; i < HASH_AGGREGATE_SPILL_PARTITIONS; i++)
     {
-      GOTO_EXIT_ON_ERROR;
+      rc = qexec_hash_gby_process_partition (thread_p, gbstate, sub_tuple_lists[i], sub_part_lists[i], depth + 1);
+      if (rc != NO_ERROR)
+	{
+	  break;
+	}
     }
-  gbstate.input_scan = &input_scan_id;
 
-  /*
-   * Now load up the sort module and set it off...
-   */
-  gbstate.key_info.use_original = (gbstate.key_info.nkeys != list_id->type_list.type_cnt);
-  gbstate.cmp_fn =
-    (gbstate.key_info.use_original == 1 ? &qfile_compare_partial_sort_record : &qfile_compare_all_sort_record);
+cleanup:
+  qexec_hash_gby_destroy_partitions (thread_p, sub_tuple_lists, sub_part_lists);
 
-  if (XASL_IS_FLAGED (xasl, XASL_MULTI_UPDATE_AGG))
-    {
-#if defined (ENABLE_COMPOSITE_LOCK)
-      gbstate.composite_lock = &xasl->composite_lock;
-#endif /* defined (ENABLE_COMPOSITE_LOCK) */
-      gbstate.upd_del_class_cnt = xasl->upd_del_class_cnt;
-    }
-  else
-    {
-      gbstate.composite_lock = NULL;
-      gbstate.upd_del_class_cnt = 0;
-    }
+  return rc;
+}
 
-  estimated_pages = qfile_get_estimated_pages_for_sorting (list_id, &gbstate.key_info);
+/*
+ * qexec_gby_get_next () -
+ *   return:
+ *   recdes(in) :
+ *   arg(in)    :
+ */
+static SORT_STATUS
+qexec_gby_get_next (THREAD_ENTRY * thread_p, RECDES * recdes, void *arg)
+{
+  GROUPBY_STATE *gbstate;
 
-  if (sort_listfile (thread_p, NULL_VOLID, estimated_pages, &qexec_gby_get_next, &gbstate, &qexec_gby_put_next,
-		     &gbstate, gbstate.cmp_fn, &gbstate.key_info, SORT_DUP, NO_SORT_LIMIT) != NO_ERROR)
-    {
-      GOTO_EXIT_ON_ERROR;
-    }
+  gbstate = (GROUPBY_STATE *) arg;
 
-  /*
-   * There may be one unfinished group in the output, since the sort_listfile
-   * interface doesn't include a finalization function.  If so, finish
+  return qfile_make_sort_key (thread_p, &gbstate->key_info, recdes, gbstate->input_scan, &gbstate->input_tpl);
+}
+
+/*
+ * qexec_gby_put_next () -
+ *   return:
+ *   recdes(in) :
+ *   arg(in)    :
+ */
+static int
+qexec_gby_put_next (THREAD_ENTRY * thread_p, const RECDES * recdes, void *arg)
+{
+  GROUPBY_STATE *info;
+  SORT_REC *key;
+  char *data;
+  PAGE_PTR page;
+  VPID vpid;
+  int peek, i, rollup_level;
+  QFILE_LIST_ID *list_idp;
+
+  QFILE_TUPLE_RECORD dummy;
+  int status;
+
+  info = (GROUPBY_STATE *) arg;
+  list_idp = &(info->input_scan->list_id);
+
+  data = NULL;
+  page = NULL;
+
+  /* Traverse next link */
+  for (key = (SORT_REC *) recdes->data; key; key = key->next)
+    {
+      if (info->state != NO_ERROR)
+	{
+	  goto exit_on_error;
+	}
+
+      peek = COPY;		/* default */
+      if (info->key_info.use_original)
+	{			/* P_sort_key */
+	  /*
+	   * Retrieve the original tuple.  This will be the case if the
+	   * original tuple had more fields than we were sorting on.
+	   */
+	  vpid.pageid = key->s.original.pageid;
+	  vpid.volid = key->s.original.volid;
+
+#if 0				/* SortCache */
+	  /* check if page is already fixed */
+	  if (VPID_EQ (&(info->fixed_vpid), &vpid))
+	    {
+	      /* use cached page pointer */
+	      page = info->fixed_page;
+	    }
+	  else
+	    {
+	      /* free currently fixed page */
+	      if (info->fixed_page != NULL)
+		{
+		  qmgr_free_old_page_and_init (info->fixed_page, list_idp->tfile_vfid);
+		}
+
+	      /* fix page and cache fixed vpid */
+	      page = qmgr_get_old_page (&vpid, list_idp->tfile_vfid);
+	      if (page == NULL)
+		{
+		  goto exit_on_error;
+		}
+
+	      /* save page pointer */
+	      info->fixed_vpid = vpid;
+	      info->fixed_page = page;
+	    }			/* else */
+#else
+	  page = qmgr_get_old_page (thread_p, &vpid, list_idp->tfile_vfid);
+	  if (page == NULL)
+	    {
+	      goto exit_on_error;
+	    }
+#endif
+
+	  QFILE_GET_OVERFLOW_VPID (&vpid, page);
+	  data = page + key->s.original.offset;
+	  if (vpid.pageid != NULL_PAGEID)
+	    {
+	      /*
+	       * This sucks; why do we need two different structures to
+	       * accomplish exactly the same goal?
+	       */
+	      dummy.size = info->gby_rec.area_size;
+	      dummy.tpl = info->gby_rec.data;
+	      status = qfile_get_tuple (thread_p, page, data, &dummy, list_idp);
+
+	      if (dummy.tpl != info->gby_rec.data)
+		{
+		  /*
+		   * DON'T FREE THE BUFFER!  qfile_get_tuple() already did
+		   * that, and what you have here in gby_rec is a dangling
+		   * pointer.
+		   */
+		  info->gby_rec.area_size = dummy.size;
+		  info->gby_rec.data = dummy.tpl;
+		}
+	      if (status != NO_ERROR)
+		{
+		  goto exit_on_error;
+		}
+
+	      data = info->gby_rec.data;
+	    }
+	  else
+	    {
+	      peek = PEEK;	/* avoid unnecessary COPY */
+	    }
+	}
+      else
+	{			/* A_sort_key */
+	  /*
+	   * We didn't record the original vpid, and we should just
+	   * reconstruct the original record from this sort key (rather
+	   * than pressure the page buffer pool by reading in the original
+	   * page to get the original tuple).
+	   */
+	  if (qfile_generate_sort_tuple (&info->key_info, key, &info->gby_rec) == NULL)
+	    {
+	      goto exit_on_error;
+	    }
+	  data = info->gby_rec.data;
+	}
+
+      if (info->input_recs == 0)
+	{
+	  /*
+	   * First record we've seen; put it out and set up the group
+	   * comparison key(s).
+	   */
+	  qexec_gby_start_group_dim (thread_p, info, recdes);
+
+	  /* check partial list file */
+	  if (info->hash_eligible && info->agg_hash_context->part_scan_code == S_SUCCESS)
+	    {
+	      AGGREGATE_HASH_VALUE *hvalue = info->agg_hash_context->curr_part_value;
+	      bool found = false;
+
+	      /* build key for current */
+	      if (qexec_build_agg_hkey (thread_p, info->xasl_state, info->g_hk_regu_list, data,
+					info->agg_hash_context->temp_key) != NO_ERROR)
+		{
+		  goto exit_on_error;
+		}
+
+	      /* search in partial list */
+	      if (qexec_locate_agg_hentry_in_list (thread_p, info->agg_hash_context, info->agg_hash_context->temp_key,
+						   &found) != NO_ERROR)
+		{
+		  goto exit_on_error;
+		}
+
+	      /* if found, load it */
+	      if (found)
+		{
+		  /* increment record count */
+		  info->input_recs += hvalue->tuple_count;
+
+		  /* replace aggregate accumulators */
+		  qdata_load_agg_hvalue_in_agg_list (hvalue, info->g_dim[0].d_agg_list, false);
+
+		  if (info->with_rollup)
+		    {
+		      for (i = 1; i < info->g_dim_levels; i++)
+			{
+			  /* replace accumulators for restarted rollup groups */
+			  qdata_load_agg_hvalue_in_agg_list (hvalue, info->g_dim[i].d_agg_list, true);
+			}
+		    }
+		}
+	    }
+	}
+      else if ((*info->cmp_fn) (&info->current_key.data, &key, &info->key_info) == 0)
+	{
+	  /*
+	   * Still in the same group; accumulate the tuple and proceed,
+	   * leaving the group key the same.
+	   */
+	}
+      else
+	{
+	  /*
+	   * We got a new group; finalize the group we were accumulating,
+	   * and start a new group using the current key as the group key.
+	   */
+	  rollup_level = qexec_gby_finalize_group_dim (thread_p, info, recdes);
+	  if (info->state == SORT_PUT_STOP)
+	    {
+	      goto wrapup;
+	    }
+
+	  /* check partial list file */
+	  if (info->hash_eligible && info->agg_hash_context->part_scan_code == S_SUCCESS)
+	    {
+	      AGGREGATE_HASH_VALUE *hvalue = info->agg_hash_context->curr_part_value;
+	      bool found = false;
+
+	      /* build key for current */
+	      if (qexec_build_agg_hkey (thread_p, info->xasl_state, info->g_hk_regu_list, data,
+					info->agg_hash_context->temp_key) != NO_ERROR)
+		{
+		  goto exit_on_error;
+		}
+
+	      /* search in partial list */
+	      if (qexec_locate_agg_hentry_in_list (thread_p, info->agg_hash_context, info->agg_hash_context->temp_key,
+						   &found) != NO_ERROR)
+		{
+		  goto exit_on_error;
+		}
+
+	      /* if found, load it */
+	      if (found)
+		{
+		  /* increment record count */
+		  info->input_recs += hvalue->tuple_count;
+
+		  /* replace aggregate accumulators */
+		  qdata_load_agg_hvalue_in_agg_list (hvalue, info->g_dim[0].d_agg_list, false);
+
+		  if (info->with_rollup)
+		    {
+		      /* replace accumulators for restarted rollup groups */
+		      for (i = rollup_level; i < info->g_dim_levels; i++)
+			{
+			  qdata_load_agg_hvalue_in_agg_list (hvalue, info->g_dim[i].d_agg_list, true);
+			}
+
+		      /* compose accumulators for active rollup groups */
+		      for (i = 1; i < rollup_level; i++)
+			{
+			  AGGREGATE_ACCUMULATOR *acc = hvalue->accumulators;
+			  AGGREGATE_TYPE *ru_agg_list = info->g_dim[i].d_agg_list;
+			  int j = 0;
+
+			  while (ru_agg_list)
+			    {
+			      if (qdata_aggregate_accumulator_to_accumulator (thread_p, &ru_agg_list->accumulator,
+									      &ru_agg_list->accumulator_domain,
+									      ru_agg_list->function,
+									      ru_agg_list->domain, &acc[j]) != NO_ERROR)
+				{
+				  goto exit_on_error;
+				}
+
+			      ru_agg_list = ru_agg_list->next;
+			      j++;
+			    }
+			}
+		    }
+		}
+	    }
+	}
+
+      /* aggregate tuple */
+      qexec_gby_agg_tuple (thread_p, info, data, peek);
+
+      info->input_recs++;
+
+#if 1				/* SortCache */
+      if (page)
+	{
+	  qmgr_free_old_page_and_init (thread_p, page, list_idp->tfile_vfid);
+	}
+#endif
+
+    }				/* for (key = (SORT_REC *) recdes->data; ...) */
+
+wrapup:
+#if 1				/* SortCache */
+  if (page)
+    {
+      qmgr_free_old_page_and_init (thread_p, page, list_idp->tfile_vfid);
+    }
+#endif
+
+  return info->state;
+
+exit_on_error:
+  assert (er_errid () != NO_ERROR);
+  info->state = er_errid ();
+  goto wrapup;
+}
+
+/*
+ * qexec_groupby () -
+ *   return: NO_ERROR, or ER_code
+ *   xasl(in)   :
+ *   xasl_state(in)     : XASL tree state information
+ *   tplrec(out) : Tuple record descriptor to store result tuples
+ *
+ * Note: Apply the group_by clause to the given list file to group it
+ * using the specified group_by parameters.
+ */
+static int
+qexec_groupby (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state, QFILE_TUPLE_RECORD * tplrec)
+{
+  QFILE_LIST_ID *list_id = xasl->list_id;
+  BUILDLIST_PROC_NODE *buildlist = &xasl->proc.buildlist;
+  GROUPBY_STATE gbstate;
+  QFILE_LIST_SCAN_ID input_scan_id;
+  int ls_flag = 0;
+  int estimated_pages;
+
+  TSC_TICKS start_tick, end_tick;
+  TSCTIMEVAL tv_diff;
+
+  UINT64 old_sort_pages = 0, old_sort_ioreads = 0;
+
+  if (buildlist->groupby_list == NULL)
+    {
+      return NO_ERROR;
+    }
+
+  if (thread_is_on_trace (thread_p))
+    {
+      tsc_getticks (&start_tick);
+      xasl->groupby_stats.run_groupby = true;
+      xasl->groupby_stats.rows = 0;
+    }
+
+  /* initialize groupby_num() value */
+  if (buildlist->g_grbynum_val && DB_IS_NULL (buildlist->g_grbynum_val))
+    {
+      db_make_bigint (buildlist->g_grbynum_val, 0);
+    }
+
+  /* clear group by limit flags when skip group by is not used */
+  if (buildlist->g_grbynum_flag & XASL_G_GRBYNUM_FLAG_LIMIT_LT)
+    {
+      buildlist->g_grbynum_flag &= ~XASL_G_GRBYNUM_FLAG_LIMIT_LT;
+    }
+  if (buildlist->g_grbynum_flag & XASL_G_GRBYNUM_FLAG_LIMIT_GT_LT)
+    {
+      buildlist->g_grbynum_flag &= ~XASL_G_GRBYNUM_FLAG_LIMIT_GT_LT;
+    }
+
+  /* late binding : resolve group_by (buildlist) */
+  if (xasl->outptr_list != NULL)
+    {
+      qexec_resolve_domains_for_group_by (buildlist, xasl->outptr_list);
+    }
+
+  if (qexec_initialize_groupby_state (&gbstate, buildlist->groupby_list, buildlist->g_having_pred,
+				      buildlist->g_grbynum_pred, buildlist->g_grbynum_val, buildlist->g_grbynum_flag,
+				      buildlist->eptr_list, buildlist->g_agg_list, buildlist->g_regu_list,
+				      buildlist->g_val_list, buildlist->g_outptr_list, buildlist->g_hk_sort_regu_list,
+				      buildlist->g_with_rollup != 0, buildlist->g_hash_eligible,
+				      buildlist->agg_hash_context, xasl, xasl_state, &list_id->type_list,
+				      tplrec) == NULL)
+    {
+      GOTO_EXIT_ON_ERROR;
+    }
+
+  /*
+   * Create a new listfile to receive the results.
+   */
+  {
+    QFILE_TUPLE_VALUE_TYPE_LIST output_type_list;
+    QFILE_LIST_ID *output_list_id;
+
+    if (qdata_get_valptr_type_list (thread_p, buildlist->g_outptr_list, &output_type_list) != NO_ERROR)
+      {
+	GOTO_EXIT_ON_ERROR;
+      }
+    /* If it does not have 'order by'(xasl->orderby_list), then the list file to be open at here will be the last one.
+     * Otherwise, the last list file will be open at qexec_orderby_distinct(). (Note that only one that can have 'group
+     * by' is BUILDLIST_PROC type.) And, the top most XASL is the other condition for the list file to be the last
+     * result file. */
+
+    QFILE_SET_FLAG (ls_flag, QFILE_FLAG_ALL);
+    if (XASL_IS_FLAGED (xasl, XASL_TOP_MOST_XASL) && XASL_IS_FLAGED (xasl, XASL_TO_BE_CACHED)
+	&& (xasl->orderby_list == NULL || XASL_IS_FLAGED (xasl, XASL_SKIP_ORDERBY_LIST)) && xasl->option != Q_DISTINCT)
+      {
+	QFILE_SET_FLAG (ls_flag, QFILE_FLAG_RESULT_FILE);
+      }
+
+    output_list_id =
+      qfile_open_list (thread_p, &output_type_list, buildlist->after_groupby_list, xasl_state->query_id, ls_flag);
+    if (output_list_id == NULL)
+      {
+	if (output_type_list.domp)
+	  {
+	    db_private_free_and_init (thread_p, output_type_list.domp);
+	  }
+
+	GOTO_EXIT_ON_ERROR;
+      }
+
+    if (output_type_list.domp)
+      {
+	db_private_free_and_init (thread_p, output_type_list.domp);
+      }
+
+    gbstate.output_file = output_list_id;
+  }
+
+  /* check for quick finalization scenarios */
+  if (list_id->tuple_cnt == 0)
+    {
+      if (!gbstate.hash_eligible || gbstate.agg_hash_context->tuple_count == 0)
+	{
+	  /* no tuples hash aggregated and empty unsorted list; no reason to continue */
+	  qfile_destroy_list (thread_p, list_id);
+	  qfile_close_list (thread_p, gbstate.output_file);
+	  qfile_copy_list_id (list_id, gbstate.output_file, true);
+	  qexec_clear_groupby_state (thread_p, &gbstate);
+
+	  return NO_ERROR;
+	}
+      else if (gbstate.agg_hash_context->part_list_id->tuple_cnt == 0
+	       && !prm_get_bool_value (PRM_ID_AGG_HASH_RESPECT_ORDER))
+	{
+	  /* empty unsorted list and empty partial list; we can generate the output from the hash table or, if groups
+	   * were spilled, from the hash partitions */
+	  if (gbstate.agg_hash_context->spill_count > 0)
+	    {
+	      if (qexec_hash_gby_finalize_partitions (thread_p, &gbstate) != NO_ERROR)
+		{
+		  GOTO_EXIT_ON_ERROR;
+		}
+	    }
+	  else if (qexec_hash_gby_output_htable (thread_p, &gbstate) != NO_ERROR)
+	    {
+	      GOTO_EXIT_ON_ERROR;
+	    }
+
+	  /* output generated; finalize */
+	  qfile_destroy_list (thread_p, list_id);
+	  qfile_close_list (thread_p, gbstate.output_file);
+	  qfile_copy_list_id (list_id, gbstate.output_file, true);
+
+	  goto wrapup;
+	}
+    }
+
+  if (thread_is_on_trace (thread_p))
+    {
+      xasl->groupby_stats.groupby_sort = true;
+      old_sort_pages = perfmon_get_from_statistic (thread_p, PSTAT_SORT_NUM_DATA_PAGES);
+      old_sort_ioreads = perfmon_get_from_statistic (thread_p, PSTAT_SORT_NUM_IO_PAGES);
+    }
+
+  /* unsorted list is not empty; dump hash table and hash partitions to partial list */
+  if (gbstate.hash_eligible && gbstate.agg_hash_context->spill_count > 0)
+    {
+      /* reopen unsorted list to accept new tuples */
+      if (qfile_reopen_list_as_append_mode (thread_p, list_id) != NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
+
+      /* move spilled groups to unsorted and partial lists */
+      if (qexec_hash_gby_unspill_partitions (thread_p, gbstate.agg_hash_context, list_id) != NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
+
+      /* close unsorted list */
+      qfile_close_list (thread_p, list_id);
+    }
+
+  if (gbstate.hash_eligible && gbstate.agg_hash_context->tuple_count > 0
+      && mht_count (gbstate.agg_hash_context->hash_table) > 0)
+    {
+      /* reopen unsorted list to accept new tuples */
+      if (qfile_reopen_list_as_append_mode (thread_p, list_id) != NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
+
+      /* save hash table */
+      if (qdata_save_agg_htable_to_list (thread_p, gbstate.agg_hash_context->hash_table, list_id,
+					 gbstate.agg_hash_context->part_list_id,
+					 gbstate.agg_hash_context->temp_dbval_array) != NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
+
+      /* close unsorted list */
+      qfile_close_list (thread_p, list_id);
+    }
+
+  /* sort partial list and open a scan on it */
+  if (gbstate.hash_eligible && gbstate.agg_hash_context->part_list_id->tuple_cnt > 0)
+    {
+      SORT_CMP_FUNC *cmp_fn;
+
+      /* open scan on partial list */
+      if (qfile_open_list_scan (gbstate.agg_hash_context->part_list_id, &gbstate.agg_hash_context->part_scan_id) !=
+	  NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
+
+      estimated_pages =
+	qfile_get_estimated_pages_for_sorting (gbstate.agg_hash_context->part_list_id,
+					       &gbstate.agg_hash_context->sort_key);
+
+      /* choose appripriate sort function */
+      if (gbstate.agg_hash_context->sort_key.use_original)
+	{
+	  cmp_fn = &qfile_compare_partial_sort_record;
+	}
+      else
+	{
+	  cmp_fn = &qfile_compare_all_sort_record;
+	}
+
+      /* sort and aggregate partial results */
+      if (sort_listfile (thread_p, NULL_VOLID, estimated_pages, &qexec_hash_gby_get_next, &gbstate,
+			 &qexec_hash_gby_put_next, &gbstate, cmp_fn, &gbstate.agg_hash_context->sort_key, SORT_DUP,
+			 NO_SORT_LIMIT) != NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
+
+      /* write last group */
+      if (gbstate.agg_hash_context->sorted_count > 0)
+	{
+	  /* different key, write current accumulators */
+	  if (qdata_save_agg_hentry_to_list (thread_p, gbstate.agg_hash_context->curr_part_key,
+					     gbstate.agg_hash_context->curr_part_value,
+					     gbstate.agg_hash_context->temp_dbval_array,
+					     gbstate.agg_hash_context->sorted_part_list_id) != NO_ERROR)
+	    {
+	      GOTO_EXIT_ON_ERROR;
+	    }
+	}
+
+      /* close scan */
+      qfile_close_scan (thread_p, &gbstate.agg_hash_context->part_scan_id);
+
+      /* partial list is no longer necessary */
+      qfile_close_list (thread_p, gbstate.agg_hash_context->part_list_id);
+      qfile_destroy_list (thread_p, gbstate.agg_hash_context->part_list_id);
+      qfile_free_list_id (gbstate.agg_hash_context->part_list_id);
+      gbstate.agg_hash_context->part_list_id = NULL;
+
+      /* reopen scan on newly sorted list */
+      if (qfile_open_list_scan (gbstate.agg_hash_context->sorted_part_list_id, &gbstate.agg_hash_context->part_scan_id)
+	  != NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
+
+      /* load first key */
+      gbstate.agg_hash_context->part_scan_code =
+	qdata_load_agg_hentry_from_list (thread_p, &gbstate.agg_hash_context->part_scan_id,
+					 gbstate.agg_hash_context->curr_part_key,
+					 gbstate.agg_hash_context->curr_part_value,
+					 gbstate.agg_hash_context->key_domains,
+					 gbstate.agg_hash_context->accumulator_domains);
+    }
+  else
+    {
+      /* empty partial list; probably set types or big records */
+      gbstate.agg_hash_context->part_scan_code = S_END;
+    }
+
+  /*
+   * Open a scan on the unsorted input file
+   */
+  if (qfile_open_list_scan (list_id, &input_scan_id) != NO_ERROR)
+    {
+      GOTO_EXIT_ON_ERROR;
+    }
+  gbstate.input_scan = &input_scan_id;
+
+  /*
+   * Now load up the sort module and set it off...
+   */
+  gbstate.key_info.use_original = (gbstate.key_info.nkeys != list_id->type_list.type_cnt);
+  gbstate.cmp_fn =
+    (gbstate.key_info.use_original == 1 ? &qfile_compare_partial_sort_record : &qfile_compare_all_sort_record);
+
+  if (XASL_IS_FLAGED (xasl, XASL_MULTI_UPDATE_AGG))
+    {
+#if defined (ENABLE_COMPOSITE_LOCK)
+      gbstate.composite_lock = &xasl->composite_lock;
+#endif /* defined (ENABLE_COMPOSITE_LOCK) */
+      gbstate.upd_del_class_cnt = xasl->upd_del_class_cnt;
+    }
+  else
+    {
+      gbstate.composite_lock = NULL;
+      gbstate.upd_del_class_cnt = 0;
+    }
+
+  estimated_pages = qfile_get_estimated_pages_for_sorting (list_id, &gbstate.key_info);
+
+  if (sort_listfile (thread_p, NULL_VOLID, estimated_pages, &qexec_gby_get_next, &gbstate, &qexec_gby_put_next,
+		     &gbstate, gbstate.cmp_fn, &gbstate.key_info, SORT_DUP, NO_SORT_LIMIT) != NO_ERROR)
+    {
+      GOTO_EXIT_ON_ERROR;
+    }
+
+  /*
+   * There may be one unfinished group in the output, since the sort_listfile
+   * interface doesn't include a finalization function.  If so, finish
    * off that group.
    */
   if (gbstate.input_recs != 0)
@@ -6543,6 +7251,7 @@ qexec_open_scan (THREAD_ENTRY * thread_p, ACCESS_SPEC_TYPE * curr_spec, VAL_LIST
 	      ASSERT_ERROR ();
 	      goto exit_on_error;
 	    }
+	  s_id->join_filter = curr_spec->join_filter;
 	}
       else if (scan_type == S_HEAP_PAGE_SCAN)
 	{
@@ -6608,6 +7317,7 @@ qexec_open_scan (THREAD_ENTRY * thread_p, ACCESS_SPEC_TYPE * curr_spec, VAL_LIST
 	      ASSERT_ERROR ();
 	      goto exit_on_error;
 	    }
+	  s_id->join_filter = curr_spec->join_filter;
 	  /* monitor */
 	  perfmon_inc_stat (thread_p, PSTAT_QM_NUM_ISCANS);
 	}
@@ -7829,7 +8539,8 @@ qexec_intprt_fnc (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_s
 	      ACCESS_SPEC_TYPE *specp = xasl->spec_list;
 	      if (specp->next == NULL && specp->access == ACCESS_METHOD_INDEX
 		  && specp->s.cls_node.cls_regu_list_pred == NULL && specp->where_pred == NULL
-		  && !specp->indexptr->use_iss && !SCAN_IS_INDEX_MRO (&specp->s_id.s.isid)
+		  && !specp->indexptr->use_iss && specp->indexptr->bitmap_next == NULL
+		  && !SCAN_IS_INDEX_MRO (&specp->s_id.s.isid)
 		  && !SCAN_IS_INDEX_COVERED (&specp->s_id.s.isid))
 		{
 		  /* count(*) query will scan an index but does not have a data-filter */
@@ -10866,6 +11577,7 @@ qexec_execute_insert (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xa
   HEAP_SCANCACHE scan_cache;
   bool scan_cache_inited = false;
   int scan_cache_op_type = 0;
+  bool use_index_insert_batch = false;
   int force_count = 0;
   int num_default_expr = 0;
   LC_COPYAREA_OPERATION operation = LC_FLUSH_INSERT;
@@ -11233,6 +11945,11 @@ qexec_execute_insert (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xa
       scan_cache_op_type = SINGLE_ROW_INSERT;
     }
 
+  /* Index keys of plain multi-row inserts are collected and inserted sorted, index by index. Replace and on duplicate
+   * key update must find the keys of previous rows immediately. */
+  use_index_insert_batch = (scan_cache_op_type == MULTI_ROW_INSERT && !insert->do_replace && odku_assignments == NULL
+			    && pcontext == NULL && !XASL_IS_FLAGED (xasl, XASL_LINK_TO_REGU_VARIABLE));
+
   if (specp)
     {
       /* we are inserting multiple values ... ie. insert into foo select ... */
@@ -11250,6 +11967,11 @@ qexec_execute_insert (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xa
 	}
       scan_cache_inited = true;
 
+      if (use_index_insert_batch && locator_start_index_insert_batch (thread_p, &scan_cache) != NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
+
       assert (xasl->scan_op_type == S_SELECT);
 
       /* force_select_lock = false */
@@ -11428,6 +12150,11 @@ qexec_execute_insert (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xa
 	}
       scan_cache_inited = true;
 
+      if (use_index_insert_batch && locator_start_index_insert_batch (thread_p, &scan_cache) != NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
+
       if (XASL_IS_FLAGED (xasl, XASL_LINK_TO_REGU_VARIABLE) && scan_cache.file_type == FILE_HEAP_REUSE_SLOTS)
 	{
 	  /* do not allow references to reusable oids in sub-inserts. this is a safety check and should have been
@@ -11582,6 +12309,12 @@ qexec_execute_insert (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xa
 	}
     }
 
+  /* insert the index keys collected by the scan cache; unique constraints are checked now */
+  if (scan_cache_inited && locator_flush_index_insert_batch (thread_p, &scan_cache) != NO_ERROR)
+    {
+      GOTO_EXIT_ON_ERROR;
+    }
+
   /* check uniques */
   /* In this case, consider only single class. Therefore, uniqueness checking is performed based on the local
    * statistical information kept in scan_cache. And then, it is reflected into the transaction's statistical
@@ -13937,6 +14670,38 @@ qexec_execute_mainblock_internal (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XAS
 			    }
 			}
 		    }
+
+		  /* the other input is already materialized; use its join keys to filter the scan of this one */
+		  if (prm_get_bool_value (PRM_ID_USE_RUNTIME_JOIN_FILTER)
+		      && (xptr2->status == XASL_CLEARED || xptr2->status == XASL_INITIALIZED))
+		    {
+		      int error_code = NO_ERROR;
+
+		      if (xptr2 == inner_xasl && outer_xasl->status == XASL_SUCCESS
+			  && (merge_infop->join_type == JOIN_INNER || merge_infop->join_type == JOIN_LEFT))
+			{
+			  error_code = qexec_setup_join_filter (thread_p, outer_xasl, merge_infop->ls_outer_column,
+								inner_xasl, merge_infop->ls_inner_column,
+								merge_infop->ls_column_cnt);
+			}
+		      else if (xptr2 == outer_xasl && inner_xasl->status == XASL_SUCCESS
+			       && (merge_infop->join_type == JOIN_INNER || merge_infop->join_type == JOIN_RIGHT))
+			{
+			  error_code = qexec_setup_join_filter (thread_p, inner_xasl, merge_infop->ls_inner_column,
+								outer_xasl, merge_infop->ls_outer_column,
+								merge_infop->ls_column_cnt);
+			}
+
+		      if (error_code != NO_ERROR)
+			{
+			  if (tplrec.tpl)
+			    {
+			      db_private_free_and_init (thread_p, tplrec.tpl);
+			    }
+			  qexec_failure_line (__LINE__, xasl_state);
+			  GOTO_EXIT_ON_ERROR;
+			}
+		    }
 		}
 
 	      if (XASL_IS_FLAGED (xptr2, XASL_LINK_TO_REGU_VARIABLE))
@@ -18052,850 +18817,1331 @@ bf2df_str_compare (const unsigned char *s0, int l0, const unsigned char *s1, int
     {
       return DB_GT;
     }
-  return DB_UNK;
+  return DB_UNK;
+}
+
+/*
+ * bf2df_str_cmpdisk () -
+ *   return: DB_LT, DB_EQ, or DB_GT
+ */
+static DB_VALUE_COMPARE_RESULT
+bf2df_str_cmpdisk (void *mem1, void *mem2, TP_DOMAIN * domain, int do_coercion, int total_order, int *start_colp)
+{
+  DB_VALUE_COMPARE_RESULT c = DB_UNK;
+  char *str1, *str2;
+  int str_length1, str1_compressed_length = 0, str1_decompressed_length = 0;
+  int str_length2, str2_compressed_length = 0, str2_decompressed_length = 0;
+  OR_BUF buf1, buf2;
+  int rc = NO_ERROR;
+  char *string1 = NULL, *string2 = NULL;
+  bool alloced_string1 = false, alloced_string2 = false;
+
+  str1 = (char *) mem1;
+  str2 = (char *) mem2;
+
+  /* generally, data is short enough */
+  str_length1 = OR_GET_BYTE (str1);
+  str_length2 = OR_GET_BYTE (str2);
+  if (str_length1 < OR_MINIMUM_STRING_LENGTH_FOR_COMPRESSION && str_length2 < OR_MINIMUM_STRING_LENGTH_FOR_COMPRESSION)
+    {
+      str1 += OR_BYTE_SIZE;
+      str2 += OR_BYTE_SIZE;
+      return bf2df_str_compare ((unsigned char *) str1, str_length1, (unsigned char *) str2, str_length2);
+    }
+
+  assert (str_length1 == OR_MINIMUM_STRING_LENGTH_FOR_COMPRESSION
+	  || str_length2 == OR_MINIMUM_STRING_LENGTH_FOR_COMPRESSION);
+
+  /* String 1 */
+  or_init (&buf1, str1, 0);
+  if (str_length1 == OR_MINIMUM_STRING_LENGTH_FOR_COMPRESSION)
+    {
+      rc = or_get_varchar_compression_lengths (&buf1, &str1_compressed_length, &str1_decompressed_length);
+      if (rc != NO_ERROR)
+	{
+	  goto cleanup;
+	}
+
+      string1 = (char *) db_private_alloc (NULL, str1_decompressed_length + 1);
+      if (string1 == NULL)
+	{
+	  /* Error report */
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, str1_decompressed_length);
+	  goto cleanup;
+	}
+
+      alloced_string1 = true;
+
+      rc = pr_get_compressed_data_from_buffer (&buf1, string1, str1_compressed_length, str1_decompressed_length);
+      if (rc != NO_ERROR)
+	{
+	  goto cleanup;
+	}
+
+      str_length1 = str1_decompressed_length;
+      string1[str_length1] = '\0';
+    }
+  else
+    {
+      /* Skip the size byte */
+      string1 = str1 + OR_BYTE_SIZE;
+    }
+
+  if (rc != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      goto cleanup;
+    }
+
+  /* String 2 */
+  or_init (&buf2, str2, 0);
+  if (str_length2 == OR_MINIMUM_STRING_LENGTH_FOR_COMPRESSION)
+    {
+      rc = or_get_varchar_compression_lengths (&buf2, &str2_compressed_length, &str2_decompressed_length);
+      if (rc != NO_ERROR)
+	{
+	  goto cleanup;
+	}
+
+      string2 = (char *) db_private_alloc (NULL, str2_decompressed_length + 1);
+      if (string2 == NULL)
+	{
+	  /* Error report */
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, str2_decompressed_length);
+	  goto cleanup;
+	}
+
+      alloced_string2 = true;
+
+      rc = pr_get_compressed_data_from_buffer (&buf2, string2, str2_compressed_length, str2_decompressed_length);
+      if (rc != NO_ERROR)
+	{
+	  goto cleanup;
+	}
+
+      str_length2 = str2_decompressed_length;
+      string2[str_length2] = '\0';
+    }
+  else
+    {
+      /* Skip the size byte */
+      string2 = str2 + OR_BYTE_SIZE;
+    }
+
+  if (rc != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      goto cleanup;
+    }
+
+  /* Compare the strings */
+  c = bf2df_str_compare ((unsigned char *) string1, str_length1, (unsigned char *) string2, str_length2);
+  /* Clean up the strings */
+  if (string1 != NULL && alloced_string1 == true)
+    {
+      db_private_free_and_init (NULL, string1);
+    }
+
+  if (string2 != NULL && alloced_string2 == true)
+    {
+      db_private_free_and_init (NULL, string2);
+    }
+
+  return c;
+
+cleanup:
+  if (string1 != NULL && alloced_string1 == true)
+    {
+      db_private_free_and_init (NULL, string1);
+    }
+
+  if (string2 != NULL && alloced_string2 == true)
+    {
+      db_private_free_and_init (NULL, string2);
+    }
+
+  return DB_UNK;
+}
+
+/*
+ * bf2df_str_cmpval () -
+ *   return: DB_LT, DB_EQ, or DB_GT
+ */
+static DB_VALUE_COMPARE_RESULT
+bf2df_str_cmpval (DB_VALUE * value1, DB_VALUE * value2, int do_coercion, int total_order, int *start_colp,
+		  int collation)
+{
+  const unsigned char *string1 = REINTERPRET_CAST (const unsigned char *, db_get_string (value1));
+  const unsigned char *string2 = REINTERPRET_CAST (const unsigned char *, db_get_string (value2));
+
+  if (string1 == NULL || string2 == NULL)
+    {
+      return DB_UNK;
+    }
+
+  return bf2df_str_compare (string1, (int) db_get_string_size (value1), string2, (int) db_get_string_size (value2));
+}
+
+/*
+ * qexec_resolve_domains_on_sort_list () - checks if the domains in the
+ *	'order_list' are all solved, and if any is still unresolved (VARIABLE)
+ *	it will be replaced with the domain of corresponding element from
+ *      'reference_regu_list'
+ * order_list(in/out): sort list to be checked, may be empty (NULL)
+ * reference_regu_list(in): reference list of regu variable with concrete
+ *			    domains
+ */
+static void
+qexec_resolve_domains_on_sort_list (SORT_LIST * order_list, REGU_VARIABLE_LIST reference_regu_list)
+{
+  int ref_curr_pos = 0;
+  SORT_LIST *orderby_ptr = NULL;
+  REGU_VARIABLE_LIST regu_list;
+
+  assert (reference_regu_list != NULL);
+
+  if (order_list == NULL)
+    {
+      /* nothing to check */
+      return;
+    }
+
+  for (orderby_ptr = order_list; orderby_ptr != NULL; orderby_ptr = orderby_ptr->next)
+    {
+      if (TP_DOMAIN_TYPE (orderby_ptr->pos_descr.dom) == DB_TYPE_VARIABLE
+	  || TP_DOMAIN_COLLATION_FLAG (orderby_ptr->pos_descr.dom) != TP_DOMAIN_COLL_NORMAL)
+	{
+	  ref_curr_pos = orderby_ptr->pos_descr.pos_no;
+	  regu_list = reference_regu_list;
+	  while (ref_curr_pos > 0 && regu_list)
+	    {
+	      regu_list = regu_list->next;
+	      ref_curr_pos--;
+	    }
+	  if (regu_list)
+	    {
+	      orderby_ptr->pos_descr.dom = regu_list->value.domain;
+	    }
+	}
+    }
 }
 
 /*
- * bf2df_str_cmpdisk () -
- *   return: DB_LT, DB_EQ, or DB_GT
+ * qexec_resolve_domains_for_group_by () - checks if the domains in the
+ *	various lists of 'buildlist' node are all solved, and if any is still
+ *	unresolved (VARIABLE), it will be replaced with the domain of
+ *      corresponding element from 'reference_regu_list'
+ *
+ * buildlist(in/out): buildlist for GROUP BY
+ * reference_out_list(in): reference output list of regu variable with
+ *			   concrete domains
+ *
+ *  Note : this function is used for statements with GROUP BY clause
  */
-static DB_VALUE_COMPARE_RESULT
-bf2df_str_cmpdisk (void *mem1, void *mem2, TP_DOMAIN * domain, int do_coercion, int total_order, int *start_colp)
+static void
+qexec_resolve_domains_for_group_by (BUILDLIST_PROC_NODE * buildlist, OUTPTR_LIST * reference_out_list)
 {
-  DB_VALUE_COMPARE_RESULT c = DB_UNK;
-  char *str1, *str2;
-  int str_length1, str1_compressed_length = 0, str1_decompressed_length = 0;
-  int str_length2, str2_compressed_length = 0, str2_decompressed_length = 0;
-  OR_BUF buf1, buf2;
-  int rc = NO_ERROR;
-  char *string1 = NULL, *string2 = NULL;
-  bool alloced_string1 = false, alloced_string2 = false;
+  int ref_index = 0;
+  REGU_VARIABLE_LIST group_regu = NULL;
+  REGU_VARIABLE_LIST reference_regu_list = reference_out_list->valptrp;
+  AGGREGATE_TYPE *agg_p;
 
-  str1 = (char *) mem1;
-  str2 = (char *) mem2;
+  assert (buildlist != NULL && reference_regu_list != NULL);
 
-  /* generally, data is short enough */
-  str_length1 = OR_GET_BYTE (str1);
-  str_length2 = OR_GET_BYTE (str2);
-  if (str_length1 < OR_MINIMUM_STRING_LENGTH_FOR_COMPRESSION && str_length2 < OR_MINIMUM_STRING_LENGTH_FOR_COMPRESSION)
+  /* domains in GROUP BY list (this is a SORT_LIST) */
+  qexec_resolve_domains_on_sort_list (buildlist->groupby_list, reference_regu_list);
+
+  /* following code aims to resolve VARIABLE domains in GROUP BY lists: g_regu_list, g_agg_list, g_outprr_list,
+   * g_hk_regu_list; pointer values are used to match the REGU VARIABLES */
+  for (group_regu = buildlist->g_regu_list; group_regu != NULL; group_regu = group_regu->next)
     {
-      str1 += OR_BYTE_SIZE;
-      str2 += OR_BYTE_SIZE;
-      return bf2df_str_compare ((unsigned char *) str1, str_length1, (unsigned char *) str2, str_length2);
-    }
+      int pos_in_ref_list = 0;
+      QPROC_DB_VALUE_LIST g_val_list = NULL;
+      AGGREGATE_TYPE *group_agg = NULL;
+      bool val_in_g_val_list_found = false;
+      bool g_agg_val_found = false;
+      DB_VALUE *val_list_ref_dbvalue = NULL;
+      TP_DOMAIN *ref_domain = NULL;
+      REGU_VARIABLE_LIST ref_regu = NULL;
+      REGU_VARIABLE_LIST group_out_regu = NULL;
+      REGU_VARIABLE_LIST hk_regu = NULL;
 
-  assert (str_length1 == OR_MINIMUM_STRING_LENGTH_FOR_COMPRESSION
-	  || str_length2 == OR_MINIMUM_STRING_LENGTH_FOR_COMPRESSION);
+      if (group_regu->value.domain == NULL
+	  || (TP_DOMAIN_TYPE (group_regu->value.domain) != DB_TYPE_VARIABLE
+	      && TP_DOMAIN_COLLATION_FLAG (group_regu->value.domain) == TP_DOMAIN_COLL_NORMAL))
+	{
+	  continue;
+	}
 
-  /* String 1 */
-  or_init (&buf1, str1, 0);
-  if (str_length1 == OR_MINIMUM_STRING_LENGTH_FOR_COMPRESSION)
-    {
-      rc = or_get_varchar_compression_lengths (&buf1, &str1_compressed_length, &str1_decompressed_length);
-      if (rc != NO_ERROR)
+      pos_in_ref_list = (group_regu->value.type == TYPE_POSITION) ? group_regu->value.value.pos_descr.pos_no : -1;
+
+      if (pos_in_ref_list < 0)
 	{
-	  goto cleanup;
+	  continue;
 	}
 
-      string1 = (char *) db_private_alloc (NULL, str1_decompressed_length + 1);
-      if (string1 == NULL)
+      assert (pos_in_ref_list < reference_out_list->valptr_cnt);
+
+      /* goto position */
+      for (ref_regu = reference_regu_list, ref_index = 0; ref_regu != NULL && ref_index < pos_in_ref_list;
+	   ref_regu = ref_regu->next, ref_index++)
 	{
-	  /* Error report */
-	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, str1_decompressed_length);
-	  goto cleanup;
+	  ;
 	}
 
-      alloced_string1 = true;
+      assert (ref_index == pos_in_ref_list);
 
-      rc = pr_get_compressed_data_from_buffer (&buf1, string1, str1_compressed_length, str1_decompressed_length);
-      if (rc != NO_ERROR)
+      ref_domain = ref_regu->value.domain;
+      if (TP_DOMAIN_TYPE (ref_domain) == DB_TYPE_VARIABLE
+	  || TP_DOMAIN_COLLATION_FLAG (ref_domain) != TP_DOMAIN_COLL_NORMAL)
 	{
-	  goto cleanup;
+	  /* next GROUP BY item */
+	  continue;
 	}
 
-      str_length1 = str1_decompressed_length;
-      string1[str_length1] = '\0';
-    }
-  else
-    {
-      /* Skip the size byte */
-      string1 = str1 + OR_BYTE_SIZE;
-    }
+      /* update domain in g_regu_list */
+      group_regu->value.domain = ref_domain;
 
-  if (rc != NO_ERROR)
-    {
-      ASSERT_ERROR ();
-      goto cleanup;
-    }
+      assert (group_regu->value.type == TYPE_POSITION);
+      group_regu->value.value.pos_descr.dom = ref_domain;
 
-  /* String 2 */
-  or_init (&buf2, str2, 0);
-  if (str_length2 == OR_MINIMUM_STRING_LENGTH_FOR_COMPRESSION)
-    {
-      rc = or_get_varchar_compression_lengths (&buf2, &str2_compressed_length, &str2_decompressed_length);
-      if (rc != NO_ERROR)
+      if (buildlist->g_hash_eligible)
 	{
-	  goto cleanup;
+	  /* all reguvars in g_hk_regu_list are also in g_regu_list; match them by position and update g_hk_regu_list */
+	  for (hk_regu = buildlist->g_hk_sort_regu_list; hk_regu != NULL; hk_regu = hk_regu->next)
+	    {
+	      if (hk_regu->value.type == TYPE_POSITION && hk_regu->value.value.pos_descr.pos_no == pos_in_ref_list)
+		{
+		  hk_regu->value.value.pos_descr.dom = ref_domain;
+		  hk_regu->value.domain = ref_domain;
+		}
+	    }
 	}
 
-      string2 = (char *) db_private_alloc (NULL, str2_decompressed_length + 1);
-      if (string2 == NULL)
+      /* find value in g_val_list pointed to by vfetch_to ; also find in g_agg_list (if any), the same value
+       * indentified by pointer value in operand */
+      for (g_val_list = buildlist->g_val_list->valp; g_val_list != NULL; g_val_list = g_val_list->next)
 	{
-	  /* Error report */
-	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, str2_decompressed_length);
-	  goto cleanup;
+	  if (g_val_list->val == group_regu->value.vfetch_to)
+	    {
+	      val_in_g_val_list_found = true;
+	      val_list_ref_dbvalue = g_val_list->val;
+	      break;
+	    }
 	}
 
-      alloced_string2 = true;
+      /* search for corresponding aggregate, by matching the operands REGU VAR update the domains for aggregate and
+       * aggregate's operand */
+      for (group_agg = buildlist->g_agg_list; group_agg != NULL; group_agg = group_agg->next)
+	{
+	  if (group_agg->opr_dbtype != DB_TYPE_VARIABLE && !TP_TYPE_HAS_COLLATION (group_agg->opr_dbtype))
+	    {
+	      continue;
+	    }
 
-      rc = pr_get_compressed_data_from_buffer (&buf2, string2, str2_compressed_length, str2_decompressed_length);
-      if (rc != NO_ERROR)
+	  REGU_VARIABLE operand = group_agg->operands->value;
+
+	  assert (operand.type == TYPE_CONSTANT);
+
+	  if ((TP_DOMAIN_TYPE (operand.domain) == DB_TYPE_VARIABLE
+	       || TP_DOMAIN_COLLATION_FLAG (operand.domain) != TP_DOMAIN_COLL_NORMAL)
+	      && operand.value.dbvalptr == val_list_ref_dbvalue)
+	    {
+	      /* update domain of aggregate's operand */
+	      operand.domain = ref_domain;
+	      group_agg->opr_dbtype = TP_DOMAIN_TYPE (ref_domain);
+
+	      if (TP_DOMAIN_TYPE (group_agg->domain) == DB_TYPE_VARIABLE
+		  || TP_DOMAIN_COLLATION_FLAG (group_agg->domain) != TP_DOMAIN_COLL_NORMAL)
+		{
+		  /* set domain at run-time for MEDIAN, PERCENTILE funcs */
+		  if (QPROC_IS_INTERPOLATION_FUNC (group_agg))
+		    {
+		      continue;
+		    }
+		  else if (group_agg->function == PT_GROUP_CONCAT)
+		    {
+		      /* result of GROUP_CONCAT is always string */
+		      if (!TP_TYPE_HAS_COLLATION (TP_DOMAIN_TYPE (ref_domain)))
+			{
+			  ref_domain = tp_domain_resolve_default (DB_TYPE_VARCHAR);
+			}
+		      group_agg->domain = ref_domain;
+
+		      db_value_domain_init (group_agg->accumulator.value, TP_DOMAIN_TYPE (ref_domain),
+					    DB_DEFAULT_PRECISION, DB_DEFAULT_SCALE);
+		      db_string_put_cs_and_collation (group_agg->accumulator.value, TP_DOMAIN_CODESET (ref_domain),
+						      TP_DOMAIN_COLLATION (ref_domain));
+
+		      g_agg_val_found = true;
+		      break;
+		    }
+
+		  assert (group_agg->function == PT_MIN || group_agg->function == PT_MAX
+			  || group_agg->function == PT_SUM);
+
+		  group_agg->domain = ref_domain;
+		  db_value_domain_init (group_agg->accumulator.value, group_agg->opr_dbtype, DB_DEFAULT_PRECISION,
+					DB_DEFAULT_SCALE);
+		  if (TP_TYPE_HAS_COLLATION (DB_VALUE_TYPE (group_agg->accumulator.value)))
+		    {
+		      db_string_put_cs_and_collation (group_agg->accumulator.value, TP_DOMAIN_CODESET (ref_domain),
+						      TP_DOMAIN_COLLATION (ref_domain));
+		    }
+		}
+	      else
+		{
+		  /* these aggregates have 'group_agg->domain' and 'group_agg->value' already initialized */
+		  assert (group_agg->function == PT_GROUP_CONCAT || group_agg->function == PT_AGG_BIT_AND
+			  || group_agg->function == PT_AGG_BIT_OR || group_agg->function == PT_AGG_BIT_XOR
+			  || group_agg->function == PT_COUNT || group_agg->function == PT_AVG
+			  || group_agg->function == PT_STDDEV || group_agg->function == PT_VARIANCE
+			  || group_agg->function == PT_STDDEV_POP || group_agg->function == PT_VAR_POP
+			  || group_agg->function == PT_STDDEV_SAMP || group_agg->function == PT_VAR_SAMP
+			  || group_agg->function == PT_JSON_ARRAYAGG || group_agg->function == PT_JSON_OBJECTAGG);
+		}
+
+	      g_agg_val_found = true;
+	      break;
+	    }
+	}
+
+      if (!g_agg_val_found)
 	{
-	  goto cleanup;
+	  continue;
 	}
 
-      str_length2 = str2_decompressed_length;
-      string2[str_length2] = '\0';
-    }
-  else
-    {
-      /* Skip the size byte */
-      string2 = str2 + OR_BYTE_SIZE;
+      /* search in g_outptr_list for the same value pointer as the value in g_agg_list->value , and update it with the
+       * same domain */
+      for (group_out_regu = buildlist->g_outptr_list->valptrp; group_out_regu != NULL;
+	   group_out_regu = group_out_regu->next)
+	{
+	  assert (group_agg != NULL);
+	  if (group_out_regu->value.type == TYPE_CONSTANT
+	      && group_out_regu->value.value.dbvalptr == group_agg->accumulator.value)
+	    {
+	      if (TP_DOMAIN_TYPE (group_out_regu->value.domain) == DB_TYPE_VARIABLE
+		  || TP_DOMAIN_COLLATION_FLAG (group_out_regu->value.domain) != TP_DOMAIN_COLL_NORMAL)
+		{
+		  group_out_regu->value.domain = ref_domain;
+		}
+	      /* aggregate found in g_outptr_list, end */
+	      break;
+	    }
+	}
     }
 
-  if (rc != NO_ERROR)
+  /* treat case with only NULL values */
+  for (agg_p = buildlist->g_agg_list; agg_p; agg_p = agg_p->next)
     {
-      ASSERT_ERROR ();
-      goto cleanup;
-    }
+      if (agg_p->accumulator_domain.value_dom == NULL)
+	{
+	  agg_p->accumulator_domain.value_dom = &tp_Null_domain;
+	}
 
-  /* Compare the strings */
-  c = bf2df_str_compare ((unsigned char *) string1, str_length1, (unsigned char *) string2, str_length2);
-  /* Clean up the strings */
-  if (string1 != NULL && alloced_string1 == true)
-    {
-      db_private_free_and_init (NULL, string1);
+      if (agg_p->accumulator_domain.value2_dom == NULL)
+	{
+	  agg_p->accumulator_domain.value2_dom = &tp_Null_domain;
+	}
     }
 
-  if (string2 != NULL && alloced_string2 == true)
+  /* update hash aggregation domains */
+  if (buildlist->g_hash_eligible)
     {
-      db_private_free_and_init (NULL, string2);
-    }
+      AGGREGATE_HASH_CONTEXT *context = buildlist->agg_hash_context;
+      int i, index;
 
-  return c;
+      /* update key domains */
+      group_regu = buildlist->g_hk_sort_regu_list;
+      for (i = 0; i < buildlist->g_hkey_size && group_regu != NULL; i++, group_regu = group_regu->next)
+	{
+	  if (TP_DOMAIN_TYPE (context->key_domains[i]) == DB_TYPE_VARIABLE
+	      || TP_DOMAIN_COLLATION_FLAG (context->key_domains[i]) != TP_DOMAIN_COLL_NORMAL)
+	    {
+	      context->key_domains[i] = group_regu->value.domain;
+	    }
+	}
 
-cleanup:
-  if (string1 != NULL && alloced_string1 == true)
-    {
-      db_private_free_and_init (NULL, string1);
-    }
+      /* update type lists of list files */
+      for (i = 0; i < buildlist->g_hkey_size; i++)
+	{
+	  /* partial list */
+	  context->part_list_id->type_list.domp[i] = context->key_domains[i];
 
-  if (string2 != NULL && alloced_string2 == true)
-    {
-      db_private_free_and_init (NULL, string2);
-    }
+	  /* sorted partial list */
+	  context->sorted_part_list_id->type_list.domp[i] = context->key_domains[i];
+	}
 
-  return DB_UNK;
-}
+      for (i = 0; i < buildlist->g_func_count; i++)
+	{
+	  index = buildlist->g_hkey_size + i * 3;
 
-/*
- * bf2df_str_cmpval () -
- *   return: DB_LT, DB_EQ, or DB_GT
- */
-static DB_VALUE_COMPARE_RESULT
-bf2df_str_cmpval (DB_VALUE * value1, DB_VALUE * value2, int do_coercion, int total_order, int *start_colp,
-		  int collation)
-{
-  const unsigned char *string1 = REINTERPRET_CAST (const unsigned char *, db_get_string (value1));
-  const unsigned char *string2 = REINTERPRET_CAST (const unsigned char *, db_get_string (value2));
+	  /* partial list */
+	  context->part_list_id->type_list.domp[index] = context->accumulator_domains[i]->value_dom;
+	  context->part_list_id->type_list.domp[index + 1] = context->accumulator_domains[i]->value2_dom;
+	  context->part_list_id->type_list.domp[index + 2] = &tp_Integer_domain;
 
-  if (string1 == NULL || string2 == NULL)
-    {
-      return DB_UNK;
+	  /* sorted partial list */
+	  context->sorted_part_list_id->type_list.domp[index] = context->accumulator_domains[i]->value_dom;
+	  context->sorted_part_list_id->type_list.domp[index + 1] = context->accumulator_domains[i]->value2_dom;
+	  context->sorted_part_list_id->type_list.domp[index + 2] = &tp_Integer_domain;
+	}
     }
-
-  return bf2df_str_compare (string1, (int) db_get_string_size (value1), string2, (int) db_get_string_size (value2));
 }
 
 /*
- * qexec_resolve_domains_on_sort_list () - checks if the domains in the
- *	'order_list' are all solved, and if any is still unresolved (VARIABLE)
- *	it will be replaced with the domain of corresponding element from
- *      'reference_regu_list'
- * order_list(in/out): sort list to be checked, may be empty (NULL)
- * reference_regu_list(in): reference list of regu variable with concrete
- *			    domains
+ * qexec_resolve_domains_for_aggregation () - update domains of aggregate
+ *                                            functions and accumulators
+ *   returns: error code or NO_ERROR
+ *   thread_p(in): current thread
+ *   agg_p(in): aggregate node
+ *   xasl_state(in): XASL state
+ *   tplrec(in): tuple record used for fetching of value
+ *   regu_list(in): regulist (NULL for none)
+ *   resolved(out): true if all domains are resolved, false otherwise
  */
-static void
-qexec_resolve_domains_on_sort_list (SORT_LIST * order_list, REGU_VARIABLE_LIST reference_regu_list)
+static int
+qexec_resolve_domains_for_aggregation (THREAD_ENTRY * thread_p, AGGREGATE_TYPE * agg_p, XASL_STATE * xasl_state,
+				       QFILE_TUPLE_RECORD * tplrec, REGU_VARIABLE_LIST regu_list, int *resolved)
 {
-  int ref_curr_pos = 0;
-  SORT_LIST *orderby_ptr = NULL;
-  REGU_VARIABLE_LIST regu_list;
-
-  assert (reference_regu_list != NULL);
-
-  if (order_list == NULL)
-    {
-      /* nothing to check */
-      return;
-    }
+  TP_DOMAIN *tmp_domain_p;
+  TP_DOMAIN_STATUS status;
+  DB_VALUE *dbval;
+  int error;
+  HL_HEAPID save_heapid = 0;
 
-  for (orderby_ptr = order_list; orderby_ptr != NULL; orderby_ptr = orderby_ptr->next)
+  /* fetch values */
+  if (regu_list != NULL)
     {
-      if (TP_DOMAIN_TYPE (orderby_ptr->pos_descr.dom) == DB_TYPE_VARIABLE
-	  || TP_DOMAIN_COLLATION_FLAG (orderby_ptr->pos_descr.dom) != TP_DOMAIN_COLL_NORMAL)
+      if (fetch_val_list (thread_p, regu_list, &xasl_state->vd, NULL, NULL, tplrec->tpl, true) != NO_ERROR)
 	{
-	  ref_curr_pos = orderby_ptr->pos_descr.pos_no;
-	  regu_list = reference_regu_list;
-	  while (ref_curr_pos > 0 && regu_list)
-	    {
-	      regu_list = regu_list->next;
-	      ref_curr_pos--;
-	    }
-	  if (regu_list)
-	    {
-	      orderby_ptr->pos_descr.dom = regu_list->value.domain;
-	    }
+	  return ER_FAILED;
 	}
     }
-}
-
-/*
- * qexec_resolve_domains_for_group_by () - checks if the domains in the
- *	various lists of 'buildlist' node are all solved, and if any is still
- *	unresolved (VARIABLE), it will be replaced with the domain of
- *      corresponding element from 'reference_regu_list'
- *
- * buildlist(in/out): buildlist for GROUP BY
- * reference_out_list(in): reference output list of regu variable with
- *			   concrete domains
- *
- *  Note : this function is used for statements with GROUP BY clause
- */
-static void
-qexec_resolve_domains_for_group_by (BUILDLIST_PROC_NODE * buildlist, OUTPTR_LIST * reference_out_list)
-{
-  int ref_index = 0;
-  REGU_VARIABLE_LIST group_regu = NULL;
-  REGU_VARIABLE_LIST reference_regu_list = reference_out_list->valptrp;
-  AGGREGATE_TYPE *agg_p;
-
-  assert (buildlist != NULL && reference_regu_list != NULL);
 
-  /* domains in GROUP BY list (this is a SORT_LIST) */
-  qexec_resolve_domains_on_sort_list (buildlist->groupby_list, reference_regu_list);
+  /* start off as resolved */
+  *resolved = 1;
 
-  /* following code aims to resolve VARIABLE domains in GROUP BY lists: g_regu_list, g_agg_list, g_outprr_list,
-   * g_hk_regu_list; pointer values are used to match the REGU VARIABLES */
-  for (group_regu = buildlist->g_regu_list; group_regu != NULL; group_regu = group_regu->next)
+  /* iterate functions */
+  for (; agg_p != NULL; agg_p = agg_p->next)
     {
-      int pos_in_ref_list = 0;
-      QPROC_DB_VALUE_LIST g_val_list = NULL;
-      AGGREGATE_TYPE *group_agg = NULL;
-      bool val_in_g_val_list_found = false;
-      bool g_agg_val_found = false;
-      DB_VALUE *val_list_ref_dbvalue = NULL;
-      TP_DOMAIN *ref_domain = NULL;
-      REGU_VARIABLE_LIST ref_regu = NULL;
-      REGU_VARIABLE_LIST group_out_regu = NULL;
-      REGU_VARIABLE_LIST hk_regu = NULL;
-
-      if (group_regu->value.domain == NULL
-	  || (TP_DOMAIN_TYPE (group_regu->value.domain) != DB_TYPE_VARIABLE
-	      && TP_DOMAIN_COLLATION_FLAG (group_regu->value.domain) == TP_DOMAIN_COLL_NORMAL))
+      if (agg_p->function == PT_CUME_DIST || agg_p->function == PT_PERCENT_RANK)
 	{
+	  /* operands for CUME_DIST and PERCENT_RANK are of no interest here */
 	  continue;
 	}
 
-      pos_in_ref_list = (group_regu->value.type == TYPE_POSITION) ? group_regu->value.value.pos_descr.pos_no : -1;
-
-      if (pos_in_ref_list < 0)
+      if (agg_p->function == PT_COUNT || agg_p->function == PT_COUNT_STAR)
 	{
+	  /* COUNT and COUNT(*) always have the same signature */
+	  agg_p->accumulator_domain.value_dom = &tp_Integer_domain;
+	  agg_p->accumulator_domain.value2_dom = &tp_Null_domain;
+
 	  continue;
 	}
 
-      assert (pos_in_ref_list < reference_out_list->valptr_cnt);
-
-      /* goto position */
-      for (ref_regu = reference_regu_list, ref_index = 0; ref_regu != NULL && ref_index < pos_in_ref_list;
-	   ref_regu = ref_regu->next, ref_index++)
+      if (agg_p->function == PT_JSON_ARRAYAGG || agg_p->function == PT_JSON_OBJECTAGG)
 	{
-	  ;
+	  /* PT_JSON_ARRAYAGG and PT_JSON_OBJECTAGG always have the same signature */
+	  agg_p->accumulator_domain.value_dom = &tp_Json_domain;
+	  agg_p->accumulator_domain.value2_dom = &tp_Null_domain;
+	  continue;
 	}
 
-      assert (ref_index == pos_in_ref_list);
-
-      ref_domain = ref_regu->value.domain;
-      if (TP_DOMAIN_TYPE (ref_domain) == DB_TYPE_VARIABLE
-	  || TP_DOMAIN_COLLATION_FLAG (ref_domain) != TP_DOMAIN_COLL_NORMAL)
+      DB_VALUE benchmark_dummy_dbval;
+      db_make_double (&benchmark_dummy_dbval, 0);
+      if (agg_p->operands->value.type == TYPE_FUNC && agg_p->operands->value.value.funcp != NULL
+	  && agg_p->operands->value.value.funcp->ftype == F_BENCHMARK)
 	{
-	  /* next GROUP BY item */
-	  continue;
+	  // In case we have a benchmark function we want ot avoid the usual superflous function evaluation
+	  dbval = &benchmark_dummy_dbval;
+	}
+      else
+	{
+	  /* fetch function operand */
+	  if (fetch_peek_dbval (thread_p, &agg_p->operands->value, &xasl_state->vd, NULL, NULL, NULL, &dbval) !=
+	      NO_ERROR)
+	    {
+	      return ER_FAILED;
+	    }
 	}
 
-      /* update domain in g_regu_list */
-      group_regu->value.domain = ref_domain;
-
-      assert (group_regu->value.type == TYPE_POSITION);
-      group_regu->value.value.pos_descr.dom = ref_domain;
-
-      if (buildlist->g_hash_eligible)
+      /* handle NULL value */
+      if (dbval == NULL || DB_IS_NULL (dbval))
 	{
-	  /* all reguvars in g_hk_regu_list are also in g_regu_list; match them by position and update g_hk_regu_list */
-	  for (hk_regu = buildlist->g_hk_sort_regu_list; hk_regu != NULL; hk_regu = hk_regu->next)
+	  if (agg_p->opr_dbtype == DB_TYPE_VARIABLE || agg_p->accumulator_domain.value_dom == NULL
+	      || agg_p->accumulator_domain.value2_dom == NULL)
 	    {
-	      if (hk_regu->value.type == TYPE_POSITION && hk_regu->value.value.pos_descr.pos_no == pos_in_ref_list)
-		{
-		  hk_regu->value.value.pos_descr.dom = ref_domain;
-		  hk_regu->value.domain = ref_domain;
-		}
+	      /* domains will not be resolved at this time */
+	      *resolved = 0;
 	    }
+
+	  /* no need to continue */
+	  continue;
 	}
 
-      /* find value in g_val_list pointed to by vfetch_to ; also find in g_agg_list (if any), the same value
-       * indentified by pointer value in operand */
-      for (g_val_list = buildlist->g_val_list->valp; g_val_list != NULL; g_val_list = g_val_list->next)
+      /* update variable domain of function */
+      if (agg_p->opr_dbtype == DB_TYPE_VARIABLE || TP_DOMAIN_COLLATION_FLAG (agg_p->domain) != TP_DOMAIN_COLL_NORMAL)
 	{
-	  if (g_val_list->val == group_regu->value.vfetch_to)
+	  if (TP_IS_CHAR_TYPE (DB_VALUE_DOMAIN_TYPE (dbval))
+	      && (agg_p->function == PT_SUM || agg_p->function == PT_AVG))
 	    {
-	      val_in_g_val_list_found = true;
-	      val_list_ref_dbvalue = g_val_list->val;
-	      break;
+	      agg_p->domain = tp_domain_resolve_default (DB_TYPE_DOUBLE);
+	    }
+	  else if (!TP_IS_CHAR_TYPE (DB_VALUE_DOMAIN_TYPE (dbval)) && agg_p->function == PT_GROUP_CONCAT)
+	    {
+	      agg_p->domain = tp_domain_resolve_default (DB_TYPE_VARCHAR);
 	    }
+	  else
+	    {
+	      agg_p->domain = tp_domain_resolve_value (dbval, NULL);
+	    }
+	  agg_p->opr_dbtype = TP_DOMAIN_TYPE (agg_p->domain);
 	}
 
-      /* search for corresponding aggregate, by matching the operands REGU VAR update the domains for aggregate and
-       * aggregate's operand */
-      for (group_agg = buildlist->g_agg_list; group_agg != NULL; group_agg = group_agg->next)
+      /* set up domains of accumulator */
+      if (agg_p->domain != NULL && agg_p->opr_dbtype != DB_TYPE_VARIABLE
+	  && (agg_p->accumulator_domain.value_dom == NULL || agg_p->accumulator_domain.value2_dom == NULL))
 	{
-	  if (group_agg->opr_dbtype != DB_TYPE_VARIABLE && !TP_TYPE_HAS_COLLATION (group_agg->opr_dbtype))
+	  switch (agg_p->function)
 	    {
-	      continue;
-	    }
+	    case PT_AGG_BIT_AND:
+	    case PT_AGG_BIT_OR:
+	    case PT_AGG_BIT_XOR:
+	    case PT_MIN:
+	    case PT_MAX:
+	      agg_p->accumulator_domain.value_dom = agg_p->domain;
+	      agg_p->accumulator_domain.value2_dom = &tp_Null_domain;
+	      break;
 
-	  REGU_VARIABLE operand = group_agg->operands->value;
+	    case PT_AVG:
+	    case PT_SUM:
+	      if (TP_IS_NUMERIC_TYPE (DB_VALUE_TYPE (dbval)))
+		{
+		  if (TP_DOMAIN_TYPE (agg_p->domain) == DB_TYPE_NUMERIC)
+		    {
+		      agg_p->accumulator_domain.value_dom =
+			tp_domain_resolve (DB_TYPE_NUMERIC, NULL, DB_MAX_NUMERIC_PRECISION, agg_p->domain->scale, NULL,
+					   0);
+		    }
+		  else if (DB_VALUE_TYPE (dbval) == DB_TYPE_NUMERIC)
+		    {
+		      agg_p->accumulator_domain.value_dom =
+			tp_domain_resolve (DB_TYPE_NUMERIC, NULL, DB_MAX_NUMERIC_PRECISION, DB_VALUE_SCALE (dbval),
+					   NULL, 0);
+		    }
+		  else if (DB_VALUE_TYPE (dbval) == DB_TYPE_FLOAT)
+		    {
+		      agg_p->accumulator_domain.value_dom =
+			tp_domain_resolve (DB_TYPE_DOUBLE, NULL, DB_DOUBLE_DECIMAL_PRECISION, DB_VALUE_SCALE (dbval),
+					   NULL, 0);
+		    }
+		  else
+		    {
+		      agg_p->accumulator_domain.value_dom = tp_domain_resolve_default (DB_VALUE_TYPE (dbval));
+		    }
+		}
+	      else
+		{
+		  agg_p->accumulator_domain.value_dom = agg_p->domain;
+		}
+	      agg_p->accumulator_domain.value2_dom = &tp_Null_domain;
+	      break;
 
-	  assert (operand.type == TYPE_CONSTANT);
+	    case PT_STDDEV:
+	    case PT_STDDEV_POP:
+	    case PT_STDDEV_SAMP:
+	    case PT_VARIANCE:
+	    case PT_VAR_POP:
+	    case PT_VAR_SAMP:
+	      agg_p->accumulator_domain.value_dom = &tp_Double_domain;
+	      agg_p->accumulator_domain.value2_dom = &tp_Double_domain;
+	      break;
 
-	  if ((TP_DOMAIN_TYPE (operand.domain) == DB_TYPE_VARIABLE
-	       || TP_DOMAIN_COLLATION_FLAG (operand.domain) != TP_DOMAIN_COLL_NORMAL)
-	      && operand.value.dbvalptr == val_list_ref_dbvalue)
-	    {
-	      /* update domain of aggregate's operand */
-	      operand.domain = ref_domain;
-	      group_agg->opr_dbtype = TP_DOMAIN_TYPE (ref_domain);
+	    case PT_GROUPBY_NUM:
+	      agg_p->accumulator_domain.value_dom = &tp_Null_domain;
+	      agg_p->accumulator_domain.value2_dom = &tp_Null_domain;
+	      break;
 
-	      if (TP_DOMAIN_TYPE (group_agg->domain) == DB_TYPE_VARIABLE
-		  || TP_DOMAIN_COLLATION_FLAG (group_agg->domain) != TP_DOMAIN_COLL_NORMAL)
+	    case PT_GROUP_CONCAT:
+	      agg_p->accumulator_domain.value_dom = agg_p->domain;
+	      agg_p->accumulator_domain.value2_dom = &tp_Null_domain;
+	      break;
+
+	    case PT_MEDIAN:
+	    case PT_PERCENTILE_CONT:
+	    case PT_PERCENTILE_DISC:
+	      switch (agg_p->opr_dbtype)
 		{
-		  /* set domain at run-time for MEDIAN, PERCENTILE funcs */
-		  if (QPROC_IS_INTERPOLATION_FUNC (group_agg))
+		case DB_TYPE_SHORT:
+		case DB_TYPE_INTEGER:
+		case DB_TYPE_BIGINT:
+		case DB_TYPE_FLOAT:
+		case DB_TYPE_DOUBLE:
+		case DB_TYPE_MONETARY:
+		case DB_TYPE_NUMERIC:
+		case DB_TYPE_DATE:
+		case DB_TYPE_DATETIME:
+		case DB_TYPE_DATETIMETZ:
+		case DB_TYPE_DATETIMELTZ:
+		case DB_TYPE_TIMESTAMP:
+		case DB_TYPE_TIMESTAMPTZ:
+		case DB_TYPE_TIMESTAMPLTZ:
+		case DB_TYPE_TIME:
+		  break;
+
+		default:
+		  assert (agg_p->operands->value.type == TYPE_CONSTANT || agg_p->operands->value.type == TYPE_DBVAL
+			  || agg_p->operands->value.type == TYPE_INARITH);
+
+		  /* try to cast dbval to double, datetime then time */
+		  tmp_domain_p = tp_domain_resolve_default (DB_TYPE_DOUBLE);
+
+		  if (REGU_VARIABLE_IS_FLAGED (&agg_p->operands->value, REGU_VARIABLE_CLEAR_AT_CLONE_DECACHE))
 		    {
-		      continue;
+		      save_heapid = db_change_private_heap (thread_p, 0);
 		    }
-		  else if (group_agg->function == PT_GROUP_CONCAT)
+
+		  status = tp_value_cast (dbval, dbval, tmp_domain_p, false);
+		  if (status != DOMAIN_COMPATIBLE)
 		    {
-		      /* result of GROUP_CONCAT is always string */
-		      if (!TP_TYPE_HAS_COLLATION (TP_DOMAIN_TYPE (ref_domain)))
-			{
-			  ref_domain = tp_domain_resolve_default (DB_TYPE_VARCHAR);
-			}
-		      group_agg->domain = ref_domain;
+		      /* try datetime */
+		      tmp_domain_p = tp_domain_resolve_default (DB_TYPE_DATETIME);
 
-		      db_value_domain_init (group_agg->accumulator.value, TP_DOMAIN_TYPE (ref_domain),
-					    DB_DEFAULT_PRECISION, DB_DEFAULT_SCALE);
-		      db_string_put_cs_and_collation (group_agg->accumulator.value, TP_DOMAIN_CODESET (ref_domain),
-						      TP_DOMAIN_COLLATION (ref_domain));
+		      status = tp_value_cast (dbval, dbval, tmp_domain_p, false);
+		    }
 
-		      g_agg_val_found = true;
-		      break;
+		  /* try time */
+		  if (status != DOMAIN_COMPATIBLE)
+		    {
+		      tmp_domain_p = tp_domain_resolve_default (DB_TYPE_TIME);
+
+		      status = tp_value_cast (dbval, dbval, tmp_domain_p, false);
 		    }
 
-		  assert (group_agg->function == PT_MIN || group_agg->function == PT_MAX
-			  || group_agg->function == PT_SUM);
+		  if (save_heapid != 0)
+		    {
+		      (void) db_change_private_heap (thread_p, save_heapid);
+		      save_heapid = 0;
+		    }
+		  else
+		    {
+		      if (status != DOMAIN_COMPATIBLE)
+			{
+			  pr_clear_value (dbval);
+			}
+		    }
 
-		  group_agg->domain = ref_domain;
-		  db_value_domain_init (group_agg->accumulator.value, group_agg->opr_dbtype, DB_DEFAULT_PRECISION,
-					DB_DEFAULT_SCALE);
-		  if (TP_TYPE_HAS_COLLATION (DB_VALUE_TYPE (group_agg->accumulator.value)))
+		  if (status != DOMAIN_COMPATIBLE)
 		    {
-		      db_string_put_cs_and_collation (group_agg->accumulator.value, TP_DOMAIN_CODESET (ref_domain),
-						      TP_DOMAIN_COLLATION (ref_domain));
+		      error = ER_ARG_CAN_NOT_BE_CASTED_TO_DESIRED_DOMAIN;
+		      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, error, 2, fcode_get_uppercase_name (agg_p->function),
+			      "DOUBLE, DATETIME or TIME");
+
+		      return error;
 		    }
+
+		  /* update domain */
+		  agg_p->domain = tmp_domain_p;
+		  agg_p->accumulator_domain.value_dom = tmp_domain_p;
+		  agg_p->accumulator_domain.value2_dom = &tp_Null_domain;
 		}
-	      else
+	      break;
+	    default:
+	      break;
+	    }
+
+	  /* initialize accumulators */
+	  if (agg_p->accumulator.value != NULL && agg_p->accumulator_domain.value_dom != NULL
+	      && DB_VALUE_TYPE (agg_p->accumulator.value) == DB_TYPE_NULL)
+	    {
+	      if (db_value_domain_init (agg_p->accumulator.value, TP_DOMAIN_TYPE (agg_p->accumulator_domain.value_dom),
+					DB_DEFAULT_PRECISION, DB_DEFAULT_SCALE) != NO_ERROR)
 		{
-		  /* these aggregates have 'group_agg->domain' and 'group_agg->value' already initialized */
-		  assert (group_agg->function == PT_GROUP_CONCAT || group_agg->function == PT_AGG_BIT_AND
-			  || group_agg->function == PT_AGG_BIT_OR || group_agg->function == PT_AGG_BIT_XOR
-			  || group_agg->function == PT_COUNT || group_agg->function == PT_AVG
-			  || group_agg->function == PT_STDDEV || group_agg->function == PT_VARIANCE
-			  || group_agg->function == PT_STDDEV_POP || group_agg->function == PT_VAR_POP
-			  || group_agg->function == PT_STDDEV_SAMP || group_agg->function == PT_VAR_SAMP
-			  || group_agg->function == PT_JSON_ARRAYAGG || group_agg->function == PT_JSON_OBJECTAGG);
+		  return ER_FAILED;
 		}
+	    }
 
-	      g_agg_val_found = true;
-	      break;
+	  if (agg_p->accumulator.value2 != NULL && agg_p->accumulator_domain.value2_dom != NULL
+	      && DB_VALUE_TYPE (agg_p->accumulator.value2) == DB_TYPE_NULL)
+	    {
+	      if (db_value_domain_init (agg_p->accumulator.value2,
+					TP_DOMAIN_TYPE (agg_p->accumulator_domain.value2_dom),
+					DB_DEFAULT_PRECISION, DB_DEFAULT_SCALE) != NO_ERROR)
+		{
+		  return ER_FAILED;
+		}
 	    }
 	}
+    }
+
+  /* all ok */
+  return NO_ERROR;
+}
+
+/*
+ * qexec_groupby_index() - computes group by on the fly from the index list
+ *   return: NO_ERROR, or ER_code
+ *   xasl(in)   :
+ *   xasl_state(in)     : XASL tree state information
+ *   tplrec(out) : Tuple record descriptor to store result tuples
+ *
+ * Note: Apply the group_by clause to the given list file to group it
+ * using the specified group_by parameters.
+ */
+int
+qexec_groupby_index (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state, QFILE_TUPLE_RECORD * tplrec)
+{
+  QFILE_LIST_ID *list_id = xasl->list_id;
+  BUILDLIST_PROC_NODE *buildlist = &xasl->proc.buildlist;
+  GROUPBY_STATE gbstate;
+  QFILE_LIST_SCAN_ID input_scan_id;
+  int result = 0, ls_flag = 0;
+  DB_VALUE *list_dbvals = NULL;
+  int i, ncolumns = 0;
+  SORT_LIST *sort_col = NULL;
+  bool all_cols_equal = false;
+  SCAN_CODE scan_code;
+  QFILE_TUPLE_RECORD tuple_rec = { NULL, 0 };
+  REGU_VARIABLE_LIST regu_list;
+  int tuple_cnt = 0;
+  DB_VALUE val;
 
-      if (!g_agg_val_found)
-	{
-	  continue;
-	}
+  TSC_TICKS start_tick, end_tick;
+  TSCTIMEVAL tv_diff;
 
-      /* search in g_outptr_list for the same value pointer as the value in g_agg_list->value , and update it with the
-       * same domain */
-      for (group_out_regu = buildlist->g_outptr_list->valptrp; group_out_regu != NULL;
-	   group_out_regu = group_out_regu->next)
-	{
-	  assert (group_agg != NULL);
-	  if (group_out_regu->value.type == TYPE_CONSTANT
-	      && group_out_regu->value.value.dbvalptr == group_agg->accumulator.value)
-	    {
-	      if (TP_DOMAIN_TYPE (group_out_regu->value.domain) == DB_TYPE_VARIABLE
-		  || TP_DOMAIN_COLLATION_FLAG (group_out_regu->value.domain) != TP_DOMAIN_COLL_NORMAL)
-		{
-		  group_out_regu->value.domain = ref_domain;
-		}
-	      /* aggregate found in g_outptr_list, end */
-	      break;
-	    }
-	}
-    }
+  db_make_null (&val);
 
-  /* treat case with only NULL values */
-  for (agg_p = buildlist->g_agg_list; agg_p; agg_p = agg_p->next)
+  if (buildlist->groupby_list == NULL)
     {
-      if (agg_p->accumulator_domain.value_dom == NULL)
-	{
-	  agg_p->accumulator_domain.value_dom = &tp_Null_domain;
-	}
+      return NO_ERROR;
+    }
 
-      if (agg_p->accumulator_domain.value2_dom == NULL)
-	{
-	  agg_p->accumulator_domain.value2_dom = &tp_Null_domain;
-	}
+  if (thread_is_on_trace (thread_p))
+    {
+      tsc_getticks (&start_tick);
+      xasl->groupby_stats.run_groupby = true;
+      xasl->groupby_stats.groupby_sort = false;
+      xasl->groupby_stats.groupby_hash = HS_NONE;
+      xasl->groupby_stats.rows = 0;
     }
 
-  /* update hash aggregation domains */
-  if (buildlist->g_hash_eligible)
+  assert (buildlist->g_with_rollup == 0);
+
+  if (qexec_initialize_groupby_state (&gbstate, buildlist->groupby_list, buildlist->g_having_pred,
+				      buildlist->g_grbynum_pred, buildlist->g_grbynum_val, buildlist->g_grbynum_flag,
+				      buildlist->eptr_list, buildlist->g_agg_list, buildlist->g_regu_list,
+				      buildlist->g_val_list, buildlist->g_outptr_list, NULL,
+				      buildlist->g_with_rollup != 0, 0, NULL, xasl, xasl_state, &list_id->type_list,
+				      tplrec) == NULL)
     {
-      AGGREGATE_HASH_CONTEXT *context = buildlist->agg_hash_context;
-      int i, index;
+      GOTO_EXIT_ON_ERROR;
+    }
 
-      /* update key domains */
-      group_regu = buildlist->g_hk_sort_regu_list;
-      for (i = 0; i < buildlist->g_hkey_size && group_regu != NULL; i++, group_regu = group_regu->next)
-	{
-	  if (TP_DOMAIN_TYPE (context->key_domains[i]) == DB_TYPE_VARIABLE
-	      || TP_DOMAIN_COLLATION_FLAG (context->key_domains[i]) != TP_DOMAIN_COLL_NORMAL)
-	    {
-	      context->key_domains[i] = group_regu->value.domain;
-	    }
-	}
+  assert (gbstate.g_dim_levels == 1);
+  assert (gbstate.with_rollup == false);
 
-      /* update type lists of list files */
-      for (i = 0; i < buildlist->g_hkey_size; i++)
-	{
-	  /* partial list */
-	  context->part_list_id->type_list.domp[i] = context->key_domains[i];
+  /*
+   * Create a new listfile to receive the results.
+   */
+  {
+    QFILE_TUPLE_VALUE_TYPE_LIST output_type_list;
+    QFILE_LIST_ID *output_list_id;
 
-	  /* sorted partial list */
-	  context->sorted_part_list_id->type_list.domp[i] = context->key_domains[i];
-	}
+    if (qdata_get_valptr_type_list (thread_p, buildlist->g_outptr_list, &output_type_list) != NO_ERROR)
+      {
+	GOTO_EXIT_ON_ERROR;
+      }
+    /* If it does not have 'order by'(xasl->orderby_list), then the list file to be open at here will be the last one.
+     * Otherwise, the last list file will be open at qexec_orderby_distinct(). (Note that only one that can have 'group
+     * by' is BUILDLIST_PROC type.) And, the top most XASL is the other condition for the list file to be the last
+     * result file. */
 
-      for (i = 0; i < buildlist->g_func_count; i++)
-	{
-	  index = buildlist->g_hkey_size + i * 3;
+    QFILE_SET_FLAG (ls_flag, QFILE_FLAG_ALL);
 
-	  /* partial list */
-	  context->part_list_id->type_list.domp[index] = context->accumulator_domains[i]->value_dom;
-	  context->part_list_id->type_list.domp[index + 1] = context->accumulator_domains[i]->value2_dom;
-	  context->part_list_id->type_list.domp[index + 2] = &tp_Integer_domain;
+    output_list_id =
+      qfile_open_list (thread_p, &output_type_list, buildlist->after_groupby_list, xasl_state->query_id, ls_flag);
 
-	  /* sorted partial list */
-	  context->sorted_part_list_id->type_list.domp[index] = context->accumulator_domains[i]->value_dom;
-	  context->sorted_part_list_id->type_list.domp[index + 1] = context->accumulator_domains[i]->value2_dom;
-	  context->sorted_part_list_id->type_list.domp[index + 2] = &tp_Integer_domain;
-	}
-    }
-}
+    if (output_type_list.domp)
+      {
+	db_private_free_and_init (thread_p, output_type_list.domp);
+      }
 
-/*
- * qexec_resolve_domains_for_aggregation () - update domains of aggregate
- *                                            functions and accumulators
- *   returns: error code or NO_ERROR
- *   thread_p(in): current thread
- *   agg_p(in): aggregate node
- *   xasl_state(in): XASL state
- *   tplrec(in): tuple record used for fetching of value
- *   regu_list(in): regulist (NULL for none)
- *   resolved(out): true if all domains are resolved, false otherwise
- */
-static int
-qexec_resolve_domains_for_aggregation (THREAD_ENTRY * thread_p, AGGREGATE_TYPE * agg_p, XASL_STATE * xasl_state,
-				       QFILE_TUPLE_RECORD * tplrec, REGU_VARIABLE_LIST regu_list, int *resolved)
-{
-  TP_DOMAIN *tmp_domain_p;
-  TP_DOMAIN_STATUS status;
-  DB_VALUE *dbval;
-  int error;
-  HL_HEAPID save_heapid = 0;
+    if (output_list_id == NULL)
+      {
+	GOTO_EXIT_ON_ERROR;
+      }
 
-  /* fetch values */
-  if (regu_list != NULL)
+    gbstate.output_file = output_list_id;
+  }
+
+  if (list_id->tuple_cnt == 0)
     {
-      if (fetch_val_list (thread_p, regu_list, &xasl_state->vd, NULL, NULL, tplrec->tpl, true) != NO_ERROR)
-	{
-	  return ER_FAILED;
-	}
+      /* empty unsorted list file, no need to proceed */
+      qfile_destroy_list (thread_p, list_id);
+      qfile_close_list (thread_p, gbstate.output_file);
+      qfile_copy_list_id (list_id, gbstate.output_file, true);
+      qexec_clear_groupby_state (thread_p, &gbstate);	/* will free gbstate.output_file */
+
+      return NO_ERROR;
+    }
+  else
+    {
+      tuple_cnt = list_id->tuple_cnt;
     }
 
-  /* start off as resolved */
-  *resolved = 1;
+  /*
+   * Open a scan on the unsorted input file
+   */
+  if (qfile_open_list_scan (list_id, &input_scan_id) != NO_ERROR)
+    {
+      GOTO_EXIT_ON_ERROR;
+    }
+  gbstate.input_scan = &input_scan_id;
 
-  /* iterate functions */
-  for (; agg_p != NULL; agg_p = agg_p->next)
+  /* ... go through all records and identify groups */
+
+  /* count the number of columns in group by */
+  for (sort_col = xasl->proc.buildlist.groupby_list; sort_col != NULL; sort_col = sort_col->next)
     {
-      if (agg_p->function == PT_CUME_DIST || agg_p->function == PT_PERCENT_RANK)
-	{
-	  /* operands for CUME_DIST and PERCENT_RANK are of no interest here */
-	  continue;
-	}
+      ncolumns++;
+    }
 
-      if (agg_p->function == PT_COUNT || agg_p->function == PT_COUNT_STAR)
-	{
-	  /* COUNT and COUNT(*) always have the same signature */
-	  agg_p->accumulator_domain.value_dom = &tp_Integer_domain;
-	  agg_p->accumulator_domain.value2_dom = &tp_Null_domain;
+  /* alloc an array to store db_values */
+  list_dbvals = (DB_VALUE *) db_private_alloc (thread_p, ncolumns * sizeof (DB_VALUE));
 
-	  continue;
-	}
+  if (list_dbvals == NULL)
+    {
+      GOTO_EXIT_ON_ERROR;
+    }
 
-      if (agg_p->function == PT_JSON_ARRAYAGG || agg_p->function == PT_JSON_OBJECTAGG)
+  while (1)
+    {
+      if (gbstate.state == SORT_PUT_STOP)
 	{
-	  /* PT_JSON_ARRAYAGG and PT_JSON_OBJECTAGG always have the same signature */
-	  agg_p->accumulator_domain.value_dom = &tp_Json_domain;
-	  agg_p->accumulator_domain.value2_dom = &tp_Null_domain;
-	  continue;
+	  break;
 	}
-
-      DB_VALUE benchmark_dummy_dbval;
-      db_make_double (&benchmark_dummy_dbval, 0);
-      if (agg_p->operands->value.type == TYPE_FUNC && agg_p->operands->value.value.funcp != NULL
-	  && agg_p->operands->value.value.funcp->ftype == F_BENCHMARK)
+      scan_code = qfile_scan_list_next (thread_p, gbstate.input_scan, &tuple_rec, PEEK);
+      if (scan_code != S_SUCCESS)
 	{
-	  // In case we have a benchmark function we want ot avoid the usual superflous function evaluation
-	  dbval = &benchmark_dummy_dbval;
+	  break;
 	}
-      else
+
+      /* fetch the values from the tuple according to outptr format check the result in xasl->outptr_list->valptrp */
+      all_cols_equal = true;
+
+      regu_list = xasl->outptr_list->valptrp;
+      for (i = 0; i < ncolumns; i++)
 	{
-	  /* fetch function operand */
-	  if (fetch_peek_dbval (thread_p, &agg_p->operands->value, &xasl_state->vd, NULL, NULL, NULL, &dbval) !=
-	      NO_ERROR)
+	  if (regu_list == NULL)
 	    {
-	      return ER_FAILED;
+	      gbstate.state = ER_FAILED;
+	      goto exit_on_error;
+	    }
+
+	  if (qexec_get_tuple_column_value (tuple_rec.tpl, i, &val, regu_list->value.domain) != NO_ERROR)
+	    {
+	      gbstate.state = ER_FAILED;
+	      goto exit_on_error;
+	    }
+
+	  if (gbstate.input_recs > 0)
+	    {
+	      /* compare old value with current total_order is 1. Then NULLs are equal. */
+	      int c = tp_value_compare (&list_dbvals[i], &val, 1, 1);
+
+	      if (c != DB_EQ)
+		{
+		  /* must be DB_LT or DB_GT */
+		  if (c != DB_LT && c != DB_GT)
+		    {
+		      assert_release (false);
+		      gbstate.state = ER_FAILED;
+
+		      GOTO_EXIT_ON_ERROR;
+		    }
+
+		  /* new group should begin, check code below */
+		  all_cols_equal = false;
+		}
+
+	      pr_clear_value (&list_dbvals[i]);
 	    }
-	}
 
-      /* handle NULL value */
-      if (dbval == NULL || DB_IS_NULL (dbval))
-	{
-	  if (agg_p->opr_dbtype == DB_TYPE_VARIABLE || agg_p->accumulator_domain.value_dom == NULL
-	      || agg_p->accumulator_domain.value2_dom == NULL)
+	  pr_clone_value (&val, &list_dbvals[i]);
+
+	  if (DB_NEED_CLEAR (&val))
 	    {
-	      /* domains will not be resolved at this time */
-	      *resolved = 0;
+	      pr_clear_value (&val);
 	    }
 
-	  /* no need to continue */
-	  continue;
+	  regu_list = regu_list->next;
 	}
 
-      /* update variable domain of function */
-      if (agg_p->opr_dbtype == DB_TYPE_VARIABLE || TP_DOMAIN_COLLATION_FLAG (agg_p->domain) != TP_DOMAIN_COLL_NORMAL)
+      if (gbstate.input_recs == 0)
 	{
-	  if (TP_IS_CHAR_TYPE (DB_VALUE_DOMAIN_TYPE (dbval))
-	      && (agg_p->function == PT_SUM || agg_p->function == PT_AVG))
-	    {
-	      agg_p->domain = tp_domain_resolve_default (DB_TYPE_DOUBLE);
-	    }
-	  else if (!TP_IS_CHAR_TYPE (DB_VALUE_DOMAIN_TYPE (dbval)) && agg_p->function == PT_GROUP_CONCAT)
-	    {
-	      agg_p->domain = tp_domain_resolve_default (DB_TYPE_VARCHAR);
-	    }
-	  else
-	    {
-	      agg_p->domain = tp_domain_resolve_value (dbval, NULL);
-	    }
-	  agg_p->opr_dbtype = TP_DOMAIN_TYPE (agg_p->domain);
+	  /* First record we've seen; put it out and set up the group comparison key(s). */
+	  qexec_gby_start_group_dim (thread_p, &gbstate, NULL);
 	}
-
-      /* set up domains of accumulator */
-      if (agg_p->domain != NULL && agg_p->opr_dbtype != DB_TYPE_VARIABLE
-	  && (agg_p->accumulator_domain.value_dom == NULL || agg_p->accumulator_domain.value2_dom == NULL))
+      else if (all_cols_equal)
 	{
-	  switch (agg_p->function)
-	    {
-	    case PT_AGG_BIT_AND:
-	    case PT_AGG_BIT_OR:
-	    case PT_AGG_BIT_XOR:
-	    case PT_MIN:
-	    case PT_MAX:
-	      agg_p->accumulator_domain.value_dom = agg_p->domain;
-	      agg_p->accumulator_domain.value2_dom = &tp_Null_domain;
-	      break;
+	  /* Still in the same group; accumulate the tuple and proceed, leaving the group key the same. */
+	}
+      else
+	{
+	  assert (gbstate.g_dim_levels == 1);
+	  assert (gbstate.with_rollup == false);
 
-	    case PT_AVG:
-	    case PT_SUM:
-	      if (TP_IS_NUMERIC_TYPE (DB_VALUE_TYPE (dbval)))
-		{
-		  if (TP_DOMAIN_TYPE (agg_p->domain) == DB_TYPE_NUMERIC)
-		    {
-		      agg_p->accumulator_domain.value_dom =
-			tp_domain_resolve (DB_TYPE_NUMERIC, NULL, DB_MAX_NUMERIC_PRECISION, agg_p->domain->scale, NULL,
-					   0);
-		    }
-		  else if (DB_VALUE_TYPE (dbval) == DB_TYPE_NUMERIC)
-		    {
-		      agg_p->accumulator_domain.value_dom =
-			tp_domain_resolve (DB_TYPE_NUMERIC, NULL, DB_MAX_NUMERIC_PRECISION, DB_VALUE_SCALE (dbval),
-					   NULL, 0);
-		    }
-		  else if (DB_VALUE_TYPE (dbval) == DB_TYPE_FLOAT)
-		    {
-		      agg_p->accumulator_domain.value_dom =
-			tp_domain_resolve (DB_TYPE_DOUBLE, NULL, DB_DOUBLE_DECIMAL_PRECISION, DB_VALUE_SCALE (dbval),
-					   NULL, 0);
-		    }
-		  else
-		    {
-		      agg_p->accumulator_domain.value_dom = tp_domain_resolve_default (DB_VALUE_TYPE (dbval));
-		    }
-		}
-	      else
-		{
-		  agg_p->accumulator_domain.value_dom = agg_p->domain;
-		}
-	      agg_p->accumulator_domain.value2_dom = &tp_Null_domain;
-	      break;
+	  /* We got a new group; finalize the group we were accumulating, and start a new group using the current key
+	   * as the group key. */
+	  qexec_gby_finalize_group_dim (thread_p, &gbstate, NULL);
+	}
 
-	    case PT_STDDEV:
-	    case PT_STDDEV_POP:
-	    case PT_STDDEV_SAMP:
-	    case PT_VARIANCE:
-	    case PT_VAR_POP:
-	    case PT_VAR_SAMP:
-	      agg_p->accumulator_domain.value_dom = &tp_Double_domain;
-	      agg_p->accumulator_domain.value2_dom = &tp_Double_domain;
-	      break;
+      qexec_gby_agg_tuple (thread_p, &gbstate, tuple_rec.tpl, COPY);
 
-	    case PT_GROUPBY_NUM:
-	      agg_p->accumulator_domain.value_dom = &tp_Null_domain;
-	      agg_p->accumulator_domain.value2_dom = &tp_Null_domain;
-	      break;
+      gbstate.input_recs++;
+    }
 
-	    case PT_GROUP_CONCAT:
-	      agg_p->accumulator_domain.value_dom = agg_p->domain;
-	      agg_p->accumulator_domain.value2_dom = &tp_Null_domain;
-	      break;
+  /* ... finish grouping */
 
-	    case PT_MEDIAN:
-	    case PT_PERCENTILE_CONT:
-	    case PT_PERCENTILE_DISC:
-	      switch (agg_p->opr_dbtype)
-		{
-		case DB_TYPE_SHORT:
-		case DB_TYPE_INTEGER:
-		case DB_TYPE_BIGINT:
-		case DB_TYPE_FLOAT:
-		case DB_TYPE_DOUBLE:
-		case DB_TYPE_MONETARY:
-		case DB_TYPE_NUMERIC:
-		case DB_TYPE_DATE:
-		case DB_TYPE_DATETIME:
-		case DB_TYPE_DATETIMETZ:
-		case DB_TYPE_DATETIMELTZ:
-		case DB_TYPE_TIMESTAMP:
-		case DB_TYPE_TIMESTAMPTZ:
-		case DB_TYPE_TIMESTAMPLTZ:
-		case DB_TYPE_TIME:
-		  break;
+  /* There may be one unfinished group in the output. If so, finish it */
+  if (gbstate.input_recs != 0)
+    {
+      qexec_gby_finalize_group_dim (thread_p, &gbstate, NULL);
+    }
 
-		default:
-		  assert (agg_p->operands->value.type == TYPE_CONSTANT || agg_p->operands->value.type == TYPE_DBVAL
-			  || agg_p->operands->value.type == TYPE_INARITH);
+  qfile_close_list (thread_p, gbstate.output_file);
 
-		  /* try to cast dbval to double, datetime then time */
-		  tmp_domain_p = tp_domain_resolve_default (DB_TYPE_DOUBLE);
+  if (gbstate.input_scan)
+    {
+      qfile_close_scan (thread_p, gbstate.input_scan);
+      gbstate.input_scan = NULL;
+    }
+  qfile_destroy_list (thread_p, list_id);
+  qfile_copy_list_id (list_id, gbstate.output_file, true);
 
-		  if (REGU_VARIABLE_IS_FLAGED (&agg_p->operands->value, REGU_VARIABLE_CLEAR_AT_CLONE_DECACHE))
-		    {
-		      save_heapid = db_change_private_heap (thread_p, 0);
-		    }
+  if (XASL_IS_FLAGED (xasl, XASL_IS_MERGE_QUERY) && list_id->tuple_cnt != tuple_cnt)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_MERGE_TOO_MANY_SOURCE_ROWS, 0);
+      result = ER_FAILED;
+    }
 
-		  status = tp_value_cast (dbval, dbval, tmp_domain_p, false);
-		  if (status != DOMAIN_COMPATIBLE)
-		    {
-		      /* try datetime */
-		      tmp_domain_p = tp_domain_resolve_default (DB_TYPE_DATETIME);
+  if (thread_is_on_trace (thread_p))
+    {
+      tsc_getticks (&end_tick);
+      tsc_elapsed_time_usec (&tv_diff, end_tick, start_tick);
+      TSC_ADD_TIMEVAL (xasl->groupby_stats.groupby_time, tv_diff);
+    }
 
-		      status = tp_value_cast (dbval, dbval, tmp_domain_p, false);
-		    }
+exit_on_error:
 
-		  /* try time */
-		  if (status != DOMAIN_COMPATIBLE)
-		    {
-		      tmp_domain_p = tp_domain_resolve_default (DB_TYPE_TIME);
+  if (list_dbvals)
+    {
+      for (i = 0; i < ncolumns; i++)
+	{
+	  pr_clear_value (&(list_dbvals[i]));
+	}
+      db_private_free (thread_p, list_dbvals);
+    }
 
-		      status = tp_value_cast (dbval, dbval, tmp_domain_p, false);
-		    }
+  if (DB_NEED_CLEAR (&val))
+    {
+      pr_clear_value (&val);
+    }
 
-		  if (save_heapid != 0)
-		    {
-		      (void) db_change_private_heap (thread_p, save_heapid);
-		      save_heapid = 0;
-		    }
-		  else
-		    {
-		      if (status != DOMAIN_COMPATIBLE)
-			{
-			  pr_clear_value (dbval);
-			}
-		    }
+  /* SORT_PUT_STOP set by 'qexec_gby_finalize_group_dim ()' isn't error */
+  result = (gbstate.state == NO_ERROR || gbstate.state == SORT_PUT_STOP) ? NO_ERROR : ER_FAILED;
 
-		  if (status != DOMAIN_COMPATIBLE)
-		    {
-		      error = ER_ARG_CAN_NOT_BE_CASTED_TO_DESIRED_DOMAIN;
-		      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, error, 2, fcode_get_uppercase_name (agg_p->function),
-			      "DOUBLE, DATETIME or TIME");
+  qexec_clear_groupby_state (thread_p, &gbstate);
 
-		      return error;
-		    }
+  return result;
+}
+
+/*
+ * query_multi_range_opt_check_set_sort_col () - scans the SPEC nodes in the
+ *						 XASL and resolves the sorting
+ *						 info required for multiple
+ *						 range search optimization
+ *
+ * return	 : error code
+ * thread_p (in) : thread entry
+ * xasl (in)     : xasl node
+ */
+static int
+query_multi_range_opt_check_set_sort_col (THREAD_ENTRY * thread_p, XASL_NODE * xasl)
+{
+  DB_VALUE **sort_col_out_val_ref = NULL;
+  int i = 0, count = 0, index = 0, att_id, sort_index_pos;
+  REGU_VARIABLE_LIST regu_list = NULL;
+  SORT_LIST *orderby_list = NULL;
+  int error = NO_ERROR;
+  MULTI_RANGE_OPT *multi_range_opt = NULL;
+  ACCESS_SPEC_TYPE *spec = NULL;
+
+  if (xasl == NULL || xasl->type != BUILDLIST_PROC || xasl->orderby_list == NULL || xasl->spec_list == NULL)
+    {
+      return NO_ERROR;
+    }
+
+  /* find access spec using multi range optimization */
+  spec = query_multi_range_opt_check_specs (thread_p, xasl);
+  if (spec == NULL)
+    {
+      /* no scan with multi range search optimization was found */
+      return NO_ERROR;
+    }
+  multi_range_opt = &spec->s_id.s.isid.multi_range_opt;
+  /* initialize sort info for multi range search optimization */
+  orderby_list = xasl->orderby_list;
+  while (orderby_list)
+    {
+      count++;
+      orderby_list = orderby_list->next;
+    }
 
-		  /* update domain */
-		  agg_p->domain = tmp_domain_p;
-		  agg_p->accumulator_domain.value_dom = tmp_domain_p;
-		  agg_p->accumulator_domain.value2_dom = &tp_Null_domain;
-		}
-	      break;
-	    default:
-	      break;
+  /* find the addresses contained in REGU VAR for values used in sorting */
+  sort_col_out_val_ref = (DB_VALUE **) db_private_alloc (thread_p, count * sizeof (DB_VALUE *));
+  if (sort_col_out_val_ref == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, count * sizeof (DB_VALUE *));
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+  for (orderby_list = xasl->orderby_list; orderby_list != NULL; orderby_list = orderby_list->next)
+    {
+      i = 0;
+      /* get sort column from 'outptr_list' */
+      for (regu_list = xasl->outptr_list->valptrp; regu_list != NULL; regu_list = regu_list->next)
+	{
+	  if (REGU_VARIABLE_IS_FLAGED (&regu_list->value, REGU_VARIABLE_HIDDEN_COLUMN))
+	    {
+	      continue;
 	    }
-
-	  /* initialize accumulators */
-	  if (agg_p->accumulator.value != NULL && agg_p->accumulator_domain.value_dom != NULL
-	      && DB_VALUE_TYPE (agg_p->accumulator.value) == DB_TYPE_NULL)
+	  if (i == orderby_list->pos_descr.pos_no)
 	    {
-	      if (db_value_domain_init (agg_p->accumulator.value, TP_DOMAIN_TYPE (agg_p->accumulator_domain.value_dom),
-					DB_DEFAULT_PRECISION, DB_DEFAULT_SCALE) != NO_ERROR)
+	      if (regu_list->value.type == TYPE_CONSTANT)
 		{
-		  return ER_FAILED;
+		  sort_col_out_val_ref[index++] = regu_list->value.value.dbvalptr;
 		}
+	      break;
 	    }
+	  i++;
+	}
+    }
+  if (index != count)
+    {
+      /* this is not supposed to happen */
+      assert (0);
+      goto exit_on_error;
+    }
 
-	  if (agg_p->accumulator.value2 != NULL && agg_p->accumulator_domain.value2_dom != NULL
-	      && DB_VALUE_TYPE (agg_p->accumulator.value2) == DB_TYPE_NULL)
+  if (multi_range_opt->num_attrs == 0)
+    {
+      multi_range_opt->num_attrs = count;
+      multi_range_opt->is_desc_order = (bool *) db_private_alloc (thread_p, count * sizeof (bool));
+      if (multi_range_opt->is_desc_order == NULL)
+	{
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, count * sizeof (bool));
+	  goto exit_on_error;
+	}
+      multi_range_opt->sort_att_idx = (int *) db_private_alloc (thread_p, count * sizeof (int));
+      if (multi_range_opt->sort_att_idx == NULL)
+	{
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, count * sizeof (int));
+	  goto exit_on_error;
+	}
+    }
+  else
+    {
+      /* is multi_range_opt already initialized? */
+      assert (0);
+    }
+
+  for (index = 0, orderby_list = xasl->orderby_list; index < count; index++, orderby_list = orderby_list->next)
+    {
+      const DB_VALUE *valp = sort_col_out_val_ref[index];
+
+      att_id = -1;
+      sort_index_pos = -1;
+      /* search the ATTR_ID regu 'fetching to' the output list regu used for sorting */
+      for (regu_list = spec->s_id.s.isid.rest_regu_list; regu_list != NULL; regu_list = regu_list->next)
+	{
+	  if (regu_list->value.type == TYPE_ATTR_ID && regu_list->value.vfetch_to == valp)
 	    {
-	      if (db_value_domain_init (agg_p->accumulator.value2,
-					TP_DOMAIN_TYPE (agg_p->accumulator_domain.value2_dom),
-					DB_DEFAULT_PRECISION, DB_DEFAULT_SCALE) != NO_ERROR)
+	      att_id = regu_list->value.value.attr_descr.id;
+	      break;
+	    }
+	}
+      /* search the attribute in the index attributes */
+      if (att_id != -1)
+	{
+	  for (i = 0; i < spec->s_id.s.isid.bt_num_attrs; i++)
+	    {
+	      if (att_id == spec->s_id.s.isid.bt_attr_ids[i])
 		{
-		  return ER_FAILED;
+		  sort_index_pos = i;
+		  break;
 		}
 	    }
 	}
+      if (sort_index_pos == -1)
+	{
+	  /* REGUs didn't match, at least disable the optimization */
+	  multi_range_opt->use = false;
+	  goto exit;
+	}
+      multi_range_opt->is_desc_order[index] = (orderby_list->s_order == S_DESC) ? true : false;
+      multi_range_opt->sort_att_idx[index] = sort_index_pos;
     }
 
-  /* all ok */
-  return NO_ERROR;
+  /* disable order by in XASL for this execution */
+  if (xasl->option != Q_DISTINCT && xasl->scan_ptr == NULL)
+    {
+      XASL_SET_FLAG (xasl, XASL_SKIP_ORDERBY_LIST);
+      XASL_SET_FLAG (xasl, XASL_USES_MRO);
+    }
+
+exit:
+  if (sort_col_out_val_ref)
+    {
+      db_private_free_and_init (thread_p, sort_col_out_val_ref);
+    }
+  return error;
+
+exit_on_error:
+  error = ER_FAILED;
+  goto exit;
 }
 
 /*
- * qexec_groupby_index() - computes group by on the fly from the index list
+ * query_multi_range_opt_check_specs () - searches the XASL tree for the
+ *					  enabled multiple range search
+ *					  optimized index scan
+ *
+ * return		     : ACCESS_SPEC_TYPE if an index scan with multiple
+ *			       range search enabled is found, NULL otherwise
+ * thread_p (in)	     : thread entry
+ * spec_list (in/out)	     : access spec list
+ */
+static ACCESS_SPEC_TYPE *
+query_multi_range_opt_check_specs (THREAD_ENTRY * thread_p, XASL_NODE * xasl)
+{
+  ACCESS_SPEC_TYPE *spec_list;
+  for (; xasl != NULL; xasl = xasl->scan_ptr)
+    {
+      for (spec_list = xasl->spec_list; spec_list != NULL; spec_list = spec_list->next)
+	{
+	  if (spec_list->access != ACCESS_METHOD_INDEX || spec_list->type != TARGET_CLASS
+	      || spec_list->s_id.type != S_INDX_SCAN)
+	    {
+	      continue;
+	    }
+	  if (spec_list->s_id.s.isid.multi_range_opt.use)
+	    {
+	      return spec_list;
+	    }
+	}
+    }
+  return NULL;
+}
+
+/*
+ * qexec_execute_analytic () -
  *   return: NO_ERROR, or ER_code
  *   xasl(in)   :
- *   xasl_state(in)     : XASL tree state information
+ *   xasl_state(in) : XASL tree state information
+ *   analytic_func_p(in): Analytic function pointer
  *   tplrec(out) : Tuple record descriptor to store result tuples
- *
- * Note: Apply the group_by clause to the given list file to group it
- * using the specified group_by parameters.
+ *   next_func(out) : next unprocessed function
  */
-int
-qexec_groupby_index (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state, QFILE_TUPLE_RECORD * tplrec)
+static int
+qexec_execute_analytic (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state,
+			ANALYTIC_EVAL_TYPE * analytic_eval, QFILE_TUPLE_RECORD * tplrec, bool is_last)
 {
   QFILE_LIST_ID *list_id = xasl->list_id;
   BUILDLIST_PROC_NODE *buildlist = &xasl->proc.buildlist;
-  GROUPBY_STATE gbstate;
-  QFILE_LIST_SCAN_ID input_scan_id;
-  int result = 0, ls_flag = 0;
-  DB_VALUE *list_dbvals = NULL;
-  int i, ncolumns = 0;
-  SORT_LIST *sort_col = NULL;
-  bool all_cols_equal = false;
-  SCAN_CODE scan_code;
-  QFILE_TUPLE_RECORD tuple_rec = { NULL, 0 };
-  REGU_VARIABLE_LIST regu_list;
-  int tuple_cnt = 0;
-  DB_VALUE val;
+  ANALYTIC_STATE analytic_state;
+  QFILE_LIST_SCAN_ID input_scan_id, interm_scan_id;
+  OUTPTR_LIST *a_outptr_list;
+  int ls_flag = 0;
+  int estimated_pages;
+  bool finalized = false;
+  int i = 0;
+  ANALYTIC_TYPE *func_p = NULL;
 
-  TSC_TICKS start_tick, end_tick;
-  TSCTIMEVAL tv_diff;
+  /* fetch regulist and outlist */
+  a_outptr_list = (is_last ? buildlist->a_outptr_list : buildlist->a_outptr_list_interm);
 
-  db_make_null (&val);
+  /* resolve late bindings in analytic sort list */
+  qexec_resolve_domains_on_sort_list (analytic_eval->sort_list, buildlist->a_outptr_list_ex->valptrp);
 
-  if (buildlist->groupby_list == NULL)
+  /* initialized analytic functions state structure */
+  if (qexec_initialize_analytic_state (thread_p, &analytic_state, analytic_eval->head, analytic_eval->sort_list,
+				       buildlist->a_regu_list, buildlist->a_val_list, a_outptr_list,
+				       buildlist->a_outptr_list_interm, is_last, xasl, xasl_state, &list_id->type_list,
+				       tplrec) == NULL)
     {
-      return NO_ERROR;
+      GOTO_EXIT_ON_ERROR;
     }
 
-  if (thread_is_on_trace (thread_p))
+  if (analytic_state.is_last_run)
     {
-      tsc_getticks (&start_tick);
-      xasl->groupby_stats.run_groupby = true;
-      xasl->groupby_stats.groupby_sort = false;
-      xasl->groupby_stats.groupby_hash = HS_NONE;
-      xasl->groupby_stats.rows = 0;
+      /* for last function, evaluate instnum() predicate while sorting */
+      xasl->instnum_pred = buildlist->a_instnum_pred;
+      xasl->instnum_val = buildlist->a_instnum_val;
+      xasl->instnum_flag = buildlist->a_instnum_flag;
+
+      if (xasl->instnum_val != NULL)
+	{
+	  /* initialize counter to zero */
+	  (void) db_make_bigint (xasl->instnum_val, 0);
+	}
     }
 
-  assert (buildlist->g_with_rollup == 0);
+  /* create intermediary and output list files */
+  {
+    QFILE_TUPLE_VALUE_TYPE_LIST interm_type_list, output_type_list;
+    QFILE_LIST_ID *interm_list_id;
+    QFILE_LIST_ID *output_list_id;
 
-  if (qexec_initialize_groupby_state (&gbstate, buildlist->groupby_list, buildlist->g_having_pred,
-				      buildlist->g_grbynum_pred, buildlist->g_grbynum_val, buildlist->g_grbynum_flag,
-				      buildlist->eptr_list, buildlist->g_agg_list, buildlist->g_regu_list,
-				      buildlist->g_val_list, buildlist->g_outptr_list, NULL,
-				      buildlist->g_with_rollup != 0, 0, NULL, xasl, xasl_state, &list_id->type_list,
-				      tplrec) == NULL)
-    {
-      GOTO_EXIT_ON_ERROR;
-    }
+    /* open intermediate file */
+    if (qdata_get_valptr_type_list (thread_p, buildlist->a_outptr_list_interm, &interm_type_list) != NO_ERROR)
+      {
+	GOTO_EXIT_ON_ERROR;
+      }
+
+    interm_list_id = qfile_open_list (thread_p, &interm_type_list, NULL, xasl_state->query_id, ls_flag);
+
+    if (interm_type_list.domp)
+      {
+	db_private_free_and_init (thread_p, interm_type_list.domp);
+      }
+
+    if (interm_list_id == NULL)
+      {
+	GOTO_EXIT_ON_ERROR;
+      }
 
-  assert (gbstate.g_dim_levels == 1);
-  assert (gbstate.with_rollup == false);
+    analytic_state.interm_file = interm_list_id;
 
-  /*
-   * Create a new listfile to receive the results.
-   */
-  {
-    QFILE_TUPLE_VALUE_TYPE_LIST output_type_list;
-    QFILE_LIST_ID *output_list_id;
+    /* last iteration results in xasl result file */
+    if (is_last)
+      {
+	QFILE_SET_FLAG (ls_flag, QFILE_FLAG_ALL);
+	if (XASL_IS_FLAGED (xasl, XASL_TOP_MOST_XASL) && XASL_IS_FLAGED (xasl, XASL_TO_BE_CACHED)
+	    && (xasl->orderby_list == NULL || XASL_IS_FLAGED (xasl, XASL_SKIP_ORDERBY_LIST))
+	    && xasl->option != Q_DISTINCT)
+	  {
+	    QFILE_SET_FLAG (ls_flag, QFILE_FLAG_RESULT_FILE);
+	  }
+      }
 
-    if (qdata_get_valptr_type_list (thread_p, buildlist->g_outptr_list, &output_type_list) != NO_ERROR)
+    /* open output file */
+    if (qdata_get_valptr_type_list (thread_p, a_outptr_list, &output_type_list) != NO_ERROR)
       {
 	GOTO_EXIT_ON_ERROR;
       }
-    /* If it does not have 'order by'(xasl->orderby_list), then the list file to be open at here will be the last one.
-     * Otherwise, the last list file will be open at qexec_orderby_distinct(). (Note that only one that can have 'group
-     * by' is BUILDLIST_PROC type.) And, the top most XASL is the other condition for the list file to be the last
-     * result file. */
 
-    QFILE_SET_FLAG (ls_flag, QFILE_FLAG_ALL);
-
-    output_list_id =
-      qfile_open_list (thread_p, &output_type_list, buildlist->after_groupby_list, xasl_state->query_id, ls_flag);
+    output_list_id = qfile_open_list (thread_p, &output_type_list, NULL, xasl_state->query_id, ls_flag);
 
     if (output_type_list.domp)
       {
@@ -18907,22 +20153,14 @@ qexec_groupby_index (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xas
 	GOTO_EXIT_ON_ERROR;
       }
 
-    gbstate.output_file = output_list_id;
+    analytic_state.output_file = output_list_id;
   }
 
   if (list_id->tuple_cnt == 0)
     {
-      /* empty unsorted list file, no need to proceed */
-      qfile_destroy_list (thread_p, list_id);
-      qfile_close_list (thread_p, gbstate.output_file);
-      qfile_copy_list_id (list_id, gbstate.output_file, true);
-      qexec_clear_groupby_state (thread_p, &gbstate);	/* will free gbstate.output_file */
-
-      return NO_ERROR;
-    }
-  else
-    {
-      tuple_cnt = list_id->tuple_cnt;
+      /* empty list files, no need to proceed */
+      analytic_state.state = NO_ERROR;
+      goto wrapup;
     }
 
   /*
@@ -18932,1508 +20170,1529 @@ qexec_groupby_index (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xas
     {
       GOTO_EXIT_ON_ERROR;
     }
-  gbstate.input_scan = &input_scan_id;
-
-  /* ... go through all records and identify groups */
+  analytic_state.input_scan = &input_scan_id;
 
-  /* count the number of columns in group by */
-  for (sort_col = xasl->proc.buildlist.groupby_list; sort_col != NULL; sort_col = sort_col->next)
+  /*
+   * open a scan on the intermediate file
+   */
+  if (qfile_open_list_scan (analytic_state.interm_file, &interm_scan_id) != NO_ERROR)
     {
-      ncolumns++;
+      GOTO_EXIT_ON_ERROR;
     }
+  interm_scan_id.keep_page_on_finish = 1;
+  analytic_state.interm_scan = &interm_scan_id;
 
-  /* alloc an array to store db_values */
-  list_dbvals = (DB_VALUE *) db_private_alloc (thread_p, ncolumns * sizeof (DB_VALUE));
+  /*
+   * Now load up the sort module and set it off...
+   */
 
-  if (list_dbvals == NULL)
+  estimated_pages = qfile_get_estimated_pages_for_sorting (list_id, &analytic_state.key_info);
+
+  /* number of sort keys is always less than list file column count, as sort columns are included */
+  analytic_state.key_info.use_original = 1;
+  analytic_state.cmp_fn = &qfile_compare_partial_sort_record;
+
+  if (sort_listfile (thread_p, NULL_VOLID, estimated_pages, &qexec_analytic_get_next, &analytic_state,
+		     &qexec_analytic_put_next, &analytic_state, analytic_state.cmp_fn, &analytic_state.key_info,
+		     SORT_DUP, NO_SORT_LIMIT) != NO_ERROR)
     {
       GOTO_EXIT_ON_ERROR;
     }
 
-  while (1)
+  /* check sort error */
+  if (analytic_state.key_info.error != NO_ERROR)
     {
-      if (gbstate.state == SORT_PUT_STOP)
-	{
-	  break;
-	}
-      scan_code = qfile_scan_list_next (thread_p, gbstate.input_scan, &tuple_rec, PEEK);
-      if (scan_code != S_SUCCESS)
+      if (analytic_state.key_info.error == ER_ARG_CAN_NOT_BE_CASTED_TO_DESIRED_DOMAIN)
 	{
-	  break;
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_ARG_CAN_NOT_BE_CASTED_TO_DESIRED_DOMAIN, 2,
+		  fcode_get_uppercase_name (analytic_eval->head->function), "DOUBLE, DATETIME or TIME");
 	}
 
-      /* fetch the values from the tuple according to outptr format check the result in xasl->outptr_list->valptrp */
-      all_cols_equal = true;
+      GOTO_EXIT_ON_ERROR;
+    }
 
-      regu_list = xasl->outptr_list->valptrp;
-      for (i = 0; i < ncolumns; i++)
+  /*
+   * There may be one unfinished group in the output, since the sort_listfile
+   * interface doesn't include a finalization function.  If so, finish
+   * off that group.
+   */
+  if (analytic_state.input_recs != 0)
+    {
+      for (i = 0; i < analytic_state.func_count; i++)
 	{
-	  if (regu_list == NULL)
+	  if (qexec_analytic_finalize_group (thread_p, analytic_state.xasl_state, &analytic_state.func_state_list[i],
+					     false) != NO_ERROR)
 	    {
-	      gbstate.state = ER_FAILED;
-	      goto exit_on_error;
+	      GOTO_EXIT_ON_ERROR;
 	    }
+	}
 
-	  if (qexec_get_tuple_column_value (tuple_rec.tpl, i, &val, regu_list->value.domain) != NO_ERROR)
-	    {
-	      gbstate.state = ER_FAILED;
-	      goto exit_on_error;
-	    }
+      finalized = true;
 
-	  if (gbstate.input_recs > 0)
-	    {
-	      /* compare old value with current total_order is 1. Then NULLs are equal. */
-	      int c = tp_value_compare (&list_dbvals[i], &val, 1, 1);
+      /* reiterate intermediate file and write output using function result files */
+      if (qexec_analytic_update_group_result (thread_p, &analytic_state) != NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
+    }
 
-	      if (c != DB_EQ)
-		{
-		  /* must be DB_LT or DB_GT */
-		  if (c != DB_LT && c != DB_GT)
-		    {
-		      assert_release (false);
-		      gbstate.state = ER_FAILED;
+wrapup:
+  if (analytic_state.state == NO_ERROR)
+    {
+      /* clear current input: sort items and input scan */
+      if (analytic_state.curr_sort_page.page_p != NULL)
+	{
+	  qmgr_free_old_page_and_init (thread_p, analytic_state.curr_sort_page.page_p,
+				       analytic_state.input_scan->list_id.tfile_vfid);
+	  analytic_state.curr_sort_page.vpid.pageid = NULL_PAGEID;
+	  analytic_state.curr_sort_page.vpid.volid = NULL_VOLID;
+	}
+      if (analytic_state.input_scan)
+	{
+	  qfile_close_scan (thread_p, analytic_state.input_scan);
+	  analytic_state.input_scan = NULL;
+	}
 
-		      GOTO_EXIT_ON_ERROR;
-		    }
+      /* replace current input with output */
+      qfile_close_list (thread_p, analytic_state.output_file);
+      qfile_destroy_list (thread_p, list_id);
+      qfile_copy_list_id (list_id, analytic_state.output_file, true);
 
-		  /* new group should begin, check code below */
-		  all_cols_equal = false;
-		}
+      qfile_free_list_id (analytic_state.output_file);
+      analytic_state.output_file = NULL;
+    }
 
-	      pr_clear_value (&list_dbvals[i]);
-	    }
+  /* clear internal processing items */
+  qexec_clear_analytic_state (thread_p, &analytic_state);
 
-	  pr_clone_value (&val, &list_dbvals[i]);
+  return (analytic_state.state == NO_ERROR) ? NO_ERROR : ER_FAILED;
 
-	  if (DB_NEED_CLEAR (&val))
+exit_on_error:
+  ASSERT_ERROR_AND_SET (analytic_state.state);
+
+  if (!finalized)
+    {
+      /* make sure all the list_files are destroyed correctly */
+      for (i = 0; i < analytic_state.func_count; i++)
+	{
+	  func_p = analytic_state.func_state_list[i].func_p;
+	  if (func_p != NULL && func_p->option == Q_DISTINCT && func_p->list_id != NULL)
 	    {
-	      pr_clear_value (&val);
+	      qfile_close_list (thread_p, func_p->list_id);
+	      qfile_destroy_list (thread_p, func_p->list_id);
 	    }
-
-	  regu_list = regu_list->next;
 	}
+    }
 
-      if (gbstate.input_recs == 0)
-	{
-	  /* First record we've seen; put it out and set up the group comparison key(s). */
-	  qexec_gby_start_group_dim (thread_p, &gbstate, NULL);
-	}
-      else if (all_cols_equal)
-	{
-	  /* Still in the same group; accumulate the tuple and proceed, leaving the group key the same. */
-	}
-      else
-	{
-	  assert (gbstate.g_dim_levels == 1);
-	  assert (gbstate.with_rollup == false);
+  goto wrapup;
+}
 
-	  /* We got a new group; finalize the group we were accumulating, and start a new group using the current key
-	   * as the group key. */
-	  qexec_gby_finalize_group_dim (thread_p, &gbstate, NULL);
-	}
+/*
+ * qexec_initialize_analytic_function_state () - initialize a function state
+ *   returns: error code or NO_ERROR
+ *   thread_p(in): thread entry
+ *   func_state(in/out): function state
+ *   func_p(in): function to initialize state for
+ */
+static int
+qexec_initialize_analytic_function_state (THREAD_ENTRY * thread_p, ANALYTIC_FUNCTION_STATE * func_state,
+					  ANALYTIC_TYPE * func_p, XASL_STATE * xasl_state)
+{
+  QFILE_TUPLE_VALUE_TYPE_LIST group_type_list, value_type_list;
 
-      qexec_gby_agg_tuple (thread_p, &gbstate, tuple_rec.tpl, COPY);
+  assert (func_state != NULL);
 
-      gbstate.input_recs++;
+  /* register function */
+  func_state->func_p = func_p;
+
+  /* initialize function state */
+  func_state->current_key.data = (char *) db_private_alloc (thread_p, DB_PAGESIZE);
+  if (func_state->current_key.data == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) DB_PAGESIZE);
+      return ER_FAILED;
     }
+  func_state->current_key.area_size = DB_PAGESIZE;
+  func_state->current_key.length = 0;
+  func_state->current_key.type = 0;
 
-  /* ... finish grouping */
+  /* zero input recs */
+  func_state->curr_group_tuple_count = 0;
+  func_state->curr_group_tuple_count_nn = 0;
+  func_state->curr_sort_key_tuple_count = 0;
 
-  /* There may be one unfinished group in the output. If so, finish it */
-  if (gbstate.input_recs != 0)
+  /* initialize tuple record */
+  func_state->group_tplrec.size = 0;
+  func_state->group_tplrec.tpl = NULL;
+  func_state->value_tplrec.size = 0;
+  func_state->value_tplrec.tpl = NULL;
+
+  /* initialize dbvals */
+  db_make_null (&func_state->csktc_dbval);
+  db_make_null (&func_state->cgtc_dbval);
+  db_make_null (&func_state->cgtc_nn_dbval);
+
+  /* initialize group header listfile */
+  group_type_list.type_cnt = 2;
+  group_type_list.domp = (TP_DOMAIN **) db_private_alloc (thread_p, sizeof (TP_DOMAIN *) * 2);
+  if (group_type_list.domp == NULL)
     {
-      qexec_gby_finalize_group_dim (thread_p, &gbstate, NULL);
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) DB_PAGESIZE);
+      return ER_FAILED;
     }
+  group_type_list.domp[0] = &tp_Integer_domain;
+  group_type_list.domp[1] = &tp_Integer_domain;
 
-  qfile_close_list (thread_p, gbstate.output_file);
+  func_state->group_list_id = qfile_open_list (thread_p, &group_type_list, NULL, xasl_state->query_id, 0);
 
-  if (gbstate.input_scan)
+  db_private_free_and_init (thread_p, group_type_list.domp);
+
+  func_state->group_list_id->tpl_descr.f_cnt = 2;
+  func_state->group_list_id->tpl_descr.f_valp = (DB_VALUE **) malloc (sizeof (DB_VALUE *) * 2);
+  if (func_state->group_list_id->tpl_descr.f_valp == NULL)
     {
-      qfile_close_scan (thread_p, gbstate.input_scan);
-      gbstate.input_scan = NULL;
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) DB_PAGESIZE);
+      return ER_FAILED;
     }
-  qfile_destroy_list (thread_p, list_id);
-  qfile_copy_list_id (list_id, gbstate.output_file, true);
+  func_state->group_list_id->tpl_descr.f_valp[0] = &func_state->cgtc_dbval;
+  func_state->group_list_id->tpl_descr.f_valp[1] = &func_state->cgtc_nn_dbval;
 
-  if (XASL_IS_FLAGED (xasl, XASL_IS_MERGE_QUERY) && list_id->tuple_cnt != tuple_cnt)
+  func_state->group_list_id->tpl_descr.clear_f_val_at_clone_decache = (bool *) malloc (sizeof (bool) * 2);
+  if (func_state->group_list_id->tpl_descr.clear_f_val_at_clone_decache == NULL)
     {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_MERGE_TOO_MANY_SOURCE_ROWS, 0);
-      result = ER_FAILED;
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, sizeof (bool) * 2);
+      return ER_FAILED;
     }
+  func_state->group_list_id->tpl_descr.clear_f_val_at_clone_decache[0] =
+    func_state->group_list_id->tpl_descr.clear_f_val_at_clone_decache[1] = false;
 
-  if (thread_is_on_trace (thread_p))
+  /* initialize group value listfile */
+  value_type_list.type_cnt = 2;
+  value_type_list.domp = (TP_DOMAIN **) db_private_alloc (thread_p, sizeof (TP_DOMAIN *) * 2);
+  if (value_type_list.domp == NULL)
     {
-      tsc_getticks (&end_tick);
-      tsc_elapsed_time_usec (&tv_diff, end_tick, start_tick);
-      TSC_ADD_TIMEVAL (xasl->groupby_stats.groupby_time, tv_diff);
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) DB_PAGESIZE);
+      return ER_FAILED;
     }
+  value_type_list.domp[0] = &tp_Integer_domain;
+  value_type_list.domp[1] = func_state->func_p->domain;
 
-exit_on_error:
+  func_state->value_list_id = qfile_open_list (thread_p, &value_type_list, NULL, xasl_state->query_id, 0);
 
-  if (list_dbvals)
+  db_private_free_and_init (thread_p, value_type_list.domp);
+
+  func_state->value_list_id->tpl_descr.f_cnt = 2;
+  func_state->value_list_id->tpl_descr.f_valp = (DB_VALUE **) malloc (sizeof (DB_VALUE *) * 2);
+  if (func_state->value_list_id->tpl_descr.f_valp == NULL)
     {
-      for (i = 0; i < ncolumns; i++)
-	{
-	  pr_clear_value (&(list_dbvals[i]));
-	}
-      db_private_free (thread_p, list_dbvals);
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) DB_PAGESIZE);
+      return ER_FAILED;
     }
+  func_state->value_list_id->tpl_descr.f_valp[0] = &func_state->csktc_dbval;
+  func_state->value_list_id->tpl_descr.f_valp[1] = func_p->value;
 
-  if (DB_NEED_CLEAR (&val))
+  func_state->value_list_id->tpl_descr.clear_f_val_at_clone_decache = (bool *) malloc (sizeof (bool) * 2);
+  if (func_state->value_list_id->tpl_descr.clear_f_val_at_clone_decache == NULL)
     {
-      pr_clear_value (&val);
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, sizeof (bool) * 2);
+      return ER_FAILED;
     }
+  func_state->value_list_id->tpl_descr.clear_f_val_at_clone_decache[0] =
+    func_state->value_list_id->tpl_descr.clear_f_val_at_clone_decache[1] = false;
 
-  /* SORT_PUT_STOP set by 'qexec_gby_finalize_group_dim ()' isn't error */
-  result = (gbstate.state == NO_ERROR || gbstate.state == SORT_PUT_STOP) ? NO_ERROR : ER_FAILED;
-
-  qexec_clear_groupby_state (thread_p, &gbstate);
-
-  return result;
+  return NO_ERROR;
 }
 
 /*
- * query_multi_range_opt_check_set_sort_col () - scans the SPEC nodes in the
- *						 XASL and resolves the sorting
- *						 info required for multiple
- *						 range search optimization
- *
- * return	 : error code
- * thread_p (in) : thread entry
- * xasl (in)     : xasl node
+ * qexec_initialize_analytic_state () -
+ *   return:
+ *   analytic_state(in) :
+ *   a_func_list(in)    : Analytic functions list
+ *   a_regu_list(in)    : Regulator variable list
+ *   a_regu_list_ex(in)	: Extended regulator variable list
+ *   a_val_list(in)     : Value list
+ *   a_outptr_list(in)  : Output pointer list
+ *   xasl_state(in)     : XASL tree state information
+ *   type_list(in)      :
+ *   tplrec(out) 	: Tuple record descriptor to store result tuples
  */
-static int
-query_multi_range_opt_check_set_sort_col (THREAD_ENTRY * thread_p, XASL_NODE * xasl)
+static ANALYTIC_STATE *
+qexec_initialize_analytic_state (THREAD_ENTRY * thread_p, ANALYTIC_STATE * analytic_state, ANALYTIC_TYPE * a_func_list,
+				 SORT_LIST * sort_list, REGU_VARIABLE_LIST a_regu_list, VAL_LIST * a_val_list,
+				 OUTPTR_LIST * a_outptr_list, OUTPTR_LIST * a_outptr_list_interm, bool is_last_run,
+				 XASL_NODE * xasl, XASL_STATE * xasl_state, QFILE_TUPLE_VALUE_TYPE_LIST * type_list,
+				 QFILE_TUPLE_RECORD * tplrec)
 {
-  DB_VALUE **sort_col_out_val_ref = NULL;
-  int i = 0, count = 0, index = 0, att_id, sort_index_pos;
   REGU_VARIABLE_LIST regu_list = NULL;
-  SORT_LIST *orderby_list = NULL;
-  int error = NO_ERROR;
-  MULTI_RANGE_OPT *multi_range_opt = NULL;
-  ACCESS_SPEC_TYPE *spec = NULL;
+  ANALYTIC_TYPE *func_p;
+  bool has_interpolation_func = false;
+  SUBKEY_INFO *subkey = NULL;
+  int i;
+  int interpolation_func_sort_prefix_len = 0;
 
-  if (xasl == NULL || xasl->type != BUILDLIST_PROC || xasl->orderby_list == NULL || xasl->spec_list == NULL)
+  analytic_state->state = NO_ERROR;
+
+  analytic_state->input_scan = NULL;
+  analytic_state->interm_scan = NULL;
+  analytic_state->interm_file = NULL;
+  analytic_state->output_file = NULL;
+
+  analytic_state->a_regu_list = a_regu_list;
+  analytic_state->a_outptr_list = a_outptr_list;
+  analytic_state->a_outptr_list_interm = a_outptr_list_interm;
+
+  analytic_state->xasl = xasl;
+  analytic_state->xasl_state = xasl_state;
+
+  analytic_state->is_last_run = is_last_run;
+
+  analytic_state->analytic_rec.area_size = 0;
+  analytic_state->analytic_rec.length = 0;
+  analytic_state->analytic_rec.type = 0;	/* Unused */
+  analytic_state->analytic_rec.data = NULL;
+  analytic_state->output_tplrec = NULL;
+  analytic_state->input_tplrec.size = 0;
+  analytic_state->input_tplrec.tpl = 0;
+  analytic_state->input_recs = 0;
+
+  analytic_state->curr_sort_page.vpid.pageid = NULL_PAGEID;
+  analytic_state->curr_sort_page.vpid.volid = NULL_VOLID;
+  analytic_state->curr_sort_page.page_p = NULL;
+  analytic_state->output_tplrec = tplrec;
+
+  if (sort_list)
     {
-      return NO_ERROR;
+      if (qfile_initialize_sort_key_info (&analytic_state->key_info, sort_list, type_list) == NULL)
+	{
+	  return NULL;
+	}
+    }
+  else
+    {
+      analytic_state->key_info.nkeys = 0;
+      analytic_state->key_info.use_original = 1;
+      analytic_state->key_info.key = NULL;
+      analytic_state->key_info.error = NO_ERROR;
     }
 
-  /* find access spec using multi range optimization */
-  spec = query_multi_range_opt_check_specs (thread_p, xasl);
-  if (spec == NULL)
+  /* build function states */
+  for (analytic_state->func_count = 0, func_p = a_func_list; func_p != NULL;
+       analytic_state->func_count++, func_p = func_p->next)
     {
-      /* no scan with multi range search optimization was found */
-      return NO_ERROR;
+      ;				/* count analytic functions */
     }
-  multi_range_opt = &spec->s_id.s.isid.multi_range_opt;
-  /* initialize sort info for multi range search optimization */
-  orderby_list = xasl->orderby_list;
-  while (orderby_list)
+
+  analytic_state->func_state_list =
+    (ANALYTIC_FUNCTION_STATE *) db_private_alloc (thread_p,
+						  sizeof (ANALYTIC_FUNCTION_STATE) * analytic_state->func_count);
+  if (analytic_state->func_state_list == NULL)
     {
-      count++;
-      orderby_list = orderby_list->next;
+      return NULL;
     }
 
-  /* find the addresses contained in REGU VAR for values used in sorting */
-  sort_col_out_val_ref = (DB_VALUE **) db_private_alloc (thread_p, count * sizeof (DB_VALUE *));
-  if (sort_col_out_val_ref == NULL)
+  memset (analytic_state->func_state_list, 0, analytic_state->func_count * sizeof (ANALYTIC_FUNCTION_STATE));
+  for (i = 0, func_p = a_func_list; i < analytic_state->func_count; i++, func_p = func_p->next)
     {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, count * sizeof (DB_VALUE *));
-      return ER_OUT_OF_VIRTUAL_MEMORY;
+      if (qexec_initialize_analytic_function_state (thread_p, &analytic_state->func_state_list[i], func_p, xasl_state)
+	  != NO_ERROR)
+	{
+	  return NULL;
+	}
     }
-  for (orderby_list = xasl->orderby_list; orderby_list != NULL; orderby_list = orderby_list->next)
+
+  /* initialize runtime structure */
+  for (func_p = a_func_list; func_p != NULL; func_p = func_p->next)
     {
-      i = 0;
-      /* get sort column from 'outptr_list' */
-      for (regu_list = xasl->outptr_list->valptrp; regu_list != NULL; regu_list = regu_list->next)
+      if (QPROC_IS_INTERPOLATION_FUNC (func_p))
 	{
-	  if (REGU_VARIABLE_IS_FLAGED (&regu_list->value, REGU_VARIABLE_HIDDEN_COLUMN))
+	  has_interpolation_func = true;
+
+	  if (interpolation_func_sort_prefix_len == 0)
 	    {
-	      continue;
+	      interpolation_func_sort_prefix_len = func_p->sort_prefix_size;
 	    }
-	  if (i == orderby_list->pos_descr.pos_no)
+	  else
 	    {
-	      if (regu_list->value.type == TYPE_CONSTANT)
-		{
-		  sort_col_out_val_ref[index++] = regu_list->value.value.dbvalptr;
-		}
-	      break;
+	      assert (interpolation_func_sort_prefix_len == func_p->sort_prefix_size);
 	    }
-	  i++;
 	}
     }
-  if (index != count)
+
+  /* set SUBKEY_INFO.cmp_dom */
+  if (has_interpolation_func)
     {
-      /* this is not supposed to happen */
-      assert (0);
-      goto exit_on_error;
+      for (i = 0, subkey = analytic_state->key_info.key; i < analytic_state->key_info.nkeys && subkey != NULL;
+	   ++i, ++subkey)
+	{
+	  if (i >= interpolation_func_sort_prefix_len && TP_IS_STRING_TYPE (TP_DOMAIN_TYPE (subkey->col_dom)))
+	    {
+	      subkey->use_cmp_dom = true;
+	    }
+	}
+    }
+
+  /* resolve domains in regulist */
+  for (regu_list = a_regu_list; regu_list; regu_list = regu_list->next)
+    {
+      /* if it's position, resolve domain */
+      if (regu_list->value.type == TYPE_POSITION
+	  && (TP_DOMAIN_TYPE (regu_list->value.value.pos_descr.dom) == DB_TYPE_VARIABLE
+	      || TP_DOMAIN_COLLATION_FLAG (regu_list->value.value.pos_descr.dom) != TP_DOMAIN_COLL_NORMAL))
+	{
+	  int pos = regu_list->value.value.pos_descr.pos_no;
+	  if (pos <= type_list->type_cnt)
+	    {
+	      regu_list->value.value.pos_descr.dom = type_list->domp[pos];
+	      regu_list->value.domain = type_list->domp[pos];
+	    }
+	}
     }
 
-  if (multi_range_opt->num_attrs == 0)
+  return analytic_state;
+}
+
+/*
+ * qexec_analytic_get_next () -
+ *   return:
+ *   recdes(in) :
+ *   arg(in)    :
+ */
+static SORT_STATUS
+qexec_analytic_get_next (THREAD_ENTRY * thread_p, RECDES * recdes, void *arg)
+{
+  ANALYTIC_STATE *analytic_state;
+
+  analytic_state = (ANALYTIC_STATE *) arg;
+
+  return qfile_make_sort_key (thread_p, &analytic_state->key_info, recdes, analytic_state->input_scan,
+			      &analytic_state->input_tplrec);
+}
+
+/*
+ * qexec_analytic_put_next () -
+ *   return:
+ *   recdes(in) :
+ *   arg(in)    :
+ */
+static int
+qexec_analytic_put_next (THREAD_ENTRY * thread_p, const RECDES * recdes, void *arg)
+{
+  ANALYTIC_STATE *analytic_state;
+  SORT_REC *key;
+  char *data;
+  VPID vpid;
+  int peek, i;
+  QFILE_LIST_ID *list_idp;
+
+  QFILE_TUPLE_RECORD dummy;
+  int status;
+
+  analytic_state = (ANALYTIC_STATE *) arg;
+  list_idp = &(analytic_state->input_scan->list_id);
+
+  data = NULL;
+
+  /* Traverse next link */
+  for (key = (SORT_REC *) recdes->data; key; key = key->next)
     {
-      multi_range_opt->num_attrs = count;
-      multi_range_opt->is_desc_order = (bool *) db_private_alloc (thread_p, count * sizeof (bool));
-      if (multi_range_opt->is_desc_order == NULL)
+      if (analytic_state->state != NO_ERROR)
 	{
-	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, count * sizeof (bool));
 	  goto exit_on_error;
 	}
-      multi_range_opt->sort_att_idx = (int *) db_private_alloc (thread_p, count * sizeof (int));
-      if (multi_range_opt->sort_att_idx == NULL)
+
+      peek = COPY;		/* default */
+
+      /* evaluate inst_num() predicate */
+      if (qexec_analytic_eval_instnum_pred (thread_p, analytic_state, ANALYTIC_INTERM_PROC) != NO_ERROR)
 	{
-	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, count * sizeof (int));
 	  goto exit_on_error;
 	}
-    }
-  else
-    {
-      /* is multi_range_opt already initialized? */
-      assert (0);
-    }
 
-  for (index = 0, orderby_list = xasl->orderby_list; index < count; index++, orderby_list = orderby_list->next)
-    {
-      const DB_VALUE *valp = sort_col_out_val_ref[index];
+      /*
+       * Retrieve the original tuple.  This will be the case if the
+       * original tuple had more fields than we were sorting on.
+       */
+      vpid.pageid = key->s.original.pageid;
+      vpid.volid = key->s.original.volid;
 
-      att_id = -1;
-      sort_index_pos = -1;
-      /* search the ATTR_ID regu 'fetching to' the output list regu used for sorting */
-      for (regu_list = spec->s_id.s.isid.rest_regu_list; regu_list != NULL; regu_list = regu_list->next)
+      if (analytic_state->curr_sort_page.vpid.pageid != vpid.pageid
+	  || analytic_state->curr_sort_page.vpid.volid != vpid.volid)
 	{
-	  if (regu_list->value.type == TYPE_ATTR_ID && regu_list->value.vfetch_to == valp)
+	  if (analytic_state->curr_sort_page.page_p != NULL)
 	    {
-	      att_id = regu_list->value.value.attr_descr.id;
-	      break;
+	      qmgr_free_old_page_and_init (thread_p, analytic_state->curr_sort_page.page_p, list_idp->tfile_vfid);
+	    }
+
+	  analytic_state->curr_sort_page.page_p = qmgr_get_old_page (thread_p, &vpid, list_idp->tfile_vfid);
+	  if (analytic_state->curr_sort_page.page_p == NULL)
+	    {
+	      goto exit_on_error;
+	    }
+	  else
+	    {
+	      analytic_state->curr_sort_page.vpid = vpid;
 	    }
 	}
-      /* search the attribute in the index attributes */
-      if (att_id != -1)
+
+      QFILE_GET_OVERFLOW_VPID (&vpid, analytic_state->curr_sort_page.page_p);
+      data = analytic_state->curr_sort_page.page_p + key->s.original.offset;
+      if (vpid.pageid != NULL_PAGEID)
 	{
-	  for (i = 0; i < spec->s_id.s.isid.bt_num_attrs; i++)
+	  /*
+	   * This sucks; why do we need two different structures to
+	   * accomplish exactly the same goal?
+	   */
+	  dummy.size = analytic_state->analytic_rec.area_size;
+	  dummy.tpl = analytic_state->analytic_rec.data;
+	  status = qfile_get_tuple (thread_p, analytic_state->curr_sort_page.page_p, data, &dummy, list_idp);
+
+	  if (dummy.tpl != analytic_state->analytic_rec.data)
 	    {
-	      if (att_id == spec->s_id.s.isid.bt_attr_ids[i])
-		{
-		  sort_index_pos = i;
-		  break;
-		}
+	      /*
+	       * DON'T FREE THE BUFFER!  qfile_get_tuple() already did
+	       * that, and what you have here in gby_rec is a dangling
+	       * pointer.
+	       */
+	      analytic_state->analytic_rec.area_size = dummy.size;
+	      analytic_state->analytic_rec.data = dummy.tpl;
+	    }
+	  if (status != NO_ERROR)
+	    {
+	      goto exit_on_error;
 	    }
+
+	  data = analytic_state->analytic_rec.data;
 	}
-      if (sort_index_pos == -1)
+      else
 	{
-	  /* REGUs didn't match, at least disable the optimization */
-	  multi_range_opt->use = false;
-	  goto exit;
+	  peek = PEEK;		/* avoid unnecessary COPY */
 	}
-      multi_range_opt->is_desc_order[index] = (orderby_list->s_order == S_DESC) ? true : false;
-      multi_range_opt->sort_att_idx[index] = sort_index_pos;
-    }
-
-  /* disable order by in XASL for this execution */
-  if (xasl->option != Q_DISTINCT && xasl->scan_ptr == NULL)
-    {
-      XASL_SET_FLAG (xasl, XASL_SKIP_ORDERBY_LIST);
-      XASL_SET_FLAG (xasl, XASL_USES_MRO);
-    }
-
-exit:
-  if (sort_col_out_val_ref)
-    {
-      db_private_free_and_init (thread_p, sort_col_out_val_ref);
-    }
-  return error;
-
-exit_on_error:
-  error = ER_FAILED;
-  goto exit;
-}
 
-/*
- * query_multi_range_opt_check_specs () - searches the XASL tree for the
- *					  enabled multiple range search
- *					  optimized index scan
- *
- * return		     : ACCESS_SPEC_TYPE if an index scan with multiple
- *			       range search enabled is found, NULL otherwise
- * thread_p (in)	     : thread entry
- * spec_list (in/out)	     : access spec list
- */
-static ACCESS_SPEC_TYPE *
-query_multi_range_opt_check_specs (THREAD_ENTRY * thread_p, XASL_NODE * xasl)
-{
-  ACCESS_SPEC_TYPE *spec_list;
-  for (; xasl != NULL; xasl = xasl->scan_ptr)
-    {
-      for (spec_list = xasl->spec_list; spec_list != NULL; spec_list = spec_list->next)
+      /*
+       * process current sorted tuple
+       */
+      if (analytic_state->input_recs == 0)
 	{
-	  if (spec_list->access != ACCESS_METHOD_INDEX || spec_list->type != TARGET_CLASS
-	      || spec_list->s_id.type != S_INDX_SCAN)
+	  /* first input record, initialize everything */
+	  for (i = 0; i < analytic_state->func_count; i++)
 	    {
-	      continue;
+	      qexec_analytic_start_group (thread_p, analytic_state->xasl_state, &analytic_state->func_state_list[i],
+					  recdes, true);
 	    }
-	  if (spec_list->s_id.s.isid.multi_range_opt.use)
+	}
+      else
+	{
+	  for (i = 0; i < analytic_state->func_count; i++)
 	    {
-	      return spec_list;
+	      ANALYTIC_FUNCTION_STATE *func_state = &analytic_state->func_state_list[i];
+	      bool is_same_group = false;
+	      int nkeys;
+
+	      /* check group finish */
+	      nkeys = analytic_state->key_info.nkeys;
+	      analytic_state->key_info.nkeys = func_state->func_p->sort_list_size;
+	      if (((*analytic_state->cmp_fn) (&func_state->current_key.data, &key, &analytic_state->key_info) == 0)
+		  || analytic_state->key_info.nkeys == 0)
+		{
+		  /* keep rank within same sort key */
+		  analytic_state->key_info.nkeys = nkeys;
+		  ANALYTIC_FUNC_SET_FLAG (func_state->func_p, ANALYTIC_KEEP_RANK);
+
+		  if (QPROC_ANALYTIC_IS_OFFSET_FUNCTION (func_state->func_p))
+		    {
+		      /* offset functions will treat all tuples in a group as having a different sort key regardless if
+		       * this is true or not; this is done in order to have a distinct value for each tuple in the
+		       * group (whereas normally tuples sharing a sort key will also share a value) */
+		      is_same_group = true;
+		    }
+		  else
+		    {
+		      /* same sort key, move on */
+		      continue;
+		    }
+		}
+	      analytic_state->key_info.nkeys = nkeys;
+
+	      /* find out if it's the same group */
+	      if (!is_same_group)
+		{
+		  if (func_state->func_p->sort_prefix_size == 0)
+		    {
+		      /* no groups, only ordering */
+		      is_same_group = true;
+		    }
+		  else
+		    {
+		      nkeys = analytic_state->key_info.nkeys;
+		      analytic_state->key_info.nkeys = func_state->func_p->sort_prefix_size;
+		      if ((*analytic_state->cmp_fn) (&func_state->current_key.data, &key,
+						     &analytic_state->key_info) == 0)
+			{
+			  is_same_group = true;
+			}
+		      analytic_state->key_info.nkeys = nkeys;
+		    }
+		}
+
+	      if (!is_same_group)
+		{
+		  if (qexec_analytic_finalize_group (thread_p, analytic_state->xasl_state, func_state, false) !=
+		      NO_ERROR)
+		    {
+		      goto exit_on_error;
+		    }
+		  pr_clear_value (func_state->func_p->value);
+		  qexec_analytic_start_group (thread_p, analytic_state->xasl_state, func_state, recdes, true);
+		}
+	      else if (func_state->func_p->function != PT_NTILE
+		       && (!QPROC_IS_INTERPOLATION_FUNC (func_state->func_p) || func_state->func_p->option == Q_ALL))
+		{
+		  if (qexec_analytic_finalize_group (thread_p, analytic_state->xasl_state, func_state, true) !=
+		      NO_ERROR)
+		    {
+		      goto exit_on_error;
+		    }
+		  qexec_analytic_start_group (thread_p, analytic_state->xasl_state, func_state, recdes, false);
+		}
 	    }
 	}
-    }
-  return NULL;
+
+      /* aggregate tuple across all functions */
+      qexec_analytic_add_tuple (thread_p, analytic_state, data, peek);
+
+      /* one more input record of beer on the wall */
+      analytic_state->input_recs++;
+    }				/* for (key = (SORT_REC *) recdes->data; ...) */
+
+wrapup:
+  return analytic_state->state;
+
+exit_on_error:
+  assert (er_errid () != NO_ERROR);
+  analytic_state->state = er_errid ();
+  goto wrapup;
 }
 
 /*
- * qexec_execute_analytic () -
- *   return: NO_ERROR, or ER_code
- *   xasl(in)   :
- *   xasl_state(in) : XASL tree state information
- *   analytic_func_p(in): Analytic function pointer
- *   tplrec(out) : Tuple record descriptor to store result tuples
- *   next_func(out) : next unprocessed function
+ * qexec_analytic_eval_instnum_pred () - evaluate inst_num() predicate
+ *   returns: error code or NO_ERROR
+ *   thread_p(in): current thread
+ *   analytic_state(in): analytic state
+ *   func_p(in): analytic function chain
+ *   stage(in): stage from within function is called
+ *
+ * NOTE: this function sets the analytic state's "is_output_rec" flag
  */
 static int
-qexec_execute_analytic (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state,
-			ANALYTIC_EVAL_TYPE * analytic_eval, QFILE_TUPLE_RECORD * tplrec, bool is_last)
+qexec_analytic_eval_instnum_pred (THREAD_ENTRY * thread_p, ANALYTIC_STATE * analytic_state, ANALYTIC_STAGE stage)
 {
-  QFILE_LIST_ID *list_id = xasl->list_id;
-  BUILDLIST_PROC_NODE *buildlist = &xasl->proc.buildlist;
-  ANALYTIC_STATE analytic_state;
-  QFILE_LIST_SCAN_ID input_scan_id, interm_scan_id;
-  OUTPTR_LIST *a_outptr_list;
-  int ls_flag = 0;
-  int estimated_pages;
-  bool finalized = false;
-  int i = 0;
-  ANALYTIC_TYPE *func_p = NULL;
+  ANALYTIC_STAGE instnum_stage = ANALYTIC_INTERM_PROC;
+  DB_LOGICAL is_output_rec;
+  int instnum_flag, i;
 
-  /* fetch regulist and outlist */
-  a_outptr_list = (is_last ? buildlist->a_outptr_list : buildlist->a_outptr_list_interm);
+  /* get flag from buildlist */
+  instnum_flag = analytic_state->xasl->proc.buildlist.a_instnum_flag;
 
-  /* resolve late bindings in analytic sort list */
-  qexec_resolve_domains_on_sort_list (analytic_eval->sort_list, buildlist->a_outptr_list_ex->valptrp);
+  /* by default, it's an output record */
+  analytic_state->is_output_rec = true;
 
-  /* initialized analytic functions state structure */
-  if (qexec_initialize_analytic_state (thread_p, &analytic_state, analytic_eval->head, analytic_eval->sort_list,
-				       buildlist->a_regu_list, buildlist->a_val_list, a_outptr_list,
-				       buildlist->a_outptr_list_interm, is_last, xasl, xasl_state, &list_id->type_list,
-				       tplrec) == NULL)
+  if (!analytic_state->is_last_run
+      || (analytic_state->xasl->instnum_pred == NULL && !(instnum_flag & XASL_INSTNUM_FLAG_EVAL_DEFER)))
     {
-      GOTO_EXIT_ON_ERROR;
+      /* inst_num() is evaluated only for last function, when an INST_NUM() predicate is present or when INST_NUM() is
+       * selected */
+      return NO_ERROR;
     }
 
-  if (analytic_state.is_last_run)
+  for (i = 0; i < analytic_state->func_count; i++)
     {
-      /* for last function, evaluate instnum() predicate while sorting */
-      xasl->instnum_pred = buildlist->a_instnum_pred;
-      xasl->instnum_val = buildlist->a_instnum_val;
-      xasl->instnum_flag = buildlist->a_instnum_flag;
+      ANALYTIC_TYPE *func_p = analytic_state->func_state_list[i].func_p;
 
-      if (xasl->instnum_val != NULL)
+      if (QPROC_ANALYTIC_IS_OFFSET_FUNCTION (func_p) || func_p->function == PT_NTILE
+	  || func_p->function == PT_FIRST_VALUE || func_p->function == PT_LAST_VALUE)
 	{
-	  /* initialize counter to zero */
-	  (void) db_make_bigint (xasl->instnum_val, 0);
+	  /* inst_num() predicate is evaluated at group processing for these functions, as the result is computed at
+	   * this stage using all group values */
+	  instnum_stage = ANALYTIC_GROUP_PROC;
 	}
-    }
-
-  /* create intermediary and output list files */
-  {
-    QFILE_TUPLE_VALUE_TYPE_LIST interm_type_list, output_type_list;
-    QFILE_LIST_ID *interm_list_id;
-    QFILE_LIST_ID *output_list_id;
-
-    /* open intermediate file */
-    if (qdata_get_valptr_type_list (thread_p, buildlist->a_outptr_list_interm, &interm_type_list) != NO_ERROR)
-      {
-	GOTO_EXIT_ON_ERROR;
-      }
-
-    interm_list_id = qfile_open_list (thread_p, &interm_type_list, NULL, xasl_state->query_id, ls_flag);
-
-    if (interm_type_list.domp)
-      {
-	db_private_free_and_init (thread_p, interm_type_list.domp);
-      }
-
-    if (interm_list_id == NULL)
-      {
-	GOTO_EXIT_ON_ERROR;
-      }
-
-    analytic_state.interm_file = interm_list_id;
 
-    /* last iteration results in xasl result file */
-    if (is_last)
-      {
-	QFILE_SET_FLAG (ls_flag, QFILE_FLAG_ALL);
-	if (XASL_IS_FLAGED (xasl, XASL_TOP_MOST_XASL) && XASL_IS_FLAGED (xasl, XASL_TO_BE_CACHED)
-	    && (xasl->orderby_list == NULL || XASL_IS_FLAGED (xasl, XASL_SKIP_ORDERBY_LIST))
-	    && xasl->option != Q_DISTINCT)
-	  {
-	    QFILE_SET_FLAG (ls_flag, QFILE_FLAG_RESULT_FILE);
-	  }
-      }
+      if (instnum_flag & XASL_INSTNUM_FLAG_EVAL_DEFER)
+	{
+	  /* we're selecting INST_NUM() so we must evaluate it when writing the output file */
+	  instnum_stage = ANALYTIC_GROUP_PROC;
+	}
+    }
 
-    /* open output file */
-    if (qdata_get_valptr_type_list (thread_p, a_outptr_list, &output_type_list) != NO_ERROR)
-      {
-	GOTO_EXIT_ON_ERROR;
-      }
+  if (stage != instnum_stage)
+    {
+      /* we're not at the required stage */
+      return NO_ERROR;
+    }
 
-    output_list_id = qfile_open_list (thread_p, &output_type_list, NULL, xasl_state->query_id, ls_flag);
+  /* evaluate inst_num() */
+  is_output_rec = qexec_eval_instnum_pred (thread_p, analytic_state->xasl, analytic_state->xasl_state);
+  if (is_output_rec == V_ERROR)
+    {
+      return ER_FAILED;
+    }
+  else
+    {
+      analytic_state->is_output_rec = (is_output_rec == V_TRUE);
+    }
 
-    if (output_type_list.domp)
-      {
-	db_private_free_and_init (thread_p, output_type_list.domp);
-      }
+  /* all ok */
+  return NO_ERROR;
+}
 
-    if (output_list_id == NULL)
-      {
-	GOTO_EXIT_ON_ERROR;
-      }
+/*
+ * qexec_analytic_start_group () -
+ *   return:
+ *   analytic_state(in):
+ *   key(in):
+ *   reinit(in):
+ */
+static int
+qexec_analytic_start_group (THREAD_ENTRY * thread_p, XASL_STATE * xasl_state, ANALYTIC_FUNCTION_STATE * func_state,
+			    const RECDES * key, bool reinit)
+{
+  int error;
 
-    analytic_state.output_file = output_list_id;
-  }
+  /*
+   * Record the new key; keep it in SORT_KEY format so we can continue
+   * to use the SORTKEY_INFO version of the comparison functions.
+   *
+   * WARNING: the sort module doesn't seem to set key->area_size
+   * reliably, so the only thing we can rely on is key->length.
+   */
 
-  if (list_id->tuple_cnt == 0)
+  if (key)
     {
-      /* empty list files, no need to proceed */
-      analytic_state.state = NO_ERROR;
-      goto wrapup;
+      if (func_state->current_key.area_size < key->length)
+	{
+	  void *tmp;
+
+	  tmp = db_private_realloc (thread_p, func_state->current_key.data, key->area_size);
+	  if (tmp == NULL)
+	    {
+	      GOTO_EXIT_ON_ERROR;
+	    }
+	  func_state->current_key.data = (char *) tmp;
+	  func_state->current_key.area_size = key->area_size;
+	}
+      memcpy (func_state->current_key.data, key->data, key->length);
+      func_state->current_key.length = key->length;
     }
 
   /*
-   * Open a scan on the unsorted input file
+   * (Re)initialize the various accumulator variables...
    */
-  if (qfile_open_list_scan (list_id, &input_scan_id) != NO_ERROR)
+  if (reinit)
     {
-      GOTO_EXIT_ON_ERROR;
-    }
-  analytic_state.input_scan = &input_scan_id;
+      /* starting a new group */
+      error = qdata_initialize_analytic_func (thread_p, func_state->func_p, xasl_state->query_id);
+      if (error != NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
 
-  /*
-   * open a scan on the intermediate file
-   */
-  if (qfile_open_list_scan (analytic_state.interm_file, &interm_scan_id) != NO_ERROR)
+      /* reinitialize counters */
+      func_state->curr_group_tuple_count = 0;
+      func_state->curr_group_tuple_count_nn = 0;
+      func_state->curr_sort_key_tuple_count = 0;
+    }
+  else
     {
-      GOTO_EXIT_ON_ERROR;
+      /* starting a new partition; reinstate acumulator */
+      qdata_copy_db_value (func_state->func_p->value, &func_state->func_p->part_value);
+      pr_clear_value (&func_state->func_p->part_value);
+
+      /* reinitialize counters */
+      func_state->curr_sort_key_tuple_count = 0;
     }
-  interm_scan_id.keep_page_on_finish = 1;
-  analytic_state.interm_scan = &interm_scan_id;
 
-  /*
-   * Now load up the sort module and set it off...
-   */
+  return NO_ERROR;
 
-  estimated_pages = qfile_get_estimated_pages_for_sorting (list_id, &analytic_state.key_info);
+exit_on_error:
+  assert (er_errid () != NO_ERROR);
+  return er_errid ();
+}
 
-  /* number of sort keys is always less than list file column count, as sort columns are included */
-  analytic_state.key_info.use_original = 1;
-  analytic_state.cmp_fn = &qfile_compare_partial_sort_record;
+/*
+ * qexec_analytic_finalize_group () - finish analytic function and dump result to file
+ *   return: error code or NO_ERROR
+ *   xasl_state(in): XASL state
+ *   func_state(in): function state
+ *   is_same_group(in): true if we're finalizing a sort key, false if a group
+ */
+static int
+qexec_analytic_finalize_group (THREAD_ENTRY * thread_p, XASL_STATE * xasl_state, ANALYTIC_FUNCTION_STATE * func_state,
+			       bool is_same_group)
+{
+  QFILE_TUPLE_RECORD tplrec;
+  int rc = NO_ERROR;
 
-  if (sort_listfile (thread_p, NULL_VOLID, estimated_pages, &qexec_analytic_get_next, &analytic_state,
-		     &qexec_analytic_put_next, &analytic_state, analytic_state.cmp_fn, &analytic_state.key_info,
-		     SORT_DUP, NO_SORT_LIMIT) != NO_ERROR)
-    {
-      GOTO_EXIT_ON_ERROR;
-    }
+  /* initialize tuple record */
+  tplrec.tpl = NULL;
+  tplrec.size = 0;
 
-  /* check sort error */
-  if (analytic_state.key_info.error != NO_ERROR)
+  /* finalize function */
+  if (qdata_finalize_analytic_func (thread_p, func_state->func_p, is_same_group) != NO_ERROR)
     {
-      if (analytic_state.key_info.error == ER_ARG_CAN_NOT_BE_CASTED_TO_DESIRED_DOMAIN)
-	{
-	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_ARG_CAN_NOT_BE_CASTED_TO_DESIRED_DOMAIN, 2,
-		  fcode_get_uppercase_name (analytic_eval->head->function), "DOUBLE, DATETIME or TIME");
-	}
-
-      GOTO_EXIT_ON_ERROR;
+      rc = ER_FAILED;
+      goto cleanup;
     }
 
-  /*
-   * There may be one unfinished group in the output, since the sort_listfile
-   * interface doesn't include a finalization function.  If so, finish
-   * off that group.
-   */
-  if (analytic_state.input_recs != 0)
+  if (!DB_IS_NULL (func_state->func_p->value))
     {
-      for (i = 0; i < analytic_state.func_count; i++)
-	{
-	  if (qexec_analytic_finalize_group (thread_p, analytic_state.xasl_state, &analytic_state.func_state_list[i],
-					     false) != NO_ERROR)
-	    {
-	      GOTO_EXIT_ON_ERROR;
-	    }
-	}
+      /* keep track of non-NULL values */
+      func_state->curr_group_tuple_count_nn += func_state->curr_sort_key_tuple_count;
+    }
 
-      finalized = true;
+  /* write current counts to dbvalues */
+  db_make_int (&func_state->cgtc_dbval, func_state->curr_group_tuple_count);
+  db_make_int (&func_state->cgtc_nn_dbval, func_state->curr_group_tuple_count_nn);
+  db_make_int (&func_state->csktc_dbval, func_state->curr_sort_key_tuple_count);
 
-      /* reiterate intermediate file and write output using function result files */
-      if (qexec_analytic_update_group_result (thread_p, &analytic_state) != NO_ERROR)
+  /* dump group */
+  if (!is_same_group)
+    {
+      if (qfile_fast_intint_tuple_to_list (thread_p, func_state->group_list_id, func_state->curr_group_tuple_count,
+					   func_state->curr_group_tuple_count_nn) != NO_ERROR)
 	{
-	  GOTO_EXIT_ON_ERROR;
+	  rc = ER_FAILED;
+	  goto cleanup;
 	}
     }
 
-wrapup:
-  if (analytic_state.state == NO_ERROR)
+  /* dump sort key header */
+  rc =
+    qfile_fast_intval_tuple_to_list (thread_p, func_state->value_list_id, func_state->curr_sort_key_tuple_count,
+				     func_state->func_p->value);
+  if (rc > 0)
     {
-      /* clear current input: sort items and input scan */
-      if (analytic_state.curr_sort_page.page_p != NULL)
+      rc = NO_ERROR;
+      /* big tuple */
+      if (qfile_copy_tuple_descr_to_tuple (thread_p, &func_state->value_list_id->tpl_descr, &tplrec) != NO_ERROR)
 	{
-	  qmgr_free_old_page_and_init (thread_p, analytic_state.curr_sort_page.page_p,
-				       analytic_state.input_scan->list_id.tfile_vfid);
-	  analytic_state.curr_sort_page.vpid.pageid = NULL_PAGEID;
-	  analytic_state.curr_sort_page.vpid.volid = NULL_VOLID;
+	  rc = ER_FAILED;
+	  goto cleanup;
 	}
-      if (analytic_state.input_scan)
+      if (qfile_add_tuple_to_list (thread_p, func_state->value_list_id, tplrec.tpl) != NO_ERROR)
 	{
-	  qfile_close_scan (thread_p, analytic_state.input_scan);
-	  analytic_state.input_scan = NULL;
+	  rc = ER_FAILED;
+	  goto cleanup;
 	}
-
-      /* replace current input with output */
-      qfile_close_list (thread_p, analytic_state.output_file);
-      qfile_destroy_list (thread_p, list_id);
-      qfile_copy_list_id (list_id, analytic_state.output_file, true);
-
-      qfile_free_list_id (analytic_state.output_file);
-      analytic_state.output_file = NULL;
     }
 
-  /* clear internal processing items */
-  qexec_clear_analytic_state (thread_p, &analytic_state);
-
-  return (analytic_state.state == NO_ERROR) ? NO_ERROR : ER_FAILED;
-
-exit_on_error:
-  ASSERT_ERROR_AND_SET (analytic_state.state);
+cleanup:
 
-  if (!finalized)
+  if (tplrec.tpl != NULL)
     {
-      /* make sure all the list_files are destroyed correctly */
-      for (i = 0; i < analytic_state.func_count; i++)
-	{
-	  func_p = analytic_state.func_state_list[i].func_p;
-	  if (func_p != NULL && func_p->option == Q_DISTINCT && func_p->list_id != NULL)
-	    {
-	      qfile_close_list (thread_p, func_p->list_id);
-	      qfile_destroy_list (thread_p, func_p->list_id);
-	    }
-	}
+      db_private_free (thread_p, tplrec.tpl);
     }
 
-  goto wrapup;
+  return rc;
 }
 
 /*
- * qexec_initialize_analytic_function_state () - initialize a function state
- *   returns: error code or NO_ERROR
- *   thread_p(in): thread entry
- *   func_state(in/out): function state
- *   func_p(in): function to initialize state for
+ * qexec_analytic_add_tuple () -
+ *   return:
+ *   analytic_state(in):
+ *   tpl(in):
+ *   peek(in):
  */
-static int
-qexec_initialize_analytic_function_state (THREAD_ENTRY * thread_p, ANALYTIC_FUNCTION_STATE * func_state,
-					  ANALYTIC_TYPE * func_p, XASL_STATE * xasl_state)
+static void
+qexec_analytic_add_tuple (THREAD_ENTRY * thread_p, ANALYTIC_STATE * analytic_state, QFILE_TUPLE tpl, int peek)
 {
-  QFILE_TUPLE_VALUE_TYPE_LIST group_type_list, value_type_list;
-
-  assert (func_state != NULL);
-
-  /* register function */
-  func_state->func_p = func_p;
+  XASL_STATE *xasl_state = analytic_state->xasl_state;
+  QFILE_LIST_ID *list_id = analytic_state->interm_file;
+  int i;
 
-  /* initialize function state */
-  func_state->current_key.data = (char *) db_private_alloc (thread_p, DB_PAGESIZE);
-  if (func_state->current_key.data == NULL)
+  if (analytic_state->state != NO_ERROR)
     {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) DB_PAGESIZE);
-      return ER_FAILED;
+      return;
     }
-  func_state->current_key.area_size = DB_PAGESIZE;
-  func_state->current_key.length = 0;
-  func_state->current_key.type = 0;
-
-  /* zero input recs */
-  func_state->curr_group_tuple_count = 0;
-  func_state->curr_group_tuple_count_nn = 0;
-  func_state->curr_sort_key_tuple_count = 0;
-
-  /* initialize tuple record */
-  func_state->group_tplrec.size = 0;
-  func_state->group_tplrec.tpl = NULL;
-  func_state->value_tplrec.size = 0;
-  func_state->value_tplrec.tpl = NULL;
-
-  /* initialize dbvals */
-  db_make_null (&func_state->csktc_dbval);
-  db_make_null (&func_state->cgtc_dbval);
-  db_make_null (&func_state->cgtc_nn_dbval);
 
-  /* initialize group header listfile */
-  group_type_list.type_cnt = 2;
-  group_type_list.domp = (TP_DOMAIN **) db_private_alloc (thread_p, sizeof (TP_DOMAIN *) * 2);
-  if (group_type_list.domp == NULL)
+  if (fetch_val_list (thread_p, analytic_state->a_regu_list, &xasl_state->vd, NULL, NULL, tpl, peek) != NO_ERROR)
     {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) DB_PAGESIZE);
-      return ER_FAILED;
+      GOTO_EXIT_ON_ERROR;
     }
-  group_type_list.domp[0] = &tp_Integer_domain;
-  group_type_list.domp[1] = &tp_Integer_domain;
-
-  func_state->group_list_id = qfile_open_list (thread_p, &group_type_list, NULL, xasl_state->query_id, 0);
-
-  db_private_free_and_init (thread_p, group_type_list.domp);
 
-  func_state->group_list_id->tpl_descr.f_cnt = 2;
-  func_state->group_list_id->tpl_descr.f_valp = (DB_VALUE **) malloc (sizeof (DB_VALUE *) * 2);
-  if (func_state->group_list_id->tpl_descr.f_valp == NULL)
+  for (i = 0; i < analytic_state->func_count; i++)
     {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) DB_PAGESIZE);
-      return ER_FAILED;
-    }
-  func_state->group_list_id->tpl_descr.f_valp[0] = &func_state->cgtc_dbval;
-  func_state->group_list_id->tpl_descr.f_valp[1] = &func_state->cgtc_nn_dbval;
+      if (qdata_evaluate_analytic_func (thread_p, analytic_state->func_state_list[i].func_p, &xasl_state->vd) !=
+	  NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
 
-  func_state->group_list_id->tpl_descr.clear_f_val_at_clone_decache = (bool *) malloc (sizeof (bool) * 2);
-  if (func_state->group_list_id->tpl_descr.clear_f_val_at_clone_decache == NULL)
-    {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, sizeof (bool) * 2);
-      return ER_FAILED;
+      /* account for tuple */
+      analytic_state->func_state_list[i].curr_group_tuple_count++;
+      analytic_state->func_state_list[i].curr_sort_key_tuple_count++;
     }
-  func_state->group_list_id->tpl_descr.clear_f_val_at_clone_decache[0] =
-    func_state->group_list_id->tpl_descr.clear_f_val_at_clone_decache[1] = false;
 
-  /* initialize group value listfile */
-  value_type_list.type_cnt = 2;
-  value_type_list.domp = (TP_DOMAIN **) db_private_alloc (thread_p, sizeof (TP_DOMAIN *) * 2);
-  if (value_type_list.domp == NULL)
+  /* check if output */
+  if (analytic_state->is_output_rec)
     {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) DB_PAGESIZE);
-      return ER_FAILED;
+      /* records that did not pass the instnum() predicate evaluation are used for computing the function value, but
+       * are not included in the intermediate file */
+      if (qexec_insert_tuple_into_list (thread_p, list_id, analytic_state->a_outptr_list_interm, &xasl_state->vd,
+					analytic_state->output_tplrec) != NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
     }
-  value_type_list.domp[0] = &tp_Integer_domain;
-  value_type_list.domp[1] = func_state->func_p->domain;
 
-  func_state->value_list_id = qfile_open_list (thread_p, &value_type_list, NULL, xasl_state->query_id, 0);
+wrapup:
+  return;
 
-  db_private_free_and_init (thread_p, value_type_list.domp);
+exit_on_error:
+  assert (er_errid () != NO_ERROR);
+  analytic_state->state = er_errid ();
+  goto wrapup;
+}
 
-  func_state->value_list_id->tpl_descr.f_cnt = 2;
-  func_state->value_list_id->tpl_descr.f_valp = (DB_VALUE **) malloc (sizeof (DB_VALUE *) * 2);
-  if (func_state->value_list_id->tpl_descr.f_valp == NULL)
-    {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) DB_PAGESIZE);
-      return ER_FAILED;
-    }
-  func_state->value_list_id->tpl_descr.f_valp[0] = &func_state->csktc_dbval;
-  func_state->value_list_id->tpl_descr.f_valp[1] = func_p->value;
+/*
+ * qexec_clear_analytic_function_state () - clear function state
+ *   thread_p(in): thread entry
+ *   func_state(in): function state to free
+ */
+static void
+qexec_clear_analytic_function_state (THREAD_ENTRY * thread_p, ANALYTIC_FUNCTION_STATE * func_state)
+{
+  assert (func_state != NULL);
 
-  func_state->value_list_id->tpl_descr.clear_f_val_at_clone_decache = (bool *) malloc (sizeof (bool) * 2);
-  if (func_state->value_list_id->tpl_descr.clear_f_val_at_clone_decache == NULL)
+  /* clear db_values */
+  pr_clear_value (func_state->func_p->value);
+  pr_clear_value (&func_state->cgtc_dbval);
+  pr_clear_value (&func_state->cgtc_nn_dbval);
+  pr_clear_value (&func_state->csktc_dbval);
+
+  /* free buffers */
+  if (func_state->current_key.data)
     {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, sizeof (bool) * 2);
-      return ER_FAILED;
+      db_private_free_and_init (thread_p, func_state->current_key.data);
+      func_state->current_key.area_size = 0;
     }
-  func_state->value_list_id->tpl_descr.clear_f_val_at_clone_decache[0] =
-    func_state->value_list_id->tpl_descr.clear_f_val_at_clone_decache[1] = false;
 
-  return NO_ERROR;
+  /* dealloc files */
+  qfile_close_list (thread_p, func_state->group_list_id);
+  qfile_close_list (thread_p, func_state->value_list_id);
+  qfile_destroy_list (thread_p, func_state->group_list_id);
+  qfile_destroy_list (thread_p, func_state->value_list_id);
+  qfile_free_list_id (func_state->group_list_id);
+  qfile_free_list_id (func_state->value_list_id);
 }
 
 /*
- * qexec_initialize_analytic_state () -
+ * qexec_clear_analytic_state () -
  *   return:
- *   analytic_state(in) :
- *   a_func_list(in)    : Analytic functions list
- *   a_regu_list(in)    : Regulator variable list
- *   a_regu_list_ex(in)	: Extended regulator variable list
- *   a_val_list(in)     : Value list
- *   a_outptr_list(in)  : Output pointer list
- *   xasl_state(in)     : XASL tree state information
- *   type_list(in)      :
- *   tplrec(out) 	: Tuple record descriptor to store result tuples
+ *   analytic_state(in):
  */
-static ANALYTIC_STATE *
-qexec_initialize_analytic_state (THREAD_ENTRY * thread_p, ANALYTIC_STATE * analytic_state, ANALYTIC_TYPE * a_func_list,
-				 SORT_LIST * sort_list, REGU_VARIABLE_LIST a_regu_list, VAL_LIST * a_val_list,
-				 OUTPTR_LIST * a_outptr_list, OUTPTR_LIST * a_outptr_list_interm, bool is_last_run,
-				 XASL_NODE * xasl, XASL_STATE * xasl_state, QFILE_TUPLE_VALUE_TYPE_LIST * type_list,
-				 QFILE_TUPLE_RECORD * tplrec)
+static void
+qexec_clear_analytic_state (THREAD_ENTRY * thread_p, ANALYTIC_STATE * analytic_state)
 {
-  REGU_VARIABLE_LIST regu_list = NULL;
-  ANALYTIC_TYPE *func_p;
-  bool has_interpolation_func = false;
-  SUBKEY_INFO *subkey = NULL;
   int i;
-  int interpolation_func_sort_prefix_len = 0;
-
-  analytic_state->state = NO_ERROR;
-
-  analytic_state->input_scan = NULL;
-  analytic_state->interm_scan = NULL;
-  analytic_state->interm_file = NULL;
-  analytic_state->output_file = NULL;
-
-  analytic_state->a_regu_list = a_regu_list;
-  analytic_state->a_outptr_list = a_outptr_list;
-  analytic_state->a_outptr_list_interm = a_outptr_list_interm;
-
-  analytic_state->xasl = xasl;
-  analytic_state->xasl_state = xasl_state;
 
-  analytic_state->is_last_run = is_last_run;
+  for (i = 0; i < analytic_state->func_count; i++)
+    {
+      qexec_clear_analytic_function_state (thread_p, &analytic_state->func_state_list[i]);
+    }
+  if (analytic_state->func_state_list != NULL)
+    {
+      db_private_free_and_init (thread_p, analytic_state->func_state_list);
+    }
 
-  analytic_state->analytic_rec.area_size = 0;
-  analytic_state->analytic_rec.length = 0;
-  analytic_state->analytic_rec.type = 0;	/* Unused */
-  analytic_state->analytic_rec.data = NULL;
+  if (analytic_state->analytic_rec.data)
+    {
+      db_private_free_and_init (thread_p, analytic_state->analytic_rec.data);
+      analytic_state->analytic_rec.area_size = 0;
+    }
   analytic_state->output_tplrec = NULL;
-  analytic_state->input_tplrec.size = 0;
-  analytic_state->input_tplrec.tpl = 0;
-  analytic_state->input_recs = 0;
 
-  analytic_state->curr_sort_page.vpid.pageid = NULL_PAGEID;
-  analytic_state->curr_sort_page.vpid.volid = NULL_VOLID;
-  analytic_state->curr_sort_page.page_p = NULL;
-  analytic_state->output_tplrec = tplrec;
+  qfile_clear_sort_key_info (&analytic_state->key_info);
 
-  if (sort_list)
+  if (analytic_state->curr_sort_page.page_p != NULL)
     {
-      if (qfile_initialize_sort_key_info (&analytic_state->key_info, sort_list, type_list) == NULL)
-	{
-	  return NULL;
-	}
+      qmgr_free_old_page_and_init (thread_p, analytic_state->curr_sort_page.page_p,
+				   analytic_state->input_scan->list_id.tfile_vfid);
+      analytic_state->curr_sort_page.vpid.pageid = NULL_PAGEID;
+      analytic_state->curr_sort_page.vpid.volid = NULL_VOLID;
     }
-  else
+
+  if (analytic_state->input_scan)
     {
-      analytic_state->key_info.nkeys = 0;
-      analytic_state->key_info.use_original = 1;
-      analytic_state->key_info.key = NULL;
-      analytic_state->key_info.error = NO_ERROR;
+      qfile_close_scan (thread_p, analytic_state->input_scan);
+      analytic_state->input_scan = NULL;
     }
 
-  /* build function states */
-  for (analytic_state->func_count = 0, func_p = a_func_list; func_p != NULL;
-       analytic_state->func_count++, func_p = func_p->next)
+  if (analytic_state->interm_scan)
     {
-      ;				/* count analytic functions */
+      qfile_close_scan (thread_p, analytic_state->interm_scan);
+      analytic_state->interm_scan = NULL;
     }
 
-  analytic_state->func_state_list =
-    (ANALYTIC_FUNCTION_STATE *) db_private_alloc (thread_p,
-						  sizeof (ANALYTIC_FUNCTION_STATE) * analytic_state->func_count);
-  if (analytic_state->func_state_list == NULL)
+  if (analytic_state->interm_file)
     {
-      return NULL;
+      qfile_close_list (thread_p, analytic_state->interm_file);
+      qfile_destroy_list (thread_p, analytic_state->interm_file);
+      qfile_free_list_id (analytic_state->interm_file);
+      analytic_state->interm_file = NULL;
+    }
+  if (analytic_state->output_file)
+    {
+      qfile_close_list (thread_p, analytic_state->output_file);
+      qfile_free_list_id (analytic_state->output_file);
+      analytic_state->output_file = NULL;
     }
+}
 
-  memset (analytic_state->func_state_list, 0, analytic_state->func_count * sizeof (ANALYTIC_FUNCTION_STATE));
-  for (i = 0, func_p = a_func_list; i < analytic_state->func_count; i++, func_p = func_p->next)
+/*
+ * qexec_analytic_evaluate_ntile_function () - evaluate NTILE function
+ *   returns: error code or NO_ERROR
+ *   thread_p(in): current thread
+ *   func_p(in): analytic function
+ *   analytic_state(in): analytic state
+ *   tuple_idx(in): current tuple index
+ */
+static int
+qexec_analytic_evaluate_ntile_function (THREAD_ENTRY * thread_p, ANALYTIC_FUNCTION_STATE * func_state)
+{
+  if (func_state == NULL || func_state->func_p == NULL || func_state->func_p->function != PT_NTILE)
     {
-      if (qexec_initialize_analytic_function_state (thread_p, &analytic_state->func_state_list[i], func_p, xasl_state)
-	  != NO_ERROR)
-	{
-	  return NULL;
-	}
+      /* nothing to do */
+      return NO_ERROR;
     }
 
-  /* initialize runtime structure */
-  for (func_p = a_func_list; func_p != NULL; func_p = func_p->next)
+  if (!func_state->func_p->info.ntile.is_null)
     {
-      if (QPROC_IS_INTERPOLATION_FUNC (func_p))
+      int recs_in_bucket = func_state->curr_group_tuple_count / func_state->func_p->info.ntile.bucket_count;
+      int compensate = func_state->curr_group_tuple_count % func_state->func_p->info.ntile.bucket_count;
+
+      /* get bucket of current tuple */
+      if (recs_in_bucket == 0)
 	{
-	  has_interpolation_func = true;
+	  /* more buckets than tuples, this is identity */
+	  db_make_int (func_state->func_p->value, func_state->group_tuple_position + 1);
+	}
+      else if (compensate == 0)
+	{
+	  /* perfect division, straightforward */
+	  db_make_int (func_state->func_p->value, func_state->group_tuple_position / recs_in_bucket + 1);
+	}
+      else
+	{
+	  int xcount = (recs_in_bucket + 1) * compensate;
 
-	  if (interpolation_func_sort_prefix_len == 0)
+	  /* account for remainder */
+	  if (func_state->group_tuple_position < xcount)
 	    {
-	      interpolation_func_sort_prefix_len = func_p->sort_prefix_size;
+	      db_make_int (func_state->func_p->value, func_state->group_tuple_position / (recs_in_bucket + 1) + 1);
 	    }
 	  else
 	    {
-	      assert (interpolation_func_sort_prefix_len == func_p->sort_prefix_size);
-	    }
-	}
-    }
-
-  /* set SUBKEY_INFO.cmp_dom */
-  if (has_interpolation_func)
-    {
-      for (i = 0, subkey = analytic_state->key_info.key; i < analytic_state->key_info.nkeys && subkey != NULL;
-	   ++i, ++subkey)
-	{
-	  if (i >= interpolation_func_sort_prefix_len && TP_IS_STRING_TYPE (TP_DOMAIN_TYPE (subkey->col_dom)))
-	    {
-	      subkey->use_cmp_dom = true;
+	      db_make_int (func_state->func_p->value,
+			   (func_state->group_tuple_position - compensate) / recs_in_bucket + 1);
 	    }
 	}
     }
-
-  /* resolve domains in regulist */
-  for (regu_list = a_regu_list; regu_list; regu_list = regu_list->next)
+  else
     {
-      /* if it's position, resolve domain */
-      if (regu_list->value.type == TYPE_POSITION
-	  && (TP_DOMAIN_TYPE (regu_list->value.value.pos_descr.dom) == DB_TYPE_VARIABLE
-	      || TP_DOMAIN_COLLATION_FLAG (regu_list->value.value.pos_descr.dom) != TP_DOMAIN_COLL_NORMAL))
-	{
-	  int pos = regu_list->value.value.pos_descr.pos_no;
-	  if (pos <= type_list->type_cnt)
-	    {
-	      regu_list->value.value.pos_descr.dom = type_list->domp[pos];
-	      regu_list->value.domain = type_list->domp[pos];
-	    }
-	}
+      /* null output */
+      db_make_null (func_state->func_p->value);
     }
 
-  return analytic_state;
-}
-
-/*
- * qexec_analytic_get_next () -
- *   return:
- *   recdes(in) :
- *   arg(in)    :
- */
-static SORT_STATUS
-qexec_analytic_get_next (THREAD_ENTRY * thread_p, RECDES * recdes, void *arg)
-{
-  ANALYTIC_STATE *analytic_state;
-
-  analytic_state = (ANALYTIC_STATE *) arg;
-
-  return qfile_make_sort_key (thread_p, &analytic_state->key_info, recdes, analytic_state->input_scan,
-			      &analytic_state->input_tplrec);
+  /* all ok */
+  return NO_ERROR;
 }
 
 /*
- * qexec_analytic_put_next () -
- *   return:
- *   recdes(in) :
- *   arg(in)    :
+ * qexec_analytic_evaluate_offset_function () - process analytic offset functions
+ *                                              (i.e. lead/lag)
+ *   returns: error code or NO_ERROR
+ *   thread_p(in): current thread
+ *   func_p(in): analytic function
+ *   analytic_state(in): analytic state
+ *   val_desc(in): value descriptor
+ *   tuple_idx(in): current position of main scan in group
  */
 static int
-qexec_analytic_put_next (THREAD_ENTRY * thread_p, const RECDES * recdes, void *arg)
+qexec_analytic_evaluate_offset_function (THREAD_ENTRY * thread_p, ANALYTIC_FUNCTION_STATE * func_state,
+					 ANALYTIC_STATE * analytic_state)
 {
-  ANALYTIC_STATE *analytic_state;
-  SORT_REC *key;
-  char *data;
-  VPID vpid;
-  int peek, i;
-  QFILE_LIST_ID *list_idp;
-
-  QFILE_TUPLE_RECORD dummy;
-  int status;
-
-  analytic_state = (ANALYTIC_STATE *) arg;
-  list_idp = &(analytic_state->input_scan->list_id);
-
-  data = NULL;
+  ANALYTIC_TYPE *func_p;
+  REGU_VARIABLE_LIST regulist;
+  DB_VALUE *default_val_p;
+  DB_VALUE offset_val;
+  DB_VALUE default_val;
+  int regu_idx;
+  int target_idx;
+  int group_tuple_count;
+  int error = NO_ERROR;
+  TP_DOMAIN_STATUS dom_status;
+  double nth_idx = 0.0;
+  char buf[64];
+  bool put_default = false;
 
-  /* Traverse next link */
-  for (key = (SORT_REC *) recdes->data; key; key = key->next)
+  if (func_state == NULL)
+    {
+      /* nothing to do */
+      return NO_ERROR;
+    }
+  else
     {
-      if (analytic_state->state != NO_ERROR)
-	{
-	  goto exit_on_error;
-	}
+      func_p = func_state->func_p;
+      assert (func_p);
+    }
 
-      peek = COPY;		/* default */
+  if (!QPROC_ANALYTIC_IS_OFFSET_FUNCTION (func_p))
+    {
+      /* nothing to do */
+      return NO_ERROR;
+    }
 
-      /* evaluate inst_num() predicate */
-      if (qexec_analytic_eval_instnum_pred (thread_p, analytic_state, ANALYTIC_INTERM_PROC) != NO_ERROR)
-	{
-	  goto exit_on_error;
-	}
+  /* determine which tuple count to use */
+  if (func_p->ignore_nulls)
+    {
+      group_tuple_count = func_state->curr_group_tuple_count_nn;
+    }
+  else
+    {
+      group_tuple_count = func_state->curr_group_tuple_count;
+    }
 
-      /*
-       * Retrieve the original tuple.  This will be the case if the
-       * original tuple had more fields than we were sorting on.
-       */
-      vpid.pageid = key->s.original.pageid;
-      vpid.volid = key->s.original.volid;
+  /* find offset reguvar and get int value */
+  regulist = analytic_state->a_regu_list;
+  regu_idx = func_p->offset_idx;
+  while (regu_idx > 0 && regulist != NULL)
+    {
+      regulist = regulist->next;
+      regu_idx--;
+    }
+  if (regulist == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_QPROC_INVALID_XASLNODE, 0);
+      return ER_FAILED;
+    }
 
-      if (analytic_state->curr_sort_page.vpid.pageid != vpid.pageid
-	  || analytic_state->curr_sort_page.vpid.volid != vpid.volid)
+  /* get target tuple index */
+  switch (func_p->function)
+    {
+    case PT_LEAD:
+    case PT_LAG:
+      dom_status = tp_value_coerce (regulist->value.vfetch_to, &offset_val, &tp_Integer_domain);
+      if (dom_status != DOMAIN_COMPATIBLE)
 	{
-	  if (analytic_state->curr_sort_page.page_p != NULL)
-	    {
-	      qmgr_free_old_page_and_init (thread_p, analytic_state->curr_sort_page.page_p, list_idp->tfile_vfid);
-	    }
-
-	  analytic_state->curr_sort_page.page_p = qmgr_get_old_page (thread_p, &vpid, list_idp->tfile_vfid);
-	  if (analytic_state->curr_sort_page.page_p == NULL)
-	    {
-	      goto exit_on_error;
-	    }
-	  else
+	  error = tp_domain_status_er_set (dom_status, ARG_FILE_LINE, regulist->value.vfetch_to, &tp_Integer_domain);
+	  if (error == NO_ERROR)
 	    {
-	      analytic_state->curr_sort_page.vpid = vpid;
+	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_QUERY_EXECUTION_ERROR, 1, __LINE__);
+	      return ER_FAILED;
 	    }
+	  return error;
 	}
 
-      QFILE_GET_OVERFLOW_VPID (&vpid, analytic_state->curr_sort_page.page_p);
-      data = analytic_state->curr_sort_page.page_p + key->s.original.offset;
-      if (vpid.pageid != NULL_PAGEID)
+      /* guard against NULL */
+      if (!DB_IS_NULL (&offset_val))
 	{
-	  /*
-	   * This sucks; why do we need two different structures to
-	   * accomplish exactly the same goal?
-	   */
-	  dummy.size = analytic_state->analytic_rec.area_size;
-	  dummy.tpl = analytic_state->analytic_rec.data;
-	  status = qfile_get_tuple (thread_p, analytic_state->curr_sort_page.page_p, data, &dummy, list_idp);
-
-	  if (dummy.tpl != analytic_state->analytic_rec.data)
-	    {
-	      /*
-	       * DON'T FREE THE BUFFER!  qfile_get_tuple() already did
-	       * that, and what you have here in gby_rec is a dangling
-	       * pointer.
-	       */
-	      analytic_state->analytic_rec.area_size = dummy.size;
-	      analytic_state->analytic_rec.data = dummy.tpl;
-	    }
-	  if (status != NO_ERROR)
-	    {
-	      goto exit_on_error;
-	    }
-
-	  data = analytic_state->analytic_rec.data;
+	  target_idx = offset_val.data.i;
 	}
       else
 	{
-	  peek = PEEK;		/* avoid unnecessary COPY */
+	  target_idx = 0;
 	}
 
-      /*
-       * process current sorted tuple
-       */
-      if (analytic_state->input_recs == 0)
+      /* done with offset dbval */
+      pr_clear_value (&offset_val);
+
+      if (func_p->function == PT_LEAD)
 	{
-	  /* first input record, initialize everything */
-	  for (i = 0; i < analytic_state->func_count; i++)
-	    {
-	      qexec_analytic_start_group (thread_p, analytic_state->xasl_state, &analytic_state->func_state_list[i],
-					  recdes, true);
-	    }
+	  target_idx = func_state->group_consumed_tuples + target_idx;
 	}
       else
 	{
-	  for (i = 0; i < analytic_state->func_count; i++)
-	    {
-	      ANALYTIC_FUNCTION_STATE *func_state = &analytic_state->func_state_list[i];
-	      bool is_same_group = false;
-	      int nkeys;
-
-	      /* check group finish */
-	      nkeys = analytic_state->key_info.nkeys;
-	      analytic_state->key_info.nkeys = func_state->func_p->sort_list_size;
-	      if (((*analytic_state->cmp_fn) (&func_state->current_key.data, &key, &analytic_state->key_info) == 0)
-		  || analytic_state->key_info.nkeys == 0)
-		{
-		  /* keep rank within same sort key */
-		  analytic_state->key_info.nkeys = nkeys;
-		  ANALYTIC_FUNC_SET_FLAG (func_state->func_p, ANALYTIC_KEEP_RANK);
-
-		  if (QPROC_ANALYTIC_IS_OFFSET_FUNCTION (func_state->func_p))
-		    {
-		      /* offset functions will treat all tuples in a group as having a different sort key regardless if
-		       * this is true or not; this is done in order to have a distinct value for each tuple in the
-		       * group (whereas normally tuples sharing a sort key will also share a value) */
-		      is_same_group = true;
-		    }
-		  else
-		    {
-		      /* same sort key, move on */
-		      continue;
-		    }
-		}
-	      analytic_state->key_info.nkeys = nkeys;
-
-	      /* find out if it's the same group */
-	      if (!is_same_group)
-		{
-		  if (func_state->func_p->sort_prefix_size == 0)
-		    {
-		      /* no groups, only ordering */
-		      is_same_group = true;
-		    }
-		  else
-		    {
-		      nkeys = analytic_state->key_info.nkeys;
-		      analytic_state->key_info.nkeys = func_state->func_p->sort_prefix_size;
-		      if ((*analytic_state->cmp_fn) (&func_state->current_key.data, &key,
-						     &analytic_state->key_info) == 0)
-			{
-			  is_same_group = true;
-			}
-		      analytic_state->key_info.nkeys = nkeys;
-		    }
-		}
+	  /* PT_LAG */
+	  target_idx = func_state->group_consumed_tuples - target_idx;
+	}
+      break;
 
-	      if (!is_same_group)
-		{
-		  if (qexec_analytic_finalize_group (thread_p, analytic_state->xasl_state, func_state, false) !=
-		      NO_ERROR)
-		    {
-		      goto exit_on_error;
-		    }
-		  pr_clear_value (func_state->func_p->value);
-		  qexec_analytic_start_group (thread_p, analytic_state->xasl_state, func_state, recdes, true);
-		}
-	      else if (func_state->func_p->function != PT_NTILE
-		       && (!QPROC_IS_INTERPOLATION_FUNC (func_state->func_p) || func_state->func_p->option == Q_ALL))
-		{
-		  if (qexec_analytic_finalize_group (thread_p, analytic_state->xasl_state, func_state, true) !=
-		      NO_ERROR)
-		    {
-		      goto exit_on_error;
-		    }
-		  qexec_analytic_start_group (thread_p, analytic_state->xasl_state, func_state, recdes, false);
-		}
-	    }
+    case PT_NTH_VALUE:
+      dom_status = tp_value_coerce (regulist->value.vfetch_to, &offset_val, &tp_Double_domain);
+      if (dom_status != DOMAIN_COMPATIBLE)
+	{
+	  error = tp_domain_status_er_set (dom_status, ARG_FILE_LINE, regulist->value.vfetch_to, &tp_Double_domain);
+	  return error;
 	}
 
-      /* aggregate tuple across all functions */
-      qexec_analytic_add_tuple (thread_p, analytic_state, data, peek);
+      if (DB_IS_NULL (&offset_val))
+	{
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_ARG_OUT_OF_RANGE, 1, "NULL");
+	  return ER_FAILED;
+	}
 
-      /* one more input record of beer on the wall */
-      analytic_state->input_recs++;
-    }				/* for (key = (SORT_REC *) recdes->data; ...) */
+      nth_idx = db_get_double (&offset_val);
 
-wrapup:
-  return analytic_state->state;
+      if (nth_idx < 1.0 || nth_idx > DB_INT32_MAX)
+	{
+	  sprintf (buf, "%.15g", nth_idx);
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_ARG_OUT_OF_RANGE, 1, buf);
+	  return ER_FAILED;
+	}
 
-exit_on_error:
-  assert (er_errid () != NO_ERROR);
-  analytic_state->state = er_errid ();
-  goto wrapup;
-}
+      target_idx = (int) floor (nth_idx);
+      target_idx--;		/* SQL defines this index as starting with one */
 
-/*
- * qexec_analytic_eval_instnum_pred () - evaluate inst_num() predicate
- *   returns: error code or NO_ERROR
- *   thread_p(in): current thread
- *   analytic_state(in): analytic state
- *   func_p(in): analytic function chain
- *   stage(in): stage from within function is called
- *
- * NOTE: this function sets the analytic state's "is_output_rec" flag
- */
-static int
-qexec_analytic_eval_instnum_pred (THREAD_ENTRY * thread_p, ANALYTIC_STATE * analytic_state, ANALYTIC_STAGE stage)
-{
-  ANALYTIC_STAGE instnum_stage = ANALYTIC_INTERM_PROC;
-  DB_LOGICAL is_output_rec;
-  int instnum_flag, i;
+      if (target_idx >= 0 && target_idx < group_tuple_count)
+	{
+	  if (func_p->from_last)
+	    {
+	      target_idx = group_tuple_count - target_idx;
+	    }
+	}
+      else
+	{
+	  target_idx = -1;
+	}
+      break;
 
-  /* get flag from buildlist */
-  instnum_flag = analytic_state->xasl->proc.buildlist.a_instnum_flag;
+    default:
+      /* switch should cover all cases */
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_QUERY_EXECUTION_ERROR, 1, __LINE__);
+      return ER_FAILED;
+    }
 
-  /* by default, it's an output record */
-  analytic_state->is_output_rec = true;
+  /* clean up */
+  pr_clear_value (&offset_val);
 
-  if (!analytic_state->is_last_run
-      || (analytic_state->xasl->instnum_pred == NULL && !(instnum_flag & XASL_INSTNUM_FLAG_EVAL_DEFER)))
+  /* find defaultvalue reguvar and get dbvalue pointer */
+  regulist = analytic_state->a_regu_list;
+  regu_idx = func_p->default_idx;
+  while (regu_idx > 0 && regulist != NULL)
     {
-      /* inst_num() is evaluated only for last function, when an INST_NUM() predicate is present or when INST_NUM() is
-       * selected */
-      return NO_ERROR;
+      regulist = regulist->next;
+      regu_idx--;
     }
-
-  for (i = 0; i < analytic_state->func_count; i++)
+  if (regulist == NULL)
     {
-      ANALYTIC_TYPE *func_p = analytic_state->func_state_list[i].func_p;
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_QPROC_INVALID_XASLNODE, 0);
+      return ER_FAILED;
+    }
+  default_val_p = regulist->value.vfetch_to;
 
-      if (QPROC_ANALYTIC_IS_OFFSET_FUNCTION (func_p) || func_p->function == PT_NTILE
-	  || func_p->function == PT_FIRST_VALUE || func_p->function == PT_LAST_VALUE)
+  /* put value */
+  if (target_idx >= 0 && target_idx < group_tuple_count)
+    {
+      if (qexec_analytic_value_lookup (thread_p, func_state, target_idx, func_p->ignore_nulls) != NO_ERROR)
 	{
-	  /* inst_num() predicate is evaluated at group processing for these functions, as the result is computed at
-	   * this stage using all group values */
-	  instnum_stage = ANALYTIC_GROUP_PROC;
+	  return ER_FAILED;
 	}
 
-      if (instnum_flag & XASL_INSTNUM_FLAG_EVAL_DEFER)
+      if (func_p->function == PT_NTH_VALUE)
 	{
-	  /* we're selecting INST_NUM() so we must evaluate it when writing the output file */
-	  instnum_stage = ANALYTIC_GROUP_PROC;
+	  /* when using ORDER BY on NTH_VALUE, value will be NULL until that value is reached */
+	  if ((func_p->sort_prefix_size != func_p->sort_list_size)
+	      && (func_state->group_consumed_tuples < func_state->group_tuple_position))
+	    {
+	      put_default = true;
+	    }
 	}
     }
-
-  if (stage != instnum_stage)
+  else
     {
-      /* we're not at the required stage */
-      return NO_ERROR;
+      put_default = true;
     }
 
-  /* evaluate inst_num() */
-  is_output_rec = qexec_eval_instnum_pred (thread_p, analytic_state->xasl, analytic_state->xasl_state);
-  if (is_output_rec == V_ERROR)
-    {
-      return ER_FAILED;
-    }
-  else
+  if (put_default)
     {
-      analytic_state->is_output_rec = (is_output_rec == V_TRUE);
+      /* coerce value to default domain */
+      dom_status = tp_value_coerce (default_val_p, &default_val, func_p->domain);
+      if (dom_status != DOMAIN_COMPATIBLE)
+	{
+	  error = tp_domain_status_er_set (dom_status, ARG_FILE_LINE, default_val_p, func_p->domain);
+	  if (error == NO_ERROR)
+	    {
+	      return ER_FAILED;
+	    }
+	  return error;
+	}
+
+      /* put default value and clean up */
+      pr_clear_value (func_p->value);
+      pr_clone_value (&default_val, func_p->value);
+      pr_clear_value (&default_val);
     }
 
   /* all ok */
-  return NO_ERROR;
+  return error;
 }
 
 /*
- * qexec_analytic_start_group () -
- *   return:
+ * qexec_analytic_evaluate_cume_dist_percent_rank_function () -
+ *                    evaluate CUME_DIST and PERCENT_RANK
+ *   returns: error code or NO_ERROR
+ *   thread(in):
+ *   func_p(in/out):
  *   analytic_state(in):
- *   key(in):
- *   reinit(in):
+ *   tuple_idx(in):
  */
 static int
-qexec_analytic_start_group (THREAD_ENTRY * thread_p, XASL_STATE * xasl_state, ANALYTIC_FUNCTION_STATE * func_state,
-			    const RECDES * key, bool reinit)
+qexec_analytic_evaluate_cume_dist_percent_rank_function (THREAD_ENTRY * thread_p, ANALYTIC_FUNCTION_STATE * func_state)
 {
-  int error;
-
-  /*
-   * Record the new key; keep it in SORT_KEY format so we can continue
-   * to use the SORTKEY_INFO version of the comparison functions.
-   *
-   * WARNING: the sort module doesn't seem to set key->area_size
-   * reliably, so the only thing we can rely on is key->length.
-   */
+  int start_of_group = func_state->group_tuple_position - func_state->sort_key_tuple_position;
+  int end_of_group =
+    func_state->group_tuple_position - func_state->sort_key_tuple_position + func_state->curr_sort_key_tuple_count;
 
-  if (key)
+  switch (func_state->func_p->function)
     {
-      if (func_state->current_key.area_size < key->length)
-	{
-	  void *tmp;
+    case PT_CUME_DIST:
+      db_make_double (func_state->func_p->value, (double) end_of_group / func_state->curr_group_tuple_count);
+      break;
 
-	  tmp = db_private_realloc (thread_p, func_state->current_key.data, key->area_size);
-	  if (tmp == NULL)
-	    {
-	      GOTO_EXIT_ON_ERROR;
-	    }
-	  func_state->current_key.data = (char *) tmp;
-	  func_state->current_key.area_size = key->area_size;
+    case PT_PERCENT_RANK:
+      if (func_state->curr_group_tuple_count <= 1)
+	{
+	  db_make_double (func_state->func_p->value, 0.0f);
 	}
-      memcpy (func_state->current_key.data, key->data, key->length);
-      func_state->current_key.length = key->length;
-    }
-
-  /*
-   * (Re)initialize the various accumulator variables...
-   */
-  if (reinit)
-    {
-      /* starting a new group */
-      error = qdata_initialize_analytic_func (thread_p, func_state->func_p, xasl_state->query_id);
-      if (error != NO_ERROR)
+      else
 	{
-	  GOTO_EXIT_ON_ERROR;
+	  db_make_double (func_state->func_p->value,
+			  (double) start_of_group / (func_state->curr_group_tuple_count - 1));
 	}
+      break;
 
-      /* reinitialize counters */
-      func_state->curr_group_tuple_count = 0;
-      func_state->curr_group_tuple_count_nn = 0;
-      func_state->curr_sort_key_tuple_count = 0;
-    }
-  else
-    {
-      /* starting a new partition; reinstate acumulator */
-      qdata_copy_db_value (func_state->func_p->value, &func_state->func_p->part_value);
-      pr_clear_value (&func_state->func_p->part_value);
-
-      /* reinitialize counters */
-      func_state->curr_sort_key_tuple_count = 0;
+    default:
+      return ER_FAILED;
     }
 
   return NO_ERROR;
-
-exit_on_error:
-  assert (er_errid () != NO_ERROR);
-  return er_errid ();
 }
 
 /*
- * qexec_analytic_finalize_group () - finish analytic function and dump result to file
- *   return: error code or NO_ERROR
- *   xasl_state(in): XASL state
- *   func_state(in): function state
- *   is_same_group(in): true if we're finalizing a sort key, false if a group
+ * qexec_analytic_evaluate_interpolation_function () -
+ *
+ *   returns: error code or NO_ERROR
+ *   thread_p(in): current thread
+ *   func_p(in): analytic function
+ *   analytic_state(in): analytic state
+ *   tuple_idx(in): current position of main scan in group
  */
 static int
-qexec_analytic_finalize_group (THREAD_ENTRY * thread_p, XASL_STATE * xasl_state, ANALYTIC_FUNCTION_STATE * func_state,
-			       bool is_same_group)
+qexec_analytic_evaluate_interpolation_function (THREAD_ENTRY * thread_p, ANALYTIC_FUNCTION_STATE * func_state)
 {
-  QFILE_TUPLE_RECORD tplrec;
-  int rc = NO_ERROR;
+  ANALYTIC_TYPE *func_p = NULL;
+  double f_row_num_d, c_row_num_d, row_num_d, percentile_d;
+  int error = NO_ERROR;
+  DB_VALUE *peek_value_p = NULL;
 
-  /* initialize tuple record */
-  tplrec.tpl = NULL;
-  tplrec.size = 0;
+  assert (func_state != NULL && func_state->func_p != NULL);
+  func_p = func_state->func_p;
+  assert (QPROC_IS_INTERPOLATION_FUNC (func_p));
 
-  /* finalize function */
-  if (qdata_finalize_analytic_func (thread_p, func_state->func_p, is_same_group) != NO_ERROR)
+  /* MEDIAN function is evaluated at the start of the group */
+  if (func_state->group_tuple_position_nn > 0)
     {
-      rc = ER_FAILED;
-      goto cleanup;
+      return NO_ERROR;
     }
 
-  if (!DB_IS_NULL (func_state->func_p->value))
+  /* constant operand case */
+  if (func_p->is_const_operand)
     {
-      /* keep track of non-NULL values */
-      func_state->curr_group_tuple_count_nn += func_state->curr_sort_key_tuple_count;
+      /* if constant operand, value has been established during evaluation and was fetched from intermediate file */
+      return NO_ERROR;
     }
 
-  /* write current counts to dbvalues */
-  db_make_int (&func_state->cgtc_dbval, func_state->curr_group_tuple_count);
-  db_make_int (&func_state->cgtc_nn_dbval, func_state->curr_group_tuple_count_nn);
-  db_make_int (&func_state->csktc_dbval, func_state->curr_sort_key_tuple_count);
-
-  /* dump group */
-  if (!is_same_group)
+  /* zero non-NULL values in group */
+  if (func_state->curr_group_tuple_count_nn == 0)
     {
-      if (qfile_fast_intint_tuple_to_list (thread_p, func_state->group_list_id, func_state->curr_group_tuple_count,
-					   func_state->curr_group_tuple_count_nn) != NO_ERROR)
-	{
-	  rc = ER_FAILED;
-	  goto cleanup;
-	}
+      return NO_ERROR;
     }
 
-  /* dump sort key header */
-  rc =
-    qfile_fast_intval_tuple_to_list (thread_p, func_state->value_list_id, func_state->curr_sort_key_tuple_count,
-				     func_state->func_p->value);
-  if (rc > 0)
+  /* get target row */
+  if (func_p->function == PT_MEDIAN)
     {
-      rc = NO_ERROR;
-      /* big tuple */
-      if (qfile_copy_tuple_descr_to_tuple (thread_p, &func_state->value_list_id->tpl_descr, &tplrec) != NO_ERROR)
+      percentile_d = 0.5;
+    }
+  else
+    {
+      error =
+	fetch_peek_dbval (thread_p, func_p->info.percentile.percentile_reguvar, NULL, NULL, NULL, NULL, &peek_value_p);
+      if (error != NO_ERROR)
 	{
-	  rc = ER_FAILED;
-	  goto cleanup;
+	  assert (er_errid () != NO_ERROR);
+
+	  return error;
 	}
-      if (qfile_add_tuple_to_list (thread_p, func_state->value_list_id, tplrec.tpl) != NO_ERROR)
+
+      assert (DB_VALUE_TYPE (peek_value_p) == DB_TYPE_DOUBLE);
+
+      percentile_d = db_get_double (peek_value_p);
+
+      if (func_p->function == PT_PERCENTILE_DISC)
 	{
-	  rc = ER_FAILED;
-	  goto cleanup;
+	  percentile_d =
+	    ceil (percentile_d * func_state->curr_group_tuple_count_nn) / func_state->curr_group_tuple_count_nn;
 	}
     }
 
-cleanup:
-
-  if (tplrec.tpl != NULL)
-    {
-      db_private_free (thread_p, tplrec.tpl);
-    }
-
-  return rc;
-}
-
-/*
- * qexec_analytic_add_tuple () -
- *   return:
- *   analytic_state(in):
- *   tpl(in):
- *   peek(in):
- */
-static void
-qexec_analytic_add_tuple (THREAD_ENTRY * thread_p, ANALYTIC_STATE * analytic_state, QFILE_TUPLE tpl, int peek)
-{
-  XASL_STATE *xasl_state = analytic_state->xasl_state;
-  QFILE_LIST_ID *list_id = analytic_state->interm_file;
-  int i;
+  row_num_d = ((double) (func_state->curr_group_tuple_count_nn - 1)) * percentile_d;
+  f_row_num_d = floor (row_num_d);
 
-  if (analytic_state->state != NO_ERROR)
+  if (func_p->function == PT_PERCENTILE_DISC)
     {
-      return;
+      c_row_num_d = f_row_num_d;
     }
-
-  if (fetch_val_list (thread_p, analytic_state->a_regu_list, &xasl_state->vd, NULL, NULL, tpl, peek) != NO_ERROR)
+  else
     {
-      GOTO_EXIT_ON_ERROR;
+      c_row_num_d = ceil (row_num_d);
     }
 
-  for (i = 0; i < analytic_state->func_count; i++)
+  /* compute value */
+  if (f_row_num_d == c_row_num_d)
     {
-      if (qdata_evaluate_analytic_func (thread_p, analytic_state->func_state_list[i].func_p, &xasl_state->vd) !=
-	  NO_ERROR)
+      /* we have an odd number of rows, median is middle row's value; fetch it */
+      if (qexec_analytic_value_lookup (thread_p, func_state, (int) f_row_num_d, true) != NO_ERROR)
 	{
-	  GOTO_EXIT_ON_ERROR;
+	  return ER_FAILED;
 	}
 
-      /* account for tuple */
-      analytic_state->func_state_list[i].curr_group_tuple_count++;
-      analytic_state->func_state_list[i].curr_sort_key_tuple_count++;
-    }
-
-  /* check if output */
-  if (analytic_state->is_output_rec)
-    {
-      /* records that did not pass the instnum() predicate evaluation are used for computing the function value, but
-       * are not included in the intermediate file */
-      if (qexec_insert_tuple_into_list (thread_p, list_id, analytic_state->a_outptr_list_interm, &xasl_state->vd,
-					analytic_state->output_tplrec) != NO_ERROR)
+      /* coerce accordingly */
+      error =
+	qdata_apply_interpolation_function_coercion (func_p->value, &func_p->domain, func_p->value, func_p->function);
+      if (error != NO_ERROR)
 	{
-	  GOTO_EXIT_ON_ERROR;
+	  return error;
 	}
     }
+  else
+    {
+      DB_VALUE c_value, f_value;
+      db_make_null (&c_value);
+      db_make_null (&f_value);
 
-wrapup:
-  return;
-
-exit_on_error:
-  assert (er_errid () != NO_ERROR);
-  analytic_state->state = er_errid ();
-  goto wrapup;
-}
-
-/*
- * qexec_clear_analytic_function_state () - clear function state
- *   thread_p(in): thread entry
- *   func_state(in): function state to free
- */
-static void
-qexec_clear_analytic_function_state (THREAD_ENTRY * thread_p, ANALYTIC_FUNCTION_STATE * func_state)
-{
-  assert (func_state != NULL);
+      if (qexec_analytic_value_lookup (thread_p, func_state, (int) f_row_num_d, true) != NO_ERROR)
+	{
+	  return ER_FAILED;
+	}
+      else
+	{
+	  pr_clone_value (func_p->value, &f_value);
+	}
 
-  /* clear db_values */
-  pr_clear_value (func_state->func_p->value);
-  pr_clear_value (&func_state->cgtc_dbval);
-  pr_clear_value (&func_state->cgtc_nn_dbval);
-  pr_clear_value (&func_state->csktc_dbval);
+      if (qexec_analytic_value_lookup (thread_p, func_state, (int) c_row_num_d, true) != NO_ERROR)
+	{
+	  return ER_FAILED;
+	}
+      else
+	{
+	  pr_clone_value (func_p->value, &c_value);
+	}
 
-  /* free buffers */
-  if (func_state->current_key.data)
-    {
-      db_private_free_and_init (thread_p, func_state->current_key.data);
-      func_state->current_key.area_size = 0;
+      pr_clear_value (func_p->value);
+      error =
+	qdata_interpolation_function_values (&f_value, &c_value, row_num_d, f_row_num_d, c_row_num_d, &func_p->domain,
+					     func_p->value, func_p->function);
+      if (error != NO_ERROR)
+	{
+	  return error;
+	}
     }
 
-  /* dealloc files */
-  qfile_close_list (thread_p, func_state->group_list_id);
-  qfile_close_list (thread_p, func_state->value_list_id);
-  qfile_destroy_list (thread_p, func_state->group_list_id);
-  qfile_destroy_list (thread_p, func_state->value_list_id);
-  qfile_free_list_id (func_state->group_list_id);
-  qfile_free_list_id (func_state->value_list_id);
+  /* all ok */
+  return NO_ERROR;
 }
 
 /*
- * qexec_clear_analytic_state () -
- *   return:
- *   analytic_state(in):
+ * qexec_analytic_group_header_load () - load group information from group list
+ *					 file
+ *   returns: error code or NO_ERROR
+ *   func_state(in): function state
  */
-static void
-qexec_clear_analytic_state (THREAD_ENTRY * thread_p, ANALYTIC_STATE * analytic_state)
+static int
+qexec_analytic_group_header_load (ANALYTIC_FUNCTION_STATE * func_state)
 {
-  int i;
-
-  for (i = 0; i < analytic_state->func_count; i++)
-    {
-      qexec_clear_analytic_function_state (thread_p, &analytic_state->func_state_list[i]);
-    }
-  if (analytic_state->func_state_list != NULL)
-    {
-      db_private_free_and_init (thread_p, analytic_state->func_state_list);
-    }
-
-  if (analytic_state->analytic_rec.data)
-    {
-      db_private_free_and_init (thread_p, analytic_state->analytic_rec.data);
-      analytic_state->analytic_rec.area_size = 0;
-    }
-  analytic_state->output_tplrec = NULL;
+  QFILE_TUPLE tuple_p;
 
-  qfile_clear_sort_key_info (&analytic_state->key_info);
+  assert (func_state != NULL);
 
-  if (analytic_state->curr_sort_page.page_p != NULL)
-    {
-      qmgr_free_old_page_and_init (thread_p, analytic_state->curr_sort_page.page_p,
-				   analytic_state->input_scan->list_id.tfile_vfid);
-      analytic_state->curr_sort_page.vpid.pageid = NULL_PAGEID;
-      analytic_state->curr_sort_page.vpid.volid = NULL_VOLID;
-    }
+  tuple_p = func_state->group_tplrec.tpl + QFILE_TUPLE_LENGTH_SIZE;
 
-  if (analytic_state->input_scan)
+  /* deserialize tuple count */
+  if (QFILE_GET_TUPLE_VALUE_FLAG (tuple_p) != V_BOUND)
     {
-      qfile_close_scan (thread_p, analytic_state->input_scan);
-      analytic_state->input_scan = NULL;
+      return ER_FAILED;
     }
+  tuple_p += QFILE_TUPLE_VALUE_HEADER_SIZE;
+  func_state->curr_group_tuple_count = OR_GET_INT (tuple_p);
+  tuple_p += DB_ALIGN (tp_Integer.disksize, MAX_ALIGNMENT);
 
-  if (analytic_state->interm_scan)
+  /* deserialize not-null tuple count */
+  if (QFILE_GET_TUPLE_VALUE_FLAG (tuple_p) != V_BOUND)
     {
-      qfile_close_scan (thread_p, analytic_state->interm_scan);
-      analytic_state->interm_scan = NULL;
+      return ER_FAILED;
     }
+  tuple_p += QFILE_TUPLE_VALUE_HEADER_SIZE;
+  func_state->curr_group_tuple_count_nn = OR_GET_INT (tuple_p);
 
-  if (analytic_state->interm_file)
-    {
-      qfile_close_list (thread_p, analytic_state->interm_file);
-      qfile_destroy_list (thread_p, analytic_state->interm_file);
-      qfile_free_list_id (analytic_state->interm_file);
-      analytic_state->interm_file = NULL;
-    }
-  if (analytic_state->output_file)
-    {
-      qfile_close_list (thread_p, analytic_state->output_file);
-      qfile_free_list_id (analytic_state->output_file);
-      analytic_state->output_file = NULL;
-    }
+  /* all ok */
+  return NO_ERROR;
 }
 
 /*
- * qexec_analytic_evaluate_ntile_function () - evaluate NTILE function
+ * qexec_analytic_sort_key_header_load () - load sort key header from sort key
+ *					    list file
  *   returns: error code or NO_ERROR
- *   thread_p(in): current thread
- *   func_p(in): analytic function
- *   analytic_state(in): analytic state
- *   tuple_idx(in): current tuple index
+ *   func_state(in): function state
+ *   load_value(in): if true, will load the actual value into func_p->value
+ *
+ * NOTE: if repeated often, loading the actual value can be expensive, so make
+ * sure you only set load_value when necessary.
  */
 static int
-qexec_analytic_evaluate_ntile_function (THREAD_ENTRY * thread_p, ANALYTIC_FUNCTION_STATE * func_state)
+qexec_analytic_sort_key_header_load (ANALYTIC_FUNCTION_STATE * func_state, bool load_value)
 {
-  if (func_state == NULL || func_state->func_p == NULL || func_state->func_p->function != PT_NTILE)
+  QFILE_TUPLE tuple_p;
+  OR_BUF buf;
+  int length, rc = NO_ERROR;
+
+  assert (func_state != NULL);
+
+  tuple_p = func_state->value_tplrec.tpl + QFILE_TUPLE_LENGTH_SIZE;
+
+  /* deserialize tuple count */
+  if (QFILE_GET_TUPLE_VALUE_FLAG (tuple_p) != V_BOUND)
     {
-      /* nothing to do */
-      return NO_ERROR;
+      return ER_FAILED;
     }
+  tuple_p += QFILE_TUPLE_VALUE_HEADER_SIZE;
+  func_state->curr_sort_key_tuple_count = OR_GET_INT (tuple_p);
+  tuple_p += DB_ALIGN (tp_Integer.disksize, MAX_ALIGNMENT);
 
-  if (!func_state->func_p->info.ntile.is_null)
+  if (!load_value && !func_state->func_p->ignore_nulls && !QPROC_IS_INTERPOLATION_FUNC (func_state->func_p))
     {
-      int recs_in_bucket = func_state->curr_group_tuple_count / func_state->func_p->info.ntile.bucket_count;
-      int compensate = func_state->curr_group_tuple_count % func_state->func_p->info.ntile.bucket_count;
+      /* we're not counting NULLs and we're not using the value */
+      return NO_ERROR;
+    }
 
-      /* get bucket of current tuple */
-      if (recs_in_bucket == 0)
-	{
-	  /* more buckets than tuples, this is identity */
-	  db_make_int (func_state->func_p->value, func_state->group_tuple_position + 1);
-	}
-      else if (compensate == 0)
-	{
-	  /* perfect division, straightforward */
-	  db_make_int (func_state->func_p->value, func_state->group_tuple_position / recs_in_bucket + 1);
-	}
-      else
-	{
-	  int xcount = (recs_in_bucket + 1) * compensate;
+  /* clear current value */
+  pr_clear_value (func_state->func_p->value);
+
+  /* deserialize value */
+  if (QFILE_GET_TUPLE_VALUE_FLAG (tuple_p) == V_BOUND)
+    {
+      length = QFILE_GET_TUPLE_VALUE_LENGTH (tuple_p);
+      tuple_p += QFILE_TUPLE_VALUE_HEADER_SIZE;
+      OR_BUF_INIT (buf, tuple_p, length);
 
-	  /* account for remainder */
-	  if (func_state->group_tuple_position < xcount)
-	    {
-	      db_make_int (func_state->func_p->value, func_state->group_tuple_position / (recs_in_bucket + 1) + 1);
-	    }
-	  else
-	    {
-	      db_make_int (func_state->func_p->value,
-			   (func_state->group_tuple_position - compensate) / recs_in_bucket + 1);
-	    }
+      rc =
+	func_state->func_p->domain->type->data_readval (&buf, func_state->func_p->value, func_state->func_p->domain, -1,
+							false, NULL, 0);
+      if (rc != NO_ERROR)
+	{
+	  return ER_FAILED;
 	}
     }
   else
     {
-      /* null output */
       db_make_null (func_state->func_p->value);
     }
 
@@ -20442,3467 +21701,3476 @@ qexec_analytic_evaluate_ntile_function (THREAD_ENTRY * thread_p, ANALYTIC_FUNCTI
 }
 
 /*
- * qexec_analytic_evaluate_offset_function () - process analytic offset functions
- *                                              (i.e. lead/lag)
+ * qexec_analytic_value_advance () - advance position in group/sort key list
+ *				     files and load headers
  *   returns: error code or NO_ERROR
- *   thread_p(in): current thread
- *   func_p(in): analytic function
- *   analytic_state(in): analytic state
- *   val_desc(in): value descriptor
- *   tuple_idx(in): current position of main scan in group
+ *   thread_p(in): thread
+ *   func_state(in): function state
+ *   amount(in): amount to advance (can also be negative)
+ *   max_group_changes(in): maximum number of group changes
+ *   ignore_nulls(in): if true, execution will skip NULL values
  */
 static int
-qexec_analytic_evaluate_offset_function (THREAD_ENTRY * thread_p, ANALYTIC_FUNCTION_STATE * func_state,
-					 ANALYTIC_STATE * analytic_state)
+qexec_analytic_value_advance (THREAD_ENTRY * thread_p, ANALYTIC_FUNCTION_STATE * func_state, int amount,
+			      int max_group_changes, bool ignore_nulls)
 {
-  ANALYTIC_TYPE *func_p;
-  REGU_VARIABLE_LIST regulist;
-  DB_VALUE *default_val_p;
-  DB_VALUE offset_val;
-  DB_VALUE default_val;
-  int regu_idx;
-  int target_idx;
-  int group_tuple_count;
-  int error = NO_ERROR;
-  TP_DOMAIN_STATUS dom_status;
-  double nth_idx = 0.0;
-  char buf[64];
-  bool put_default = false;
-
-  if (func_state == NULL)
-    {
-      /* nothing to do */
-      return NO_ERROR;
-    }
-  else
-    {
-      func_p = func_state->func_p;
-      assert (func_p);
-    }
-
-  if (!QPROC_ANALYTIC_IS_OFFSET_FUNCTION (func_p))
-    {
-      /* nothing to do */
-      return NO_ERROR;
-    }
-
-  /* determine which tuple count to use */
-  if (func_p->ignore_nulls)
-    {
-      group_tuple_count = func_state->curr_group_tuple_count_nn;
-    }
-  else
-    {
-      group_tuple_count = func_state->curr_group_tuple_count;
-    }
-
-  /* find offset reguvar and get int value */
-  regulist = analytic_state->a_regu_list;
-  regu_idx = func_p->offset_idx;
-  while (regu_idx > 0 && regulist != NULL)
-    {
-      regulist = regulist->next;
-      regu_idx--;
-    }
-  if (regulist == NULL)
-    {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_QPROC_INVALID_XASLNODE, 0);
-      return ER_FAILED;
-    }
+  SCAN_CODE sc = S_SUCCESS;
 
-  /* get target tuple index */
-  switch (func_p->function)
+  while (sc == S_SUCCESS && amount != 0)
     {
-    case PT_LEAD:
-    case PT_LAG:
-      dom_status = tp_value_coerce (regulist->value.vfetch_to, &offset_val, &tp_Integer_domain);
-      if (dom_status != DOMAIN_COMPATIBLE)
+      /* compute new position */
+      if (amount > 0)
 	{
-	  error = tp_domain_status_er_set (dom_status, ARG_FILE_LINE, regulist->value.vfetch_to, &tp_Integer_domain);
-	  if (error == NO_ERROR)
+	  if (max_group_changes <= 0 && func_state->group_tuple_position >= func_state->curr_group_tuple_count - 1)
 	    {
-	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_QUERY_EXECUTION_ERROR, 1, __LINE__);
-	      return ER_FAILED;
+	      /* already at end of group */
+	      break;
 	    }
-	  return error;
-	}
 
-      /* guard against NULL */
-      if (!DB_IS_NULL (&offset_val))
-	{
-	  target_idx = offset_val.data.i;
+	  func_state->sort_key_tuple_position++;
+	  func_state->group_tuple_position++;
 	}
       else
 	{
-	  target_idx = 0;
-	}
+	  if (max_group_changes <= 0 && func_state->group_tuple_position <= 0)
+	    {
+	      /* already at beginning of group */
+	      break;
+	    }
 
-      /* done with offset dbval */
-      pr_clear_value (&offset_val);
+	  func_state->sort_key_tuple_position--;
+	  func_state->group_tuple_position--;
+	}
 
-      if (func_p->function == PT_LEAD)
+      /* check for sort key header change */
+      if (func_state->sort_key_tuple_position < 0)
 	{
-	  target_idx = func_state->group_consumed_tuples + target_idx;
+	  /* load previous sort key header */
+	  sc = qfile_scan_list_prev (thread_p, &func_state->value_scan_id, &func_state->value_tplrec, PEEK);
+	  if (sc != S_SUCCESS)
+	    {
+	      return ER_FAILED;
+	    }
+	  if (qexec_analytic_sort_key_header_load (func_state, (-1 <= amount) && (amount <= 1)) != NO_ERROR)
+	    {
+	      return ER_FAILED;
+	    }
+
+	  /* initialize position to last */
+	  func_state->sort_key_tuple_position = func_state->curr_sort_key_tuple_count - 1;
 	}
-      else
+      else if (func_state->sort_key_tuple_position >= func_state->curr_sort_key_tuple_count)
 	{
-	  /* PT_LAG */
-	  target_idx = func_state->group_consumed_tuples - target_idx;
-	}
-      break;
+	  /* load next sort key header */
+	  sc = qfile_scan_list_next (thread_p, &func_state->value_scan_id, &func_state->value_tplrec, PEEK);
+	  if (sc != S_SUCCESS)
+	    {
+	      return ER_FAILED;
+	    }
+	  if (qexec_analytic_sort_key_header_load (func_state, (-1 <= amount) && (amount <= 1)) != NO_ERROR)
+	    {
+	      return ER_FAILED;
+	    }
 
-    case PT_NTH_VALUE:
-      dom_status = tp_value_coerce (regulist->value.vfetch_to, &offset_val, &tp_Double_domain);
-      if (dom_status != DOMAIN_COMPATIBLE)
-	{
-	  error = tp_domain_status_er_set (dom_status, ARG_FILE_LINE, regulist->value.vfetch_to, &tp_Double_domain);
-	  return error;
+	  /* reset position to first */
+	  func_state->sort_key_tuple_position = 0;
 	}
 
-      if (DB_IS_NULL (&offset_val))
+      /* check for group header change */
+      if (func_state->group_tuple_position < 0)
 	{
-	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_ARG_OUT_OF_RANGE, 1, "NULL");
-	  return ER_FAILED;
-	}
+	  /* load previous sort key header */
+	  sc = qfile_scan_list_prev (thread_p, &func_state->group_scan_id, &func_state->group_tplrec, PEEK);
+	  if (sc != S_SUCCESS)
+	    {
+	      return ER_FAILED;
+	    }
+	  if (qexec_analytic_group_header_load (func_state) != NO_ERROR)
+	    {
+	      return ER_FAILED;
+	    }
 
-      nth_idx = db_get_double (&offset_val);
+	  /* initialize position to last */
+	  func_state->group_tuple_position = func_state->curr_group_tuple_count - 1;
+	  func_state->group_tuple_position_nn = func_state->curr_group_tuple_count;
 
-      if (nth_idx < 1.0 || nth_idx > DB_INT32_MAX)
-	{
-	  sprintf (buf, "%.15g", nth_idx);
-	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_ARG_OUT_OF_RANGE, 1, buf);
-	  return ER_FAILED;
+	  /* decrement group change counter */
+	  max_group_changes--;
 	}
+      else if (func_state->group_tuple_position >= func_state->curr_group_tuple_count)
+	{
+	  /* load next sort key header */
+	  sc = qfile_scan_list_next (thread_p, &func_state->group_scan_id, &func_state->group_tplrec, PEEK);
+	  if (sc != S_SUCCESS)
+	    {
+	      return ER_FAILED;
+	    }
+	  if (qexec_analytic_group_header_load (func_state) != NO_ERROR)
+	    {
+	      return ER_FAILED;
+	    }
 
-      target_idx = (int) floor (nth_idx);
-      target_idx--;		/* SQL defines this index as starting with one */
+	  /* reset position to first */
+	  func_state->group_tuple_position = 0;
+	  func_state->group_tuple_position_nn = -1;
 
-      if (target_idx >= 0 && target_idx < group_tuple_count)
+	  /* decrement group change counter */
+	  max_group_changes--;
+	}
+
+      /* adjust amount */
+      if (amount > 0)
 	{
-	  if (func_p->from_last)
+	  if (!DB_IS_NULL (func_state->func_p->value))
 	    {
-	      target_idx = group_tuple_count - target_idx;
+	      func_state->group_tuple_position_nn++;
+	      amount--;
+	    }
+	  else
+	    {
+	      if (!ignore_nulls)
+		{
+		  amount--;
+		}
+	    }
+	}
+      else
+	{
+	  if (!DB_IS_NULL (func_state->func_p->value))
+	    {
+	      func_state->group_tuple_position_nn--;
+	      amount++;
+	    }
+	  else
+	    {
+	      if (!ignore_nulls)
+		{
+		  amount++;
+		}
 	    }
 	}
+    }
+
+  if (amount != 0)
+    {
+      /* target was not hit */
+      if (func_state->curr_group_tuple_count_nn == 0 && ignore_nulls)
+	{
+	  /* current group has only NULL values, so result will be NULL */
+	  return NO_ERROR;
+	}
       else
 	{
-	  target_idx = -1;
+	  /* true failure */
+	  return ER_FAILED;
 	}
-      break;
-
-    default:
-      /* switch should cover all cases */
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_QUERY_EXECUTION_ERROR, 1, __LINE__);
-      return ER_FAILED;
     }
+  else
+    {
+      /* target was hit */
+      return NO_ERROR;
+    }
+}
 
-  /* clean up */
-  pr_clear_value (&offset_val);
+/*
+ * qexec_analytic_value_lookup () - seek a position within the group and
+ *				    load sort key headers
+ *   returns: error code or NO_ERROR
+ *   thread_p(in): thread
+ *   func_state(in): function state
+ *   position(in): position to seek
+ *   ignore_nulls(in): if true, execution will skip NULL values
+ */
+static int
+qexec_analytic_value_lookup (THREAD_ENTRY * thread_p, ANALYTIC_FUNCTION_STATE * func_state, int position,
+			     bool ignore_nulls)
+{
+  int offset = position;
 
-  /* find defaultvalue reguvar and get dbvalue pointer */
-  regulist = analytic_state->a_regu_list;
-  regu_idx = func_p->default_idx;
-  while (regu_idx > 0 && regulist != NULL)
+  if (ignore_nulls)
     {
-      regulist = regulist->next;
-      regu_idx--;
+      offset -= func_state->group_tuple_position_nn;
     }
-  if (regulist == NULL)
+  else
     {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_QPROC_INVALID_XASLNODE, 0);
-      return ER_FAILED;
+      offset -= func_state->group_tuple_position;
     }
-  default_val_p = regulist->value.vfetch_to;
 
-  /* put value */
-  if (target_idx >= 0 && target_idx < group_tuple_count)
+  if (offset != 0)
     {
-      if (qexec_analytic_value_lookup (thread_p, func_state, target_idx, func_p->ignore_nulls) != NO_ERROR)
+      return qexec_analytic_value_advance (thread_p, func_state, offset, 0, ignore_nulls);
+    }
+  else
+    {
+      /* even if we didn't move the position, make sure value is there */
+      return qexec_analytic_sort_key_header_load (func_state, true);
+    }
+}
+
+/*
+ * qexec_analytic_group_header_next () - advance to next group
+ *   returns: error code or NO_ERROR
+ *   thread_p(in): thread
+ *   func_state(in): function state
+ */
+static int
+qexec_analytic_group_header_next (THREAD_ENTRY * thread_p, ANALYTIC_FUNCTION_STATE * func_state)
+{
+  int pos, count;
+
+  assert (func_state != NULL);
+
+  pos = func_state->group_tuple_position;
+  count = func_state->curr_group_tuple_count;
+
+  return qexec_analytic_value_advance (thread_p, func_state, count - pos, 1, false);
+}
+
+/*
+ * qexec_analytic_update_group_result () - update group result and add to
+ *                                         output file
+ *   return:
+ *   analytic_state(in):
+ *
+ *   Note: Scan the last group from intermediary file and add up to date
+ *         analytic result into output file
+ */
+static int
+qexec_analytic_update_group_result (THREAD_ENTRY * thread_p, ANALYTIC_STATE * analytic_state)
+{
+  QFILE_TUPLE_RECORD tplrec_scan, tplrec_write;
+  QFILE_LIST_SCAN_ID interm_scan_id;
+  XASL_STATE *xasl_state = analytic_state->xasl_state;
+  SCAN_CODE sc = S_SUCCESS;
+  int i, rc = NO_ERROR;
+
+  assert (analytic_state != NULL);
+
+  /* open scans on all result files */
+  for (i = 0; i < analytic_state->func_count; i++)
+    {
+      if (qfile_open_list_scan (analytic_state->func_state_list[i].group_list_id,
+				&analytic_state->func_state_list[i].group_scan_id) != NO_ERROR)
 	{
 	  return ER_FAILED;
 	}
-
-      if (func_p->function == PT_NTH_VALUE)
+      if (qfile_open_list_scan (analytic_state->func_state_list[i].value_list_id,
+				&analytic_state->func_state_list[i].value_scan_id) != NO_ERROR)
 	{
-	  /* when using ORDER BY on NTH_VALUE, value will be NULL until that value is reached */
-	  if ((func_p->sort_prefix_size != func_p->sort_list_size)
-	      && (func_state->group_consumed_tuples < func_state->group_tuple_position))
-	    {
-	      put_default = true;
-	    }
+	  qfile_close_scan (thread_p, &analytic_state->func_state_list[i].group_scan_id);
+	  return ER_FAILED;
 	}
+
+      /* initialize tuple counter so we do a result read right away */
+      analytic_state->func_state_list[i].curr_group_tuple_count = 0;
+      analytic_state->func_state_list[i].curr_group_tuple_count_nn = 0;
+      analytic_state->func_state_list[i].curr_sort_key_tuple_count = 0;
+      analytic_state->func_state_list[i].group_tuple_position = -1;
+      analytic_state->func_state_list[i].group_tuple_position_nn = -1;
+      analytic_state->func_state_list[i].sort_key_tuple_position = -1;
+      analytic_state->func_state_list[i].group_consumed_tuples = 0;
     }
-  else
+
+  /* open scan on intermediate file */
+  if (qfile_open_list_scan (analytic_state->interm_file, &interm_scan_id) != NO_ERROR)
     {
-      put_default = true;
+      qfile_close_scan (thread_p, &analytic_state->func_state_list[i].group_scan_id);
+      qfile_close_scan (thread_p, &analytic_state->func_state_list[i].value_scan_id);
+      return ER_FAILED;
     }
 
-  if (put_default)
+  /* we will use each func_state->value as a buffer to read values from the sort key headers, so make sure it points to
+   * the vallist in order to correctly output values */
+  for (i = 0; i < analytic_state->func_count; i++)
     {
-      /* coerce value to default domain */
-      dom_status = tp_value_coerce (default_val_p, &default_val, func_p->domain);
-      if (dom_status != DOMAIN_COMPATIBLE)
+      REGU_VARIABLE_LIST regu_list_p;
+      ANALYTIC_TYPE *func_p = analytic_state->func_state_list[i].func_p;
+      DB_VALUE *swap;
+
+      if (func_p->function != PT_ROW_NUMBER)
 	{
-	  error = tp_domain_status_er_set (dom_status, ARG_FILE_LINE, default_val_p, func_p->domain);
-	  if (error == NO_ERROR)
+	  swap = func_p->value;
+	  func_p->value = func_p->out_value;
+	  func_p->out_value = swap;
+
+	  /* also, don't fetch into value */
+	  for (regu_list_p = analytic_state->a_regu_list; regu_list_p != NULL; regu_list_p = regu_list_p->next)
 	    {
-	      return ER_FAILED;
+	      if (regu_list_p->value.vfetch_to == func_p->value)
+		{
+		  regu_list_p->value.vfetch_to = func_p->out_value;
+		  break;
+		}
 	    }
-	  return error;
 	}
-
-      /* put default value and clean up */
-      pr_clear_value (func_p->value);
-      pr_clone_value (&default_val, func_p->value);
-      pr_clear_value (&default_val);
     }
 
-  /* all ok */
-  return error;
-}
-
-/*
- * qexec_analytic_evaluate_cume_dist_percent_rank_function () -
- *                    evaluate CUME_DIST and PERCENT_RANK
- *   returns: error code or NO_ERROR
- *   thread(in):
- *   func_p(in/out):
- *   analytic_state(in):
- *   tuple_idx(in):
- */
-static int
-qexec_analytic_evaluate_cume_dist_percent_rank_function (THREAD_ENTRY * thread_p, ANALYTIC_FUNCTION_STATE * func_state)
-{
-  int start_of_group = func_state->group_tuple_position - func_state->sort_key_tuple_position;
-  int end_of_group =
-    func_state->group_tuple_position - func_state->sort_key_tuple_position + func_state->curr_sort_key_tuple_count;
+  /* initialize tuple record */
+  tplrec_scan.size = 0;
+  tplrec_scan.tpl = NULL;
+  tplrec_write.size = 0;
+  tplrec_write.tpl = NULL;
 
-  switch (func_state->func_p->function)
+  /* iterate files */
+  while (sc == S_SUCCESS)
     {
-    case PT_CUME_DIST:
-      db_make_double (func_state->func_p->value, (double) end_of_group / func_state->curr_group_tuple_count);
-      break;
+      /* read one tuple from intermediate file */
+      sc = qfile_scan_list_next (thread_p, &interm_scan_id, &tplrec_scan, PEEK);
+      if (sc == S_END)
+	{
+	  break;
+	}
+      else if (sc == S_ERROR)
+	{
+	  rc = ER_FAILED;
+	  goto cleanup;
+	}
 
-    case PT_PERCENT_RANK:
-      if (func_state->curr_group_tuple_count <= 1)
+      /* fetch values from intermediate file */
+      rc = fetch_val_list (thread_p, analytic_state->a_regu_list, &xasl_state->vd, NULL, NULL, tplrec_scan.tpl, PEEK);
+      if (rc != NO_ERROR)
 	{
-	  db_make_double (func_state->func_p->value, 0.0f);
+	  goto cleanup;
 	}
-      else
+
+      /* evaluate inst_num() predicate */
+      rc = qexec_analytic_eval_instnum_pred (thread_p, analytic_state, ANALYTIC_GROUP_PROC);
+      if (rc != NO_ERROR)
 	{
-	  db_make_double (func_state->func_p->value,
-			  (double) start_of_group / (func_state->curr_group_tuple_count - 1));
+	  goto cleanup;
 	}
-      break;
 
-    default:
-      return ER_FAILED;
-    }
+      /* handle functions */
+      for (i = 0; i < analytic_state->func_count; i++)
+	{
+	  ANALYTIC_FUNCTION_STATE *func_state = &analytic_state->func_state_list[i];
+	  ANALYTIC_TYPE *func_p = analytic_state->func_state_list[i].func_p;
+
+	  if (func_p->function == PT_ROW_NUMBER)
+	    {
+	      /* row number has already been computed and value was fetched from the intermediate file; nothing to do
+	       * here */
+	    }
+	  else if (QPROC_ANALYTIC_IS_OFFSET_FUNCTION (func_p))
+	    {
+	      if (func_state->group_tuple_position == -1 && func_state->sort_key_tuple_position == -1)
+		{
+		  /* first scan, load first value */
+		  rc = qexec_analytic_value_advance (thread_p, func_state, 1, 1, func_p->ignore_nulls);
+		  if (rc != NO_ERROR)
+		    {
+		      goto cleanup;
+		    }
+		}
+	      else if (func_state->group_consumed_tuples >= func_state->curr_group_tuple_count)
+		{
+		  /* advance to next group */
+		  rc = qexec_analytic_group_header_next (thread_p, func_state);
+		  if (rc != NO_ERROR)
+		    {
+		      goto cleanup;
+		    }
+		  func_state->group_consumed_tuples = 0;
+		}
+	    }
+	  else if (QPROC_IS_INTERPOLATION_FUNC (func_state->func_p))
+	    {
+	      /* MEDIAN, check for group end */
+	      if (func_state->group_consumed_tuples >= func_state->curr_group_tuple_count)
+		{
+		  /* advance to next group */
+		  rc = qexec_analytic_group_header_next (thread_p, func_state);
+		  if (rc != NO_ERROR)
+		    {
+		      goto cleanup;
+		    }
+		  func_state->group_consumed_tuples = 0;
+		}
+	    }
+	  else
+	    {
+	      bool ignore_nulls = func_p->ignore_nulls;
 
-  return NO_ERROR;
-}
+	      if (func_p->function == PT_FIRST_VALUE || func_p->function == PT_LAST_VALUE)
+		{
+		  /* for FIRST_VALUE and LAST_VALUE, the IGNORE NULLS logic resides at evaluation time */
+		  ignore_nulls = false;
+		}
 
-/*
- * qexec_analytic_evaluate_interpolation_function () -
- *
- *   returns: error code or NO_ERROR
- *   thread_p(in): current thread
- *   func_p(in): analytic function
- *   analytic_state(in): analytic state
- *   tuple_idx(in): current position of main scan in group
- */
-static int
-qexec_analytic_evaluate_interpolation_function (THREAD_ENTRY * thread_p, ANALYTIC_FUNCTION_STATE * func_state)
-{
-  ANALYTIC_TYPE *func_p = NULL;
-  double f_row_num_d, c_row_num_d, row_num_d, percentile_d;
-  int error = NO_ERROR;
-  DB_VALUE *peek_value_p = NULL;
+	      /* if the function does not seek results in the list file, we are in charge of advancing */
+	      rc = qexec_analytic_value_advance (thread_p, func_state, 1, 1, ignore_nulls);
+	      if (rc != NO_ERROR)
+		{
+		  goto cleanup;
+		}
+	    }
 
-  assert (func_state != NULL && func_state->func_p != NULL);
-  func_p = func_state->func_p;
-  assert (QPROC_IS_INTERPOLATION_FUNC (func_p));
+	  /* special behavior */
+	  switch (func_p->function)
+	    {
+	    case PT_LEAD:
+	    case PT_LAG:
+	    case PT_NTH_VALUE:
+	      if (analytic_state->is_output_rec)
+		{
+		  rc = qexec_analytic_evaluate_offset_function (thread_p, func_state, analytic_state);
+		  if (rc != NO_ERROR)
+		    {
+		      goto cleanup;
+		    }
+		}
+	      break;
 
-  /* MEDIAN function is evaluated at the start of the group */
-  if (func_state->group_tuple_position_nn > 0)
-    {
-      return NO_ERROR;
-    }
+	    case PT_NTILE:
+	      if (analytic_state->is_output_rec)
+		{
+		  rc = qexec_analytic_evaluate_ntile_function (thread_p, func_state);
+		  if (rc != NO_ERROR)
+		    {
+		      goto cleanup;
+		    }
+		}
+	      break;
 
-  /* constant operand case */
-  if (func_p->is_const_operand)
-    {
-      /* if constant operand, value has been established during evaluation and was fetched from intermediate file */
-      return NO_ERROR;
-    }
+	    case PT_CUME_DIST:
+	    case PT_PERCENT_RANK:
+	      rc = qexec_analytic_evaluate_cume_dist_percent_rank_function (thread_p, func_state);
+	      if (rc != NO_ERROR)
+		{
+		  goto cleanup;
+		}
+	      break;
 
-  /* zero non-NULL values in group */
-  if (func_state->curr_group_tuple_count_nn == 0)
-    {
-      return NO_ERROR;
-    }
+	    case PT_MEDIAN:
+	    case PT_PERCENTILE_CONT:
+	    case PT_PERCENTILE_DISC:
+	      rc = qexec_analytic_evaluate_interpolation_function (thread_p, func_state);
+	      if (rc != NO_ERROR)
+		{
+		  goto cleanup;
+		}
+	      break;
 
-  /* get target row */
-  if (func_p->function == PT_MEDIAN)
-    {
-      percentile_d = 0.5;
-    }
-  else
-    {
-      error =
-	fetch_peek_dbval (thread_p, func_p->info.percentile.percentile_reguvar, NULL, NULL, NULL, NULL, &peek_value_p);
-      if (error != NO_ERROR)
-	{
-	  assert (er_errid () != NO_ERROR);
+	    default:
+	      /* nothing to do */
+	      break;
+	    }
 
-	  return error;
+	  /* advance tuple index */
+	  func_state->group_consumed_tuples++;
 	}
 
-      assert (DB_VALUE_TYPE (peek_value_p) == DB_TYPE_DOUBLE);
-
-      percentile_d = db_get_double (peek_value_p);
-
-      if (func_p->function == PT_PERCENTILE_DISC)
+      if (analytic_state->is_output_rec)
 	{
-	  percentile_d =
-	    ceil (percentile_d * func_state->curr_group_tuple_count_nn) / func_state->curr_group_tuple_count_nn;
+	  /* add tuple to output file */
+	  rc =
+	    qexec_insert_tuple_into_list (thread_p, analytic_state->output_file, analytic_state->a_outptr_list,
+					  &xasl_state->vd, &tplrec_write);
+	  if (rc != NO_ERROR)
+	    {
+	      goto cleanup;
+	    }
 	}
     }
 
-  row_num_d = ((double) (func_state->curr_group_tuple_count_nn - 1)) * percentile_d;
-  f_row_num_d = floor (row_num_d);
-
-  if (func_p->function == PT_PERCENTILE_DISC)
-    {
-      c_row_num_d = f_row_num_d;
-    }
-  else
+cleanup:
+  /* undo the pointer swap we've done before */
+  for (i = 0; i < analytic_state->func_count; i++)
     {
-      c_row_num_d = ceil (row_num_d);
-    }
+      ANALYTIC_TYPE *func_p = analytic_state->func_state_list[i].func_p;
+      REGU_VARIABLE_LIST regu_list_p;
+      DB_VALUE *swap;
 
-  /* compute value */
-  if (f_row_num_d == c_row_num_d)
-    {
-      /* we have an odd number of rows, median is middle row's value; fetch it */
-      if (qexec_analytic_value_lookup (thread_p, func_state, (int) f_row_num_d, true) != NO_ERROR)
+      if (func_p->function != PT_ROW_NUMBER)
 	{
-	  return ER_FAILED;
+	  swap = func_p->value;
+	  func_p->value = func_p->out_value;
+	  func_p->out_value = swap;
 	}
 
-      /* coerce accordingly */
-      error =
-	qdata_apply_interpolation_function_coercion (func_p->value, &func_p->domain, func_p->value, func_p->function);
-      if (error != NO_ERROR)
+      for (regu_list_p = analytic_state->a_regu_list; regu_list_p != NULL; regu_list_p = regu_list_p->next)
 	{
-	  return error;
+	  if (regu_list_p->value.vfetch_to == func_p->value)
+	    {
+	      regu_list_p->value.vfetch_to = func_p->out_value;
+	      break;
+	    }
 	}
     }
-  else
-    {
-      DB_VALUE c_value, f_value;
-      db_make_null (&c_value);
-      db_make_null (&f_value);
-
-      if (qexec_analytic_value_lookup (thread_p, func_state, (int) f_row_num_d, true) != NO_ERROR)
-	{
-	  return ER_FAILED;
-	}
-      else
-	{
-	  pr_clone_value (func_p->value, &f_value);
-	}
 
-      if (qexec_analytic_value_lookup (thread_p, func_state, (int) c_row_num_d, true) != NO_ERROR)
-	{
-	  return ER_FAILED;
-	}
-      else
-	{
-	  pr_clone_value (func_p->value, &c_value);
-	}
+  /* free write tuple record */
+  if (tplrec_write.tpl != NULL)
+    {
+      db_private_free_and_init (thread_p, tplrec_write.tpl);
+      tplrec_write.size = 0;
+    }
 
-      pr_clear_value (func_p->value);
-      error =
-	qdata_interpolation_function_values (&f_value, &c_value, row_num_d, f_row_num_d, c_row_num_d, &func_p->domain,
-					     func_p->value, func_p->function);
-      if (error != NO_ERROR)
-	{
-	  return error;
-	}
+  /* close all scans */
+  qfile_close_scan (thread_p, &interm_scan_id);
+  for (i = 0; i < analytic_state->func_count; i++)
+    {
+      qfile_close_scan (thread_p, &analytic_state->func_state_list[i].group_scan_id);
+      qfile_close_scan (thread_p, &analytic_state->func_state_list[i].value_scan_id);
     }
 
   /* all ok */
-  return NO_ERROR;
+  return rc;
 }
 
 /*
- * qexec_analytic_group_header_load () - load group information from group list
- *					 file
- *   returns: error code or NO_ERROR
- *   func_state(in): function state
+ * qexec_clear_pred_context () - clear the predicate
+ *   return: int
+ *   pred_filter(in) : The filter predicate
+ *   dealloc_dbvalues(in): Deallocate db values from dbvalue regu variable
+ *
+ *  Note: Use an XASL_NODE to clear allocated memmory.
  */
-static int
-qexec_analytic_group_header_load (ANALYTIC_FUNCTION_STATE * func_state)
-{
-  QFILE_TUPLE tuple_p;
 
-  assert (func_state != NULL);
-
-  tuple_p = func_state->group_tplrec.tpl + QFILE_TUPLE_LENGTH_SIZE;
-
-  /* deserialize tuple count */
-  if (QFILE_GET_TUPLE_VALUE_FLAG (tuple_p) != V_BOUND)
-    {
-      return ER_FAILED;
-    }
-  tuple_p += QFILE_TUPLE_VALUE_HEADER_SIZE;
-  func_state->curr_group_tuple_count = OR_GET_INT (tuple_p);
-  tuple_p += DB_ALIGN (tp_Integer.disksize, MAX_ALIGNMENT);
+int
+qexec_clear_pred_context (THREAD_ENTRY * thread_p, pred_expr_with_context * pred_filter, bool dealloc_dbvalues)
+{
+  XASL_NODE xasl_node;
 
-  /* deserialize not-null tuple count */
-  if (QFILE_GET_TUPLE_VALUE_FLAG (tuple_p) != V_BOUND)
+  memset (&xasl_node, 0, sizeof (XASL_NODE));
+
+  if (dealloc_dbvalues)
     {
-      return ER_FAILED;
+      XASL_SET_FLAG (&xasl_node, XASL_DECACHE_CLONE);
     }
-  tuple_p += QFILE_TUPLE_VALUE_HEADER_SIZE;
-  func_state->curr_group_tuple_count_nn = OR_GET_INT (tuple_p);
 
-  /* all ok */
+  qexec_clear_pred (thread_p, &xasl_node, pred_filter->pred, true);
+
   return NO_ERROR;
 }
 
 /*
- * qexec_analytic_sort_key_header_load () - load sort key header from sort key
- *					    list file
- *   returns: error code or NO_ERROR
- *   func_state(in): function state
- *   load_value(in): if true, will load the actual value into func_p->value
+ * qexec_clear_func_pred () - clear the predicate
+ *   return: int
+ *   func_pred(in) : The function predicate
  *
- * NOTE: if repeated often, loading the actual value can be expensive, so make
- * sure you only set load_value when necessary.
+ *  Note: Use an XASL_NODE to clear allocated memmory.
  */
-static int
-qexec_analytic_sort_key_header_load (ANALYTIC_FUNCTION_STATE * func_state, bool load_value)
-{
-  QFILE_TUPLE tuple_p;
-  OR_BUF buf;
-  int length, rc = NO_ERROR;
-
-  assert (func_state != NULL);
 
-  tuple_p = func_state->value_tplrec.tpl + QFILE_TUPLE_LENGTH_SIZE;
+int
+qexec_clear_func_pred (THREAD_ENTRY * thread_p, func_pred * fpr)
+{
+  XASL_NODE xasl_node;
 
-  /* deserialize tuple count */
-  if (QFILE_GET_TUPLE_VALUE_FLAG (tuple_p) != V_BOUND)
-    {
-      return ER_FAILED;
-    }
-  tuple_p += QFILE_TUPLE_VALUE_HEADER_SIZE;
-  func_state->curr_sort_key_tuple_count = OR_GET_INT (tuple_p);
-  tuple_p += DB_ALIGN (tp_Integer.disksize, MAX_ALIGNMENT);
+  memset (&xasl_node, 0, sizeof (XASL_NODE));
 
-  if (!load_value && !func_state->func_p->ignore_nulls && !QPROC_IS_INTERPOLATION_FUNC (func_state->func_p))
-    {
-      /* we're not counting NULLs and we're not using the value */
-      return NO_ERROR;
-    }
+  (void) qexec_clear_regu_var (thread_p, &xasl_node, fpr->func_regu, true);
 
-  /* clear current value */
-  pr_clear_value (func_state->func_p->value);
+  return NO_ERROR;
+}
 
-  /* deserialize value */
-  if (QFILE_GET_TUPLE_VALUE_FLAG (tuple_p) == V_BOUND)
-    {
-      length = QFILE_GET_TUPLE_VALUE_LENGTH (tuple_p);
-      tuple_p += QFILE_TUPLE_VALUE_HEADER_SIZE;
-      OR_BUF_INIT (buf, tuple_p, length);
+/*
+ * qexec_clear_partition_expression () - clear partition expression
+ * return : cleared count or error code
+ * thread_p (in) :
+ * expr (in) :
+ */
+int
+qexec_clear_partition_expression (THREAD_ENTRY * thread_p, regu_variable_node * expr)
+{
+  XASL_NODE xasl_node;
 
-      rc =
-	func_state->func_p->domain->type->data_readval (&buf, func_state->func_p->value, func_state->func_p->domain, -1,
-							false, NULL, 0);
-      if (rc != NO_ERROR)
-	{
-	  return ER_FAILED;
-	}
-    }
-  else
-    {
-      db_make_null (func_state->func_p->value);
-    }
+  memset (&xasl_node, 0, sizeof (XASL_NODE));
+  qexec_clear_regu_var (thread_p, &xasl_node, expr, true);
 
-  /* all ok */
   return NO_ERROR;
 }
 
 /*
- * qexec_analytic_value_advance () - advance position in group/sort key list
- *				     files and load headers
- *   returns: error code or NO_ERROR
- *   thread_p(in): thread
- *   func_state(in): function state
- *   amount(in): amount to advance (can also be negative)
- *   max_group_changes(in): maximum number of group changes
- *   ignore_nulls(in): if true, execution will skip NULL values
+ * qexec_for_update_set_class_locks () - set X_LOCK on classes which will be
+ *					 updated and are accessed sequentially
+ * return : error code or NO_ERROR
+ * thread_p (in)  :
+ * scan_list (in) :
+ *
+ * Note: Used in SELECT ... FOR UPDATE
  */
 static int
-qexec_analytic_value_advance (THREAD_ENTRY * thread_p, ANALYTIC_FUNCTION_STATE * func_state, int amount,
-			      int max_group_changes, bool ignore_nulls)
+qexec_for_update_set_class_locks (THREAD_ENTRY * thread_p, XASL_NODE * scan_list)
 {
-  SCAN_CODE sc = S_SUCCESS;
+  XASL_NODE *scan = NULL;
+  ACCESS_SPEC_TYPE *specp = NULL;
+  OID *class_oid = NULL;
+  int error = NO_ERROR;
+  LOCK class_lock = IX_LOCK;	/* MVCC use IX_LOCK on class at update/delete */
 
-  while (sc == S_SUCCESS && amount != 0)
+  for (scan = scan_list; scan != NULL; scan = scan->scan_ptr)
     {
-      /* compute new position */
-      if (amount > 0)
-	{
-	  if (max_group_changes <= 0 && func_state->group_tuple_position >= func_state->curr_group_tuple_count - 1)
-	    {
-	      /* already at end of group */
-	      break;
-	    }
-
-	  func_state->sort_key_tuple_position++;
-	  func_state->group_tuple_position++;
-	}
-      else
-	{
-	  if (max_group_changes <= 0 && func_state->group_tuple_position <= 0)
-	    {
-	      /* already at beginning of group */
-	      break;
-	    }
-
-	  func_state->sort_key_tuple_position--;
-	  func_state->group_tuple_position--;
-	}
-
-      /* check for sort key header change */
-      if (func_state->sort_key_tuple_position < 0)
-	{
-	  /* load previous sort key header */
-	  sc = qfile_scan_list_prev (thread_p, &func_state->value_scan_id, &func_state->value_tplrec, PEEK);
-	  if (sc != S_SUCCESS)
-	    {
-	      return ER_FAILED;
-	    }
-	  if (qexec_analytic_sort_key_header_load (func_state, (-1 <= amount) && (amount <= 1)) != NO_ERROR)
-	    {
-	      return ER_FAILED;
-	    }
-
-	  /* initialize position to last */
-	  func_state->sort_key_tuple_position = func_state->curr_sort_key_tuple_count - 1;
-	}
-      else if (func_state->sort_key_tuple_position >= func_state->curr_sort_key_tuple_count)
+      for (specp = scan->spec_list; specp; specp = specp->next)
 	{
-	  /* load next sort key header */
-	  sc = qfile_scan_list_next (thread_p, &func_state->value_scan_id, &func_state->value_tplrec, PEEK);
-	  if (sc != S_SUCCESS)
-	    {
-	      return ER_FAILED;
-	    }
-	  if (qexec_analytic_sort_key_header_load (func_state, (-1 <= amount) && (amount <= 1)) != NO_ERROR)
+	  if (specp->type == TARGET_CLASS && (specp->flags & ACCESS_SPEC_FLAG_FOR_UPDATE))
 	    {
-	      return ER_FAILED;
-	    }
-
-	  /* reset position to first */
-	  func_state->sort_key_tuple_position = 0;
-	}
+	      class_oid = &specp->s.cls_node.cls_oid;
 
-      /* check for group header change */
-      if (func_state->group_tuple_position < 0)
-	{
-	  /* load previous sort key header */
-	  sc = qfile_scan_list_prev (thread_p, &func_state->group_scan_id, &func_state->group_tplrec, PEEK);
-	  if (sc != S_SUCCESS)
-	    {
-	      return ER_FAILED;
-	    }
-	  if (qexec_analytic_group_header_load (func_state) != NO_ERROR)
-	    {
-	      return ER_FAILED;
+	      /* lock the class */
+	      if (lock_object (thread_p, class_oid, oid_Root_class_oid, class_lock, LK_UNCOND_LOCK) != LK_GRANTED)
+		{
+		  assert (er_errid () != NO_ERROR);
+		  error = er_errid ();
+		  if (error == NO_ERROR)
+		    {
+		      error = ER_FAILED;
+		    }
+		  return error;
+		}
 	    }
-
-	  /* initialize position to last */
-	  func_state->group_tuple_position = func_state->curr_group_tuple_count - 1;
-	  func_state->group_tuple_position_nn = func_state->curr_group_tuple_count;
-
-	  /* decrement group change counter */
-	  max_group_changes--;
 	}
-      else if (func_state->group_tuple_position >= func_state->curr_group_tuple_count)
-	{
-	  /* load next sort key header */
-	  sc = qfile_scan_list_next (thread_p, &func_state->group_scan_id, &func_state->group_tplrec, PEEK);
-	  if (sc != S_SUCCESS)
-	    {
-	      return ER_FAILED;
-	    }
-	  if (qexec_analytic_group_header_load (func_state) != NO_ERROR)
-	    {
-	      return ER_FAILED;
-	    }
+    }
 
-	  /* reset position to first */
-	  func_state->group_tuple_position = 0;
-	  func_state->group_tuple_position_nn = -1;
+  return error;
+}
 
-	  /* decrement group change counter */
-	  max_group_changes--;
-	}
+/*
+ * qexec_set_class_locks () - set X_LOCK on classes which will be updated and
+ *			      are accessed sequentially and IX_LOCK on updated
+ *			      classes which are accessed through an index
+ *
+ * return : error code or NO_ERROR
+ * thread_p (in)  :
+ * xasl (in)	  :
+ * query_classes (in) : query classes
+ * internal_classes (in) : internal classes
+ * count (in)	  :
+ */
+static int
+qexec_set_class_locks (THREAD_ENTRY * thread_p, XASL_NODE * aptr_list, UPDDEL_CLASS_INFO * query_classes,
+		       int query_classes_count, UPDDEL_CLASS_INFO_INTERNAL * internal_classes)
+{
+  XASL_NODE *aptr = NULL;
+  ACCESS_SPEC_TYPE *specp = NULL;
+  OID *class_oid = NULL;
+  int i, j, error = NO_ERROR;
+  UPDDEL_CLASS_INFO *query_class = NULL;
+  bool found = false;
+  LOCK class_lock = IX_LOCK;	/* MVCC use IX_LOCK on class at update/delete */
 
-      /* adjust amount */
-      if (amount > 0)
-	{
-	  if (!DB_IS_NULL (func_state->func_p->value))
-	    {
-	      func_state->group_tuple_position_nn++;
-	      amount--;
-	    }
-	  else
+  for (aptr = aptr_list; aptr != NULL; aptr = aptr->scan_ptr)
+    {
+      for (specp = aptr->spec_list; specp; specp = specp->next)
+	{
+	  if (specp->type == TARGET_SET)
 	    {
-	      if (!ignore_nulls)
+	      /* lock all update classes */
+
+	      assert (specp->access == ACCESS_METHOD_SEQUENTIAL);
+
+	      for (i = 0; i < query_classes_count; i++)
 		{
-		  amount--;
+		  query_class = &query_classes[i];
+
+		  /* search class_oid through subclasses of a query class */
+		  for (j = 0; j < query_class->num_subclasses; j++)
+		    {
+		      class_oid = &query_class->class_oid[j];
+
+		      if (lock_object (thread_p, class_oid, oid_Root_class_oid, class_lock, LK_UNCOND_LOCK) !=
+			  LK_GRANTED)
+			{
+			  assert (er_errid () != NO_ERROR);
+			  error = er_errid ();
+			  if (error == NO_ERROR)
+			    {
+			      error = ER_FAILED;
+			    }
+			  return error;
+			}
+		    }
 		}
+
+	      return error;
 	    }
-	}
-      else
-	{
-	  if (!DB_IS_NULL (func_state->func_p->value))
-	    {
-	      func_state->group_tuple_position_nn--;
-	      amount++;
-	    }
-	  else
+
+	  if (specp->type == TARGET_CLASS)
 	    {
-	      if (!ignore_nulls)
+	      class_oid = &specp->s.cls_node.cls_oid;
+	      found = false;
+
+	      /* search through query classes */
+	      for (i = 0; i < query_classes_count && !found; i++)
 		{
-		  amount++;
+		  query_class = &query_classes[i];
+
+		  /* search class_oid through subclasses of a query class */
+		  for (j = 0; j < query_class->num_subclasses; j++)
+		    {
+		      if (OID_EQ (&query_class->class_oid[j], class_oid))
+			{
+			  /* lock the class */
+			  if (lock_object (thread_p, class_oid, oid_Root_class_oid, class_lock, LK_UNCOND_LOCK) !=
+			      LK_GRANTED)
+			    {
+			      assert (er_errid () != NO_ERROR);
+			      error = er_errid ();
+			      if (error == NO_ERROR)
+				{
+				  error = ER_FAILED;
+				}
+			      return error;
+			    }
+
+			  found = true;
+			  break;
+			}
+		    }
 		}
 	    }
 	}
     }
 
-  if (amount != 0)
+  return error;
+}
+
+/*
+ * qexec_execute_build_indexes () - Execution function for BUILD SCHEMA proc
+ *   return: NO_ERROR, or ER_code
+ *   xasl(in): XASL tree
+ *   xasl_state(in): XASL state
+ */
+static int
+qexec_execute_build_indexes (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state)
+{
+  QFILE_TUPLE_RECORD tplrec = { NULL, 0 };
+  int idx_incache = -1;
+  REPR_ID class_repr_id = NULL_REPRID;
+  OR_CLASSREP *rep = NULL;
+  OR_INDEX *index = NULL;
+  OR_ATTRIBUTE *index_att = NULL;
+  int att_id = 0;
+  char *attr_name = NULL, *string = NULL;
+  OR_ATTRIBUTE *attrepr = NULL;
+  DB_VALUE **out_values = NULL;
+  REGU_VARIABLE_LIST regu_var_p;
+  char **attr_names = NULL;
+  int *attr_ids = NULL;
+  int function_asc_desc;
+  HEAP_SCANCACHE scan;
+  bool scancache_inited = false;
+  RECDES class_record;
+  DISK_REPR *disk_repr_p = NULL;
+  char *class_name = NULL;
+  int non_unique;
+  int cardinality;
+  OID *class_oid = NULL;
+  OID dir_oid;
+  int i, j, k;
+  int error = NO_ERROR;
+  int function_index_pos = -1;
+  int index_position = 0, size_values = 0;
+  int num_idx_att = 0;
+  char *comment = NULL;
+  int alloced_string = 0;
+  HL_HEAPID save_heapid = 0;
+  CATALOG_ACCESS_INFO catalog_access_info = CATALOG_ACCESS_INFO_INITIALIZER;
+
+  assert (xasl != NULL && xasl_state != NULL);
+
+  for (regu_var_p = xasl->outptr_list->valptrp, i = 0; regu_var_p; regu_var_p = regu_var_p->next, i++)
     {
-      /* target was not hit */
-      if (func_state->curr_group_tuple_count_nn == 0 && ignore_nulls)
-	{
-	  /* current group has only NULL values, so result will be NULL */
-	  return NO_ERROR;
-	}
-      else
+      if (REGU_VARIABLE_IS_FLAGED (&regu_var_p->value, REGU_VARIABLE_CLEAR_AT_CLONE_DECACHE))
 	{
-	  /* true failure */
-	  return ER_FAILED;
+	  save_heapid = db_change_private_heap (thread_p, 0);
+	  break;
 	}
     }
-  else
+  if (qexec_start_mainblock_iterations (thread_p, xasl, xasl_state) != NO_ERROR)
     {
-      /* target was hit */
-      return NO_ERROR;
+      GOTO_EXIT_ON_ERROR;
     }
-}
 
-/*
- * qexec_analytic_value_lookup () - seek a position within the group and
- *				    load sort key headers
- *   returns: error code or NO_ERROR
- *   thread_p(in): thread
- *   func_state(in): function state
- *   position(in): position to seek
- *   ignore_nulls(in): if true, execution will skip NULL values
- */
-static int
-qexec_analytic_value_lookup (THREAD_ENTRY * thread_p, ANALYTIC_FUNCTION_STATE * func_state, int position,
-			     bool ignore_nulls)
-{
-  int offset = position;
+  assert (xasl_state != NULL);
+  class_oid = &(xasl->spec_list->s.cls_node.cls_oid);
 
-  if (ignore_nulls)
+  /* get class disk representation */
+  if (catalog_get_dir_oid_from_cache (thread_p, class_oid, &dir_oid) != NO_ERROR)
     {
-      offset -= func_state->group_tuple_position_nn;
+      ASSERT_ERROR_AND_SET (error);
+      GOTO_EXIT_ON_ERROR;
     }
-  else
+
+  catalog_access_info.class_oid = class_oid;
+  catalog_access_info.dir_oid = &dir_oid;
+  if (catalog_start_access_with_dir_oid (thread_p, &catalog_access_info, S_LOCK) != NO_ERROR)
     {
-      offset -= func_state->group_tuple_position;
+      ASSERT_ERROR_AND_SET (error);
+      (void) catalog_end_access_with_dir_oid (thread_p, &catalog_access_info, error);
+      GOTO_EXIT_ON_ERROR;
     }
 
-  if (offset != 0)
+  error = catalog_get_last_representation_id (thread_p, class_oid, &class_repr_id);
+  if (error != NO_ERROR)
     {
-      return qexec_analytic_value_advance (thread_p, func_state, offset, 0, ignore_nulls);
+      (void) catalog_end_access_with_dir_oid (thread_p, &catalog_access_info, error);
+      GOTO_EXIT_ON_ERROR;
     }
-  else
+
+  disk_repr_p = catalog_get_representation (thread_p, class_oid, class_repr_id, &catalog_access_info);
+  if (disk_repr_p == NULL)
     {
-      /* even if we didn't move the position, make sure value is there */
-      return qexec_analytic_sort_key_header_load (func_state, true);
+      ASSERT_ERROR_AND_SET (error);
+      (void) catalog_end_access_with_dir_oid (thread_p, &catalog_access_info, error);
+      GOTO_EXIT_ON_ERROR;
     }
-}
 
-/*
- * qexec_analytic_group_header_next () - advance to next group
- *   returns: error code or NO_ERROR
- *   thread_p(in): thread
- *   func_state(in): function state
- */
-static int
-qexec_analytic_group_header_next (THREAD_ENTRY * thread_p, ANALYTIC_FUNCTION_STATE * func_state)
-{
-  int pos, count;
+  (void) catalog_end_access_with_dir_oid (thread_p, &catalog_access_info, NO_ERROR);
 
-  assert (func_state != NULL);
+  /* read heap class record, get class representation */
+  heap_scancache_quick_start_root_hfid (thread_p, &scan);
+  scancache_inited = true;
 
-  pos = func_state->group_tuple_position;
-  count = func_state->curr_group_tuple_count;
+  if (heap_get_class_record (thread_p, class_oid, &class_record, &scan, PEEK) != S_SUCCESS)
+    {
+      GOTO_EXIT_ON_ERROR;
+    }
 
-  return qexec_analytic_value_advance (thread_p, func_state, count - pos, 1, false);
-}
+  rep = heap_classrepr_get (thread_p, class_oid, &class_record, class_repr_id, &idx_incache);
+  if (rep == NULL)
+    {
+      GOTO_EXIT_ON_ERROR;
+    }
 
-/*
- * qexec_analytic_update_group_result () - update group result and add to
- *                                         output file
- *   return:
- *   analytic_state(in):
- *
- *   Note: Scan the last group from intermediary file and add up to date
- *         analytic result into output file
- */
-static int
-qexec_analytic_update_group_result (THREAD_ENTRY * thread_p, ANALYTIC_STATE * analytic_state)
-{
-  QFILE_TUPLE_RECORD tplrec_scan, tplrec_write;
-  QFILE_LIST_SCAN_ID interm_scan_id;
-  XASL_STATE *xasl_state = analytic_state->xasl_state;
-  SCAN_CODE sc = S_SUCCESS;
-  int i, rc = NO_ERROR;
+  size_values = xasl->outptr_list->valptr_cnt;
+  assert (size_values == 14);
+  out_values = (DB_VALUE **) malloc (size_values * sizeof (DB_VALUE *));
+  if (out_values == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, size_values * sizeof (DB_VALUE *));
+      error = ER_OUT_OF_VIRTUAL_MEMORY;
+      GOTO_EXIT_ON_ERROR;
+    }
+
+  for (regu_var_p = xasl->outptr_list->valptrp, i = 0; regu_var_p; regu_var_p = regu_var_p->next, i++)
+    {
+      out_values[i] = &(regu_var_p->value.value.dbval);
+      pr_clear_value (out_values[i]);
+    }
+
+  attr_names = (char **) malloc (rep->n_attributes * sizeof (char *));
+  if (attr_names == NULL)
+    {
+      GOTO_EXIT_ON_ERROR;
+    }
+
+  attr_ids = (int *) malloc (rep->n_attributes * sizeof (int));
+  if (attr_ids == NULL)
+    {
+      GOTO_EXIT_ON_ERROR;
+    }
 
-  assert (analytic_state != NULL);
+  for (i = 0; i < rep->n_attributes; i++)
+    {
+      attr_names[i] = NULL;
+      attr_ids[i] = -1;
+    }
 
-  /* open scans on all result files */
-  for (i = 0; i < analytic_state->func_count; i++)
+  for (i = 0, attrepr = rep->attributes; i < rep->n_attributes; i++, attrepr++)
     {
-      if (qfile_open_list_scan (analytic_state->func_state_list[i].group_list_id,
-				&analytic_state->func_state_list[i].group_scan_id) != NO_ERROR)
+      string = NULL;
+      alloced_string = 0;
+
+      error = or_get_attrname (&class_record, attrepr->id, &string, &alloced_string);
+      if (error != NO_ERROR)
 	{
-	  return ER_FAILED;
+	  ASSERT_ERROR ();
+	  GOTO_EXIT_ON_ERROR;
 	}
-      if (qfile_open_list_scan (analytic_state->func_state_list[i].value_list_id,
-				&analytic_state->func_state_list[i].value_scan_id) != NO_ERROR)
+
+      attr_name = string;
+      if (attr_name == NULL)
 	{
-	  qfile_close_scan (thread_p, &analytic_state->func_state_list[i].group_scan_id);
-	  return ER_FAILED;
+	  continue;
 	}
 
-      /* initialize tuple counter so we do a result read right away */
-      analytic_state->func_state_list[i].curr_group_tuple_count = 0;
-      analytic_state->func_state_list[i].curr_group_tuple_count_nn = 0;
-      analytic_state->func_state_list[i].curr_sort_key_tuple_count = 0;
-      analytic_state->func_state_list[i].group_tuple_position = -1;
-      analytic_state->func_state_list[i].group_tuple_position_nn = -1;
-      analytic_state->func_state_list[i].sort_key_tuple_position = -1;
-      analytic_state->func_state_list[i].group_consumed_tuples = 0;
-    }
+      attr_names[i] = strdup (attr_name);
+      attr_ids[i] = attrepr->id;
 
-  /* open scan on intermediate file */
-  if (qfile_open_list_scan (analytic_state->interm_file, &interm_scan_id) != NO_ERROR)
-    {
-      qfile_close_scan (thread_p, &analytic_state->func_state_list[i].group_scan_id);
-      qfile_close_scan (thread_p, &analytic_state->func_state_list[i].value_scan_id);
-      return ER_FAILED;
+      if (string != NULL && alloced_string == 1)
+	{
+	  db_private_free_and_init (thread_p, string);
+	}
     }
 
-  /* we will use each func_state->value as a buffer to read values from the sort key headers, so make sure it points to
-   * the vallist in order to correctly output values */
-  for (i = 0; i < analytic_state->func_count; i++)
+  class_name = or_class_name (&class_record);
+  for (i = 0; i < rep->n_indexes; i++)
     {
-      REGU_VARIABLE_LIST regu_list_p;
-      ANALYTIC_TYPE *func_p = analytic_state->func_state_list[i].func_p;
-      DB_VALUE *swap;
+      /* class name */
+      db_make_string (out_values[0], class_name);
 
-      if (func_p->function != PT_ROW_NUMBER)
-	{
-	  swap = func_p->value;
-	  func_p->value = func_p->out_value;
-	  func_p->out_value = swap;
+      /* packed */
+      db_make_null (out_values[8]);
 
-	  /* also, don't fetch into value */
-	  for (regu_list_p = analytic_state->a_regu_list; regu_list_p != NULL; regu_list_p = regu_list_p->next)
-	    {
-	      if (regu_list_p->value.vfetch_to == func_p->value)
-		{
-		  regu_list_p->value.vfetch_to = func_p->out_value;
-		  break;
-		}
-	    }
-	}
-    }
+      /* index type */
+      db_make_string (out_values[10], "BTREE");
 
-  /* initialize tuple record */
-  tplrec_scan.size = 0;
-  tplrec_scan.tpl = NULL;
-  tplrec_write.size = 0;
-  tplrec_write.tpl = NULL;
+      index = rep->indexes + i;
+      /* Non_unique */
+      non_unique = btree_is_unique_type (index->type) ? 0 : 1;
+      db_make_int (out_values[1], non_unique);
 
-  /* iterate files */
-  while (sc == S_SUCCESS)
-    {
-      /* read one tuple from intermediate file */
-      sc = qfile_scan_list_next (thread_p, &interm_scan_id, &tplrec_scan, PEEK);
-      if (sc == S_END)
+      /* Key_name */
+      db_make_string (out_values[2], index->btname);
+
+      /* Func */
+      db_make_null (out_values[11]);
+
+      /* Comment */
+      comment = (char *) or_get_constraint_comment (&class_record, index->btname);
+      db_make_string (out_values[12], comment);
+
+      /* Visible */
+      db_make_string (out_values[13], (index->index_status == OR_NORMAL_INDEX) ? "YES" : "NO");
+
+      if (index->func_index_info == NULL)
 	{
-	  break;
+	  function_index_pos = -1;
+	  num_idx_att = index->n_atts;
 	}
-      else if (sc == S_ERROR)
+      else
 	{
-	  rc = ER_FAILED;
-	  goto cleanup;
+	  function_index_pos = index->func_index_info->col_id;
+	  /* do not count function attributes function attributes are positioned after index attributes at the end of
+	   * index->atts array */
+	  num_idx_att = index->func_index_info->attr_index_start;
 	}
 
-      /* fetch values from intermediate file */
-      rc = fetch_val_list (thread_p, analytic_state->a_regu_list, &xasl_state->vd, NULL, NULL, tplrec_scan.tpl, PEEK);
-      if (rc != NO_ERROR)
+      /* index attributes */
+      index_position = 0;
+      for (j = 0; j < num_idx_att; j++)
 	{
-	  goto cleanup;
-	}
+	  index_att = index->atts[j];
+	  att_id = index_att->id;
+	  assert (att_id >= 0);
 
-      /* evaluate inst_num() predicate */
-      rc = qexec_analytic_eval_instnum_pred (thread_p, analytic_state, ANALYTIC_GROUP_PROC);
-      if (rc != NO_ERROR)
-	{
-	  goto cleanup;
-	}
+	  if (index_position == function_index_pos)
+	    {
+	      /* function position in index founded, compute attribute position in index */
+	      index_position++;
+	    }
 
-      /* handle functions */
-      for (i = 0; i < analytic_state->func_count; i++)
-	{
-	  ANALYTIC_FUNCTION_STATE *func_state = &analytic_state->func_state_list[i];
-	  ANALYTIC_TYPE *func_p = analytic_state->func_state_list[i].func_p;
+	  /* Seq_in_index */
+	  db_make_int (out_values[3], index_position + 1);
 
-	  if (func_p->function == PT_ROW_NUMBER)
+	  /* Collation */
+	  if (index->asc_desc[j])
 	    {
-	      /* row number has already been computed and value was fetched from the intermediate file; nothing to do
-	       * here */
+	      db_make_string (out_values[5], "D");
 	    }
-	  else if (QPROC_ANALYTIC_IS_OFFSET_FUNCTION (func_p))
+	  else
 	    {
-	      if (func_state->group_tuple_position == -1 && func_state->sort_key_tuple_position == -1)
-		{
-		  /* first scan, load first value */
-		  rc = qexec_analytic_value_advance (thread_p, func_state, 1, 1, func_p->ignore_nulls);
-		  if (rc != NO_ERROR)
-		    {
-		      goto cleanup;
-		    }
-		}
-	      else if (func_state->group_consumed_tuples >= func_state->curr_group_tuple_count)
-		{
-		  /* advance to next group */
-		  rc = qexec_analytic_group_header_next (thread_p, func_state);
-		  if (rc != NO_ERROR)
-		    {
-		      goto cleanup;
-		    }
-		  func_state->group_consumed_tuples = 0;
-		}
+	      db_make_string (out_values[5], "A");
 	    }
-	  else if (QPROC_IS_INTERPOLATION_FUNC (func_state->func_p))
+
+	  /* Cardinality */
+	  if (catalog_get_cardinality (thread_p, class_oid, disk_repr_p, &index->btid, index_position, &cardinality) !=
+	      NO_ERROR)
 	    {
-	      /* MEDIAN, check for group end */
-	      if (func_state->group_consumed_tuples >= func_state->curr_group_tuple_count)
-		{
-		  /* advance to next group */
-		  rc = qexec_analytic_group_header_next (thread_p, func_state);
-		  if (rc != NO_ERROR)
-		    {
-		      goto cleanup;
-		    }
-		  func_state->group_consumed_tuples = 0;
-		}
+	      GOTO_EXIT_ON_ERROR;
+	    }
+
+	  if (cardinality < 0)
+	    {
+	      db_make_null (out_values[6]);
 	    }
 	  else
 	    {
-	      bool ignore_nulls = func_p->ignore_nulls;
+	      db_make_int (out_values[6], cardinality);
+	    }
 
-	      if (func_p->function == PT_FIRST_VALUE || func_p->function == PT_LAST_VALUE)
-		{
-		  /* for FIRST_VALUE and LAST_VALUE, the IGNORE NULLS logic resides at evaluation time */
-		  ignore_nulls = false;
-		}
+	  /* Sub_part */
+	  if (index->attrs_prefix_length && index->attrs_prefix_length[j] > -1)
+	    {
+	      db_make_int (out_values[7], index->attrs_prefix_length[j]);
+	    }
+	  else
+	    {
+	      db_make_null (out_values[7]);
+	    }
 
-	      /* if the function does not seek results in the list file, we are in charge of advancing */
-	      rc = qexec_analytic_value_advance (thread_p, func_state, 1, 1, ignore_nulls);
-	      if (rc != NO_ERROR)
+	  /* [Null] */
+	  if (index_att->is_notnull)
+	    {
+	      db_make_string (out_values[9], "NO");
+	    }
+	  else
+	    {
+	      db_make_string (out_values[9], "YES");
+	    }
+
+	  /* Column_name */
+	  for (k = 0; k < rep->n_attributes; k++)
+	    {
+	      if (att_id == attr_ids[k])
 		{
-		  goto cleanup;
+		  db_make_string (out_values[4], attr_names[k]);
+		  qexec_end_one_iteration (thread_p, xasl, xasl_state, &tplrec);
+		  break;
 		}
 	    }
 
-	  /* special behavior */
-	  switch (func_p->function)
+	  /* clear alloced DB_VALUEs */
+	  pr_clear_value (out_values[5]);
+	  pr_clear_value (out_values[9]);
+
+	  index_position++;
+	}
+
+      /* function index */
+      if (function_index_pos >= 0)
+	{
+	  /* Func */
+	  db_make_string (out_values[11], index->func_index_info->expr_string);
+
+	  /* Collation */
+	  if (btree_get_asc_desc (thread_p, &index->btid, function_index_pos, &function_asc_desc) != NO_ERROR)
+	    {
+	      GOTO_EXIT_ON_ERROR;
+	    }
+
+	  if (function_asc_desc)
 	    {
-	    case PT_LEAD:
-	    case PT_LAG:
-	    case PT_NTH_VALUE:
-	      if (analytic_state->is_output_rec)
-		{
-		  rc = qexec_analytic_evaluate_offset_function (thread_p, func_state, analytic_state);
-		  if (rc != NO_ERROR)
-		    {
-		      goto cleanup;
-		    }
-		}
-	      break;
-
-	    case PT_NTILE:
-	      if (analytic_state->is_output_rec)
-		{
-		  rc = qexec_analytic_evaluate_ntile_function (thread_p, func_state);
-		  if (rc != NO_ERROR)
-		    {
-		      goto cleanup;
-		    }
-		}
-	      break;
+	      db_make_string (out_values[5], "D");
+	    }
+	  else
+	    {
+	      db_make_string (out_values[5], "A");
+	    }
 
-	    case PT_CUME_DIST:
-	    case PT_PERCENT_RANK:
-	      rc = qexec_analytic_evaluate_cume_dist_percent_rank_function (thread_p, func_state);
-	      if (rc != NO_ERROR)
-		{
-		  goto cleanup;
-		}
-	      break;
+	  /* Seq_in_index */
+	  db_make_int (out_values[3], function_index_pos + 1);
 
-	    case PT_MEDIAN:
-	    case PT_PERCENTILE_CONT:
-	    case PT_PERCENTILE_DISC:
-	      rc = qexec_analytic_evaluate_interpolation_function (thread_p, func_state);
-	      if (rc != NO_ERROR)
-		{
-		  goto cleanup;
-		}
-	      break;
+	  /* Cardinality */
+	  if (catalog_get_cardinality (thread_p, class_oid, disk_repr_p, &index->btid, function_index_pos, &cardinality)
+	      != NO_ERROR)
+	    {
+	      GOTO_EXIT_ON_ERROR;
+	    }
 
-	    default:
-	      /* nothing to do */
-	      break;
+	  if (cardinality < 0)
+	    {
+	      db_make_null (out_values[6]);
+	    }
+	  else
+	    {
+	      db_make_int (out_values[6], cardinality);
 	    }
 
-	  /* advance tuple index */
-	  func_state->group_consumed_tuples++;
+	  /* Sub_part */
+	  db_make_null (out_values[7]);
+
+	  /* [Null] */
+	  db_make_string (out_values[9], "YES");
+
+	  /* Column_name */
+	  db_make_null (out_values[4]);
+	  qexec_end_one_iteration (thread_p, xasl, xasl_state, &tplrec);
 	}
 
-      if (analytic_state->is_output_rec)
+      if (comment != NULL)
 	{
-	  /* add tuple to output file */
-	  rc =
-	    qexec_insert_tuple_into_list (thread_p, analytic_state->output_file, analytic_state->a_outptr_list,
-					  &xasl_state->vd, &tplrec_write);
-	  if (rc != NO_ERROR)
-	    {
-	      goto cleanup;
-	    }
+	  free_and_init (comment);
+	}
+
+      /* needs to clear db_value content if is allocated during qexec_end_one_iteration */
+      for (j = 0; j < size_values; j++)
+	{
+	  pr_clear_value (out_values[j]);
 	}
     }
 
-cleanup:
-  /* undo the pointer swap we've done before */
-  for (i = 0; i < analytic_state->func_count; i++)
+  for (i = 0; i < rep->n_attributes; i++)
     {
-      ANALYTIC_TYPE *func_p = analytic_state->func_state_list[i].func_p;
-      REGU_VARIABLE_LIST regu_list_p;
-      DB_VALUE *swap;
-
-      if (func_p->function != PT_ROW_NUMBER)
+      if (attr_names[i] != NULL)
 	{
-	  swap = func_p->value;
-	  func_p->value = func_p->out_value;
-	  func_p->out_value = swap;
+	  free_and_init (attr_names[i]);
 	}
+    }
 
-      for (regu_list_p = analytic_state->a_regu_list; regu_list_p != NULL; regu_list_p = regu_list_p->next)
+  free_and_init (out_values);
+  free_and_init (attr_ids);
+  free_and_init (attr_names);
+
+  catalog_free_representation_and_init (disk_repr_p);
+  heap_classrepr_free_and_init (rep, &idx_incache);
+  if (heap_scancache_end (thread_p, &scan) != NO_ERROR)
+    {
+      GOTO_EXIT_ON_ERROR;
+    }
+  scancache_inited = false;
+
+  if (qexec_end_mainblock_iterations (thread_p, xasl, xasl_state, &tplrec) != NO_ERROR)
+    {
+      GOTO_EXIT_ON_ERROR;
+    }
+
+  if ((xasl->orderby_list	/* it has ORDER BY clause */
+       && (!XASL_IS_FLAGED (xasl, XASL_SKIP_ORDERBY_LIST)	/* cannot skip */
+	   || XASL_IS_FLAGED (xasl, XASL_USES_MRO))	/* MRO must go on */
+       && (xasl->list_id->tuple_cnt > 1	/* the result has more than one tuple */
+	   || xasl->ordbynum_val != NULL))	/* ORDERBY_NUM() is used */
+      || (xasl->option == Q_DISTINCT))	/* DISTINCT must go on */
+    {
+      if (qexec_orderby_distinct (thread_p, xasl, xasl->option, xasl_state) != NO_ERROR)
 	{
-	  if (regu_list_p->value.vfetch_to == func_p->value)
-	    {
-	      regu_list_p->value.vfetch_to = func_p->out_value;
-	      break;
-	    }
+	  GOTO_EXIT_ON_ERROR;
 	}
     }
 
-  /* free write tuple record */
-  if (tplrec_write.tpl != NULL)
+  if (tplrec.tpl)
     {
-      db_private_free_and_init (thread_p, tplrec_write.tpl);
-      tplrec_write.size = 0;
+      db_private_free_and_init (thread_p, tplrec.tpl);
     }
 
-  /* close all scans */
-  qfile_close_scan (thread_p, &interm_scan_id);
-  for (i = 0; i < analytic_state->func_count; i++)
+  if (save_heapid != 0)
     {
-      qfile_close_scan (thread_p, &analytic_state->func_state_list[i].group_scan_id);
-      qfile_close_scan (thread_p, &analytic_state->func_state_list[i].value_scan_id);
+      (void) db_change_private_heap (thread_p, save_heapid);
+      save_heapid = 0;
     }
 
-  /* all ok */
-  return rc;
-}
-
-/*
- * qexec_clear_pred_context () - clear the predicate
- *   return: int
- *   pred_filter(in) : The filter predicate
- *   dealloc_dbvalues(in): Deallocate db values from dbvalue regu variable
- *
- *  Note: Use an XASL_NODE to clear allocated memmory.
- */
+  return NO_ERROR;
 
-int
-qexec_clear_pred_context (THREAD_ENTRY * thread_p, pred_expr_with_context * pred_filter, bool dealloc_dbvalues)
-{
-  XASL_NODE xasl_node;
+exit_on_error:
 
-  memset (&xasl_node, 0, sizeof (XASL_NODE));
+  if (out_values)
+    {
+      for (i = 0; i < size_values; i++)
+	{
+	  pr_clear_value (out_values[i]);
+	}
 
-  if (dealloc_dbvalues)
+      free_and_init (out_values);
+    }
+  if (attr_ids)
     {
-      XASL_SET_FLAG (&xasl_node, XASL_DECACHE_CLONE);
+      free_and_init (attr_ids);
+    }
+  if (attr_names)
+    {
+      for (i = 0; i < rep->n_attributes; i++)
+	{
+	  if (attr_names[i] != NULL)
+	    {
+	      free_and_init (attr_names[i]);
+	    }
+	}
+      free_and_init (attr_names);
     }
 
-  qexec_clear_pred (thread_p, &xasl_node, pred_filter->pred, true);
-
-  return NO_ERROR;
-}
+  if (disk_repr_p)
+    {
+      catalog_free_representation_and_init (disk_repr_p);
+    }
 
-/*
- * qexec_clear_func_pred () - clear the predicate
- *   return: int
- *   func_pred(in) : The function predicate
- *
- *  Note: Use an XASL_NODE to clear allocated memmory.
- */
+  if (rep)
+    {
+      heap_classrepr_free_and_init (rep, &idx_incache);
+    }
 
-int
-qexec_clear_func_pred (THREAD_ENTRY * thread_p, func_pred * fpr)
-{
-  XASL_NODE xasl_node;
+  if (scancache_inited)
+    {
+      heap_scancache_end (thread_p, &scan);
+      scancache_inited = false;
+    }
 
-  memset (&xasl_node, 0, sizeof (XASL_NODE));
+#if defined(SERVER_MODE)
+  /* query execution error must be set up before qfile_close_list(). */
+  if (er_errid () < 0)
+    {
+      qmgr_set_query_error (thread_p, xasl_state->query_id);
+    }
+#endif
 
-  (void) qexec_clear_regu_var (thread_p, &xasl_node, fpr->func_regu, true);
+  qfile_close_list (thread_p, xasl->list_id);
 
-  return NO_ERROR;
-}
+  if (tplrec.tpl)
+    {
+      db_private_free_and_init (thread_p, tplrec.tpl);
+    }
 
-/*
- * qexec_clear_partition_expression () - clear partition expression
- * return : cleared count or error code
- * thread_p (in) :
- * expr (in) :
- */
-int
-qexec_clear_partition_expression (THREAD_ENTRY * thread_p, regu_variable_node * expr)
-{
-  XASL_NODE xasl_node;
+  if (save_heapid != 0)
+    {
+      (void) db_change_private_heap (thread_p, save_heapid);
+      save_heapid = 0;
+    }
 
-  memset (&xasl_node, 0, sizeof (XASL_NODE));
-  qexec_clear_regu_var (thread_p, &xasl_node, expr, true);
+  xasl->status = XASL_FAILURE;
 
-  return NO_ERROR;
+  qexec_failure_line (__LINE__, xasl_state);
+
+  return (error == NO_ERROR && (error = er_errid ()) == NO_ERROR) ? ER_FAILED : error;
 }
 
 /*
- * qexec_for_update_set_class_locks () - set X_LOCK on classes which will be
- *					 updated and are accessed sequentially
- * return : error code or NO_ERROR
- * thread_p (in)  :
- * scan_list (in) :
- *
- * Note: Used in SELECT ... FOR UPDATE
+ * qexec_schema_get_type_name_from_id() - returns string form of t's datatype
+ *					  for build schema
+ *   return:  character string denoting datatype dt
+ *   id(in): a DB_TYPE
  */
-static int
-qexec_for_update_set_class_locks (THREAD_ENTRY * thread_p, XASL_NODE * scan_list)
+static const char *
+qexec_schema_get_type_name_from_id (DB_TYPE id)
 {
-  XASL_NODE *scan = NULL;
-  ACCESS_SPEC_TYPE *specp = NULL;
-  OID *class_oid = NULL;
-  int error = NO_ERROR;
-  LOCK class_lock = IX_LOCK;	/* MVCC use IX_LOCK on class at update/delete */
-
-  for (scan = scan_list; scan != NULL; scan = scan->scan_ptr)
+  switch (id)
     {
-      for (specp = scan->spec_list; specp; specp = specp->next)
-	{
-	  if (specp->type == TARGET_CLASS && (specp->flags & ACCESS_SPEC_FLAG_FOR_UPDATE))
-	    {
-	      class_oid = &specp->s.cls_node.cls_oid;
+    case DB_TYPE_INTEGER:
+      return "INTEGER";
 
-	      /* lock the class */
-	      if (lock_object (thread_p, class_oid, oid_Root_class_oid, class_lock, LK_UNCOND_LOCK) != LK_GRANTED)
-		{
-		  assert (er_errid () != NO_ERROR);
-		  error = er_errid ();
-		  if (error == NO_ERROR)
-		    {
-		      error = ER_FAILED;
-		    }
-		  return error;
-		}
-	    }
-	}
-    }
+    case DB_TYPE_BIGINT:
+      return "BIGINT";
 
-  return error;
-}
+    case DB_TYPE_SMALLINT:
+      return "SHORT";
 
-/*
- * qexec_set_class_locks () - set X_LOCK on classes which will be updated and
- *			      are accessed sequentially and IX_LOCK on updated
- *			      classes which are accessed through an index
- *
- * return : error code or NO_ERROR
- * thread_p (in)  :
- * xasl (in)	  :
- * query_classes (in) : query classes
- * internal_classes (in) : internal classes
- * count (in)	  :
- */
-static int
-qexec_set_class_locks (THREAD_ENTRY * thread_p, XASL_NODE * aptr_list, UPDDEL_CLASS_INFO * query_classes,
-		       int query_classes_count, UPDDEL_CLASS_INFO_INTERNAL * internal_classes)
-{
-  XASL_NODE *aptr = NULL;
-  ACCESS_SPEC_TYPE *specp = NULL;
-  OID *class_oid = NULL;
-  int i, j, error = NO_ERROR;
-  UPDDEL_CLASS_INFO *query_class = NULL;
-  bool found = false;
-  LOCK class_lock = IX_LOCK;	/* MVCC use IX_LOCK on class at update/delete */
+    case DB_TYPE_NUMERIC:
+      return "NUMERIC";
 
-  for (aptr = aptr_list; aptr != NULL; aptr = aptr->scan_ptr)
-    {
-      for (specp = aptr->spec_list; specp; specp = specp->next)
-	{
-	  if (specp->type == TARGET_SET)
-	    {
-	      /* lock all update classes */
+    case DB_TYPE_FLOAT:
+      return "FLOAT";
 
-	      assert (specp->access == ACCESS_METHOD_SEQUENTIAL);
+    case DB_TYPE_DOUBLE:
+      return "DOUBLE";
 
-	      for (i = 0; i < query_classes_count; i++)
-		{
-		  query_class = &query_classes[i];
+    case DB_TYPE_DATE:
+      return "DATE";
 
-		  /* search class_oid through subclasses of a query class */
-		  for (j = 0; j < query_class->num_subclasses; j++)
-		    {
-		      class_oid = &query_class->class_oid[j];
+    case DB_TYPE_TIME:
+      return "TIME";
 
-		      if (lock_object (thread_p, class_oid, oid_Root_class_oid, class_lock, LK_UNCOND_LOCK) !=
-			  LK_GRANTED)
-			{
-			  assert (er_errid () != NO_ERROR);
-			  error = er_errid ();
-			  if (error == NO_ERROR)
-			    {
-			      error = ER_FAILED;
-			    }
-			  return error;
-			}
-		    }
-		}
+    case DB_TYPE_TIMESTAMP:
+      return "TIMESTAMP";
 
-	      return error;
-	    }
+    case DB_TYPE_TIMESTAMPTZ:
+      return "TIMESTAMPTZ";
 
-	  if (specp->type == TARGET_CLASS)
-	    {
-	      class_oid = &specp->s.cls_node.cls_oid;
-	      found = false;
+    case DB_TYPE_TIMESTAMPLTZ:
+      return "TIMESTAMPLTZ";
 
-	      /* search through query classes */
-	      for (i = 0; i < query_classes_count && !found; i++)
-		{
-		  query_class = &query_classes[i];
+    case DB_TYPE_DATETIME:
+      return "DATETIME";
 
-		  /* search class_oid through subclasses of a query class */
-		  for (j = 0; j < query_class->num_subclasses; j++)
-		    {
-		      if (OID_EQ (&query_class->class_oid[j], class_oid))
-			{
-			  /* lock the class */
-			  if (lock_object (thread_p, class_oid, oid_Root_class_oid, class_lock, LK_UNCOND_LOCK) !=
-			      LK_GRANTED)
-			    {
-			      assert (er_errid () != NO_ERROR);
-			      error = er_errid ();
-			      if (error == NO_ERROR)
-				{
-				  error = ER_FAILED;
-				}
-			      return error;
-			    }
+    case DB_TYPE_DATETIMETZ:
+      return "DATETIMETZ";
 
-			  found = true;
-			  break;
-			}
-		    }
-		}
-	    }
-	}
-    }
+    case DB_TYPE_DATETIMELTZ:
+      return "DATETIMELTZ";
 
-  return error;
-}
+    case DB_TYPE_MONETARY:
+      return "MONETARY";
 
-/*
- * qexec_execute_build_indexes () - Execution function for BUILD SCHEMA proc
- *   return: NO_ERROR, or ER_code
- *   xasl(in): XASL tree
- *   xasl_state(in): XASL state
- */
-static int
-qexec_execute_build_indexes (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state)
-{
-  QFILE_TUPLE_RECORD tplrec = { NULL, 0 };
-  int idx_incache = -1;
-  REPR_ID class_repr_id = NULL_REPRID;
-  OR_CLASSREP *rep = NULL;
-  OR_INDEX *index = NULL;
-  OR_ATTRIBUTE *index_att = NULL;
-  int att_id = 0;
-  char *attr_name = NULL, *string = NULL;
-  OR_ATTRIBUTE *attrepr = NULL;
-  DB_VALUE **out_values = NULL;
-  REGU_VARIABLE_LIST regu_var_p;
-  char **attr_names = NULL;
-  int *attr_ids = NULL;
-  int function_asc_desc;
-  HEAP_SCANCACHE scan;
-  bool scancache_inited = false;
-  RECDES class_record;
-  DISK_REPR *disk_repr_p = NULL;
-  char *class_name = NULL;
-  int non_unique;
-  int cardinality;
-  OID *class_oid = NULL;
-  OID dir_oid;
-  int i, j, k;
-  int error = NO_ERROR;
-  int function_index_pos = -1;
-  int index_position = 0, size_values = 0;
-  int num_idx_att = 0;
-  char *comment = NULL;
-  int alloced_string = 0;
-  HL_HEAPID save_heapid = 0;
-  CATALOG_ACCESS_INFO catalog_access_info = CATALOG_ACCESS_INFO_INITIALIZER;
 
-  assert (xasl != NULL && xasl_state != NULL);
+    case DB_TYPE_VARCHAR:
+      return "VARCHAR";
 
-  for (regu_var_p = xasl->outptr_list->valptrp, i = 0; regu_var_p; regu_var_p = regu_var_p->next, i++)
-    {
-      if (REGU_VARIABLE_IS_FLAGED (&regu_var_p->value, REGU_VARIABLE_CLEAR_AT_CLONE_DECACHE))
-	{
-	  save_heapid = db_change_private_heap (thread_p, 0);
-	  break;
-	}
-    }
-  if (qexec_start_mainblock_iterations (thread_p, xasl, xasl_state) != NO_ERROR)
-    {
-      GOTO_EXIT_ON_ERROR;
-    }
+    case DB_TYPE_CHAR:
+      return "CHAR";
 
-  assert (xasl_state != NULL);
-  class_oid = &(xasl->spec_list->s.cls_node.cls_oid);
+    case DB_TYPE_OID:
+    case DB_TYPE_OBJECT:
+      return "OBJECT";
 
-  /* get class disk representation */
-  if (catalog_get_dir_oid_from_cache (thread_p, class_oid, &dir_oid) != NO_ERROR)
-    {
-      ASSERT_ERROR_AND_SET (error);
-      GOTO_EXIT_ON_ERROR;
-    }
+    case DB_TYPE_SET:
+      return "SET";
 
-  catalog_access_info.class_oid = class_oid;
-  catalog_access_info.dir_oid = &dir_oid;
-  if (catalog_start_access_with_dir_oid (thread_p, &catalog_access_info, S_LOCK) != NO_ERROR)
-    {
-      ASSERT_ERROR_AND_SET (error);
-      (void) catalog_end_access_with_dir_oid (thread_p, &catalog_access_info, error);
-      GOTO_EXIT_ON_ERROR;
-    }
+    case DB_TYPE_MULTISET:
+      return "MULTISET";
+
+    case DB_TYPE_SEQUENCE:
+      return "SEQUENCE";
+
+    case DB_TYPE_NCHAR:
+      return "NCHAR";
 
-  error = catalog_get_last_representation_id (thread_p, class_oid, &class_repr_id);
-  if (error != NO_ERROR)
-    {
-      (void) catalog_end_access_with_dir_oid (thread_p, &catalog_access_info, error);
-      GOTO_EXIT_ON_ERROR;
-    }
+    case DB_TYPE_VARNCHAR:
+      return "NCHAR VARYING";
 
-  disk_repr_p = catalog_get_representation (thread_p, class_oid, class_repr_id, &catalog_access_info);
-  if (disk_repr_p == NULL)
-    {
-      ASSERT_ERROR_AND_SET (error);
-      (void) catalog_end_access_with_dir_oid (thread_p, &catalog_access_info, error);
-      GOTO_EXIT_ON_ERROR;
-    }
+    case DB_TYPE_BIT:
+      return "BIT";
 
-  (void) catalog_end_access_with_dir_oid (thread_p, &catalog_access_info, NO_ERROR);
+    case DB_TYPE_VARBIT:
+      return "BIT VARYING";
 
-  /* read heap class record, get class representation */
-  heap_scancache_quick_start_root_hfid (thread_p, &scan);
-  scancache_inited = true;
+    case DB_TYPE_BLOB:
+      return "BLOB";
 
-  if (heap_get_class_record (thread_p, class_oid, &class_record, &scan, PEEK) != S_SUCCESS)
-    {
-      GOTO_EXIT_ON_ERROR;
-    }
+    case DB_TYPE_CLOB:
+      return "CLOB";
 
-  rep = heap_classrepr_get (thread_p, class_oid, &class_record, class_repr_id, &idx_incache);
-  if (rep == NULL)
-    {
-      GOTO_EXIT_ON_ERROR;
+    case DB_TYPE_ENUMERATION:
+      return "ENUM";
+    case DB_TYPE_JSON:
+      return "JSON";
+    default:
+      return "UNKNOWN DATA_TYPE";
     }
+}
 
-  size_values = xasl->outptr_list->valptr_cnt;
-  assert (size_values == 14);
-  out_values = (DB_VALUE **) malloc (size_values * sizeof (DB_VALUE *));
-  if (out_values == NULL)
-    {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, size_values * sizeof (DB_VALUE *));
-      error = ER_OUT_OF_VIRTUAL_MEMORY;
-      GOTO_EXIT_ON_ERROR;
-    }
 
-  for (regu_var_p = xasl->outptr_list->valptrp, i = 0; regu_var_p; regu_var_p = regu_var_p->next, i++)
-    {
-      out_values[i] = &(regu_var_p->value.value.dbval);
-      pr_clear_value (out_values[i]);
-    }
+/*
+ * qexec_schema_get_type_desc() - returns string form of t's datatype
+ *   return:  character string denoting datatype dt
+ *   ie(in): a DB_TYPE
+ */
+static int
+qexec_schema_get_type_desc (DB_TYPE id, TP_DOMAIN * domain, DB_VALUE * result)
+{
+  const char *name = NULL;
+  int precision = -1;
+  int scale = -1;
+  DB_ENUM_ELEMENT *enum_elements = NULL;
+  int enum_elements_count = 0;
+  TP_DOMAIN *setdomain = NULL;
+  const char *set_of_string = NULL;
+  JSON_VALIDATOR *validator = NULL;
 
-  attr_names = (char **) malloc (rep->n_attributes * sizeof (char *));
-  if (attr_names == NULL)
-    {
-      GOTO_EXIT_ON_ERROR;
-    }
+  assert (domain != NULL && result != NULL);
 
-  attr_ids = (int *) malloc (rep->n_attributes * sizeof (int));
-  if (attr_ids == NULL)
-    {
-      GOTO_EXIT_ON_ERROR;
-    }
+  db_make_null (result);
 
-  for (i = 0; i < rep->n_attributes; i++)
+  switch (id)
     {
-      attr_names[i] = NULL;
-      attr_ids[i] = -1;
-    }
+    case DB_TYPE_NUMERIC:
+      scale = domain->scale;
+      /* fall through */
 
-  for (i = 0, attrepr = rep->attributes; i < rep->n_attributes; i++, attrepr++)
-    {
-      string = NULL;
-      alloced_string = 0;
+    case DB_TYPE_VARCHAR:
+    case DB_TYPE_CHAR:
+    case DB_TYPE_NCHAR:
+    case DB_TYPE_VARNCHAR:
+    case DB_TYPE_BIT:
+    case DB_TYPE_VARBIT:
+      precision = domain->precision;
+      break;
 
-      error = or_get_attrname (&class_record, attrepr->id, &string, &alloced_string);
-      if (error != NO_ERROR)
+    case DB_TYPE_SET:
+      setdomain = domain->setdomain;
+      if (setdomain == NULL)
 	{
-	  ASSERT_ERROR ();
-	  GOTO_EXIT_ON_ERROR;
+	  return NO_ERROR;
 	}
-
-      attr_name = string;
-      if (attr_name == NULL)
+      set_of_string = "SET OF ";
+      break;
+    case DB_TYPE_MULTISET:
+      setdomain = domain->setdomain;
+      if (setdomain == NULL)
 	{
-	  continue;
+	  return NO_ERROR;
 	}
-
-      attr_names[i] = strdup (attr_name);
-      attr_ids[i] = attrepr->id;
-
-      if (string != NULL && alloced_string == 1)
+      set_of_string = "MULTISET OF ";
+      break;
+    case DB_TYPE_SEQUENCE:
+      setdomain = domain->setdomain;
+      if (setdomain == NULL)
 	{
-	  db_private_free_and_init (thread_p, string);
+	  return NO_ERROR;
 	}
+      set_of_string = "SEQUENCE OF ";
+      break;
+
+    case DB_TYPE_ENUMERATION:
+      enum_elements = domain->enumeration.elements;
+      enum_elements_count = domain->enumeration.count;
+      break;
+    case DB_TYPE_JSON:
+      validator = domain->json_validator;
+      break;
+    default:
+      break;
     }
 
-  class_name = or_class_name (&class_record);
-  for (i = 0; i < rep->n_indexes; i++)
+  name = qexec_schema_get_type_name_from_id (id);
+
+  if (enum_elements)
     {
-      /* class name */
-      db_make_string (out_values[0], class_name);
+      DB_VALUE enum_arg1, enum_arg2, enum_result, *penum_arg1, *penum_arg2, *penum_result, *penum_temp;
+      DB_DATA_STATUS data_stat;
+      DB_VALUE quote, quote_comma_space, enum_;
+      DB_VALUE braket;
+      int i;
 
-      /* packed */
-      db_make_null (out_values[8]);
+      assert (enum_elements_count >= 0);
 
-      /* index type */
-      db_make_string (out_values[10], "BTREE");
+      penum_arg1 = &enum_arg1;
+      penum_arg2 = &enum_arg2;
+      penum_result = &enum_result;
 
-      index = rep->indexes + i;
-      /* Non_unique */
-      non_unique = btree_is_unique_type (index->type) ? 0 : 1;
-      db_make_int (out_values[1], non_unique);
+      db_make_string (&quote, "\'");
+      db_make_string (&quote_comma_space, "\', ");
+      db_make_string (&braket, ")");
+      db_make_string (&enum_, "ENUM(");
 
-      /* Key_name */
-      db_make_string (out_values[2], index->btname);
+      pr_clone_value (&enum_, penum_result);
+      for (i = 0; i < enum_elements_count; i++)
+	{
+	  penum_temp = penum_arg1;
+	  penum_arg1 = penum_result;
+	  penum_result = penum_temp;
+	  if ((db_string_concatenate (penum_arg1, &quote, penum_result, &data_stat) != NO_ERROR)
+	      || (data_stat != DATA_STATUS_OK))
+	    {
+	      pr_clear_value (penum_arg1);
+	      goto exit_on_error;
+	    }
+	  pr_clear_value (penum_arg1);
 
-      /* Func */
-      db_make_null (out_values[11]);
+	  penum_temp = penum_arg1;
+	  penum_arg1 = penum_result;
+	  penum_result = penum_temp;
 
-      /* Comment */
-      comment = (char *) or_get_constraint_comment (&class_record, index->btname);
-      db_make_string (out_values[12], comment);
+	  db_make_string (penum_arg2, enum_elements[i].str_val.medium.buf);
+	  if ((db_string_concatenate (penum_arg1, penum_arg2, penum_result, &data_stat) != NO_ERROR)
+	      || (data_stat != DATA_STATUS_OK))
+	    {
+	      pr_clear_value (penum_arg1);
+	      pr_clear_value (penum_arg2);
+	      goto exit_on_error;
+	    }
+	  pr_clear_value (penum_arg1);
 
-      /* Visible */
-      db_make_string (out_values[13], (index->index_status == OR_NORMAL_INDEX) ? "YES" : "NO");
+	  penum_temp = penum_arg1;
+	  penum_arg1 = penum_result;
+	  penum_result = penum_temp;
+	  if (i < enum_elements_count - 1)
+	    {
+	      if ((db_string_concatenate (penum_arg1, &quote_comma_space, penum_result, &data_stat) != NO_ERROR)
+		  || (data_stat != DATA_STATUS_OK))
+		{
+		  pr_clear_value (penum_arg1);
+		  pr_clear_value (penum_arg2);
+		  goto exit_on_error;
+		}
+	    }
+	  else
+	    {
+	      if ((db_string_concatenate (penum_arg1, &quote, penum_result, &data_stat) != NO_ERROR)
+		  || (data_stat != DATA_STATUS_OK))
+		{
+		  pr_clear_value (penum_arg1);
+		  pr_clear_value (penum_arg2);
+		  goto exit_on_error;
+		}
+	    }
+	  pr_clear_value (penum_arg1);
+	  pr_clear_value (penum_arg2);
+	}
+
+      penum_temp = penum_arg1;
+      penum_arg1 = penum_result;
+      penum_result = penum_temp;
+      if ((db_string_concatenate (penum_arg1, &braket, penum_result, &data_stat) != NO_ERROR)
+	  || (data_stat != DATA_STATUS_OK))
+	{
+	  goto exit_on_error;
+	}
+      pr_clear_value (penum_arg1);
+      pr_clone_value (penum_result, result);
+      pr_clear_value (penum_result);
+
+      return NO_ERROR;
+    }
+  else if (setdomain != NULL)
+    {
+      /* process sequence */
+      DB_VALUE set_arg1, set_arg2, set_result, *pset_arg1, *pset_arg2, *pset_result, *pset_temp;
+      DB_DATA_STATUS data_stat;
+      DB_VALUE comma;
+      char **ordered_names = NULL, *min, *temp;
+      int count_names = 0, i, j, idx_min;
 
-      if (index->func_index_info == NULL)
+      for (setdomain = domain->setdomain; setdomain; setdomain = setdomain->next)
 	{
-	  function_index_pos = -1;
-	  num_idx_att = index->n_atts;
+	  count_names++;
 	}
-      else
+
+      ordered_names = (char **) malloc (count_names * sizeof (char *));
+      if (ordered_names == NULL)
 	{
-	  function_index_pos = index->func_index_info->col_id;
-	  /* do not count function attributes function attributes are positioned after index attributes at the end of
-	   * index->atts array */
-	  num_idx_att = index->func_index_info->attr_index_start;
+	  return ER_OUT_OF_VIRTUAL_MEMORY;
 	}
 
-      /* index attributes */
-      index_position = 0;
-      for (j = 0; j < num_idx_att; j++)
+      for (setdomain = domain->setdomain, i = 0; setdomain; setdomain = setdomain->next, i++)
 	{
-	  index_att = index->atts[j];
-	  att_id = index_att->id;
-	  assert (att_id >= 0);
-
-	  if (index_position == function_index_pos)
-	    {
-	      /* function position in index founded, compute attribute position in index */
-	      index_position++;
-	    }
-
-	  /* Seq_in_index */
-	  db_make_int (out_values[3], index_position + 1);
+	  ordered_names[i] = (char *) qexec_schema_get_type_name_from_id (setdomain->type->id);
+	}
 
-	  /* Collation */
-	  if (index->asc_desc[j])
-	    {
-	      db_make_string (out_values[5], "D");
-	    }
-	  else
+      for (i = 0; i < count_names - 1; i++)
+	{
+	  idx_min = i;
+	  min = ordered_names[i];
+	  for (j = i + 1; j < count_names; j++)
 	    {
-	      db_make_string (out_values[5], "A");
+	      if (strcmp (ordered_names[i], ordered_names[j]) > 0)
+		{
+		  min = ordered_names[j];
+		  idx_min = j;
+		}
 	    }
 
-	  /* Cardinality */
-	  if (catalog_get_cardinality (thread_p, class_oid, disk_repr_p, &index->btid, index_position, &cardinality) !=
-	      NO_ERROR)
+	  if (idx_min != i)
 	    {
-	      GOTO_EXIT_ON_ERROR;
+	      temp = ordered_names[i];
+	      ordered_names[i] = ordered_names[idx_min];
+	      ordered_names[idx_min] = temp;
 	    }
+	}
 
-	  if (cardinality < 0)
-	    {
-	      db_make_null (out_values[6]);
-	    }
-	  else
-	    {
-	      db_make_int (out_values[6], cardinality);
-	    }
+      pset_arg1 = &set_arg1;
+      pset_arg2 = &set_arg2;
+      pset_result = &set_result;
 
-	  /* Sub_part */
-	  if (index->attrs_prefix_length && index->attrs_prefix_length[j] > -1)
-	    {
-	      db_make_int (out_values[7], index->attrs_prefix_length[j]);
-	    }
-	  else
-	    {
-	      db_make_null (out_values[7]);
-	    }
+      db_make_string (&comma, ",");
+      db_make_string (pset_result, set_of_string);
 
-	  /* [Null] */
-	  if (index_att->is_notnull)
-	    {
-	      db_make_string (out_values[9], "NO");
-	    }
-	  else
+      for (setdomain = domain->setdomain, i = 0; setdomain; setdomain = setdomain->next, i++)
+	{
+	  pset_temp = pset_arg1;
+	  pset_arg1 = pset_result;
+	  pset_result = pset_temp;
+	  db_make_string (pset_arg2, ordered_names[i]);
+	  if ((db_string_concatenate (pset_arg1, pset_arg2, pset_result, &data_stat) != NO_ERROR)
+	      || (data_stat != DATA_STATUS_OK))
 	    {
-	      db_make_string (out_values[9], "YES");
+	      free_and_init (ordered_names);
+	      pr_clear_value (pset_arg1);
+	      pr_clear_value (pset_arg2);
+	      goto exit_on_error;
 	    }
+	  pr_clear_value (pset_arg1);
+	  pr_clear_value (pset_arg2);
 
-	  /* Column_name */
-	  for (k = 0; k < rep->n_attributes; k++)
+	  if (setdomain->next != NULL)
 	    {
-	      if (att_id == attr_ids[k])
+	      pset_temp = pset_arg1;
+	      pset_arg1 = pset_result;
+	      pset_result = pset_temp;
+	      if ((db_string_concatenate (pset_arg1, &comma, pset_result, &data_stat) != NO_ERROR)
+		  || (data_stat != DATA_STATUS_OK))
 		{
-		  db_make_string (out_values[4], attr_names[k]);
-		  qexec_end_one_iteration (thread_p, xasl, xasl_state, &tplrec);
-		  break;
+		  free_and_init (ordered_names);
+		  pr_clear_value (pset_arg1);
+		  goto exit_on_error;
 		}
+	      pr_clear_value (pset_arg1);
 	    }
+	}
 
-	  /* clear alloced DB_VALUEs */
-	  pr_clear_value (out_values[5]);
-	  pr_clear_value (out_values[9]);
+      pr_clone_value (pset_result, result);
+      pr_clear_value (pset_result);
+      free_and_init (ordered_names);
+      return NO_ERROR;
+    }
+  else if (precision >= 0)
+    {
+      DB_VALUE db_int_scale, db_str_scale;
+      DB_VALUE db_int_precision, db_str_precision;
+      DB_VALUE prec_scale_result, prec_scale_arg1, *pprec_scale_arg1, *pprec_scale_result, *pprec_scale_temp;
+      DB_VALUE comma, bracket1, bracket2;
+      DB_DATA_STATUS data_stat;
 
-	  index_position++;
+      db_make_int (&db_int_precision, precision);
+      db_make_null (&db_str_precision);
+      if (tp_value_cast (&db_int_precision, &db_str_precision, &tp_String_domain, false) != DOMAIN_COMPATIBLE)
+	{
+	  goto exit_on_error;
 	}
+      pprec_scale_arg1 = &prec_scale_arg1;
+      pprec_scale_result = &prec_scale_result;
+      db_make_string (&comma, ",");
+      db_make_string (&bracket1, "(");
+      db_make_string (&bracket2, ")");
+      db_make_string (pprec_scale_arg1, name);
 
-      /* function index */
-      if (function_index_pos >= 0)
+      if ((db_string_concatenate (pprec_scale_arg1, &bracket1, pprec_scale_result, &data_stat) != NO_ERROR)
+	  || (data_stat != DATA_STATUS_OK))
 	{
-	  /* Func */
-	  db_make_string (out_values[11], index->func_index_info->expr_string);
+	  pr_clear_value (pprec_scale_arg1);
+	  goto exit_on_error;
+	}
+      pr_clear_value (pprec_scale_arg1);
 
-	  /* Collation */
-	  if (btree_get_asc_desc (thread_p, &index->btid, function_index_pos, &function_asc_desc) != NO_ERROR)
-	    {
-	      GOTO_EXIT_ON_ERROR;
-	    }
+      pprec_scale_temp = pprec_scale_arg1;
+      pprec_scale_arg1 = pprec_scale_result;
+      pprec_scale_result = pprec_scale_temp;
+      if ((db_string_concatenate (pprec_scale_arg1, &db_str_precision, pprec_scale_result, &data_stat) != NO_ERROR)
+	  || (data_stat != DATA_STATUS_OK))
+	{
+	  pr_clear_value (pprec_scale_arg1);
+	  goto exit_on_error;
+	}
+      pr_clear_value (&db_str_precision);
+      pr_clear_value (pprec_scale_arg1);
 
-	  if (function_asc_desc)
-	    {
-	      db_make_string (out_values[5], "D");
-	    }
-	  else
+      if (scale >= 0)
+	{
+	  db_make_int (&db_int_scale, scale);
+	  db_make_null (&db_str_scale);
+	  if (tp_value_cast (&db_int_scale, &db_str_scale, &tp_String_domain, false) != DOMAIN_COMPATIBLE)
 	    {
-	      db_make_string (out_values[5], "A");
+	      pr_clear_value (pprec_scale_result);
+	      goto exit_on_error;
 	    }
 
-	  /* Seq_in_index */
-	  db_make_int (out_values[3], function_index_pos + 1);
-
-	  /* Cardinality */
-	  if (catalog_get_cardinality (thread_p, class_oid, disk_repr_p, &index->btid, function_index_pos, &cardinality)
-	      != NO_ERROR)
+	  pprec_scale_temp = pprec_scale_arg1;
+	  pprec_scale_arg1 = pprec_scale_result;
+	  pprec_scale_result = pprec_scale_temp;
+	  if ((db_string_concatenate (pprec_scale_arg1, &comma, pprec_scale_result, &data_stat) != NO_ERROR)
+	      || (data_stat != DATA_STATUS_OK))
 	    {
-	      GOTO_EXIT_ON_ERROR;
+	      pr_clear_value (pprec_scale_arg1);
+	      goto exit_on_error;
 	    }
+	  pr_clear_value (pprec_scale_arg1);
 
-	  if (cardinality < 0)
-	    {
-	      db_make_null (out_values[6]);
-	    }
-	  else
+	  pprec_scale_temp = pprec_scale_arg1;
+	  pprec_scale_arg1 = pprec_scale_result;
+	  pprec_scale_result = pprec_scale_temp;
+	  if ((db_string_concatenate (pprec_scale_arg1, &db_str_scale, pprec_scale_result, &data_stat) != NO_ERROR)
+	      || (data_stat != DATA_STATUS_OK))
 	    {
-	      db_make_int (out_values[6], cardinality);
+	      pr_clear_value (pprec_scale_arg1);
+	      goto exit_on_error;
 	    }
-
-	  /* Sub_part */
-	  db_make_null (out_values[7]);
-
-	  /* [Null] */
-	  db_make_string (out_values[9], "YES");
-
-	  /* Column_name */
-	  db_make_null (out_values[4]);
-	  qexec_end_one_iteration (thread_p, xasl, xasl_state, &tplrec);
-	}
-
-      if (comment != NULL)
-	{
-	  free_and_init (comment);
-	}
-
-      /* needs to clear db_value content if is allocated during qexec_end_one_iteration */
-      for (j = 0; j < size_values; j++)
-	{
-	  pr_clear_value (out_values[j]);
+	  pr_clear_value (&db_str_scale);
+	  pr_clear_value (pprec_scale_arg1);
 	}
-    }
 
-  for (i = 0; i < rep->n_attributes; i++)
-    {
-      if (attr_names[i] != NULL)
+      pprec_scale_temp = pprec_scale_arg1;
+      pprec_scale_arg1 = pprec_scale_result;
+      pprec_scale_result = pprec_scale_temp;
+      if ((db_string_concatenate (pprec_scale_arg1, &bracket2, pprec_scale_result, &data_stat) != NO_ERROR)
+	  || (data_stat != DATA_STATUS_OK))
 	{
-	  free_and_init (attr_names[i]);
+	  pr_clear_value (pprec_scale_arg1);
+	  goto exit_on_error;
 	}
-    }
+      pr_clear_value (pprec_scale_arg1);
 
-  free_and_init (out_values);
-  free_and_init (attr_ids);
-  free_and_init (attr_names);
+      pr_clone_value (pprec_scale_result, result);
+      pr_clear_value (pprec_scale_result);
 
-  catalog_free_representation_and_init (disk_repr_p);
-  heap_classrepr_free_and_init (rep, &idx_incache);
-  if (heap_scancache_end (thread_p, &scan) != NO_ERROR)
-    {
-      GOTO_EXIT_ON_ERROR;
+      return NO_ERROR;
     }
-  scancache_inited = false;
-
-  if (qexec_end_mainblock_iterations (thread_p, xasl, xasl_state, &tplrec) != NO_ERROR)
+  else if (validator != NULL)
     {
-      GOTO_EXIT_ON_ERROR;
-    }
+      DB_DATA_STATUS data_stat;
+      DB_VALUE bracket1, bracket2, schema;
+      bool err = false;
 
-  if ((xasl->orderby_list	/* it has ORDER BY clause */
-       && (!XASL_IS_FLAGED (xasl, XASL_SKIP_ORDERBY_LIST)	/* cannot skip */
-	   || XASL_IS_FLAGED (xasl, XASL_USES_MRO))	/* MRO must go on */
-       && (xasl->list_id->tuple_cnt > 1	/* the result has more than one tuple */
-	   || xasl->ordbynum_val != NULL))	/* ORDERBY_NUM() is used */
-      || (xasl->option == Q_DISTINCT))	/* DISTINCT must go on */
-    {
-      if (qexec_orderby_distinct (thread_p, xasl, xasl->option, xasl_state) != NO_ERROR)
+      if (db_json_get_schema_raw_from_validator (validator) != NULL)
 	{
-	  GOTO_EXIT_ON_ERROR;
-	}
-    }
+	  db_make_string (result, name);
+	  db_make_string (&schema, db_json_get_schema_raw_from_validator (validator));
+	  db_make_string (&bracket1, "(\'");
+	  db_make_string (&bracket2, "\')");
 
-  if (tplrec.tpl)
-    {
-      db_private_free_and_init (thread_p, tplrec.tpl);
-    }
+	  if (db_string_concatenate (result, &bracket1, result, &data_stat) != NO_ERROR
+	      || (data_stat != DATA_STATUS_OK)
+	      || db_string_concatenate (result, &schema, result, &data_stat) != NO_ERROR
+	      || (data_stat != DATA_STATUS_OK)
+	      || db_string_concatenate (result, &bracket2, result, &data_stat) != NO_ERROR
+	      || (data_stat != DATA_STATUS_OK))
+	    {
+	      err = true;
+	    }
 
-  if (save_heapid != 0)
+	  pr_clear_value (&schema);
+
+	  if (err)
+	    {
+	      pr_clear_value (result);
+	      goto exit_on_error;
+	    }
+	}
+      return NO_ERROR;
+    }
+  else
     {
-      (void) db_change_private_heap (thread_p, save_heapid);
-      save_heapid = 0;
+      db_make_string (result, name);
+      return NO_ERROR;
     }
 
-  return NO_ERROR;
-
 exit_on_error:
+  return ER_FAILED;
+}
 
-  if (out_values)
-    {
-      for (i = 0; i < size_values; i++)
-	{
-	  pr_clear_value (out_values[i]);
-	}
+/*
+ * qexec_execute_build_columns () - Execution function for BUILD SCHEMA proc
+ *   return: NO_ERROR, or ER_code
+ *   xasl(in): XASL tree
+ *   xasl_state(in): XASL state
+ */
+static int
+qexec_execute_build_columns (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state)
+{
+  QFILE_TUPLE_RECORD tplrec = { NULL, 0 };
+  int idx_incache = -1;
+  OR_CLASSREP *rep = NULL;
+  OR_INDEX *index = NULL;
+  char *attr_name = NULL, *default_value_string = NULL;
+  const char *default_expr_type_string = NULL, *default_expr_format = NULL;
+  char *attr_comment = NULL;
+  OR_ATTRIBUTE *volatile attrepr = NULL;
+  DB_VALUE **out_values = NULL;
+  REGU_VARIABLE_LIST regu_var_p;
+  HEAP_SCANCACHE scan;
+  bool scancache_inited = false;
+  RECDES class_record;
+  OID *class_oid = NULL;
+  volatile int idx_val;
+  volatile int error = NO_ERROR;
+  int i, j, k, idx_all_attr, size_values, found_index_type = -1;
+  bool search_index_type = true;
+  BTID *btid;
+  int index_type_priorities[] = { 1, 0, 1, 0, 2, 0 };
+  int index_type_max_priority = 2;
+  DB_VALUE def_order, attr_class_type;
+  OR_ATTRIBUTE *all_class_attr[3];
+  int all_class_attr_lengths[3];
+  bool full_columns = false;
+  char *string = NULL;
+  int alloced_string = 0;
+  HL_HEAPID save_heapid = 0;
 
-      free_and_init (out_values);
-    }
-  if (attr_ids)
+  if (xasl == NULL || xasl_state == NULL)
     {
-      free_and_init (attr_ids);
+      return ER_FAILED;
     }
-  if (attr_names)
+
+  for (regu_var_p = xasl->outptr_list->valptrp, i = 0; regu_var_p; regu_var_p = regu_var_p->next, i++)
     {
-      for (i = 0; i < rep->n_attributes; i++)
+      if (REGU_VARIABLE_IS_FLAGED (&regu_var_p->value, REGU_VARIABLE_CLEAR_AT_CLONE_DECACHE))
 	{
-	  if (attr_names[i] != NULL)
-	    {
-	      free_and_init (attr_names[i]);
-	    }
+	  save_heapid = db_change_private_heap (thread_p, 0);
+	  break;
 	}
-      free_and_init (attr_names);
     }
 
-  if (disk_repr_p)
+  if (qexec_start_mainblock_iterations (thread_p, xasl, xasl_state) != NO_ERROR)
     {
-      catalog_free_representation_and_init (disk_repr_p);
+      GOTO_EXIT_ON_ERROR;
     }
 
-  if (rep)
-    {
-      heap_classrepr_free_and_init (rep, &idx_incache);
-    }
+  heap_scancache_quick_start_root_hfid (thread_p, &scan);
+  scancache_inited = true;
 
-  if (scancache_inited)
-    {
-      heap_scancache_end (thread_p, &scan);
-      scancache_inited = false;
-    }
+  assert (xasl_state != NULL);
+  class_oid = &(xasl->spec_list->s.cls_node.cls_oid);
 
-#if defined(SERVER_MODE)
-  /* query execution error must be set up before qfile_close_list(). */
-  if (er_errid () < 0)
+  if (heap_get_class_record (thread_p, class_oid, &class_record, &scan, PEEK) != S_SUCCESS)
     {
-      qmgr_set_query_error (thread_p, xasl_state->query_id);
+      GOTO_EXIT_ON_ERROR;
     }
-#endif
-
-  qfile_close_list (thread_p, xasl->list_id);
 
-  if (tplrec.tpl)
+  rep = heap_classrepr_get (thread_p, class_oid, &class_record, NULL_REPRID, &idx_incache);
+  if (rep == NULL)
     {
-      db_private_free_and_init (thread_p, tplrec.tpl);
+      GOTO_EXIT_ON_ERROR;
     }
 
-  if (save_heapid != 0)
+  size_values = xasl->outptr_list->valptr_cnt;
+  out_values = (DB_VALUE **) malloc (size_values * sizeof (DB_VALUE *));
+  if (out_values == NULL)
     {
-      (void) db_change_private_heap (thread_p, save_heapid);
-      save_heapid = 0;
+      GOTO_EXIT_ON_ERROR;
     }
 
-  xasl->status = XASL_FAILURE;
-
-  qexec_failure_line (__LINE__, xasl_state);
-
-  return (error == NO_ERROR && (error = er_errid ()) == NO_ERROR) ? ER_FAILED : error;
-}
-
-/*
- * qexec_schema_get_type_name_from_id() - returns string form of t's datatype
- *					  for build schema
- *   return:  character string denoting datatype dt
- *   id(in): a DB_TYPE
- */
-static const char *
-qexec_schema_get_type_name_from_id (DB_TYPE id)
-{
-  switch (id)
+  for (regu_var_p = xasl->outptr_list->valptrp, i = 0; regu_var_p; regu_var_p = regu_var_p->next, i++)
     {
-    case DB_TYPE_INTEGER:
-      return "INTEGER";
-
-    case DB_TYPE_BIGINT:
-      return "BIGINT";
-
-    case DB_TYPE_SMALLINT:
-      return "SHORT";
-
-    case DB_TYPE_NUMERIC:
-      return "NUMERIC";
-
-    case DB_TYPE_FLOAT:
-      return "FLOAT";
-
-    case DB_TYPE_DOUBLE:
-      return "DOUBLE";
-
-    case DB_TYPE_DATE:
-      return "DATE";
-
-    case DB_TYPE_TIME:
-      return "TIME";
-
-    case DB_TYPE_TIMESTAMP:
-      return "TIMESTAMP";
-
-    case DB_TYPE_TIMESTAMPTZ:
-      return "TIMESTAMPTZ";
-
-    case DB_TYPE_TIMESTAMPLTZ:
-      return "TIMESTAMPLTZ";
-
-    case DB_TYPE_DATETIME:
-      return "DATETIME";
-
-    case DB_TYPE_DATETIMETZ:
-      return "DATETIMETZ";
-
-    case DB_TYPE_DATETIMELTZ:
-      return "DATETIMELTZ";
-
-    case DB_TYPE_MONETARY:
-      return "MONETARY";
-
-
-    case DB_TYPE_VARCHAR:
-      return "VARCHAR";
-
-    case DB_TYPE_CHAR:
-      return "CHAR";
-
-    case DB_TYPE_OID:
-    case DB_TYPE_OBJECT:
-      return "OBJECT";
-
-    case DB_TYPE_SET:
-      return "SET";
-
-    case DB_TYPE_MULTISET:
-      return "MULTISET";
-
-    case DB_TYPE_SEQUENCE:
-      return "SEQUENCE";
+      out_values[i] = &(regu_var_p->value.value.dbval);
+      pr_clear_value (out_values[i]);
+    }
 
-    case DB_TYPE_NCHAR:
-      return "NCHAR";
+  all_class_attr[0] = rep->attributes;
+  all_class_attr_lengths[0] = rep->n_attributes;
+  all_class_attr[1] = rep->class_attrs;
+  all_class_attr_lengths[1] = rep->n_class_attrs;
+  all_class_attr[2] = rep->shared_attrs;
+  all_class_attr_lengths[2] = rep->n_shared_attrs;
 
-    case DB_TYPE_VARNCHAR:
-      return "NCHAR VARYING";
+  if (xasl->spec_list->s.cls_node.schema_type == FULL_COLUMNS_SCHEMA)
+    {
+      full_columns = true;
+    }
 
-    case DB_TYPE_BIT:
-      return "BIT";
+  for (idx_all_attr = 0; idx_all_attr < 3; idx_all_attr++)
+    {
+      /* attribute class type */
+      db_make_int (&attr_class_type, idx_all_attr);
+      error = db_value_coerce (&attr_class_type, out_values[0], db_type_to_db_domain (DB_TYPE_VARCHAR));
+      if (error != NO_ERROR)
+	{
+	  GOTO_EXIT_ON_ERROR;
+	}
 
-    case DB_TYPE_VARBIT:
-      return "BIT VARYING";
+      for (i = 0, attrepr = all_class_attr[idx_all_attr]; i < all_class_attr_lengths[idx_all_attr]; i++, attrepr++)
+	{
+	  idx_val = 1;
+	  /* attribute def order */
+	  db_make_int (&def_order, attrepr->def_order);
+	  error = db_value_coerce (&def_order, out_values[idx_val++], db_type_to_db_domain (DB_TYPE_VARCHAR));
+	  if (error != NO_ERROR)
+	    {
+	      GOTO_EXIT_ON_ERROR;
+	    }
 
-    case DB_TYPE_BLOB:
-      return "BLOB";
+	  /* attribute name */
+	  string = NULL;
+	  alloced_string = 0;
 
-    case DB_TYPE_CLOB:
-      return "CLOB";
+	  error = or_get_attrname (&class_record, attrepr->id, &string, &alloced_string);
+	  if (error != NO_ERROR)
+	    {
+	      ASSERT_ERROR ();
+	      GOTO_EXIT_ON_ERROR;
+	    }
 
-    case DB_TYPE_ENUMERATION:
-      return "ENUM";
-    case DB_TYPE_JSON:
-      return "JSON";
-    default:
-      return "UNKNOWN DATA_TYPE";
-    }
-}
+	  attr_name = string;
+	  db_make_string (out_values[idx_val], attr_name);
+	  if (string != NULL && alloced_string == 1)
+	    {
+	      out_values[idx_val]->need_clear = true;
+	    }
+	  idx_val++;
 
+	  /* attribute type */
+	  (void) qexec_schema_get_type_desc (attrepr->type, attrepr->domain, out_values[idx_val++]);
 
-/*
- * qexec_schema_get_type_desc() - returns string form of t's datatype
- *   return:  character string denoting datatype dt
- *   ie(in): a DB_TYPE
- */
-static int
-qexec_schema_get_type_desc (DB_TYPE id, TP_DOMAIN * domain, DB_VALUE * result)
-{
-  const char *name = NULL;
-  int precision = -1;
-  int scale = -1;
-  DB_ENUM_ELEMENT *enum_elements = NULL;
-  int enum_elements_count = 0;
-  TP_DOMAIN *setdomain = NULL;
-  const char *set_of_string = NULL;
-  JSON_VALIDATOR *validator = NULL;
+	  /* collation */
+	  if (full_columns)
+	    {
+	      switch (attrepr->type)
+		{
+		case DB_TYPE_VARCHAR:
+		case DB_TYPE_CHAR:
+		case DB_TYPE_NCHAR:
+		case DB_TYPE_VARNCHAR:
+		case DB_TYPE_ENUMERATION:
+		  db_make_string (out_values[idx_val], lang_get_collation_name (attrepr->domain->collation_id));
+		  break;
+		default:
+		  db_make_null (out_values[idx_val]);
+		}
+	      idx_val++;
+	    }
 
-  assert (domain != NULL && result != NULL);
+	  /* attribute can store NULL ? */
+	  if (attrepr->is_notnull == 0)
+	    {
+	      db_make_string (out_values[idx_val], "YES");
+	    }
+	  else
+	    {
+	      db_make_string (out_values[idx_val], "NO");
+	    }
+	  idx_val++;
 
-  db_make_null (result);
+	  /* attribute has index or not */
+	  found_index_type = -1;
+	  search_index_type = true;
+	  for (j = 0; j < attrepr->n_btids && search_index_type; j++)
+	    {
+	      btid = attrepr->btids + j;
 
-  switch (id)
-    {
-    case DB_TYPE_NUMERIC:
-      scale = domain->scale;
-      /* fall through */
+	      for (k = 0; k < rep->n_indexes; k++)
+		{
+		  index = rep->indexes + k;
+		  if (BTID_IS_EQUAL (btid, &index->btid))
+		    {
+		      if (found_index_type == -1
+			  || index_type_priorities[index->type] > index_type_priorities[found_index_type])
+			{
+			  found_index_type = index->type;
+			  if (index_type_priorities[found_index_type] == index_type_max_priority)
+			    {
+			      /* stop searching */
+			      search_index_type = false;
+			    }
+			}
+		      break;
+		    }
+		}
+	    }
 
-    case DB_TYPE_VARCHAR:
-    case DB_TYPE_CHAR:
-    case DB_TYPE_NCHAR:
-    case DB_TYPE_VARNCHAR:
-    case DB_TYPE_BIT:
-    case DB_TYPE_VARBIT:
-      precision = domain->precision;
-      break;
+	  switch (found_index_type)
+	    {
+	    case BTREE_UNIQUE:
+	    case BTREE_REVERSE_UNIQUE:
+	      db_make_string (out_values[idx_val], "UNI");
+	      break;
 
-    case DB_TYPE_SET:
-      setdomain = domain->setdomain;
-      if (setdomain == NULL)
-	{
-	  return NO_ERROR;
-	}
-      set_of_string = "SET OF ";
-      break;
-    case DB_TYPE_MULTISET:
-      setdomain = domain->setdomain;
-      if (setdomain == NULL)
-	{
-	  return NO_ERROR;
-	}
-      set_of_string = "MULTISET OF ";
-      break;
-    case DB_TYPE_SEQUENCE:
-      setdomain = domain->setdomain;
-      if (setdomain == NULL)
-	{
-	  return NO_ERROR;
-	}
-      set_of_string = "SEQUENCE OF ";
-      break;
+	    case BTREE_INDEX:
+	    case BTREE_REVERSE_INDEX:
+	    case BTREE_FOREIGN_KEY:
+	      db_make_string (out_values[idx_val], "MUL");
+	      break;
 
-    case DB_TYPE_ENUMERATION:
-      enum_elements = domain->enumeration.elements;
-      enum_elements_count = domain->enumeration.count;
-      break;
-    case DB_TYPE_JSON:
-      validator = domain->json_validator;
-      break;
-    default:
-      break;
-    }
+	    case BTREE_PRIMARY_KEY:
+	      db_make_string (out_values[idx_val], "PRI");
+	      break;
 
-  name = qexec_schema_get_type_name_from_id (id);
+	    default:
+	      db_make_string (out_values[idx_val], "");
+	      break;
+	    }
+	  idx_val++;
 
-  if (enum_elements)
-    {
-      DB_VALUE enum_arg1, enum_arg2, enum_result, *penum_arg1, *penum_arg2, *penum_result, *penum_temp;
-      DB_DATA_STATUS data_stat;
-      DB_VALUE quote, quote_comma_space, enum_;
-      DB_VALUE braket;
-      int i;
+	  /* default values */
+	  alloced_string = 0;
+	  if (attrepr->default_value.default_expr.default_expr_type != DB_DEFAULT_NONE)
+	    {
+	      const char *default_expr_op_string = NULL;
 
-      assert (enum_elements_count >= 0);
+	      default_expr_type_string =
+		db_default_expression_string (attrepr->default_value.default_expr.default_expr_type);
 
-      penum_arg1 = &enum_arg1;
-      penum_arg2 = &enum_arg2;
-      penum_result = &enum_result;
+	      if (attrepr->default_value.default_expr.default_expr_op == T_TO_CHAR)
+		{
+		  size_t len;
 
-      db_make_string (&quote, "\'");
-      db_make_string (&quote_comma_space, "\', ");
-      db_make_string (&braket, ")");
-      db_make_string (&enum_, "ENUM(");
+		  default_expr_op_string = qdump_operator_type_string (T_TO_CHAR);
+		  default_expr_format = attrepr->default_value.default_expr.default_expr_format;
 
-      pr_clone_value (&enum_, penum_result);
-      for (i = 0; i < enum_elements_count; i++)
-	{
-	  penum_temp = penum_arg1;
-	  penum_arg1 = penum_result;
-	  penum_result = penum_temp;
-	  if ((db_string_concatenate (penum_arg1, &quote, penum_result, &data_stat) != NO_ERROR)
-	      || (data_stat != DATA_STATUS_OK))
-	    {
-	      pr_clear_value (penum_arg1);
-	      goto exit_on_error;
-	    }
-	  pr_clear_value (penum_arg1);
+		  len = ((default_expr_op_string ? strlen (default_expr_op_string) : 0)
+			 + 6 /* parenthesis, a comma, a blank and quotes */  + strlen (default_expr_type_string)
+			 + (default_expr_format ? strlen (default_expr_format) : 0));
 
-	  penum_temp = penum_arg1;
-	  penum_arg1 = penum_result;
-	  penum_result = penum_temp;
+		  default_value_string = (char *) malloc (len + 1);
+		  if (default_value_string == NULL)
+		    {
+		      GOTO_EXIT_ON_ERROR;
+		    }
+
+		  strcpy (default_value_string, default_expr_op_string);
+		  strcat (default_value_string, "(");
+		  strcat (default_value_string, default_expr_type_string);
+		  if (default_expr_format)
+		    {
+		      strcat (default_value_string, ", \'");
+		      strcat (default_value_string, default_expr_format);
+		      strcat (default_value_string, "\'");
+		    }
 
-	  db_make_string (penum_arg2, enum_elements[i].str_val.medium.buf);
-	  if ((db_string_concatenate (penum_arg1, penum_arg2, penum_result, &data_stat) != NO_ERROR)
-	      || (data_stat != DATA_STATUS_OK))
-	    {
-	      pr_clear_value (penum_arg1);
-	      pr_clear_value (penum_arg2);
-	      goto exit_on_error;
-	    }
-	  pr_clear_value (penum_arg1);
+		  strcat (default_value_string, ")");
 
-	  penum_temp = penum_arg1;
-	  penum_arg1 = penum_result;
-	  penum_result = penum_temp;
-	  if (i < enum_elements_count - 1)
-	    {
-	      if ((db_string_concatenate (penum_arg1, &quote_comma_space, penum_result, &data_stat) != NO_ERROR)
-		  || (data_stat != DATA_STATUS_OK))
+		  db_make_string (out_values[idx_val], default_value_string);
+		  out_values[idx_val]->need_clear = true;
+		}
+	      else
 		{
-		  pr_clear_value (penum_arg1);
-		  pr_clear_value (penum_arg2);
-		  goto exit_on_error;
+		  if (default_expr_type_string)
+		    {
+		      db_make_string (out_values[idx_val], default_expr_type_string);
+		    }
 		}
+	      idx_val++;
+	    }
+	  else if (attrepr->current_default_value.value == NULL || attrepr->current_default_value.val_length <= 0)
+	    {
+	      db_make_null (out_values[idx_val]);
+	      idx_val++;
 	    }
 	  else
 	    {
-	      if ((db_string_concatenate (penum_arg1, &quote, penum_result, &data_stat) != NO_ERROR)
-		  || (data_stat != DATA_STATUS_OK))
+	      error = qexec_get_attr_default (thread_p, attrepr, out_values[idx_val]);
+	      if (error != NO_ERROR)
 		{
-		  pr_clear_value (penum_arg1);
-		  pr_clear_value (penum_arg2);
-		  goto exit_on_error;
+		  GOTO_EXIT_ON_ERROR;
 		}
-	    }
-	  pr_clear_value (penum_arg1);
-	  pr_clear_value (penum_arg2);
-	}
-
-      penum_temp = penum_arg1;
-      penum_arg1 = penum_result;
-      penum_result = penum_temp;
-      if ((db_string_concatenate (penum_arg1, &braket, penum_result, &data_stat) != NO_ERROR)
-	  || (data_stat != DATA_STATUS_OK))
-	{
-	  goto exit_on_error;
-	}
-      pr_clear_value (penum_arg1);
-      pr_clone_value (penum_result, result);
-      pr_clear_value (penum_result);
-
-      return NO_ERROR;
-    }
-  else if (setdomain != NULL)
-    {
-      /* process sequence */
-      DB_VALUE set_arg1, set_arg2, set_result, *pset_arg1, *pset_arg2, *pset_result, *pset_temp;
-      DB_DATA_STATUS data_stat;
-      DB_VALUE comma;
-      char **ordered_names = NULL, *min, *temp;
-      int count_names = 0, i, j, idx_min;
-
-      for (setdomain = domain->setdomain; setdomain; setdomain = setdomain->next)
-	{
-	  count_names++;
-	}
-
-      ordered_names = (char **) malloc (count_names * sizeof (char *));
-      if (ordered_names == NULL)
-	{
-	  return ER_OUT_OF_VIRTUAL_MEMORY;
-	}
-
-      for (setdomain = domain->setdomain, i = 0; setdomain; setdomain = setdomain->next, i++)
-	{
-	  ordered_names[i] = (char *) qexec_schema_get_type_name_from_id (setdomain->type->id);
-	}
-
-      for (i = 0; i < count_names - 1; i++)
-	{
-	  idx_min = i;
-	  min = ordered_names[i];
-	  for (j = i + 1; j < count_names; j++)
-	    {
-	      if (strcmp (ordered_names[i], ordered_names[j]) > 0)
+	      if (!DB_IS_NULL (out_values[idx_val]))
 		{
-		  min = ordered_names[j];
-		  idx_min = j;
+		  valcnv_convert_value_to_string (out_values[idx_val]);
 		}
+	      idx_val++;
 	    }
 
-	  if (idx_min != i)
+	  /* attribute has auto_increment or not */
+	  if (attrepr->is_autoincrement == 0)
 	    {
-	      temp = ordered_names[i];
-	      ordered_names[i] = ordered_names[idx_min];
-	      ordered_names[idx_min] = temp;
+	      db_make_string (out_values[idx_val], "");
 	    }
-	}
-
-      pset_arg1 = &set_arg1;
-      pset_arg2 = &set_arg2;
-      pset_result = &set_result;
-
-      db_make_string (&comma, ",");
-      db_make_string (pset_result, set_of_string);
-
-      for (setdomain = domain->setdomain, i = 0; setdomain; setdomain = setdomain->next, i++)
-	{
-	  pset_temp = pset_arg1;
-	  pset_arg1 = pset_result;
-	  pset_result = pset_temp;
-	  db_make_string (pset_arg2, ordered_names[i]);
-	  if ((db_string_concatenate (pset_arg1, pset_arg2, pset_result, &data_stat) != NO_ERROR)
-	      || (data_stat != DATA_STATUS_OK))
+	  else
 	    {
-	      free_and_init (ordered_names);
-	      pr_clear_value (pset_arg1);
-	      pr_clear_value (pset_arg2);
-	      goto exit_on_error;
+	      db_make_string (out_values[idx_val], "auto_increment");
 	    }
-	  pr_clear_value (pset_arg1);
-	  pr_clear_value (pset_arg2);
 
-	  if (setdomain->next != NULL)
+	  if (attrepr->on_update_expr != DB_DEFAULT_NONE)
 	    {
-	      pset_temp = pset_arg1;
-	      pset_arg1 = pset_result;
-	      pset_result = pset_temp;
-	      if ((db_string_concatenate (pset_arg1, &comma, pset_result, &data_stat) != NO_ERROR)
-		  || (data_stat != DATA_STATUS_OK))
+	      const char *saved = db_get_string (out_values[idx_val]);
+	      size_t len = strlen (saved);
+
+	      const char *default_expr_op_string = db_default_expression_string (attrepr->on_update_expr);
+	      if (default_expr_op_string == NULL)
 		{
-		  free_and_init (ordered_names);
-		  pr_clear_value (pset_arg1);
-		  goto exit_on_error;
+		  GOTO_EXIT_ON_ERROR;
 		}
-	      pr_clear_value (pset_arg1);
-	    }
-	}
-
-      pr_clone_value (pset_result, result);
-      pr_clear_value (pset_result);
-      free_and_init (ordered_names);
-      return NO_ERROR;
-    }
-  else if (precision >= 0)
-    {
-      DB_VALUE db_int_scale, db_str_scale;
-      DB_VALUE db_int_precision, db_str_precision;
-      DB_VALUE prec_scale_result, prec_scale_arg1, *pprec_scale_arg1, *pprec_scale_result, *pprec_scale_temp;
-      DB_VALUE comma, bracket1, bracket2;
-      DB_DATA_STATUS data_stat;
 
-      db_make_int (&db_int_precision, precision);
-      db_make_null (&db_str_precision);
-      if (tp_value_cast (&db_int_precision, &db_str_precision, &tp_String_domain, false) != DOMAIN_COMPATIBLE)
-	{
-	  goto exit_on_error;
-	}
-      pprec_scale_arg1 = &prec_scale_arg1;
-      pprec_scale_result = &prec_scale_result;
-      db_make_string (&comma, ",");
-      db_make_string (&bracket1, "(");
-      db_make_string (&bracket2, ")");
-      db_make_string (pprec_scale_arg1, name);
+	      /* add whitespace character if saved is not an empty string */
+	      const char *on_update_string = "ON UPDATE ";
+	      size_t str_len = len + strlen (on_update_string) + strlen (default_expr_op_string) + 1;
+	      if (len != 0)
+		{
+		  str_len += 1;	// append space before
+		}
+	      char *str_val = (char *) db_private_alloc (thread_p, str_len);
 
-      if ((db_string_concatenate (pprec_scale_arg1, &bracket1, pprec_scale_result, &data_stat) != NO_ERROR)
-	  || (data_stat != DATA_STATUS_OK))
-	{
-	  pr_clear_value (pprec_scale_arg1);
-	  goto exit_on_error;
-	}
-      pr_clear_value (pprec_scale_arg1);
+	      if (str_val == NULL)
+		{
+		  GOTO_EXIT_ON_ERROR;
+		}
 
-      pprec_scale_temp = pprec_scale_arg1;
-      pprec_scale_arg1 = pprec_scale_result;
-      pprec_scale_result = pprec_scale_temp;
-      if ((db_string_concatenate (pprec_scale_arg1, &db_str_precision, pprec_scale_result, &data_stat) != NO_ERROR)
-	  || (data_stat != DATA_STATUS_OK))
-	{
-	  pr_clear_value (pprec_scale_arg1);
-	  goto exit_on_error;
-	}
-      pr_clear_value (&db_str_precision);
-      pr_clear_value (pprec_scale_arg1);
+	      strcpy (str_val, saved);
+	      if (len != 0)
+		{
+		  strcat (str_val, " ");
+		}
+	      strcat (str_val, on_update_string);
+	      strcat (str_val, default_expr_op_string);
 
-      if (scale >= 0)
-	{
-	  db_make_int (&db_int_scale, scale);
-	  db_make_null (&db_str_scale);
-	  if (tp_value_cast (&db_int_scale, &db_str_scale, &tp_String_domain, false) != DOMAIN_COMPATIBLE)
-	    {
-	      pr_clear_value (pprec_scale_result);
-	      goto exit_on_error;
+	      if (default_expr_op_string)
+		{
+		  pr_clear_value (out_values[idx_val]);
+		  db_make_string (out_values[idx_val], str_val);
+		  out_values[idx_val]->need_clear = true;
+		}
 	    }
+	  idx_val++;
 
-	  pprec_scale_temp = pprec_scale_arg1;
-	  pprec_scale_arg1 = pprec_scale_result;
-	  pprec_scale_result = pprec_scale_temp;
-	  if ((db_string_concatenate (pprec_scale_arg1, &comma, pprec_scale_result, &data_stat) != NO_ERROR)
-	      || (data_stat != DATA_STATUS_OK))
+	  /* attribute's comment */
+	  if (full_columns)
 	    {
-	      pr_clear_value (pprec_scale_arg1);
-	      goto exit_on_error;
+	      int alloced_string = 0;
+	      char *string = NULL;
+
+	      error = or_get_attrcomment (&class_record, attrepr->id, &string, &alloced_string);
+	      if (error != NO_ERROR)
+		{
+		  ASSERT_ERROR ();
+		  return error;
+		}
+
+	      attr_comment = string;
+	      db_make_string (out_values[idx_val], attr_comment);
+	      if (string != NULL && alloced_string == 1)
+		{
+		  out_values[idx_val]->need_clear = true;
+		}
+	      idx_val++;
 	    }
-	  pr_clear_value (pprec_scale_arg1);
 
-	  pprec_scale_temp = pprec_scale_arg1;
-	  pprec_scale_arg1 = pprec_scale_result;
-	  pprec_scale_result = pprec_scale_temp;
-	  if ((db_string_concatenate (pprec_scale_arg1, &db_str_scale, pprec_scale_result, &data_stat) != NO_ERROR)
-	      || (data_stat != DATA_STATUS_OK))
+	  qexec_end_one_iteration (thread_p, xasl, xasl_state, &tplrec);
+
+	  for (j = 1; j < size_values; j++)
 	    {
-	      pr_clear_value (pprec_scale_arg1);
-	      goto exit_on_error;
+	      pr_clear_value (out_values[j]);
 	    }
-	  pr_clear_value (&db_str_scale);
-	  pr_clear_value (pprec_scale_arg1);
 	}
+      pr_clear_value (out_values[0]);
+    }
 
-      pprec_scale_temp = pprec_scale_arg1;
-      pprec_scale_arg1 = pprec_scale_result;
-      pprec_scale_result = pprec_scale_temp;
-      if ((db_string_concatenate (pprec_scale_arg1, &bracket2, pprec_scale_result, &data_stat) != NO_ERROR)
-	  || (data_stat != DATA_STATUS_OK))
-	{
-	  pr_clear_value (pprec_scale_arg1);
-	  goto exit_on_error;
-	}
-      pr_clear_value (pprec_scale_arg1);
+  free_and_init (out_values);
 
-      pr_clone_value (pprec_scale_result, result);
-      pr_clear_value (pprec_scale_result);
+  heap_classrepr_free_and_init (rep, &idx_incache);
+  if (heap_scancache_end (thread_p, &scan) != NO_ERROR)
+    {
+      GOTO_EXIT_ON_ERROR;
+    }
+  scancache_inited = false;
 
-      return NO_ERROR;
+  if (qexec_end_mainblock_iterations (thread_p, xasl, xasl_state, &tplrec) != NO_ERROR)
+    {
+      GOTO_EXIT_ON_ERROR;
     }
-  else if (validator != NULL)
+
+  if (tplrec.tpl)
     {
-      DB_DATA_STATUS data_stat;
-      DB_VALUE bracket1, bracket2, schema;
-      bool err = false;
+      db_private_free_and_init (thread_p, tplrec.tpl);
+    }
 
-      if (db_json_get_schema_raw_from_validator (validator) != NULL)
-	{
-	  db_make_string (result, name);
-	  db_make_string (&schema, db_json_get_schema_raw_from_validator (validator));
-	  db_make_string (&bracket1, "(\'");
-	  db_make_string (&bracket2, "\')");
+  if (save_heapid != 0)
+    {
+      (void) db_change_private_heap (thread_p, save_heapid);
+      save_heapid = 0;
+    }
 
-	  if (db_string_concatenate (result, &bracket1, result, &data_stat) != NO_ERROR
-	      || (data_stat != DATA_STATUS_OK)
-	      || db_string_concatenate (result, &schema, result, &data_stat) != NO_ERROR
-	      || (data_stat != DATA_STATUS_OK)
-	      || db_string_concatenate (result, &bracket2, result, &data_stat) != NO_ERROR
-	      || (data_stat != DATA_STATUS_OK))
-	    {
-	      err = true;
-	    }
+  return NO_ERROR;
 
-	  pr_clear_value (&schema);
+exit_on_error:
 
-	  if (err)
-	    {
-	      pr_clear_value (result);
-	      goto exit_on_error;
-	    }
+  if (out_values)
+    {
+      for (i = 0; i < size_values; i++)
+	{
+	  pr_clear_value (out_values[i]);
 	}
-      return NO_ERROR;
+
+      free_and_init (out_values);
     }
-  else
+
+  if (rep)
     {
-      db_make_string (result, name);
-      return NO_ERROR;
+      heap_classrepr_free_and_init (rep, &idx_incache);
     }
 
-exit_on_error:
-  return ER_FAILED;
+  if (scancache_inited)
+    {
+      heap_scancache_end (thread_p, &scan);
+    }
+
+#if defined(SERVER_MODE)
+  /* query execution error must be set up before qfile_close_list(). */
+  if (er_errid () < 0)
+    {
+      qmgr_set_query_error (thread_p, xasl_state->query_id);
+    }
+#endif
+
+  qfile_close_list (thread_p, xasl->list_id);
+
+  if (tplrec.tpl)
+    {
+      db_private_free_and_init (thread_p, tplrec.tpl);
+    }
+
+  if (save_heapid != 0)
+    {
+      (void) db_change_private_heap (thread_p, save_heapid);
+      save_heapid = 0;
+    }
+
+  xasl->status = XASL_FAILURE;
+
+  qexec_failure_line (__LINE__, xasl_state);
+
+  return (error == NO_ERROR && (error = er_errid ()) == NO_ERROR) ? ER_FAILED : error;
 }
 
 /*
- * qexec_execute_build_columns () - Execution function for BUILD SCHEMA proc
- *   return: NO_ERROR, or ER_code
- *   xasl(in): XASL tree
- *   xasl_state(in): XASL state
+ * qexec_create_internal_classes () - create internal classes used for
+ *				      internal update / delete execution
+ * return : error code or NO_ERROR
+ * thread_p (in)    :
+ * query_classes (in): query classes
+ * count (in)	    : number of query classes
+ * internal_classes (in/out) : internal classes array
  */
 static int
-qexec_execute_build_columns (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state)
+qexec_create_internal_classes (THREAD_ENTRY * thread_p, UPDDEL_CLASS_INFO * query_classes, int count,
+			       UPDDEL_CLASS_INFO_INTERNAL ** internal_classes)
 {
-  QFILE_TUPLE_RECORD tplrec = { NULL, 0 };
-  int idx_incache = -1;
-  OR_CLASSREP *rep = NULL;
-  OR_INDEX *index = NULL;
-  char *attr_name = NULL, *default_value_string = NULL;
-  const char *default_expr_type_string = NULL, *default_expr_format = NULL;
-  char *attr_comment = NULL;
-  OR_ATTRIBUTE *volatile attrepr = NULL;
-  DB_VALUE **out_values = NULL;
-  REGU_VARIABLE_LIST regu_var_p;
-  HEAP_SCANCACHE scan;
-  bool scancache_inited = false;
-  RECDES class_record;
-  OID *class_oid = NULL;
-  volatile int idx_val;
-  volatile int error = NO_ERROR;
-  int i, j, k, idx_all_attr, size_values, found_index_type = -1;
-  bool search_index_type = true;
-  BTID *btid;
-  int index_type_priorities[] = { 1, 0, 1, 0, 2, 0 };
-  int index_type_max_priority = 2;
-  DB_VALUE def_order, attr_class_type;
-  OR_ATTRIBUTE *all_class_attr[3];
-  int all_class_attr_lengths[3];
-  bool full_columns = false;
-  char *string = NULL;
-  int alloced_string = 0;
-  HL_HEAPID save_heapid = 0;
+  UPDDEL_CLASS_INFO_INTERNAL *class_ = NULL, *classes = NULL;
+  UPDDEL_CLASS_INFO *query_class = NULL;
+  size_t size;
+  int i = 0, error = NO_ERROR;
 
-  if (xasl == NULL || xasl_state == NULL)
+  if (internal_classes == NULL)
     {
+      assert (false);
       return ER_FAILED;
     }
+  *internal_classes = NULL;
 
-  for (regu_var_p = xasl->outptr_list->valptrp, i = 0; regu_var_p; regu_var_p = regu_var_p->next, i++)
+  size = count * sizeof (UPDDEL_CLASS_INFO_INTERNAL);
+  classes = (UPDDEL_CLASS_INFO_INTERNAL *) db_private_alloc (thread_p, size);
+  if (classes == NULL)
     {
-      if (REGU_VARIABLE_IS_FLAGED (&regu_var_p->value, REGU_VARIABLE_CLEAR_AT_CLONE_DECACHE))
+      return ER_FAILED;
+    }
+
+  /* initialize internal structures */
+  for (i = 0; i < count; i++)
+    {
+      query_class = query_classes + i;
+      class_ = &(classes[i]);
+      class_->oid = NULL;
+      class_->class_hfid = NULL;
+      class_->class_oid = NULL;
+      class_->needs_pruning = DB_NOT_PARTITIONED_CLASS;
+      class_->subclass_idx = -1;
+      class_->scan_cache = NULL;
+      OID_SET_NULL (&class_->prev_class_oid);
+      class_->is_attr_info_inited = 0;
+
+      class_->num_lob_attrs = 0;
+      class_->lob_attr_ids = NULL;
+      class_->crt_del_lob_info = NULL;
+      class_->m_unique_stats.construct ();
+      class_->extra_assign_reev_cnt = 0;
+      class_->mvcc_extra_assign_reev = NULL;
+      class_->mvcc_reev_assigns = NULL;
+
+      partition_init_pruning_context (&class_->context);
+
+      class_->m_inited_scancache = false;
+
+      if (query_class->needs_pruning)
 	{
-	  save_heapid = db_change_private_heap (thread_p, 0);
-	  break;
+	  /* set partition information here */
+	  class_->needs_pruning = query_class->needs_pruning;
+	  error =
+	    partition_load_pruning_context (thread_p, &query_class->class_oid[0], class_->needs_pruning,
+					    &class_->context);
+	  if (error != NO_ERROR)
+	    {
+	      goto exit_on_error;
+	    }
 	}
     }
 
-  if (qexec_start_mainblock_iterations (thread_p, xasl, xasl_state) != NO_ERROR)
+  *internal_classes = classes;
+
+  return NO_ERROR;
+
+exit_on_error:
+  if (classes)
     {
-      GOTO_EXIT_ON_ERROR;
+      qexec_clear_internal_classes (thread_p, classes, i + 1);
+      db_private_free (thread_p, classes);
     }
 
-  heap_scancache_quick_start_root_hfid (thread_p, &scan);
-  scancache_inited = true;
+  return (error == NO_ERROR) ? NO_ERROR : er_errid ();
 
-  assert (xasl_state != NULL);
-  class_oid = &(xasl->spec_list->s.cls_node.cls_oid);
+}
+
+/*
+ * qexec_create_internal_assignments () - create and initialize structures for
+ *					  MVCC assignments reevaluation
+ * return : error code or NO_ERROR
+ * thread_p (in) :
+ * aptr (in): XASL for generated SELECT statement for UPDATE
+ * should_delete (in):
+ * classes (in) : internal classes array
+ * num_classes (in) : count internal classes array elements
+ * num_assignments (in) : no of assignments
+ * assignments(in): array of assignments received from client
+ * mvcc_reev_assigns (in/out) : allocated array of assignments used in
+ *				reevaluation
+ */
+static int
+qexec_create_mvcc_reev_assignments (THREAD_ENTRY * thread_p, XASL_NODE * aptr, bool should_delete,
+				    UPDDEL_CLASS_INFO_INTERNAL * classes, int num_classes, int num_assignments,
+				    UPDATE_ASSIGNMENT * assignments, UPDATE_MVCC_REEV_ASSIGNMENT ** mvcc_reev_assigns)
+{
+  int idx, new_assign_idx, count;
+  UPDDEL_CLASS_INFO_INTERNAL *claz = NULL;
+  UPDATE_ASSIGNMENT *assign = NULL;
+  UPDATE_MVCC_REEV_ASSIGNMENT *new_assigns = NULL, *new_assign = NULL, *prev_new_assign = NULL;
+  REGU_VARIABLE_LIST regu_var = NULL;
+  OUTPTR_LIST *outptr_list = NULL;
 
-  if (heap_get_class_record (thread_p, class_oid, &class_record, &scan, PEEK) != S_SUCCESS)
+  if (mvcc_reev_assigns == NULL || !num_assignments)
     {
-      GOTO_EXIT_ON_ERROR;
+      return NO_ERROR;
     }
 
-  rep = heap_classrepr_get (thread_p, class_oid, &class_record, NULL_REPRID, &idx_incache);
-  if (rep == NULL)
-    {
-      GOTO_EXIT_ON_ERROR;
-    }
+  outptr_list = aptr->outptr_list;
 
-  size_values = xasl->outptr_list->valptr_cnt;
-  out_values = (DB_VALUE **) malloc (size_values * sizeof (DB_VALUE *));
-  if (out_values == NULL)
-    {
-      GOTO_EXIT_ON_ERROR;
-    }
+  count = aptr->upd_del_class_cnt + aptr->mvcc_reev_extra_cls_cnt;
+  /* skip OID - CLASS OID pairs and should_delete */
+  for (idx = 0, regu_var = outptr_list->valptrp; idx < count; idx++, regu_var = regu_var->next->next)
+    ;
 
-  for (regu_var_p = xasl->outptr_list->valptrp, i = 0; regu_var_p; regu_var_p = regu_var_p->next, i++)
+  if (should_delete)
     {
-      out_values[i] = &(regu_var_p->value.value.dbval);
-      pr_clear_value (out_values[i]);
+      regu_var = regu_var->next;
     }
 
-  all_class_attr[0] = rep->attributes;
-  all_class_attr_lengths[0] = rep->n_attributes;
-  all_class_attr[1] = rep->class_attrs;
-  all_class_attr_lengths[1] = rep->n_class_attrs;
-  all_class_attr[2] = rep->shared_attrs;
-  all_class_attr_lengths[2] = rep->n_shared_attrs;
-
-  if (xasl->spec_list->s.cls_node.schema_type == FULL_COLUMNS_SCHEMA)
+  new_assigns =
+    (UPDATE_MVCC_REEV_ASSIGNMENT *) db_private_alloc (thread_p, sizeof (UPDATE_MVCC_REEV_ASSIGNMENT) * num_assignments);
+  if (new_assigns == NULL)
     {
-      full_columns = true;
+      return ER_FAILED;
     }
 
-  for (idx_all_attr = 0; idx_all_attr < 3; idx_all_attr++)
+  for (idx = 0, new_assign_idx = 0; idx < num_assignments; idx++)
     {
-      /* attribute class type */
-      db_make_int (&attr_class_type, idx_all_attr);
-      error = db_value_coerce (&attr_class_type, out_values[0], db_type_to_db_domain (DB_TYPE_VARCHAR));
-      if (error != NO_ERROR)
+      assign = &assignments[idx];
+      claz = &classes[assign->cls_idx];
+
+      new_assign = &new_assigns[new_assign_idx++];
+      new_assign->constant = assign->constant;
+      if (new_assign->constant == NULL)
 	{
-	  GOTO_EXIT_ON_ERROR;
+	  new_assign->regu_right = &regu_var->value;
+	  regu_var = regu_var->next;
 	}
-
-      for (i = 0, attrepr = all_class_attr[idx_all_attr]; i < all_class_attr_lengths[idx_all_attr]; i++, attrepr++)
+      else
 	{
-	  idx_val = 1;
-	  /* attribute def order */
-	  db_make_int (&def_order, attrepr->def_order);
-	  error = db_value_coerce (&def_order, out_values[idx_val++], db_type_to_db_domain (DB_TYPE_VARCHAR));
-	  if (error != NO_ERROR)
-	    {
-	      GOTO_EXIT_ON_ERROR;
-	    }
-
-	  /* attribute name */
-	  string = NULL;
-	  alloced_string = 0;
-
-	  error = or_get_attrname (&class_record, attrepr->id, &string, &alloced_string);
-	  if (error != NO_ERROR)
-	    {
-	      ASSERT_ERROR ();
-	      GOTO_EXIT_ON_ERROR;
-	    }
-
-	  attr_name = string;
-	  db_make_string (out_values[idx_val], attr_name);
-	  if (string != NULL && alloced_string == 1)
-	    {
-	      out_values[idx_val]->need_clear = true;
-	    }
-	  idx_val++;
-
-	  /* attribute type */
-	  (void) qexec_schema_get_type_desc (attrepr->type, attrepr->domain, out_values[idx_val++]);
-
-	  /* collation */
-	  if (full_columns)
-	    {
-	      switch (attrepr->type)
-		{
-		case DB_TYPE_VARCHAR:
-		case DB_TYPE_CHAR:
-		case DB_TYPE_NCHAR:
-		case DB_TYPE_VARNCHAR:
-		case DB_TYPE_ENUMERATION:
-		  db_make_string (out_values[idx_val], lang_get_collation_name (attrepr->domain->collation_id));
-		  break;
-		default:
-		  db_make_null (out_values[idx_val]);
-		}
-	      idx_val++;
-	    }
-
-	  /* attribute can store NULL ? */
-	  if (attrepr->is_notnull == 0)
-	    {
-	      db_make_string (out_values[idx_val], "YES");
-	    }
-	  else
-	    {
-	      db_make_string (out_values[idx_val], "NO");
-	    }
-	  idx_val++;
-
-	  /* attribute has index or not */
-	  found_index_type = -1;
-	  search_index_type = true;
-	  for (j = 0; j < attrepr->n_btids && search_index_type; j++)
-	    {
-	      btid = attrepr->btids + j;
-
-	      for (k = 0; k < rep->n_indexes; k++)
-		{
-		  index = rep->indexes + k;
-		  if (BTID_IS_EQUAL (btid, &index->btid))
-		    {
-		      if (found_index_type == -1
-			  || index_type_priorities[index->type] > index_type_priorities[found_index_type])
-			{
-			  found_index_type = index->type;
-			  if (index_type_priorities[found_index_type] == index_type_max_priority)
-			    {
-			      /* stop searching */
-			      search_index_type = false;
-			    }
-			}
-		      break;
-		    }
-		}
-	    }
-
-	  switch (found_index_type)
+	  new_assign->regu_right = NULL;
+	}
+      new_assign->next = NULL;
+      if (claz->mvcc_reev_assigns == NULL)
+	{
+	  claz->mvcc_reev_assigns = new_assign;
+	}
+      else
+	{
+	  prev_new_assign = claz->mvcc_reev_assigns;
+	  while (prev_new_assign->next != NULL)
 	    {
-	    case BTREE_UNIQUE:
-	    case BTREE_REVERSE_UNIQUE:
-	      db_make_string (out_values[idx_val], "UNI");
-	      break;
-
-	    case BTREE_INDEX:
-	    case BTREE_REVERSE_INDEX:
-	    case BTREE_FOREIGN_KEY:
-	      db_make_string (out_values[idx_val], "MUL");
-	      break;
-
-	    case BTREE_PRIMARY_KEY:
-	      db_make_string (out_values[idx_val], "PRI");
-	      break;
-
-	    default:
-	      db_make_string (out_values[idx_val], "");
-	      break;
+	      prev_new_assign = prev_new_assign->next;
 	    }
-	  idx_val++;
-
-	  /* default values */
-	  alloced_string = 0;
-	  if (attrepr->default_value.default_expr.default_expr_type != DB_DEFAULT_NONE)
-	    {
-	      const char *default_expr_op_string = NULL;
-
-	      default_expr_type_string =
-		db_default_expression_string (attrepr->default_value.default_expr.default_expr_type);
+	  prev_new_assign->next = new_assign;
+	}
+    }
 
-	      if (attrepr->default_value.default_expr.default_expr_op == T_TO_CHAR)
-		{
-		  size_t len;
+  *mvcc_reev_assigns = new_assigns;
 
-		  default_expr_op_string = qdump_operator_type_string (T_TO_CHAR);
-		  default_expr_format = attrepr->default_value.default_expr.default_expr_format;
+  return NO_ERROR;
+}
 
-		  len = ((default_expr_op_string ? strlen (default_expr_op_string) : 0)
-			 + 6 /* parenthesis, a comma, a blank and quotes */  + strlen (default_expr_type_string)
-			 + (default_expr_format ? strlen (default_expr_format) : 0));
+/*
+ * qexec_clear_internal_classes () - clear memory allocated for classes
+ * return : void
+ * thread_p (in) :
+ * classes (in)	 : classes array
+ * count (in)	 : number of elements in the array
+ */
+static void
+qexec_clear_internal_classes (THREAD_ENTRY * thread_p, UPDDEL_CLASS_INFO_INTERNAL * classes, int count)
+{
+  int i;
+  UPDDEL_CLASS_INFO_INTERNAL *cls_int = NULL;
 
-		  default_value_string = (char *) malloc (len + 1);
-		  if (default_value_string == NULL)
-		    {
-		      GOTO_EXIT_ON_ERROR;
-		    }
+  for (i = 0; i < count; i++)
+    {
+      cls_int = &classes[i];
+      if (cls_int->m_inited_scancache)
+	{
+	  locator_end_force_scan_cache (thread_p, &cls_int->m_scancache);
+	}
+      cls_int->m_unique_stats.clear ();
+      if (cls_int->is_attr_info_inited)
+	{
+	  heap_attrinfo_end (thread_p, &cls_int->attr_info);
+	}
+      if (cls_int->needs_pruning)
+	{
+	  partition_clear_pruning_context (&cls_int->context);
+	}
+      if (cls_int->mvcc_extra_assign_reev != NULL)
+	{
+	  db_private_free_and_init (thread_p, cls_int->mvcc_extra_assign_reev);
+	}
+      cls_int->m_unique_stats.destruct ();
+    }
+}
 
-		  strcpy (default_value_string, default_expr_op_string);
-		  strcat (default_value_string, "(");
-		  strcat (default_value_string, default_expr_type_string);
-		  if (default_expr_format)
-		    {
-		      strcat (default_value_string, ", \'");
-		      strcat (default_value_string, default_expr_format);
-		      strcat (default_value_string, "\'");
-		    }
+/*
+ * qexec_upddel_mvcc_set_filters () - setup current class filters
+ *				      in a class hierarchy
+ * return : error code or NO_ERROR
+ * thread_p (in) :
+ * aptr_list (in) :
+ * mvcc_data_filter (in) : filter info
+ * class_oid (in) : class oid
+ *
+ * Note: this function is used only in MVCC
+ */
+static int
+qexec_upddel_mvcc_set_filters (THREAD_ENTRY * thread_p, XASL_NODE * aptr_list,
+			       UPDDEL_MVCC_COND_REEVAL * mvcc_reev_class, OID * class_oid)
+{
+  ACCESS_SPEC_TYPE *curr_spec = NULL;
 
-		  strcat (default_value_string, ")");
+  while (aptr_list != NULL && curr_spec == NULL)
+    {
+      curr_spec = aptr_list->spec_list;
+      while (curr_spec != NULL && !OID_EQ (&(curr_spec->s.cls_node.cls_oid), class_oid))
+	{
+	  curr_spec = curr_spec->next;
+	}
+      aptr_list = aptr_list->scan_ptr;
+    }
 
-		  db_make_string (out_values[idx_val], default_value_string);
-		  out_values[idx_val]->need_clear = true;
-		}
-	      else
-		{
-		  if (default_expr_type_string)
-		    {
-		      db_make_string (out_values[idx_val], default_expr_type_string);
-		    }
-		}
-	      idx_val++;
-	    }
-	  else if (attrepr->current_default_value.value == NULL || attrepr->current_default_value.val_length <= 0)
-	    {
-	      db_make_null (out_values[idx_val]);
-	      idx_val++;
-	    }
-	  else
-	    {
-	      error = qexec_get_attr_default (thread_p, attrepr, out_values[idx_val]);
-	      if (error != NO_ERROR)
-		{
-		  GOTO_EXIT_ON_ERROR;
-		}
-	      if (!DB_IS_NULL (out_values[idx_val]))
-		{
-		  valcnv_convert_value_to_string (out_values[idx_val]);
-		}
-	      idx_val++;
-	    }
+  if (curr_spec == NULL)
+    {
+      return ER_FAILED;
+    }
 
-	  /* attribute has auto_increment or not */
-	  if (attrepr->is_autoincrement == 0)
-	    {
-	      db_make_string (out_values[idx_val], "");
-	    }
-	  else
-	    {
-	      db_make_string (out_values[idx_val], "auto_increment");
-	    }
+  mvcc_reev_class->init (curr_spec->s_id);
+  mvcc_reev_class->cls_oid = *class_oid;
 
-	  if (attrepr->on_update_expr != DB_DEFAULT_NONE)
-	    {
-	      const char *saved = db_get_string (out_values[idx_val]);
-	      size_t len = strlen (saved);
+  return NO_ERROR;
+}
 
-	      const char *default_expr_op_string = db_default_expression_string (attrepr->on_update_expr);
-	      if (default_expr_op_string == NULL)
-		{
-		  GOTO_EXIT_ON_ERROR;
-		}
+/*
+ * qexec_upddel_setup_current_class () - setup current class info in a class
+ *					 hierarchy
+ * return : error code or NO_ERROR
+ * thread_p (in) :
+ * query_class (in) : query class information
+ * internal_class (in) : internal class
+ * op_type (in) : operation type
+ * current_oid (in): class oid
+ *
+ * Note: this function is used for update and delete to find class hfid when
+ *  the operation is performed on a class hierarchy
+ */
+static int
+qexec_upddel_setup_current_class (THREAD_ENTRY * thread_p, UPDDEL_CLASS_INFO * query_class,
+				  UPDDEL_CLASS_INFO_INTERNAL * internal_class, int op_type, OID * current_oid)
+{
+  int i = 0;
+  int error = NO_ERROR;
 
-	      /* add whitespace character if saved is not an empty string */
-	      const char *on_update_string = "ON UPDATE ";
-	      size_t str_len = len + strlen (on_update_string) + strlen (default_expr_op_string) + 1;
-	      if (len != 0)
-		{
-		  str_len += 1;	// append space before
-		}
-	      char *str_val = (char *) db_private_alloc (thread_p, str_len);
+  internal_class->class_oid = NULL;
+  internal_class->class_hfid = NULL;
 
-	      if (str_val == NULL)
-		{
-		  GOTO_EXIT_ON_ERROR;
-		}
+  /* Find class HFID */
+  if (internal_class->needs_pruning)
+    {
+      /* test root class */
+      if (OID_EQ (&query_class->class_oid[0], current_oid))
+	{
+	  internal_class->class_oid = &query_class->class_oid[0];
+	  internal_class->class_hfid = &query_class->class_hfid[0];
+	  internal_class->subclass_idx = 0;
 
-	      strcpy (str_val, saved);
-	      if (len != 0)
+	  internal_class->num_lob_attrs = 0;
+	  internal_class->lob_attr_ids = NULL;
+	}
+      else
+	{
+	  /* look through the class partitions for the current_oid */
+	  for (i = 0; i < internal_class->context.count; i++)
+	    {
+	      if (OID_EQ (&internal_class->context.partitions[i].class_oid, current_oid))
 		{
-		  strcat (str_val, " ");
-		}
-	      strcat (str_val, on_update_string);
-	      strcat (str_val, default_expr_op_string);
+		  internal_class->class_oid = &internal_class->context.partitions[i].class_oid;
+		  internal_class->class_hfid = &internal_class->context.partitions[i].class_hfid;
+		  internal_class->subclass_idx = 0;
 
-	      if (default_expr_op_string)
-		{
-		  pr_clear_value (out_values[idx_val]);
-		  db_make_string (out_values[idx_val], str_val);
-		  out_values[idx_val]->need_clear = true;
+		  internal_class->num_lob_attrs = 0;
+		  internal_class->lob_attr_ids = NULL;
+		  break;
 		}
 	    }
-	  idx_val++;
-
-	  /* attribute's comment */
-	  if (full_columns)
+	}
+    }
+  else
+    {
+      /* look through subclasses */
+      for (i = 0; i < query_class->num_subclasses; i++)
+	{
+	  if (OID_EQ (&query_class->class_oid[i], current_oid))
 	    {
-	      int alloced_string = 0;
-	      char *string = NULL;
+	      internal_class->class_oid = &query_class->class_oid[i];
+	      internal_class->class_hfid = &query_class->class_hfid[i];
+	      internal_class->subclass_idx = i;
 
-	      error = or_get_attrcomment (&class_record, attrepr->id, &string, &alloced_string);
-	      if (error != NO_ERROR)
+	      if (query_class->num_lob_attrs && query_class->lob_attr_ids)
 		{
-		  ASSERT_ERROR ();
-		  return error;
+		  internal_class->num_lob_attrs = query_class->num_lob_attrs[i];
+		  internal_class->lob_attr_ids = query_class->lob_attr_ids[i];
 		}
-
-	      attr_comment = string;
-	      db_make_string (out_values[idx_val], attr_comment);
-	      if (string != NULL && alloced_string == 1)
+	      else
 		{
-		  out_values[idx_val]->need_clear = true;
+		  internal_class->num_lob_attrs = 0;
+		  internal_class->lob_attr_ids = NULL;
 		}
-	      idx_val++;
-	    }
-
-	  qexec_end_one_iteration (thread_p, xasl, xasl_state, &tplrec);
-
-	  for (j = 1; j < size_values; j++)
-	    {
-	      pr_clear_value (out_values[j]);
+	      break;
 	    }
 	}
-      pr_clear_value (out_values[0]);
     }
 
-  free_and_init (out_values);
-
-  heap_classrepr_free_and_init (rep, &idx_incache);
-  if (heap_scancache_end (thread_p, &scan) != NO_ERROR)
+  if (internal_class->class_hfid == NULL)
     {
-      GOTO_EXIT_ON_ERROR;
+      return ER_FAILED;
     }
-  scancache_inited = false;
 
-  if (qexec_end_mainblock_iterations (thread_p, xasl, xasl_state, &tplrec) != NO_ERROR)
+  /* Start a HEAP_SCANCACHE object on the new class. Partitioned classes and class hierarchies are handled differently */
+  if (internal_class->needs_pruning)
     {
-      GOTO_EXIT_ON_ERROR;
+      /* Get a scan_cache object from the pruning context. We don't close the previous one here, it will be closed when
+       * the pruning context is cleared. */
+      PRUNING_SCAN_CACHE *pcache = NULL;
+      pcache =
+	locator_get_partition_scancache (&internal_class->context, internal_class->class_oid,
+					 internal_class->class_hfid, op_type, false);
+      if (pcache == NULL)
+	{
+	  return ER_FAILED;
+	}
+      internal_class->scan_cache = &pcache->scan_cache;
     }
-
-  if (tplrec.tpl)
+  else
     {
-      db_private_free_and_init (thread_p, tplrec.tpl);
+      if (internal_class->m_inited_scancache)
+	{
+	  if (query_class->has_uniques && BTREE_IS_MULTI_ROW_OP (op_type))
+	    {
+	      /* In this case, consider class hierarchy as well as single class. Therefore, construct the local
+	       * statistical information by collecting the statistical information during scanning on each class of
+	       * class hierarchy. */
+	      qexec_update_btree_unique_stats_info (thread_p, &internal_class->m_unique_stats,
+						    &internal_class->m_scancache);
+	    }
+	  (void) locator_end_force_scan_cache (thread_p, &internal_class->m_scancache);
+	  internal_class->m_inited_scancache = false;
+	}
+      error =
+	locator_start_force_scan_cache (thread_p, &internal_class->m_scancache, internal_class->class_hfid,
+					internal_class->class_oid, op_type);
+      if (error != NO_ERROR)
+	{
+	  return error;
+	}
+      internal_class->m_inited_scancache = true;
+      internal_class->scan_cache = &internal_class->m_scancache;
+      internal_class->scan_cache->mvcc_snapshot = logtb_get_mvcc_snapshot (thread_p);
+
     }
+  COPY_OID (&internal_class->prev_class_oid, current_oid);
 
-  if (save_heapid != 0)
+  return NO_ERROR;
+}
+
+/*
+ * qexec_execute_merge () - Execution function for MERGE proc
+ *   return: NO_ERROR, or ER_code
+ *   xasl(in): XASL tree
+ *   xasl_state(in): XASL state
+ */
+static int
+qexec_execute_merge (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state)
+{
+  int error = NO_ERROR;
+  int savepoint_used = 0;
+  LOG_LSA lsa;
+
+  /* start a topop */
+  error = xtran_server_start_topop (thread_p, &lsa);
+  if (error != NO_ERROR)
     {
-      (void) db_change_private_heap (thread_p, save_heapid);
-      save_heapid = 0;
+      GOTO_EXIT_ON_ERROR;
     }
+  savepoint_used = 1;
 
-  return NO_ERROR;
-
-exit_on_error:
-
-  if (out_values)
+  /* execute insert aptr */
+  if (xasl->proc.merge.insert_xasl)
     {
-      for (i = 0; i < size_values; i++)
+      XASL_NODE *xptr = xasl->proc.merge.insert_xasl;
+      if (xptr && xptr->aptr_list)
 	{
-	  pr_clear_value (out_values[i]);
+	  error = qexec_execute_mainblock (thread_p, xptr->aptr_list, xasl_state, NULL);
 	}
-
-      free_and_init (out_values);
-    }
-
-  if (rep)
-    {
-      heap_classrepr_free_and_init (rep, &idx_incache);
     }
-
-  if (scancache_inited)
+  /* execute update */
+  if (error == NO_ERROR && xasl->proc.merge.update_xasl)
     {
-      heap_scancache_end (thread_p, &scan);
+      error = qexec_execute_update (thread_p, xasl->proc.merge.update_xasl, xasl->proc.merge.has_delete, xasl_state);
     }
-
-#if defined(SERVER_MODE)
-  /* query execution error must be set up before qfile_close_list(). */
-  if (er_errid () < 0)
+  /* execute insert */
+  if (error == NO_ERROR && xasl->proc.merge.insert_xasl)
     {
-      qmgr_set_query_error (thread_p, xasl_state->query_id);
+      error = qexec_execute_insert (thread_p, xasl->proc.merge.insert_xasl, xasl_state, true);
     }
-#endif
-
-  qfile_close_list (thread_p, xasl->list_id);
 
-  if (tplrec.tpl)
+  /* check error */
+  if (error != NO_ERROR)
     {
-      db_private_free_and_init (thread_p, tplrec.tpl);
+      GOTO_EXIT_ON_ERROR;
     }
 
-  if (save_heapid != 0)
+  /* setup list file for result count */
+  error = qexec_setup_list_id (thread_p, xasl);
+  if (error != NO_ERROR)
     {
-      (void) db_change_private_heap (thread_p, save_heapid);
-      save_heapid = 0;
+      GOTO_EXIT_ON_ERROR;
     }
 
-  xasl->status = XASL_FAILURE;
-
-  qexec_failure_line (__LINE__, xasl_state);
-
-  return (error == NO_ERROR && (error = er_errid ()) == NO_ERROR) ? ER_FAILED : error;
-}
-
-/*
- * qexec_create_internal_classes () - create internal classes used for
- *				      internal update / delete execution
- * return : error code or NO_ERROR
- * thread_p (in)    :
- * query_classes (in): query classes
- * count (in)	    : number of query classes
- * internal_classes (in/out) : internal classes array
- */
-static int
-qexec_create_internal_classes (THREAD_ENTRY * thread_p, UPDDEL_CLASS_INFO * query_classes, int count,
-			       UPDDEL_CLASS_INFO_INTERNAL ** internal_classes)
-{
-  UPDDEL_CLASS_INFO_INTERNAL *class_ = NULL, *classes = NULL;
-  UPDDEL_CLASS_INFO *query_class = NULL;
-  size_t size;
-  int i = 0, error = NO_ERROR;
+  xasl->list_id->tuple_cnt = 0;
 
-  if (internal_classes == NULL)
+  /* set result count */
+  if (xasl->proc.merge.update_xasl)
     {
-      assert (false);
-      return ER_FAILED;
+      xasl->list_id->tuple_cnt += xasl->proc.merge.update_xasl->list_id->tuple_cnt;
+      /* monitor */
+      perfmon_inc_stat (thread_p, PSTAT_QM_NUM_UPDATES);
     }
-  *internal_classes = NULL;
 
-  size = count * sizeof (UPDDEL_CLASS_INFO_INTERNAL);
-  classes = (UPDDEL_CLASS_INFO_INTERNAL *) db_private_alloc (thread_p, size);
-  if (classes == NULL)
+  if (xasl->proc.merge.insert_xasl)
     {
-      return ER_FAILED;
+      xasl->list_id->tuple_cnt += xasl->proc.merge.insert_xasl->list_id->tuple_cnt;
+      /* monitor */
+      perfmon_inc_stat (thread_p, PSTAT_QM_NUM_INSERTS);
     }
 
-  /* initialize internal structures */
-  for (i = 0; i < count; i++)
+  /* end topop */
+  if (xtran_server_end_topop (thread_p, LOG_RESULT_TOPOP_ATTACH_TO_OUTER, &lsa) != TRAN_ACTIVE)
     {
-      query_class = query_classes + i;
-      class_ = &(classes[i]);
-      class_->oid = NULL;
-      class_->class_hfid = NULL;
-      class_->class_oid = NULL;
-      class_->needs_pruning = DB_NOT_PARTITIONED_CLASS;
-      class_->subclass_idx = -1;
-      class_->scan_cache = NULL;
-      OID_SET_NULL (&class_->prev_class_oid);
-      class_->is_attr_info_inited = 0;
-
-      class_->num_lob_attrs = 0;
-      class_->lob_attr_ids = NULL;
-      class_->crt_del_lob_info = NULL;
-      class_->m_unique_stats.construct ();
-      class_->extra_assign_reev_cnt = 0;
-      class_->mvcc_extra_assign_reev = NULL;
-      class_->mvcc_reev_assigns = NULL;
-
-      partition_init_pruning_context (&class_->context);
-
-      class_->m_inited_scancache = false;
-
-      if (query_class->needs_pruning)
-	{
-	  /* set partition information here */
-	  class_->needs_pruning = query_class->needs_pruning;
-	  error =
-	    partition_load_pruning_context (thread_p, &query_class->class_oid[0], class_->needs_pruning,
-					    &class_->context);
-	  if (error != NO_ERROR)
-	    {
-	      goto exit_on_error;
-	    }
-	}
+      GOTO_EXIT_ON_ERROR;
     }
 
-  *internal_classes = classes;
-
   return NO_ERROR;
 
 exit_on_error:
-  if (classes)
+
+  if (savepoint_used)
     {
-      qexec_clear_internal_classes (thread_p, classes, i + 1);
-      db_private_free (thread_p, classes);
+      xtran_server_end_topop (thread_p, LOG_RESULT_TOPOP_ABORT, &lsa);
     }
 
-  return (error == NO_ERROR) ? NO_ERROR : er_errid ();
-
+  return error;
 }
 
 /*
- * qexec_create_internal_assignments () - create and initialize structures for
- *					  MVCC assignments reevaluation
+ * qexec_init_agg_hierarchy_helpers () - initialize aggregate helpers for
+ *					 evaluating aggregates in a class
+ *					 hierarchy
  * return : error code or NO_ERROR
- * thread_p (in) :
- * aptr (in): XASL for generated SELECT statement for UPDATE
- * should_delete (in):
- * classes (in) : internal classes array
- * num_classes (in) : count internal classes array elements
- * num_assignments (in) : no of assignments
- * assignments(in): array of assignments received from client
- * mvcc_reev_assigns (in/out) : allocated array of assignments used in
- *				reevaluation
+ * thread_p (in)	: thread entry
+ * spec (in)		: spec on which the aggregates are to be evaluated
+ * aggregate_list (in)	: aggregates
+ * helpersp (in/out)	: evaluation helpers
  */
 static int
-qexec_create_mvcc_reev_assignments (THREAD_ENTRY * thread_p, XASL_NODE * aptr, bool should_delete,
-				    UPDDEL_CLASS_INFO_INTERNAL * classes, int num_classes, int num_assignments,
-				    UPDATE_ASSIGNMENT * assignments, UPDATE_MVCC_REEV_ASSIGNMENT ** mvcc_reev_assigns)
+qexec_init_agg_hierarchy_helpers (THREAD_ENTRY * thread_p, ACCESS_SPEC_TYPE * spec, AGGREGATE_TYPE * aggregate_list,
+				  HIERARCHY_AGGREGATE_HELPER ** helpersp, int *helpers_countp)
 {
-  int idx, new_assign_idx, count;
-  UPDDEL_CLASS_INFO_INTERNAL *claz = NULL;
-  UPDATE_ASSIGNMENT *assign = NULL;
-  UPDATE_MVCC_REEV_ASSIGNMENT *new_assigns = NULL, *new_assign = NULL, *prev_new_assign = NULL;
-  REGU_VARIABLE_LIST regu_var = NULL;
-  OUTPTR_LIST *outptr_list = NULL;
+  int agg_count = 0, part_count = 0, i;
+  AGGREGATE_TYPE *agg = NULL;
+  HIERARCHY_AGGREGATE_HELPER *helpers = NULL;
+  PRUNING_CONTEXT context;
+  int error = NO_ERROR;
+  PARTITION_SPEC_TYPE *part = NULL;
 
-  if (mvcc_reev_assigns == NULL || !num_assignments)
+  /* count aggregates */
+  agg = aggregate_list;
+  agg_count = 0;
+  while (agg)
+    {
+      if (!agg->flag_agg_optimize)
+	{
+	  agg = agg->next;
+	  continue;
+	}
+      agg = agg->next;
+      agg_count++;
+    }
+
+  if (agg_count == 0)
     {
+      *helpersp = NULL;
+      *helpers_countp = 0;
       return NO_ERROR;
     }
 
-  outptr_list = aptr->outptr_list;
+  partition_init_pruning_context (&context);
 
-  count = aptr->upd_del_class_cnt + aptr->mvcc_reev_extra_cls_cnt;
-  /* skip OID - CLASS OID pairs and should_delete */
-  for (idx = 0, regu_var = outptr_list->valptrp; idx < count; idx++, regu_var = regu_var->next->next)
-    ;
+  helpers = (HIERARCHY_AGGREGATE_HELPER *) db_private_alloc (thread_p, agg_count * sizeof (HIERARCHY_AGGREGATE_HELPER));
+  if (helpers == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
+	      agg_count * sizeof (HIERARCHY_AGGREGATE_HELPER));
+      error = ER_OUT_OF_VIRTUAL_MEMORY;
+      goto error_return;
+    }
 
-  if (should_delete)
+  for (i = 0; i < agg_count; i++)
     {
-      regu_var = regu_var->next;
+      helpers[i].btids = NULL;
+      helpers[i].hfids = NULL;
     }
 
-  new_assigns =
-    (UPDATE_MVCC_REEV_ASSIGNMENT *) db_private_alloc (thread_p, sizeof (UPDATE_MVCC_REEV_ASSIGNMENT) * num_assignments);
-  if (new_assigns == NULL)
+  /* count pruned partitions */
+  for (part_count = 0, part = spec->parts; part != NULL; part_count++, part = part->next);
+  if (part_count == 0)
     {
-      return ER_FAILED;
+      error = NO_ERROR;
+      goto error_return;
     }
 
-  for (idx = 0, new_assign_idx = 0; idx < num_assignments; idx++)
+  error = partition_load_pruning_context (thread_p, &ACCESS_SPEC_CLS_OID (spec), spec->pruning_type, &context);
+  if (error != NO_ERROR)
     {
-      assign = &assignments[idx];
-      claz = &classes[assign->cls_idx];
+      goto error_return;
+    }
 
-      new_assign = &new_assigns[new_assign_idx++];
-      new_assign->constant = assign->constant;
-      if (new_assign->constant == NULL)
-	{
-	  new_assign->regu_right = &regu_var->value;
-	  regu_var = regu_var->next;
-	}
-      else
+  agg = aggregate_list;
+  i = 0;
+  while (agg != NULL)
+    {
+      if (!agg->flag_agg_optimize)
 	{
-	  new_assign->regu_right = NULL;
+	  agg = agg->next;
+	  continue;
 	}
-      new_assign->next = NULL;
-      if (claz->mvcc_reev_assigns == NULL)
+      error = partition_load_aggregate_helper (&context, spec, part_count, &agg->btid, &helpers[i]);
+      if (error != NO_ERROR)
 	{
-	  claz->mvcc_reev_assigns = new_assign;
+	  goto error_return;
 	}
-      else
+      agg = agg->next;
+      i++;
+    }
+
+  partition_clear_pruning_context (&context);
+  *helpersp = helpers;
+  *helpers_countp = agg_count;
+  return NO_ERROR;
+
+error_return:
+  if (helpers != NULL)
+    {
+      for (i = 0; i < agg_count; i++)
 	{
-	  prev_new_assign = claz->mvcc_reev_assigns;
-	  while (prev_new_assign->next != NULL)
+	  if (helpers[i].btids != NULL)
 	    {
-	      prev_new_assign = prev_new_assign->next;
+	      db_private_free (thread_p, helpers[i].btids);
+	    }
+	  if (helpers[i].hfids != NULL)
+	    {
+	      db_private_free (thread_p, helpers[i].hfids);
 	    }
-	  prev_new_assign->next = new_assign;
 	}
+      db_private_free (thread_p, helpers);
     }
 
-  *mvcc_reev_assigns = new_assigns;
+  partition_clear_pruning_context (&context);
 
-  return NO_ERROR;
+  *helpersp = NULL;
+  *helpers_countp = 0;
+  return error;
 }
 
 /*
- * qexec_clear_internal_classes () - clear memory allocated for classes
- * return : void
- * thread_p (in) :
- * classes (in)	 : classes array
- * count (in)	 : number of elements in the array
+ * qexec_evaluate_partition_aggregates () - optimized aggregate evaluation
+ *					    on a partitioned class
+ * return : error code or NO_ERROR
+ * thread_p (in)  : thread entry
+ * spec (in)	  : access spec of the partitioned class
+ * agg_list (in)  : aggregate list
+ * is_scan_needed (in/out) : whether or not scan is still needed after
+ *			     evaluation
  */
-static void
-qexec_clear_internal_classes (THREAD_ENTRY * thread_p, UPDDEL_CLASS_INFO_INTERNAL * classes, int count)
+static int
+qexec_evaluate_partition_aggregates (THREAD_ENTRY * thread_p, ACCESS_SPEC_TYPE * spec, AGGREGATE_TYPE * agg_list,
+				     bool * is_scan_needed)
 {
-  int i;
-  UPDDEL_CLASS_INFO_INTERNAL *cls_int = NULL;
-
-  for (i = 0; i < count; i++)
+  int error = NO_ERROR;
+  int i = 0, helpers_count = 0;
+  HIERARCHY_AGGREGATE_HELPER *helpers = NULL;
+  AGGREGATE_TYPE *agg_ptr = NULL;
+  BTID root_btid;
+  error = qexec_init_agg_hierarchy_helpers (thread_p, spec, agg_list, &helpers, &helpers_count);
+  if (error != NO_ERROR)
     {
-      cls_int = &classes[i];
-      if (cls_int->m_inited_scancache)
-	{
-	  locator_end_force_scan_cache (thread_p, &cls_int->m_scancache);
-	}
-      cls_int->m_unique_stats.clear ();
-      if (cls_int->is_attr_info_inited)
+      *is_scan_needed = true;
+      goto cleanup;
+    }
+  i = 0;
+  for (agg_ptr = agg_list; agg_ptr; agg_ptr = agg_ptr->next)
+    {
+      if (!agg_ptr->flag_agg_optimize)
 	{
-	  heap_attrinfo_end (thread_p, &cls_int->attr_info);
+	  continue;
 	}
-      if (cls_int->needs_pruning)
+
+      if (agg_ptr->function == PT_COUNT_STAR && *is_scan_needed)
 	{
-	  partition_clear_pruning_context (&cls_int->context);
+	  agg_ptr->flag_agg_optimize = false;
+	  i++;
+	  continue;
 	}
-      if (cls_int->mvcc_extra_assign_reev != NULL)
+      BTID_COPY (&root_btid, &agg_ptr->btid);
+      error = qdata_evaluate_aggregate_hierarchy (thread_p, agg_ptr, &ACCESS_SPEC_HFID (spec), &root_btid, &helpers[i]);
+      if (error != NO_ERROR)
 	{
-	  db_private_free_and_init (thread_p, cls_int->mvcc_extra_assign_reev);
+	  agg_ptr->flag_agg_optimize = false;
+	  *is_scan_needed = true;
+	  goto cleanup;
 	}
-      cls_int->m_unique_stats.destruct ();
+      i++;
     }
-}
-
-/*
- * qexec_upddel_mvcc_set_filters () - setup current class filters
- *				      in a class hierarchy
- * return : error code or NO_ERROR
- * thread_p (in) :
- * aptr_list (in) :
- * mvcc_data_filter (in) : filter info
- * class_oid (in) : class oid
- *
- * Note: this function is used only in MVCC
- */
-static int
-qexec_upddel_mvcc_set_filters (THREAD_ENTRY * thread_p, XASL_NODE * aptr_list,
-			       UPDDEL_MVCC_COND_REEVAL * mvcc_reev_class, OID * class_oid)
-{
-  ACCESS_SPEC_TYPE *curr_spec = NULL;
 
-  while (aptr_list != NULL && curr_spec == NULL)
+cleanup:
+  if (helpers != NULL)
     {
-      curr_spec = aptr_list->spec_list;
-      while (curr_spec != NULL && !OID_EQ (&(curr_spec->s.cls_node.cls_oid), class_oid))
+      for (i = 0; i < helpers_count; i++)
 	{
-	  curr_spec = curr_spec->next;
+	  if (helpers[i].btids != NULL)
+	    {
+	      db_private_free (thread_p, helpers[i].btids);
+	    }
+	  if (helpers[i].hfids != NULL)
+	    {
+	      db_private_free (thread_p, helpers[i].hfids);
+	    }
 	}
-      aptr_list = aptr_list->scan_ptr;
-    }
-
-  if (curr_spec == NULL)
-    {
-      return ER_FAILED;
+      db_private_free (thread_p, helpers);
     }
-
-  mvcc_reev_class->init (curr_spec->s_id);
-  mvcc_reev_class->cls_oid = *class_oid;
-
-  return NO_ERROR;
+  return error;
 }
 
 /*
- * qexec_upddel_setup_current_class () - setup current class info in a class
- *					 hierarchy
+ * qexec_evaluate_aggregates_optimize () - optimize aggregate evaluation
  * return : error code or NO_ERROR
- * thread_p (in) :
- * query_class (in) : query class information
- * internal_class (in) : internal class
- * op_type (in) : operation type
- * current_oid (in): class oid
- *
- * Note: this function is used for update and delete to find class hfid when
- *  the operation is performed on a class hierarchy
+ * thread_p (in) : thread entry
+ * agg_list (in) : aggregate list to be evaluated
+ * spec (in)	 : access spec
+ * is_scan_needed (in/out) : true if scan is still needed after evaluation
  */
 static int
-qexec_upddel_setup_current_class (THREAD_ENTRY * thread_p, UPDDEL_CLASS_INFO * query_class,
-				  UPDDEL_CLASS_INFO_INTERNAL * internal_class, int op_type, OID * current_oid)
+qexec_evaluate_aggregates_optimize (THREAD_ENTRY * thread_p, AGGREGATE_TYPE * agg_list, ACCESS_SPEC_TYPE * spec,
+				    bool * is_scan_needed)
 {
-  int i = 0;
+  AGGREGATE_TYPE *agg_ptr;
   int error = NO_ERROR;
+  OID super_oid;
 
-  internal_class->class_oid = NULL;
-  internal_class->class_hfid = NULL;
+  OID_SET_NULL (&super_oid);
 
-  /* Find class HFID */
-  if (internal_class->needs_pruning)
+  for (agg_ptr = agg_list; agg_ptr; agg_ptr = agg_ptr->next)
     {
-      /* test root class */
-      if (OID_EQ (&query_class->class_oid[0], current_oid))
+      if (!agg_ptr->flag_agg_optimize)
 	{
-	  internal_class->class_oid = &query_class->class_oid[0];
-	  internal_class->class_hfid = &query_class->class_hfid[0];
-	  internal_class->subclass_idx = 0;
+	  /* scan is needed for this aggregate */
+	  *is_scan_needed = true;
+	  break;
+	}
 
-	  internal_class->num_lob_attrs = 0;
-	  internal_class->lob_attr_ids = NULL;
+      /* Temporary disable count optimization. To enable it just remove these lines and also restore the condition in
+       * pt_find_lck_classes and also enable load global statistics in logtb_get_mvcc_snapshot_data. */
+      if (agg_ptr->function == PT_COUNT_STAR)
+	{
+	  *is_scan_needed = true;
+	  break;
 	}
-      else
+
+      /* If we deal with a count optimization and the snapshot wasn't already taken then prepare current class for
+       * optimization and force a snapshot */
+      if (!*is_scan_needed && agg_ptr->function == PT_COUNT_STAR)
 	{
-	  /* look through the class partitions for the current_oid */
-	  for (i = 0; i < internal_class->context.count; i++)
+	  LOG_TDES *tdes = LOG_FIND_TDES (LOG_FIND_THREAD_TRAN_INDEX (thread_p));
+	  LOG_TRAN_CLASS_COS *class_cos = logtb_tran_find_class_cos (thread_p, &ACCESS_SPEC_CLS_OID (spec),
+								     true);
+	  if (class_cos == NULL)
 	    {
-	      if (OID_EQ (&internal_class->context.partitions[i].class_oid, current_oid))
+	      agg_ptr->flag_agg_optimize = false;
+	      *is_scan_needed = true;
+	      break;
+	    }
+	  if (tdes->mvccinfo.snapshot.valid)
+	    {
+	      if (class_cos->count_state != COS_LOADED)
 		{
-		  internal_class->class_oid = &internal_class->context.partitions[i].class_oid;
-		  internal_class->class_hfid = &internal_class->context.partitions[i].class_hfid;
-		  internal_class->subclass_idx = 0;
-
-		  internal_class->num_lob_attrs = 0;
-		  internal_class->lob_attr_ids = NULL;
+		  agg_ptr->flag_agg_optimize = false;
+		  *is_scan_needed = true;
 		  break;
 		}
 	    }
-	}
-    }
-  else
-    {
-      /* look through subclasses */
-      for (i = 0; i < query_class->num_subclasses; i++)
-	{
-	  if (OID_EQ (&query_class->class_oid[i], current_oid))
+	  else
 	    {
-	      internal_class->class_oid = &query_class->class_oid[i];
-	      internal_class->class_hfid = &query_class->class_hfid[i];
-	      internal_class->subclass_idx = i;
-
-	      if (query_class->num_lob_attrs && query_class->lob_attr_ids)
+	      if (logtb_tran_find_btid_stats (thread_p, &agg_ptr->btid, true) == NULL)
 		{
-		  internal_class->num_lob_attrs = query_class->num_lob_attrs[i];
-		  internal_class->lob_attr_ids = query_class->lob_attr_ids[i];
+		  agg_ptr->flag_agg_optimize = false;
+		  *is_scan_needed = true;
+		  break;
 		}
-	      else
+	      class_cos->count_state = COS_TO_LOAD;
+
+	      if (logtb_get_mvcc_snapshot (thread_p) == NULL)
 		{
-		  internal_class->num_lob_attrs = 0;
-		  internal_class->lob_attr_ids = NULL;
+		  error = er_errid ();
+		  return (error == NO_ERROR ? ER_FAILED : error);
 		}
-	      break;
 	    }
 	}
     }
 
-  if (internal_class->class_hfid == NULL)
+  if (spec->pruning_type == DB_PARTITIONED_CLASS)
     {
-      return ER_FAILED;
+      /* evaluate aggregate across partition hierarchy */
+      return qexec_evaluate_partition_aggregates (thread_p, spec, agg_list, is_scan_needed);
     }
-
-  /* Start a HEAP_SCANCACHE object on the new class. Partitioned classes and class hierarchies are handled differently */
-  if (internal_class->needs_pruning)
-    {
-      /* Get a scan_cache object from the pruning context. We don't close the previous one here, it will be closed when
-       * the pruning context is cleared. */
-      PRUNING_SCAN_CACHE *pcache = NULL;
-      pcache =
-	locator_get_partition_scancache (&internal_class->context, internal_class->class_oid,
-					 internal_class->class_hfid, op_type, false);
-      if (pcache == NULL)
+  else if (spec->pruning_type == DB_PARTITION_CLASS)
+    {
+      error = partition_find_root_class_oid (thread_p, &ACCESS_SPEC_CLS_OID (spec), &super_oid);
+      if (error != NO_ERROR)
 	{
-	  return ER_FAILED;
+	  *is_scan_needed = true;
+	  return error;
 	}
-      internal_class->scan_cache = &pcache->scan_cache;
     }
-  else
+
+  for (agg_ptr = agg_list; agg_ptr; agg_ptr = agg_ptr->next)
     {
-      if (internal_class->m_inited_scancache)
+      if (agg_ptr->flag_agg_optimize)
 	{
-	  if (query_class->has_uniques && BTREE_IS_MULTI_ROW_OP (op_type))
+	  if (agg_ptr->function == PT_COUNT_STAR && *is_scan_needed)
 	    {
-	      /* In this case, consider class hierarchy as well as single class. Therefore, construct the local
-	       * statistical information by collecting the statistical information during scanning on each class of
-	       * class hierarchy. */
-	      qexec_update_btree_unique_stats_info (thread_p, &internal_class->m_unique_stats,
-						    &internal_class->m_scancache);
+	      /* If scan is needed, do not optimize PT_COUNT_STAR. */
+	      agg_ptr->flag_agg_optimize = false;
+	      continue;
+	    }
+	  if (qdata_evaluate_aggregate_optimize (thread_p, agg_ptr, &ACCESS_SPEC_HFID (spec), &super_oid) != NO_ERROR)
+	    {
+	      agg_ptr->flag_agg_optimize = false;
+	      *is_scan_needed = true;
 	    }
-	  (void) locator_end_force_scan_cache (thread_p, &internal_class->m_scancache);
-	  internal_class->m_inited_scancache = false;
 	}
-      error =
-	locator_start_force_scan_cache (thread_p, &internal_class->m_scancache, internal_class->class_hfid,
-					internal_class->class_oid, op_type);
-      if (error != NO_ERROR)
+    }
+
+  return error;
+}
+
+/*
+ * qexec_get_fetched_attr_id () - get the attribute fetched into a value
+ * return : attribute identifier or -1 if no attribute is fetched into dbval
+ * regu_list (in) : attribute fetch list of an access spec
+ * dbval (in) : value of the xasl val_list
+ */
+static ATTR_ID
+qexec_get_fetched_attr_id (REGU_VARIABLE_LIST regu_list, DB_VALUE * dbval)
+{
+  for (; regu_list != NULL; regu_list = regu_list->next)
+    {
+      if (regu_list->value.type == TYPE_ATTR_ID && regu_list->value.vfetch_to == dbval)
 	{
-	  return error;
+	  return regu_list->value.value.attr_descr.id;
 	}
-      internal_class->m_inited_scancache = true;
-      internal_class->scan_cache = &internal_class->m_scancache;
-      internal_class->scan_cache->mvcc_snapshot = logtb_get_mvcc_snapshot (thread_p);
-
     }
-  COPY_OID (&internal_class->prev_class_oid, current_oid);
 
-  return NO_ERROR;
+  return -1;
 }
 
 /*
- * qexec_execute_merge () - Execution function for MERGE proc
- *   return: NO_ERROR, or ER_code
- *   xasl(in): XASL tree
- *   xasl_state(in): XASL state
+ * qexec_can_filter_join_probe () - can a runtime join filter drop rows of
+ *				    the scan of a merge join input
+ * return : true if a join filter may be attached to the scan of probe_xasl
+ * probe_xasl (in) : input to filter, not executed yet
+ *
+ * Note: The join columns of the input list file are mapped to attributes
+ *	 through the output list of its scan, which is not the list that
+ *	 builds the list file of a grouped or analytic query. Dropping rows
+ *	 before inst_num () / ROWNUM, orderby_num (), LIMIT or CONNECT BY are
+ *	 evaluated would also change which rows they produce.
  */
-static int
-qexec_execute_merge (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state)
+bool
+qexec_can_filter_join_probe (const XASL_NODE * probe_xasl)
 {
-  int error = NO_ERROR;
-  int savepoint_used = 0;
-  LOG_LSA lsa;
+  const ACCESS_SPEC_TYPE *spec = probe_xasl->spec_list;
 
-  /* start a topop */
-  error = xtran_server_start_topop (thread_p, &lsa);
-  if (error != NO_ERROR)
+  if (probe_xasl->type != BUILDLIST_PROC || probe_xasl->outptr_list == NULL || probe_xasl->scan_ptr != NULL
+      || spec == NULL || spec->next != NULL)
     {
-      GOTO_EXIT_ON_ERROR;
+      return false;
+    }
+  if (spec->type != TARGET_CLASS || spec->pruning_type != DB_NOT_PARTITIONED_CLASS
+      || (spec->access != ACCESS_METHOD_SEQUENTIAL && spec->access != ACCESS_METHOD_INDEX))
+    {
+      return false;
     }
-  savepoint_used = 1;
 
-  /* execute insert aptr */
-  if (xasl->proc.merge.insert_xasl)
+  if (probe_xasl->proc.buildlist.groupby_list != NULL || probe_xasl->proc.buildlist.a_eval_list != NULL)
     {
-      XASL_NODE *xptr = xasl->proc.merge.insert_xasl;
-      if (xptr && xptr->aptr_list)
-	{
-	  error = qexec_execute_mainblock (thread_p, xptr->aptr_list, xasl_state, NULL);
-	}
+      return false;
     }
-  /* execute update */
-  if (error == NO_ERROR && xasl->proc.merge.update_xasl)
+  if (probe_xasl->instnum_pred != NULL || probe_xasl->instnum_val != NULL || probe_xasl->ordbynum_pred != NULL
+      || probe_xasl->ordbynum_val != NULL || probe_xasl->limit_row_count != NULL || probe_xasl->connect_by_ptr != NULL)
     {
-      error = qexec_execute_update (thread_p, xasl->proc.merge.update_xasl, xasl->proc.merge.has_delete, xasl_state);
+      return false;
     }
-  /* execute insert */
-  if (error == NO_ERROR && xasl->proc.merge.insert_xasl)
+
+  return true;
+}
+
+/*
+ * qexec_setup_join_filter () - build a runtime join filter over the join
+ *				columns of a materialized merge join input
+ *				and attach it to the scan of the other input
+ * return : error code or NO_ERROR
+ * thread_p (in) :
+ * build_xasl (in) : materialized input
+ * build_columns (in) : join columns of the build_xasl list file
+ * probe_xasl (in) : input to filter, not executed yet
+ * probe_columns (in) : join columns of the probe_xasl list file
+ * column_cnt (in) : number of join columns
+ *
+ * Note: The filter is only used when the probe input is a heap or index scan
+ *	 of a single, not partitioned class and at least one of its join
+ *	 columns is an attribute of a type supported by the filter. Rows are
+ *	 dropped only when one of the filtered keys cannot match, the merge
+ *	 still checks the join terms.
+ */
+static int
+qexec_setup_join_filter (THREAD_ENTRY * thread_p, XASL_NODE * build_xasl, int *build_columns, XASL_NODE * probe_xasl,
+			 int *probe_columns, int column_cnt)
+{
+  ACCESS_SPEC_TYPE *spec;
+  QFILE_LIST_ID *build_list;
+  QFILE_LIST_SCAN_ID scan_id;
+  QFILE_TUPLE_RECORD tplrec = { NULL, 0 };
+  REGU_VARIABLE_LIST regu_list;
+  SCAN_JOIN_FILTER *filter = NULL;
+  TP_DOMAIN *build_domain;
+  DB_VALUE *keys = NULL;
+  ATTR_ID *attr_ids = NULL;
+  DB_TYPE *types = NULL;
+  int *key_columns = NULL;
+  ATTR_ID attr_id;
+  SCAN_CODE scan_code;
+  int i, j, k, n_keys = 0, error = NO_ERROR;
+  bool has_null;
+
+  scan_id.status = S_CLOSED;
+
+  if (column_cnt <= 0 || !qexec_can_filter_join_probe (probe_xasl))
     {
-      error = qexec_execute_insert (thread_p, xasl->proc.merge.insert_xasl, xasl_state, true);
+      return NO_ERROR;
     }
+  spec = probe_xasl->spec_list;
 
-  /* check error */
-  if (error != NO_ERROR)
+  build_list = build_xasl->list_id;
+  if (build_list == NULL || build_list->type_list.type_cnt <= 0)
     {
-      GOTO_EXIT_ON_ERROR;
+      return NO_ERROR;
     }
 
-  /* setup list file for result count */
-  error = qexec_setup_list_id (thread_p, xasl);
-  if (error != NO_ERROR)
+  attr_ids = (ATTR_ID *) db_private_alloc (thread_p, column_cnt * sizeof (ATTR_ID));
+  types = (DB_TYPE *) db_private_alloc (thread_p, column_cnt * sizeof (DB_TYPE));
+  key_columns = (int *) db_private_alloc (thread_p, column_cnt * sizeof (int));
+  keys = (DB_VALUE *) db_private_alloc (thread_p, column_cnt * sizeof (DB_VALUE));
+  if (attr_ids == NULL || types == NULL || key_columns == NULL || keys == NULL)
     {
-      GOTO_EXIT_ON_ERROR;
+      error = ER_FAILED;
+      goto exit_on_error;
     }
 
-  xasl->list_id->tuple_cnt = 0;
+  /* map the join columns of the probe list file to the attributes of the probed class */
+  for (i = 0; i < column_cnt; i++)
+    {
+      for (regu_list = probe_xasl->outptr_list->valptrp, k = 0; regu_list != NULL; regu_list = regu_list->next)
+	{
+	  if (REGU_VARIABLE_IS_FLAGED (&regu_list->value, REGU_VARIABLE_HIDDEN_COLUMN))
+	    {
+	      continue;
+	    }
+	  if (k == probe_columns[i])
+	    {
+	      break;
+	    }
+	  k++;
+	}
+      if (regu_list == NULL || regu_list->value.type != TYPE_CONSTANT || regu_list->value.domain == NULL)
+	{
+	  continue;
+	}
 
-  /* set result count */
-  if (xasl->proc.merge.update_xasl)
+      build_domain = build_list->type_list.domp[build_columns[i]];
+      if (build_domain == NULL || TP_DOMAIN_TYPE (build_domain) != TP_DOMAIN_TYPE (regu_list->value.domain)
+	  || !scan_join_filter_is_supported_type (TP_DOMAIN_TYPE (build_domain)))
+	{
+	  continue;
+	}
+
+      attr_id = qexec_get_fetched_attr_id (spec->s.cls_node.cls_regu_list_pred, regu_list->value.value.dbvalptr);
+      if (attr_id < 0)
+	{
+	  attr_id = qexec_get_fetched_attr_id (spec->s.cls_node.cls_regu_list_rest, regu_list->value.value.dbvalptr);
+	}
+      if (attr_id < 0)
+	{
+	  attr_id = qexec_get_fetched_attr_id (spec->s.cls_node.cls_regu_list_key, regu_list->value.value.dbvalptr);
+	}
+      if (attr_id < 0)
+	{
+	  continue;
+	}
+
+      for (j = 0; j < n_keys; j++)
+	{
+	  if (attr_ids[j] == attr_id)
+	    {
+	      break;
+	    }
+	}
+      if (j < n_keys)
+	{
+	  /* already filtered */
+	  continue;
+	}
+
+      attr_ids[n_keys] = attr_id;
+      types[n_keys] = TP_DOMAIN_TYPE (build_domain);
+      key_columns[n_keys] = build_columns[i];
+      db_make_null (&keys[n_keys]);
+      n_keys++;
+    }
+
+  if (n_keys == 0)
     {
-      xasl->list_id->tuple_cnt += xasl->proc.merge.update_xasl->list_id->tuple_cnt;
-      /* monitor */
-      perfmon_inc_stat (thread_p, PSTAT_QM_NUM_UPDATES);
+      goto exit_on_error;
     }
 
-  if (xasl->proc.merge.insert_xasl)
+  filter = scan_join_filter_create (thread_p, &ACCESS_SPEC_CLS_OID (spec), n_keys, attr_ids, types,
+				    (int) build_list->tuple_cnt);
+  if (filter == NULL)
     {
-      xasl->list_id->tuple_cnt += xasl->proc.merge.insert_xasl->list_id->tuple_cnt;
-      /* monitor */
-      perfmon_inc_stat (thread_p, PSTAT_QM_NUM_INSERTS);
+      ASSERT_ERROR_AND_SET (error);
+      goto exit_on_error;
     }
 
-  /* end topop */
-  if (xtran_server_end_topop (thread_p, LOG_RESULT_TOPOP_ATTACH_TO_OUTER, &lsa) != TRAN_ACTIVE)
+  if (qfile_open_list_scan (build_list, &scan_id) != NO_ERROR)
     {
-      GOTO_EXIT_ON_ERROR;
+      error = ER_FAILED;
+      goto exit_on_error;
     }
 
-  return NO_ERROR;
+  while ((scan_code = qfile_scan_list_next (thread_p, &scan_id, &tplrec, PEEK)) == S_SUCCESS)
+    {
+      has_null = false;
+      for (j = 0; j < n_keys; j++)
+	{
+	  error = qexec_get_tuple_column_value (tplrec.tpl, key_columns[j], &keys[j],
+						build_list->type_list.domp[key_columns[j]]);
+	  if (error != NO_ERROR)
+	    {
+	      goto exit_on_error;
+	    }
+	  if (DB_IS_NULL (&keys[j]))
+	    {
+	      has_null = true;
+	    }
+	}
+
+      if (!has_null)
+	{
+	  /* a row with a null join key never finds a partner */
+	  scan_join_filter_add_key (thread_p, filter, keys);
+	}
+
+      for (j = 0; j < n_keys; j++)
+	{
+	  pr_clear_value (&keys[j]);
+	}
+    }
+  if (scan_code == S_ERROR)
+    {
+      error = ER_FAILED;
+      goto exit_on_error;
+    }
+
+  if (spec->join_filter != NULL)
+    {
+      scan_join_filter_destroy (thread_p, spec->join_filter);
+    }
+  spec->join_filter = filter;
+  filter = NULL;
 
 exit_on_error:
+  qfile_close_scan (thread_p, &scan_id);
 
-  if (savepoint_used)
+  if (filter != NULL)
     {
-      xtran_server_end_topop (thread_p, LOG_RESULT_TOPOP_ABORT, &lsa);
+      scan_join_filter_destroy (thread_p, filter);
+    }
+  if (attr_ids != NULL)
+    {
+      db_private_free (thread_p, attr_ids);
+    }
+  if (types != NULL)
+    {
+      db_private_free (thread_p, types);
+    }
+  if (key_columns != NULL)
+    {
+      db_private_free (thread_p, key_columns);
+    }
+  if (keys != NULL)
+    {
+      db_private_free (thread_p, keys);
     }
 
   return error;
 }
 
 /*
- * qexec_init_agg_hierarchy_helpers () - initialize aggregate helpers for
- *					 evaluating aggregates in a class
- *					 hierarchy
+ * qexec_setup_topn_proc () - setup a top-n object
  * return : error code or NO_ERROR
- * thread_p (in)	: thread entry
- * spec (in)		: spec on which the aggregates are to be evaluated
- * aggregate_list (in)	: aggregates
- * helpersp (in/out)	: evaluation helpers
+ * thread_p (in) :
+ * xasl (in) :
+ * vd (in) :
  */
 static int
-qexec_init_agg_hierarchy_helpers (THREAD_ENTRY * thread_p, ACCESS_SPEC_TYPE * spec, AGGREGATE_TYPE * aggregate_list,
-				  HIERARCHY_AGGREGATE_HELPER ** helpersp, int *helpers_countp)
+qexec_setup_topn_proc (THREAD_ENTRY * thread_p, XASL_NODE * xasl, VAL_DESCR * vd)
 {
-  int agg_count = 0, part_count = 0, i;
-  AGGREGATE_TYPE *agg = NULL;
-  HIERARCHY_AGGREGATE_HELPER *helpers = NULL;
-  PRUNING_CONTEXT context;
-  int error = NO_ERROR;
-  PARTITION_SPEC_TYPE *part = NULL;
+  DB_VALUE ubound_val;
+  REGU_VARIABLE_LIST var_list = NULL;
+  TOPN_TUPLES *top_n = NULL;
+  int error = NO_ERROR, ubound = 0, count = 0;
+  UINT64 estimated_size = 0, max_size = 0;
 
-  /* count aggregates */
-  agg = aggregate_list;
-  agg_count = 0;
-  while (agg)
+  if (xasl->type != BUILDLIST_PROC)
     {
-      if (!agg->flag_agg_optimize)
-	{
-	  agg = agg->next;
-	  continue;
-	}
-      agg = agg->next;
-      agg_count++;
+      return NO_ERROR;
     }
 
-  if (agg_count == 0)
+  if (xasl->orderby_list == NULL)
     {
-      *helpersp = NULL;
-      *helpers_countp = 0;
+      /* Not ordered */
+      return NO_ERROR;
+    }
+  if (xasl->ordbynum_pred == NULL)
+    {
+      /* No limit specified */
       return NO_ERROR;
     }
 
-  partition_init_pruning_context (&context);
-
-  helpers = (HIERARCHY_AGGREGATE_HELPER *) db_private_alloc (thread_p, agg_count * sizeof (HIERARCHY_AGGREGATE_HELPER));
-  if (helpers == NULL)
+  if (xasl->option == Q_DISTINCT)
     {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
-	      agg_count * sizeof (HIERARCHY_AGGREGATE_HELPER));
-      error = ER_OUT_OF_VIRTUAL_MEMORY;
-      goto error_return;
+      /* We cannot handle distinct ordering */
+      return NO_ERROR;
     }
 
-  for (i = 0; i < agg_count; i++)
+  if (XASL_IS_FLAGED (xasl, XASL_HAS_CONNECT_BY) || XASL_IS_FLAGED (xasl, XASL_SKIP_ORDERBY_LIST)
+      || XASL_IS_FLAGED (xasl, XASL_USES_MRO))
     {
-      helpers[i].btids = NULL;
-      helpers[i].hfids = NULL;
+      return NO_ERROR;
     }
 
-  /* count pruned partitions */
-  for (part_count = 0, part = spec->parts; part != NULL; part_count++, part = part->next);
-  if (part_count == 0)
+  if (xasl->proc.buildlist.groupby_list != NULL || xasl->proc.buildlist.a_eval_list != NULL)
     {
-      error = NO_ERROR;
-      goto error_return;
+      /* Cannot handle group by and analytics with order by */
+      return NO_ERROR;
     }
 
-  error = partition_load_pruning_context (thread_p, &ACCESS_SPEC_CLS_OID (spec), spec->pruning_type, &context);
+  db_make_null (&ubound_val);
+  error = qexec_get_orderbynum_upper_bound (thread_p, xasl->ordbynum_pred, vd, &ubound_val);
   if (error != NO_ERROR)
     {
-      goto error_return;
+      return error;
     }
-
-  agg = aggregate_list;
-  i = 0;
-  while (agg != NULL)
+  if (DB_IS_NULL (&ubound_val))
     {
-      if (!agg->flag_agg_optimize)
-	{
-	  agg = agg->next;
-	  continue;
-	}
-      error = partition_load_aggregate_helper (&context, spec, part_count, &agg->btid, &helpers[i]);
-      if (error != NO_ERROR)
-	{
-	  goto error_return;
-	}
-      agg = agg->next;
-      i++;
+      return NO_ERROR;
     }
-
-  partition_clear_pruning_context (&context);
-  *helpersp = helpers;
-  *helpers_countp = agg_count;
-  return NO_ERROR;
-
-error_return:
-  if (helpers != NULL)
+  if (DB_VALUE_TYPE (&ubound_val) != DB_TYPE_INTEGER)
     {
-      for (i = 0; i < agg_count; i++)
+      TP_DOMAIN_STATUS status;
+      status = tp_value_cast (&ubound_val, &ubound_val, &tp_Integer_domain, 1);
+      if (status != DOMAIN_COMPATIBLE)
 	{
-	  if (helpers[i].btids != NULL)
-	    {
-	      db_private_free (thread_p, helpers[i].btids);
-	    }
-	  if (helpers[i].hfids != NULL)
-	    {
-	      db_private_free (thread_p, helpers[i].hfids);
-	    }
+	  pr_clear_value (&ubound_val);
+	  return NO_ERROR;
 	}
-      db_private_free (thread_p, helpers);
     }
 
-  partition_clear_pruning_context (&context);
-
-  *helpersp = NULL;
-  *helpers_countp = 0;
-  return error;
-}
+  ubound = db_get_int (&ubound_val);
+  pr_clear_value (&ubound_val);
 
-/*
- * qexec_evaluate_partition_aggregates () - optimized aggregate evaluation
- *					    on a partitioned class
- * return : error code or NO_ERROR
- * thread_p (in)  : thread entry
- * spec (in)	  : access spec of the partitioned class
- * agg_list (in)  : aggregate list
- * is_scan_needed (in/out) : whether or not scan is still needed after
- *			     evaluation
- */
-static int
-qexec_evaluate_partition_aggregates (THREAD_ENTRY * thread_p, ACCESS_SPEC_TYPE * spec, AGGREGATE_TYPE * agg_list,
-				     bool * is_scan_needed)
-{
-  int error = NO_ERROR;
-  int i = 0, helpers_count = 0;
-  HIERARCHY_AGGREGATE_HELPER *helpers = NULL;
-  AGGREGATE_TYPE *agg_ptr = NULL;
-  BTID root_btid;
-  error = qexec_init_agg_hierarchy_helpers (thread_p, spec, agg_list, &helpers, &helpers_count);
-  if (error != NO_ERROR)
+  if (ubound == 0)
     {
-      *is_scan_needed = true;
-      goto cleanup;
+      return NO_ERROR;
     }
-  i = 0;
-  for (agg_ptr = agg_list; agg_ptr; agg_ptr = agg_ptr->next)
+
+  estimated_size = 0;
+  count = 0;
+  var_list = xasl->outptr_list->valptrp;
+  while (var_list)
     {
-      if (!agg_ptr->flag_agg_optimize)
+      if (var_list->value.domain == NULL)
 	{
-	  continue;
+	  /* probably an error but just abandon top-n */
+	  return NO_ERROR;
 	}
-
-      if (agg_ptr->function == PT_COUNT_STAR && *is_scan_needed)
+      if (TP_IS_SET_TYPE (TP_DOMAIN_TYPE (var_list->value.domain)))
 	{
-	  agg_ptr->flag_agg_optimize = false;
-	  i++;
+	  /* do not apply this to collections */
+	  return NO_ERROR;
+	}
+      if (REGU_VARIABLE_IS_FLAGED (&var_list->value, REGU_VARIABLE_HIDDEN_COLUMN))
+	{
+	  /* skip hidden values */
+	  var_list = var_list->next;
 	  continue;
 	}
-      BTID_COPY (&root_btid, &agg_ptr->btid);
-      error = qdata_evaluate_aggregate_hierarchy (thread_p, agg_ptr, &ACCESS_SPEC_HFID (spec), &root_btid, &helpers[i]);
-      if (error != NO_ERROR)
+
+      if (var_list->value.domain->precision != TP_FLOATING_PRECISION_VALUE)
 	{
-	  agg_ptr->flag_agg_optimize = false;
-	  *is_scan_needed = true;
-	  goto cleanup;
+	  /* Ignore floating point precision domains for now. We will decide whether or not to continue with top-N
+	   * whenever we add/replace a tuple. */
+	  estimated_size += tp_domain_memory_size (var_list->value.domain);
 	}
-      i++;
+      count++;
+      var_list = var_list->next;
     }
 
-cleanup:
-  if (helpers != NULL)
+  if (estimated_size >= (UINT64) QFILE_MAX_TUPLE_SIZE_IN_PAGE)
     {
-      for (i = 0; i < helpers_count; i++)
-	{
-	  if (helpers[i].btids != NULL)
-	    {
-	      db_private_free (thread_p, helpers[i].btids);
-	    }
-	  if (helpers[i].hfids != NULL)
-	    {
-	      db_private_free (thread_p, helpers[i].hfids);
-	    }
-	}
-      db_private_free (thread_p, helpers);
+      /* Do not keep these values in memory */
+      return NO_ERROR;
     }
-  return error;
+
+  /* At any time, we will handle at most ubound tuples */
+  estimated_size *= ubound;
+  max_size = (UINT64) prm_get_integer_value (PRM_ID_SR_NBUFFERS) * IO_PAGESIZE;
+  if (estimated_size > max_size)
+    {
+      /* Do not use more than the sort buffer size. Using the entire sort buffer is possible because this is the only
+       * sort operation which is being executed for this transaction at this time. */
+      return NO_ERROR;
+    }
+
+
+  top_n = qexec_alloc_topn_tuples (thread_p, xasl->orderby_list, ubound, count, max_size);
+  if (top_n == NULL)
+    {
+      return ER_FAILED;
+    }
+
+  xasl->topn_items = top_n;
+
+  return NO_ERROR;
 }
 
 /*
- * qexec_evaluate_aggregates_optimize () - optimize aggregate evaluation
- * return : error code or NO_ERROR
- * thread_p (in) : thread entry
- * agg_list (in) : aggregate list to be evaluated
- * spec (in)	 : access spec
- * is_scan_needed (in/out) : true if scan is still needed after evaluation
+ * qexec_alloc_topn_tuples () - allocate a top-n object able to hold at most
+ *				ubound tuples
+ * return : top-n object or NULL on error
+ * thread_p (in) :
+ * sort_items (in) : sort items position in tuple and sort order
+ * ubound (in) : maximum number of tuples
+ * values_count (in) : number of values in a tuple
+ * max_size (in) : maximum size in bytes the tuples may occupy
  */
-static int
-qexec_evaluate_aggregates_optimize (THREAD_ENTRY * thread_p, AGGREGATE_TYPE * agg_list, ACCESS_SPEC_TYPE * spec,
-				    bool * is_scan_needed)
+static TOPN_TUPLES *
+qexec_alloc_topn_tuples (THREAD_ENTRY * thread_p, SORT_LIST * sort_items, int ubound, int values_count,
+			 UINT64 max_size)
 {
-  AGGREGATE_TYPE *agg_ptr;
-  int error = NO_ERROR;
-  OID super_oid;
+  BINARY_HEAP *heap = NULL;
+  TOPN_TUPLES *top_n = NULL;
 
-  OID_SET_NULL (&super_oid);
+  top_n = (TOPN_TUPLES *) db_private_alloc (thread_p, sizeof (TOPN_TUPLES));
+  if (top_n == NULL)
+    {
+      goto error_return;
+    }
 
-  for (agg_ptr = agg_list; agg_ptr; agg_ptr = agg_ptr->next)
+  top_n->max_size = max_size;
+  top_n->total_size = 0;
+
+  top_n->tuples = (TOPN_TUPLE *) db_private_alloc (thread_p, ubound * sizeof (TOPN_TUPLE));
+  if (top_n->tuples == NULL)
     {
-      if (!agg_ptr->flag_agg_optimize)
-	{
-	  /* scan is needed for this aggregate */
-	  *is_scan_needed = true;
-	  break;
-	}
+      goto error_return;
+    }
+  memset (top_n->tuples, 0, ubound * sizeof (TOPN_TUPLE));
 
-      /* Temporary disable count optimization. To enable it just remove these lines and also restore the condition in
-       * pt_find_lck_classes and also enable load global statistics in logtb_get_mvcc_snapshot_data. */
-      if (agg_ptr->function == PT_COUNT_STAR)
-	{
-	  *is_scan_needed = true;
-	  break;
-	}
+  heap = bh_create (thread_p, ubound, sizeof (TOPN_TUPLE *), qexec_topn_compare, top_n);
+  if (heap == NULL)
+    {
+      goto error_return;
+    }
 
-      /* If we deal with a count optimization and the snapshot wasn't already taken then prepare current class for
-       * optimization and force a snapshot */
-      if (!*is_scan_needed && agg_ptr->function == PT_COUNT_STAR)
-	{
-	  LOG_TDES *tdes = LOG_FIND_TDES (LOG_FIND_THREAD_TRAN_INDEX (thread_p));
-	  LOG_TRAN_CLASS_COS *class_cos = logtb_tran_find_class_cos (thread_p, &ACCESS_SPEC_CLS_OID (spec),
-								     true);
-	  if (class_cos == NULL)
-	    {
-	      agg_ptr->flag_agg_optimize = false;
-	      *is_scan_needed = true;
-	      break;
-	    }
-	  if (tdes->mvccinfo.snapshot.valid)
-	    {
-	      if (class_cos->count_state != COS_LOADED)
-		{
-		  agg_ptr->flag_agg_optimize = false;
-		  *is_scan_needed = true;
-		  break;
-		}
-	    }
-	  else
-	    {
-	      if (logtb_tran_find_btid_stats (thread_p, &agg_ptr->btid, true) == NULL)
-		{
-		  agg_ptr->flag_agg_optimize = false;
-		  *is_scan_needed = true;
-		  break;
-		}
-	      class_cos->count_state = COS_TO_LOAD;
+  top_n->heap = heap;
+  top_n->sort_items = sort_items;
+  top_n->values_count = values_count;
 
-	      if (logtb_get_mvcc_snapshot (thread_p) == NULL)
-		{
-		  error = er_errid ();
-		  return (error == NO_ERROR ? ER_FAILED : error);
-		}
-	    }
+  return top_n;
+
+error_return:
+  if (top_n != NULL)
+    {
+      if (top_n->tuples != NULL)
+	{
+	  db_private_free (thread_p, top_n->tuples);
 	}
+      db_private_free (thread_p, top_n);
     }
 
-  if (spec->pruning_type == DB_PARTITIONED_CLASS)
+  return NULL;
+}
+
+/*
+ * qexec_free_topn_tuples () - free a top-n object and the tuples it holds
+ * return : void
+ * thread_p (in) :
+ * topn_items (in) : top-n object
+ */
+static void
+qexec_free_topn_tuples (THREAD_ENTRY * thread_p, TOPN_TUPLES * topn_items)
+{
+  BINARY_HEAP *heap;
+  int i;
+
+  if (topn_items == NULL)
     {
-      /* evaluate aggregate across partition hierarchy */
-      return qexec_evaluate_partition_aggregates (thread_p, spec, agg_list, is_scan_needed);
+      return;
     }
-  else if (spec->pruning_type == DB_PARTITION_CLASS)
+
+  heap = topn_items->heap;
+  if (heap != NULL)
     {
-      error = partition_find_root_class_oid (thread_p, &ACCESS_SPEC_CLS_OID (spec), &super_oid);
-      if (error != NO_ERROR)
+      for (i = 0; i < heap->element_count; i++)
 	{
-	  *is_scan_needed = true;
-	  return error;
+	  qexec_clear_topn_tuple (thread_p, QEXEC_GET_BH_TOPN_TUPLE (heap, i), topn_items->values_count);
 	}
+      bh_destroy (thread_p, heap);
     }
 
-  for (agg_ptr = agg_list; agg_ptr; agg_ptr = agg_ptr->next)
+  if (topn_items->tuples != NULL)
     {
-      if (agg_ptr->flag_agg_optimize)
-	{
-	  if (agg_ptr->function == PT_COUNT_STAR && *is_scan_needed)
-	    {
-	      /* If scan is needed, do not optimize PT_COUNT_STAR. */
-	      agg_ptr->flag_agg_optimize = false;
-	      continue;
-	    }
-	  if (qdata_evaluate_aggregate_optimize (thread_p, agg_ptr, &ACCESS_SPEC_HFID (spec), &super_oid) != NO_ERROR)
-	    {
-	      agg_ptr->flag_agg_optimize = false;
-	      *is_scan_needed = true;
-	    }
-	}
+      db_private_free (thread_p, topn_items->tuples);
     }
 
-  return error;
+  db_private_free (thread_p, topn_items);
 }
 
 /*
- * qexec_setup_topn_proc () - setup a top-n object
+ * qexec_orderby_topn_list () - order an already built listfile on ORDER BY
+ *				... LIMIT using the top-n heap
  * return : error code or NO_ERROR
  * thread_p (in) :
- * xasl (in) :
- * vd (in) :
+ * xasl (in) : xasl node
+ * xasl_state (in) :
+ * outptr_list (in) : output pointer list describing the listfile columns
+ * is_done (out) : true if the listfile was replaced by the ordered top-n
+ *		   tuples, false if it must be ordered by sorting
+ *
+ * Note: This is used when the tuples could not be fed to the heap while
+ *	 they were generated, e.g. for grouped or analytic results. The
+ *	 listfile is scanned once and only the first ubound tuples are kept in
+ *	 memory. If they do not fit in the sort buffer, the heap is abandoned
+ *	 and the caller falls back to sort_listfile.
  */
 static int
-qexec_setup_topn_proc (THREAD_ENTRY * thread_p, XASL_NODE * xasl, VAL_DESCR * vd)
+qexec_orderby_topn_list (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state,
+			 OUTPTR_LIST * outptr_list, bool * is_done)
 {
-  BINARY_HEAP *heap = NULL;
-  DB_VALUE ubound_val;
-  REGU_VARIABLE_LIST var_list = NULL;
+  QFILE_LIST_ID *list_id = xasl->list_id;
+  QFILE_LIST_ID *t_list_id = NULL;
+  QFILE_LIST_SCAN_ID scan_id;
+  QFILE_TUPLE_RECORD tplrec = { NULL, 0 };
+  QFILE_TUPLE_DESCRIPTOR tpl_descr;
   TOPN_TUPLES *top_n = NULL;
-  int error = NO_ERROR, ubound = 0, count = 0;
+  DB_VALUE ubound_val;
+  DB_VALUE *values = NULL;
+  DB_VALUE **values_p = NULL;
+  TP_DOMAIN *domain;
+  SCAN_CODE scan_code;
+  TOPN_STATUS topn_status = TOPN_SUCCESS;
+  int error = NO_ERROR, ubound = 0, values_count, i, ls_flag;
   UINT64 estimated_size = 0, max_size = 0;
 
-  if (xasl->type != BUILDLIST_PROC)
-    {
-      return NO_ERROR;
-    }
-
-  if (xasl->orderby_list == NULL)
-    {
-      /* Not ordered */
-      return NO_ERROR;
-    }
-  if (xasl->ordbynum_pred == NULL)
-    {
-      /* No limit specified */
-      return NO_ERROR;
-    }
+  assert (is_done != NULL);
+  *is_done = false;
 
-  if (xasl->option == Q_DISTINCT)
-    {
-      /* We cannot handle distinct ordering */
-      return NO_ERROR;
-    }
+  scan_id.status = S_CLOSED;
 
-  if (XASL_IS_FLAGED (xasl, XASL_HAS_CONNECT_BY) || XASL_IS_FLAGED (xasl, XASL_SKIP_ORDERBY_LIST)
-      || XASL_IS_FLAGED (xasl, XASL_USES_MRO))
+  if (list_id == NULL || xasl->orderby_list == NULL || xasl->ordbynum_pred == NULL || outptr_list == NULL)
     {
       return NO_ERROR;
     }
 
-  if (xasl->proc.buildlist.groupby_list != NULL || xasl->proc.buildlist.a_eval_list != NULL)
+  if (XASL_IS_FLAGED (xasl, XASL_HAS_CONNECT_BY) || XASL_IS_FLAGED (xasl, XASL_USES_MRO))
     {
-      /* Cannot handle group by and analytics with order by */
       return NO_ERROR;
     }
 
   db_make_null (&ubound_val);
-  error = qexec_get_orderbynum_upper_bound (thread_p, xasl->ordbynum_pred, vd, &ubound_val);
+  error = qexec_get_orderbynum_upper_bound (thread_p, xasl->ordbynum_pred, &xasl_state->vd, &ubound_val);
   if (error != NO_ERROR)
     {
       return error;
@@ -23925,105 +25193,160 @@ qexec_setup_topn_proc (THREAD_ENTRY * thread_p, XASL_NODE * xasl, VAL_DESCR * vd
   ubound = db_get_int (&ubound_val);
   pr_clear_value (&ubound_val);
 
-  if (ubound == 0)
+  if (ubound <= 0 || list_id->tuple_cnt <= ubound)
     {
+      /* nothing to cut off, a regular sort is just as good */
       return NO_ERROR;
     }
 
-  estimated_size = 0;
-  count = 0;
-  var_list = xasl->outptr_list->valptrp;
-  while (var_list)
+  values_count = list_id->type_list.type_cnt;
+  if (values_count <= 0)
     {
-      if (var_list->value.domain == NULL)
-	{
-	  /* probably an error but just abandon top-n */
-	  return NO_ERROR;
-	}
-      if (TP_IS_SET_TYPE (TP_DOMAIN_TYPE (var_list->value.domain)))
+      return NO_ERROR;
+    }
+
+  for (i = 0; i < values_count; i++)
+    {
+      domain = list_id->type_list.domp[i];
+      if (domain == NULL || TP_IS_SET_TYPE (TP_DOMAIN_TYPE (domain)))
 	{
 	  /* do not apply this to collections */
 	  return NO_ERROR;
 	}
-      if (REGU_VARIABLE_IS_FLAGED (&var_list->value, REGU_VARIABLE_HIDDEN_COLUMN))
-	{
-	  /* skip hidden values */
-	  var_list = var_list->next;
-	  continue;
-	}
-
-      if (var_list->value.domain->precision != TP_FLOATING_PRECISION_VALUE)
+      if (domain->precision != TP_FLOATING_PRECISION_VALUE)
 	{
-	  /* Ignore floating point precision domains for now. We will decide whether or not to continue with top-N
-	   * whenever we add/replace a tuple. */
-	  estimated_size += tp_domain_memory_size (var_list->value.domain);
+	  estimated_size += tp_domain_memory_size (domain);
 	}
-      count++;
-      var_list = var_list->next;
     }
 
   if (estimated_size >= (UINT64) QFILE_MAX_TUPLE_SIZE_IN_PAGE)
     {
-      /* Do not keep these values in memory */
       return NO_ERROR;
     }
 
-  /* At any time, we will handle at most ubound tuples */
-  estimated_size *= ubound;
   max_size = (UINT64) prm_get_integer_value (PRM_ID_SR_NBUFFERS) * IO_PAGESIZE;
-  if (estimated_size > max_size)
+  if (estimated_size * ubound > max_size)
     {
-      /* Do not use more than the sort buffer size. Using the entire sort buffer is possible because this is the only
-       * sort operation which is being executed for this transaction at this time. */
       return NO_ERROR;
     }
 
-
-  top_n = (TOPN_TUPLES *) db_private_alloc (thread_p, sizeof (TOPN_TUPLES));
+  top_n = qexec_alloc_topn_tuples (thread_p, xasl->orderby_list, ubound, values_count, max_size);
   if (top_n == NULL)
     {
       error = ER_FAILED;
-      goto error_return;
+      GOTO_EXIT_ON_ERROR;
     }
 
-  top_n->max_size = max_size;
-  top_n->total_size = 0;
+  values = (DB_VALUE *) db_private_alloc (thread_p, values_count * sizeof (DB_VALUE));
+  values_p = (DB_VALUE **) db_private_alloc (thread_p, values_count * sizeof (DB_VALUE *));
+  if (values == NULL || values_p == NULL)
+    {
+      error = ER_FAILED;
+      GOTO_EXIT_ON_ERROR;
+    }
+  for (i = 0; i < values_count; i++)
+    {
+      db_make_null (&values[i]);
+      values_p[i] = &values[i];
+    }
 
-  top_n->tuples = (TOPN_TUPLE *) db_private_alloc (thread_p, ubound * sizeof (TOPN_TUPLE));
-  if (top_n->tuples == NULL)
+  memset (&tpl_descr, 0, sizeof (QFILE_TUPLE_DESCRIPTOR));
+  tpl_descr.f_valp = values_p;
+  tpl_descr.f_cnt = values_count;
+
+  if (qfile_open_list_scan (list_id, &scan_id) != NO_ERROR)
     {
       error = ER_FAILED;
-      goto error_return;
+      GOTO_EXIT_ON_ERROR;
     }
-  memset (top_n->tuples, 0, ubound * sizeof (TOPN_TUPLE));
 
-  heap = bh_create (thread_p, ubound, sizeof (TOPN_TUPLE *), qexec_topn_compare, top_n);
-  if (heap == NULL)
+  while ((scan_code = qfile_scan_list_next (thread_p, &scan_id, &tplrec, PEEK)) == S_SUCCESS)
+    {
+      for (i = 0; i < values_count; i++)
+	{
+	  /* values are only peeked; qexec_add_tuple_to_topn copies what it keeps */
+	  error = qexec_get_tuple_column_value (tplrec.tpl, i, &values[i], list_id->type_list.domp[i]);
+	  if (error != NO_ERROR)
+	    {
+	      GOTO_EXIT_ON_ERROR;
+	    }
+	}
+      tpl_descr.tpl_size = QFILE_GET_TUPLE_LENGTH (tplrec.tpl);
+
+      topn_status = qexec_add_tuple_to_topn (thread_p, top_n, &tpl_descr);
+
+      for (i = 0; i < values_count; i++)
+	{
+	  pr_clear_value (&values[i]);
+	}
+
+      if (topn_status == TOPN_FAILURE)
+	{
+	  error = ER_FAILED;
+	  GOTO_EXIT_ON_ERROR;
+	}
+      else if (topn_status == TOPN_OVERFLOW)
+	{
+	  /* the first tuples do not fit in memory; let the caller sort the list */
+	  goto exit_on_error;
+	}
+    }
+
+  if (scan_code == S_ERROR)
     {
       error = ER_FAILED;
-      goto error_return;
+      GOTO_EXIT_ON_ERROR;
     }
+  qfile_close_scan (thread_p, &scan_id);
 
-  top_n->heap = heap;
-  top_n->sort_items = xasl->orderby_list;
-  top_n->values_count = count;
+  /* replace the input list with the ordered top-n tuples */
+  ls_flag = QFILE_FLAG_ALL;
+  if (XASL_IS_FLAGED (xasl, XASL_TOP_MOST_XASL) && XASL_IS_FLAGED (xasl, XASL_TO_BE_CACHED))
+    {
+      QFILE_SET_FLAG (ls_flag, QFILE_FLAG_RESULT_FILE);
+    }
 
-  xasl->topn_items = top_n;
+  t_list_id = qfile_open_list (thread_p, &list_id->type_list, NULL, xasl_state->query_id, ls_flag);
+  if (t_list_id == NULL)
+    {
+      error = ER_FAILED;
+      GOTO_EXIT_ON_ERROR;
+    }
 
-  return NO_ERROR;
+  qfile_destroy_list (thread_p, list_id);
+  qfile_clear_list_id (list_id);
+  error = qfile_copy_list_id (list_id, t_list_id, true);
+  QFILE_FREE_AND_INIT_LIST_ID (t_list_id);
+  if (error != NO_ERROR)
+    {
+      GOTO_EXIT_ON_ERROR;
+    }
 
-error_return:
-  if (heap != NULL)
+  /* qexec_topn_tuples_to_list_id () consumes and frees the top-n object */
+  xasl->topn_items = top_n;
+  top_n = NULL;
+  error = qexec_topn_tuples_to_list_id (thread_p, xasl, xasl_state, outptr_list, true);
+  if (error != NO_ERROR)
     {
-      bh_destroy (thread_p, heap);
+      GOTO_EXIT_ON_ERROR;
     }
+
+  *is_done = true;
+
+exit_on_error:
+  qfile_close_scan (thread_p, &scan_id);
+
   if (top_n != NULL)
     {
-      if (top_n->tuples != NULL)
-	{
-	  db_private_free (thread_p, top_n->tuples);
-	}
-      db_private_free (thread_p, top_n);
+      qexec_free_topn_tuples (thread_p, top_n);
+    }
+  if (values != NULL)
+    {
+      db_private_free (thread_p, values);
+    }
+  if (values_p != NULL)
+    {
+      db_private_free (thread_p, values_p);
     }
 
   return error;
@@ -24243,9 +25566,11 @@ qexec_add_tuple_to_topn (THREAD_ENTRY * thread_p, TOPN_TUPLES * topn_items, QFIL
  *				   output listfile
  * return : error code or NO_ERROR
  * xasl (in) : xasl node
+ * outptr_list (in) : output pointer list describing the listfile columns
  */
 static int
-qexec_topn_tuples_to_list_id (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state, bool is_final)
+qexec_topn_tuples_to_list_id (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_STATE * xasl_state,
+			      OUTPTR_LIST * outptr_list, bool is_final)
 {
   QFILE_LIST_ID *list_id = NULL;
   QFILE_TUPLE_DESCRIPTOR *tpl_descr = NULL;
@@ -24301,7 +25626,7 @@ qexec_topn_tuples_to_list_id (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_ST
 	}
     }
 
-  varp = xasl->outptr_list->valptrp;
+  varp = outptr_list->valptrp;
   for (row = 0; row < heap->element_count; row++)
     {
       tuple = QEXEC_GET_BH_TOPN_TUPLE (heap, row);
@@ -24330,7 +25655,7 @@ qexec_topn_tuples_to_list_id (THREAD_ENTRY * thread_p, XASL_NODE * xasl, XASL_ST
 
       tpl_descr->f_cnt = 0;
 
-      for (varp = xasl->outptr_list->valptrp; varp != NULL; varp = varp->next)
+      for (varp = outptr_list->valptrp; varp != NULL; varp = varp->next)
 	{
 	  if (REGU_VARIABLE_IS_FLAGED (&varp->value, REGU_VARIABLE_HIDDEN_COLUMN))
 	    {
@@ -24772,6 +26097,8 @@ qexec_alloc_agg_hash_context (THREAD_ENTRY * thread_p, BUILDLIST_PROC_NODE * pro
   proc->agg_hash_context->curr_part_value = NULL;
   proc->agg_hash_context->sort_key.key = NULL;
   proc->agg_hash_context->sort_key.nkeys = 0;
+  proc->agg_hash_context->spill_tuple_lists = NULL;
+  proc->agg_hash_context->spill_part_lists = NULL;
 
   /*
    * create temporary dbvalue array
@@ -24870,53 +26197,18 @@ qexec_alloc_agg_hash_context (THREAD_ENTRY * thread_p, BUILDLIST_PROC_NODE * pro
   proc->agg_hash_context->sort_key.key = NULL;
   proc->agg_hash_context->sort_key.nkeys = 0;
 
-  /* create list files */
-  proc->agg_hash_context->part_list_id = qfile_open_list (thread_p, &type_list, NULL, xasl_state->query_id, 0);
-  proc->agg_hash_context->sorted_part_list_id = qfile_open_list (thread_p, &type_list, NULL, xasl_state->query_id, 0);
-
-  /* create tuple descriptor for partial list files */
-  proc->agg_hash_context->part_list_id->tpl_descr.f_cnt = type_list.type_cnt;
-  proc->agg_hash_context->part_list_id->tpl_descr.f_valp =
-    (DB_VALUE **) malloc (sizeof (DB_VALUE) * type_list.type_cnt);
-  if (proc->agg_hash_context->part_list_id->tpl_descr.f_valp == NULL)
-    {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, sizeof (DB_VALUE) * type_list.type_cnt);
-      goto exit_on_error;
-    }
-  proc->agg_hash_context->part_list_id->tpl_descr.clear_f_val_at_clone_decache =
-    (bool *) malloc (sizeof (bool) * type_list.type_cnt);
-  if (proc->agg_hash_context->part_list_id->tpl_descr.clear_f_val_at_clone_decache == NULL)
-    {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, sizeof (bool) * type_list.type_cnt);
-      goto exit_on_error;
-    }
-  for (i = 0; i < type_list.type_cnt; i++)
-    {
-      proc->agg_hash_context->part_list_id->tpl_descr.clear_f_val_at_clone_decache[i] = false;
-    }
+  /* initialize scan; this way we can call qfile_close_scan on an unopened scan without repercussions */
+  proc->agg_hash_context->part_scan_id.status = S_CLOSED;
 
-  proc->agg_hash_context->sorted_part_list_id->tpl_descr.f_cnt = type_list.type_cnt;
-  proc->agg_hash_context->sorted_part_list_id->tpl_descr.f_valp =
-    (DB_VALUE **) malloc (sizeof (DB_VALUE) * type_list.type_cnt);
-  if (proc->agg_hash_context->sorted_part_list_id->tpl_descr.f_valp == NULL)
-    {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, sizeof (DB_VALUE) * type_list.type_cnt);
-      goto exit_on_error;
-    }
-  proc->agg_hash_context->sorted_part_list_id->tpl_descr.clear_f_val_at_clone_decache =
-    (bool *) malloc (sizeof (bool) * type_list.type_cnt);
-  if (proc->agg_hash_context->sorted_part_list_id->tpl_descr.clear_f_val_at_clone_decache == NULL)
+  /* create list files */
+  proc->agg_hash_context->part_list_id = qexec_open_agg_hash_part_list (thread_p, &type_list, xasl_state->query_id);
+  proc->agg_hash_context->sorted_part_list_id =
+    qexec_open_agg_hash_part_list (thread_p, &type_list, xasl_state->query_id);
+  if (proc->agg_hash_context->part_list_id == NULL || proc->agg_hash_context->sorted_part_list_id == NULL)
     {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, sizeof (bool) * type_list.type_cnt);
+      db_private_free (thread_p, type_list.domp);
       goto exit_on_error;
     }
-  for (i = 0; i < type_list.type_cnt; i++)
-    {
-      proc->agg_hash_context->sorted_part_list_id->tpl_descr.clear_f_val_at_clone_decache[i] = false;
-    }
-
-  /* initialize scan; this way we can call qfile_close_scan on an unopened scan without repercussions */
-  proc->agg_hash_context->part_scan_id.status = S_CLOSED;
 
   /* free memory */
   db_private_free (thread_p, type_list.domp);
@@ -24983,6 +26275,12 @@ qexec_alloc_agg_hash_context (THREAD_ENTRY * thread_p, BUILDLIST_PROC_NODE * pro
   proc->agg_hash_context->sorted_count = 0;
   proc->agg_hash_context->state = HS_ACCEPT_ALL;
 
+  /* when groups don't have to be output in order and all first tuples are kept in the hash table, groups that do not
+   * fit in memory are spilled to hash partitions instead of being sorted */
+  proc->agg_hash_context->use_partitions = (!proc->g_output_first_tuple
+					    && !prm_get_bool_value (PRM_ID_AGG_HASH_RESPECT_ORDER));
+  proc->agg_hash_context->spill_count = 0;
+
   /* all ok */
   return NO_ERROR;
 
@@ -24992,6 +26290,54 @@ exit_on_error:
   return (error_code == NO_ERROR && (error_code = er_errid ()) == NO_ERROR) ? ER_FAILED : error_code;
 }
 
+/*
+ * qexec_open_agg_hash_part_list () - open a list file for partial accumulators of hash aggregate groups
+ *   returns: list file or NULL on error
+ *   thread_p(in): thread
+ *   type_list(in): type list of partial accumulators
+ *   query_id(in): query identifier
+ */
+static QFILE_LIST_ID *
+qexec_open_agg_hash_part_list (THREAD_ENTRY * thread_p, QFILE_TUPLE_VALUE_TYPE_LIST * type_list, QUERY_ID query_id)
+{
+  QFILE_LIST_ID *list_id;
+  int i;
+
+  list_id = qfile_open_list (thread_p, type_list, NULL, query_id, 0);
+  if (list_id == NULL)
+    {
+      return NULL;
+    }
+
+  /* create tuple descriptor, used for saving hash entries */
+  list_id->tpl_descr.f_cnt = type_list->type_cnt;
+  list_id->tpl_descr.f_valp = (DB_VALUE **) malloc (sizeof (DB_VALUE) * type_list->type_cnt);
+  if (list_id->tpl_descr.f_valp == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, sizeof (DB_VALUE) * type_list->type_cnt);
+      goto exit_on_error;
+    }
+  list_id->tpl_descr.clear_f_val_at_clone_decache = (bool *) malloc (sizeof (bool) * type_list->type_cnt);
+  if (list_id->tpl_descr.clear_f_val_at_clone_decache == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, sizeof (bool) * type_list->type_cnt);
+      goto exit_on_error;
+    }
+  for (i = 0; i < type_list->type_cnt; i++)
+    {
+      list_id->tpl_descr.clear_f_val_at_clone_decache[i] = false;
+    }
+
+  return list_id;
+
+exit_on_error:
+  qfile_close_list (thread_p, list_id);
+  qfile_destroy_list (thread_p, list_id);
+  QFILE_FREE_AND_INIT_LIST_ID (list_id);
+
+  return NULL;
+}
+
 /*
  * qexec_alloc_agg_hash_context () - dispose hash aggregate evaluation related
  *                                   structures used at runtime
@@ -25041,6 +26387,15 @@ qexec_free_agg_hash_context (THREAD_ENTRY * thread_p, BUILDLIST_PROC_NODE * proc
   /* close scan */
   qfile_close_scan (thread_p, &proc->agg_hash_context->part_scan_id);
 
+  /* free hash partitions */
+  if (proc->agg_hash_context->spill_tuple_lists != NULL)
+    {
+      qexec_hash_gby_destroy_partitions (thread_p, proc->agg_hash_context->spill_tuple_lists,
+					 proc->agg_hash_context->spill_part_lists);
+      db_private_free_and_init (thread_p, proc->agg_hash_context->spill_tuple_lists);
+      db_private_free_and_init (thread_p, proc->agg_hash_context->spill_part_lists);
+    }
+
   /* free partial lists */
   if (proc->agg_hash_context->part_list_id != NULL)
     {
@@ -25101,6 +26456,7 @@ qexec_free_agg_hash_context (THREAD_ENTRY * thread_p, BUILDLIST_PROC_NODE * proc
   proc->agg_hash_context->hash_size = 0;
   proc->agg_hash_context->group_count = 0;
   proc->agg_hash_context->tuple_count = 0;
+  proc->agg_hash_context->spill_count = 0;
 }
 
 /*
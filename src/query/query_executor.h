@@ -86,6 +86,7 @@ extern int qexec_clear_func_pred (THREAD_ENTRY * thread_p, func_pred * pred_filt
 extern int qexec_clear_partition_expression (THREAD_ENTRY * thread_p, regu_variable_node * expr);
 
 extern qfile_list_id *qexec_get_xasl_list_id (xasl_node * xasl);
+extern bool qexec_can_filter_join_probe (const xasl_node * probe_xasl);
 #if defined(CUBRID_DEBUG)
 extern void get_xasl_dumper_linked_in ();
 #endif
@@ -0,0 +1,898 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+//
+// Parallel index range scan - a large index range is split and scanned by worker threads
+//
+
+#include "scan_index_parallel.hpp"
+
+#include "access_spec.hpp"
+#include "btree.h"
+#include "dbtype.h"
+#include "error_manager.h"
+#include "heap_file.h"
+#include "log_impl.h"
+#include "object_primitive.h"
+#include "object_representation.h"
+#include "scan_manager.h"
+#include "system_parameter.h"
+#include "thread_entry_task.hpp"
+#include "thread_manager.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+  const int INDEX_SCAN_PARALLEL_PARTS_PER_THREAD = 4;	// sub-ranges for each worker, to balance uneven ones
+  const std::size_t INDEX_SCAN_PARALLEL_BATCH_ROWS = 256;
+  const std::size_t INDEX_SCAN_PARALLEL_BATCH_SIZE = 256 * 1024;	// bytes of records in a batch
+  const std::size_t INDEX_SCAN_PARALLEL_QUEUED_BATCHES = 2;	// filled batches waiting for each sub-range
+
+  // objects of a sub-range and their records, in key order
+  class index_scan_parallel_batch
+  {
+    public:
+      std::vector<OID> m_oids;
+      std::vector<RECDES> m_records;	// record data are offsets in m_area while the batch is filled
+      std::vector<char> m_area;
+      std::size_t m_area_length;
+      std::size_t m_read_pos;
+
+      index_scan_parallel_batch ()
+	: m_oids ()
+	, m_records ()
+	, m_area ()
+	, m_area_length (0)
+	, m_read_pos (0)
+      {
+	m_oids.reserve (INDEX_SCAN_PARALLEL_BATCH_ROWS);
+	m_records.reserve (INDEX_SCAN_PARALLEL_BATCH_ROWS);
+      }
+
+      void
+      add (const OID &oid, const RECDES &recdes)
+      {
+	std::size_t offset = DB_ALIGN (m_area_length, MAX_ALIGNMENT);
+	RECDES record = recdes;
+
+	if (m_area.size () < offset + recdes.length)
+	  {
+	    m_area.resize (MAX (offset + recdes.length, 2 * m_area.size ()));
+	  }
+	std::memcpy (m_area.data () + offset, recdes.data, recdes.length);
+	m_area_length = offset + recdes.length;
+
+	record.area_size = recdes.length;
+	record.data = (char *) offset;
+	m_oids.push_back (oid);
+	m_records.push_back (record);
+      }
+
+      bool
+      is_full () const
+      {
+	return m_oids.size () >= INDEX_SCAN_PARALLEL_BATCH_ROWS || m_area_length >= INDEX_SCAN_PARALLEL_BATCH_SIZE;
+      }
+
+      bool
+      is_empty () const
+      {
+	return m_oids.empty ();
+      }
+
+      // record data become pointers once the batch is not filled anymore
+      void
+      seal ()
+      {
+	for (RECDES &record : m_records)
+	  {
+	    record.data = m_area.data () + (std::size_t) record.data;
+	  }
+      }
+
+      void
+      clear ()
+      {
+	m_oids.clear ();
+	m_records.clear ();
+	m_area_length = 0;
+	m_read_pos = 0;
+      }
+  };
+
+  struct index_scan_parallel_part
+  {
+    key_val_range m_range;
+    std::deque<index_scan_parallel_batch *> m_batches;	// filled batches not consumed yet
+    bool m_done;		// all batches were queued
+  };
+
+  // workers are attached to the connection of the transaction, like the workers of a parallel index load
+  class index_scan_parallel_worker_manager : public cubthread::entry_manager
+  {
+    public:
+      css_conn_entry *m_conn;
+
+      index_scan_parallel_worker_manager ()
+	: m_conn (NULL)
+      {
+      }
+
+    protected:
+      void
+      on_create (context_type &context) override
+      {
+	context.claim_system_worker ();
+	context.conn_entry = m_conn;
+      }
+
+      void
+      on_retire (context_type &context) override
+      {
+	context.retire_system_worker ();
+	context.conn_entry = NULL;
+      }
+
+      void
+      on_recycle (context_type &context) override
+      {
+	context.tran_index = LOG_SYSTEM_TRAN_INDEX;
+      }
+  };
+}
+
+class index_scan_parallel
+{
+  public:
+    index_scan_parallel (BTID *btid, const OID *class_oid, const HFID *hfid, mvcc_snapshot *snapshot, bool ordered,
+			 int tran_index);
+    ~index_scan_parallel ();
+
+    int make_parts (key_val_range *kv_range, DB_VALUE *separators, int n_separators);
+    bool start_workers (THREAD_ENTRY *thread_p, int thread_count);
+
+    /* worker threads */
+    void execute_task (cubthread::entry &thread_ref);
+
+    /* scan thread */
+    SCAN_CODE next (THREAD_ENTRY *thread_p, OID **oid);
+    void get_record (RECDES *recdes) const;
+    void abort_and_wait ();
+
+  private:
+    int scan_part (THREAD_ENTRY *thread_p, HEAP_SCANCACHE *scan_cache, INDX_SCAN_ID *isidp,
+		   BTREE_ISCAN_OID_LIST *oid_list, std::size_t part_index, index_scan_parallel_batch *&batch);
+    bool pop_part (std::size_t &part_index);
+    index_scan_parallel_batch *get_free_batch ();
+    bool push_batch (std::size_t part_index, index_scan_parallel_batch *batch);
+    void end_part (std::size_t part_index);
+    void set_error (int error_code);
+    bool pick_batch ();
+
+    BTID m_btid;
+    OID m_class_oid;
+    HFID m_hfid;
+    mvcc_snapshot *m_snapshot;	// snapshot of the transaction; workers only read it
+    bool m_ordered;
+    int m_tran_index;
+
+    std::vector<index_scan_parallel_part> m_parts;
+    std::size_t m_next_part;	// next sub-range to give to a worker
+    std::size_t m_read_part;	// first sub-range that is not consumed
+
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::vector<index_scan_parallel_batch *> m_batches;
+    std::vector<index_scan_parallel_batch *> m_free_batches;
+    index_scan_parallel_batch *m_read_batch;
+
+    index_scan_parallel_worker_manager m_worker_manager;
+    cubthread::entry_workpool *m_workpool;
+    int m_running_tasks;
+    bool m_aborted;
+    int m_error_code;
+    OR_ALIGNED_BUF (1024) m_error_area;
+    bool m_has_error_area;
+};
+
+namespace
+{
+  class index_scan_parallel_task : public cubthread::entry_task
+  {
+    public:
+      index_scan_parallel_task (index_scan_parallel &scan)
+	: m_scan (scan)
+      {
+      }
+
+      void
+      execute (cubthread::entry &thread_ref) override
+      {
+	m_scan.execute_task (thread_ref);
+      }
+
+    private:
+      index_scan_parallel &m_scan;
+  };
+
+  RANGE
+  index_scan_parallel_make_range (RANGE lower, RANGE upper)
+  {
+    // lower is GE_*, GT_* or INF_* and upper is *_LE, *_LT or *_INF; only their bound of interest is used
+    bool lower_ge = (lower == GE_LE || lower == GE_LT || lower == GE_INF);
+    bool lower_gt = (lower == GT_LE || lower == GT_LT || lower == GT_INF);
+    bool upper_le = (upper == GE_LE || upper == GT_LE || upper == INF_LE);
+    bool upper_lt = (upper == GE_LT || upper == GT_LT || upper == INF_LT);
+
+    if (lower_ge)
+      {
+	return upper_le ? GE_LE : (upper_lt ? GE_LT : GE_INF);
+      }
+    else if (lower_gt)
+      {
+	return upper_le ? GT_LE : (upper_lt ? GT_LT : GT_INF);
+      }
+    else
+      {
+	return upper_le ? INF_LE : (upper_lt ? INF_LT : INF_INF);
+      }
+  }
+}
+
+index_scan_parallel::index_scan_parallel (BTID *btid, const OID *class_oid, const HFID *hfid,
+    mvcc_snapshot *snapshot, bool ordered, int tran_index)
+  : m_btid (*btid)
+  , m_class_oid (*class_oid)
+  , m_hfid (*hfid)
+  , m_snapshot (snapshot)
+  , m_ordered (ordered)
+  , m_tran_index (tran_index)
+  , m_parts ()
+  , m_next_part (0)
+  , m_read_part (0)
+  , m_mutex ()
+  , m_cond ()
+  , m_batches ()
+  , m_free_batches ()
+  , m_read_batch (NULL)
+  , m_worker_manager ()
+  , m_workpool (NULL)
+  , m_running_tasks (0)
+  , m_aborted (false)
+  , m_error_code (NO_ERROR)
+  , m_has_error_area (false)
+{
+}
+
+index_scan_parallel::~index_scan_parallel ()
+{
+  assert (m_running_tasks == 0 && m_workpool == NULL);
+
+  for (index_scan_parallel_part &part : m_parts)
+    {
+      pr_clear_value (&part.m_range.key1);
+      pr_clear_value (&part.m_range.key2);
+    }
+  for (index_scan_parallel_batch *batch : m_batches)
+    {
+      delete batch;
+    }
+}
+
+/*
+ * make_parts () - split the range at the separators
+ *
+ * return	     : error code
+ * kv_range (in)     : range of the scan
+ * separators (in)   : keys strictly inside the range, in ascending order; their values are moved to the sub-ranges
+ * n_separators (in) : number of separators
+ */
+int
+index_scan_parallel::make_parts (key_val_range *kv_range, DB_VALUE *separators, int n_separators)
+{
+  int error_code = NO_ERROR;
+
+  m_parts.resize (n_separators + 1);
+  for (int i = 0; i <= n_separators; i++)
+    {
+      index_scan_parallel_part &part = m_parts[i];
+      RANGE lower = (i == 0) ? kv_range->range : GE_INF;
+      RANGE upper = (i == n_separators) ? kv_range->range : INF_LT;
+
+      part.m_range.range = index_scan_parallel_make_range (lower, upper);
+      part.m_range.is_truncated = false;
+      part.m_range.num_index_term = (part.m_range.range == INF_INF) ? 0 : 1;
+      db_make_null (&part.m_range.key1);
+      db_make_null (&part.m_range.key2);
+      part.m_done = false;
+    }
+
+  for (int i = 0; i <= n_separators; i++)
+    {
+      index_scan_parallel_part &part = m_parts[i];
+
+      if (i == 0)
+	{
+	  error_code = pr_clone_value (&kv_range->key1, &part.m_range.key1);
+	}
+      else
+	{
+	  /* the separator is the upper bound of the previous sub-range and the lower bound of this one */
+	  error_code = pr_clone_value (&separators[i - 1], &part.m_range.key1);
+	}
+      if (error_code != NO_ERROR)
+	{
+	  return error_code;
+	}
+
+      if (i == n_separators)
+	{
+	  error_code = pr_clone_value (&kv_range->key2, &part.m_range.key2);
+	}
+      else
+	{
+	  error_code = pr_clone_value (&separators[i], &part.m_range.key2);
+	}
+      if (error_code != NO_ERROR)
+	{
+	  return error_code;
+	}
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * start_workers () - start the worker threads that scan the sub-ranges
+ *
+ * return	     : false if no worker could be started
+ * thread_p (in)     : scan thread
+ * thread_count (in) : number of workers
+ */
+bool
+index_scan_parallel::start_workers (THREAD_ENTRY *thread_p, int thread_count)
+{
+  m_worker_manager.m_conn = thread_p->conn_entry;
+
+  m_workpool =
+	  thread_get_manager ()->create_worker_pool (thread_count, thread_count, "Parallel index scan pool",
+	      &m_worker_manager, 1, cubthread::is_logging_configured (cubthread::LOG_WORKER_POOL_INDEX_SCAN));
+  if (m_workpool == NULL)
+    {
+      return false;
+    }
+
+  m_running_tasks = thread_count;
+  for (int i = 0; i < thread_count; i++)
+    {
+      thread_get_manager ()->push_task (m_workpool, new index_scan_parallel_task (*this));
+    }
+  return true;
+}
+
+/*
+ * execute_task () - scan sub-ranges until all of them are taken
+ *
+ * thread_ref (in) : worker thread
+ */
+void
+index_scan_parallel::execute_task (cubthread::entry &thread_ref)
+{
+  THREAD_ENTRY *thread_p = &thread_ref;
+  int save_tran_index = thread_ref.tran_index;
+  HEAP_SCANCACHE scan_cache;
+  INDX_SCAN_ID *isidp = NULL;
+  BTREE_ISCAN_OID_LIST oid_list;
+  std::vector<OID> oid_buffer (ISCAN_OID_BUFFER_CAPACITY / OR_OID_SIZE);
+  index_scan_parallel_batch *batch = NULL;
+  bool scancache_inited = false;
+  std::size_t part_index;
+  int error_code = NO_ERROR;
+
+  /* objects are selected for the transaction that runs the query */
+  thread_ref.tran_index = m_tran_index;
+
+  oid_list.oidp = oid_buffer.data ();
+  oid_list.capacity = (int) oid_buffer.size ();
+  oid_list.max_oid_cnt = ISCAN_OID_BUFFER_COUNT;
+  oid_list.oid_cnt = 0;
+  oid_list.next_list = NULL;
+
+  isidp = (INDX_SCAN_ID *) db_private_alloc (thread_p, sizeof (INDX_SCAN_ID));
+  if (isidp == NULL)
+    {
+      error_code = ER_OUT_OF_VIRTUAL_MEMORY;
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, error_code, 1, sizeof (INDX_SCAN_ID));
+      goto end;
+    }
+
+  error_code = heap_scancache_start (thread_p, &scan_cache, &m_hfid, &m_class_oid, false, true, m_snapshot);
+  if (error_code != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      goto end;
+    }
+  scancache_inited = true;
+
+  while (pop_part (part_index))
+    {
+      error_code = scan_part (thread_p, &scan_cache, isidp, &oid_list, part_index, batch);
+      if (error_code != NO_ERROR)
+	{
+	  break;
+	}
+      end_part (part_index);
+    }
+
+end:
+  if (error_code != NO_ERROR)
+    {
+      set_error (error_code);
+    }
+  if (scancache_inited)
+    {
+      (void) heap_scancache_end (thread_p, &scan_cache);
+    }
+  if (isidp != NULL)
+    {
+      db_private_free_and_init (thread_p, isidp);
+    }
+
+  thread_ref.tran_index = save_tran_index;
+
+  std::unique_lock<std::mutex> ulock (m_mutex);
+  if (batch != NULL)
+    {
+      batch->clear ();
+      m_free_batches.push_back (batch);
+    }
+  m_running_tasks--;
+  m_cond.notify_all ();
+}
+
+/*
+ * scan_part () - select the visible objects of a sub-range, fetch their records and queue them
+ *
+ * return	   : error code
+ * thread_p (in)   : worker thread
+ * scan_cache (in) : heap scan cache of the worker
+ * isidp (in)	   : index scan of the worker
+ * oid_list (in)   : OID buffer of the worker
+ * part_index (in) : sub-range
+ * batch (in/out)  : batch being filled
+ */
+int
+index_scan_parallel::scan_part (THREAD_ENTRY *thread_p, HEAP_SCANCACHE *scan_cache, INDX_SCAN_ID *isidp,
+				BTREE_ISCAN_OID_LIST *oid_list, std::size_t part_index,
+				index_scan_parallel_batch *&batch)
+{
+  BTREE_SCAN *bts = &isidp->bt_scan;
+  RECDES recdes = RECDES_INITIALIZER;
+  SCAN_CODE scan_code;
+  int error_code = NO_ERROR;
+
+  scan_init_index_scan (isidp, oid_list, m_snapshot);
+  isidp->bitmap.use = false;
+  BTREE_INIT_SCAN (bts);
+
+  error_code = btree_prepare_bts (thread_p, bts, &m_btid, isidp, &m_parts[part_index].m_range, NULL, &m_class_oid,
+				  NULL, NULL, true, NULL);
+  if (error_code != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      return error_code;
+    }
+
+  do
+    {
+      error_code = btree_range_scan (thread_p, bts, btree_range_scan_select_visible_oids);
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  break;
+	}
+
+      for (int i = 0; i < bts->n_oids_read_last_iteration; i++)
+	{
+	  OID *oid = &oid_list->oidp[i];
+
+	  scan_code = heap_get_visible_version (thread_p, oid, NULL, &recdes, scan_cache, COPY, NULL_CHN);
+	  if (scan_code == S_SNAPSHOT_NOT_SATISFIED || scan_code == S_DOESNT_EXIST)
+	    {
+	      /* same as the scan thread: deleted objects are ignored */
+	      er_clear ();
+	      continue;
+	    }
+	  else if (scan_code != S_SUCCESS)
+	    {
+	      ASSERT_ERROR_AND_SET (error_code);
+	      break;
+	    }
+
+	  if (batch == NULL)
+	    {
+	      batch = get_free_batch ();
+	    }
+	  batch->add (*oid, recdes);
+	  if (batch->is_full ())
+	    {
+	      bool is_queued = push_batch (part_index, batch);
+
+	      batch = NULL;
+	      if (!is_queued)
+		{
+		  /* the scan was aborted */
+		  btree_scan_clear_key (bts);
+		  return NO_ERROR;
+		}
+	    }
+	}
+    }
+  while (error_code == NO_ERROR && !BTREE_END_OF_SCAN (bts));
+
+  btree_scan_clear_key (bts);
+  if (error_code != NO_ERROR)
+    {
+      return error_code;
+    }
+
+  if (batch != NULL && !batch->is_empty ())
+    {
+      (void) push_batch (part_index, batch);
+      batch = NULL;
+    }
+  return NO_ERROR;
+}
+
+bool
+index_scan_parallel::pop_part (std::size_t &part_index)
+{
+  std::unique_lock<std::mutex> ulock (m_mutex);
+
+  if (m_aborted || m_next_part >= m_parts.size ())
+    {
+      return false;
+    }
+  part_index = m_next_part++;
+  return true;
+}
+
+index_scan_parallel_batch *
+index_scan_parallel::get_free_batch ()
+{
+  std::unique_lock<std::mutex> ulock (m_mutex);
+  index_scan_parallel_batch *batch;
+
+  if (!m_free_batches.empty ())
+    {
+      batch = m_free_batches.back ();
+      m_free_batches.pop_back ();
+      return batch;
+    }
+
+  batch = new index_scan_parallel_batch ();
+  m_batches.push_back (batch);
+  return batch;
+}
+
+/*
+ * push_batch () - queue a filled batch of a sub-range; wait while the sub-range has enough batches queued
+ *
+ * return	   : false if the scan was aborted
+ * part_index (in) : sub-range
+ * batch (in)	   : filled batch
+ */
+bool
+index_scan_parallel::push_batch (std::size_t part_index, index_scan_parallel_batch *batch)
+{
+  std::unique_lock<std::mutex> ulock (m_mutex);
+  index_scan_parallel_part &part = m_parts[part_index];
+
+  /* sub-ranges are given to workers in order, so the sub-range consumed in an ordered scan always has a worker that
+   * does not wait here because of the sub-ranges that follow */
+  m_cond.wait (ulock, [&] { return m_aborted || part.m_batches.size () < INDEX_SCAN_PARALLEL_QUEUED_BATCHES; });
+  if (m_aborted)
+    {
+      batch->clear ();
+      m_free_batches.push_back (batch);
+      return false;
+    }
+
+  batch->seal ();
+  part.m_batches.push_back (batch);
+  m_cond.notify_all ();
+  return true;
+}
+
+void
+index_scan_parallel::end_part (std::size_t part_index)
+{
+  std::unique_lock<std::mutex> ulock (m_mutex);
+
+  m_parts[part_index].m_done = true;
+  m_cond.notify_all ();
+}
+
+void
+index_scan_parallel::set_error (int error_code)
+{
+  std::unique_lock<std::mutex> ulock (m_mutex);
+
+  if (m_error_code == NO_ERROR)
+    {
+      int length = (int) OR_ALIGNED_BUF_SIZE (m_error_area);
+
+      /* the error is set on the worker thread; keep it to set it again on the scan thread */
+      m_error_code = error_code;
+      m_has_error_area = (er_errid () == error_code
+			  && er_get_area_error (OR_ALIGNED_BUF_START (m_error_area), &length) != NULL);
+    }
+  m_aborted = true;
+  m_cond.notify_all ();
+}
+
+/*
+ * pick_batch () - take the next batch to consume; must be called with the mutex locked
+ *
+ * return : true if a batch was taken
+ */
+bool
+index_scan_parallel::pick_batch ()
+{
+  /* skip the sub-ranges that are consumed entirely */
+  while (m_read_part < m_parts.size () && m_parts[m_read_part].m_done && m_parts[m_read_part].m_batches.empty ())
+    {
+      m_read_part++;
+    }
+
+  for (std::size_t i = m_read_part; i < m_parts.size () && i < m_next_part; i++)
+    {
+      index_scan_parallel_part &part = m_parts[i];
+
+      if (!part.m_batches.empty ())
+	{
+	  m_read_batch = part.m_batches.front ();
+	  part.m_batches.pop_front ();
+	  m_cond.notify_all ();
+	  return true;
+	}
+      if (m_ordered)
+	{
+	  /* keep the index order */
+	  break;
+	}
+    }
+  return false;
+}
+
+/*
+ * next () - get the next object of the scan
+ *
+ * return	 : S_SUCCESS, S_END or S_ERROR
+ * thread_p (in) : scan thread
+ * oid (out)	 : object; valid until the next call
+ */
+SCAN_CODE
+index_scan_parallel::next (THREAD_ENTRY *thread_p, OID **oid)
+{
+  while (true)
+    {
+      if (m_read_batch != NULL && m_read_batch->m_read_pos + 1 < m_read_batch->m_oids.size ())
+	{
+	  m_read_batch->m_read_pos++;
+	  *oid = &m_read_batch->m_oids[m_read_batch->m_read_pos];
+	  return S_SUCCESS;
+	}
+
+      std::unique_lock<std::mutex> ulock (m_mutex);
+
+      if (m_read_batch != NULL)
+	{
+	  /* give the consumed batch back to the workers */
+	  m_read_batch->clear ();
+	  m_free_batches.push_back (m_read_batch);
+	  m_read_batch = NULL;
+	}
+
+      while (m_error_code == NO_ERROR && !pick_batch ())
+	{
+	  bool dummy_continue_checking = true;
+
+	  if (m_read_part >= m_parts.size ())
+	    {
+	      return S_END;
+	    }
+
+	  m_cond.wait_for (ulock, std::chrono::milliseconds (10));
+
+	  /* Check for interrupts. */
+	  if (logtb_is_interrupted (thread_p, true, &dummy_continue_checking))
+	    {
+	      m_aborted = true;
+	      m_cond.notify_all ();
+	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_INTERRUPTED, 0);
+	      return S_ERROR;
+	    }
+	}
+
+      if (m_error_code != NO_ERROR)
+	{
+	  if (m_has_error_area)
+	    {
+	      (void) er_set_area_error (OR_ALIGNED_BUF_START (m_error_area));
+	    }
+	  else
+	    {
+	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_FAILED, 0);
+	    }
+	  return S_ERROR;
+	}
+
+      /* the read position is moved on the first object of the batch */
+      assert (m_read_batch != NULL && !m_read_batch->is_empty ());
+      m_read_batch->m_read_pos = 0;
+      *oid = &m_read_batch->m_oids[0];
+      return S_SUCCESS;
+    }
+}
+
+/*
+ * get_record () - get the record of the current object, fetched by a worker
+ *
+ * recdes (out) : record; valid until the next call of next ()
+ */
+void
+index_scan_parallel::get_record (RECDES *recdes) const
+{
+  assert (m_read_batch != NULL && m_read_batch->m_read_pos < m_read_batch->m_records.size ());
+
+  *recdes = m_read_batch->m_records[m_read_batch->m_read_pos];
+}
+
+/*
+ * abort_and_wait () - stop the workers that are still running, wait for all of them to end and destroy their pool
+ */
+void
+index_scan_parallel::abort_and_wait ()
+{
+  {
+    std::unique_lock<std::mutex> ulock (m_mutex);
+
+    m_aborted = true;
+    m_cond.notify_all ();
+    m_cond.wait (ulock, [this] { return m_running_tasks == 0; });
+  }
+
+  if (m_workpool != NULL)
+    {
+      thread_get_manager ()->destroy_worker_pool (m_workpool);
+      m_workpool = NULL;
+    }
+}
+
+/*
+ * index_scan_parallel_start () - start a parallel scan of an index range if the range is large enough
+ *
+ * return	   : error code
+ * thread_p (in)   : scan thread
+ * btid (in)	   : index
+ * class_oid (in)  : class of the objects
+ * hfid (in)	   : heap file of the class
+ * kv_range (in)   : range of the scan; a single column range that is not truncated
+ * snapshot (in)   : snapshot of the transaction
+ * ordered (in)    : true if the objects must be returned in index order
+ * parallel (out)  : the parallel scan, or NULL if the range is scanned by the scan thread
+ */
+int
+index_scan_parallel_start (THREAD_ENTRY *thread_p, BTID *btid, const OID *class_oid, const HFID *hfid,
+			   key_val_range *kv_range, mvcc_snapshot *snapshot, bool ordered,
+			   index_scan_parallel **parallel)
+{
+  int thread_count = prm_get_integer_value (PRM_ID_INDEX_SCAN_THREAD_COUNT);
+  int max_separators = thread_count * INDEX_SCAN_PARALLEL_PARTS_PER_THREAD - 1;
+  std::vector<DB_VALUE> separators;
+  int n_separators = 0;
+  int n_leaves = 0;
+  index_scan_parallel *scan = NULL;
+  int error_code = NO_ERROR;
+
+  *parallel = NULL;
+
+#if defined (SERVER_MODE)
+  if (thread_count < 2)
+    {
+      return NO_ERROR;
+    }
+
+  separators.resize (max_separators);
+  error_code = btree_get_range_separators (thread_p, btid, kv_range, max_separators, separators.data (),
+		 &n_separators, &n_leaves);
+  if (error_code != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      return error_code;
+    }
+
+  if (n_leaves >= prm_get_integer_value (PRM_ID_INDEX_SCAN_PARALLEL_MIN_PAGES) && n_separators > 0)
+    {
+      scan = new index_scan_parallel (btid, class_oid, hfid, snapshot, ordered, LOG_FIND_THREAD_TRAN_INDEX (thread_p));
+
+      error_code = scan->make_parts (kv_range, separators.data (), n_separators);
+      if (error_code != NO_ERROR || !scan->start_workers (thread_p, MIN (thread_count, n_separators + 1)))
+	{
+	  /* scanned by the scan thread */
+	  delete scan;
+	  scan = NULL;
+	}
+    }
+
+  for (int i = 0; i < n_separators; i++)
+    {
+      pr_clear_value (&separators[i]);
+    }
+#endif /* SERVER_MODE */
+
+  *parallel = scan;
+  return error_code;
+}
+
+/*
+ * index_scan_parallel_next () - get the next object of a parallel scan
+ *
+ * return	 : S_SUCCESS, S_END or S_ERROR
+ * thread_p (in) : scan thread
+ * parallel (in) : parallel scan
+ * oid (out)	 : object; valid until the next call
+ */
+SCAN_CODE
+index_scan_parallel_next (THREAD_ENTRY *thread_p, index_scan_parallel *parallel, OID **oid)
+{
+  return parallel->next (thread_p, oid);
+}
+
+/*
+ * index_scan_parallel_get_record () - get the record of the current object of a parallel scan
+ *
+ * parallel (in) : parallel scan
+ * recdes (out)  : record; valid until the next call of index_scan_parallel_next
+ */
+void
+index_scan_parallel_get_record (index_scan_parallel *parallel, RECDES *recdes)
+{
+  parallel->get_record (recdes);
+}
+
+/*
+ * index_scan_parallel_end () - stop the workers of a parallel scan and free it
+ *
+ * thread_p (in) : scan thread
+ * parallel (in) : parallel scan
+ */
+void
+index_scan_parallel_end (THREAD_ENTRY *thread_p, index_scan_parallel *parallel)
+{
+  parallel->abort_and_wait ();
+  delete parallel;
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+//
+// Parallel index range scan - a large index range is split and scanned by worker threads
+//
+// The range is split into sub-ranges using the separator keys of the non-leaf nodes that cover it (see
+// btree_get_range_separators). Worker threads of the transaction scan the sub-ranges concurrently, each with its own
+// b-tree scan and heap scan cache: they select the objects visible to the snapshot of the transaction, fetch their
+// records and queue them in batches for the sub-range.
+//
+// The scan thread consumes the batches and evaluates the data filter and the rest of the XASL itself, since
+// predicates and regulator variables cannot be shared between threads. When the output has to keep the index order,
+// sub-ranges are consumed one after the other; otherwise the first batch ready is consumed.
+//
+
+#ifndef _SCAN_INDEX_PARALLEL_HPP_
+#define _SCAN_INDEX_PARALLEL_HPP_
+
+#if !defined (SERVER_MODE) && !defined (SA_MODE)
+#error Belongs to server module
+#endif /* !defined (SERVER_MODE) && !defined (SA_MODE) */
+
+#include "storage_common.h"
+#include "thread_compat.hpp"
+
+// forward definitions
+struct key_val_range;
+struct mvcc_snapshot;
+
+class index_scan_parallel;
+
+int index_scan_parallel_start (THREAD_ENTRY *thread_p, BTID *btid, const OID *class_oid, const HFID *hfid,
+			       key_val_range *kv_range, mvcc_snapshot *snapshot, bool ordered,
+			       index_scan_parallel **parallel);
+SCAN_CODE index_scan_parallel_next (THREAD_ENTRY *thread_p, index_scan_parallel *parallel, OID **oid);
+void index_scan_parallel_get_record (index_scan_parallel *parallel, RECDES *recdes);
+void index_scan_parallel_end (THREAD_ENTRY *thread_p, index_scan_parallel *parallel);
+
+#endif // _SCAN_INDEX_PARALLEL_HPP_
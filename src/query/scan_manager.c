@@ -32,6 +32,8 @@
 
 #include "error_manager.h"
 #include "heap_file.h"
+#include "heap_zone_map.hpp"
+#include "scan_index_parallel.hpp"
 #include "fetch.h"
 #include "list_file.h"
 #include "set_scan.h"
@@ -139,6 +141,10 @@ static int scan_Iscan_oid_buf_list_count = 0;
 
 #define SCAN_ISCAN_OID_BUF_LIST_DEFAULT_SIZE 10
 
+/* bloom filter sizing of the runtime join filter */
+#define SCAN_JOIN_FILTER_BITS_PER_KEY 8
+#define SCAN_JOIN_FILTER_MAX_BLOOM_WORDS (1 << 14)	/* 128K per join attribute */
+
 static void scan_init_scan_pred (SCAN_PRED * scan_pred_p, regu_variable_list_node * regu_list, PRED_EXPR * pred_expr,
 				 PR_EVAL_FNC pr_eval_fnc);
 static void scan_init_scan_attrs (SCAN_ATTRS * scan_attrs_p, int num_attrs, ATTR_ID * attr_ids,
@@ -162,8 +168,25 @@ static int scan_dbvals_to_midxkey (THREAD_ENTRY * thread_p, DB_VALUE * retval, b
 				   int key_minmax, bool is_iss);
 static int scan_regu_key_to_index_key (THREAD_ENTRY * thread_p, KEY_RANGE * key_ranges, KEY_VAL_RANGE * key_val_range,
 				       INDX_SCAN_ID * iscan_id, TP_DOMAIN * btree_domainp, VAL_DESCR * vd);
+static void scan_prefetch_index_oidset (THREAD_ENTRY * thread_p, INDX_SCAN_ID * iscan_id);
+static int scan_compare_vpids (const void *a, const void *b);
 static int scan_get_index_oidset (THREAD_ENTRY * thread_p, SCAN_ID * s_id, DB_BIGINT * key_limit_upper,
 				  DB_BIGINT * key_limit_lower);
+static int scan_index_range_to_bitmap (THREAD_ENTRY * thread_p, SCAN_ID * s_id, int max_oids, OID ** oids,
+				       int *capacity, INDEX_BITMAP_WORD ** words, int *n_words);
+static int scan_compare_bitmap_words (const INDEX_BITMAP_WORD * word1, const INDEX_BITMAP_WORD * word2);
+static int scan_oids_to_bitmap (THREAD_ENTRY * thread_p, OID * oids, int n_oids, INDEX_BITMAP_WORD ** words,
+				int *n_words);
+static void scan_make_bitmap_lossy (INDEX_BITMAP_WORD * words, int *n_words);
+static int scan_add_lossy_pages (THREAD_ENTRY * thread_p, OID * oids, int n_oids, INDEX_BITMAP_WORD ** words,
+				 int *n_words);
+static int scan_bitmap_page_end (const INDEX_BITMAP_WORD * words, int n_words, int start);
+static int scan_combine_bitmaps (THREAD_ENTRY * thread_p, INDEX_BITMAP_WORD ** words, int *n_words,
+				 INDEX_BITMAP_WORD * other_words, int n_other_words, int op);
+static int scan_build_index_bitmap (THREAD_ENTRY * thread_p, SCAN_ID * s_id);
+static int scan_get_index_bitmap_oidset (THREAD_ENTRY * thread_p, SCAN_ID * s_id);
+static int scan_get_lossy_page_oids (THREAD_ENTRY * thread_p, INDX_SCAN_ID * iscan_id, INDEX_BITMAP_WORD * word);
+static void scan_clear_index_bitmap (THREAD_ENTRY * thread_p, INDX_SCAN_ID * iscan_id);
 static void scan_init_scan_id (SCAN_ID * scan_id, bool force_select_lock, SCAN_OPERATION_TYPE scan_op_type, int fixed,
 			       int grouped, QPROC_SINGLE_FETCH single_fetch, DB_VALUE * join_dbval,
 			       val_list_node * val_list, VAL_DESCR * vd);
@@ -174,6 +197,9 @@ static SCAN_CODE scan_next_heap_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id
 static SCAN_CODE scan_next_heap_page_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
 static SCAN_CODE scan_next_class_attr_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
 static SCAN_CODE scan_next_index_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
+#if defined (SERVER_MODE)
+static int scan_start_parallel_index_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
+#endif /* SERVER_MODE */
 static SCAN_CODE scan_next_index_key_info_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
 static SCAN_CODE scan_next_index_node_info_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
 static SCAN_CODE scan_next_index_lookup_heap (THREAD_ENTRY * thread_p, SCAN_ID * scan_id, INDX_SCAN_ID * isidp,
@@ -199,6 +225,10 @@ static SCAN_CODE scan_get_next_iss_value (THREAD_ENTRY * thread_p, SCAN_ID * sca
 static SCAN_CODE call_get_next_index_oidset (THREAD_ENTRY * thread_p, SCAN_ID * scan_id, INDX_SCAN_ID * isidp,
 					     bool should_go_to_next_value);
 static int scan_key_compare (DB_VALUE * val1, DB_VALUE * val2, int num_index_term);
+static bool scan_join_filter_get_key (DB_VALUE * value, DB_TYPE type, INT64 * key);
+static UINT64 scan_join_filter_hash (INT64 key);
+static DB_LOGICAL scan_join_filter_eval (THREAD_ENTRY * thread_p, SCAN_JOIN_FILTER * filter, OID * oid,
+					 RECDES * recdes);
 
 /*
  * scan_init_iss () - initialize index skip scan structure
@@ -294,6 +324,7 @@ scan_init_index_scan (INDX_SCAN_ID * isidp, struct btree_iscan_oid_list *oid_lis
   isidp->need_count_only = false;
   isidp->check_not_vacuumed = false;
   isidp->not_vacuumed_res = DISK_VALID;
+  isidp->parallel = NULL;
 }
 
 /*
@@ -2149,6 +2180,106 @@ scan_regu_key_to_index_key (THREAD_ENTRY * thread_p, KEY_RANGE * key_ranges, KEY
   return ret;
 }
 
+/*
+ * scan_compare_vpids () - qsort comparator of page identifiers
+ *   return: negative, zero or positive
+ *   a(in): first VPID
+ *   b(in): second VPID
+ */
+static int
+scan_compare_vpids (const void *a, const void *b)
+{
+  const VPID *vpid1 = (const VPID *) a;
+  const VPID *vpid2 = (const VPID *) b;
+
+  if (vpid1->volid != vpid2->volid)
+    {
+      return vpid1->volid < vpid2->volid ? -1 : 1;
+    }
+  if (vpid1->pageid != vpid2->pageid)
+    {
+      return vpid1->pageid < vpid2->pageid ? -1 : 1;
+    }
+  return 0;
+}
+
+/*
+ * scan_prefetch_index_oidset () - prefetch the heap pages of the objects of an OID buffer and, if the order of the
+ *				   keys is not needed, sort the objects in heap order
+ *   return: void
+ *   iscan_id(in/out): index scan identifier
+ *
+ * Note: Objects of a non-covering index scan are fetched in key order, which for a key not correlated to the heap
+ *       order visits heap pages in random order. When the OID buffer visits at least index_scan_prefetch_min_pages
+ *       pages, the distinct pages are requested in background in page order, so the fetches that follow find them
+ *       in the file system cache. When the scan output does not skip ORDER BY or GROUP BY, the objects of the buffer
+ *       are also sorted by OID so that each page is fixed once.
+ */
+static void
+scan_prefetch_index_oidset (THREAD_ENTRY * thread_p, INDX_SCAN_ID * iscan_id)
+{
+  OID *oids = iscan_id->oid_list->oidp;
+  int n_oids = iscan_id->oids_count;
+  int min_pages = prm_get_integer_value (PRM_ID_INDEX_SCAN_PREFETCH_MIN_PAGES);
+  VPID *vpids = NULL;
+  int n_visits = 0;
+  int n_pages = 0;
+  int i;
+
+  /* count the page visits in key order */
+  for (i = 0; i < n_oids; i++)
+    {
+      if (i == 0 || oids[i].pageid != oids[i - 1].pageid || oids[i].volid != oids[i - 1].volid)
+	{
+	  n_visits++;
+	}
+    }
+  if (n_visits < min_pages)
+    {
+      /* few pages; they are read anyway */
+      return;
+    }
+
+  vpids = (VPID *) db_private_alloc (thread_p, n_visits * sizeof (VPID));
+  if (vpids == NULL)
+    {
+      /* only an optimization */
+      er_clear ();
+      return;
+    }
+
+  for (i = 0; i < n_oids; i++)
+    {
+      if (i == 0 || oids[i].pageid != oids[i - 1].pageid || oids[i].volid != oids[i - 1].volid)
+	{
+	  vpids[n_pages].volid = oids[i].volid;
+	  vpids[n_pages].pageid = oids[i].pageid;
+	  n_pages++;
+	}
+    }
+  qsort (vpids, n_pages, sizeof (VPID), scan_compare_vpids);
+  for (i = 1, n_pages = 1; i < n_visits; i++)
+    {
+      if (!VPID_EQ (&vpids[i], &vpids[n_pages - 1]))
+	{
+	  vpids[n_pages++] = vpids[i];
+	}
+    }
+
+  if (n_pages >= min_pages)
+    {
+      (void) pgbuf_prefetch_pages (thread_p, vpids, n_pages);
+    }
+
+  if (n_visits > n_pages && !iscan_id->indx_info->orderby_skip && !iscan_id->indx_info->groupby_skip)
+    {
+      /* pages are visited more than once in key order */
+      qsort (oids, n_oids, sizeof (OID), oid_compare);
+    }
+
+  db_private_free_and_init (thread_p, vpids);
+}
+
 /*
  * scan_get_index_oidset () - Fetch the next group of set of object identifiers
  * from the index associated with the scan identifier.
@@ -2662,6 +2793,13 @@ scan_get_index_oidset (THREAD_ENTRY * thread_p, SCAN_ID * s_id, DB_BIGINT * key_
     {
       qsort (iscan_id->oid_list->oidp, iscan_id->oids_count, sizeof (OID), oid_compare);
     }
+  else if (iscan_id->oid_list != NULL && iscan_id->oid_list->oidp != NULL && iscan_id->oids_count > 1
+	   && iscan_id->need_count_only == false && !SCAN_IS_INDEX_COVERED (iscan_id)
+	   && !SCAN_IS_INDEX_MRO (iscan_id) && !SCAN_IS_INDEX_BITMAP (iscan_id)
+	   && prm_get_integer_value (PRM_ID_INDEX_SCAN_PREFETCH_MIN_PAGES) > 0)
+    {
+      scan_prefetch_index_oidset (thread_p, iscan_id);
+    }
 
 end:
 
@@ -2700,168 +2838,852 @@ exit_on_error:
 }
 
 /*
+ * scan_index_range_to_bitmap () - Run the whole range scan of an index scan identifier and pack its OIDs into a
+ *				    bitmap.
+ *   return: NO_ERROR, or ER_code
+ *   s_id(in): Scan identifier
+ *   max_oids(in): maximum number of OIDs kept in memory
+ *   oids(in/out): buffer of collected OIDs, reused between ranges
+ *   capacity(in/out): allocated size of oids
+ *   words(out): allocated bitmap words
+ *   n_words(out): number of bitmap words
  *
- *                    SCAN MANAGEMENT ROUTINES
- *
- */
-
-/*
- * scan_init_scan_id () -
- *   return:
- *   scan_id(out): Scan identifier
- *   mvcc_select_lock_needed(in):
- *   scan_op_type(in): scan operation type
- *   fixed(in):
- *   grouped(in):
- *   single_fetch(in):
- *   join_dbval(in):
- *   val_list(in):
- *   vd(in):
- *
- * Note: If you feel the need
+ * Note: once the range has more than max_oids objects, the bitmap becomes lossy: only the pages of the objects are
+ *	 kept and all objects of these pages are returned. This is correct because every row is rechecked with the
+ *	 data filter.
  */
-static void
-scan_init_scan_id (SCAN_ID * scan_id, bool mvcc_select_lock_needed, SCAN_OPERATION_TYPE scan_op_type, int fixed,
-		   int grouped, QPROC_SINGLE_FETCH single_fetch, DB_VALUE * join_dbval, val_list_node * val_list,
-		   VAL_DESCR * vd)
+static int
+scan_index_range_to_bitmap (THREAD_ENTRY * thread_p, SCAN_ID * s_id, int max_oids, OID ** oids, int *capacity,
+			    INDEX_BITMAP_WORD ** words, int *n_words)
 {
-  scan_id->status = S_OPENED;
-  scan_id->position = S_BEFORE;
-  scan_id->direction = S_FORWARD;
+  INDX_SCAN_ID *iscan_id = &s_id->s.isid;
+  OID *new_oids;
+  int new_capacity;
+  int n_oids = 0;
+  bool is_lossy = false;
+  int error;
 
-  scan_id->mvcc_select_lock_needed = mvcc_select_lock_needed;
-  scan_id->scan_op_type = scan_op_type;
-  scan_id->fixed = fixed;
+  *words = NULL;
+  *n_words = 0;
 
-  scan_id->grouped = grouped;	/* is it grouped or single scan? */
-  scan_id->qualified_block = false;
-  scan_id->single_fetch = single_fetch;
-  scan_id->single_fetched = false;
-  scan_id->null_fetched = false;
-  scan_id->qualification = QPROC_QUALIFIED;
+  while (true)
+    {
+      if (scan_get_index_oidset (thread_p, s_id, NULL, NULL) != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  return er_errid ();
+	}
 
-  /* join term */
-  scan_id->join_dbval = join_dbval;
+      if (iscan_id->oids_count > 0)
+	{
+	  if (n_oids + iscan_id->oids_count > max_oids && n_oids > 0)
+	    {
+	      /* too many objects to remember them all; remember their pages */
+	      error = scan_add_lossy_pages (thread_p, *oids, n_oids, words, n_words);
+	      if (error != NO_ERROR)
+		{
+		  return error;
+		}
+	      n_oids = 0;
+	      is_lossy = true;
+	    }
 
-  /* value list and descriptor */
-  scan_id->val_list = val_list;	/* points to the XASL tree */
-  scan_id->vd = vd;		/* set value descriptor pointer */
-  scan_id->scan_immediately_stop = false;
+	  if (n_oids + iscan_id->oids_count > *capacity)
+	    {
+	      new_capacity = MAX (MIN (*capacity * 2, max_oids), n_oids + iscan_id->oids_count);
+	      new_oids = (OID *) db_private_realloc (thread_p, *oids, new_capacity * sizeof (OID));
+	      if (new_oids == NULL)
+		{
+		  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
+			  (size_t) (new_capacity * sizeof (OID)));
+		  return ER_OUT_OF_VIRTUAL_MEMORY;
+		}
+	      *oids = new_oids;
+	      *capacity = new_capacity;
+	    }
+	  memcpy (*oids + n_oids, iscan_id->oid_list->oidp, iscan_id->oids_count * sizeof (OID));
+	  n_oids += iscan_id->oids_count;
+	}
+
+      if (iscan_id->oids_count == 0
+	  || (BTREE_END_OF_SCAN (&iscan_id->bt_scan) && iscan_id->indx_info->range_type != R_KEYLIST
+	      && iscan_id->indx_info->range_type != R_RANGELIST))
+	{
+	  break;
+	}
+    }
+
+  if (is_lossy)
+    {
+      return scan_add_lossy_pages (thread_p, *oids, n_oids, words, n_words);
+    }
+  return scan_oids_to_bitmap (thread_p, *oids, n_oids, words, n_words);
 }
 
 /*
- * scan_open_heap_scan () -
- *   return: NO_ERROR
- *   scan_id(out): Scan identifier
- *   mvcc_select_lock_needed(in):
- *   scan_op_type(in): scan operation type
- *   fixed(in):
- *   grouped(in):
- *   single_fetch(in):
- *   join_dbval(in):
- *   val_list(in):
- *   vd(in):
- *   cls_oid(in):
- *   hfid(in):
- *   regu_list_pred(in):
- *   pr(in):
- *   regu_list_rest(in):
- *   num_attrs_pred(in):
- *   attrids_pred(in):
- *   cache_pred(in):
- *   num_attrs_rest(in):
- *   attrids_rest(in):
- *   cache_rest(in):
- *   cache_recordinfo(in):
- *   regu_list_recordinfo(in):
+ * scan_compare_bitmap_words () - Compare the positions of two bitmap words in physical page order.
+ *   return: <0, 0, >0
+ */
+static int
+scan_compare_bitmap_words (const INDEX_BITMAP_WORD * word1, const INDEX_BITMAP_WORD * word2)
+{
+  if (word1->vpid.volid != word2->vpid.volid)
+    {
+      return word1->vpid.volid < word2->vpid.volid ? -1 : 1;
+    }
+  if (word1->vpid.pageid != word2->vpid.pageid)
+    {
+      return word1->vpid.pageid < word2->vpid.pageid ? -1 : 1;
+    }
+  return word1->word_no - word2->word_no;
+}
+
+/*
+ * scan_oids_to_bitmap () - Sort a set of OIDs and pack it into a compressed bitmap.
+ *   return: NO_ERROR, or ER_code
+ *   oids(in/out): OIDs to pack; they are sorted in place
+ *   n_oids(in): number of OIDs
+ *   words(out): allocated bitmap words
+ *   n_words(out): number of bitmap words
  *
- * Note: If you feel the need
+ * Note: only the non-empty 64-slot words of a heap page are kept, so the bitmap size grows with the number of
+ *	 distinct page areas rather than with the size of the heap.
  */
-int
-scan_open_heap_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id,
-		     /* fields of SCAN_ID */
-		     bool mvcc_select_lock_needed, SCAN_OPERATION_TYPE scan_op_type, int fixed, int grouped,
-		     QPROC_SINGLE_FETCH single_fetch, DB_VALUE * join_dbval, val_list_node * val_list, VAL_DESCR * vd,
-		     /* fields of HEAP_SCAN_ID */
-		     OID * cls_oid, HFID * hfid, regu_variable_list_node * regu_list_pred, PRED_EXPR * pr,
-		     regu_variable_list_node * regu_list_rest, int num_attrs_pred, ATTR_ID * attrids_pred,
-		     HEAP_CACHE_ATTRINFO * cache_pred, int num_attrs_rest, ATTR_ID * attrids_rest,
-		     HEAP_CACHE_ATTRINFO * cache_rest, SCAN_TYPE scan_type, DB_VALUE ** cache_recordinfo,
-		     regu_variable_list_node * regu_list_recordinfo)
+static int
+scan_oids_to_bitmap (THREAD_ENTRY * thread_p, OID * oids, int n_oids, INDEX_BITMAP_WORD ** words, int *n_words)
 {
-  HEAP_SCAN_ID *hsidp;
-  DB_TYPE single_node_type = DB_TYPE_NULL;
+  INDEX_BITMAP_WORD *word = NULL;
+  int i;
 
-  /* scan type is HEAP SCAN or HEAP SCAN RECORD INFO */
-  assert (scan_type == S_HEAP_SCAN || scan_type == S_HEAP_SCAN_RECORD_INFO);
-  scan_id->type = scan_type;
+  *words = NULL;
+  *n_words = 0;
 
-  /* initialize SCAN_ID structure */
-  scan_init_scan_id (scan_id, mvcc_select_lock_needed, scan_op_type, fixed, grouped, single_fetch, join_dbval, val_list,
-		     vd);
+  if (n_oids == 0)
+    {
+      return NO_ERROR;
+    }
 
-  /* initialize HEAP_SCAN_ID structure */
-  hsidp = &scan_id->s.hsid;
+  qsort (oids, n_oids, sizeof (OID), oid_compare);
 
-  /* class object OID */
-  COPY_OID (&hsidp->cls_oid, cls_oid);
+  *words = (INDEX_BITMAP_WORD *) db_private_alloc (thread_p, n_oids * sizeof (INDEX_BITMAP_WORD));
+  if (*words == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
+	      (size_t) (n_oids * sizeof (INDEX_BITMAP_WORD)));
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
 
-  /* heap file identifier */
-  hsidp->hfid = *hfid;		/* bitwise copy */
+  for (i = 0; i < n_oids; i++)
+    {
+      if (word == NULL || word->vpid.volid != oids[i].volid || word->vpid.pageid != oids[i].pageid
+	  || word->word_no != oids[i].slotid / 64)
+	{
+	  word = &(*words)[(*n_words)++];
+	  word->vpid.volid = oids[i].volid;
+	  word->vpid.pageid = oids[i].pageid;
+	  word->word_no = oids[i].slotid / 64;
+	  word->bits = 0;
+	}
+      word->bits |= ((UINT64) 1) << (oids[i].slotid % 64);
+    }
 
-  /* OID within the heap */
-  UT_CAST_TO_NULL_HEAP_OID (&hsidp->hfid, &hsidp->curr_oid);
+  return NO_ERROR;
+}
 
-  /* scan predicates */
-  scan_init_scan_pred (&hsidp->scan_pred, regu_list_pred, pr,
-		       ((pr) ? eval_fnc (thread_p, pr, &single_node_type) : NULL));
-  /* attribute information from predicates */
-  scan_init_scan_attrs (&hsidp->pred_attrs, num_attrs_pred, attrids_pred, cache_pred);
+/*
+ * scan_make_bitmap_lossy () - Replace the words of each page of a bitmap by one lossy word.
+ *   return:
+ *   words(in/out): bitmap words
+ *   n_words(in/out): number of bitmap words
+ */
+static void
+scan_make_bitmap_lossy (INDEX_BITMAP_WORD * words, int *n_words)
+{
+  int i, n = 0;
 
-  /* regulator variable list for other than predicates */
-  hsidp->rest_regu_list = regu_list_rest;
+  for (i = 0; i < *n_words; i = scan_bitmap_page_end (words, *n_words, i))
+    {
+      words[n].vpid = words[i].vpid;
+      words[n].word_no = INDEX_BITMAP_LOSSY_WORD;
+      words[n].bits = 0;
+      n++;
+    }
+  *n_words = n;
+}
 
-  /* attribute information from other than predicates */
-  scan_init_scan_attrs (&hsidp->rest_attrs, num_attrs_rest, attrids_rest, cache_rest);
+/*
+ * scan_add_lossy_pages () - Add the pages of a set of OIDs to a lossy bitmap.
+ *   return: NO_ERROR, or ER_code
+ *   oids(in/out): OIDs whose pages are added; they are sorted in place
+ *   n_oids(in): number of OIDs
+ *   words(in/out): lossy bitmap
+ *   n_words(in/out): number of words of the bitmap
+ */
+static int
+scan_add_lossy_pages (THREAD_ENTRY * thread_p, OID * oids, int n_oids, INDEX_BITMAP_WORD ** words, int *n_words)
+{
+  INDEX_BITMAP_WORD *page_words = NULL;
+  int n_page_words = 0;
+  int error;
 
-  /* flags */
-  /* do not reset hsidp->caches_inited here */
-  hsidp->scancache_inited = false;
-  hsidp->scanrange_inited = false;
+  error = scan_oids_to_bitmap (thread_p, oids, n_oids, &page_words, &n_page_words);
+  if (error != NO_ERROR || n_page_words == 0)
+    {
+      return error;
+    }
+  scan_make_bitmap_lossy (page_words, &n_page_words);
 
-  hsidp->cache_recordinfo = cache_recordinfo;
-  hsidp->recordinfo_regu_list = regu_list_recordinfo;
+  error = scan_combine_bitmaps (thread_p, words, n_words, page_words, n_page_words, BITMAP_OP_OR);
+  db_private_free (thread_p, page_words);
 
-  return NO_ERROR;
+  return error;
 }
 
 /*
- * scan_open_heap_page_scan () - Opens a page by page heap scan.
- *
- * return		    : Error code.
- * thread_p (in)	    :
- * scan_id (in)		    :
- * val_list (in)	    :
- * vd (in)		    :
- * cls_oid (in)		    :
- * hfid (in)		    :
- * pr (in)		    :
- * scan_type (in)	    :
- * cache_page_info (in)	    :
- * regu_list_page_info (in) :
+ * scan_bitmap_page_end () - Find the end of the words of a heap page in a bitmap.
+ *   return: index of the first word of the next page
+ *   words(in): bitmap words
+ *   n_words(in): number of bitmap words
+ *   start(in): index of a word of the page
  */
-int
-scan_open_heap_page_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id,
-			  /* fields of SCAN_ID */
-			  val_list_node * val_list, VAL_DESCR * vd,
-			  /* fields of HEAP_SCAN_ID */
-			  OID * cls_oid, HFID * hfid, PRED_EXPR * pr, SCAN_TYPE scan_type, DB_VALUE ** cache_page_info,
-			  regu_variable_list_node * regu_list_page_info)
+static int
+scan_bitmap_page_end (const INDEX_BITMAP_WORD * words, int n_words, int start)
 {
-  HEAP_PAGE_SCAN_ID *hpsidp = NULL;
-  DB_TYPE single_node_type = DB_TYPE_NULL;
-
-  scan_id->type = scan_type;
+  int end;
+
+  for (end = start + 1; end < n_words && VPID_EQ (&words[end].vpid, &words[start].vpid); end++)
+    {
+      ;
+    }
+  return end;
+}
+
+/*
+ * scan_combine_bitmaps () - Combine two compressed bitmaps.
+ *   return: NO_ERROR, or ER_code
+ *   words(in/out): first bitmap; replaced by the combined bitmap
+ *   n_words(in/out): number of words of the first bitmap
+ *   other_words(in): second bitmap
+ *   n_other_words(in): number of words of the second bitmap
+ *   op(in): BITMAP_OP_AND or BITMAP_OP_OR
+ *
+ * Note: the bitmaps are combined page by page. A lossy page is the union of all objects of the page: it absorbs the
+ *	 words of the same page in a union and gives way to them in an intersection.
+ */
+static int
+scan_combine_bitmaps (THREAD_ENTRY * thread_p, INDEX_BITMAP_WORD ** words, int *n_words,
+		      INDEX_BITMAP_WORD * other_words, int n_other_words, int op)
+{
+  INDEX_BITMAP_WORD *result;
+  int i = 0, j = 0, n = 0;
+  int i_end, j_end;
+  bool is_lossy, is_other_lossy;
+  int cmp;
+
+  if (op == BITMAP_OP_AND && (*n_words == 0 || n_other_words == 0))
+    {
+      *n_words = 0;
+      return NO_ERROR;
+    }
+
+  result = (INDEX_BITMAP_WORD *) db_private_alloc (thread_p, (*n_words + n_other_words) * sizeof (INDEX_BITMAP_WORD));
+  if (result == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
+	      (size_t) ((*n_words + n_other_words) * sizeof (INDEX_BITMAP_WORD)));
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+
+  while (i < *n_words && j < n_other_words)
+    {
+      i_end = scan_bitmap_page_end (*words, *n_words, i);
+      j_end = scan_bitmap_page_end (other_words, n_other_words, j);
+
+      if (VPID_EQ (&(*words)[i].vpid, &other_words[j].vpid))
+	{
+	  cmp = 0;
+	}
+      else
+	{
+	  cmp = scan_compare_bitmap_words (&(*words)[i], &other_words[j]);
+	}
+      if (cmp < 0)
+	{
+	  if (op == BITMAP_OP_OR)
+	    {
+	      for (; i < i_end; i++)
+		{
+		  result[n++] = (*words)[i];
+		}
+	    }
+	  i = i_end;
+	  continue;
+	}
+      if (cmp > 0)
+	{
+	  if (op == BITMAP_OP_OR)
+	    {
+	      for (; j < j_end; j++)
+		{
+		  result[n++] = other_words[j];
+		}
+	    }
+	  j = j_end;
+	  continue;
+	}
+
+      /* same page */
+      is_lossy = (*words)[i].word_no == INDEX_BITMAP_LOSSY_WORD;
+      is_other_lossy = other_words[j].word_no == INDEX_BITMAP_LOSSY_WORD;
+      if (is_lossy || is_other_lossy)
+	{
+	  if (op == BITMAP_OP_OR || (is_lossy && is_other_lossy))
+	    {
+	      result[n] = is_lossy ? (*words)[i] : other_words[j];
+	      n++;
+	    }
+	  else if (is_lossy)
+	    {
+	      for (; j < j_end; j++)
+		{
+		  result[n++] = other_words[j];
+		}
+	    }
+	  else
+	    {
+	      for (; i < i_end; i++)
+		{
+		  result[n++] = (*words)[i];
+		}
+	    }
+	  i = i_end;
+	  j = j_end;
+	  continue;
+	}
+
+      while (i < i_end && j < j_end)
+	{
+	  cmp = (*words)[i].word_no - other_words[j].word_no;
+	  if (cmp == 0)
+	    {
+	      result[n] = (*words)[i];
+	      if (op == BITMAP_OP_AND)
+		{
+		  result[n].bits &= other_words[j].bits;
+		}
+	      else
+		{
+		  result[n].bits |= other_words[j].bits;
+		}
+	      if (result[n].bits != 0)
+		{
+		  n++;
+		}
+	      i++;
+	      j++;
+	    }
+	  else if (cmp < 0)
+	    {
+	      if (op == BITMAP_OP_OR)
+		{
+		  result[n++] = (*words)[i];
+		}
+	      i++;
+	    }
+	  else
+	    {
+	      if (op == BITMAP_OP_OR)
+		{
+		  result[n++] = other_words[j];
+		}
+	      j++;
+	    }
+	}
+      if (op == BITMAP_OP_OR)
+	{
+	  for (; i < i_end; i++)
+	    {
+	      result[n++] = (*words)[i];
+	    }
+	  for (; j < j_end; j++)
+	    {
+	      result[n++] = other_words[j];
+	    }
+	}
+      i = i_end;
+      j = j_end;
+    }
+
+  if (op == BITMAP_OP_OR)
+    {
+      for (; i < *n_words; i++)
+	{
+	  result[n++] = (*words)[i];
+	}
+      for (; j < n_other_words; j++)
+	{
+	  result[n++] = other_words[j];
+	}
+    }
+
+  if (*words != NULL)
+    {
+      db_private_free (thread_p, *words);
+    }
+  *words = result;
+  *n_words = n;
+
+  return NO_ERROR;
+}
+
+/*
+ * scan_build_index_bitmap () - Compute the combined OID bitmap of a bitmap index scan.
+ *   return: NO_ERROR, or ER_code
+ *   s_id(in): Scan identifier of the first index of the bitmap scan
+ *
+ * Note: every other index chained through indx_info->bitmap_next is range scanned with a private index scan that
+ *	 shares the MVCC snapshot of the main one. The data filter of the main scan still holds all the predicates,
+ *	 so the heap rows are rechecked regardless of which index produced them.
+ *	 The OIDs of a range and the combined bitmap are kept within the sort buffer size; beyond it, they are
+ *	 reduced to lossy pages.
+ */
+static int
+scan_build_index_bitmap (THREAD_ENTRY * thread_p, SCAN_ID * s_id)
+{
+  INDX_SCAN_ID *iscan_id = &s_id->s.isid;
+  INDEX_BITMAP_SCAN *bitmap = &iscan_id->bitmap;
+  INDX_INFO *child_info;
+  SCAN_ID *child_scan = NULL;
+  INDEX_BITMAP_WORD *child_words = NULL;
+  int n_child_words = 0;
+  OID *oids = NULL;
+  int capacity = 0;
+  UINT64 max_size;
+  int max_oids;
+  int error = NO_ERROR;
+
+  assert (bitmap->words == NULL);
+
+  /* Do not use more than the sort buffer size for the OIDs of a range, but at least one OID buffer. */
+  max_size = (UINT64) prm_get_integer_value (PRM_ID_SR_NBUFFERS) * IO_PAGESIZE;
+  max_oids = (int) MIN (max_size / sizeof (OID), INT_MAX / sizeof (INDEX_BITMAP_WORD));
+  max_oids = MAX (max_oids, iscan_id->oid_list->max_oid_cnt);
+
+  error = scan_index_range_to_bitmap (thread_p, s_id, max_oids, &oids, &capacity, &bitmap->words, &bitmap->n_words);
+  if (error != NO_ERROR)
+    {
+      goto end;
+    }
+
+  child_scan = (SCAN_ID *) db_private_alloc (thread_p, sizeof (SCAN_ID));
+  if (child_scan == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, sizeof (SCAN_ID));
+      error = ER_OUT_OF_VIRTUAL_MEMORY;
+      goto end;
+    }
+
+  for (child_info = iscan_id->indx_info->bitmap_next; child_info != NULL; child_info = child_info->bitmap_next)
+    {
+      if (iscan_id->indx_info->bitmap_op == BITMAP_OP_AND && bitmap->n_words == 0)
+	{
+	  /* the intersection is already empty */
+	  break;
+	}
+
+      memset (child_scan, 0, sizeof (SCAN_ID));
+      error = scan_open_index_scan (thread_p, child_scan, false, S_SELECT, s_id->fixed, false, QPROC_NO_SINGLE_INNER,
+				    NULL, s_id->val_list, s_id->vd, child_info, &iscan_id->cls_oid, &iscan_id->hfid,
+				    NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0, NULL, NULL, 0, NULL, NULL,
+				    0, NULL, NULL, 0, NULL, NULL, false, 0);
+      if (error != NO_ERROR)
+	{
+	  goto end;
+	}
+      child_scan->s.isid.scan_cache.mvcc_snapshot = iscan_id->scan_cache.mvcc_snapshot;
+
+      error = scan_index_range_to_bitmap (thread_p, child_scan, max_oids, &oids, &capacity, &child_words,
+					  &n_child_words);
+
+      scan_end_scan (thread_p, child_scan);
+      scan_close_scan (thread_p, child_scan);
+
+      if (error != NO_ERROR)
+	{
+	  goto end;
+	}
+
+      error = scan_combine_bitmaps (thread_p, &bitmap->words, &bitmap->n_words, child_words, n_child_words,
+				    iscan_id->indx_info->bitmap_op);
+      if (child_words != NULL)
+	{
+	  db_private_free_and_init (thread_p, child_words);
+	}
+      if (error != NO_ERROR)
+	{
+	  goto end;
+	}
+
+      if ((UINT64) bitmap->n_words * sizeof (INDEX_BITMAP_WORD) > max_size)
+	{
+	  /* a union grew too large */
+	  scan_make_bitmap_lossy (bitmap->words, &bitmap->n_words);
+	}
+    }
+
+end:
+  if (child_scan != NULL)
+    {
+      db_private_free (thread_p, child_scan);
+    }
+  if (oids != NULL)
+    {
+      db_private_free (thread_p, oids);
+    }
+
+  bitmap->built = true;
+  bitmap->curr_word = 0;
+  bitmap->curr_bit = 0;
+
+  return error;
+}
+
+/*
+ * scan_get_index_bitmap_oidset () - Fetch the next group of object identifiers of a bitmap index scan.
+ *   return: NO_ERROR, or ER_code
+ *   s_id(in): Scan identifier
+ *
+ * Note: the objects are returned in physical page order, so every heap page is visited once. All objects of a lossy
+ *	 page are returned.
+ */
+static int
+scan_get_index_bitmap_oidset (THREAD_ENTRY * thread_p, SCAN_ID * s_id)
+{
+  INDX_SCAN_ID *iscan_id = &s_id->s.isid;
+  INDEX_BITMAP_SCAN *bitmap = &iscan_id->bitmap;
+  INDEX_BITMAP_WORD *word;
+  OID *oidp;
+  int error;
+
+  assert (iscan_id->oid_list != NULL);
+
+  if (!bitmap->built)
+    {
+      error = scan_build_index_bitmap (thread_p, s_id);
+      if (error != NO_ERROR)
+	{
+	  bitmap->n_words = 0;
+	  return error;
+	}
+    }
+
+  iscan_id->oids_count = 0;
+  oidp = iscan_id->oid_list->oidp;
+
+  while (bitmap->curr_word < bitmap->n_words && iscan_id->oids_count < iscan_id->oid_list->max_oid_cnt)
+    {
+      word = &bitmap->words[bitmap->curr_word];
+      if (word->word_no == INDEX_BITMAP_LOSSY_WORD)
+	{
+	  error = scan_get_lossy_page_oids (thread_p, iscan_id, word);
+	  if (error != NO_ERROR)
+	    {
+	      return error;
+	    }
+	  oidp = iscan_id->oid_list->oidp + iscan_id->oids_count;
+	  continue;
+	}
+
+      for (; bitmap->curr_bit < 64 && iscan_id->oids_count < iscan_id->oid_list->max_oid_cnt; bitmap->curr_bit++)
+	{
+	  if (word->bits & (((UINT64) 1) << bitmap->curr_bit))
+	    {
+	      oidp->volid = word->vpid.volid;
+	      oidp->pageid = word->vpid.pageid;
+	      oidp->slotid = word->word_no * 64 + bitmap->curr_bit;
+	      oidp++;
+	      iscan_id->oids_count++;
+	    }
+	}
+
+      if (bitmap->curr_bit == 64)
+	{
+	  bitmap->curr_word++;
+	  bitmap->curr_bit = 0;
+	}
+    }
+
+  iscan_id->oid_list->oid_cnt = iscan_id->oids_count;
+
+  return NO_ERROR;
+}
+
+/*
+ * scan_get_lossy_page_oids () - Add the objects of a lossy page of the bitmap to the OID buffer of the scan.
+ *   return: NO_ERROR, or ER_code
+ *   iscan_id(in): index scan identifier
+ *   word(in): lossy word of the page
+ *
+ * Note: bitmap.curr_bit is the next slot of the page to examine. The page is done when it is past the last slot;
+ *	 otherwise the OID buffer is full and the page is continued by the next call.
+ */
+static int
+scan_get_lossy_page_oids (THREAD_ENTRY * thread_p, INDX_SCAN_ID * iscan_id, INDEX_BITMAP_WORD * word)
+{
+  INDEX_BITMAP_SCAN *bitmap = &iscan_id->bitmap;
+  PGBUF_WATCHER pg_watcher;
+  OID class_oid;
+  OID *oidp;
+  PGSLOTID slotid, n_slots;
+  INT16 rec_type;
+  int error;
+
+  PGBUF_INIT_WATCHER (&pg_watcher, PGBUF_ORDERED_HEAP_NORMAL, &iscan_id->hfid);
+
+  error = pgbuf_ordered_fix (thread_p, &word->vpid, OLD_PAGE_MAYBE_DEALLOCATED, PGBUF_LATCH_READ, &pg_watcher);
+  if (error != NO_ERROR)
+    {
+      if (error == ER_PB_BAD_PAGEID)
+	{
+	  /* the page was emptied and removed by vacuum */
+	  er_clear ();
+	  bitmap->curr_word++;
+	  bitmap->curr_bit = 0;
+	  return NO_ERROR;
+	}
+      ASSERT_ERROR ();
+      return error;
+    }
+
+  if (pgbuf_get_page_ptype (thread_p, pg_watcher.pgptr) != PAGE_HEAP
+      || heap_get_class_oid_from_page (thread_p, pg_watcher.pgptr, &class_oid) != NO_ERROR
+      || !OID_EQ (&class_oid, &iscan_id->cls_oid))
+    {
+      /* the page was removed and reused since its objects were found */
+      er_clear ();
+      pgbuf_ordered_unfix (thread_p, &pg_watcher);
+      bitmap->curr_word++;
+      bitmap->curr_bit = 0;
+      return NO_ERROR;
+    }
+
+  n_slots = spage_number_of_slots (pg_watcher.pgptr);
+  oidp = iscan_id->oid_list->oidp + iscan_id->oids_count;
+  for (slotid = MAX (bitmap->curr_bit, HEAP_HEADER_AND_CHAIN_SLOTID + 1);
+       slotid < n_slots && iscan_id->oids_count < iscan_id->oid_list->max_oid_cnt; slotid++)
+    {
+      rec_type = spage_get_record_type (pg_watcher.pgptr, slotid);
+      if (rec_type != REC_HOME && rec_type != REC_RELOCATION && rec_type != REC_BIGONE)
+	{
+	  /* not an object; relocated objects are read from their relocation slot */
+	  continue;
+	}
+      oidp->volid = word->vpid.volid;
+      oidp->pageid = word->vpid.pageid;
+      oidp->slotid = slotid;
+      oidp++;
+      iscan_id->oids_count++;
+    }
+
+  pgbuf_ordered_unfix (thread_p, &pg_watcher);
+
+  if (slotid >= n_slots)
+    {
+      bitmap->curr_word++;
+      bitmap->curr_bit = 0;
+    }
+  else
+    {
+      bitmap->curr_bit = slotid;
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * scan_clear_index_bitmap () - Free the combined bitmap so that the next scan rebuilds it.
+ *   return:
+ *   iscan_id(in): index scan identifier
+ */
+static void
+scan_clear_index_bitmap (THREAD_ENTRY * thread_p, INDX_SCAN_ID * iscan_id)
+{
+  if (iscan_id->bitmap.words != NULL)
+    {
+      db_private_free_and_init (thread_p, iscan_id->bitmap.words);
+    }
+  iscan_id->bitmap.n_words = 0;
+  iscan_id->bitmap.built = false;
+  iscan_id->bitmap.curr_word = 0;
+  iscan_id->bitmap.curr_bit = 0;
+}
+
+/*
+ *
+ *                    SCAN MANAGEMENT ROUTINES
+ *
+ */
+
+/*
+ * scan_init_scan_id () -
+ *   return:
+ *   scan_id(out): Scan identifier
+ *   mvcc_select_lock_needed(in):
+ *   scan_op_type(in): scan operation type
+ *   fixed(in):
+ *   grouped(in):
+ *   single_fetch(in):
+ *   join_dbval(in):
+ *   val_list(in):
+ *   vd(in):
+ *
+ * Note: If you feel the need
+ */
+static void
+scan_init_scan_id (SCAN_ID * scan_id, bool mvcc_select_lock_needed, SCAN_OPERATION_TYPE scan_op_type, int fixed,
+		   int grouped, QPROC_SINGLE_FETCH single_fetch, DB_VALUE * join_dbval, val_list_node * val_list,
+		   VAL_DESCR * vd)
+{
+  scan_id->status = S_OPENED;
+  scan_id->position = S_BEFORE;
+  scan_id->direction = S_FORWARD;
+
+  scan_id->mvcc_select_lock_needed = mvcc_select_lock_needed;
+  scan_id->scan_op_type = scan_op_type;
+  scan_id->fixed = fixed;
+
+  scan_id->grouped = grouped;	/* is it grouped or single scan? */
+  scan_id->qualified_block = false;
+  scan_id->single_fetch = single_fetch;
+  scan_id->single_fetched = false;
+  scan_id->null_fetched = false;
+  scan_id->qualification = QPROC_QUALIFIED;
+
+  /* join term */
+  scan_id->join_dbval = join_dbval;
+
+  /* value list and descriptor */
+  scan_id->val_list = val_list;	/* points to the XASL tree */
+  scan_id->vd = vd;		/* set value descriptor pointer */
+  scan_id->scan_immediately_stop = false;
+
+  /* the executor attaches the runtime join filter after the scan is opened */
+  scan_id->join_filter = NULL;
+}
+
+/*
+ * scan_open_heap_scan () -
+ *   return: NO_ERROR
+ *   scan_id(out): Scan identifier
+ *   mvcc_select_lock_needed(in):
+ *   scan_op_type(in): scan operation type
+ *   fixed(in):
+ *   grouped(in):
+ *   single_fetch(in):
+ *   join_dbval(in):
+ *   val_list(in):
+ *   vd(in):
+ *   cls_oid(in):
+ *   hfid(in):
+ *   regu_list_pred(in):
+ *   pr(in):
+ *   regu_list_rest(in):
+ *   num_attrs_pred(in):
+ *   attrids_pred(in):
+ *   cache_pred(in):
+ *   num_attrs_rest(in):
+ *   attrids_rest(in):
+ *   cache_rest(in):
+ *   cache_recordinfo(in):
+ *   regu_list_recordinfo(in):
+ *
+ * Note: If you feel the need
+ */
+int
+scan_open_heap_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id,
+		     /* fields of SCAN_ID */
+		     bool mvcc_select_lock_needed, SCAN_OPERATION_TYPE scan_op_type, int fixed, int grouped,
+		     QPROC_SINGLE_FETCH single_fetch, DB_VALUE * join_dbval, val_list_node * val_list, VAL_DESCR * vd,
+		     /* fields of HEAP_SCAN_ID */
+		     OID * cls_oid, HFID * hfid, regu_variable_list_node * regu_list_pred, PRED_EXPR * pr,
+		     regu_variable_list_node * regu_list_rest, int num_attrs_pred, ATTR_ID * attrids_pred,
+		     HEAP_CACHE_ATTRINFO * cache_pred, int num_attrs_rest, ATTR_ID * attrids_rest,
+		     HEAP_CACHE_ATTRINFO * cache_rest, SCAN_TYPE scan_type, DB_VALUE ** cache_recordinfo,
+		     regu_variable_list_node * regu_list_recordinfo)
+{
+  HEAP_SCAN_ID *hsidp;
+  DB_TYPE single_node_type = DB_TYPE_NULL;
+
+  /* scan type is HEAP SCAN or HEAP SCAN RECORD INFO */
+  assert (scan_type == S_HEAP_SCAN || scan_type == S_HEAP_SCAN_RECORD_INFO);
+  scan_id->type = scan_type;
+
+  /* initialize SCAN_ID structure */
+  scan_init_scan_id (scan_id, mvcc_select_lock_needed, scan_op_type, fixed, grouped, single_fetch, join_dbval, val_list,
+		     vd);
+
+  /* initialize HEAP_SCAN_ID structure */
+  hsidp = &scan_id->s.hsid;
+
+  /* class object OID */
+  COPY_OID (&hsidp->cls_oid, cls_oid);
+
+  /* heap file identifier */
+  hsidp->hfid = *hfid;		/* bitwise copy */
+
+  /* OID within the heap */
+  UT_CAST_TO_NULL_HEAP_OID (&hsidp->hfid, &hsidp->curr_oid);
+
+  /* scan predicates */
+  scan_init_scan_pred (&hsidp->scan_pred, regu_list_pred, pr,
+		       ((pr) ? eval_fnc (thread_p, pr, &single_node_type) : NULL));
+  /* attribute information from predicates */
+  scan_init_scan_attrs (&hsidp->pred_attrs, num_attrs_pred, attrids_pred, cache_pred);
+
+  /* regulator variable list for other than predicates */
+  hsidp->rest_regu_list = regu_list_rest;
+
+  /* attribute information from other than predicates */
+  scan_init_scan_attrs (&hsidp->rest_attrs, num_attrs_rest, attrids_rest, cache_rest);
+
+  /* flags */
+  /* do not reset hsidp->caches_inited here */
+  hsidp->scancache_inited = false;
+  hsidp->scanrange_inited = false;
+
+  hsidp->cache_recordinfo = cache_recordinfo;
+  hsidp->recordinfo_regu_list = regu_list_recordinfo;
+
+  return NO_ERROR;
+}
+
+/*
+ * scan_open_heap_page_scan () - Opens a page by page heap scan.
+ *
+ * return		    : Error code.
+ * thread_p (in)	    :
+ * scan_id (in)		    :
+ * val_list (in)	    :
+ * vd (in)		    :
+ * cls_oid (in)		    :
+ * hfid (in)		    :
+ * pr (in)		    :
+ * scan_type (in)	    :
+ * cache_page_info (in)	    :
+ * regu_list_page_info (in) :
+ */
+int
+scan_open_heap_page_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id,
+			  /* fields of SCAN_ID */
+			  val_list_node * val_list, VAL_DESCR * vd,
+			  /* fields of HEAP_SCAN_ID */
+			  OID * cls_oid, HFID * hfid, PRED_EXPR * pr, SCAN_TYPE scan_type, DB_VALUE ** cache_page_info,
+			  regu_variable_list_node * regu_list_page_info)
+{
+  HEAP_PAGE_SCAN_ID *hpsidp = NULL;
+  DB_TYPE single_node_type = DB_TYPE_NULL;
+
+  scan_id->type = scan_type;
 
   scan_init_scan_id (scan_id, true, S_SELECT, true, false, QPROC_NO_SINGLE_INNER, NULL, val_list, vd);
 
@@ -3105,8 +3927,17 @@ scan_open_index_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id,
 	}
     }
 
+  /* bitmap index scan; the OIDs of all chained indexes are combined before the heap is visited */
+  isidp->bitmap.use = (indx_info->bitmap_next != NULL);
+  isidp->bitmap.built = false;
+  isidp->bitmap.words = NULL;
+  isidp->bitmap.n_words = 0;
+  isidp->bitmap.curr_word = 0;
+  isidp->bitmap.curr_bit = 0;
+
   /* indicator whether covering index is used or not */
-  coverage_enabled = (indx_info->coverage != 0) && (scan_op_type == S_SELECT) && !mvcc_select_lock_needed;
+  coverage_enabled = ((indx_info->coverage != 0) && (scan_op_type == S_SELECT) && !mvcc_select_lock_needed
+		      && !isidp->bitmap.use);
   scan_id->scan_stats.loose_index_scan = indx_info->ils_prefix_len > 0;
 
   /* is a single range? */
@@ -3115,6 +3946,7 @@ scan_open_index_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id,
   /* initial values */
   isidp->curr_keyno = -1;
   isidp->curr_oidno = -1;
+  isidp->parallel = NULL;
 
   /* OID buffer */
   if (coverage_enabled)
@@ -3956,6 +4788,14 @@ scan_start_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
 	      goto exit_on_error;
 	    }
 	  hsidp->scancache_inited = true;
+	  if (scan_id->type == S_HEAP_SCAN && scan_id->qualification == QPROC_QUALIFIED
+	      && !scan_id->mvcc_select_lock_needed && mvcc_snapshot != NULL)
+	    {
+	      /* skip heap pages whose zone maps show that no record can satisfy the data filter */
+	      hsidp->scan_cache.m_zone_filter =
+		heap_zone_filter_create (thread_p, &hsidp->hfid, &hsidp->cls_oid, hsidp->scan_pred.pred_expr,
+					 scan_id->vd);
+	    }
 	}
       if (hsidp->caches_inited != true)
 	{
@@ -4257,11 +5097,24 @@ scan_reset_scan_block (THREAD_ENTRY * thread_p, SCAN_ID * s_id)
 	{
 	  INDX_COV *indx_cov_p;
 
+	  if (s_id->s.isid.parallel != NULL)
+	    {
+	      index_scan_parallel_end (thread_p, s_id->s.isid.parallel);
+	      s_id->s.isid.parallel = NULL;
+
+	      /* the key values of the range are computed again for the next scan */
+	      pr_clear_value (&s_id->s.isid.key_vals[0].key1);
+	      pr_clear_value (&s_id->s.isid.key_vals[0].key2);
+	    }
+
 	  s_id->s.isid.curr_oidno = -1;
 	  s_id->s.isid.curr_keyno = -1;
 	  s_id->position = S_BEFORE;
 	  BTREE_RESET_SCAN (&s_id->s.isid.bt_scan);
 
+	  /* the bitmap of a bitmap index scan is rebuilt from the (possibly new) key values */
+	  scan_clear_index_bitmap (thread_p, &s_id->s.isid);
+
 	  /* reset key limits */
 	  if (s_id->s.isid.indx_info)
 	    {
@@ -4411,12 +5264,19 @@ scan_next_scan_block (THREAD_ENTRY * thread_p, SCAN_ID * s_id)
 	{
 	  if ((s_id->direction == S_FORWARD && s_id->position == S_BEFORE)
 	      || (!BTREE_END_OF_SCAN (&s_id->s.isid.bt_scan) || s_id->s.isid.indx_info->range_type == R_KEYLIST
-		  || s_id->s.isid.indx_info->range_type == R_RANGELIST))
+		  || s_id->s.isid.indx_info->range_type == R_RANGELIST || SCAN_IS_INDEX_BITMAP (&s_id->s.isid)))
 	    {
 	      if (!(s_id->position == S_BEFORE && s_id->s.isid.one_range == true))
 		{
 		  /* get the next set of object identifiers specified in the range */
-		  if (scan_get_index_oidset (thread_p, s_id, NULL, NULL) != NO_ERROR)
+		  if (SCAN_IS_INDEX_BITMAP (&s_id->s.isid))
+		    {
+		      if (scan_get_index_bitmap_oidset (thread_p, s_id) != NO_ERROR)
+			{
+			  return S_ERROR;
+			}
+		    }
+		  else if (scan_get_index_oidset (thread_p, s_id, NULL, NULL) != NO_ERROR)
 		    {
 		      return S_ERROR;
 		    }
@@ -4429,7 +5289,7 @@ scan_next_scan_block (THREAD_ENTRY * thread_p, SCAN_ID * s_id)
 
 		  if (s_id->position == S_BEFORE && BTREE_END_OF_SCAN (&s_id->s.isid.bt_scan)
 		      && s_id->s.isid.indx_info->range_type != R_KEYLIST
-		      && s_id->s.isid.indx_info->range_type != R_RANGELIST)
+		      && s_id->s.isid.indx_info->range_type != R_RANGELIST && !SCAN_IS_INDEX_BITMAP (&s_id->s.isid))
 		    {
 		      s_id->s.isid.one_range = true;
 		    }
@@ -4551,6 +5411,11 @@ scan_end_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
 
       /* do not free attr_cache here. xs_clear_access_spec_list() will free attr_caches. */
 
+      if (isidp->parallel != NULL)
+	{
+	  index_scan_parallel_end (thread_p, isidp->parallel);
+	  isidp->parallel = NULL;
+	}
       if (isidp->scancache_inited)
 	{
 	  (void) heap_scancache_end (thread_p, &isidp->scan_cache);
@@ -4568,6 +5433,8 @@ scan_end_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
       btree_scan_clear_key (&(isidp->bt_scan));
       /* clear last_key */
       (void) scan_init_iss (isidp);
+      /* free the bitmap of a bitmap index scan */
+      scan_clear_index_bitmap (thread_p, isidp);
       break;
 
     case S_LIST_SCAN:
@@ -4633,6 +5500,11 @@ scan_close_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
 
     case S_INDX_SCAN:
       isidp = &scan_id->s.isid;
+      if (isidp->parallel != NULL)
+	{
+	  index_scan_parallel_end (thread_p, isidp->parallel);
+	  isidp->parallel = NULL;
+	}
       if (isidp->key_vals)
 	{
 	  db_private_free_and_init (thread_p, isidp->key_vals);
@@ -4834,7 +5706,14 @@ call_get_next_index_oidset (THREAD_ENTRY * thread_p, SCAN_ID * scan_id, INDX_SCA
       p_kl_lower = isidp->key_limit_lower == -1 ? NULL : &isidp->key_limit_lower;
       p_kl_upper = isidp->key_limit_upper == -1 ? NULL : &isidp->key_limit_upper;
 
-      if (scan_get_index_oidset (thread_p, scan_id, p_kl_upper, p_kl_lower) != NO_ERROR)
+      if (SCAN_IS_INDEX_BITMAP (isidp))
+	{
+	  if (scan_get_index_bitmap_oidset (thread_p, scan_id) != NO_ERROR)
+	    {
+	      return S_ERROR;
+	    }
+	}
+      else if (scan_get_index_oidset (thread_p, scan_id, p_kl_upper, p_kl_lower) != NO_ERROR)
 	{
 	  return S_ERROR;
 	}
@@ -5080,6 +5959,21 @@ scan_next_heap_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
       /* evaluate the predicates to see if the object qualifies */
       scan_id->scan_stats.read_rows++;
 
+      if (scan_id->join_filter != NULL && scan_id->qualification == QPROC_QUALIFIED)
+	{
+	  ev_res = scan_join_filter_eval (thread_p, scan_id->join_filter, &hsidp->curr_oid, &recdes);
+	  if (ev_res == V_ERROR)
+	    {
+	      return S_ERROR;
+	    }
+	  else if (ev_res != V_TRUE)
+	    {
+	      /* no join partner, skip it without evaluating the data filter */
+	      scan_id->scan_stats.join_filtered_rows++;
+	      continue;
+	    }
+	}
+
       ev_res = eval_data_filter (thread_p, p_current_oid, &recdes, &hsidp->scan_cache, &data_filter);
       if (ev_res == V_ERROR)
 	{
@@ -5504,6 +6398,123 @@ scan_next_class_attr_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
     }
 }
 
+#if defined (SERVER_MODE)
+/*
+ * scan_start_parallel_index_scan () - scan the index range with worker threads if the scan allows it and the range is
+ *				       large enough
+ *   return: error code
+ *   scan_id(in/out): Scan identifier
+ *
+ * Note: Only the simplest scans are parallel: a single range of a single column ascending index whose objects are
+ *       read to be filtered on the data filter. Workers fetch the records; the filters and the rest of the XASL are
+ *       evaluated by the scan thread. When the scan is not parallel, isidp->parallel remains NULL.
+ */
+static int
+scan_start_parallel_index_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
+{
+  INDX_SCAN_ID *isidp = &scan_id->s.isid;
+  indx_info *indx_infop = isidp->indx_info;
+  BTREE_SCAN *bts = &isidp->bt_scan;
+  KEY_VAL_RANGE *key_val;
+  bool ordered;
+  int error_code = NO_ERROR;
+
+  assert (isidp->parallel == NULL);
+
+  if (prm_get_integer_value (PRM_ID_INDEX_SCAN_THREAD_COUNT) < 2)
+    {
+      return NO_ERROR;
+    }
+
+  if (indx_infop == NULL || indx_infop->range_type != R_RANGE || indx_infop->key_info.key_cnt != 1
+      || isidp->curr_keyno != -1 || isidp->key_vals == NULL)
+    {
+      return NO_ERROR;
+    }
+  if (scan_id->scan_op_type != S_SELECT || scan_id->mvcc_select_lock_needed || scan_id->grouped)
+    {
+      return NO_ERROR;
+    }
+  if (SCAN_IS_INDEX_COVERED (isidp) || SCAN_IS_INDEX_MRO (isidp) || SCAN_IS_INDEX_ISS (isidp)
+      || SCAN_IS_INDEX_BITMAP (isidp) || SCAN_IS_INDEX_ILS (isidp) || isidp->need_count_only)
+    {
+      return NO_ERROR;
+    }
+  if (isidp->key_pred.regu_list != NULL || isidp->key_pred.pred_expr != NULL || isidp->range_pred.regu_list != NULL
+      || isidp->range_pred.pred_expr != NULL)
+    {
+      /* key filters are evaluated by the b-tree scan */
+      return NO_ERROR;
+    }
+  if (indx_infop->use_desc_index || indx_infop->key_info.key_limit_l != NULL
+      || indx_infop->key_info.key_limit_u != NULL)
+    {
+      return NO_ERROR;
+    }
+  if (isidp->scan_cache.mvcc_snapshot == NULL || mvcc_is_mvcc_disabled_class (&isidp->cls_oid))
+    {
+      return NO_ERROR;
+    }
+  if (!bts->is_btid_int_valid || TP_DOMAIN_TYPE (bts->btid_int.key_type) == DB_TYPE_MIDXKEY
+      || bts->btid_int.key_type->is_desc || bts->btid_int.nonleaf_key_type != bts->btid_int.key_type)
+    {
+      /* separators of prefix keys cannot be used as bounds of sub-ranges */
+      return NO_ERROR;
+    }
+
+  /* same as the first call of scan_get_index_oidset */
+  key_val = &isidp->key_vals[0];
+  key_val->range = indx_infop->key_info.key_ranges[0].range;
+  db_make_null (&key_val->key1);
+  db_make_null (&key_val->key2);
+  key_val->is_truncated = false;
+  key_val->num_index_term = 0;
+
+  if (key_val->range != INF_INF)
+    {
+      error_code =
+	scan_regu_key_to_index_key (thread_p, &indx_infop->key_info.key_ranges[0], key_val, isidp,
+				    bts->btid_int.key_type, scan_id->vd);
+      if (error_code != NO_ERROR)
+	{
+	  goto end;
+	}
+    }
+  if (key_val->range == NA_NA || key_val->range == EQ_NA || key_val->is_truncated)
+    {
+      goto end;
+    }
+  if (key_val->range == GE_INF || key_val->range == GT_INF)
+    {
+      pr_clear_value (&key_val->key2);
+    }
+  else if (key_val->range == INF_LE || key_val->range == INF_LT || key_val->range == INF_INF)
+    {
+      pr_clear_value (&key_val->key1);
+    }
+
+  ordered = (indx_infop->orderby_skip || indx_infop->groupby_skip);
+  error_code =
+    index_scan_parallel_start (thread_p, &indx_infop->btid, &isidp->cls_oid, &isidp->hfid, key_val,
+			       isidp->scan_cache.mvcc_snapshot, ordered, &isidp->parallel);
+
+end:
+  if (isidp->parallel != NULL)
+    {
+      /* the key values are cleared with the scan */
+      isidp->curr_keyno = 0;
+      scan_id->scan_stats.parallel_index_scan = true;
+    }
+  else
+    {
+      /* scanned by this thread, which computes the key values again */
+      pr_clear_value (&key_val->key1);
+      pr_clear_value (&key_val->key2);
+    }
+  return error_code;
+}
+#endif /* SERVER_MODE */
+
 /*
  * scan_next_index_scan () - The scan is moved to the next index scan item.
  *   return: SCAN_CODE (S_SUCCESS, S_END, S_ERROR)
@@ -5594,7 +6605,29 @@ scan_next_index_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
       else
 	{
 	  /* non-grouped, regular index scan */
-	  if (scan_id->position == S_BEFORE)
+#if defined (SERVER_MODE)
+	  if (scan_id->position == S_BEFORE && isidp->parallel == NULL)
+	    {
+	      if (scan_start_parallel_index_scan (thread_p, scan_id) != NO_ERROR)
+		{
+		  return S_ERROR;
+		}
+	    }
+#endif /* SERVER_MODE */
+
+	  if (isidp->parallel != NULL)
+	    {
+	      SCAN_CODE ret;
+
+	      /* the objects are selected and their records fetched by the workers */
+	      ret = index_scan_parallel_next (thread_p, isidp->parallel, &isidp->curr_oidp);
+	      if (ret != S_SUCCESS)
+		{
+		  return ret;
+		}
+	      scan_id->position = S_ON;
+	    }
+	  else if (scan_id->position == S_BEFORE)
 	    {
 	      SCAN_CODE ret;
 
@@ -5682,7 +6715,7 @@ scan_next_index_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
 		  /* We can ignore the END OF SCAN signal if we're certain there can be more results, for instance if
 		   * we have a multiple range scan, or if we have the "index skip scan" optimization on */
 		  if (BTREE_END_OF_SCAN (&isidp->bt_scan) && isidp->indx_info->range_type != R_RANGELIST
-		      && isidp->indx_info->range_type != R_KEYLIST && !isidp->iss.use)
+		      && isidp->indx_info->range_type != R_KEYLIST && !isidp->iss.use && !SCAN_IS_INDEX_BITMAP (isidp))
 		    {
 		      return S_END;
 		    }
@@ -5877,8 +6910,17 @@ scan_next_index_lookup_heap (THREAD_ENTRY * thread_p, SCAN_ID * scan_id, INDX_SC
       recdes.data = NULL;
     }
 
-  sp_scan = heap_get_visible_version (thread_p, isidp->curr_oidp, NULL, &recdes, &isidp->scan_cache, scan_id->fixed,
-				      NULL_CHN);
+  if (isidp->parallel != NULL)
+    {
+      /* the visible version was fetched by a worker */
+      index_scan_parallel_get_record (isidp->parallel, &recdes);
+      sp_scan = S_SUCCESS;
+    }
+  else
+    {
+      sp_scan = heap_get_visible_version (thread_p, isidp->curr_oidp, NULL, &recdes, &isidp->scan_cache,
+					  scan_id->fixed, NULL_CHN);
+    }
   if (sp_scan == S_SNAPSHOT_NOT_SATISFIED)
     {
       if (SCAN_IS_INDEX_COVERED (isidp))
@@ -5905,6 +6947,21 @@ scan_next_index_lookup_heap (THREAD_ENTRY * thread_p, SCAN_ID * scan_id, INDX_SC
       assert (sp_scan == S_SUCCESS || sp_scan == S_SUCCESS_CHN_UPTODATE);
     }
 
+  if (scan_id->join_filter != NULL && scan_id->qualification == QPROC_QUALIFIED)
+    {
+      ev_res = scan_join_filter_eval (thread_p, scan_id->join_filter, isidp->curr_oidp, &recdes);
+      if (ev_res == V_ERROR)
+	{
+	  return S_ERROR;
+	}
+      else if (ev_res != V_TRUE)
+	{
+	  /* no join partner */
+	  scan_id->scan_stats.join_filtered_rows++;
+	  return S_DOESNT_EXIST;
+	}
+    }
+
   /* evaluate the predicates to see if the object qualifies */
   ev_res = eval_data_filter (thread_p, isidp->curr_oidp, &recdes, &isidp->scan_cache, data_filter);
 
@@ -7449,6 +8506,351 @@ scan_dump_key_into_tuple (THREAD_ENTRY * thread_p, INDX_SCAN_ID * iscan_id, DB_V
 }
 
 
+/*
+ * scan_join_filter_is_supported_type () - can join keys of this type be
+ *					   checked by a runtime join filter?
+ *   return: true if supported
+ *   type(in): join key type
+ *
+ * Note: Only types whose equality is the equality of a 64 bit integer image
+ *	 are supported; strings are left out because of collations.
+ */
+bool
+scan_join_filter_is_supported_type (DB_TYPE type)
+{
+  switch (type)
+    {
+    case DB_TYPE_SHORT:
+    case DB_TYPE_INTEGER:
+    case DB_TYPE_BIGINT:
+    case DB_TYPE_DATE:
+    case DB_TYPE_TIME:
+    case DB_TYPE_TIMESTAMP:
+    case DB_TYPE_DATETIME:
+      return true;
+
+    default:
+      return false;
+    }
+}
+
+/*
+ * scan_join_filter_get_key () - get the 64 bit integer image of a join key
+ *   return: false if the value has not the expected type
+ *   value(in): join key value, not null
+ *   type(in): expected type
+ *   key(out): integer image, keeps the order of the values
+ */
+static bool
+scan_join_filter_get_key (DB_VALUE * value, DB_TYPE type, INT64 * key)
+{
+  DB_DATETIME *datetime;
+
+  if (DB_VALUE_DOMAIN_TYPE (value) != type)
+    {
+      return false;
+    }
+
+  switch (type)
+    {
+    case DB_TYPE_SHORT:
+      *key = db_get_short (value);
+      return true;
+
+    case DB_TYPE_INTEGER:
+      *key = db_get_int (value);
+      return true;
+
+    case DB_TYPE_BIGINT:
+      *key = db_get_bigint (value);
+      return true;
+
+    case DB_TYPE_DATE:
+      *key = *db_get_date (value);
+      return true;
+
+    case DB_TYPE_TIME:
+      *key = *db_get_time (value);
+      return true;
+
+    case DB_TYPE_TIMESTAMP:
+      *key = *db_get_timestamp (value);
+      return true;
+
+    case DB_TYPE_DATETIME:
+      datetime = db_get_datetime (value);
+      *key = (INT64) datetime->date * MILLISECONDS_OF_ONE_DAY + datetime->time;
+      return true;
+
+    default:
+      return false;
+    }
+}
+
+/*
+ * scan_join_filter_hash () - mix the bits of a join key
+ *   return: hash value
+ *   key(in): join key
+ */
+static UINT64
+scan_join_filter_hash (INT64 key)
+{
+  UINT64 h = (UINT64) key;
+
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+
+  return h;
+}
+
+/*
+ * scan_join_filter_create () - create an empty runtime join filter
+ *   return: join filter or NULL on error
+ *   thread_p(in):
+ *   cls_oid(in): class scanned on the probe side
+ *   n_attrs(in): number of join attributes
+ *   attr_ids(in): join attributes of the class
+ *   types(in): type of each join attribute
+ *   expected_keys(in): number of build rows
+ */
+SCAN_JOIN_FILTER *
+scan_join_filter_create (THREAD_ENTRY * thread_p, OID * cls_oid, int n_attrs, ATTR_ID * attr_ids, DB_TYPE * types,
+			 int expected_keys)
+{
+  SCAN_JOIN_FILTER *filter;
+  size_t size;
+  int i, bloom_words;
+
+  assert (n_attrs > 0);
+
+  filter = (SCAN_JOIN_FILTER *) db_private_alloc (thread_p, sizeof (SCAN_JOIN_FILTER));
+  if (filter == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, sizeof (SCAN_JOIN_FILTER));
+      return NULL;
+    }
+  memset (filter, 0, sizeof (SCAN_JOIN_FILTER));
+  filter->n_attrs = n_attrs;
+
+  filter->attr_ids = (ATTR_ID *) db_private_alloc (thread_p, n_attrs * sizeof (ATTR_ID));
+  filter->types = (DB_TYPE *) db_private_alloc (thread_p, n_attrs * sizeof (DB_TYPE));
+  filter->min_keys = (INT64 *) db_private_alloc (thread_p, n_attrs * sizeof (INT64));
+  filter->max_keys = (INT64 *) db_private_alloc (thread_p, n_attrs * sizeof (INT64));
+  if (filter->attr_ids == NULL || filter->types == NULL || filter->min_keys == NULL || filter->max_keys == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, n_attrs * sizeof (INT64));
+      goto error;
+    }
+
+  for (i = 0; i < n_attrs; i++)
+    {
+      assert (scan_join_filter_is_supported_type (types[i]));
+      filter->attr_ids[i] = attr_ids[i];
+      filter->types[i] = types[i];
+      filter->min_keys[i] = DB_BIGINT_MAX;
+      filter->max_keys[i] = DB_BIGINT_MIN;
+    }
+
+  /* the bloom filter is only worth it while it stays sparse; otherwise rely on the key ranges */
+  bloom_words = 1;
+  while (bloom_words * 64 < expected_keys * SCAN_JOIN_FILTER_BITS_PER_KEY
+	 && bloom_words < SCAN_JOIN_FILTER_MAX_BLOOM_WORDS)
+    {
+      bloom_words *= 2;
+    }
+  if (bloom_words * 64 >= expected_keys * SCAN_JOIN_FILTER_BITS_PER_KEY)
+    {
+      size = (size_t) n_attrs * bloom_words * sizeof (UINT64);
+      filter->bloom = (UINT64 *) db_private_alloc (thread_p, size);
+      if (filter->bloom == NULL)
+	{
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, size);
+	  goto error;
+	}
+      memset (filter->bloom, 0, size);
+      filter->bloom_words = bloom_words;
+    }
+
+  if (heap_attrinfo_start (thread_p, cls_oid, n_attrs, attr_ids, &filter->attr_info) != NO_ERROR)
+    {
+      goto error;
+    }
+  filter->attr_info_inited = true;
+
+  return filter;
+
+error:
+  scan_join_filter_destroy (thread_p, filter);
+  return NULL;
+}
+
+/*
+ * scan_join_filter_add_key () - add the join key of a build row
+ *   return:
+ *   thread_p(in):
+ *   filter(in/out): join filter
+ *   keys(in): one value for each join attribute
+ *
+ * Note: Rows having a null key cannot be joined and must not be added.
+ */
+void
+scan_join_filter_add_key (THREAD_ENTRY * thread_p, SCAN_JOIN_FILTER * filter, DB_VALUE * keys)
+{
+  UINT64 *bloom, h;
+  INT64 key;
+  int i, mask;
+
+  for (i = 0; i < filter->n_attrs; i++)
+    {
+      if (!scan_join_filter_get_key (&keys[i], filter->types[i], &key))
+	{
+	  /* not expected for values read from a list file of the filter type; stop filtering on this attribute */
+	  assert (false);
+	  filter->min_keys[i] = DB_BIGINT_MIN;
+	  filter->max_keys[i] = DB_BIGINT_MAX;
+	  if (filter->bloom != NULL)
+	    {
+	      db_private_free_and_init (thread_p, filter->bloom);
+	      filter->bloom_words = 0;
+	    }
+	  continue;
+	}
+
+      if (key < filter->min_keys[i])
+	{
+	  filter->min_keys[i] = key;
+	}
+      if (key > filter->max_keys[i])
+	{
+	  filter->max_keys[i] = key;
+	}
+
+      if (filter->bloom != NULL)
+	{
+	  bloom = filter->bloom + (size_t) i * filter->bloom_words;
+	  mask = filter->bloom_words * 64 - 1;
+	  h = scan_join_filter_hash (key);
+	  bloom[(h & mask) / 64] |= 1ULL << (h & 63);
+	  bloom[((h >> 32) & mask) / 64] |= 1ULL << ((h >> 32) & 63);
+	}
+    }
+
+  filter->key_count++;
+}
+
+/*
+ * scan_join_filter_eval () - check whether a probe row may find a join
+ *			      partner
+ *   return: V_FALSE if the row cannot be joined, V_TRUE if it may be joined,
+ *	     V_ERROR on error
+ *   thread_p(in):
+ *   filter(in): join filter
+ *   oid(in): object identifier of the row
+ *   recdes(in): row record
+ */
+static DB_LOGICAL
+scan_join_filter_eval (THREAD_ENTRY * thread_p, SCAN_JOIN_FILTER * filter, OID * oid, RECDES * recdes)
+{
+  UINT64 *bloom, h;
+  DB_VALUE *value;
+  INT64 key;
+  int i, mask;
+
+  if (filter->key_count == 0)
+    {
+      return V_FALSE;
+    }
+
+  if (heap_attrinfo_read_dbvalues (thread_p, oid, recdes, NULL, &filter->attr_info) != NO_ERROR)
+    {
+      return V_ERROR;
+    }
+
+  for (i = 0; i < filter->n_attrs; i++)
+    {
+      value = heap_attrinfo_access (filter->attr_ids[i], &filter->attr_info);
+      if (value == NULL)
+	{
+	  return V_ERROR;
+	}
+
+      if (DB_IS_NULL (value))
+	{
+	  /* null keys never join */
+	  return V_FALSE;
+	}
+
+      if (!scan_join_filter_get_key (value, filter->types[i], &key))
+	{
+	  /* cannot decide, let the join evaluate it */
+	  continue;
+	}
+
+      if (key < filter->min_keys[i] || key > filter->max_keys[i])
+	{
+	  return V_FALSE;
+	}
+
+      if (filter->bloom != NULL)
+	{
+	  bloom = filter->bloom + (size_t) i * filter->bloom_words;
+	  mask = filter->bloom_words * 64 - 1;
+	  h = scan_join_filter_hash (key);
+	  if (!(bloom[(h & mask) / 64] & (1ULL << (h & 63)))
+	      || !(bloom[((h >> 32) & mask) / 64] & (1ULL << ((h >> 32) & 63))))
+	    {
+	      return V_FALSE;
+	    }
+	}
+    }
+
+  return V_TRUE;
+}
+
+/*
+ * scan_join_filter_destroy () - free a runtime join filter
+ *   return:
+ *   thread_p(in):
+ *   filter(in): join filter
+ */
+void
+scan_join_filter_destroy (THREAD_ENTRY * thread_p, SCAN_JOIN_FILTER * filter)
+{
+  if (filter == NULL)
+    {
+      return;
+    }
+
+  if (filter->attr_info_inited)
+    {
+      heap_attrinfo_end (thread_p, &filter->attr_info);
+    }
+  if (filter->attr_ids != NULL)
+    {
+      db_private_free (thread_p, filter->attr_ids);
+    }
+  if (filter->types != NULL)
+    {
+      db_private_free (thread_p, filter->types);
+    }
+  if (filter->min_keys != NULL)
+    {
+      db_private_free (thread_p, filter->min_keys);
+    }
+  if (filter->max_keys != NULL)
+    {
+      db_private_free (thread_p, filter->max_keys);
+    }
+  if (filter->bloom != NULL)
+    {
+      db_private_free (thread_p, filter->bloom);
+    }
+  db_private_free (thread_p, filter);
+}
+
 #if defined (SERVER_MODE)
 /*
  * scan_print_stats_json () -
@@ -7474,6 +8876,10 @@ scan_print_stats_json (SCAN_ID * scan_id, json_t * scan_stats)
     case S_LIST_SCAN:
       json_object_set_new (scan, "readrows", json_integer (scan_id->scan_stats.read_rows));
       json_object_set_new (scan, "rows", json_integer (scan_id->scan_stats.qualified_rows));
+      if (scan_id->scan_stats.join_filtered_rows > 0)
+	{
+	  json_object_set_new (scan, "joinfiltered", json_integer (scan_id->scan_stats.join_filtered_rows));
+	}
 
       if (scan_id->type == S_HEAP_SCAN)
 	{
@@ -7499,6 +8905,10 @@ scan_print_stats_json (SCAN_ID * scan_id, json_t * scan_stats)
 	{
 	  lookup = json_pack ("{s:i, s:i}", "time", TO_MSEC (scan_id->scan_stats.elapsed_lookup), "rows",
 			      scan_id->scan_stats.data_qualified_rows);
+	  if (scan_id->scan_stats.join_filtered_rows > 0)
+	    {
+	      json_object_set_new (lookup, "joinfiltered", json_integer (scan_id->scan_stats.join_filtered_rows));
+	    }
 
 	  json_object_set_new (scan_stats, "lookup", lookup);
 	}
@@ -7517,6 +8927,11 @@ scan_print_stats_json (SCAN_ID * scan_id, json_t * scan_stats)
 	{
 	  json_object_set_new (scan_stats, "loose", json_true ());
 	}
+
+      if (scan_id->scan_stats.parallel_index_scan == true)
+	{
+	  json_object_set_new (scan_stats, "parallel", json_true ());
+	}
       break;
 
     case S_SHOWSTMT_SCAN:
@@ -7596,7 +9011,12 @@ scan_print_stats_text (FILE * fp, SCAN_ID * scan_id)
     {
     case S_HEAP_SCAN:
     case S_LIST_SCAN:
-      fprintf (fp, ", readrows: %d, rows: %d)", scan_id->scan_stats.read_rows, scan_id->scan_stats.qualified_rows);
+      fprintf (fp, ", readrows: %d, rows: %d", scan_id->scan_stats.read_rows, scan_id->scan_stats.qualified_rows);
+      if (scan_id->scan_stats.join_filtered_rows > 0)
+	{
+	  fprintf (fp, ", joinfiltered: %d", scan_id->scan_stats.join_filtered_rows);
+	}
+      fprintf (fp, ")");
       break;
 
     case S_INDX_SCAN:
@@ -7622,12 +9042,22 @@ scan_print_stats_text (FILE * fp, SCAN_ID * scan_id)
 	{
 	  fprintf (fp, ", loose: true");
 	}
+
+      if (scan_id->scan_stats.parallel_index_scan == true)
+	{
+	  fprintf (fp, ", parallel: true");
+	}
       fprintf (fp, ")");
 
       if (scan_id->scan_stats.covered_index == false)
 	{
-	  fprintf (fp, " (lookup time: %d, rows: %d)", TO_MSEC (scan_id->scan_stats.elapsed_lookup),
+	  fprintf (fp, " (lookup time: %d, rows: %d", TO_MSEC (scan_id->scan_stats.elapsed_lookup),
 		   scan_id->scan_stats.data_qualified_rows);
+	  if (scan_id->scan_stats.join_filtered_rows > 0)
+	    {
+	      fprintf (fp, ", joinfiltered: %d", scan_id->scan_stats.join_filtered_rows);
+	    }
+	  fprintf (fp, ")");
 	}
       break;
 
@@ -58,6 +58,8 @@ struct val_descr;
 typedef struct val_descr VAL_DESCR;
 struct valptr_list_node;
 
+class index_scan_parallel;
+
 // *INDENT-OFF*
 namespace cubxasl
 {
@@ -182,6 +184,28 @@ struct index_skip_scan
   key_range *skipped_range;	/* range used for iterating the distinct values on the first index column */
 };
 
+/* one 64-slot word of the compressed OID bitmap of a bitmap index scan */
+#define INDEX_BITMAP_LOSSY_WORD (-1)	/* word_no of a lossy page: all objects of the page */
+
+typedef struct index_bitmap_word INDEX_BITMAP_WORD;
+struct index_bitmap_word
+{
+  VPID vpid;			/* heap page of the objects */
+  INT16 word_no;		/* slot number / 64, or INDEX_BITMAP_LOSSY_WORD */
+  UINT64 bits;			/* one bit per slot covered by the word */
+};
+
+typedef struct index_bitmap_scan INDEX_BITMAP_SCAN;
+struct index_bitmap_scan
+{
+  bool use;			/* true if the OID sets of several indexes are combined */
+  bool built;			/* true once the combined bitmap has been computed */
+  INDEX_BITMAP_WORD *words;	/* combined bitmap, sorted in physical page order */
+  int n_words;			/* number of words in the bitmap */
+  int curr_word;		/* next word to return objects from */
+  int curr_bit;			/* next bit to examine in the current word, or next slot of a lossy page */
+};
+
 /* typedef struct indx_scan_id INDX_SCAN_ID; - already defined in btree.h */
 struct indx_scan_id
 {
@@ -224,11 +248,13 @@ struct indx_scan_id
   INDX_COV indx_cov;		/* index covering information */
   MULTI_RANGE_OPT multi_range_opt;	/* optimization for multiple range search */
   INDEX_SKIP_SCAN iss;		/* index skip scan structure */
+  INDEX_BITMAP_SCAN bitmap;	/* bitmap index scan structure */
   DB_VALUE **key_info_values;	/* Used for index key info scan */
   regu_variable_list_node *key_info_regu_list;	/* regulator variable list */
   bool check_not_vacuumed;	/* if true then during index scan, the entries will be checked if they should've been
 				 * vacuumed. Used in checkdb. */
   DISK_ISVALID not_vacuumed_res;	/* The result of not vacuumed checking operation */
+  index_scan_parallel *parallel;	/* workers scanning the range, when it is large enough */
 };
 
 typedef struct index_node_scan_id INDEX_NODE_SCAN_ID;
@@ -308,6 +334,7 @@ struct scan_stats
   /* for heap & list scan */
   int read_rows;		/* # of rows read */
   int qualified_rows;		/* # of rows qualified by data filter */
+  int join_filtered_rows;	/* # of rows rejected by the runtime join filter */
 
   /* for btree scan */
   int read_keys;		/* # of keys read */
@@ -319,6 +346,25 @@ struct scan_stats
   bool multi_range_opt;
   bool index_skip_scan;
   bool loose_index_scan;
+  bool parallel_index_scan;
+};
+
+/* Runtime join filter. Built over the join keys of a materialized join input and checked by the heap and index scans
+ * of the other input before the data filter, so that rows which cannot find a join partner are dropped after reading
+ * only their join attributes. Keys are mapped to 64 bit integers, so only integer and date/time types are filtered. */
+typedef struct scan_join_filter SCAN_JOIN_FILTER;
+struct scan_join_filter
+{
+  int n_attrs;			/* number of join attributes */
+  ATTR_ID *attr_ids;		/* join attributes of the scanned class */
+  DB_TYPE *types;		/* type of each join attribute */
+  INT64 *min_keys;		/* smallest build key of each join attribute */
+  INT64 *max_keys;		/* largest build key of each join attribute */
+  UINT64 *bloom;		/* bloom filter of each join attribute, NULL if too many build keys */
+  int bloom_words;		/* number of 64 bit words in each bloom filter */
+  int key_count;		/* number of build rows added */
+  bool attr_info_inited;	/* is attr_info started? */
+  HEAP_CACHE_ATTRINFO attr_info;	/* cache used to read only the join attributes */
 };
 
 typedef struct scan_id_struct SCAN_ID;
@@ -359,12 +405,14 @@ struct scan_id_struct
 
   SCAN_STATS scan_stats;
   bool scan_immediately_stop;
+  SCAN_JOIN_FILTER *join_filter;	/* runtime join filter (owned by the access spec), or NULL */
 };				/* Scan Identifier */
 
 #define SCAN_IS_INDEX_COVERED(iscan_id_p) \
   ((iscan_id_p)->indx_cov.list_id != NULL)
 #define SCAN_IS_INDEX_MRO(iscan_id_p) ((iscan_id_p)->multi_range_opt.use)
 #define SCAN_IS_INDEX_ISS(iscan_id_p) ((iscan_id_p)->iss.use)
+#define SCAN_IS_INDEX_BITMAP(iscan_id_p) ((iscan_id_p)->bitmap.use)
 #define SCAN_IS_INDEX_ILS(iscan_id_p) \
   ((iscan_id_p)->indx_info != NULL \
    && (iscan_id_p)->indx_info->ils_prefix_len > 0)
@@ -475,6 +523,12 @@ extern void scan_init_filter_info (FILTER_INFO * filter_info_p, SCAN_PRED * scan
 				   int btree_num_attrs, ATTR_ID * btree_attr_ids, int *num_vstr_ptr,
 				   ATTR_ID * vstr_ids);
 
+extern bool scan_join_filter_is_supported_type (DB_TYPE type);
+extern SCAN_JOIN_FILTER *scan_join_filter_create (THREAD_ENTRY * thread_p, OID * cls_oid, int n_attrs,
+						  ATTR_ID * attr_ids, DB_TYPE * types, int expected_keys);
+extern void scan_join_filter_add_key (THREAD_ENTRY * thread_p, SCAN_JOIN_FILTER * filter, DB_VALUE * keys);
+extern void scan_join_filter_destroy (THREAD_ENTRY * thread_p, SCAN_JOIN_FILTER * filter);
+
 extern void showstmt_scan_init (void);
 extern SCAN_CODE showstmt_next_scan (THREAD_ENTRY * thread_p, SCAN_ID * s_id);
 extern int showstmt_start_scan (THREAD_ENTRY * thread_p, SCAN_ID * s_id);
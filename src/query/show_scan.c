@@ -50,6 +50,7 @@
 #include "connection_support.h"
 #include "critical_section.h"
 #include "tz_support.h"
+#include "vacuum.h"
 #include "db_date.h"
 #include "network.h"
 
@@ -229,6 +230,24 @@ showstmt_scan_init (void)
   req->next_func = showstmt_array_next_scan;
   req->end_func = showstmt_array_end_scan;
 
+  req = &show_Requests[SHOWSTMT_VACUUM_STATUS];
+  req->show_type = SHOWSTMT_VACUUM_STATUS;
+  req->start_func = vacuum_status_start_scan;
+  req->next_func = showstmt_array_next_scan;
+  req->end_func = showstmt_array_end_scan;
+
+  req = &show_Requests[SHOWSTMT_VACUUM_TABLES];
+  req->show_type = SHOWSTMT_VACUUM_TABLES;
+  req->start_func = vacuum_tables_start_scan;
+  req->next_func = showstmt_array_next_scan;
+  req->end_func = showstmt_array_end_scan;
+
+  req = &show_Requests[SHOWSTMT_VACUUM_THREADS];
+  req->show_type = SHOWSTMT_VACUUM_THREADS;
+  req->start_func = vacuum_threads_start_scan;
+  req->next_func = showstmt_array_next_scan;
+  req->end_func = showstmt_array_end_scan;
+
   /* append to init other show statement scan function here */
 
 
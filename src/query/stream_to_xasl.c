@@ -4432,6 +4432,7 @@ stx_build_access_spec_type (THREAD_ENTRY * thread_p, char *ptr, ACCESS_SPEC_TYPE
   access_spec->parts = NULL;
   access_spec->curent = NULL;
   access_spec->pruned = false;
+  access_spec->join_filter = NULL;
 
   ptr = or_unpack_int (ptr, &val);
   access_spec->flags = (ACCESS_SPEC_FLAG) val;
@@ -4478,6 +4479,23 @@ stx_build_indx_info (THREAD_ENTRY * thread_p, char *ptr, INDX_INFO * indx_info)
 
   ptr = or_unpack_int (ptr, &indx_info->func_idx_col_id);
 
+  ptr = or_unpack_int (ptr, &indx_info->bitmap_op);
+
+  ptr = or_unpack_int (ptr, &offset);
+  if (offset == 0)
+    {
+      indx_info->bitmap_next = NULL;
+    }
+  else
+    {
+      indx_info->bitmap_next = stx_restore_indx_info (thread_p, &xasl_unpack_info->packed_xasl[offset]);
+      if (indx_info->bitmap_next == NULL)
+	{
+	  stx_set_xasl_errcode (thread_p, ER_OUT_OF_VIRTUAL_MEMORY);
+	  return NULL;
+	}
+    }
+
   if (indx_info->use_iss)
     {
       ptr = or_unpack_int (ptr, &tmp);
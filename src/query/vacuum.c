@@ -42,6 +42,7 @@
 #include "page_buffer.h"
 #include "perf_monitor.h"
 #include "resource_shared_pool.hpp"
+#include "show_scan.h"
 #include "thread_entry_task.hpp"
 #if defined (SERVER_MODE)
 #include "thread_daemon.hpp"
@@ -55,8 +56,10 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <stack>
+#include <vector>
 
 #include <cstring>
 
@@ -489,6 +492,34 @@ lockfree::circular_queue<VACUUM_LOG_BLOCKID> *vacuum_Finished_job_queue = NULL;
 /* Static array of vacuum workers */
 VACUUM_WORKER vacuum_Workers[VACUUM_MAX_WORKER_COUNT];
 
+/* Vacuum statistics of heap files (SHOW VACUUM TABLES): versions produced by MVCC inserts, updates and deletes and
+ * versions vacuumed. Heap files get a slot of a fixed open addressing table the first time they are counted; slots are
+ * claimed with a compare-and-swap on the packed VFID and are never released, the counters of a destroyed heap file are
+ * only reset. Heap files that do not find a slot are counted together in the last (overflow) slot.
+ */
+#define VACUUM_STATS_HEAP_COUNT 1024	/* must be a power of 2 */
+#define VACUUM_STATS_HEAP_OVERFLOW VACUUM_STATS_HEAP_COUNT
+#define VACUUM_STATS_HEAP_MAX_PROBES 32
+
+/* *INDENT-OFF* */
+struct vacuum_heap_stats
+{
+  std::atomic<INT64> vfid_key;		/* packed VFID plus one; zero if slot is free */
+  std::atomic<INT32> hpgid;		/* heap header page identifier */
+  std::atomic<INT64> class_oid_key;	/* packed class OID; zero if unknown */
+  std::atomic<INT64> n_inserts;		/* MVCC inserts */
+  std::atomic<INT64> n_updates;		/* MVCC updates */
+  std::atomic<INT64> n_deletes;		/* MVCC deletes */
+  std::atomic<INT64> n_vacuumed;	/* versions (heap objects) vacuumed */
+  std::atomic<INT64> n_removed;		/* dead records removed */
+  std::atomic<INT64> n_cleaned;		/* records with insert MVCCID or previous version cleared */
+};
+static vacuum_heap_stats vacuum_Heap_stats[VACUUM_STATS_HEAP_COUNT + 1];
+
+/* Number of blocks in vacuum data, refreshed by vacuum master on each iteration. */
+static std::atomic<INT64> vacuum_Backlog_blocks { 0 };
+/* *INDENT-ON* */
+
 /* VACUUM_HEAP_HELPER -
  * Structure used by vacuum heap functions.
  */
@@ -523,6 +554,8 @@ struct vacuum_heap_helper
 
   int n_bulk_vacuumed;		/* Number of vacuumed objects to be logged in bulk mode. */
   int n_vacuumed;		/* Number of vacuumed objects. */
+  int n_removed;		/* Number of removed records (vacuum statistics). */
+  int n_cleaned;		/* Number of records with insert MVCCID or previous version cleared (vacuum statistics). */
   int initial_home_free_space;	/* Free space in home page before vacuum */
 
   /* Performance tracking. */
@@ -694,6 +727,8 @@ static int vacuum_compare_heap_object (const void *a, const void *b);
 static int vacuum_collect_heap_objects (THREAD_ENTRY * thread_p, VACUUM_WORKER * worker, OID * oid, VFID * vfid);
 static void vacuum_cleanup_collected_by_vfid (VACUUM_WORKER * worker, VFID * vfid);
 static int vacuum_heap (THREAD_ENTRY * thread_p, VACUUM_WORKER * worker, MVCCID threshold_mvccid, bool was_interrupted);
+static int vacuum_heap_objects (THREAD_ENTRY * thread_p, VACUUM_HEAP_OBJECT * heap_objects, int n_heap_objects,
+				MVCCID threshold_mvccid, bool was_interrupted);
 static int vacuum_heap_prepare_record (THREAD_ENTRY * thread_p, VACUUM_HEAP_HELPER * helper);
 static int vacuum_heap_record_insid_and_prev_version (THREAD_ENTRY * thread_p, VACUUM_HEAP_HELPER * helper);
 static int vacuum_heap_record (THREAD_ENTRY * thread_p, VACUUM_HEAP_HELPER * helper);
@@ -750,6 +785,11 @@ static void vacuum_verify_vacuum_data_page_fix_count (THREAD_ENTRY * thread_p);
 #endif /* NDEBUG */
 static void vacuum_check_shutdown_interruption (const THREAD_ENTRY * thread_p, int error_code);
 
+static vacuum_heap_stats *vacuum_stats_get_heap (const HFID * hfid, bool create);
+static void vacuum_stats_add_vacuumed (THREAD_ENTRY * thread_p, const HFID * hfid, int n_versions, int n_removed,
+				       int n_cleaned);
+static const char *vacuum_worker_state_string (VACUUM_WORKER_STATE state);
+
 /* *INDENT-OFF* */
 void
 vacuum_init_thread_context (cubthread::entry &context, thread_type type, VACUUM_WORKER *worker)
@@ -918,6 +958,112 @@ class vacuum_worker_task : public cubthread::entry_task
     VACUUM_DATA_ENTRY m_data;
 };
 
+#if defined (SERVER_MODE)
+// class vacuum_heap_shards
+//
+//  description:
+//    sorted heap objects of a vacuum job split in shards of consecutive heap pages. the shards are vacuumed by the
+//    worker running the job and by helper workers; each heap page belongs to one shard, so it is fixed only once.
+//
+class vacuum_heap_shards
+{
+  public:
+    vacuum_heap_shards (VACUUM_HEAP_OBJECT *heap_objects, std::vector<int> &&shard_starts, MVCCID threshold_mvccid,
+                        bool was_interrupted)
+      : m_heap_objects (heap_objects)
+      , m_shard_starts (std::move (shard_starts))
+      , m_threshold_mvccid (threshold_mvccid)
+      , m_was_interrupted (was_interrupted)
+      , m_next_shard { 0 }
+      , m_mutex ()
+      , m_done_cv ()
+      , m_done_count (0)
+      , m_error_code (NO_ERROR)
+    {
+    }
+
+    int get_shard_count () const
+    {
+      return (int) m_shard_starts.size () - 1;
+    }
+
+    // vacuum shards until none is left to claim
+    void run (cubthread::entry &thread_ref)
+    {
+      int shard;
+      int error_code;
+
+      while ((shard = m_next_shard++) < get_shard_count ())
+        {
+          error_code = vacuum_heap_objects (&thread_ref, m_heap_objects + m_shard_starts[shard],
+                                            m_shard_starts[shard + 1] - m_shard_starts[shard], m_threshold_mvccid,
+                                            m_was_interrupted);
+
+          std::unique_lock<std::mutex> ulock (m_mutex);
+          if (error_code != NO_ERROR && m_error_code == NO_ERROR)
+            {
+              m_error_code = error_code;
+            }
+          if (++m_done_count == get_shard_count ())
+            {
+              m_done_cv.notify_all ();
+            }
+        }
+    }
+
+    // wait for the shards claimed by helpers; returns the error of the first failed shard
+    int wait_all ()
+    {
+      std::unique_lock<std::mutex> ulock (m_mutex);
+      m_done_cv.wait (ulock, [this] { return m_done_count == get_shard_count (); });
+      return m_error_code;
+    }
+
+  private:
+    VACUUM_HEAP_OBJECT *m_heap_objects;     // sorted heap objects of the job; owned by the job worker
+    std::vector<int> m_shard_starts;        // index of the first object of each shard; last is the object count
+    MVCCID m_threshold_mvccid;
+    bool m_was_interrupted;
+    std::atomic<int> m_next_shard;          // next shard to claim
+    std::mutex m_mutex;
+    std::condition_variable m_done_cv;
+    int m_done_count;                       // # of vacuumed shards
+    int m_error_code;
+};
+
+// class vacuum_heap_shard_task
+//
+//  description:
+//    helper task vacuuming heap shards of a job run by another worker. a helper that starts after all shards were
+//    claimed has nothing to do; the job worker never waits for helpers that did not claim a shard.
+//
+class vacuum_heap_shard_task : public cubthread::entry_task
+{
+  public:
+    vacuum_heap_shard_task (const std::shared_ptr<vacuum_heap_shards> &shards)
+      : m_shards (shards)
+    {
+    }
+
+    void execute (cubthread::entry & thread_ref) final
+    {
+      assert (!thread_ref.check_interrupt);
+
+      thread_ref.vacuum_worker->state = VACUUM_WORKER_STATE_EXECUTE;
+      m_shards->run (thread_ref);
+      thread_ref.vacuum_worker->state = VACUUM_WORKER_STATE_INACTIVE;
+
+      /* Normally all pages should already be unfixed. */
+      pgbuf_unfix_all (&thread_ref);
+    }
+
+  private:
+    vacuum_heap_shard_task ();
+
+    std::shared_ptr<vacuum_heap_shards> m_shards;
+};
+#endif // SERVER_MODE
+
 // vacuum master globals
 static cubthread::daemon *vacuum_Master_daemon = NULL;                       // daemon thread
 static vacuum_master_context_manager *vacuum_Master_context_manager = NULL;  // context manager
@@ -1178,6 +1324,11 @@ vacuum_initialize (THREAD_ENTRY * thread_p, int vacuum_log_block_npages, VFID *
   vacuum_Master.prefetch_first_pageid = NULL_PAGEID;
   vacuum_Master.prefetch_last_pageid = NULL_PAGEID;
   vacuum_Master.allocated_resources = false;
+  vacuum_Master.n_jobs = 0;
+  vacuum_Master.n_log_pages = 0;
+  vacuum_Master.n_versions_vacuumed = 0;
+  vacuum_Master.n_records_removed = 0;
+  vacuum_Master.n_versions_cleaned = 0;
 
   /* Initialize workers */
   for (i = 0; i < VACUUM_MAX_WORKER_COUNT; i++)
@@ -1194,6 +1345,11 @@ vacuum_initialize (THREAD_ENTRY * thread_p, int vacuum_log_block_npages, VFID *
       vacuum_Workers[i].prefetch_first_pageid = NULL_PAGEID;
       vacuum_Workers[i].prefetch_last_pageid = NULL_PAGEID;
       vacuum_Workers[i].allocated_resources = false;
+      vacuum_Workers[i].n_jobs = 0;
+      vacuum_Workers[i].n_log_pages = 0;
+      vacuum_Workers[i].n_versions_vacuumed = 0;
+      vacuum_Workers[i].n_records_removed = 0;
+      vacuum_Workers[i].n_versions_cleaned = 0;
     }
 
   return NO_ERROR;
@@ -1400,21 +1556,23 @@ vacuum_finalize (THREAD_ENTRY * thread_p)
  *
  * return		 : Error code.
  * thread_p (in)	 : Thread entry.
- * heap_objects (in)	 : Array of heap objects (VFID & OID).
- * n_heap_objects (in)	 : Number of heap objects.
+ * worker (in)		 : Vacuum worker with the heap objects collected by the job.
  * threshold_mvccid (in) : Threshold MVCCID used for vacuum check.
  * was_interrutped (in)  : True if same job was executed and interrupted.
+ *
+ * NOTE: When the job collected objects in many heap pages (e.g. after a mass update of one table), the objects are
+ *	 split in shards of PRM_ID_VACUUM_HEAP_SHARD_PAGES pages and idle vacuum workers help vacuuming them.
  */
 static int
 vacuum_heap (THREAD_ENTRY * thread_p, VACUUM_WORKER * worker, MVCCID threshold_mvccid, bool was_interrupted)
 {
-  VACUUM_HEAP_OBJECT *page_ptr;
-  VACUUM_HEAP_OBJECT *obj_ptr;
+#if defined (SERVER_MODE)
+  int shard_pages;
+  int page_count;
+  int helper_count;
+  int i;
   int error_code = NO_ERROR;
-  VFID vfid = VFID_INITIALIZER;
-  HFID hfid = HFID_INITIALIZER;
-  bool reusable = false;
-  int object_count = 0;
+#endif /* SERVER_MODE */
 
   if (worker->n_heap_objects == 0)
     {
@@ -1429,8 +1587,90 @@ vacuum_heap (THREAD_ENTRY * thread_p, VACUUM_WORKER * worker, MVCCID threshold_m
    * each different heap page. */
   qsort (worker->heap_objects, worker->n_heap_objects, sizeof (VACUUM_HEAP_OBJECT), vacuum_compare_heap_object);
 
+#if defined (SERVER_MODE)
+  shard_pages = prm_get_integer_value (PRM_ID_VACUUM_HEAP_SHARD_PAGES);
+  if (shard_pages > 0 && worker->n_heap_objects > shard_pages && prm_get_integer_value (PRM_ID_VACUUM_WORKER_COUNT) > 1)
+    {
+      /* Split objects in shards of consecutive pages. */
+      /* *INDENT-OFF* */
+      std::vector<int> shard_starts;
+      /* *INDENT-ON* */
+
+      shard_starts.push_back (0);
+      page_count = 1;
+      for (i = 1; i < worker->n_heap_objects; i++)
+	{
+	  if (worker->heap_objects[i].oid.pageid == worker->heap_objects[i - 1].oid.pageid
+	      && worker->heap_objects[i].oid.volid == worker->heap_objects[i - 1].oid.volid)
+	    {
+	      continue;
+	    }
+	  if (page_count == shard_pages)
+	    {
+	      shard_starts.push_back (i);
+	      page_count = 0;
+	    }
+	  page_count++;
+	}
+      shard_starts.push_back (worker->n_heap_objects);
+
+      if (shard_starts.size () > 2)
+	{
+	  /* *INDENT-OFF* */
+	  std::shared_ptr<vacuum_heap_shards> shards =
+	    std::make_shared<vacuum_heap_shards> (worker->heap_objects, std::move (shard_starts), threshold_mvccid,
+						  was_interrupted);
+	  /* *INDENT-ON* */
+
+	  helper_count = MIN (shards->get_shard_count (), prm_get_integer_value (PRM_ID_VACUUM_WORKER_COUNT)) - 1;
+	  for (i = 0; i < helper_count && !cubthread::get_manager ()->is_pool_full (vacuum_Worker_threads); i++)
+	    {
+	      cubthread::get_manager ()->push_task (vacuum_Worker_threads, new vacuum_heap_shard_task (shards));
+	    }
+	  vacuum_er_log (VACUUM_ER_LOG_HEAP | VACUUM_ER_LOG_WORKER, "Vacuum %d heap objects in %d shards with %d helpers.",
+			 worker->n_heap_objects, shards->get_shard_count (), i);
+
+	  shards->run (*thread_p);
+	  error_code = shards->wait_all ();
+	  if (error_code != NO_ERROR && er_errid () == NO_ERROR)
+	    {
+	      /* A helper failed (it may be stopped on shutdown); the job is not complete. */
+	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_INTERRUPTED, 0);
+	      error_code = ER_INTERRUPTED;
+	    }
+	  return error_code;
+	}
+    }
+#endif /* SERVER_MODE */
+
+  return vacuum_heap_objects (thread_p, worker->heap_objects, worker->n_heap_objects, threshold_mvccid,
+			      was_interrupted);
+}
+
+/*
+ * vacuum_heap_objects () - Vacuum sorted heap objects page by page.
+ *
+ * return		 : Error code.
+ * thread_p (in)	 : Thread entry.
+ * heap_objects (in)	 : Array of heap objects (VFID & OID), sorted by VFID then by OID.
+ * n_heap_objects (in)	 : Number of heap objects.
+ * threshold_mvccid (in) : Threshold MVCCID used for vacuum check.
+ * was_interrutped (in)  : True if same job was executed and interrupted.
+ */
+static int
+vacuum_heap_objects (THREAD_ENTRY * thread_p, VACUUM_HEAP_OBJECT * heap_objects, int n_heap_objects,
+		     MVCCID threshold_mvccid, bool was_interrupted)
+{
+  VACUUM_HEAP_OBJECT *page_ptr;
+  VACUUM_HEAP_OBJECT *obj_ptr;
+  int error_code = NO_ERROR;
+  VFID vfid = VFID_INITIALIZER;
+  HFID hfid = HFID_INITIALIZER;
+  bool reusable = false;
+  int object_count = 0;
+
   /* Start parsing array. Vacuum objects page by page. */
-  for (page_ptr = worker->heap_objects; page_ptr < worker->heap_objects + worker->n_heap_objects;)
+  for (page_ptr = heap_objects; page_ptr < heap_objects + n_heap_objects;)
     {
       if (!VFID_EQ (&vfid, &page_ptr->vfid))
 	{
@@ -1442,7 +1682,7 @@ vacuum_heap (THREAD_ENTRY * thread_p, VACUUM_WORKER * worker, MVCCID threshold_m
       /* Find all objects for this page. */
       object_count = 1;
       for (obj_ptr = page_ptr + 1;
-	   obj_ptr < worker->heap_objects + worker->n_heap_objects && obj_ptr->oid.pageid == page_ptr->oid.pageid
+	   obj_ptr < heap_objects + n_heap_objects && obj_ptr->oid.pageid == page_ptr->oid.pageid
 	   && obj_ptr->oid.volid == page_ptr->oid.volid; obj_ptr++)
 	{
 	  object_count++;
@@ -1529,6 +1769,8 @@ vacuum_heap_page (THREAD_ENTRY * thread_p, VACUUM_HEAP_OBJECT * heap_objects, in
   helper.forward_page = NULL;
   helper.n_vacuumed = 0;
   helper.n_bulk_vacuumed = 0;
+  helper.n_removed = 0;
+  helper.n_cleaned = 0;
   helper.initial_home_free_space = -1;
   VFID_SET_NULL (&helper.overflow_vfid);
 
@@ -1813,6 +2055,11 @@ end:
       vacuum_heap_page_log_and_reset (thread_p, &helper, true, true);
     }
 
+  if (error_code == NO_ERROR)
+    {
+      vacuum_stats_add_vacuumed (thread_p, &helper.hfid, n_heap_objects, helper.n_removed, helper.n_cleaned);
+    }
+
   return error_code;
 }
 
@@ -2254,6 +2501,7 @@ vacuum_heap_record_insid_and_prev_version (THREAD_ENTRY * thread_p, VACUUM_HEAP_
     }
 
   helper->n_vacuumed++;
+  helper->n_cleaned++;
 
   perfmon_inc_stat (thread_p, PSTAT_HEAP_INSID_VACUUMS);
 
@@ -2386,6 +2634,7 @@ vacuum_heap_record (THREAD_ENTRY * thread_p, VACUUM_HEAP_HELPER * helper)
     }
 
   helper->n_vacuumed++;
+  helper->n_removed++;
 
   assert (helper->forward_page == NULL);
 
@@ -2967,6 +3216,8 @@ vacuum_master_task::execute (cubthread::entry &thread_ref)
         }
     }
   m_cursor.unload ();
+  vacuum_Backlog_blocks =
+    vacuum_Data.is_empty () ? 0 : vacuum_Data.get_last_blockid () - vacuum_Data.get_first_blockid () + 1;
 #if !defined (NDEBUG)
   vacuum_verify_vacuum_data_page_fix_count (&thread_ref);
 #endif /* !NDEBUG */
@@ -3438,6 +3689,7 @@ vacuum_process_log_block (THREAD_ENTRY * thread_p, VACUUM_DATA_ENTRY * data, boo
   assert (!LOG_FIND_CURRENT_TDES (thread_p)->is_under_sysop ());
 
   perfmon_add_stat (thread_p, PSTAT_VAC_NUM_VACUUMED_LOG_PAGES, vacuum_Data.log_block_npages);
+  worker->n_log_pages += vacuum_Data.log_block_npages;
 
   vacuum_complete = true;
 
@@ -3446,6 +3698,7 @@ end:
   assert (!LOG_FIND_CURRENT_TDES (thread_p)->is_under_sysop ());
 
   worker->state = VACUUM_WORKER_STATE_INACTIVE;
+  worker->n_jobs++;
   if (!sa_mode_partial_block)
     {
       /* TODO: Check that if start_lsa can be set to a different value when vacuum is not complete, to avoid processing
@@ -8360,3 +8613,598 @@ vacuum_shutdown_sequence::check_shutdown_request ()
     }
 }
 // *INDENT-ON*
+
+/*
+ * vacuum_stats_get_heap () - Get statistics slot of heap file.
+ *
+ * return      : Statistics slot or NULL if heap file is not found and create is false. If the table is full, the
+ *		 overflow slot is returned for create.
+ * hfid (in)   : Heap file identifier.
+ * create (in) : True to claim a slot if heap file is not found.
+ */
+static vacuum_heap_stats *
+vacuum_stats_get_heap (const HFID * hfid, bool create)
+{
+  INT64 key = ((((INT64) (UINT16) hfid->vfid.volid) << 32) | (UINT32) hfid->vfid.fileid) + 1;
+  INT64 slot_key;
+  unsigned int pos = (unsigned int) (hfid->vfid.fileid ^ (hfid->vfid.volid << 20)) & (VACUUM_STATS_HEAP_COUNT - 1);
+  int probe;
+
+  for (probe = 0; probe < VACUUM_STATS_HEAP_MAX_PROBES; probe++, pos = (pos + 1) & (VACUUM_STATS_HEAP_COUNT - 1))
+    {
+      vacuum_heap_stats *stats = &vacuum_Heap_stats[pos];
+
+      slot_key = stats->vfid_key.load ();
+      if (slot_key == key)
+	{
+	  return stats;
+	}
+      if (slot_key != 0)
+	{
+	  continue;
+	}
+      if (!create)
+	{
+	  return NULL;
+	}
+      if (stats->vfid_key.compare_exchange_strong (slot_key, key))
+	{
+	  stats->hpgid = hfid->hpgid;
+	  return stats;
+	}
+      if (slot_key == key)
+	{
+	  /* claimed by another thread for the same heap file */
+	  return stats;
+	}
+    }
+
+  return create ? &vacuum_Heap_stats[VACUUM_STATS_HEAP_OVERFLOW] : NULL;
+}
+
+/*
+ * vacuum_stats_add_dml () - Count a new version of a heap record produced by an MVCC operation.
+ *
+ * return	  : Void.
+ * thread_p (in)  : Thread entry.
+ * hfid (in)	  : Heap file identifier.
+ * class_oid (in) : Class object identifier.
+ * op (in)	  : DML operation.
+ */
+void
+vacuum_stats_add_dml (THREAD_ENTRY * thread_p, const HFID * hfid, const OID * class_oid, VACUUM_STATS_DML_OP op)
+{
+  vacuum_heap_stats *stats;
+  INT64 class_oid_key;
+
+  if (HFID_IS_NULL (hfid))
+    {
+      return;
+    }
+
+  stats = vacuum_stats_get_heap (hfid, true);
+  if (class_oid != NULL && !OID_ISNULL (class_oid))
+    {
+      class_oid_key = (((INT64) class_oid->pageid) << 32) | (((UINT32) (UINT16) class_oid->slotid) << 16)
+	| (UINT16) class_oid->volid;
+      if (stats->class_oid_key.load () != class_oid_key)
+	{
+	  stats->class_oid_key = class_oid_key;
+	}
+    }
+
+  switch (op)
+    {
+    case VACUUM_STATS_DML_INSERT:
+      ++stats->n_inserts;
+      break;
+    case VACUUM_STATS_DML_UPDATE:
+      ++stats->n_updates;
+      break;
+    case VACUUM_STATS_DML_DELETE:
+      ++stats->n_deletes;
+      break;
+    default:
+      assert (false);
+      return;
+    }
+
+  perfmon_inc_stat (thread_p, PSTAT_VAC_NUM_VERSIONS_PRODUCED);
+}
+
+/*
+ * vacuum_stats_add_vacuumed () - Count the versions vacuumed in a heap page.
+ *
+ * return	   : Void.
+ * thread_p (in)   : Thread entry.
+ * hfid (in)	   : Heap file identifier.
+ * n_versions (in) : Number of heap objects vacuumed.
+ * n_removed (in)  : Number of records removed.
+ * n_cleaned (in)  : Number of records with insert MVCCID or previous version cleared.
+ */
+static void
+vacuum_stats_add_vacuumed (THREAD_ENTRY * thread_p, const HFID * hfid, int n_versions, int n_removed, int n_cleaned)
+{
+  vacuum_heap_stats *stats;
+  VACUUM_WORKER *worker;
+
+  if (!HFID_IS_NULL (hfid))
+    {
+      stats = vacuum_stats_get_heap (hfid, true);
+      stats->n_vacuumed += n_versions;
+      stats->n_removed += n_removed;
+      stats->n_cleaned += n_cleaned;
+    }
+
+  if (vacuum_is_thread_vacuum_worker (thread_p))
+    {
+      worker = vacuum_get_vacuum_worker (thread_p);
+      worker->n_versions_vacuumed += n_versions;
+      worker->n_records_removed += n_removed;
+      worker->n_versions_cleaned += n_cleaned;
+    }
+
+  perfmon_add_stat (thread_p, PSTAT_VAC_NUM_VERSIONS_VACUUMED, n_versions);
+}
+
+/*
+ * vacuum_stats_remove_heap () - Reset the statistics of a destroyed heap file.
+ *
+ * return    : Void.
+ * hfid (in) : Heap file identifier.
+ */
+void
+vacuum_stats_remove_heap (const HFID * hfid)
+{
+  vacuum_heap_stats *stats;
+
+  if (HFID_IS_NULL (hfid))
+    {
+      return;
+    }
+
+  stats = vacuum_stats_get_heap (hfid, false);
+  if (stats == NULL)
+    {
+      return;
+    }
+
+  stats->class_oid_key = 0;
+  stats->n_inserts = 0;
+  stats->n_updates = 0;
+  stats->n_deletes = 0;
+  stats->n_vacuumed = 0;
+  stats->n_removed = 0;
+  stats->n_cleaned = 0;
+}
+
+/*
+ * vacuum_peek_stats () - Peek vacuum statistics for performance monitor.
+ *
+ * return		   : Void.
+ * backlog_blocks (out)	   : Number of log blocks waiting to be vacuumed.
+ * oldest_visible_lag (out) : Number of MVCCIDs between the oldest visible MVCCID and the next MVCCID.
+ */
+void
+vacuum_peek_stats (UINT64 * backlog_blocks, UINT64 * oldest_visible_lag)
+{
+  MVCCID oldest_visible = log_Gl.mvcc_table.get_global_oldest_visible ();
+  MVCCID next_mvccid = log_Gl.hdr.mvcc_next_id;
+
+  *backlog_blocks = (UINT64) vacuum_Backlog_blocks.load ();
+  if (MVCCID_IS_NORMAL (oldest_visible) && MVCC_ID_PRECEDES (oldest_visible, next_mvccid))
+    {
+      *oldest_visible_lag = next_mvccid - oldest_visible;
+    }
+  else
+    {
+      *oldest_visible_lag = 0;
+    }
+}
+
+/*
+ * vacuum_worker_state_string () - Get name of vacuum worker state.
+ *
+ * return     : Name of state.
+ * state (in) : Vacuum worker state.
+ */
+static const char *
+vacuum_worker_state_string (VACUUM_WORKER_STATE state)
+{
+  switch (state)
+    {
+    case VACUUM_WORKER_STATE_INACTIVE:
+      return "INACTIVE";
+    case VACUUM_WORKER_STATE_PROCESS_LOG:
+      return "PROCESS_LOG";
+    case VACUUM_WORKER_STATE_EXECUTE:
+      return "EXECUTE";
+    default:
+      assert (false);
+      return "UNKNOWN";
+    }
+}
+
+/*
+ * vacuum_status_start_scan () - Start scan function for SHOW VACUUM STATUS.
+ *
+ * return	   : Error code.
+ * thread_p (in)   : Thread entry.
+ * type (in)	   : Show statement type.
+ * arg_values (in) : Arguments.
+ * arg_cnt (in)	   : Number of arguments.
+ * ptr (out)	   : Array context with one tuple.
+ */
+int
+vacuum_status_start_scan (THREAD_ENTRY * thread_p, int type, DB_VALUE ** arg_values, int arg_cnt, void **ptr)
+{
+  SHOWSTMT_ARRAY_CONTEXT *ctx = NULL;
+  DB_VALUE *vals = NULL;
+  const int num_cols = 18;
+  int idx = 0;
+  int i, worker_count, active_workers = 0;
+  INT64 backlog_blocks, n_jobs = 0, n_versions = 0, n_removed = 0, n_cleaned = 0;
+  MVCCID oldest_visible, holder_mvccid;
+  int holder_tran_index;
+  LOG_TDES *tdes;
+  int error = NO_ERROR;
+
+  *ptr = NULL;
+
+  ctx = showstmt_alloc_array_context (thread_p, 1, num_cols);
+  if (ctx == NULL)
+    {
+      ASSERT_ERROR_AND_SET (error);
+      return error;
+    }
+
+  vals = showstmt_alloc_tuple_in_context (thread_p, ctx);
+  if (vals == NULL)
+    {
+      ASSERT_ERROR_AND_SET (error);
+      goto exit_on_error;
+    }
+
+  worker_count = MIN (prm_get_integer_value (PRM_ID_VACUUM_WORKER_COUNT), VACUUM_MAX_WORKER_COUNT);
+  for (i = 0; i < worker_count; i++)
+    {
+      if (vacuum_Workers[i].state != VACUUM_WORKER_STATE_INACTIVE)
+	{
+	  active_workers++;
+	}
+      n_jobs += vacuum_Workers[i].n_jobs;
+      n_versions += vacuum_Workers[i].n_versions_vacuumed;
+      n_removed += vacuum_Workers[i].n_records_removed;
+      n_cleaned += vacuum_Workers[i].n_versions_cleaned;
+    }
+
+  /* Backlog_blocks */
+  backlog_blocks = vacuum_Backlog_blocks.load ();
+  db_make_bigint (&vals[idx], backlog_blocks);
+  idx++;
+
+  /* Backlog_log_pages */
+  db_make_bigint (&vals[idx], backlog_blocks * vacuum_Data.log_block_npages);
+  idx++;
+
+  /* Oldest_unvacuumed_mvccid */
+  db_make_bigint (&vals[idx], (DB_BIGINT) vacuum_Data.oldest_unvacuumed_mvccid);
+  idx++;
+
+  /* Oldest_visible_mvccid */
+  oldest_visible = log_Gl.mvcc_table.get_global_oldest_visible ();
+  db_make_bigint (&vals[idx], (DB_BIGINT) oldest_visible);
+  idx++;
+
+  /* Next_mvccid */
+  db_make_bigint (&vals[idx], (DB_BIGINT) log_Gl.hdr.mvcc_next_id);
+  idx++;
+
+  /* Blocking transaction: the transaction with the lowest visible MVCCID. */
+  TR_TABLE_CS_ENTER_READ_MODE (thread_p);
+  holder_tran_index = log_Gl.mvcc_table.find_oldest_visible_holder (holder_mvccid);
+  tdes = holder_tran_index != NULL_TRAN_INDEX ? LOG_FIND_TDES (holder_tran_index) : NULL;
+  if (tdes != NULL && tdes->trid != NULL_TRANID)
+    {
+      /* Blocking_tran_index */
+      db_make_int (&vals[idx], tdes->tran_index);
+      idx++;
+
+      /* Blocking_tran_id */
+      db_make_int (&vals[idx], tdes->trid);
+      idx++;
+
+      /* Blocking_mvccid */
+      db_make_bigint (&vals[idx], (DB_BIGINT) holder_mvccid);
+      idx++;
+
+      /* Blocking_user */
+      error = db_make_string_copy (&vals[idx], tdes->client.get_db_user ());
+      idx++;
+      if (error != NO_ERROR)
+	{
+	  TR_TABLE_CS_EXIT (thread_p);
+	  goto exit_on_error;
+	}
+
+      /* Blocking_host */
+      error = db_make_string_copy (&vals[idx], tdes->client.get_host_name ());
+      idx++;
+      if (error != NO_ERROR)
+	{
+	  TR_TABLE_CS_EXIT (thread_p);
+	  goto exit_on_error;
+	}
+
+      /* Blocking_program */
+      error = db_make_string_copy (&vals[idx], tdes->client.get_program_name ());
+      idx++;
+      if (error != NO_ERROR)
+	{
+	  TR_TABLE_CS_EXIT (thread_p);
+	  goto exit_on_error;
+	}
+
+      /* Blocking_pid */
+      db_make_int (&vals[idx], tdes->client.process_id);
+      idx++;
+    }
+  else
+    {
+      /* no blocking transaction; leave the columns null */
+      idx += 7;
+    }
+  TR_TABLE_CS_EXIT (thread_p);
+
+  /* Workers */
+  db_make_int (&vals[idx], worker_count);
+  idx++;
+
+  /* Active_workers */
+  db_make_int (&vals[idx], active_workers);
+  idx++;
+
+  /* Jobs */
+  db_make_bigint (&vals[idx], n_jobs);
+  idx++;
+
+  /* Versions_vacuumed */
+  db_make_bigint (&vals[idx], n_versions);
+  idx++;
+
+  /* Records_removed */
+  db_make_bigint (&vals[idx], n_removed);
+  idx++;
+
+  /* Versions_cleaned */
+  db_make_bigint (&vals[idx], n_cleaned);
+  idx++;
+
+  assert (idx == num_cols);
+
+  *ptr = ctx;
+  return NO_ERROR;
+
+exit_on_error:
+  showstmt_free_array_context (thread_p, ctx);
+  return error;
+}
+
+/*
+ * vacuum_tables_start_scan () - Start scan function for SHOW VACUUM TABLES.
+ *
+ * return	   : Error code.
+ * thread_p (in)   : Thread entry.
+ * type (in)	   : Show statement type.
+ * arg_values (in) : Arguments.
+ * arg_cnt (in)	   : Number of arguments.
+ * ptr (out)	   : Array context with one tuple for each heap file with statistics.
+ */
+int
+vacuum_tables_start_scan (THREAD_ENTRY * thread_p, int type, DB_VALUE ** arg_values, int arg_cnt, void **ptr)
+{
+  SHOWSTMT_ARRAY_CONTEXT *ctx = NULL;
+  DB_VALUE *vals = NULL;
+  const int num_cols = 12;
+  int idx, i;
+  INT64 vfid_key, class_oid_key, n_inserts, n_updates, n_deletes, n_vacuumed, n_produced;
+  OID class_oid;
+  char *class_name = NULL;
+  int error = NO_ERROR;
+
+  *ptr = NULL;
+
+  ctx = showstmt_alloc_array_context (thread_p, 16, num_cols);
+  if (ctx == NULL)
+    {
+      ASSERT_ERROR_AND_SET (error);
+      return error;
+    }
+
+  for (i = 0; i <= VACUUM_STATS_HEAP_OVERFLOW; i++)
+    {
+      vacuum_heap_stats *stats = &vacuum_Heap_stats[i];
+
+      vfid_key = stats->vfid_key.load ();
+      n_inserts = stats->n_inserts.load ();
+      n_updates = stats->n_updates.load ();
+      n_deletes = stats->n_deletes.load ();
+      n_vacuumed = stats->n_vacuumed.load ();
+      n_produced = n_inserts + n_updates + n_deletes;
+      if ((vfid_key == 0 && i != VACUUM_STATS_HEAP_OVERFLOW) || (n_produced == 0 && n_vacuumed == 0))
+	{
+	  /* free slot or no activity */
+	  continue;
+	}
+
+      idx = 0;
+      vals = showstmt_alloc_tuple_in_context (thread_p, ctx);
+      if (vals == NULL)
+	{
+	  ASSERT_ERROR_AND_SET (error);
+	  goto exit_on_error;
+	}
+
+      /* Class_name; null if class is unknown or for the overflow slot */
+      class_oid_key = stats->class_oid_key.load ();
+      class_oid.pageid = (INT32) (class_oid_key >> 32);
+      class_oid.slotid = (INT16) ((class_oid_key >> 16) & 0xFFFF);
+      class_oid.volid = (INT16) (class_oid_key & 0xFFFF);
+      if (i != VACUUM_STATS_HEAP_OVERFLOW && class_oid.slotid > 0)
+	{
+	  if (heap_get_class_name (thread_p, &class_oid, &class_name) != NO_ERROR)
+	    {
+	      /* ignore */
+	      er_clear ();
+	    }
+	  if (class_name != NULL)
+	    {
+	      error = db_make_string_copy (&vals[idx], class_name);
+	      free_and_init (class_name);
+	      if (error != NO_ERROR)
+		{
+		  goto exit_on_error;
+		}
+	    }
+	}
+      idx++;
+
+      if (i != VACUUM_STATS_HEAP_OVERFLOW)
+	{
+	  /* Volume_id */
+	  db_make_int (&vals[idx], (int) (((vfid_key - 1) >> 32) & 0xFFFF));
+	  idx++;
+
+	  /* File_id */
+	  db_make_int (&vals[idx], (int) ((vfid_key - 1) & 0xFFFFFFFF));
+	  idx++;
+
+	  /* Header_page_id */
+	  db_make_int (&vals[idx], stats->hpgid.load ());
+	  idx++;
+	}
+      else
+	{
+	  idx += 3;
+	}
+
+      /* Mvcc_inserts */
+      db_make_bigint (&vals[idx], n_inserts);
+      idx++;
+
+      /* Mvcc_updates */
+      db_make_bigint (&vals[idx], n_updates);
+      idx++;
+
+      /* Mvcc_deletes */
+      db_make_bigint (&vals[idx], n_deletes);
+      idx++;
+
+      /* Versions_produced */
+      db_make_bigint (&vals[idx], n_produced);
+      idx++;
+
+      /* Versions_vacuumed */
+      db_make_bigint (&vals[idx], n_vacuumed);
+      idx++;
+
+      /* Records_removed */
+      db_make_bigint (&vals[idx], stats->n_removed.load ());
+      idx++;
+
+      /* Versions_cleaned */
+      db_make_bigint (&vals[idx], stats->n_cleaned.load ());
+      idx++;
+
+      /* Pending_versions; counters are not persistent, so this is only an estimate after a restart */
+      db_make_bigint (&vals[idx], n_produced > n_vacuumed ? n_produced - n_vacuumed : 0);
+      idx++;
+
+      assert (idx == num_cols);
+    }
+
+  *ptr = ctx;
+  return NO_ERROR;
+
+exit_on_error:
+  showstmt_free_array_context (thread_p, ctx);
+  return error;
+}
+
+/*
+ * vacuum_threads_start_scan () - Start scan function for SHOW VACUUM THREADS.
+ *
+ * return	   : Error code.
+ * thread_p (in)   : Thread entry.
+ * type (in)	   : Show statement type.
+ * arg_values (in) : Arguments.
+ * arg_cnt (in)	   : Number of arguments.
+ * ptr (out)	   : Array context with one tuple for each vacuum worker.
+ */
+int
+vacuum_threads_start_scan (THREAD_ENTRY * thread_p, int type, DB_VALUE ** arg_values, int arg_cnt, void **ptr)
+{
+  SHOWSTMT_ARRAY_CONTEXT *ctx = NULL;
+  DB_VALUE *vals = NULL;
+  const int num_cols = 7;
+  int idx, i, worker_count;
+  VACUUM_WORKER *worker;
+  int error = NO_ERROR;
+
+  *ptr = NULL;
+
+  worker_count = MIN (prm_get_integer_value (PRM_ID_VACUUM_WORKER_COUNT), VACUUM_MAX_WORKER_COUNT);
+  ctx = showstmt_alloc_array_context (thread_p, worker_count, num_cols);
+  if (ctx == NULL)
+    {
+      ASSERT_ERROR_AND_SET (error);
+      return error;
+    }
+
+  for (i = 0; i < worker_count; i++)
+    {
+      worker = &vacuum_Workers[i];
+
+      idx = 0;
+      vals = showstmt_alloc_tuple_in_context (thread_p, ctx);
+      if (vals == NULL)
+	{
+	  ASSERT_ERROR_AND_SET (error);
+	  showstmt_free_array_context (thread_p, ctx);
+	  return error;
+	}
+
+      /* Worker_index */
+      db_make_int (&vals[idx], i);
+      idx++;
+
+      /* State */
+      db_make_string (&vals[idx], vacuum_worker_state_string (worker->state));
+      idx++;
+
+      /* Jobs */
+      db_make_bigint (&vals[idx], worker->n_jobs);
+      idx++;
+
+      /* Log_pages */
+      db_make_bigint (&vals[idx], worker->n_log_pages);
+      idx++;
+
+      /* Versions_vacuumed */
+      db_make_bigint (&vals[idx], worker->n_versions_vacuumed);
+      idx++;
+
+      /* Records_removed */
+      db_make_bigint (&vals[idx], worker->n_records_removed);
+      idx++;
+
+      /* Versions_cleaned */
+      db_make_bigint (&vals[idx], worker->n_versions_cleaned);
+      idx++;
+
+      assert (idx == num_cols);
+    }
+
+  *ptr = ctx;
+  return NO_ERROR;
+}
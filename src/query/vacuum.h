@@ -127,10 +127,25 @@ struct vacuum_worker
   LOG_PAGEID prefetch_last_pageid;	/* last prefetch log pageid */
 
   bool allocated_resources;
+
+  /* Throughput counters. They are only written by the thread owning the worker. */
+  INT64 n_jobs;			/* Number of vacuum jobs (log blocks) executed. */
+  INT64 n_log_pages;		/* Number of log pages processed by completed jobs. */
+  INT64 n_versions_vacuumed;	/* Number of heap record versions (heap objects) vacuumed. */
+  INT64 n_records_removed;	/* Number of dead heap records removed. */
+  INT64 n_versions_cleaned;	/* Number of heap records whose insert MVCCID or previous version was cleared. */
 };
 
 #define VACUUM_MAX_WORKER_COUNT	  50
 
+/* DML operations that produce heap record versions to be vacuumed (see vacuum_stats_add_dml). */
+typedef enum
+{
+  VACUUM_STATS_DML_INSERT,
+  VACUUM_STATS_DML_UPDATE,
+  VACUUM_STATS_DML_DELETE
+} VACUUM_STATS_DML_OP;
+
 // inline vacuum functions replacing old macros
 STATIC_INLINE VACUUM_WORKER *vacuum_get_vacuum_worker (THREAD_ENTRY * thread_p) __attribute__ ((ALWAYS_INLINE));
 STATIC_INLINE bool vacuum_is_thread_vacuum (const THREAD_ENTRY * thread_p) __attribute__ ((ALWAYS_INLINE));
@@ -278,4 +293,15 @@ extern void vacuum_notify_es_deleted (THREAD_ENTRY * thread_p, const char *uri);
 extern int vacuum_reset_data_after_copydb (THREAD_ENTRY * thread_p);
 
 extern void vacuum_sa_reflect_last_blockid (THREAD_ENTRY * thread_p);
+
+extern void vacuum_stats_add_dml (THREAD_ENTRY * thread_p, const HFID * hfid, const OID * class_oid,
+				  VACUUM_STATS_DML_OP op);
+extern void vacuum_stats_remove_heap (const HFID * hfid);
+extern void vacuum_peek_stats (UINT64 * backlog_blocks, UINT64 * oldest_visible_lag);
+extern int vacuum_status_start_scan (THREAD_ENTRY * thread_p, int type, DB_VALUE ** arg_values, int arg_cnt,
+				     void **ptr);
+extern int vacuum_tables_start_scan (THREAD_ENTRY * thread_p, int type, DB_VALUE ** arg_values, int arg_cnt,
+				     void **ptr);
+extern int vacuum_threads_start_scan (THREAD_ENTRY * thread_p, int type, DB_VALUE ** arg_values, int arg_cnt,
+				      void **ptr);
 #endif /* _VACUUM_H_ */
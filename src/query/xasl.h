@@ -938,6 +938,7 @@ struct access_spec_node
   bool fixed_scan;		/* scan pages are kept fixed? */
   bool pruned;			/* true if partition pruning has been performed */
   bool clear_value_at_clone_decache;	/* true, if need to clear s_dbval at clone decache */
+  SCAN_JOIN_FILTER *join_filter;	/* runtime join filter built from the other input of a merge join */
 #endif				/* #if defined (SERVER_MODE) || defined (SA_MODE) */
 };
 
@@ -4487,6 +4487,22 @@ xts_process_indx_info (char *ptr, const INDX_INFO * indx_info)
 
   ptr = or_pack_int (ptr, indx_info->func_idx_col_id);
 
+  ptr = or_pack_int (ptr, indx_info->bitmap_op);
+
+  if (indx_info->bitmap_next != NULL)
+    {
+      int offset = xts_save_indx_info (indx_info->bitmap_next);
+      if (offset == ER_FAILED)
+	{
+	  return NULL;
+	}
+      ptr = or_pack_int (ptr, offset);
+    }
+  else
+    {
+      ptr = or_pack_int (ptr, 0);
+    }
+
   if (indx_info->use_iss)
     {
       int offset;
@@ -6587,6 +6603,8 @@ xts_sizeof_indx_info (const INDX_INFO * indx_info)
 	   + OR_INT_SIZE	/* use_iss boolean (int) */
 	   + OR_INT_SIZE	/* ils_prefix_len (int) */
 	   + OR_INT_SIZE	/* func_idx_col_id (int) */
+	   + OR_INT_SIZE	/* bitmap_op (int) */
+	   + PTR_SIZE		/* bitmap_next */
 	   + OR_INT_SIZE	/* iss_range's range */
 	   + PTR_SIZE);		/* iss_range's key1 */
 
@@ -51,10 +51,13 @@
 #include "fault_injection.h"
 #include "dbtype.h"
 #include "thread_manager.hpp"
+#include "memory_hash.h"
 
 #include <assert.h>
 #include <algorithm>
 #include <cinttypes>
+#include <limits.h>
+#include <mutex>
 #include <stdlib.h>
 #include <string.h>
 
@@ -348,6 +351,8 @@ struct btree_stats_env
   BTREE_STATS *stat_info;
   int pkeys_val_num;
   DB_VALUE pkeys_val[BTREE_STATS_PKEYS_NUM];	/* partial key-value */
+  INT64 leaf_used_space;	/* used space of the visited leaf pages */
+  int leaf_space_count;		/* number of leaf pages in leaf_used_space */
 };
 
 /* Structure used by btree_range_search to initialize and handle variables
@@ -806,6 +811,78 @@ btree_insert_helper::btree_insert_helper ()
 #define BTREE_INSERT_MVCC_INFO(ins_helper) \
   (&((ins_helper)->obj_info.mvcc_info))
 
+/* BTREE_APPEND_HINT -
+ * Remembers the right-most leaf of an index, as it was left by the last insert that appended a key to it. Inserts of
+ * monotonically increasing keys use it to skip the traversal from root to leaf.
+ *
+ * The hint is validated by the leaf page LSA: any change of the leaf that is not an append done by hinted inserts
+ * (split, merge, delete, deallocation) changes the LSA and invalidates the hint.
+ */
+#define BTREE_APPEND_HINT_COUNT 256
+
+// *INDENT-OFF*
+struct btree_append_hint
+{
+  std::mutex m_mutex;
+  BTID m_btid;			/* Index identifier. */
+  VPID m_leaf_vpid;		/* Right-most leaf. */
+  LOG_LSA m_leaf_lsa;		/* Leaf LSA after the last append. */
+
+  btree_append_hint ();
+};
+
+btree_append_hint::btree_append_hint ()
+  : m_mutex ()
+  , m_btid (BTID_INITIALIZER)
+  , m_leaf_vpid (VPID_INITIALIZER)
+  , m_leaf_lsa (LSA_INITIALIZER)
+{
+}
+
+static btree_append_hint btree_Append_hints[BTREE_APPEND_HINT_COUNT];
+// *INDENT-ON*
+
+#define BTREE_APPEND_HINT_OF(btid) \
+  (&btree_Append_hints[((unsigned int) (btid)->vfid.fileid ^ (unsigned int) (btid)->root_pageid) \
+		       % BTREE_APPEND_HINT_COUNT])
+
+/* Adaptive hash of hot keys: maps the keys that are frequently looked up to their leaf page, so the read-only
+ * descents can go from root directly to leaf. A key is first registered as candidate and its leaf is remembered only
+ * when the key is found again. Each entry counts its hits and a colliding key replaces it only after aging it to zero.
+ * Entries are validated using the leaf LSA, so any change of the leaf (including split and merge) invalidates them. */
+#define BTREE_ADAPTIVE_HASH_COUNT 8192
+#define BTREE_ADAPTIVE_HASH_MAX_HITS 16
+
+// *INDENT-OFF*
+struct btree_adaptive_hash_entry
+{
+  std::mutex m_mutex;
+  BTID m_btid;			/* Index identifier. */
+  unsigned int m_key_hash;	/* Hash of key. */
+  VPID m_leaf_vpid;		/* Leaf of key. Null if key is only a candidate. */
+  LOG_LSA m_leaf_lsa;		/* Leaf LSA when key was found in it. */
+  int m_hits;			/* Hits since leaf was remembered, bounded by BTREE_ADAPTIVE_HASH_MAX_HITS. */
+
+  btree_adaptive_hash_entry ();
+};
+
+btree_adaptive_hash_entry::btree_adaptive_hash_entry ()
+  : m_mutex ()
+  , m_btid (BTID_INITIALIZER)
+  , m_key_hash (0)
+  , m_leaf_vpid (VPID_INITIALIZER)
+  , m_leaf_lsa (LSA_INITIALIZER)
+  , m_hits (0)
+{
+}
+
+static btree_adaptive_hash_entry btree_Adaptive_hash[BTREE_ADAPTIVE_HASH_COUNT];
+// *INDENT-ON*
+
+#define BTREE_ADAPTIVE_HASH_OF(btid, key_hash) \
+  (&btree_Adaptive_hash[((unsigned int) (btid)->vfid.fileid ^ (unsigned int) (btid)->root_pageid ^ (key_hash)) \
+			% BTREE_ADAPTIVE_HASH_COUNT])
+
 /* BTREE_DELETE_HELPER -
  * Structure used inside btree_delete_internal functions to group required
  * data into one argument.
@@ -1306,6 +1383,11 @@ static int btree_get_stats_midxkey (THREAD_ENTRY * thread_p, BTREE_STATS_ENV * e
 static int btree_get_stats_key (THREAD_ENTRY * thread_p, BTREE_STATS_ENV * env, MVCC_SNAPSHOT * mvcc_snapshot);
 static int btree_get_stats_with_AR_sampling (THREAD_ENTRY * thread_p, BTREE_STATS_ENV * env);
 static int btree_get_stats_with_fullscan (THREAD_ENTRY * thread_p, BTREE_STATS_ENV * env);
+static int btree_compact_child_vpid (THREAD_ENTRY * thread_p, PAGE_PTR page, INT16 slotid, VPID * child_vpid);
+static int btree_compact_first_key (THREAD_ENTRY * thread_p, BTID_INT * btid_int, PAGE_PTR leaf, DB_VALUE * key,
+				    bool * found);
+static int btree_compact_leaves (THREAD_ENTRY * thread_p, BTID_INT * btid_int, PAGE_PTR parent, bool is_root,
+				 INT16 slotid, int min_free, VPID * next_leaf_vpid, int *merged);
 static DISK_ISVALID btree_check_page_key (THREAD_ENTRY * thread_p, const OID * class_oid_p, BTID_INT * btid,
 					  const char *btname, PAGE_PTR page_ptr, VPID * page_vpid);
 static DISK_ISVALID btree_check_pages (THREAD_ENTRY * thread_p, BTID_INT * btid, PAGE_PTR pg_ptr, VPID * pg_vpid);
@@ -1336,6 +1418,8 @@ static PAGE_PTR btree_find_rightmost_leaf (THREAD_ENTRY * thread_p, BTID * btid,
 					   BTREE_STATS * stat_info_p);
 static PAGE_PTR btree_find_AR_sampling_leaf (THREAD_ENTRY * thread_p, BTID * btid, VPID * pg_vpid,
 					     BTREE_STATS * stat_info_p, bool * found_p);
+static int btree_range_separators_reserve (THREAD_ENTRY * thread_p, VPID ** vpids, DB_VALUE ** bounds, int *capacity,
+					   int count);
 static PAGE_PTR btree_find_boundary_leaf (THREAD_ENTRY * thread_p, BTID * btid, VPID * pg_vpid, BTREE_STATS * stat_info,
 					  BTREE_BOUNDARY where);
 static int btree_find_next_index_record (THREAD_ENTRY * thread_p, BTREE_SCAN * bts);
@@ -1546,6 +1630,7 @@ static int btree_range_scan_descending_fix_prev_leaf (THREAD_ENTRY * thread_p, B
 						      BTREE_NODE_HEADER ** node_header_ptr, VPID * next_vpid);
 static int btree_range_scan_start (THREAD_ENTRY * thread_p, BTREE_SCAN * bts);
 static int btree_range_scan_resume (THREAD_ENTRY * thread_p, BTREE_SCAN * bts);
+static int btree_range_scan_locate_key_in_probe_leaf (THREAD_ENTRY * thread_p, BTREE_SCAN * bts, bool * found);
 static int btree_range_scan_count_oids_leaf_and_one_ovf (THREAD_ENTRY * thread_p, BTREE_SCAN * bts);
 static int btree_scan_update_range (THREAD_ENTRY * thread_p, BTREE_SCAN * bts, key_val_range * kv_range);
 static int btree_ils_adjust_range (THREAD_ENTRY * thread_p, BTREE_SCAN * bts);
@@ -1560,7 +1645,8 @@ static int btree_fk_object_does_exist (THREAD_ENTRY * thread_p, BTID_INT * btid_
 
 static int btree_insert_internal (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID * class_oid, OID * oid,
 				  int op_type, btree_unique_stats * unique_stat_info, int *unique,
-				  BTREE_MVCC_INFO * mvcc_info, LOG_LSA * undo_nxlsa, BTREE_OP_PURPOSE purpose);
+				  BTREE_MVCC_INFO * mvcc_info, LOG_LSA * undo_nxlsa, BTREE_OP_PURPOSE purpose,
+				  btree_insert_list * insert_list);
 static int btree_undo_delete_physical (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID * class_oid, OID * oid,
 				       BTREE_MVCC_INFO * mvcc_info, LOG_LSA * undo_nxlsa);
 static int btree_fix_root_for_insert (THREAD_ENTRY * thread_p, BTID * btid, BTID_INT * btid_int, DB_VALUE * key,
@@ -1570,12 +1656,30 @@ static int btree_split_node_and_advance (THREAD_ENTRY * thread_p, BTID_INT * bti
 					 PAGE_PTR * crt_page, PAGE_PTR * advance_to_page, bool * is_leaf,
 					 BTREE_SEARCH_KEY_HELPER * search_key, bool * stop, bool * restart,
 					 void *other_args);
+static void btree_append_hint_remember (THREAD_ENTRY * thread_p, const BTID * btid, PAGE_PTR leaf_page);
+static void btree_append_hint_forget (const BTID * btid, const VPID * leaf_vpid, const LOG_LSA * leaf_lsa);
+static int btree_insert_advance_with_append_hint (THREAD_ENTRY * thread_p, BTID_INT * btid_int, DB_VALUE * key,
+						  PAGE_PTR * crt_page, bool * is_leaf,
+						  BTREE_SEARCH_KEY_HELPER * search_key,
+						  BTREE_INSERT_HELPER * insert_helper);
+static int btree_adaptive_hash_probe (THREAD_ENTRY * thread_p, BTID_INT * btid_int, DB_VALUE * key,
+				      unsigned int key_hash, PAGE_PTR * crt_page, bool * is_leaf,
+				      BTREE_SEARCH_KEY_HELPER * search_key);
+static void btree_adaptive_hash_learn (const BTID * btid, unsigned int key_hash, PAGE_PTR leaf_page);
+static void btree_adaptive_hash_forget (const BTID * btid, unsigned int key_hash, const VPID * leaf_vpid,
+					const LOG_LSA * leaf_lsa);
 static int btree_get_max_new_data_size (THREAD_ENTRY * thread_p, BTID_INT * btid_int, PAGE_PTR page,
 					BTREE_NODE_TYPE node_type, int key_len, BTREE_INSERT_HELPER * helper,
 					bool known_to_be_found);
 static int btree_key_insert_new_object (THREAD_ENTRY * thread_p, BTID_INT * btid_int, DB_VALUE * key,
 					PAGE_PTR * leaf_page, BTREE_SEARCH_KEY_HELPER * search_key, bool * restart,
 					void *other_args);
+static int btree_key_insert_new_object_list (THREAD_ENTRY * thread_p, BTID_INT * btid_int, DB_VALUE * key,
+					     PAGE_PTR * leaf_page, BTREE_SEARCH_KEY_HELPER * search_key,
+					     bool * restart, void *other_args);
+static int btree_insert_list_is_next_key_in_leaf (THREAD_ENTRY * thread_p, BTID_INT * btid_int,
+						  BTREE_INSERT_HELPER * insert_helper, PAGE_PTR leaf_page,
+						  DB_VALUE * key, BTREE_SEARCH_KEY_HELPER * search_key, bool * in_leaf);
 static int btree_key_online_index_IB_insert_list (THREAD_ENTRY * thread_p, BTID_INT * btid_int, DB_VALUE * key,
 						  PAGE_PTR * leaf_page, BTREE_SEARCH_KEY_HELPER * search_key,
 						  bool * restart, void *other_args);
@@ -1611,11 +1715,9 @@ static int btree_key_append_object_into_ovf (THREAD_ENTRY * thread_p, BTID_INT *
 					     PAGE_PTR leaf, BTREE_SEARCH_KEY_HELPER * search_key, RECDES * leaf_record,
 					     LEAF_REC * leaf_record_info, BTREE_INSERT_HELPER * insert_helper,
 					     BTREE_OBJECT_INFO * append_object);
-#if defined (SERVER_MODE)
 static bool btree_key_insert_does_leaf_need_split (THREAD_ENTRY * thread_p, BTID_INT * btid_int, PAGE_PTR leaf_page,
 						   BTREE_INSERT_HELPER * insert_helper,
 						   BTREE_SEARCH_KEY_HELPER * search_key);
-#endif /* SERVER_MODE */
 #if !defined (NDEBUG)
 static void btree_key_record_check_no_visible (THREAD_ENTRY * thread_p, BTID_INT * btid_int, PAGE_PTR leaf_page,
 					       PGSLOTID slotid);
@@ -6705,6 +6807,9 @@ btree_get_stats_with_AR_sampling (THREAD_ENTRY * thread_p, BTREE_STATS_ENV * env
 	    {
 	      env->stat_info->leafs++;
 
+	      env->leaf_used_space += DB_PAGESIZE - spage_get_free_space (thread_p, BTS->C_page);
+	      env->leaf_space_count++;
+
 	      BTS->slot_id = 1;
 	      BTS->oid_pos = 0;
 
@@ -6840,6 +6945,9 @@ btree_get_stats_with_fullscan (THREAD_ENTRY * thread_p, BTREE_STATS_ENV * env)
 	  VPID_COPY (&C_vpid, &(BTS->C_vpid));	/* keep current leaf vpid */
 
 	  env->stat_info->leafs++;
+
+	  env->leaf_used_space += DB_PAGESIZE - spage_get_free_space (thread_p, BTS->C_page);
+	  env->leaf_space_count++;
 	}
 
       ret = btree_get_stats_key (thread_p, env, mvcc_snapshot);
@@ -6937,7 +7045,7 @@ btree_get_btid_from_file (THREAD_ENTRY * thread_p, const VFID * vfid, BTID * bti
  *   with_fullscan(in): true iff WITH FULLSCAN
  *
  * Note: Computes and returns statistical information about B+tree which consist of the number of leaf pages,
- * total number of pages, number of keys and the height of the tree.
+ * total number of pages, number of keys, the height of the tree and the average fill factor of the leaf pages.
  */
 int
 btree_get_stats (THREAD_ENTRY * thread_p, BTREE_STATS * stat_info_p, bool with_fullscan)
@@ -6983,6 +7091,8 @@ btree_get_stats (THREAD_ENTRY * thread_p, BTREE_STATS * stat_info_p, bool with_f
   env->btree_scan.btid_int.sys_btid = &(stat_info_p->btid);
   env->stat_info = stat_info_p;
   env->pkeys_val_num = stat_info_p->pkeys_size;
+  env->leaf_used_space = 0;
+  env->leaf_space_count = 0;
 
   assert (env->pkeys_val_num <= BTREE_STATS_PKEYS_NUM);
   for (i = 0; i < env->pkeys_val_num; i++)
@@ -7050,6 +7160,7 @@ btree_get_stats (THREAD_ENTRY * thread_p, BTREE_STATS * stat_info_p, bool with_f
   env->stat_info->leafs = 0;
   env->stat_info->height = 0;
   env->stat_info->keys = 0;
+  env->stat_info->fill_factor = 0;
 
   for (i = 0; i < env->pkeys_val_num; i++)
     {
@@ -7110,6 +7221,12 @@ btree_get_stats (THREAD_ENTRY * thread_p, BTREE_STATS * stat_info_p, bool with_f
   env->stat_info->leafs = MAX (1, env->stat_info->leafs);
   env->stat_info->leafs = MIN (env->stat_info->leafs, npages - (env->stat_info->height - 1));
 
+  /* average fill of the visited (or sampled) leaf pages */
+  if (env->leaf_space_count > 0)
+    {
+      env->stat_info->fill_factor = (int) (env->leaf_used_space * 100 / ((INT64) env->leaf_space_count * DB_PAGESIZE));
+    }
+
   assert_release (env->stat_info->pages >= 1);
   assert_release (env->stat_info->leafs >= 1);
   assert_release (env->stat_info->height >= 1);
@@ -7139,6 +7256,454 @@ exit_on_error:
   goto end;
 }
 
+/*
+ * btree_compact_child_vpid () - Get the child page pointed by a slot of a non-leaf node.
+ *
+ * return	     : Error code.
+ * thread_p (in)     : Thread entry.
+ * page (in)	     : Non-leaf node.
+ * slotid (in)	     : Slot of the child.
+ * child_vpid (out)  : Child page identifier.
+ */
+static int
+btree_compact_child_vpid (THREAD_ENTRY * thread_p, PAGE_PTR page, INT16 slotid, VPID * child_vpid)
+{
+  RECDES rec;
+  NON_LEAF_REC non_leaf_rec;
+
+  if (spage_get_record (thread_p, page, slotid, &rec, PEEK) != S_SUCCESS)
+    {
+      assert_release (false);
+      return ER_FAILED;
+    }
+  btree_read_fixed_portion_of_non_leaf_record (&rec, &non_leaf_rec);
+  *child_vpid = non_leaf_rec.pnt;
+
+  return NO_ERROR;
+}
+
+/*
+ * btree_compact_first_key () - Copy the first key of a leaf that is not a fence key.
+ *
+ * return	      : Error code.
+ * thread_p (in)      : Thread entry.
+ * btid_int (in)      : B-tree info.
+ * leaf (in)	      : Leaf node.
+ * key (out)	      : Copy of the key.
+ * found (out)	      : False if the leaf has only fence keys.
+ */
+static int
+btree_compact_first_key (THREAD_ENTRY * thread_p, BTID_INT * btid_int, PAGE_PTR leaf, DB_VALUE * key, bool * found)
+{
+  RECDES rec;
+  LEAF_REC leaf_rec;
+  bool clear_key = false;
+  int offset;
+  int key_cnt, slotid;
+  int error_code;
+
+  *found = false;
+
+  key_cnt = btree_node_number_of_keys (thread_p, leaf);
+  for (slotid = 1; slotid <= key_cnt; slotid++)
+    {
+      if (btree_is_fence_key (leaf, slotid))
+	{
+	  continue;
+	}
+      if (spage_get_record (thread_p, leaf, slotid, &rec, PEEK) != S_SUCCESS)
+	{
+	  assert_release (false);
+	  return ER_FAILED;
+	}
+      error_code =
+	btree_read_record (thread_p, btid_int, leaf, &rec, key, &leaf_rec, BTREE_LEAF_NODE, &clear_key, &offset,
+			   COPY_KEY_VALUE, NULL);
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  return error_code;
+	}
+      *found = true;
+      break;
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * btree_compact_leaves () - Merge adjacent leaves of one level 2 node while their content fits one page.
+ *
+ * return	       : Error code.
+ * thread_p (in)       : Thread entry.
+ * btid_int (in)       : B-tree info.
+ * parent (in)	       : Write latched level 2 node.
+ * is_root (in)	       : True if parent is the root.
+ * slotid (in)	       : Slot of the first child to consider.
+ * min_free (in)       : Space that must remain free in a merged leaf.
+ * next_leaf_vpid (out) : Leaf that follows the last child of parent.
+ * merged (in/out)     : Incremented with the number of merged leaves.
+ *
+ * Note: Merges are executed the same way as in b-tree delete, each as a system operation that deallocates the right
+ *	 leaf. Unlike delete, which only merges almost empty nodes, two leaves are merged whenever the result still
+ *	 keeps min_free space for future inserts.
+ */
+static int
+btree_compact_leaves (THREAD_ENTRY * thread_p, BTID_INT * btid_int, PAGE_PTR parent, bool is_root, INT16 slotid,
+		      int min_free, VPID * next_leaf_vpid, int *merged)
+{
+  PAGE_PTR left_page = NULL;
+  PAGE_PTR right_page = NULL;
+  VPID left_vpid, right_vpid, child_vpid;
+  BTREE_NODE_HEADER *header = NULL;
+  int key_cnt, left_used, right_used;
+  bool is_system_op_started = false;
+  int error_code = NO_ERROR;
+
+  VPID_SET_NULL (next_leaf_vpid);
+
+  error_code = btree_compact_child_vpid (thread_p, parent, slotid, &left_vpid);
+  if (error_code != NO_ERROR)
+    {
+      goto error;
+    }
+  left_page = pgbuf_fix (thread_p, &left_vpid, OLD_PAGE, PGBUF_LATCH_WRITE, PGBUF_UNCONDITIONAL_LATCH);
+  if (left_page == NULL)
+    {
+      ASSERT_ERROR_AND_SET (error_code);
+      goto error;
+    }
+
+  key_cnt = btree_node_number_of_keys (thread_p, parent);
+  while (slotid < key_cnt)
+    {
+      if (is_root && key_cnt <= 2)
+	{
+	  /* merging the last two children of root is left to b-tree delete, which also decreases the height */
+	  break;
+	}
+
+      error_code = btree_compact_child_vpid (thread_p, parent, slotid + 1, &right_vpid);
+      if (error_code != NO_ERROR)
+	{
+	  goto error;
+	}
+      right_page = pgbuf_fix (thread_p, &right_vpid, OLD_PAGE, PGBUF_LATCH_WRITE, PGBUF_UNCONDITIONAL_LATCH);
+      if (right_page == NULL)
+	{
+	  ASSERT_ERROR_AND_SET (error_code);
+	  goto error;
+	}
+
+      left_used = btree_node_size_uncompressed (thread_p, btid_int, left_page);
+      right_used = btree_node_size_uncompressed (thread_p, btid_int, right_page);
+      if (left_used < 0 || right_used < 0)
+	{
+	  ASSERT_ERROR_AND_SET (error_code);
+	  goto error;
+	}
+
+      if (left_used + right_used + min_free >= DB_PAGESIZE)
+	{
+	  /* does not fit; move to next pair */
+	  pgbuf_unfix_and_init (thread_p, left_page);
+	  left_page = right_page;
+	  right_page = NULL;
+	  left_vpid = right_vpid;
+	  slotid++;
+	  continue;
+	}
+
+      log_sysop_start (thread_p);
+      is_system_op_started = true;
+
+      error_code =
+	btree_merge_node (thread_p, btid_int, parent, left_page, right_page, slotid + 1, &child_vpid,
+			  BTREE_MERGE_FORCE);
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  goto error;
+	}
+      assert (VPID_EQ (&child_vpid, &left_vpid));
+
+      pgbuf_unfix_and_init (thread_p, right_page);
+      error_code = file_dealloc (thread_p, &btid_int->sys_btid->vfid, &right_vpid, FILE_BTREE);
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  goto error;
+	}
+
+      log_sysop_commit (thread_p);
+      is_system_op_started = false;
+
+      (*merged)++;
+      key_cnt--;
+      /* keep left page and try to merge it with its new right sibling */
+    }
+
+  header = btree_get_node_header (thread_p, left_page);
+  if (header == NULL)
+    {
+      assert_release (false);
+      error_code = ER_FAILED;
+      goto error;
+    }
+  *next_leaf_vpid = header->next_vpid;
+
+  pgbuf_unfix_and_init (thread_p, left_page);
+
+  return NO_ERROR;
+
+error:
+  assert_release (error_code != NO_ERROR);
+
+  if (is_system_op_started)
+    {
+      /* abort before unfixing pages, so that no other transaction sees partial changes */
+      log_sysop_abort (thread_p);
+    }
+  if (right_page != NULL)
+    {
+      pgbuf_unfix_and_init (thread_p, right_page);
+    }
+  if (left_page != NULL)
+    {
+      pgbuf_unfix_and_init (thread_p, left_page);
+    }
+
+  return error_code;
+}
+
+/*
+ * xbtree_compact_index () - Merge sparse leaves of an index in place.
+ *
+ * return	      : Error code.
+ * thread_p (in)      : Thread entry.
+ * btid (in)	      : B-tree identifier.
+ * merged (out)	      : Number of leaves merged into their left sibling.
+ * fill_before (out)  : Leaf fill factor (percent) before compaction.
+ * fill_after (out)   : Leaf fill factor (percent) after compaction.
+ *
+ * Note: The index stays online. No lock is requested here (the caller holds an intention lock on the class) and
+ *	 only one level 2 node and the leaves below it are write latched at a time, like in b-tree delete. The leaves
+ *	 are visited from left to right; each level 2 node is reached by a new descent from root with the first key of
+ *	 the next leaf, so concurrent splits and merges are always followed.
+ *
+ *	 Leaves are merged while the merged leaf keeps the unfill factor of the index free, so compaction does not
+ *	 cause immediate splits.
+ */
+int
+xbtree_compact_index (THREAD_ENTRY * thread_p, BTID * btid, int *merged, int *fill_before, int *fill_after)
+{
+  BTREE_STATS stat_info;
+  BTID_INT btid_int;
+  BTREE_ROOT_HEADER *root_header = NULL;
+  BTREE_NODE_HEADER *header = NULL;
+  VPID root_vpid, child_vpid, next_leaf_vpid;
+  PAGE_PTR node = NULL;
+  PAGE_PTR child = NULL;
+  PGBUF_LATCH_MODE latch_mode;
+  DB_VALUE resume_key;
+  bool has_resume_key = false;
+  bool found;
+  INT16 slotid;
+  int node_level;
+  int min_free;
+  bool dummy_continue_checking = true;
+  int error_code = NO_ERROR;
+
+  assert (btid != NULL && merged != NULL && fill_before != NULL && fill_after != NULL);
+
+  *merged = 0;
+  *fill_before = *fill_after = 0;
+  db_make_null (&resume_key);
+
+  stat_info.btid = *btid;
+  stat_info.keys = 0;
+  stat_info.pkeys_size = 0;	/* do not request pkeys info */
+  stat_info.pkeys = NULL;
+
+  error_code = btree_get_stats (thread_p, &stat_info, STATS_WITH_SAMPLING);
+  if (error_code != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      return error_code;
+    }
+  *fill_before = stat_info.fill_factor;
+
+  root_vpid.volid = btid->vfid.volid;
+  root_vpid.pageid = btid->root_pageid;
+
+  min_free = (int) MAX (DB_PAGESIZE * prm_get_float_value (PRM_ID_BT_UNFILL_FACTOR), MAX_MERGE_ALIGN_WASTE * 1.3);
+
+  while (true)
+    {
+      if (logtb_is_interrupted (thread_p, true, &dummy_continue_checking))
+	{
+	  error_code = ER_INTERRUPTED;
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, error_code, 0);
+	  goto exit;
+	}
+
+      /* descend to the level 2 node of resume key; the level 2 node is write latched */
+      node = pgbuf_fix (thread_p, &root_vpid, OLD_PAGE, PGBUF_LATCH_READ, PGBUF_UNCONDITIONAL_LATCH);
+      if (node == NULL)
+	{
+	  ASSERT_ERROR_AND_SET (error_code);
+	  goto exit;
+	}
+      root_header = btree_get_root_header (thread_p, node);
+      if (root_header == NULL)
+	{
+	  assert_release (false);
+	  error_code = ER_FAILED;
+	  goto exit;
+	}
+      btid_int.sys_btid = btid;
+      error_code = btree_glean_root_header_info (thread_p, root_header, &btid_int);
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  goto exit;
+	}
+
+      node_level = root_header->node.node_level;
+      if (node_level < 2)
+	{
+	  /* only one leaf */
+	  goto exit;
+	}
+      if (node_level == 2)
+	{
+	  pgbuf_unfix_and_init (thread_p, node);
+	  node = pgbuf_fix (thread_p, &root_vpid, OLD_PAGE, PGBUF_LATCH_WRITE, PGBUF_UNCONDITIONAL_LATCH);
+	  if (node == NULL)
+	    {
+	      ASSERT_ERROR_AND_SET (error_code);
+	      goto exit;
+	    }
+	  header = btree_get_node_header (thread_p, node);
+	  if (header == NULL || header->node_level != 2)
+	    {
+	      /* root changed level while it was not latched; start again */
+	      pgbuf_unfix_and_init (thread_p, node);
+	      continue;
+	    }
+	}
+
+      while (true)
+	{
+	  if (has_resume_key)
+	    {
+	      error_code = btree_search_nonleaf_page (thread_p, &btid_int, node, &resume_key, &slotid, &child_vpid, NULL);
+	      if (error_code != NO_ERROR)
+		{
+		  ASSERT_ERROR ();
+		  goto exit;
+		}
+	    }
+	  else
+	    {
+	      slotid = 1;
+	      error_code = btree_compact_child_vpid (thread_p, node, slotid, &child_vpid);
+	      if (error_code != NO_ERROR)
+		{
+		  goto exit;
+		}
+	    }
+
+	  if (node_level == 2)
+	    {
+	      break;
+	    }
+
+	  latch_mode = (node_level == 3) ? PGBUF_LATCH_WRITE : PGBUF_LATCH_READ;
+	  child = pgbuf_fix (thread_p, &child_vpid, OLD_PAGE, latch_mode, PGBUF_UNCONDITIONAL_LATCH);
+	  if (child == NULL)
+	    {
+	      ASSERT_ERROR_AND_SET (error_code);
+	      goto exit;
+	    }
+	  pgbuf_unfix_and_init (thread_p, node);
+	  node = child;
+	  child = NULL;
+	  node_level--;
+	}
+
+      error_code = btree_compact_leaves (thread_p, &btid_int, node, VPID_EQ (pgbuf_get_vpid_ptr (node), &root_vpid), slotid,
+					 min_free, &next_leaf_vpid, merged);
+      pgbuf_unfix_and_init (thread_p, node);
+      if (error_code != NO_ERROR)
+	{
+	  goto exit;
+	}
+
+      /* find the resume key in the leaves that follow */
+      pr_clear_value (&resume_key);
+      has_resume_key = false;
+      found = false;
+      while (!found && !VPID_ISNULL (&next_leaf_vpid))
+	{
+	  node = pgbuf_fix (thread_p, &next_leaf_vpid, OLD_PAGE_MAYBE_DEALLOCATED, PGBUF_LATCH_READ,
+			    PGBUF_UNCONDITIONAL_LATCH);
+	  if (node == NULL)
+	    {
+	      /* merged meanwhile by someone else; compaction stops here */
+	      er_clear ();
+	      break;
+	    }
+	  header = btree_get_node_header (thread_p, node);
+	  if (header == NULL || header->node_level != 1)
+	    {
+	      pgbuf_unfix_and_init (thread_p, node);
+	      break;
+	    }
+	  error_code = btree_compact_first_key (thread_p, &btid_int, node, &resume_key, &found);
+	  next_leaf_vpid = header->next_vpid;
+	  pgbuf_unfix_and_init (thread_p, node);
+	  if (error_code != NO_ERROR)
+	    {
+	      goto exit;
+	    }
+	}
+      if (!found)
+	{
+	  /* end of index */
+	  break;
+	}
+      has_resume_key = true;
+    }
+
+exit:
+  if (child != NULL)
+    {
+      pgbuf_unfix_and_init (thread_p, child);
+    }
+  if (node != NULL)
+    {
+      pgbuf_unfix_and_init (thread_p, node);
+    }
+  pr_clear_value (&resume_key);
+
+  if (error_code != NO_ERROR)
+    {
+      return error_code;
+    }
+
+  stat_info.keys = 0;
+  error_code = btree_get_stats (thread_p, &stat_info, STATS_WITH_SAMPLING);
+  if (error_code != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      return error_code;
+    }
+  *fill_after = stat_info.fill_factor;
+
+  return NO_ERROR;
+}
+
 /*
  * xbtree_get_key_type () - Obtains index key type.
  *
@@ -11972,6 +12537,17 @@ btree_find_split_point (THREAD_ENTRY * thread_p, BTID_INT * btid, PAGE_PTR page_
   /* Compute mid_size, the desired size of left node according to split info. */
   mid_size = btree_split_find_pivot (tot_rec, &(header->split_info));
 
+  if (node_type == BTREE_LEAF_NODE && VPID_ISNULL (&header->next_vpid) && search_key.result == BTREE_KEY_BIGGER
+      && header->split_info.pivot >= BTREE_SPLIT_UPPER_BOUND)
+    {
+      /* Append pattern: the new key goes after all keys of the right-most leaf, and so did most of the previous
+       * inserts. Splitting in half would leave the left leaf half empty forever. Keep all existing records in the left
+       * leaf and let the new key start a fresh right leaf. Since the new key is known to go right, left leaf doesn't
+       * have to reserve space for it. */
+      left_max_size += new_ent_size;
+      mid_size = tot_rec;
+    }
+
   /* Split records and new entity considering mid_size, left_max_size, and right_max_size. Since we work with left
    * node, translate right_max_size into left_min_size by subtracting from total records size. */
   left_min_size = tot_rec - right_max_size;
@@ -14702,6 +15278,346 @@ error:
   return NULL;
 }
 
+/*
+ * btree_range_separators_reserve () - Make room for count nodes and their bounds in btree_get_range_separators.
+ *
+ * return	    : Error code.
+ * thread_p (in)    : Thread entry.
+ * vpids (in/out)   : Node identifiers.
+ * bounds (in/out)  : Node lower bounds.
+ * capacity (in/out): Number of nodes the arrays can hold.
+ * count (in)	    : Number of nodes needed.
+ */
+static int
+btree_range_separators_reserve (THREAD_ENTRY * thread_p, VPID ** vpids, DB_VALUE ** bounds, int *capacity, int count)
+{
+  int new_capacity;
+  VPID *new_vpids;
+  DB_VALUE *new_bounds;
+
+  if (count <= *capacity)
+    {
+      return NO_ERROR;
+    }
+
+  new_capacity = MAX (count, 2 * (*capacity));
+  new_vpids = (VPID *) db_private_realloc (thread_p, *vpids, new_capacity * sizeof (VPID));
+  if (new_vpids == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, new_capacity * sizeof (VPID));
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+  *vpids = new_vpids;
+
+  new_bounds = (DB_VALUE *) db_private_realloc (thread_p, *bounds, new_capacity * sizeof (DB_VALUE));
+  if (new_bounds == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, new_capacity * sizeof (DB_VALUE));
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+  *bounds = new_bounds;
+  *capacity = new_capacity;
+
+  return NO_ERROR;
+}
+
+/*
+ * btree_get_range_separators () - Get separator keys of non-leaf nodes that split a key range into sub-ranges.
+ *
+ * return	       : Error code.
+ * thread_p (in)       : Thread entry.
+ * btid (in)	       : B-tree identifier.
+ * kv_range (in)       : Key range.
+ * max_separators (in) : Maximum number of separators to return.
+ * separators (out)    : Separators strictly inside the range, in ascending order. Caller must clear them.
+ * n_separators (out)  : Number of separators.
+ * n_leaves (out)      : Estimated number of leaf pages that hold the range.
+ *
+ * Note: Like the AR sampling, the tree is read top-down with read latches, one node at a time. The children that
+ *	 overlap the range are read only while the separators found so far are too few to split the range evenly;
+ *	 the parents of the leaves are the lowest level read. Concurrent splits and merges cannot make a separator
+ *	 wrong, since any ascending list of keys splits the range, but a node that was deallocated or that changed its
+ *	 level ends the descent.
+ */
+int
+btree_get_range_separators (THREAD_ENTRY * thread_p, BTID * btid, key_val_range * kv_range, int max_separators,
+			    DB_VALUE * separators, int *n_separators, int *n_leaves)
+{
+  BTID_INT btid_int;
+  BTREE_ROOT_HEADER *root_header = NULL;
+  BTREE_NODE_HEADER *node_header = NULL;
+  PAGE_PTR page = NULL;
+  VPID root_vpid;
+  /* nodes of the current level and their children that overlap the range, each with its lower bound if the bound is
+   * strictly inside the range, or a null value otherwise */
+  VPID *nodes = NULL, *children = NULL, *vpid_swap;
+  DB_VALUE *node_bounds = NULL, *child_bounds = NULL, *bound_swap;
+  int n_nodes = 0, max_nodes = 0, n_children = 0, max_children = 0, int_swap;
+  int first_node = 0;		/* first node whose children were not read */
+  DB_VALUE *lower_key, *upper_key;
+  DB_VALUE key;
+  NON_LEAF_REC non_leaf_rec;
+  RECDES rec;
+  bool clear_key = false;
+  int level, key_cnt, slotid, offset, i, n_in_range, total_children, picked;
+  double fanout, estimate;
+  int error_code = NO_ERROR;
+
+  assert (kv_range != NULL && separators != NULL && n_separators != NULL && n_leaves != NULL);
+
+  *n_separators = 0;
+  *n_leaves = 1;
+
+  lower_key = (kv_range->range == INF_INF || kv_range->range == INF_LE || kv_range->range == INF_LT
+	       || DB_IS_NULL (&kv_range->key1)) ? NULL : &kv_range->key1;
+  upper_key = (kv_range->range == INF_INF || kv_range->range == GE_INF || kv_range->range == GT_INF
+	       || DB_IS_NULL (&kv_range->key2)) ? NULL : &kv_range->key2;
+
+  page = btree_fix_root_with_info (thread_p, btid, PGBUF_LATCH_READ, &root_vpid, &root_header, &btid_int);
+  if (page == NULL)
+    {
+      ASSERT_ERROR_AND_SET (error_code);
+      return error_code;
+    }
+  level = root_header->node.node_level;
+  pgbuf_unfix_and_init (thread_p, page);
+
+  if (level <= 1 || max_separators <= 0)
+    {
+      /* the tree is a single leaf */
+      return NO_ERROR;
+    }
+
+  error_code = btree_range_separators_reserve (thread_p, &nodes, &node_bounds, &max_nodes, 1);
+  if (error_code != NO_ERROR)
+    {
+      goto end;
+    }
+  nodes[0] = root_vpid;
+  db_make_null (&node_bounds[0]);
+  n_nodes = 1;
+
+  while (level > 1)
+    {
+      total_children = 0;
+
+      for (first_node = 0; first_node < n_nodes; first_node++)
+	{
+	  page = pgbuf_fix (thread_p, &nodes[first_node], OLD_PAGE_MAYBE_DEALLOCATED, PGBUF_LATCH_READ,
+			    PGBUF_UNCONDITIONAL_LATCH);
+	  if (page == NULL)
+	    {
+	      if (er_errid () != NO_ERROR)
+		{
+		  ASSERT_ERROR_AND_SET (error_code);
+		  goto end;
+		}
+	      /* deallocated by a merge */
+	      goto collect;
+	    }
+	  (void) pgbuf_check_page_ptype (thread_p, page, PAGE_BTREE);
+	  node_header = btree_get_node_header (thread_p, page);
+	  if (node_header == NULL || node_header->node_level != level)
+	    {
+	      /* changed since its parent was read */
+	      pgbuf_unfix_and_init (thread_p, page);
+	      goto collect;
+	    }
+
+	  key_cnt = btree_node_number_of_keys (thread_p, page);
+	  total_children += key_cnt;
+
+	  error_code = btree_range_separators_reserve (thread_p, &children, &child_bounds, &max_children,
+						       n_children + key_cnt);
+	  if (error_code != NO_ERROR)
+	    {
+	      pgbuf_unfix_and_init (thread_p, page);
+	      goto end;
+	    }
+
+	  for (slotid = 1; slotid <= key_cnt; slotid++)
+	    {
+	      if (spage_get_record (thread_p, page, slotid, &rec, PEEK) != S_SUCCESS)
+		{
+		  assert_release (false);
+		  pgbuf_unfix_and_init (thread_p, page);
+		  error_code = ER_FAILED;
+		  goto end;
+		}
+
+	      if (slotid == 1)
+		{
+		  /* the key of the first record is a dummy; the leftmost child inherits the bound of its parent */
+		  btree_read_fixed_portion_of_non_leaf_record (&rec, &non_leaf_rec);
+		  children[n_children] = non_leaf_rec.pnt;
+		  child_bounds[n_children] = node_bounds[first_node];
+		  db_make_null (&node_bounds[first_node]);
+		  n_children++;
+		  continue;
+		}
+
+	      btree_init_temp_key_value (&clear_key, &key);
+	      error_code =
+		btree_read_record (thread_p, &btid_int, page, &rec, &key, &non_leaf_rec, BTREE_NON_LEAF_NODE, &clear_key,
+				   &offset, PEEK_KEY_VALUE, NULL);
+	      if (error_code != NO_ERROR)
+		{
+		  ASSERT_ERROR ();
+		  pgbuf_unfix_and_init (thread_p, page);
+		  goto end;
+		}
+
+	      if (lower_key != NULL && btree_compare_key (&key, lower_key, btid_int.key_type, 1, 1, NULL) != DB_GT)
+		{
+		  /* the previous child holds only keys below the range */
+		  n_children--;
+		  pr_clear_value (&child_bounds[n_children]);
+		}
+	      else if (upper_key != NULL
+		       && btree_compare_key (&key, upper_key, btid_int.key_type, 1, 1, NULL) != DB_LT)
+		{
+		  /* the next children hold only keys that are not inside the range */
+		  btree_clear_key_value (&clear_key, &key);
+		  pgbuf_unfix_and_init (thread_p, page);
+		  first_node = n_nodes;
+		  break;
+		}
+
+	      children[n_children] = non_leaf_rec.pnt;
+	      if (lower_key != NULL && btree_compare_key (&key, lower_key, btid_int.key_type, 1, 1, NULL) != DB_GT)
+		{
+		  db_make_null (&child_bounds[n_children]);
+		}
+	      else
+		{
+		  (void) pr_clone_value (&key, &child_bounds[n_children]);
+		}
+	      btree_clear_key_value (&clear_key, &key);
+	      n_children++;
+	    }
+
+	  if (page != NULL)
+	    {
+	      pgbuf_unfix_and_init (thread_p, page);
+	    }
+	}
+
+      /* the children are the nodes of the next level */
+      for (i = 0; i < n_nodes; i++)
+	{
+	  pr_clear_value (&node_bounds[i]);
+	}
+      vpid_swap = nodes;
+      nodes = children;
+      children = vpid_swap;
+      bound_swap = node_bounds;
+      node_bounds = child_bounds;
+      child_bounds = bound_swap;
+      int_swap = max_nodes;
+      max_nodes = max_children;
+      max_children = int_swap;
+      fanout = (double) total_children / (double) n_nodes;
+      n_nodes = n_children;
+      n_children = 0;
+      first_node = 0;
+      level--;
+
+      /* each node of the new level has about fanout ^ (level - 1) leaves */
+      estimate = (double) n_nodes;
+      for (i = level; i > 1; i--)
+	{
+	  estimate *= fanout;
+	}
+      *n_leaves = (int) MIN (estimate, (double) INT_MAX);
+
+      n_in_range = 0;
+      for (i = 0; i < n_nodes; i++)
+	{
+	  if (!DB_IS_NULL (&node_bounds[i]))
+	    {
+	      n_in_range++;
+	    }
+	}
+      if (n_in_range >= 4 * max_separators)
+	{
+	  /* enough to split the range evenly */
+	  break;
+	}
+    }
+
+collect:
+  /* the bounds in key order: the children read so far, then the nodes whose children were not read */
+  n_in_range = 0;
+  for (i = 0; i < n_children; i++)
+    {
+      n_in_range += DB_IS_NULL (&child_bounds[i]) ? 0 : 1;
+    }
+  for (i = first_node; i < n_nodes; i++)
+    {
+      n_in_range += DB_IS_NULL (&node_bounds[i]) ? 0 : 1;
+    }
+
+  picked = 0;
+  for (i = 0; i < n_children + n_nodes - first_node; i++)
+    {
+      DB_VALUE *bound = (i < n_children) ? &child_bounds[i] : &node_bounds[first_node + i - n_children];
+
+      if (DB_IS_NULL (bound))
+	{
+	  continue;
+	}
+      /* when there are too many, pick the bounds evenly spread over the range */
+      if (*n_separators < max_separators
+	  && (n_in_range <= max_separators
+	      || picked >= (INT64) (*n_separators + 1) * n_in_range / (max_separators + 1))
+	  && (*n_separators == 0
+	      || btree_compare_key (&separators[*n_separators - 1], bound, btid_int.key_type, 1, 1, NULL) == DB_LT))
+	{
+	  /* move the value */
+	  separators[*n_separators] = *bound;
+	  db_make_null (bound);
+	  (*n_separators)++;
+	}
+      picked++;
+    }
+
+end:
+  for (i = 0; i < n_children; i++)
+    {
+      pr_clear_value (&child_bounds[i]);
+    }
+  for (i = 0; i < n_nodes; i++)
+    {
+      pr_clear_value (&node_bounds[i]);
+    }
+  if (nodes != NULL)
+    {
+      db_private_free (thread_p, nodes);
+    }
+  if (node_bounds != NULL)
+    {
+      db_private_free (thread_p, node_bounds);
+    }
+  if (children != NULL)
+    {
+      db_private_free (thread_p, children);
+    }
+  if (child_bounds != NULL)
+    {
+      db_private_free (thread_p, child_bounds);
+    }
+
+  if (error_code != NO_ERROR)
+    {
+      for (i = 0; i < *n_separators; i++)
+	{
+	  pr_clear_value (&separators[i]);
+	}
+      *n_separators = 0;
+    }
+  return error_code;
+}
+
 /*
  * btree_keyval_search () -
  *   return: the number of object identifiers in the set pointed
@@ -22478,6 +23394,8 @@ btree_search_key_and_apply_functions (THREAD_ENTRY * thread_p, BTID * btid, BTID
   bool is_leaf = false;		/* Set to true if crt_page is a leaf node. */
   bool stop = false;		/* Set to true to stop advancing in b-tree. */
   bool restart = false;		/* Set to true to restart b-tree traversal from root. */
+  bool learn_leaf = false;	/* Set to true to remember leaf of key in adaptive hash. */
+  unsigned int key_hash = 0;	/* Hash of key for adaptive hash. */
   BTREE_SEARCH_KEY_HELPER local_search_key;	/* Store search key result if search key pointer argument is NULL. */
 
   /* Assert expected arguments. */
@@ -22513,6 +23431,7 @@ start_btree_traversal:
   /* Reset restart flag. */
   restart = false;
   is_leaf = false;
+  learn_leaf = false;
   search_key->result = BTREE_KEY_NOTFOUND;
   search_key->slotid = NULL_SLOTID;
 
@@ -22550,6 +23469,20 @@ start_btree_traversal:
   /* Root page must be fixed. */
   assert (crt_page != NULL);
 
+  if (!is_leaf && root_function == btree_get_root_with_key && advance_function == btree_advance_and_find_key
+      && prm_get_bool_value (PRM_ID_BTREE_ADAPTIVE_HASH))
+    {
+      /* Read-only descent. Go directly to leaf if key is hot. */
+      key_hash = mht_valhash (key, UINT_MAX);
+      error_code = btree_adaptive_hash_probe (thread_p, btid_int, key, key_hash, &crt_page, &is_leaf, search_key);
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  goto error;
+	}
+      learn_leaf = !is_leaf;
+    }
+
   /* Advance until leaf page is found. */
   while (!is_leaf)
     {
@@ -22599,6 +23532,11 @@ start_btree_traversal:
   assert (btree_get_node_header (thread_p, crt_page) != NULL
 	  && btree_get_node_header (thread_p, crt_page)->node_level == 1);
 
+  if (learn_leaf && search_key->result == BTREE_KEY_FOUND)
+    {
+      btree_adaptive_hash_learn (btid, key_hash, crt_page);
+    }
+
   if (key_function != NULL)
     {
       /* Call key_function. */
@@ -22799,6 +23737,167 @@ btree_advance_and_find_key (THREAD_ENTRY * thread_p, BTID_INT * btid_int, DB_VAL
   return NO_ERROR;
 }
 
+/*
+ * btree_adaptive_hash_probe () - Try to advance from root directly to the leaf of key, using the adaptive hash.
+ *
+ * return	     : Error code.
+ * thread_p (in)     : Thread entry.
+ * btid_int (in)     : B-tree info.
+ * key (in)	     : Search key.
+ * key_hash (in)     : Hash of search key.
+ * crt_page (in/out) : Root page as input. If hash is used, root is unfixed and leaf of key is output instead.
+ * is_leaf (out)     : Output true if hash is used.
+ * search_key (out)  : Key search result in leaf (if hash is used).
+ *
+ * NOTE: The hash is used only if the leaf was not changed since the key was found in it and if the key is still
+ *	 found in the leaf.
+ */
+static int
+btree_adaptive_hash_probe (THREAD_ENTRY * thread_p, BTID_INT * btid_int, DB_VALUE * key, unsigned int key_hash,
+			   PAGE_PTR * crt_page, bool * is_leaf, BTREE_SEARCH_KEY_HELPER * search_key)
+{
+  btree_adaptive_hash_entry *entry = BTREE_ADAPTIVE_HASH_OF (btid_int->sys_btid, key_hash);
+  VPID leaf_vpid = VPID_INITIALIZER;
+  LOG_LSA leaf_lsa = LSA_INITIALIZER;
+  PAGE_PTR leaf_page = NULL;
+  BTREE_NODE_HEADER *node_header = NULL;
+  BTREE_SEARCH_KEY_HELPER leaf_search_key = BTREE_SEARCH_KEY_HELPER_INITIALIZER;
+  int error_code = NO_ERROR;
+
+  assert (crt_page != NULL && *crt_page != NULL);
+
+  *is_leaf = false;
+
+  entry->m_mutex.lock ();
+  if (BTID_IS_EQUAL (&entry->m_btid, btid_int->sys_btid) && entry->m_key_hash == key_hash)
+    {
+      VPID_COPY (&leaf_vpid, &entry->m_leaf_vpid);
+      LSA_COPY (&leaf_lsa, &entry->m_leaf_lsa);
+    }
+  entry->m_mutex.unlock ();
+
+  if (VPID_ISNULL (&leaf_vpid))
+    {
+      /* Key is not hot. */
+      return NO_ERROR;
+    }
+
+  /* Root is still fixed, so the latch order is the same as for regular traversal. Do not wait for the leaf or read it
+   * from disk. */
+  leaf_page = pgbuf_fix (thread_p, &leaf_vpid, OLD_PAGE_IF_IN_BUFFER, PGBUF_LATCH_READ, PGBUF_CONDITIONAL_LATCH);
+  if (leaf_page == NULL)
+    {
+      return NO_ERROR;
+    }
+
+  if (pgbuf_get_page_ptype (thread_p, leaf_page) != PAGE_BTREE || !LSA_EQ (pgbuf_get_lsa (leaf_page), &leaf_lsa))
+    {
+      /* Leaf was changed since key was found in it. */
+      goto forget_leaf;
+    }
+  node_header = btree_get_node_header (thread_p, leaf_page);
+  if (node_header == NULL || node_header->node_level != 1)
+    {
+      goto forget_leaf;
+    }
+
+  error_code = btree_search_leaf_page (thread_p, btid_int, leaf_page, key, &leaf_search_key);
+  if (error_code != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      pgbuf_unfix_and_init (thread_p, leaf_page);
+      return error_code;
+    }
+  if (leaf_search_key.result != BTREE_KEY_FOUND)
+    {
+      /* Hash collision. */
+      goto forget_leaf;
+    }
+
+  /* Leaf can be used. */
+  pgbuf_unfix_and_init (thread_p, *crt_page);
+  *crt_page = leaf_page;
+  *search_key = leaf_search_key;
+  *is_leaf = true;
+
+  entry->m_mutex.lock ();
+  if (BTID_IS_EQUAL (&entry->m_btid, btid_int->sys_btid) && entry->m_key_hash == key_hash
+      && entry->m_hits < BTREE_ADAPTIVE_HASH_MAX_HITS)
+    {
+      entry->m_hits++;
+    }
+  entry->m_mutex.unlock ();
+
+  return NO_ERROR;
+
+forget_leaf:
+  pgbuf_unfix_and_init (thread_p, leaf_page);
+  btree_adaptive_hash_forget (btid_int->sys_btid, key_hash, &leaf_vpid, &leaf_lsa);
+  return NO_ERROR;
+}
+
+/*
+ * btree_adaptive_hash_learn () - Register key found by a regular descent in adaptive hash.
+ *
+ * return	  : Void.
+ * btid (in)	  : B-tree identifier.
+ * key_hash (in)  : Hash of key.
+ * leaf_page (in) : Leaf page where key was found.
+ */
+static void
+btree_adaptive_hash_learn (const BTID * btid, unsigned int key_hash, PAGE_PTR leaf_page)
+{
+  btree_adaptive_hash_entry *entry = BTREE_ADAPTIVE_HASH_OF (btid, key_hash);
+
+  entry->m_mutex.lock ();
+  if (BTID_IS_EQUAL (&entry->m_btid, btid) && entry->m_key_hash == key_hash)
+    {
+      /* Key was looked up before. Remember (or refresh) its leaf. */
+      VPID_COPY (&entry->m_leaf_vpid, pgbuf_get_vpid_ptr (leaf_page));
+      LSA_COPY (&entry->m_leaf_lsa, pgbuf_get_lsa (leaf_page));
+    }
+  else if (entry->m_hits > 0)
+    {
+      /* Entry belongs to another key that is hot. Age it. */
+      entry->m_hits--;
+    }
+  else
+    {
+      /* Replace entry with the new candidate key. */
+      BTID_COPY (&entry->m_btid, btid);
+      entry->m_key_hash = key_hash;
+      VPID_SET_NULL (&entry->m_leaf_vpid);
+      LSA_SET_NULL (&entry->m_leaf_lsa);
+    }
+  entry->m_mutex.unlock ();
+}
+
+/*
+ * btree_adaptive_hash_forget () - Forget leaf of key if adaptive hash still points to the given leaf version. The key
+ *				   remains a candidate.
+ *
+ * return	  : Void.
+ * btid (in)	  : B-tree identifier.
+ * key_hash (in)  : Hash of key.
+ * leaf_vpid (in) : Leaf VPID.
+ * leaf_lsa (in)  : Leaf LSA.
+ */
+static void
+btree_adaptive_hash_forget (const BTID * btid, unsigned int key_hash, const VPID * leaf_vpid, const LOG_LSA * leaf_lsa)
+{
+  btree_adaptive_hash_entry *entry = BTREE_ADAPTIVE_HASH_OF (btid, key_hash);
+
+  entry->m_mutex.lock ();
+  if (BTID_IS_EQUAL (&entry->m_btid, btid) && entry->m_key_hash == key_hash
+      && VPID_EQ (&entry->m_leaf_vpid, leaf_vpid) && LSA_EQ (&entry->m_leaf_lsa, leaf_lsa))
+    {
+      VPID_SET_NULL (&entry->m_leaf_vpid);
+      LSA_SET_NULL (&entry->m_leaf_lsa);
+      entry->m_hits = 0;
+    }
+  entry->m_mutex.unlock ();
+}
+
 /*
  * btree_key_find_unique_version_oid () - Find the visible object version from key. Since the index is unique,
  *					  there must be at most one visible version.
@@ -24210,15 +25309,25 @@ btree_range_scan_start (THREAD_ENTRY * thread_p, BTREE_SCAN * bts)
     }
   else
     {
-      /* Has lower limit. Try to locate the key. */
-      error_code =
-	btree_locate_key (thread_p, &bts->btid_int, bts->key_range.lower_key, &bts->C_vpid, &bts->slot_id,
-			  &bts->C_page, &found);
+      /* Has lower limit. Try the leaf where the previous range of this scan ended first. */
+      error_code = btree_range_scan_locate_key_in_probe_leaf (thread_p, bts, &found);
       if (error_code != NO_ERROR)
 	{
 	  ASSERT_ERROR ();
 	  return error_code;
 	}
+      if (bts->C_page == NULL)
+	{
+	  /* Locate the key from root. */
+	  error_code =
+	    btree_locate_key (thread_p, &bts->btid_int, bts->key_range.lower_key, &bts->C_vpid, &bts->slot_id,
+			      &bts->C_page, &found);
+	  if (error_code != NO_ERROR)
+	    {
+	      ASSERT_ERROR ();
+	      return error_code;
+	    }
+	}
       if (!found && bts->use_desc_index)
 	{
 	  /* Key was not found and the bts->slot_id was positioned to next key bigger than bts->key_range.lower_key.
@@ -24419,6 +25528,118 @@ btree_range_scan_resume (THREAD_ENTRY * thread_p, BTREE_SCAN * bts)
   return btree_range_scan_advance_over_filtered_keys (thread_p, bts);
 }
 
+/*
+ * btree_range_scan_locate_key_in_probe_leaf () - Locate the lower limit of a new range in the leaf node where the
+ *						   previous range of the same scan ended, or in its right sibling.
+ *
+ * return	 : Error code.
+ * thread_p (in) : Thread entry.
+ * bts (in/out)	 : B-tree scan. If key can be located, bts->C_page, bts->C_vpid and bts->slot_id are set like
+ *		   btree_locate_key does. Otherwise, bts->C_page is left NULL and key must be located from root.
+ * found (out)	 : Output true if key was found.
+ *
+ * NOTE: Key lists are sorted before they are scanned and consecutive rows of an index join often look for close
+ *	 keys. Reusing last leaf node saves the descent from root for each key that falls in the same or in next leaf.
+ */
+static int
+btree_range_scan_locate_key_in_probe_leaf (THREAD_ENTRY * thread_p, BTREE_SCAN * bts, bool * found)
+{
+  int error_code = NO_ERROR;
+  BTREE_SEARCH_KEY_HELPER search_key = BTREE_SEARCH_KEY_HELPER_INITIALIZER;
+  BTREE_NODE_HEADER *header = NULL;
+  VPID vpid;
+  int hop;
+
+  assert (bts != NULL);
+  assert (bts->C_page == NULL);
+  assert (bts->key_range.lower_key != NULL);
+  assert (found != NULL);
+
+  *found = false;
+
+  if (VPID_ISNULL (&bts->probe_vpid) || bts->use_desc_index || BTS_IS_INDEX_ILS (bts))
+    {
+      /* Nothing to reuse. */
+      return NO_ERROR;
+    }
+
+  vpid = bts->probe_vpid;
+  VPID_SET_NULL (&bts->probe_vpid);
+
+  for (hop = 0; hop < 2; hop++)
+    {
+      error_code =
+	pgbuf_fix_if_not_deallocated (thread_p, &vpid, PGBUF_LATCH_READ, PGBUF_UNCONDITIONAL_LATCH, &bts->C_page);
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  return error_code;
+	}
+      if (bts->C_page == NULL)
+	{
+	  /* Page was deallocated. */
+	  return NO_ERROR;
+	}
+      if (!BTREE_IS_PAGE_VALID_LEAF (thread_p, bts->C_page))
+	{
+	  /* Page was reused for other purposes. */
+	  break;
+	}
+
+      error_code =
+	btree_leaf_is_key_between_min_max (thread_p, &bts->btid_int, bts->C_page, bts->key_range.lower_key,
+					   &search_key);
+      if (error_code == NO_ERROR && search_key.result == BTREE_KEY_BETWEEN)
+	{
+	  /* We need to find slot of key. */
+	  error_code =
+	    btree_search_leaf_page (thread_p, &bts->btid_int, bts->C_page, bts->key_range.lower_key, &search_key);
+	}
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  pgbuf_unfix_and_init (thread_p, bts->C_page);
+	  return error_code;
+	}
+
+      if (search_key.result == BTREE_KEY_FOUND && !btree_is_fence_key (bts->C_page, search_key.slotid))
+	{
+	  /* Key is in this page. */
+	  *found = true;
+	  bts->C_vpid = vpid;
+	  bts->slot_id = search_key.slotid;
+	  return NO_ERROR;
+	}
+      if (search_key.result == BTREE_KEY_BETWEEN)
+	{
+	  /* Key is not in index, but it would belong to this page. Start with next bigger key. */
+	  bts->C_vpid = vpid;
+	  bts->slot_id = search_key.slotid;
+	  return NO_ERROR;
+	}
+      if (search_key.result != BTREE_KEY_BIGGER || hop > 0)
+	{
+	  /* Key is elsewhere. */
+	  break;
+	}
+
+      /* Key is bigger than all keys in page. Try next leaf node. */
+      header = btree_get_node_header (thread_p, bts->C_page);
+      if (header == NULL || VPID_ISNULL (&header->next_vpid))
+	{
+	  break;
+	}
+      vpid = header->next_vpid;
+      pgbuf_unfix_and_init (thread_p, bts->C_page);
+    }
+
+  if (bts->C_page != NULL)
+    {
+      pgbuf_unfix_and_init (thread_p, bts->C_page);
+    }
+  return NO_ERROR;
+}
+
 /*
  * btree_range_scan_read_record () - Read b-tree record for b-tree range scan.
  *
@@ -25024,6 +26245,16 @@ end:
 
   if (bts->end_scan)
     {
+      /* Remember the leaf node where the range ended. Next range of a key list is likely to start in it. */
+      if (bts->C_page != NULL && error_code == NO_ERROR)
+	{
+	  pgbuf_get_vpid (bts->C_page, &bts->probe_vpid);
+	}
+      else
+	{
+	  VPID_SET_NULL (&bts->probe_vpid);
+	}
+
       /* Scan is ended. Reset current page VPID and is_scan_started flag */
       VPID_SET_NULL (&bts->C_vpid);
       bts->is_scan_started = false;
@@ -25916,7 +27147,7 @@ btree_undo_delete_physical (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key
 		     btid->vfid.fileid);
     }
   return btree_insert_internal (thread_p, btid, key, class_oid, oid, SINGLE_ROW_INSERT, NULL, NULL, mvcc_info,
-				undo_nxlsa, BTREE_OP_INSERT_UNDO_PHYSICAL_DELETE);
+				undo_nxlsa, BTREE_OP_INSERT_UNDO_PHYSICAL_DELETE, NULL);
 }
 
 /*
@@ -25968,7 +27199,74 @@ btree_insert (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID * cls_oi
   assert (!BTREE_MVCC_INFO_IS_DELID_VALID (&mvcc_info));
 
   return btree_insert_internal (thread_p, btid, key, cls_oid, oid, op_type, unique_stat_info, unique, &mvcc_info, NULL,
-				BTREE_OP_INSERT_NEW_OBJECT);
+				BTREE_OP_INSERT_NEW_OBJECT, NULL);
+}
+
+/*
+ * btree_insert_sorted_list () - Insert a list of new objects into b-tree. Keys are sorted first and each leaf node
+ *				 reached from root is used to insert all following keys that belong to it.
+ *
+ * return		  : Error code.
+ * thread_p (in)	  : Thread entry.
+ * btid (in)		  : B-tree identifier.
+ * cls_oid (in)		  : Class OID.
+ * insert_list (in)	  : List of (key, OID) pairs. NULL keys must not be added to the list.
+ * op_type (in)		  : Single-multi row operations.
+ * unique_stat_info (in)  : Statistics collector used multi row operations.
+ * p_mvcc_rec_header (in) : Heap MVCC record header, shared by all objects of the list.
+ *
+ * NOTE: Unique constraint is checked for each key just like btree_insert does. Keys that already exist in unique
+ *	 indexes are always inserted by a separate traversal from root, since they may require locking.
+ */
+int
+btree_insert_sorted_list (THREAD_ENTRY * thread_p, BTID * btid, OID * cls_oid, btree_insert_list * insert_list,
+			  int op_type, btree_unique_stats * unique_stat_info, MVCC_REC_HEADER * p_mvcc_rec_header)
+{
+  BTREE_MVCC_INFO mvcc_info = BTREE_MVCC_INFO_INITIALIZER;
+  int error_code = NO_ERROR;
+  int prev_pos;
+
+  assert (insert_list != NULL);
+
+  if (insert_list->m_keys_oids.empty ())
+    {
+      return NO_ERROR;
+    }
+
+  if (p_mvcc_rec_header != NULL)
+    {
+      btree_mvcc_info_from_heap_mvcc_header (p_mvcc_rec_header, &mvcc_info);
+    }
+
+  /* Safe guard. */
+  assert (!BTREE_MVCC_INFO_IS_DELID_VALID (&mvcc_info));
+
+  insert_list->prepare_list ();
+
+  while (insert_list->m_curr_pos < (int) insert_list->m_sorted_keys_oids.size ())
+    {
+      prev_pos = insert_list->m_curr_pos;
+
+      error_code =
+	btree_insert_internal (thread_p, btid, insert_list->get_key (), cls_oid, insert_list->get_oid (), op_type,
+			       unique_stat_info, NULL, &mvcc_info, NULL, BTREE_OP_INSERT_NEW_OBJECT, insert_list);
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  return error_code;
+	}
+
+      if (insert_list->m_curr_pos == prev_pos)
+	{
+	  /* Only current key was inserted. */
+	  if (insert_list->next_key () != btree_insert_list::KEY_AVAILABLE)
+	    {
+	      break;
+	    }
+	}
+    }
+
+  return NO_ERROR;
 }
 
 /*
@@ -26014,7 +27312,7 @@ btree_mvcc_delete (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID * c
   assert (BTREE_MVCC_INFO_IS_DELID_VALID (&mvcc_info));
 
   return btree_insert_internal (thread_p, btid, key, class_oid, oid, op_type, unique_stat_info, unique, &mvcc_info,
-				NULL, BTREE_OP_INSERT_MVCC_DELID);
+				NULL, BTREE_OP_INSERT_MVCC_DELID, NULL);
 }
 
 /*
@@ -26032,11 +27330,13 @@ btree_mvcc_delete (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID * c
  * mvcc_info (in)	     : B-tree MVCC information.
  * undo_nxlsa (in)	     : UNDO next lsa for logical compensate.
  * purpose (in)		     : B-tree insert purpose
+ * insert_list (in)	     : Sorted list of new objects that key belongs to. Following keys of the list are inserted
+ *			       in the same leaf node while possible. NULL if a single object is inserted.
  */
 static int
 btree_insert_internal (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID * class_oid, OID * oid, int op_type,
 		       btree_unique_stats * unique_stat_info, int *unique, BTREE_MVCC_INFO * mvcc_info,
-		       LOG_LSA * undo_nxlsa, BTREE_OP_PURPOSE purpose)
+		       LOG_LSA * undo_nxlsa, BTREE_OP_PURPOSE purpose, btree_insert_list * insert_list)
 {
   int error_code = NO_ERROR;	/* Error code. */
   BTID_INT btid_int;		/* B-tree info. */
@@ -26080,6 +27380,12 @@ btree_insert_internal (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID
       /* Fall through. */
     case BTREE_OP_INSERT_NEW_OBJECT:
       key_insert_func = btree_key_insert_new_object;
+      if (insert_list != NULL)
+	{
+	  assert (purpose == BTREE_OP_INSERT_NEW_OBJECT);
+	  insert_helper.insert_list = insert_list;
+	  key_insert_func = btree_key_insert_new_object_list;
+	}
       break;
     case BTREE_OP_INSERT_MVCC_DELID:
     case BTREE_OP_INSERT_MARK_DELETED:
@@ -26535,6 +27841,167 @@ btree_get_max_new_data_size (THREAD_ENTRY * thread_p, BTID_INT * btid_int, PAGE_
     }
 }
 
+/*
+ * btree_append_hint_remember () - Remember right-most leaf of index after appending a key to it.
+ *
+ * return	   : Void.
+ * thread_p (in)   : Thread entry.
+ * btid (in)	   : B-tree identifier.
+ * leaf_page (in)  : Write latched leaf page where key was appended.
+ */
+static void
+btree_append_hint_remember (THREAD_ENTRY * thread_p, const BTID * btid, PAGE_PTR leaf_page)
+{
+  btree_append_hint *hint = BTREE_APPEND_HINT_OF (btid);
+  BTREE_NODE_HEADER *node_header = NULL;
+
+  assert (leaf_page != NULL && pgbuf_get_latch_mode (leaf_page) == PGBUF_LATCH_WRITE);
+
+  node_header = btree_get_node_header (thread_p, leaf_page);
+  if (node_header == NULL || node_header->node_level != 1 || !VPID_ISNULL (&node_header->next_vpid))
+    {
+      /* Only right-most leaf is remembered. */
+      return;
+    }
+
+  hint->m_mutex.lock ();
+  BTID_COPY (&hint->m_btid, btid);
+  VPID_COPY (&hint->m_leaf_vpid, pgbuf_get_vpid_ptr (leaf_page));
+  LSA_COPY (&hint->m_leaf_lsa, pgbuf_get_lsa (leaf_page));
+  hint->m_mutex.unlock ();
+}
+
+/*
+ * btree_append_hint_forget () - Forget append hint of index if it still points to the given leaf version.
+ *
+ * return	  : Void.
+ * btid (in)	  : B-tree identifier.
+ * leaf_vpid (in) : Hinted leaf VPID.
+ * leaf_lsa (in)  : Hinted leaf LSA.
+ */
+static void
+btree_append_hint_forget (const BTID * btid, const VPID * leaf_vpid, const LOG_LSA * leaf_lsa)
+{
+  btree_append_hint *hint = BTREE_APPEND_HINT_OF (btid);
+
+  hint->m_mutex.lock ();
+  if (BTID_IS_EQUAL (&hint->m_btid, btid) && VPID_EQ (&hint->m_leaf_vpid, leaf_vpid)
+      && LSA_EQ (&hint->m_leaf_lsa, leaf_lsa))
+    {
+      BTID_SET_NULL (&hint->m_btid);
+      VPID_SET_NULL (&hint->m_leaf_vpid);
+      LSA_SET_NULL (&hint->m_leaf_lsa);
+    }
+  hint->m_mutex.unlock ();
+}
+
+/*
+ * btree_insert_advance_with_append_hint () - Try to advance from root directly to the right-most leaf, using the
+ *					      append hint of index.
+ *
+ * return	      : Error code.
+ * thread_p (in)      : Thread entry.
+ * btid_int (in)      : B-tree info.
+ * key (in)	      : Inserted key.
+ * crt_page (in/out)  : Root page as input. If hint is used, root is unfixed and right-most leaf is output instead.
+ * is_leaf (out)      : Output true if hint is used.
+ * search_key (out)   : Key search result in right-most leaf (if hint is used).
+ * insert_helper (in) : Insert helper.
+ *
+ * NOTE: The hint is used only if the key is bigger than all keys in right-most leaf and if the leaf has enough space
+ *	 for the new key. Any split or max key length update is therefore avoided and skipping the nodes between root
+ *	 and leaf is safe.
+ */
+static int
+btree_insert_advance_with_append_hint (THREAD_ENTRY * thread_p, BTID_INT * btid_int, DB_VALUE * key,
+				       PAGE_PTR * crt_page, bool * is_leaf, BTREE_SEARCH_KEY_HELPER * search_key,
+				       BTREE_INSERT_HELPER * insert_helper)
+{
+  btree_append_hint *hint = BTREE_APPEND_HINT_OF (btid_int->sys_btid);
+  VPID leaf_vpid = VPID_INITIALIZER;
+  LOG_LSA leaf_lsa = LSA_INITIALIZER;
+  PAGE_PTR leaf_page = NULL;
+  BTREE_NODE_HEADER *node_header = NULL;
+  BTREE_SEARCH_KEY_HELPER leaf_search_key = BTREE_SEARCH_KEY_HELPER_INITIALIZER;
+  int error_code = NO_ERROR;
+
+  assert (crt_page != NULL && *crt_page != NULL);
+  assert (insert_helper->purpose == BTREE_OP_INSERT_NEW_OBJECT && insert_helper->insert_list == NULL);
+  assert (!insert_helper->need_update_max_key_len);
+
+  *is_leaf = false;
+
+  hint->m_mutex.lock ();
+  if (BTID_IS_EQUAL (&hint->m_btid, btid_int->sys_btid))
+    {
+      VPID_COPY (&leaf_vpid, &hint->m_leaf_vpid);
+      LSA_COPY (&leaf_lsa, &hint->m_leaf_lsa);
+    }
+  hint->m_mutex.unlock ();
+
+  if (VPID_ISNULL (&leaf_vpid) || VPID_EQ (&leaf_vpid, pgbuf_get_vpid_ptr (*crt_page)))
+    {
+      /* No hint. */
+      return NO_ERROR;
+    }
+  if (btree_get_disk_size_of_key (key) >= BTREE_MAX_KEYLEN_INPAGE)
+    {
+      /* Overflow keys are not appended using the hint. */
+      return NO_ERROR;
+    }
+
+  /* Root is still fixed, so the latch order is the same as for regular traversal. Do not wait for the leaf or read it
+   * from disk: a busy or a cold leaf is no better than following the regular path. */
+  leaf_page = pgbuf_fix (thread_p, &leaf_vpid, OLD_PAGE_IF_IN_BUFFER, PGBUF_LATCH_WRITE, PGBUF_CONDITIONAL_LATCH);
+  if (leaf_page == NULL)
+    {
+      return NO_ERROR;
+    }
+
+  if (pgbuf_get_page_ptype (thread_p, leaf_page) != PAGE_BTREE || !LSA_EQ (pgbuf_get_lsa (leaf_page), &leaf_lsa))
+    {
+      /* Leaf was changed since the hint was saved. */
+      goto forget_hint;
+    }
+  node_header = btree_get_node_header (thread_p, leaf_page);
+  if (node_header == NULL || node_header->node_level != 1 || !VPID_ISNULL (&node_header->next_vpid)
+      || insert_helper->key_len_in_page > node_header->max_key_len)
+    {
+      /* Not the right-most leaf anymore or max key length should be updated on the path from root. */
+      goto forget_hint;
+    }
+
+  error_code = btree_search_leaf_page (thread_p, btid_int, leaf_page, key, &leaf_search_key);
+  if (error_code != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      pgbuf_unfix_and_init (thread_p, leaf_page);
+      return error_code;
+    }
+  if (leaf_search_key.result != BTREE_KEY_BIGGER
+      || btree_key_insert_does_leaf_need_split (thread_p, btid_int, leaf_page, insert_helper, &leaf_search_key))
+    {
+      /* Not an append or leaf should be split. */
+      goto forget_hint;
+    }
+
+  /* Leaf can be used. */
+  pgbuf_unfix_and_init (thread_p, *crt_page);
+  *crt_page = leaf_page;
+  *search_key = leaf_search_key;
+  *is_leaf = true;
+
+  insert_helper->is_root = false;
+  insert_helper->is_crt_node_write_latched = true;
+
+  return NO_ERROR;
+
+forget_hint:
+  pgbuf_unfix_and_init (thread_p, leaf_page);
+  btree_append_hint_forget (btid_int->sys_btid, &leaf_vpid, &leaf_lsa);
+  return NO_ERROR;
+}
+
 /*
  * btree_split_node_and_advance () - BTREE_ADVANCE_WITH_KEY_FUNCTION used by btree_insert_internal while advancing
  *				     following key. It also has the role to make sure b-tree has enough space to
@@ -26865,6 +28332,23 @@ btree_split_node_and_advance (THREAD_ENTRY * thread_p, BTID_INT * btid_int, DB_V
       assert (node_type != BTREE_LEAF_NODE || pgbuf_get_latch_mode (*crt_page) == PGBUF_LATCH_WRITE);
     }
 
+  if (insert_helper->is_root && node_type == BTREE_NON_LEAF_NODE && insert_helper->purpose == BTREE_OP_INSERT_NEW_OBJECT
+      && insert_helper->insert_list == NULL && !insert_helper->need_update_max_key_len)
+    {
+      /* Appending keys to the right-most leaf may skip the traversal. */
+      error_code =
+	btree_insert_advance_with_append_hint (thread_p, btid_int, key, crt_page, is_leaf, search_key, insert_helper);
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  goto error;
+	}
+      if (*is_leaf)
+	{
+	  return NO_ERROR;
+	}
+    }
+
   /* Here, node represented by *crt_page has enough space to handle a child split. Either because it was root and was
    * split into two nodes in this call or because it was non-root and was split in previous iteration (if split was
    * required of course). */
@@ -27258,6 +28742,11 @@ btree_key_insert_new_object (THREAD_ENTRY * thread_p, BTID_INT * btid_int, DB_VA
 	  ASSERT_ERROR ();
 	  goto error;
 	}
+      if (insert_helper->purpose == BTREE_OP_INSERT_NEW_OBJECT && search_key->result == BTREE_KEY_BIGGER)
+	{
+	  /* Key was appended to leaf. If this is the right-most leaf, next appends may go directly here. */
+	  btree_append_hint_remember (thread_p, btid_int->sys_btid, *leaf_page);
+	}
       if (insert_helper->rv_keyval_data != NULL && insert_helper->rv_keyval_data != rv_undo_data_bufalign)
 	{
 	  db_private_free_and_init (thread_p, insert_helper->rv_keyval_data);
@@ -29341,7 +30830,7 @@ btree_physical_delete (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID
       BTREE_MVCC_INFO_SET_DELID (&mvcc_info, tran_mvccid);
 
       return btree_insert_internal (thread_p, btid, key, class_oid, oid, op_type, unique_stat_info, unique, &mvcc_info,
-				    NULL, BTREE_OP_INSERT_MARK_DELETED);
+				    NULL, BTREE_OP_INSERT_MARK_DELETED, NULL);
     }
   else
     {
@@ -33388,6 +34877,273 @@ end:
   return error_code;
 }
 
+/*
+ * btree_insert_list_is_next_key_in_leaf () - Check if next key of a sorted insert list can be inserted in the leaf
+ *					      node that is already fixed, without another traversal from root.
+ *
+ * return	      : Error code.
+ * thread_p (in)      : Thread entry.
+ * btid_int (in)      : B-tree info.
+ * insert_helper (in) : Insert helper. Its insert list has the page boundaries collected while advancing to leaf.
+ * leaf_page (in)     : Leaf node page.
+ * key (in)	      : Next key of the list.
+ * search_key (out)   : Position of key in leaf node if it can be inserted there.
+ * in_leaf (out)      : Output true if key can be inserted in leaf node.
+ */
+static int
+btree_insert_list_is_next_key_in_leaf (THREAD_ENTRY * thread_p, BTID_INT * btid_int,
+				       BTREE_INSERT_HELPER * insert_helper, PAGE_PTR leaf_page, DB_VALUE * key,
+				       BTREE_SEARCH_KEY_HELPER * search_key, bool * in_leaf)
+{
+  btree_insert_list *insert_list = insert_helper->insert_list;
+  BTREE_NODE_HEADER *node_header = NULL;
+  DB_VALUE_COMPARE_RESULT c;
+  int key_len;
+  int new_ent_size;
+  bool key_already_in_page = false;
+  int error_code = NO_ERROR;
+
+  assert (insert_list != NULL);
+  assert (in_leaf != NULL);
+
+  *in_leaf = false;
+
+  key_len = btree_get_disk_size_of_key (key);
+  node_header = btree_get_node_header (thread_p, leaf_page);
+  if (node_header == NULL)
+    {
+      assert_release (false);
+      return ER_FAILED;
+    }
+
+  if (key_len > node_header->max_key_len)
+    {
+      /* cannot insert a key having len > max key len : abort and let advance/split algorithm to deal with this */
+      return NO_ERROR;
+    }
+
+  /* assuming the key does not exist in page (an existing key requires less space,
+   * we may miss adding one more record; this is a less expensive check, we accept the 'loss' */
+  new_ent_size = btree_get_max_new_data_size (thread_p, btid_int, leaf_page, BTREE_LEAF_NODE, key_len, insert_helper,
+					      key_already_in_page);
+  if (new_ent_size > spage_get_free_space_without_saving (thread_p, leaf_page, NULL))
+    {
+      /* no more space in page */
+      return NO_ERROR;
+    }
+
+  /* compare with boundary keys : NULL keys means INF bound, no check is required */
+  if (!insert_list->m_boundaries.m_is_inf_left_key)
+    {
+      c = btree_compare_key (&insert_list->m_boundaries.m_left_key, key, btid_int->key_type, 1, 1, NULL);
+      if (c != DB_LT && c != DB_EQ)
+	{
+	  return NO_ERROR;
+	}
+    }
+
+  if (!insert_list->m_boundaries.m_is_inf_right_key)
+    {
+      c = btree_compare_key (key, &insert_list->m_boundaries.m_right_key, btid_int->key_type, 1, 1, NULL);
+      if (c != DB_LT)
+	{
+	  return NO_ERROR;
+	}
+    }
+
+  /* early filter-out of out-page-range key : compare with min/max of page
+   * it also has the purpose of silencing the debug assertion of btree_search_leaf_page;
+   * after this, the 'search_key' structure is incomplete (slot id will be computed by btree_search_leaf_page) */
+  if (DB_VALUE_DOMAIN_TYPE (key) == DB_TYPE_MIDXKEY)
+    {
+      error_code = btree_leaf_is_key_between_min_max (thread_p, btid_int, leaf_page, key, search_key);
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  return error_code;
+	}
+
+      if (search_key->result == BTREE_ERROR_OCCURRED || search_key->result == BTREE_KEY_SMALLER
+	  || search_key->result == BTREE_KEY_BIGGER)
+	{
+	  if (search_key->result == BTREE_KEY_SMALLER && VPID_ISNULL (&node_header->prev_vpid))
+	    {
+	      /* key is out of range (smaller), but since there is no leaf page to the left, we may continue */
+	      ;
+	    }
+	  else if (search_key->result == BTREE_KEY_BIGGER && VPID_ISNULL (&node_header->next_vpid))
+	    {
+	      /* key is out of range (bigger), but since there is no leaf page to the right, we may continue */
+	      ;
+	    }
+	  else
+	    {
+	      /* key is out of range (smaller or bigger) and the current leaf page has neighbours :
+	       * abort and search from root */
+	      return NO_ERROR;
+	    }
+	}
+    }
+
+  /* resolution of where to insert : slot, position relative to this slot and if page has fence keys */
+  error_code = btree_search_leaf_page (thread_p, btid_int, leaf_page, key, search_key);
+  if (error_code != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      return error_code;
+    }
+
+  if ((search_key->result == BTREE_KEY_BIGGER || search_key->result == BTREE_KEY_SMALLER)
+      && search_key->has_fence_key == btree_search_key_helper::HAS_FENCE_KEY)
+    {
+      /* key is out of range and presence of fence key suggests that next/prev leaf page should be
+       * a better place; no fence means current key is bigger/lesser than all index keys and we can insert here
+       * (this is backed-up by key page boundaries checked before) */
+      return NO_ERROR;
+    }
+  else if (search_key->result != BTREE_KEY_BETWEEN && search_key->result != BTREE_KEY_FOUND
+	   && search_key->result != BTREE_KEY_BIGGER && search_key->result != BTREE_KEY_SMALLER)
+    {
+      /* unexpected, abort insert and retry from root page */
+      assert (false);
+      return NO_ERROR;
+    }
+
+  *in_leaf = true;
+  return NO_ERROR;
+}
+
+/*
+ * btree_key_insert_new_object_list () - BTREE_PROCESS_KEY_FUNCTION used for inserting new objects of a sorted insert
+ *					 list in b-tree. After the object of given key is inserted, the next keys of
+ *					 the list are inserted in the same leaf node, as long as they belong to it.
+ *
+ * return	    : Error code.
+ * thread_p (in)    : Thread entry.
+ * btid_int (in)    : B-tree info.
+ * key (in)	    : Key value.
+ * leaf_page (in)   : Pointer to the leaf page.
+ * search_key (in)  : Search helper.
+ * restart (out)    : Set to true if restart from root is required.
+ * other_args (in)  : BTREE_INSERT_HELPER *.
+ *
+ * NOTE: When this function returns, the current key of insert list is the first key that was not inserted.
+ */
+static int
+btree_key_insert_new_object_list (THREAD_ENTRY * thread_p, BTID_INT * btid_int, DB_VALUE * key,
+				  PAGE_PTR * leaf_page, BTREE_SEARCH_KEY_HELPER * search_key, bool * restart,
+				  void *other_args)
+{
+  BTREE_INSERT_HELPER *insert_helper = (BTREE_INSERT_HELPER *) other_args;
+  btree_insert_list *insert_list = insert_helper->insert_list;
+  DB_VALUE *curr_key = key;
+  bool in_leaf = false;
+  bool is_unique_append = false;
+  int error_code = NO_ERROR;
+
+  assert (insert_list != NULL && insert_list->m_use_sorted_bulk_insert);
+  assert (insert_helper->purpose == BTREE_OP_INSERT_NEW_OBJECT);
+
+  while (true)
+    {
+      is_unique_append = search_key->result == BTREE_KEY_FOUND && BTREE_IS_UNIQUE (btid_int->unique_pk);
+      error_code =
+	btree_key_insert_new_object (thread_p, btid_int, curr_key, leaf_page, search_key, restart, other_args);
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  break;
+	}
+      if (*restart)
+	{
+	  /* Only the first key can require a restart. It is inserted again from root. */
+	  assert (curr_key == key);
+	  break;
+	}
+      if (curr_key != key)
+	{
+	  /* First key is counted by btree_insert_internal. */
+	  perfmon_inc_stat (thread_p, PSTAT_BT_NUM_INSERTS);
+	}
+
+      if (insert_list->next_key () != btree_insert_list::KEY_AVAILABLE)
+	{
+	  /* no more keys in list */
+	  break;
+	}
+      if (is_unique_append)
+	{
+	  /* Leaf may have been unfixed while locking existing object. Next key is inserted from root. */
+	  break;
+	}
+
+      /* prepare next pair (key, oid) */
+      COPY_OID (BTREE_INSERT_OID (insert_helper), insert_list->get_oid ());
+      curr_key = insert_list->get_key ();
+      assert (!DB_IS_NULL (curr_key) && !btree_multicol_key_is_null (curr_key));
+      if (DB_VALUE_DOMAIN_TYPE (curr_key) == DB_TYPE_MIDXKEY)
+	{
+	  curr_key->data.midxkey.domain = btid_int->key_type;
+	}
+      insert_helper->key_len_in_page = BTREE_GET_KEY_LEN_IN_PAGE (btree_get_disk_size_of_key (curr_key));
+      if (insert_helper->printed_key != NULL)
+	{
+	  /* Printed key belongs to previous key. */
+	  db_private_free_and_init (thread_p, insert_helper->printed_key);
+	}
+
+      error_code =
+	btree_insert_list_is_next_key_in_leaf (thread_p, btid_int, insert_helper, *leaf_page, curr_key, search_key,
+					       &in_leaf);
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  break;
+	}
+      if (!in_leaf)
+	{
+	  break;
+	}
+      if (search_key->result == BTREE_KEY_FOUND && BTREE_IS_UNIQUE (btid_int->unique_pk))
+	{
+	  /* Appending to an unique key may need to lock and restart. Insert it from root. */
+	  break;
+	}
+      if (insert_list->check_release_latch (thread_p, insert_helper, *leaf_page))
+	{
+	  break;
+	}
+
+      /* Unique statistics are updated when root is fixed, which is skipped for this key. */
+      if (BTREE_IS_UNIQUE (btid_int->unique_pk))
+	{
+	  if (BTREE_IS_MULTI_ROW_OP (insert_helper->op_type))
+	    {
+	      assert (insert_helper->unique_stats_info != NULL);
+	      insert_helper->unique_stats_info->insert_key_and_row ();
+	    }
+	  else
+	    {
+	      btree_unique_stats incr;
+
+	      incr.insert_key_and_row ();
+	      error_code = logtb_tran_update_unique_stats (thread_p, *btid_int->sys_btid, incr, true);
+	      if (error_code != NO_ERROR)
+		{
+		  ASSERT_ERROR ();
+		  break;
+		}
+	    }
+	}
+
+      insert_list->m_keep_page_iterations++;
+    }
+
+  insert_list->reset_boundary_keys ();
+
+  return error_code;
+}
+
 /*
  * btree_key_online_index_IB_insert_list () - BTREE_PROCESS_KEY_FUNCTION used for inserting a new object in b-tree during
  *                                       online index loading.
@@ -33411,6 +35167,7 @@ btree_key_online_index_IB_insert_list (THREAD_ENTRY * thread_p, BTID_INT * btid_
   DB_VALUE *curr_key;
   int error_code = NO_ERROR;
   bool first_insert = true;
+  bool in_leaf = false;
 
   curr_key = key;
 
@@ -33454,110 +35211,19 @@ btree_key_online_index_IB_insert_list (THREAD_ENTRY * thread_p, BTID_INT * btid_
       COPY_OID (BTREE_INSERT_OID (&helper->insert_helper), insert_list->get_oid ());
       curr_key = insert_list->get_key ();
 
-      int key_len = btree_get_disk_size_of_key (curr_key);
-      BTREE_NODE_HEADER *node_header = btree_get_node_header (thread_p, *leaf_page);
-
-      if (key_len > node_header->max_key_len)
-	{
-	  /* cannot insert a key having len > max key len : abort and let advance/split algorithm to deal with this */
-	  perfmon_inc_stat (thread_p, PSTAT_BT_ONLINE_NUM_RETRY);
-	  break;
-	}
-
-      /* assuming the key does not exist in page (an existing key requires less space,
-       * we may miss adding one more record; this is a less expensive check, we accept the 'loss' */
-      bool key_already_in_page = false;
-      int new_ent_size = btree_get_max_new_data_size (thread_p, btid_int, *leaf_page, BTREE_LEAF_NODE, key_len,
-						      &helper->insert_helper, key_already_in_page);
-      if (new_ent_size > spage_get_free_space_without_saving (thread_p, *leaf_page, NULL))
-	{
-	  /* no more space in page */
-	  perfmon_inc_stat (thread_p, PSTAT_BT_ONLINE_NUM_RETRY);
-	  break;
-	}
-
-      /* compare with boundary keys : NULL keys means INF bound, no check is required */
-      if (!insert_list->m_boundaries.m_is_inf_left_key)
-	{
-	  DB_VALUE_COMPARE_RESULT c;
-	  c = btree_compare_key (&insert_list->m_boundaries.m_left_key, curr_key, btid_int->key_type, 1, 1, NULL);
-	  if (c != DB_LT && c != DB_EQ)
-	    {
-	      perfmon_inc_stat (thread_p, PSTAT_BT_ONLINE_NUM_RETRY);
-	      break;
-	    }
-	}
-
-      if (!insert_list->m_boundaries.m_is_inf_right_key)
-	{
-	  DB_VALUE_COMPARE_RESULT c;
-	  c = btree_compare_key (curr_key, &insert_list->m_boundaries.m_right_key, btid_int->key_type, 1, 1, NULL);
-	  if (c != DB_LT)
-	    {
-	      perfmon_inc_stat (thread_p, PSTAT_BT_ONLINE_NUM_RETRY);
-	      break;
-	    }
-	}
-
-      /* early filter-out of out-page-range key : compare with min/max of page
-       * it also has the purpose of silencing the debug assertion of btree_search_leaf_page;
-       * after this, the 'search_key' structure is incomplete (slot id will be computed by btree_search_leaf_page) */
-      if (DB_VALUE_DOMAIN_TYPE (key) == DB_TYPE_MIDXKEY)
-	{
-	  error_code = btree_leaf_is_key_between_min_max (thread_p, btid_int, *leaf_page, curr_key, search_key);
-	  if (error_code != NO_ERROR)
-	    {
-	      ASSERT_ERROR ();
-	      break;
-	    }
-
-	  if (search_key->result == BTREE_ERROR_OCCURRED || search_key->result == BTREE_KEY_SMALLER
-	      || search_key->result == BTREE_KEY_BIGGER)
-	    {
-	      if (search_key->result == BTREE_KEY_SMALLER && VPID_ISNULL (&node_header->prev_vpid))
-		{
-		  /* key is out of range (smaller), but since there is no leaf page to the left, we may continue */
-		  ;
-		}
-	      else if (search_key->result == BTREE_KEY_BIGGER && VPID_ISNULL (&node_header->next_vpid))
-		{
-		  /* key is out of range (bigger), but since there is no leaf page to the right, we may continue */
-		  ;
-		}
-	      else
-		{
-		  /* key is out of range (smaller or bigger) and the current leaf page has neighbours :
-		   * abort and search from root */
-		  perfmon_inc_stat (thread_p, PSTAT_BT_ONLINE_NUM_RETRY);
-		  break;
-		}
-	    }
-	}
-
-      /* resolution of where to insert : slot, position relative to this slot and if page has fence keys */
-      error_code = btree_search_leaf_page (thread_p, btid_int, *leaf_page, curr_key, search_key);
+      error_code =
+	btree_insert_list_is_next_key_in_leaf (thread_p, btid_int, &helper->insert_helper, *leaf_page, curr_key,
+					       search_key, &in_leaf);
       if (error_code != NO_ERROR)
 	{
 	  ASSERT_ERROR ();
 	  break;
 	}
-
-      if ((search_key->result == BTREE_KEY_BIGGER || search_key->result == BTREE_KEY_SMALLER)
-	  && search_key->has_fence_key == btree_search_key_helper::HAS_FENCE_KEY)
+      if (!in_leaf)
 	{
-	  /* key is out of range and presence of fence key suggests that next/prev leaf page should be
-	   * a better place; no fence means current key is bigger/lesser than all index keys and we can insert here
-	   * (this is backed-up by key page boundaries checked before) */
 	  perfmon_inc_stat (thread_p, PSTAT_BT_ONLINE_NUM_RETRY);
 	  break;
 	}
-      else if (search_key->result != BTREE_KEY_BETWEEN && search_key->result != BTREE_KEY_FOUND
-	       && search_key->result != BTREE_KEY_BIGGER && search_key->result != BTREE_KEY_SMALLER)
-	{
-	  /* unexpected, abort insert and retry from root page */
-	  assert (false);
-	  break;
-	}
 
       first_insert = false;
       insert_list->m_keep_page_iterations++;
@@ -35702,4 +37368,108 @@ bool btree_insert_list::check_release_latch (THREAD_ENTRY * thread_p, void *arg,
 
   return false;
 }
+
+btree_insert_batch::~btree_insert_batch ()
+{
+  clear ();
+}
+
+//
+// add_key () - add the key of a new object to the keys of its index
+//
+// return         : error code
+// thread_p (in)  : thread entry
+// btid (in)      : b-tree identifier
+// class_oid (in) : class OID
+// key (in)       : key, not NULL; it is copied
+// oid (in)       : instance OID
+//
+int
+btree_insert_batch::add_key (THREAD_ENTRY * thread_p, const BTID &btid, const OID &class_oid, const DB_VALUE *key,
+			     const OID &oid)
+{
+  index_keys *index = NULL;
+
+  assert (key != NULL && !DB_IS_NULL (key) && !btree_multicol_key_is_null (const_cast<DB_VALUE *> (key)));
+
+  for (index_keys &it : m_indexes)
+    {
+      if (BTID_IS_EQUAL (&it.m_btid, &btid))
+	{
+	  index = &it;
+	  break;
+	}
+    }
+
+  if (index == NULL)
+    {
+      index_keys new_index;
+
+      new_index.m_btid = btid;
+      new_index.m_class_oid = class_oid;
+      new_index.m_key_type = btree_read_key_type (thread_p, const_cast<BTID *> (&btid));
+      if (new_index.m_key_type == NULL)
+	{
+	  int error_code;
+
+	  ASSERT_ERROR_AND_SET (error_code);
+	  return error_code;
+	}
+      new_index.m_list = new btree_insert_list (new_index.m_key_type);
+
+      m_indexes.push_back (new_index);
+      index = &m_indexes.back ();
+    }
+
+  (void) index->m_list->add_key (key, oid);
+  m_key_count++;
+
+  return NO_ERROR;
+}
+
+//
+// flush () - insert all collected keys, index by index, and empty the batch
+//
+// return                 : error code
+// thread_p (in)          : thread entry
+// op_type (in)           : multi-row operation type
+// index_stats (in)       : unique statistics of the multi-row operation
+// p_mvcc_rec_header (in) : heap MVCC header of the new objects
+//
+int
+btree_insert_batch::flush (THREAD_ENTRY * thread_p, int op_type, multi_index_unique_stats * index_stats,
+			   MVCC_REC_HEADER * p_mvcc_rec_header)
+{
+  btree_unique_stats *unique_stat_info = NULL;
+  int error_code = NO_ERROR;
+
+  for (index_keys &index : m_indexes)
+    {
+      unique_stat_info = (index_stats != NULL) ? &index_stats->get_stats_of (index.m_btid) : NULL;
+
+      error_code =
+	btree_insert_sorted_list (thread_p, &index.m_btid, &index.m_class_oid, index.m_list, op_type, unique_stat_info,
+				  p_mvcc_rec_header);
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  break;
+	}
+    }
+
+  clear ();
+
+  return error_code;
+}
+
+void
+btree_insert_batch::clear ()
+{
+  for (index_keys &index : m_indexes)
+    {
+      delete index.m_list;
+    }
+  m_indexes.clear ();
+  m_key_count = 0;
+}
 // *INDENT-ON*
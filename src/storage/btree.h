@@ -213,6 +213,7 @@ struct btree_scan
    * cur_leaf_lsa
    */
   LOG_LSA cur_leaf_lsa;		/* page LSA of current leaf page */
+  VPID probe_vpid;		/* leaf where the previous key range ended; the next range is looked up there first */
   LOCK lock_mode;		/* Lock mode - S_LOCK or X_LOCK. */
 
   RECDES key_record;
@@ -273,6 +274,7 @@ struct btree_scan
     (bts)->qualified_keys = 0;				\
     (bts)->key_range_max_value_equal = false;		\
     LSA_SET_NULL (&(bts)->cur_leaf_lsa);		\
+    VPID_SET_NULL (&(bts)->probe_vpid);			\
     (bts)->lock_mode = NULL_LOCK;			\
     (bts)->key_record.data = NULL;			\
     (bts)->offset = 0;					\
@@ -632,6 +634,38 @@ struct btree_insert_list
 
   bool check_release_latch (THREAD_ENTRY * thread_p, void *arg, PAGE_PTR leaf_page);
 };
+
+// btree_insert_batch - keys of new objects collected by a multi-row insert, kept per index. When the batch is
+//                      flushed, the keys of each index are sorted and inserted with btree_insert_sorted_list.
+class btree_insert_batch
+{
+  public:
+    btree_insert_batch () = default;
+    ~btree_insert_batch ();
+
+    int add_key (THREAD_ENTRY * thread_p, const BTID &btid, const OID &class_oid, const DB_VALUE * key,
+                 const OID &oid);
+    int flush (THREAD_ENTRY * thread_p, int op_type, multi_index_unique_stats * index_stats,
+               MVCC_REC_HEADER * p_mvcc_rec_header);
+    void clear ();
+
+    size_t get_key_count () const
+    {
+      return m_key_count;
+    }
+
+  private:
+    struct index_keys
+    {
+      BTID m_btid;
+      OID m_class_oid;
+      const TP_DOMAIN *m_key_type;
+      btree_insert_list *m_list;
+    };
+
+    std::vector<index_keys> m_indexes;
+    size_t m_key_count = 0;
+};
 // *INDENT-ON*
 
 /* BTREE_RANGE_SCAN_PROCESS_KEY_FUNC -
@@ -770,6 +804,9 @@ extern void btree_leaf_change_first_object (THREAD_ENTRY * thread_p, RECDES * re
 					    char **rv_undo_data_ptr, char **rv_redo_data_ptr);
 extern int btree_insert (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID * cls_oid, OID * oid, int op_type,
 			 btree_unique_stats * unique_stat_info, int *unique, MVCC_REC_HEADER * p_mvcc_rec_header);
+extern int btree_insert_sorted_list (THREAD_ENTRY * thread_p, BTID * btid, OID * cls_oid,
+				     btree_insert_list * insert_list, int op_type, btree_unique_stats * unique_stat_info,
+				     MVCC_REC_HEADER * p_mvcc_rec_header);
 extern int btree_mvcc_delete (THREAD_ENTRY * thread_p, BTID * btid, DB_VALUE * key, OID * class_oid, OID * oid,
 			      int op_type, btree_unique_stats * unique_stat_info, int *unique,
 			      MVCC_REC_HEADER * p_mvcc_rec_header);
@@ -805,6 +842,8 @@ extern int btree_prepare_bts (THREAD_ENTRY * thread_p, BTREE_SCAN * bts, BTID *
 			      key_val_range * key_val_range, FILTER_INFO * filter, const OID * match_class_oid,
 			      DB_BIGINT * key_limit_upper, DB_BIGINT * key_limit_lower, bool need_to_check_null,
 			      void *bts_other);
+extern int btree_get_range_separators (THREAD_ENTRY * thread_p, BTID * btid, key_val_range * kv_range,
+				       int max_separators, DB_VALUE * separators, int *n_separators, int *n_leaves);
 
 extern void btree_mvcc_info_from_heap_mvcc_header (MVCC_REC_HEADER * mvcc_header, BTREE_MVCC_INFO * mvcc_info);
 extern void btree_mvcc_info_to_heap_mvcc_header (BTREE_MVCC_INFO * mvcc_info, MVCC_REC_HEADER * mvcc_header);
@@ -28,6 +28,10 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
 
 #include "btree_load.h"
 
@@ -48,6 +52,7 @@
 #include "query_executor.h"
 #include "query_opfunc.h"
 #include "server_support.h"
+#include "slotted_page.h"
 #include "stream_to_xasl.h"
 #include "thread_manager.hpp"
 #include "thread_entry_task.hpp"
@@ -55,6 +60,15 @@
 #include "xasl.h"
 #include "xasl_unpack_info.hpp"
 
+/* Heap pages queued ahead for each worker of a parallel load */
+#define BTREE_LOAD_PAGES_PER_EXTRACT_TASK 64
+/* Initial size of the batches of sort items produced by the workers of a parallel load */
+#define BTREE_LOAD_SORT_BATCH_SIZE (256 * ONE_K)
+
+// *INDENT-OFF*
+class index_builder_sort_context;
+// *INDENT-ON*
+
 typedef struct sort_args SORT_ARGS;
 struct sort_args
 {				/* Collection of information required for "sr_index_sort" */
@@ -85,8 +99,12 @@ struct sort_args
   PRED_EXPR_WITH_CONTEXT *filter;
   PR_EVAL_FNC filter_eval_func;
   FUNCTION_INDEX_INFO *func_index_info;
+  char *pred_stream;		/* Filter predicate stream; workers of a parallel load unpack their own copy */
+  int pred_stream_size;
 
   MVCCID oldest_visible_mvccid;
+
+  index_builder_sort_context *parallel;	/* Not NULL if the sort items are produced by parallel workers */
 };
 
 typedef struct btree_page BTREE_PAGE;
@@ -217,6 +235,132 @@ class index_builder_loader_task: public cubthread::entry_task
     void clear_keys ();
 };
 
+/* A buffer of sort items produced by a worker of a parallel load. Each item is stored as its length followed by
+ * the item itself, both aligned to MAX_ALIGNMENT. */
+class index_builder_sort_batch
+{
+  public:
+    char *m_area;
+    size_t m_area_size;
+    size_t m_length;		/* Bytes used by the items */
+    size_t m_read_pos;		/* Position of the next item to hand to the sort */
+
+    index_builder_sort_batch ();
+    ~index_builder_sort_batch ();
+
+    bool reserve (size_t size);
+};
+
+/* Shared state of a parallel load. One scan task walks the heap page chain and queues the pages; the extract
+ * tasks read the objects of the queued pages, produce their sort items into batches, and the sort thread consumes
+ * the filled batches through btree_sort_get_next. */
+class index_builder_sort_context
+{
+  public:
+    index_builder_sort_context (const SORT_ARGS &sort_args, int extract_count, int tran_index);
+    ~index_builder_sort_context ();
+
+    const SORT_ARGS &get_sort_args () const;
+    int get_tran_index () const;
+    int get_n_nulls () const;
+    int get_n_oids () const;
+
+    /* scan task */
+    bool is_page_queue_full ();
+    bool wait_page_room ();
+    void push_page (const VPID &vpid);
+    void end_pages ();
+
+    /* extract tasks */
+    bool pop_page (VPID &vpid);
+    index_builder_sort_batch *get_free_batch ();
+    void push_full_batch (index_builder_sort_batch *batch);
+
+    /* all tasks */
+    void set_error (int error_code);
+    void task_done (int n_nulls, int n_oids);
+
+    /* sort thread */
+    SORT_STATUS get_next (THREAD_ENTRY *thread_p, RECDES *temp_recdes);
+    void abort_and_wait ();
+
+  private:
+    const SORT_ARGS &m_sort_args;
+    int m_tran_index;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+
+    std::deque<VPID> m_pages;
+    size_t m_max_pages;
+    bool m_pages_done;
+
+    std::vector<index_builder_sort_batch *> m_batches;
+    std::vector<index_builder_sort_batch *> m_free_batches;
+    std::deque<index_builder_sort_batch *> m_full_batches;
+    index_builder_sort_batch *m_read_batch;
+
+    int m_running_tasks;
+    bool m_aborted;
+    int m_error_code;
+    OR_ALIGNED_BUF (1024) m_error_area;
+    bool m_has_error_area;
+
+    int m_n_nulls;
+    int m_n_oids;
+};
+
+class index_builder_scan_task : public cubthread::entry_task
+{
+  public:
+    index_builder_scan_task (index_builder_sort_context &sort_context);
+
+    void execute (cubthread::entry &thread_ref) override;
+
+  private:
+    bool mark_queued (const VPID &vpid);
+    int fix_queued_page (THREAD_ENTRY *thread_p, const VPID &vpid, PGBUF_WATCHER *page_watcher, bool *is_valid);
+
+    index_builder_sort_context &m_sort_context;
+    std::vector<std::vector<bool>> m_queued_pages;	/* pages queued so far, by volume and page identifier */
+};
+
+class index_builder_extract_task : public cubthread::entry_task
+{
+  public:
+    index_builder_extract_task (index_builder_sort_context &sort_context);
+
+    void execute (cubthread::entry &thread_ref) override;
+
+  private:
+    int start_scan (THREAD_ENTRY *thread_p);
+    void end_scan (THREAD_ENTRY *thread_p);
+    int extract_page (THREAD_ENTRY *thread_p, const VPID &vpid);
+    int copy_object (THREAD_ENTRY *thread_p, const OID &oid);
+    int add_sort_item (THREAD_ENTRY *thread_p);
+
+    /* visible version of an object of the page, copied out of the page */
+    struct copied_object
+    {
+      OID oid;
+      size_t offset;		/* Position of the record in m_record_area */
+      int length;
+      INT16 type;
+    };
+
+    index_builder_sort_context &m_sort_context;
+    SORT_ARGS m_sort_args;	/* private copy of the sort arguments */
+    PRED_EXPR_WITH_CONTEXT *m_filter;
+    FUNCTION_INDEX_INFO m_func_index_info;
+    XASL_UNPACK_INFO *m_func_unpack_info;
+    bool m_scancache_inited;
+    bool m_attrinfo_inited;
+    index_builder_sort_batch *m_batch;
+    std::vector<PGSLOTID> m_slots;
+    std::vector<copied_object> m_objects;
+    std::vector<char> m_record_area;
+};
+
 // *INDENT-ON*
 
 
@@ -238,7 +382,12 @@ static int btree_get_value_from_leaf_slot (THREAD_ENTRY * thread_p, BTID_INT * b
 static int btree_dump_sort_output (const RECDES * recdes, LOAD_ARGS * load_args);
 #endif /* defined(CUBRID_DEBUG) */
 static int btree_index_sort (THREAD_ENTRY * thread_p, SORT_ARGS * sort_args, SORT_PUT_FUNC * out_func, void *out_args);
+#if defined (SERVER_MODE)
+static int btree_index_sort_parallel (THREAD_ENTRY * thread_p, SORT_ARGS * sort_args, SORT_PUT_FUNC * out_func,
+				      void *out_args, int extract_count);
+#endif /* SERVER_MODE */
 static SORT_STATUS btree_sort_get_next (THREAD_ENTRY * thread_p, RECDES * temp_recdes, void *arg);
+static SORT_STATUS btree_sort_make_record (THREAD_ENTRY * thread_p, SORT_ARGS * sort_args, RECDES * temp_recdes);
 static int compare_driver (const void *first, const void *second, void *arg);
 static int list_add (BTREE_NODE ** list, VPID * pageid);
 static void list_remove_first (BTREE_NODE ** list);
@@ -253,6 +402,7 @@ static int btree_advance_to_next_slot_and_fix_page (THREAD_ENTRY * thread_p, BTI
 						    PAGE_PTR * pg_ptr, INT16 * slot_id, DB_VALUE * key,
 						    bool * clear_key, bool is_desc, int *key_cnt,
 						    BTREE_NODE_HEADER ** header, MVCC_SNAPSHOT * mvcc);
+static bool btree_load_is_heap_page_of_class (THREAD_ENTRY * thread_p, PAGE_PTR page_p, const OID * class_oid);
 static int btree_load_check_fk (THREAD_ENTRY * thread_p, const LOAD_ARGS * load_args_local,
 				const SORT_ARGS * sort_args_local);
 static int btree_is_slot_visible (THREAD_ENTRY * thread_p, BTID_INT * btid, PAGE_PTR pg_ptr,
@@ -813,6 +963,9 @@ xbtree_load_index (THREAD_ENTRY * thread_p, BTID * btid, const char *bt_name, TP
   sort_args->fk_refcls_oid = fk_refcls_oid;
   sort_args->fk_refcls_pk_btid = fk_refcls_pk_btid;
   sort_args->fk_name = fk_name;
+  sort_args->pred_stream = pred_stream;
+  sort_args->pred_stream_size = pred_stream_size;
+  sort_args->parallel = NULL;
   if (pred_stream && pred_stream_size > 0)
     {
       if (stx_map_stream_to_filter_pred (thread_p, &filter_pred, pred_stream, pred_stream_size) != NO_ERROR)
@@ -2928,11 +3081,114 @@ exit_on_error:
 static int
 btree_index_sort (THREAD_ENTRY * thread_p, SORT_ARGS * sort_args, SORT_PUT_FUNC * out_func, void *out_args)
 {
+#if defined (SERVER_MODE)
+  int extract_count = prm_get_integer_value (PRM_ID_IB_THREAD_COUNT);
+
+  /* only a single heap is split between workers; class hierarchies are loaded serially */
+  if (extract_count > 0 && sort_args->n_classes == 1 && !HFID_IS_NULL (&sort_args->hfids[0]))
+    {
+      return btree_index_sort_parallel (thread_p, sort_args, out_func, out_args, extract_count);
+    }
+#endif /* SERVER_MODE */
+
   return sort_listfile (thread_p, sort_args->hfids[0].vfid.volid, 0 /* TODO - support parallelism */ ,
 			&btree_sort_get_next, sort_args, out_func, out_args, compare_driver, sort_args, SORT_DUP,
 			NO_SORT_LIMIT);
 }
 
+#if defined (SERVER_MODE)
+/*
+ * btree_index_sort_parallel () - Sort for the index file creation, reading the heap with parallel workers
+ *   return: int
+ *   sort_args(in): sort arguments
+ *   out_func(in): output function to utilize the sorted items as they are produced
+ *   out_args(in): arguments to the out_func
+ *   extract_count(in): number of workers producing sort items
+ *
+ * Note: Reading the objects, evaluating the filter and function predicates and generating the keys dominate the
+ *	 cost of the load; they are done by extract_count workers fed with heap pages by one more worker walking the
+ *	 heap chain. The sort thread receives the sort items in batches through btree_sort_get_next and keeps forming
+ *	 runs and merging them, so the items still reach btree_construct_leafs in key order on this thread.
+ */
+static int
+btree_index_sort_parallel (THREAD_ENTRY * thread_p, SORT_ARGS * sort_args, SORT_PUT_FUNC * out_func, void *out_args,
+			   int extract_count)
+{
+  // *INDENT-OFF*
+  index_builder_loader_context pool_context;
+  index_builder_sort_context sort_context (*sort_args, extract_count, LOG_FIND_THREAD_TRAN_INDEX (thread_p));
+  cubthread::entry_workpool *sort_workpool;
+  int error_code;
+  int i;
+
+  pool_context.m_has_error = false;
+  pool_context.m_error_code = NO_ERROR;
+  pool_context.m_tasks_executed = 0UL;
+  pool_context.m_key_type = sort_args->key_type;
+  pool_context.m_conn = thread_p->conn_entry;
+
+  sort_workpool =
+    thread_get_manager ()->create_worker_pool (extract_count + 1, extract_count + 1, "Index loader sort pool",
+					       &pool_context, 1, btree_is_worker_pool_logging_true ());
+  if (sort_workpool == NULL)
+    {
+      /* load serially */
+      return sort_listfile (thread_p, sort_args->hfids[0].vfid.volid, 0, &btree_sort_get_next, sort_args, out_func,
+			    out_args, compare_driver, sort_args, SORT_DUP, NO_SORT_LIMIT);
+    }
+
+  thread_get_manager ()->push_task (sort_workpool, new index_builder_scan_task (sort_context));
+  for (i = 0; i < extract_count; i++)
+    {
+      thread_get_manager ()->push_task (sort_workpool, new index_builder_extract_task (sort_context));
+    }
+
+  sort_args->parallel = &sort_context;
+  error_code = sort_listfile (thread_p, sort_args->hfids[0].vfid.volid, 0, &btree_sort_get_next, sort_args, out_func,
+			      out_args, compare_driver, sort_args, SORT_DUP, NO_SORT_LIMIT);
+  sort_args->parallel = NULL;
+
+  /* on error, the workers may still be running */
+  sort_context.abort_and_wait ();
+  thread_get_manager ()->destroy_worker_pool (sort_workpool);
+
+  if (error_code == NO_ERROR)
+    {
+      sort_args->n_nulls += sort_context.get_n_nulls ();
+      sort_args->n_oids += sort_context.get_n_oids ();
+    }
+
+  return error_code;
+  // *INDENT-ON*
+}
+#endif /* SERVER_MODE */
+
+/*
+ * btree_load_is_heap_page_of_class () - Check that a page fixed without preventing its deallocation is still a heap
+ *					 page of the class
+ *   return: true if the page belongs to the heap of the class
+ *   page_p(in): fixed page
+ *   class_oid(in): class of the heap
+ *
+ * Note: A heap page removed by vacuum can be reused by another file once it is no longer fixed.
+ */
+static bool
+btree_load_is_heap_page_of_class (THREAD_ENTRY * thread_p, PAGE_PTR page_p, const OID * class_oid)
+{
+  OID page_class_oid;
+
+  if (pgbuf_get_page_ptype (thread_p, page_p) != PAGE_HEAP)
+    {
+      return false;
+    }
+  if (heap_get_class_oid_from_page (thread_p, page_p, &page_class_oid) != NO_ERROR)
+    {
+      er_clear ();
+      return false;
+    }
+  return OID_EQ (&page_class_oid, class_oid);
+}
+
 /*
  * btree_sort_get_next () - Get_key function for index sorting
  *   return: SORT_STATUS
@@ -2950,40 +3206,19 @@ static SORT_STATUS
 btree_sort_get_next (THREAD_ENTRY * thread_p, RECDES * temp_recdes, void *arg)
 {
   SCAN_CODE scan_result;
-  DB_VALUE dbvalue;
-  DB_VALUE *dbvalue_ptr;
-  int key_len;
+  SORT_STATUS status;
   OID prev_oid;
   SORT_ARGS *sort_args;
-  OR_BUF buf;
-  int value_has_null;
-  int next_size;
-  int record_size;
-  int oid_size;
-  char midxkey_buf[DBVAL_BUFSIZE + MAX_ALIGNMENT], *aligned_midxkey_buf;
-  int *prefix_lengthp;
-  int result;
-  MVCC_REC_HEADER mvcc_header = MVCC_REC_HEADER_INITIALIZER;
-  MVCC_SNAPSHOT mvcc_snapshot_dirty;
-  MVCC_SATISFIES_SNAPSHOT_RESULT snapshot_dirty_satisfied;
-
-  db_make_null (&dbvalue);
-
-  aligned_midxkey_buf = PTR_ALIGN (midxkey_buf, MAX_ALIGNMENT);
 
   sort_args = (SORT_ARGS *) arg;
-  prev_oid = sort_args->cur_oid;
 
-  if (BTREE_IS_UNIQUE (sort_args->unique_pk))
-    {
-      oid_size = 2 * OR_OID_SIZE;
-    }
-  else
+  if (sort_args->parallel != NULL)
     {
-      oid_size = OR_OID_SIZE;
+      /* the objects are read and turned into sort items by the workers of a parallel load */
+      return sort_args->parallel->get_next (thread_p, temp_recdes);
     }
 
-  mvcc_snapshot_dirty.snapshot_fnc = mvcc_satisfies_dirty;
+  prev_oid = sort_args->cur_oid;
 
   do
     {				/* Infinite loop */
@@ -3096,254 +3331,316 @@ btree_sort_get_next (THREAD_ENTRY * thread_p, RECDES * temp_recdes, void *arg)
       /*
        * Produce the sort item for this object
        */
-
-      /* filter out dead records before any more checks */
-      if (or_mvcc_get_header (&sort_args->in_recdes, &mvcc_header) != NO_ERROR)
-	{
-	  return SORT_ERROR_OCCURRED;
-	}
-      if (MVCC_IS_HEADER_DELID_VALID (&mvcc_header) && MVCC_GET_DELID (&mvcc_header) < sort_args->oldest_visible_mvccid)
+      status = btree_sort_make_record (thread_p, sort_args, temp_recdes);
+      if (status == SORT_NOMORE_RECS)
 	{
+	  /* the object does not produce a sort item */
 	  continue;
 	}
-      if (MVCC_IS_HEADER_INSID_NOT_ALL_VISIBLE (&mvcc_header)
-	  && MVCC_GET_INSID (&mvcc_header) < sort_args->oldest_visible_mvccid)
+      if (status == SORT_REC_DOESNT_FIT)
 	{
-	  /* Insert MVCCID is now visible to everyone. Clear it to avoid unnecessary vacuuming. */
-	  MVCC_CLEAR_FLAG_BITS (&mvcc_header, OR_MVCC_FLAG_VALID_INSID);
+	  /* backtrack this iteration */
+	  sort_args->cur_oid = prev_oid;
 	}
+      return status;
+    }
+  while (true);
+}
+
+/*
+ * btree_sort_make_record () - Produce the sort item of the object currently held in sort arguments
+ *   return: SORT_SUCCESS if an item was produced, SORT_NOMORE_RECS if the object does not produce any item,
+ *	     SORT_REC_DOESNT_FIT if temp_recdes is too small (its length is set to the required size) or
+ *	     SORT_ERROR_OCCURRED
+ *   temp_recdes(in): temporary record descriptor; specifies where to put the sort item.
+ *   sort_args(in): sort arguments; sort_args->cur_oid and sort_args->in_recdes hold the object.
+ *
+ * Note: Besides btree_sort_get_next, this is also used by the workers of a parallel load, each with its own copy
+ *	 of the sort arguments.
+ */
+static SORT_STATUS
+btree_sort_make_record (THREAD_ENTRY * thread_p, SORT_ARGS * sort_args, RECDES * temp_recdes)
+{
+  DB_VALUE dbvalue;
+  DB_VALUE *dbvalue_ptr;
+  int key_len;
+  OR_BUF buf;
+  int value_has_null;
+  int next_size;
+  int record_size;
+  int oid_size;
+  char midxkey_buf[DBVAL_BUFSIZE + MAX_ALIGNMENT], *aligned_midxkey_buf;
+  int *prefix_lengthp;
+  int result;
+  int cur_class, attr_offset;
+  MVCC_REC_HEADER mvcc_header = MVCC_REC_HEADER_INITIALIZER;
+  MVCC_SNAPSHOT mvcc_snapshot_dirty;
+  MVCC_SATISFIES_SNAPSHOT_RESULT snapshot_dirty_satisfied;
 
-      snapshot_dirty_satisfied = mvcc_snapshot_dirty.snapshot_fnc (thread_p, &mvcc_header, &mvcc_snapshot_dirty);
+  db_make_null (&dbvalue);
 
-      if (sort_args->filter)
-	{
-	  if (heap_attrinfo_read_dbvalues (thread_p, &sort_args->cur_oid, &sort_args->in_recdes, NULL,
-					   sort_args->filter->cache_pred) != NO_ERROR)
-	    {
-	      return SORT_ERROR_OCCURRED;
-	    }
+  aligned_midxkey_buf = PTR_ALIGN (midxkey_buf, MAX_ALIGNMENT);
 
-	  result = (*sort_args->filter_eval_func) (thread_p, sort_args->filter->pred, NULL, &sort_args->cur_oid);
-	  if (result == V_ERROR)
-	    {
-	      return SORT_ERROR_OCCURRED;
-	    }
-	  else if (result != V_TRUE)
-	    {
-	      continue;
-	    }
-	}
+  if (BTREE_IS_UNIQUE (sort_args->unique_pk))
+    {
+      oid_size = 2 * OR_OID_SIZE;
+    }
+  else
+    {
+      oid_size = OR_OID_SIZE;
+    }
 
-      if (sort_args->func_index_info && sort_args->func_index_info->expr)
-	{
-	  if (snapshot_dirty_satisfied != SNAPSHOT_SATISFIED)
-	    {
-	      /* Check snapshot before key generation. Key generation may leads to errors when a function is involved. */
-	      continue;
-	    }
+  mvcc_snapshot_dirty.snapshot_fnc = mvcc_satisfies_dirty;
 
-	  if (heap_attrinfo_read_dbvalues (thread_p, &sort_args->cur_oid, &sort_args->in_recdes, NULL,
-					   sort_args->func_index_info->expr->cache_attrinfo) != NO_ERROR)
-	    {
-	      return SORT_ERROR_OCCURRED;
-	    }
-	}
+  cur_class = sort_args->cur_class;
+  attr_offset = cur_class * sort_args->n_attrs;
 
-      if (sort_args->n_attrs == 1)
-	{			/* single-column index */
-	  if (heap_attrinfo_read_dbvalues (thread_p, &sort_args->cur_oid, &sort_args->in_recdes, NULL,
-					   &sort_args->attr_info) != NO_ERROR)
-	    {
-	      return SORT_ERROR_OCCURRED;
-	    }
-	}
+  /* filter out dead records before any more checks */
+  if (or_mvcc_get_header (&sort_args->in_recdes, &mvcc_header) != NO_ERROR)
+    {
+      return SORT_ERROR_OCCURRED;
+    }
+  if (MVCC_IS_HEADER_DELID_VALID (&mvcc_header) && MVCC_GET_DELID (&mvcc_header) < sort_args->oldest_visible_mvccid)
+    {
+      return SORT_NOMORE_RECS;
+    }
+  if (MVCC_IS_HEADER_INSID_NOT_ALL_VISIBLE (&mvcc_header)
+      && MVCC_GET_INSID (&mvcc_header) < sort_args->oldest_visible_mvccid)
+    {
+      /* Insert MVCCID is now visible to everyone. Clear it to avoid unnecessary vacuuming. */
+      MVCC_CLEAR_FLAG_BITS (&mvcc_header, OR_MVCC_FLAG_VALID_INSID);
+    }
 
-      prefix_lengthp = NULL;
-      if (sort_args->attrs_prefix_length)
+  snapshot_dirty_satisfied = mvcc_snapshot_dirty.snapshot_fnc (thread_p, &mvcc_header, &mvcc_snapshot_dirty);
+
+  if (sort_args->filter)
+    {
+      if (heap_attrinfo_read_dbvalues (thread_p, &sort_args->cur_oid, &sort_args->in_recdes, NULL,
+				       sort_args->filter->cache_pred) != NO_ERROR)
 	{
-	  prefix_lengthp = &(sort_args->attrs_prefix_length[0]);
+	  return SORT_ERROR_OCCURRED;
 	}
 
-      dbvalue_ptr =
-	heap_attrinfo_generate_key (thread_p, sort_args->n_attrs, &sort_args->attr_ids[attr_offset], prefix_lengthp,
-				    &sort_args->attr_info, &sort_args->in_recdes, &dbvalue, aligned_midxkey_buf,
-				    sort_args->func_index_info, NULL);
-      if (dbvalue_ptr == NULL)
+      result = (*sort_args->filter_eval_func) (thread_p, sort_args->filter->pred, NULL, &sort_args->cur_oid);
+      if (result == V_ERROR)
 	{
 	  return SORT_ERROR_OCCURRED;
 	}
+      else if (result != V_TRUE)
+	{
+	  return SORT_NOMORE_RECS;
+	}
+    }
 
-      value_has_null = 0;	/* init */
-      if (DB_IS_NULL (dbvalue_ptr) || btree_multicol_key_has_null (dbvalue_ptr))
+  if (sort_args->func_index_info && sort_args->func_index_info->expr)
+    {
+      if (snapshot_dirty_satisfied != SNAPSHOT_SATISFIED)
 	{
-	  value_has_null = 1;	/* found null columns */
+	  /* Check snapshot before key generation. Key generation may leads to errors when a function is involved. */
+	  return SORT_NOMORE_RECS;
 	}
 
-      if (sort_args->not_null_flag && value_has_null && snapshot_dirty_satisfied == SNAPSHOT_SATISFIED)
+      if (heap_attrinfo_read_dbvalues (thread_p, &sort_args->cur_oid, &sort_args->in_recdes, NULL,
+				       sort_args->func_index_info->expr->cache_attrinfo) != NO_ERROR)
 	{
-	  if (dbvalue_ptr == &dbvalue || dbvalue_ptr->need_clear == true)
-	    {
-	      pr_clear_value (dbvalue_ptr);
-	    }
+	  return SORT_ERROR_OCCURRED;
+	}
+    }
 
-	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_NOT_NULL_DOES_NOT_ALLOW_NULL_VALUE, 0);
+  if (sort_args->n_attrs == 1)
+    {			/* single-column index */
+      if (heap_attrinfo_read_dbvalues (thread_p, &sort_args->cur_oid, &sort_args->in_recdes, NULL,
+				       &sort_args->attr_info) != NO_ERROR)
+	{
 	  return SORT_ERROR_OCCURRED;
 	}
+    }
+
+  prefix_lengthp = NULL;
+  if (sort_args->attrs_prefix_length)
+    {
+      prefix_lengthp = &(sort_args->attrs_prefix_length[0]);
+    }
+
+  dbvalue_ptr =
+    heap_attrinfo_generate_key (thread_p, sort_args->n_attrs, &sort_args->attr_ids[attr_offset], prefix_lengthp,
+				&sort_args->attr_info, &sort_args->in_recdes, &dbvalue, aligned_midxkey_buf,
+				sort_args->func_index_info, NULL);
+  if (dbvalue_ptr == NULL)
+    {
+      return SORT_ERROR_OCCURRED;
+    }
+
+  value_has_null = 0;	/* init */
+  if (DB_IS_NULL (dbvalue_ptr) || btree_multicol_key_has_null (dbvalue_ptr))
+    {
+      value_has_null = 1;	/* found null columns */
+    }
 
-      if (DB_IS_NULL (dbvalue_ptr) || btree_multicol_key_is_null (dbvalue_ptr))
+  if (sort_args->not_null_flag && value_has_null && snapshot_dirty_satisfied == SNAPSHOT_SATISFIED)
+    {
+      if (dbvalue_ptr == &dbvalue || dbvalue_ptr->need_clear == true)
 	{
-	  if (snapshot_dirty_satisfied == SNAPSHOT_SATISFIED)
-	    {
-	      /* All objects that were not candidates for vacuum are loaded, but statistics should only care for
-	       * objects that have not been deleted and committed at the time of load. */
-	      sort_args->n_oids++;	/* Increment the OID counter */
-	      sort_args->n_nulls++;	/* Increment the NULL counter */
-	    }
-	  if (dbvalue_ptr == &dbvalue || dbvalue_ptr->need_clear == true)
-	    {
-	      pr_clear_value (dbvalue_ptr);
-	    }
-	  if (prm_get_bool_value (PRM_ID_LOG_BTREE_OPS))
-	    {
-	      _er_log_debug (ARG_FILE_LINE,
-			     "DEBUG_BTREE: load sort found null at oid(%d, %d, %d)"
-			     ", class_oid(%d, %d, %d), btid(%d, (%d, %d).", sort_args->cur_oid.volid,
-			     sort_args->cur_oid.pageid, sort_args->cur_oid.slotid,
-			     sort_args->class_ids[sort_args->cur_class].volid,
-			     sort_args->class_ids[sort_args->cur_class].pageid,
-			     sort_args->class_ids[sort_args->cur_class].slotid, sort_args->btid->sys_btid->root_pageid,
-			     sort_args->btid->sys_btid->vfid.volid, sort_args->btid->sys_btid->vfid.fileid);
-	    }
-	  continue;
+	  pr_clear_value (dbvalue_ptr);
 	}
 
-      key_len = sort_args->key_type->type->get_disk_size_of_value (dbvalue_ptr);
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_NOT_NULL_DOES_NOT_ALLOW_NULL_VALUE, 0);
+      return SORT_ERROR_OCCURRED;
+    }
 
-      if (key_len > 0)
+  if (DB_IS_NULL (dbvalue_ptr) || btree_multicol_key_is_null (dbvalue_ptr))
+    {
+      if (snapshot_dirty_satisfied == SNAPSHOT_SATISFIED)
+	{
+	  /* All objects that were not candidates for vacuum are loaded, but statistics should only care for
+	   * objects that have not been deleted and committed at the time of load. */
+	  sort_args->n_oids++;	/* Increment the OID counter */
+	  sort_args->n_nulls++;	/* Increment the NULL counter */
+	}
+      if (dbvalue_ptr == &dbvalue || dbvalue_ptr->need_clear == true)
+	{
+	  pr_clear_value (dbvalue_ptr);
+	}
+      if (prm_get_bool_value (PRM_ID_LOG_BTREE_OPS))
 	{
-	  next_size = sizeof (char *);
-	  record_size = (next_size	/* Pointer to next */
-			 + OR_INT_SIZE	/* Has null */
-			 + oid_size	/* OID, Class OID */
-			 + 2 * OR_MVCCID_SIZE	/* Insert and delete MVCCID */
-			 + key_len	/* Key length */
-			 + (int) MAX_ALIGNMENT /* Alignment */ );
+	  _er_log_debug (ARG_FILE_LINE,
+			 "DEBUG_BTREE: load sort found null at oid(%d, %d, %d)"
+			 ", class_oid(%d, %d, %d), btid(%d, (%d, %d).", sort_args->cur_oid.volid,
+			 sort_args->cur_oid.pageid, sort_args->cur_oid.slotid,
+			 sort_args->class_ids[sort_args->cur_class].volid,
+			 sort_args->class_ids[sort_args->cur_class].pageid,
+			 sort_args->class_ids[sort_args->cur_class].slotid, sort_args->btid->sys_btid->root_pageid,
+			 sort_args->btid->sys_btid->vfid.volid, sort_args->btid->sys_btid->vfid.fileid);
+	}
+      return SORT_NOMORE_RECS;
+    }
 
-	  if (temp_recdes->area_size < record_size)
-	    {
-	      /*
-	       * Record is too big to fit into temp_recdes area; so
-	       * backtrack this iteration
-	       */
-	      sort_args->cur_oid = prev_oid;
-	      temp_recdes->length = record_size;
-	      goto nofit;
-	    }
+  key_len = sort_args->key_type->type->get_disk_size_of_value (dbvalue_ptr);
+
+  if (key_len > 0)
+    {
+      next_size = sizeof (char *);
+      record_size = (next_size	/* Pointer to next */
+		     + OR_INT_SIZE	/* Has null */
+		     + oid_size	/* OID, Class OID */
+		     + 2 * OR_MVCCID_SIZE	/* Insert and delete MVCCID */
+		     + key_len	/* Key length */
+		     + (int) MAX_ALIGNMENT /* Alignment */ );
 
-	  assert (PTR_ALIGN (temp_recdes->data, MAX_ALIGNMENT) == temp_recdes->data);
-	  or_init (&buf, temp_recdes->data, 0);
+      if (temp_recdes->area_size < record_size)
+	{
+	  /*
+	   * Record is too big to fit into temp_recdes area; the caller
+	   * backtracks this iteration
+	   */
+	  temp_recdes->length = record_size;
+	  goto nofit;
+	}
 
-	  or_pad (&buf, next_size);	/* init as NULL */
+      assert (PTR_ALIGN (temp_recdes->data, MAX_ALIGNMENT) == temp_recdes->data);
+      or_init (&buf, temp_recdes->data, 0);
 
-	  /* save has_null */
-	  if (or_put_byte (&buf, value_has_null) != NO_ERROR)
-	    {
-	      goto nofit;
-	    }
+      or_pad (&buf, next_size);	/* init as NULL */
 
-	  or_advance (&buf, (OR_INT_SIZE - OR_BYTE_SIZE));
-	  assert (buf.ptr == PTR_ALIGN (buf.ptr, INT_ALIGNMENT));
+      /* save has_null */
+      if (or_put_byte (&buf, value_has_null) != NO_ERROR)
+	{
+	  goto nofit;
+	}
 
-	  if (BTREE_IS_UNIQUE (sort_args->unique_pk))
-	    {
-	      if (or_put_oid (&buf, &sort_args->class_ids[cur_class]) != NO_ERROR)
-		{
-		  goto nofit;
-		}
-	    }
+      or_advance (&buf, (OR_INT_SIZE - OR_BYTE_SIZE));
+      assert (buf.ptr == PTR_ALIGN (buf.ptr, INT_ALIGNMENT));
 
-	  if (or_put_oid (&buf, &sort_args->cur_oid) != NO_ERROR)
+      if (BTREE_IS_UNIQUE (sort_args->unique_pk))
+	{
+	  if (or_put_oid (&buf, &sort_args->class_ids[cur_class]) != NO_ERROR)
 	    {
 	      goto nofit;
 	    }
+	}
 
-	  /* Pack insert and delete MVCCID's */
-	  if (MVCC_IS_HEADER_INSID_NOT_ALL_VISIBLE (&mvcc_header))
-	    {
-	      if (or_put_mvccid (&buf, MVCC_GET_INSID (&mvcc_header)) != NO_ERROR)
-		{
-		  goto nofit;
-		}
-	    }
-	  else
-	    {
-	      if (or_put_mvccid (&buf, MVCCID_ALL_VISIBLE) != NO_ERROR)
-		{
-		  goto nofit;
-		}
-	    }
+      if (or_put_oid (&buf, &sort_args->cur_oid) != NO_ERROR)
+	{
+	  goto nofit;
+	}
 
-	  if (MVCC_IS_HEADER_DELID_VALID (&mvcc_header))
+      /* Pack insert and delete MVCCID's */
+      if (MVCC_IS_HEADER_INSID_NOT_ALL_VISIBLE (&mvcc_header))
+	{
+	  if (or_put_mvccid (&buf, MVCC_GET_INSID (&mvcc_header)) != NO_ERROR)
 	    {
-	      if (or_put_mvccid (&buf, MVCC_GET_DELID (&mvcc_header)) != NO_ERROR)
-		{
-		  goto nofit;
-		}
+	      goto nofit;
 	    }
-	  else
+	}
+      else
+	{
+	  if (or_put_mvccid (&buf, MVCCID_ALL_VISIBLE) != NO_ERROR)
 	    {
-	      if (or_put_mvccid (&buf, MVCCID_NULL) != NO_ERROR)
-		{
-		  goto nofit;
-		}
+	      goto nofit;
 	    }
+	}
 
-	  if (prm_get_bool_value (PRM_ID_LOG_BTREE_OPS))
+      if (MVCC_IS_HEADER_DELID_VALID (&mvcc_header))
+	{
+	  if (or_put_mvccid (&buf, MVCC_GET_DELID (&mvcc_header)) != NO_ERROR)
 	    {
-	      _er_log_debug (ARG_FILE_LINE,
-			     "DEBUG_BTREE: load sort found oid(%d, %d, %d)"
-			     ", class_oid(%d, %d, %d), btid(%d, (%d, %d), mvcc_info=%llu | %llu.",
-			     sort_args->cur_oid.volid, sort_args->cur_oid.pageid, sort_args->cur_oid.slotid,
-			     sort_args->class_ids[sort_args->cur_class].volid,
-			     sort_args->class_ids[sort_args->cur_class].pageid,
-			     sort_args->class_ids[sort_args->cur_class].slotid, sort_args->btid->sys_btid->root_pageid,
-			     sort_args->btid->sys_btid->vfid.volid, sort_args->btid->sys_btid->vfid.fileid,
-			     MVCC_IS_FLAG_SET (&mvcc_header,
-					       OR_MVCC_FLAG_VALID_INSID) ? MVCC_GET_INSID (&mvcc_header) :
-			     MVCCID_ALL_VISIBLE, MVCC_IS_FLAG_SET (&mvcc_header,
-								   OR_MVCC_FLAG_VALID_DELID) ?
-			     MVCC_GET_DELID (&mvcc_header) : MVCCID_NULL);
+	      goto nofit;
 	    }
-
-	  assert (buf.ptr == PTR_ALIGN (buf.ptr, INT_ALIGNMENT));
-
-	  if (sort_args->key_type->type->data_writeval (&buf, dbvalue_ptr) != NO_ERROR)
+	}
+      else
+	{
+	  if (or_put_mvccid (&buf, MVCCID_NULL) != NO_ERROR)
 	    {
 	      goto nofit;
 	    }
+	}
 
-	  temp_recdes->length = CAST_STRLEN (buf.ptr - buf.buffer);
-
-	  if (dbvalue_ptr == &dbvalue || dbvalue_ptr->need_clear == true)
-	    {
-	      pr_clear_value (dbvalue_ptr);
-	    }
+      if (prm_get_bool_value (PRM_ID_LOG_BTREE_OPS))
+	{
+	  _er_log_debug (ARG_FILE_LINE,
+			 "DEBUG_BTREE: load sort found oid(%d, %d, %d)"
+			 ", class_oid(%d, %d, %d), btid(%d, (%d, %d), mvcc_info=%llu | %llu.",
+			 sort_args->cur_oid.volid, sort_args->cur_oid.pageid, sort_args->cur_oid.slotid,
+			 sort_args->class_ids[sort_args->cur_class].volid,
+			 sort_args->class_ids[sort_args->cur_class].pageid,
+			 sort_args->class_ids[sort_args->cur_class].slotid, sort_args->btid->sys_btid->root_pageid,
+			 sort_args->btid->sys_btid->vfid.volid, sort_args->btid->sys_btid->vfid.fileid,
+			 MVCC_IS_FLAG_SET (&mvcc_header,
+					   OR_MVCC_FLAG_VALID_INSID) ? MVCC_GET_INSID (&mvcc_header) :
+			 MVCCID_ALL_VISIBLE, MVCC_IS_FLAG_SET (&mvcc_header,
+							       OR_MVCC_FLAG_VALID_DELID) ?
+			 MVCC_GET_DELID (&mvcc_header) : MVCCID_NULL);
 	}
 
-      if (snapshot_dirty_satisfied == SNAPSHOT_SATISFIED)
+      assert (buf.ptr == PTR_ALIGN (buf.ptr, INT_ALIGNMENT));
+
+      if (sort_args->key_type->type->data_writeval (&buf, dbvalue_ptr) != NO_ERROR)
 	{
-	  /* All objects that were not candidates for vacuum are loaded, but statistics should only care for objects
-	   * that have not been deleted and committed at the time of load. */
-	  sort_args->n_oids++;	/* Increment the OID counter */
+	  goto nofit;
 	}
 
-      if (key_len > 0)
+      temp_recdes->length = CAST_STRLEN (buf.ptr - buf.buffer);
+
+      if (dbvalue_ptr == &dbvalue || dbvalue_ptr->need_clear == true)
 	{
-	  return SORT_SUCCESS;
+	  pr_clear_value (dbvalue_ptr);
 	}
+    }
+
+  if (snapshot_dirty_satisfied == SNAPSHOT_SATISFIED)
+    {
+      /* All objects that were not candidates for vacuum are loaded, but statistics should only care for objects
+       * that have not been deleted and committed at the time of load. */
+      sort_args->n_oids++;	/* Increment the OID counter */
+    }
 
+  if (key_len > 0)
+    {
+      return SORT_SUCCESS;
     }
-  while (true);
+
+  /* nothing to sort for this object */
+  return SORT_NOMORE_RECS;
 
 nofit:
 
@@ -5172,3 +5469,931 @@ index_builder_loader_task::execute (cubthread::entry &thread_ref)
   m_load_context.m_tasks_executed++;
 }
 // *INDENT-ON*
+
+// *INDENT-OFF*
+index_builder_sort_batch::index_builder_sort_batch ()
+  : m_area (NULL)
+  , m_area_size (0)
+  , m_length (0)
+  , m_read_pos (0)
+{
+}
+
+index_builder_sort_batch::~index_builder_sort_batch ()
+{
+  if (m_area != NULL)
+    {
+      free (m_area);
+    }
+}
+
+bool
+index_builder_sort_batch::reserve (size_t size)
+{
+  char *new_area;
+
+  if (size <= m_area_size)
+    {
+      return true;
+    }
+
+  new_area = (char *) realloc (m_area, size);
+  if (new_area == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, size);
+      return false;
+    }
+  m_area = new_area;
+  m_area_size = size;
+  return true;
+}
+
+index_builder_sort_context::index_builder_sort_context (const SORT_ARGS &sort_args, int extract_count,
+							int tran_index)
+  : m_sort_args (sort_args)
+  , m_tran_index (tran_index)
+  , m_mutex ()
+  , m_cond ()
+  , m_pages ()
+  , m_max_pages (BTREE_LOAD_PAGES_PER_EXTRACT_TASK * extract_count)
+  , m_pages_done (false)
+  , m_batches ()
+  , m_free_batches ()
+  , m_full_batches ()
+  , m_read_batch (NULL)
+  , m_running_tasks (extract_count + 1)
+  , m_aborted (false)
+  , m_error_code (NO_ERROR)
+  , m_has_error_area (false)
+  , m_n_nulls (0)
+  , m_n_oids (0)
+{
+  /* two batches for each extract task: one is filled while the other is consumed by the sort */
+  for (int i = 0; i < 2 * extract_count; i++)
+    {
+      index_builder_sort_batch *batch = new index_builder_sort_batch ();
+
+      m_batches.push_back (batch);
+      m_free_batches.push_back (batch);
+    }
+}
+
+index_builder_sort_context::~index_builder_sort_context ()
+{
+  for (index_builder_sort_batch *batch : m_batches)
+    {
+      delete batch;
+    }
+}
+
+const SORT_ARGS &
+index_builder_sort_context::get_sort_args () const
+{
+  return m_sort_args;
+}
+
+int
+index_builder_sort_context::get_tran_index () const
+{
+  return m_tran_index;
+}
+
+int
+index_builder_sort_context::get_n_nulls () const
+{
+  return m_n_nulls;
+}
+
+int
+index_builder_sort_context::get_n_oids () const
+{
+  return m_n_oids;
+}
+
+bool
+index_builder_sort_context::is_page_queue_full ()
+{
+  std::unique_lock<std::mutex> ulock (m_mutex);
+
+  return m_pages.size () >= m_max_pages;
+}
+
+/*
+ * wait_page_room () - wait until the extract tasks consume some of the queued pages
+ *
+ * return : false if the load was aborted
+ *
+ * note: the scan task must not have any page fixed while waiting
+ */
+bool
+index_builder_sort_context::wait_page_room ()
+{
+  std::unique_lock<std::mutex> ulock (m_mutex);
+
+  m_cond.wait (ulock, [this] { return m_aborted || m_pages.size () < m_max_pages; });
+  return !m_aborted;
+}
+
+/*
+ * push_page () - queue a heap page for the extract tasks
+ *
+ * vpid (in) : heap page
+ */
+void
+index_builder_sort_context::push_page (const VPID &vpid)
+{
+  std::unique_lock<std::mutex> ulock (m_mutex);
+
+  m_pages.push_back (vpid);
+  m_cond.notify_all ();
+}
+
+void
+index_builder_sort_context::end_pages ()
+{
+  std::unique_lock<std::mutex> ulock (m_mutex);
+
+  m_pages_done = true;
+  m_cond.notify_all ();
+}
+
+/*
+ * pop_page () - get the next queued heap page
+ *
+ * return     : false if there are no more pages or if the load was aborted
+ * vpid (out) : heap page
+ */
+bool
+index_builder_sort_context::pop_page (VPID &vpid)
+{
+  std::unique_lock<std::mutex> ulock (m_mutex);
+
+  m_cond.wait (ulock, [this] { return m_aborted || m_pages_done || !m_pages.empty (); });
+  if (m_aborted || m_pages.empty ())
+    {
+      return false;
+    }
+  vpid = m_pages.front ();
+  m_pages.pop_front ();
+  m_cond.notify_all ();
+  return true;
+}
+
+/*
+ * get_free_batch () - get an empty batch; wait until the sort consumes one
+ *
+ * return : empty batch or NULL if the load was aborted
+ */
+index_builder_sort_batch *
+index_builder_sort_context::get_free_batch ()
+{
+  std::unique_lock<std::mutex> ulock (m_mutex);
+  index_builder_sort_batch *batch;
+
+  m_cond.wait (ulock, [this] { return m_aborted || !m_free_batches.empty (); });
+  if (m_aborted)
+    {
+      return NULL;
+    }
+  batch = m_free_batches.back ();
+  m_free_batches.pop_back ();
+  return batch;
+}
+
+void
+index_builder_sort_context::push_full_batch (index_builder_sort_batch *batch)
+{
+  std::unique_lock<std::mutex> ulock (m_mutex);
+
+  if (batch->m_length == 0)
+    {
+      m_free_batches.push_back (batch);
+    }
+  else
+    {
+      batch->m_read_pos = 0;
+      m_full_batches.push_back (batch);
+    }
+  m_cond.notify_all ();
+}
+
+/*
+ * set_error () - save the error of a task and abort the load
+ *
+ * error_code (in) : error code
+ */
+void
+index_builder_sort_context::set_error (int error_code)
+{
+  std::unique_lock<std::mutex> ulock (m_mutex);
+
+  if (m_error_code == NO_ERROR)
+    {
+      int length = (int) OR_ALIGNED_BUF_SIZE (m_error_area);
+
+      /* the error is set on the task thread; keep it to set it again on the sort thread */
+      m_error_code = error_code;
+      m_has_error_area = (er_errid () == error_code
+			  && er_get_area_error (OR_ALIGNED_BUF_START (m_error_area), &length) != NULL);
+    }
+  m_aborted = true;
+  m_cond.notify_all ();
+}
+
+void
+index_builder_sort_context::task_done (int n_nulls, int n_oids)
+{
+  std::unique_lock<std::mutex> ulock (m_mutex);
+
+  m_n_nulls += n_nulls;
+  m_n_oids += n_oids;
+  m_running_tasks--;
+  m_cond.notify_all ();
+}
+
+/*
+ * get_next () - hand the next sort item produced by the extract tasks to the sort
+ *
+ * return	     : SORT_STATUS
+ * thread_p (in)     : sort thread
+ * temp_recdes (out) : where to put the sort item
+ */
+SORT_STATUS
+index_builder_sort_context::get_next (THREAD_ENTRY *thread_p, RECDES *temp_recdes)
+{
+  const size_t header_size = DB_ALIGN (OR_INT_SIZE, MAX_ALIGNMENT);
+
+  while (true)
+    {
+      if (m_read_batch != NULL && m_read_batch->m_read_pos < m_read_batch->m_length)
+	{
+	  char *item = m_read_batch->m_area + m_read_batch->m_read_pos;
+	  int length = OR_GET_INT (item);
+
+	  if (temp_recdes->area_size < length)
+	    {
+	      temp_recdes->length = length;
+	      return SORT_REC_DOESNT_FIT;
+	    }
+	  memcpy (temp_recdes->data, item + header_size, length);
+	  temp_recdes->length = length;
+	  m_read_batch->m_read_pos += header_size + DB_ALIGN (length, MAX_ALIGNMENT);
+	  return SORT_SUCCESS;
+	}
+
+      std::unique_lock<std::mutex> ulock (m_mutex);
+
+      if (m_read_batch != NULL)
+	{
+	  /* give the consumed batch back to the extract tasks */
+	  m_read_batch->m_length = 0;
+	  m_read_batch->m_read_pos = 0;
+	  m_free_batches.push_back (m_read_batch);
+	  m_read_batch = NULL;
+	  m_cond.notify_all ();
+	}
+
+      while (m_full_batches.empty () && m_running_tasks > 0 && m_error_code == NO_ERROR)
+	{
+	  bool dummy_continue_checking = true;
+
+	  m_cond.wait_for (ulock, std::chrono::milliseconds (10));
+
+	  /* Check for interrupts. */
+	  if (logtb_is_interrupted (thread_p, true, &dummy_continue_checking))
+	    {
+	      m_aborted = true;
+	      m_cond.notify_all ();
+	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_INTERRUPTED, 0);
+	      return SORT_ERROR_OCCURRED;
+	    }
+	}
+
+      if (m_error_code != NO_ERROR)
+	{
+	  if (m_has_error_area)
+	    {
+	      (void) er_set_area_error (OR_ALIGNED_BUF_START (m_error_area));
+	    }
+	  else
+	    {
+	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_IB_ERROR_ABORT, 0);
+	    }
+	  return SORT_ERROR_OCCURRED;
+	}
+
+      if (m_full_batches.empty ())
+	{
+	  /* all tasks are done */
+	  assert (m_running_tasks == 0);
+	  return SORT_NOMORE_RECS;
+	}
+
+      m_read_batch = m_full_batches.front ();
+      m_full_batches.pop_front ();
+    }
+}
+
+/*
+ * abort_and_wait () - stop the tasks that are still running and wait for all of them to end
+ */
+void
+index_builder_sort_context::abort_and_wait ()
+{
+  std::unique_lock<std::mutex> ulock (m_mutex);
+
+  m_aborted = true;
+  m_cond.notify_all ();
+  m_cond.wait (ulock, [this] { return m_running_tasks == 0; });
+}
+
+index_builder_scan_task::index_builder_scan_task (index_builder_sort_context &sort_context)
+  : m_sort_context (sort_context)
+  , m_queued_pages ()
+{
+}
+
+/*
+ * execute () - walk the heap page chain and queue the pages for the extract tasks
+ *
+ * thread_ref (in) : worker thread
+ *
+ * note: No page is kept fixed while the scan waits for the extract tasks; it would block vacuum and the replacement
+ *	 of the page, and an extract task could wait for the page behind a writer waiting for its latch. The walk is
+ *	 resumed from the last page, fixed again. If vacuum removed that page meanwhile, the chain is walked again from
+ *	 its first page, which is never removed; the chain only loses pages during the load, so the pages already
+ *	 queued are found again and skipped.
+ */
+void
+index_builder_scan_task::execute (cubthread::entry &thread_ref)
+{
+  THREAD_ENTRY *thread_p = &thread_ref;
+  const HFID *hfid = &m_sort_context.get_sort_args ().hfids[0];
+  PGBUF_WATCHER curr_page_watcher;
+  PGBUF_WATCHER old_page_watcher;
+  VPID vpid, curr_vpid;
+  bool is_valid;
+  int error_code = NO_ERROR;
+
+  PGBUF_INIT_WATCHER (&curr_page_watcher, PGBUF_ORDERED_HEAP_NORMAL, hfid);
+  PGBUF_INIT_WATCHER (&old_page_watcher, PGBUF_ORDERED_HEAP_NORMAL, hfid);
+
+  vpid.volid = hfid->vfid.volid;
+  vpid.pageid = hfid->hpgid;
+
+  while (!VPID_ISNULL (&vpid))
+    {
+      /* keep the previous page fixed until the next one is fixed, so it cannot be removed from the chain */
+      error_code = pgbuf_ordered_fix (thread_p, &vpid, OLD_PAGE_PREVENT_DEALLOC, PGBUF_LATCH_READ, &curr_page_watcher);
+      if (old_page_watcher.pgptr != NULL)
+	{
+	  pgbuf_ordered_unfix (thread_p, &old_page_watcher);
+	}
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  break;
+	}
+      curr_vpid = vpid;
+
+      if (mark_queued (curr_vpid))
+	{
+	  m_sort_context.push_page (curr_vpid);
+	}
+
+      error_code = heap_vpid_next (thread_p, hfid, curr_page_watcher.pgptr, &vpid);
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  break;
+	}
+
+      if (!VPID_ISNULL (&vpid) && m_sort_context.is_page_queue_full ())
+	{
+	  pgbuf_ordered_unfix (thread_p, &curr_page_watcher);
+	  if (!m_sort_context.wait_page_room ())
+	    {
+	      /* load was aborted */
+	      break;
+	    }
+
+	  error_code = fix_queued_page (thread_p, curr_vpid, &curr_page_watcher, &is_valid);
+	  if (error_code != NO_ERROR)
+	    {
+	      break;
+	    }
+	  if (!is_valid)
+	    {
+	      /* the page was removed from the chain */
+	      vpid.volid = hfid->vfid.volid;
+	      vpid.pageid = hfid->hpgid;
+	      continue;
+	    }
+
+	  error_code = heap_vpid_next (thread_p, hfid, curr_page_watcher.pgptr, &vpid);
+	  if (error_code != NO_ERROR)
+	    {
+	      ASSERT_ERROR ();
+	      break;
+	    }
+	}
+      pgbuf_replace_watcher (thread_p, &curr_page_watcher, &old_page_watcher);
+    }
+
+  if (curr_page_watcher.pgptr != NULL)
+    {
+      pgbuf_ordered_unfix (thread_p, &curr_page_watcher);
+    }
+  if (old_page_watcher.pgptr != NULL)
+    {
+      pgbuf_ordered_unfix (thread_p, &old_page_watcher);
+    }
+
+  if (error_code != NO_ERROR)
+    {
+      m_sort_context.set_error (error_code);
+    }
+  m_sort_context.end_pages ();
+  m_sort_context.task_done (0, 0);
+}
+
+/*
+ * mark_queued () - remember that a page is queued
+ *
+ * return    : false if the page was already queued
+ * vpid (in) : heap page
+ */
+bool
+index_builder_scan_task::mark_queued (const VPID &vpid)
+{
+  assert (vpid.volid >= 0 && vpid.pageid >= 0);
+
+  if (m_queued_pages.size () <= (size_t) vpid.volid)
+    {
+      m_queued_pages.resize (vpid.volid + 1);
+    }
+
+  std::vector<bool> &volume_pages = m_queued_pages[vpid.volid];
+
+  if (volume_pages.size () <= (size_t) vpid.pageid)
+    {
+      volume_pages.resize (vpid.pageid + 1, false);
+    }
+  if (volume_pages[vpid.pageid])
+    {
+      return false;
+    }
+  volume_pages[vpid.pageid] = true;
+  return true;
+}
+
+/*
+ * fix_queued_page () - fix again a queued page, unless it was removed from the heap
+ *
+ * return	     : error code
+ * thread_p (in)     : worker thread
+ * vpid (in)	     : heap page
+ * page_watcher (in) : watcher to fix the page with
+ * is_valid (out)    : false if the page is no longer a page of the heap
+ */
+int
+index_builder_scan_task::fix_queued_page (THREAD_ENTRY *thread_p, const VPID &vpid, PGBUF_WATCHER *page_watcher,
+					  bool *is_valid)
+{
+  int error_code;
+
+  *is_valid = false;
+
+  error_code = pgbuf_ordered_fix (thread_p, &vpid, OLD_PAGE_MAYBE_DEALLOCATED, PGBUF_LATCH_READ, page_watcher);
+  if (error_code != NO_ERROR)
+    {
+      if (error_code == ER_PB_BAD_PAGEID)
+	{
+	  er_clear ();
+	  return NO_ERROR;
+	}
+      ASSERT_ERROR ();
+      return error_code;
+    }
+
+  if (!btree_load_is_heap_page_of_class (thread_p, page_watcher->pgptr,
+					 &m_sort_context.get_sort_args ().class_ids[0]))
+    {
+      /* deallocated and reused by another file */
+      pgbuf_ordered_unfix (thread_p, page_watcher);
+      return NO_ERROR;
+    }
+
+  *is_valid = true;
+  return NO_ERROR;
+}
+
+index_builder_extract_task::index_builder_extract_task (index_builder_sort_context &sort_context)
+  : m_sort_context (sort_context)
+  , m_sort_args (sort_context.get_sort_args ())
+  , m_filter (NULL)
+  , m_func_index_info ()
+  , m_func_unpack_info (NULL)
+  , m_scancache_inited (false)
+  , m_attrinfo_inited (false)
+  , m_batch (NULL)
+  , m_slots ()
+  , m_objects ()
+  , m_record_area ()
+{
+}
+
+/*
+ * execute () - produce the sort items of the objects in the queued heap pages
+ *
+ * thread_ref (in) : worker thread
+ */
+void
+index_builder_extract_task::execute (cubthread::entry &thread_ref)
+{
+  THREAD_ENTRY *thread_p = &thread_ref;
+  int save_tran_index = thread_ref.tran_index;
+  VPID vpid;
+  int error_code = NO_ERROR;
+
+  /* objects are checked against the transaction that builds the index */
+  thread_ref.tran_index = m_sort_context.get_tran_index ();
+
+  m_sort_args.n_nulls = 0;
+  m_sort_args.n_oids = 0;
+
+  error_code = start_scan (thread_p);
+  if (error_code == NO_ERROR)
+    {
+      while (m_sort_context.pop_page (vpid))
+	{
+	  error_code = extract_page (thread_p, vpid);
+	  if (error_code != NO_ERROR)
+	    {
+	      break;
+	    }
+	}
+    }
+
+  if (m_batch != NULL)
+    {
+      m_sort_context.push_full_batch (m_batch);
+      m_batch = NULL;
+    }
+
+  end_scan (thread_p);
+
+  if (error_code != NO_ERROR)
+    {
+      m_sort_context.set_error (error_code);
+    }
+
+  thread_ref.tran_index = save_tran_index;
+  m_sort_context.task_done (m_sort_args.n_nulls, m_sort_args.n_oids);
+}
+
+/*
+ * start_scan () - prepare the private copy of the sort arguments: scan cache, attribute caches and the predicates,
+ *		   which cannot be shared between threads
+ *
+ * return	 : error code
+ * thread_p (in) : worker thread
+ */
+int
+index_builder_extract_task::start_scan (THREAD_ENTRY *thread_p)
+{
+  const SORT_ARGS &sort_args = m_sort_context.get_sort_args ();
+  DB_TYPE single_node_type = DB_TYPE_NULL;
+  int attr_offset = m_sort_args.cur_class * m_sort_args.n_attrs;
+  int error_code = NO_ERROR;
+
+  m_sort_args.filter = NULL;
+  m_sort_args.filter_eval_func = NULL;
+  m_sort_args.func_index_info = NULL;
+  m_sort_args.parallel = NULL;
+
+  if (sort_args.filter != NULL)
+    {
+      error_code = stx_map_stream_to_filter_pred (thread_p, &m_filter, sort_args.pred_stream,
+						  sort_args.pred_stream_size);
+      if (error_code != NO_ERROR)
+	{
+	  return error_code;
+	}
+      m_sort_args.filter = m_filter;
+      m_sort_args.filter_eval_func = eval_fnc (thread_p, m_filter->pred, &single_node_type);
+    }
+  if (sort_args.func_index_info != NULL)
+    {
+      m_func_index_info = *sort_args.func_index_info;
+      m_func_index_info.expr = NULL;
+      error_code = stx_map_stream_to_func_pred (thread_p, &m_func_index_info.expr, m_func_index_info.expr_stream,
+						m_func_index_info.expr_stream_size, &m_func_unpack_info);
+      if (error_code != NO_ERROR)
+	{
+	  return error_code;
+	}
+      m_sort_args.func_index_info = &m_func_index_info;
+    }
+
+  error_code = heap_scancache_start (thread_p, &m_sort_args.hfscan_cache, &m_sort_args.hfids[0],
+				     &m_sort_args.class_ids[0], true, false, NULL);
+  if (error_code != NO_ERROR)
+    {
+      return error_code;
+    }
+  m_scancache_inited = true;
+
+  error_code = heap_attrinfo_start (thread_p, &m_sort_args.class_ids[0], m_sort_args.n_attrs,
+				    &m_sort_args.attr_ids[attr_offset], &m_sort_args.attr_info);
+  if (error_code != NO_ERROR)
+    {
+      return error_code;
+    }
+  m_attrinfo_inited = true;
+  if (m_sort_args.filter != NULL)
+    {
+      error_code = heap_attrinfo_start (thread_p, &m_sort_args.class_ids[0], m_sort_args.filter->num_attrs_pred,
+					m_sort_args.filter->attrids_pred, m_sort_args.filter->cache_pred);
+      if (error_code != NO_ERROR)
+	{
+	  return error_code;
+	}
+    }
+  if (m_sort_args.func_index_info != NULL)
+    {
+      error_code = heap_attrinfo_start (thread_p, &m_sort_args.class_ids[0], m_sort_args.n_attrs,
+					&m_sort_args.attr_ids[attr_offset],
+					m_sort_args.func_index_info->expr->cache_attrinfo);
+      if (error_code != NO_ERROR)
+	{
+	  return error_code;
+	}
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * end_scan () - release what start_scan prepared
+ *
+ * thread_p (in) : worker thread
+ */
+void
+index_builder_extract_task::end_scan (THREAD_ENTRY *thread_p)
+{
+  if (m_attrinfo_inited)
+    {
+      heap_attrinfo_end (thread_p, &m_sort_args.attr_info);
+      if (m_sort_args.filter != NULL)
+	{
+	  heap_attrinfo_end (thread_p, m_sort_args.filter->cache_pred);
+	}
+      if (m_sort_args.func_index_info != NULL)
+	{
+	  heap_attrinfo_end (thread_p, m_sort_args.func_index_info->expr->cache_attrinfo);
+	}
+      m_attrinfo_inited = false;
+    }
+  if (m_scancache_inited)
+    {
+      (void) heap_scancache_end (thread_p, &m_sort_args.hfscan_cache);
+      m_scancache_inited = false;
+    }
+
+  if (m_filter != NULL)
+    {
+      /* to clear db values from dbvalue regu variable */
+      qexec_clear_pred_context (thread_p, m_filter, true);
+      if (m_filter->unpack_info != NULL)
+	{
+	  free_xasl_unpack_info (thread_p, m_filter->unpack_info);
+	}
+      db_private_free_and_init (thread_p, m_filter);
+    }
+  if (m_func_index_info.expr != NULL)
+    {
+      (void) qexec_clear_func_pred (thread_p, m_func_index_info.expr);
+      m_func_index_info.expr = NULL;
+    }
+  if (m_func_unpack_info != NULL)
+    {
+      free_xasl_unpack_info (thread_p, m_func_unpack_info);
+    }
+}
+
+/*
+ * extract_page () - produce the sort items of the objects in a heap page
+ *
+ * return	 : error code
+ * thread_p (in) : worker thread
+ * vpid (in)	 : heap page
+ *
+ * note: The visible versions of the objects are copied out of the page first and the page is unfixed before the sort
+ *	 items are produced, since producing them may wait for the sort to consume a batch.
+ */
+int
+index_builder_extract_task::extract_page (THREAD_ENTRY *thread_p, const VPID &vpid)
+{
+  HEAP_SCANCACHE *scan_cache = &m_sort_args.hfscan_cache;
+  RECDES peek_recdes;
+  PGSLOTID slotid;
+  INT16 rec_type;
+  OID oid;
+  int error_code = NO_ERROR;
+
+  /* the page is fixed in the scan cache, so the objects are read without fixing it again */
+  error_code = pgbuf_ordered_fix (thread_p, &vpid, OLD_PAGE_MAYBE_DEALLOCATED, PGBUF_LATCH_READ,
+				  &scan_cache->page_watcher);
+  if (error_code != NO_ERROR)
+    {
+      if (error_code == ER_PB_BAD_PAGEID)
+	{
+	  /* the page was emptied and removed by vacuum after it was queued */
+	  er_clear ();
+	  return NO_ERROR;
+	}
+      ASSERT_ERROR ();
+      return error_code;
+    }
+  if (!btree_load_is_heap_page_of_class (thread_p, scan_cache->page_watcher.pgptr, &m_sort_args.class_ids[0]))
+    {
+      /* removed after it was queued and reused by another file */
+      pgbuf_ordered_unfix (thread_p, &scan_cache->page_watcher);
+      return NO_ERROR;
+    }
+
+  m_slots.clear ();
+  slotid = NULL_SLOTID;
+  while (spage_next_record (scan_cache->page_watcher.pgptr, &slotid, &peek_recdes, PEEK) == S_SUCCESS)
+    {
+      if (slotid == HEAP_HEADER_AND_CHAIN_SLOTID)
+	{
+	  /* skip the header */
+	  continue;
+	}
+      rec_type = spage_get_record_type (scan_cache->page_watcher.pgptr, slotid);
+      if (rec_type == REC_NEWHOME || rec_type == REC_ASSIGN_ADDRESS || rec_type == REC_UNKNOWN)
+	{
+	  /* not an object; relocated objects are read from their relocation slot */
+	  continue;
+	}
+      m_slots.push_back (slotid);
+    }
+
+  m_objects.clear ();
+  m_record_area.clear ();
+  for (PGSLOTID object_slotid : m_slots)
+    {
+      oid.volid = vpid.volid;
+      oid.pageid = vpid.pageid;
+      oid.slotid = object_slotid;
+
+      error_code = copy_object (thread_p, oid);
+      if (error_code != NO_ERROR)
+	{
+	  break;
+	}
+    }
+
+  if (scan_cache->page_watcher.pgptr != NULL)
+    {
+      pgbuf_ordered_unfix (thread_p, &scan_cache->page_watcher);
+    }
+  if (error_code != NO_ERROR)
+    {
+      return error_code;
+    }
+
+  for (const copied_object &object : m_objects)
+    {
+      m_sort_args.cur_oid = object.oid;
+      m_sort_args.in_recdes.data = m_record_area.data () + object.offset;
+      m_sort_args.in_recdes.length = object.length;
+      m_sort_args.in_recdes.area_size = object.length;
+      m_sort_args.in_recdes.type = object.type;
+
+      error_code = add_sort_item (thread_p);
+      if (error_code != NO_ERROR)
+	{
+	  break;
+	}
+    }
+  m_sort_args.in_recdes.data = NULL;
+
+  return error_code;
+}
+
+/*
+ * copy_object () - copy the visible version of an object of the fixed page to the record area
+ *
+ * return	 : error code
+ * thread_p (in) : worker thread
+ * oid (in)	 : object identifier
+ */
+int
+index_builder_extract_task::copy_object (THREAD_ENTRY *thread_p, const OID &oid)
+{
+  copied_object object;
+  int error_code = NO_ERROR;
+
+  m_sort_args.cur_oid = oid;
+  m_sort_args.in_recdes.data = NULL;
+
+  switch (heap_scan_get_visible_version (thread_p, &m_sort_args.cur_oid, &m_sort_args.class_ids[0],
+					 &m_sort_args.in_recdes, &m_sort_args.hfscan_cache, PEEK, NULL_CHN))
+    {
+    case S_SUCCESS:
+      break;
+    case S_DOESNT_EXIST:
+      return NO_ERROR;
+    default:
+      ASSERT_ERROR_AND_SET (error_code);
+      return error_code;
+    }
+
+  object.oid = oid;
+  object.offset = DB_ALIGN (m_record_area.size (), MAX_ALIGNMENT);
+  object.length = m_sort_args.in_recdes.length;
+  object.type = m_sort_args.in_recdes.type;
+
+  m_record_area.resize (object.offset + object.length);
+  memcpy (m_record_area.data () + object.offset, m_sort_args.in_recdes.data, object.length);
+  m_objects.push_back (object);
+
+  return NO_ERROR;
+}
+
+/*
+ * add_sort_item () - produce the sort item of the current object into the batch; hand full batches to the sort
+ *
+ * return	 : error code
+ * thread_p (in) : worker thread
+ */
+int
+index_builder_extract_task::add_sort_item (THREAD_ENTRY *thread_p)
+{
+  const size_t header_size = DB_ALIGN (OR_INT_SIZE, MAX_ALIGNMENT);
+  RECDES temp_recdes;
+  SORT_STATUS status;
+  int error_code = NO_ERROR;
+
+  while (true)
+    {
+      if (m_batch == NULL)
+	{
+	  m_batch = m_sort_context.get_free_batch ();
+	  if (m_batch == NULL)
+	    {
+	      /* load was aborted; the error, if any, was already set */
+	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_IB_ERROR_ABORT, 0);
+	      return ER_IB_ERROR_ABORT;
+	    }
+	  if (!m_batch->reserve (BTREE_LOAD_SORT_BATCH_SIZE))
+	    {
+	      ASSERT_ERROR_AND_SET (error_code);
+	      return error_code;
+	    }
+	}
+
+      temp_recdes.data = m_batch->m_area + m_batch->m_length + header_size;
+      temp_recdes.area_size = (int) MAX ((int) m_batch->m_area_size - (int) (m_batch->m_length + header_size), 0);
+      temp_recdes.length = 0;
+
+      status = btree_sort_make_record (thread_p, &m_sort_args, &temp_recdes);
+      switch (status)
+	{
+	case SORT_SUCCESS:
+	  OR_PUT_INT (m_batch->m_area + m_batch->m_length, temp_recdes.length);
+	  m_batch->m_length += header_size + DB_ALIGN (temp_recdes.length, MAX_ALIGNMENT);
+	  return NO_ERROR;
+
+	case SORT_NOMORE_RECS:
+	  /* the object does not produce a sort item */
+	  return NO_ERROR;
+
+	case SORT_REC_DOESNT_FIT:
+	  if (m_batch->m_length == 0)
+	    {
+	      /* item bigger than the whole batch */
+	      if (!m_batch->reserve (header_size + DB_ALIGN (temp_recdes.length, MAX_ALIGNMENT)))
+		{
+		  ASSERT_ERROR_AND_SET (error_code);
+		  return error_code;
+		}
+	    }
+	  else
+	    {
+	      m_sort_context.push_full_batch (m_batch);
+	      m_batch = NULL;
+	    }
+	  break;
+
+	case SORT_ERROR_OCCURRED:
+	default:
+	  ASSERT_ERROR_AND_SET (error_code);
+	  return error_code;
+	}
+    }
+}
+// *INDENT-ON*
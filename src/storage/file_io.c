@@ -4009,6 +4009,23 @@ fileio_read (THREAD_ENTRY * thread_p, int vol_fd, void *io_page_p, PAGEID page_i
   return io_page_p;
 }
 
+/*
+ * fileio_prefetch () - ASK THE OPERATING SYSTEM TO READ A PAGE IN THE BACKGROUND
+ *   return: void
+ *   vol_fd(in): Volume descriptor
+ *   page_id(in): Page identifier
+ *   page_size(in): Page size
+ *
+ * Note: This is only a hint; the page is still read by fileio_read, hopefully from the file system cache.
+ */
+void
+fileio_prefetch (int vol_fd, PAGEID page_id, size_t page_size)
+{
+#if _POSIX_C_SOURCE >= 200112L
+  (void) posix_fadvise (vol_fd, FILEIO_GET_FILE_SIZE (page_size, page_id), page_size, POSIX_FADV_WILLNEED);
+#endif /* _POSIX_C_SOURCE >= 200112L */
+}
+
 /*
  * fileio_write_or_add_to_dwb () - Write a page to disk if DWb disabled, otherwise add it to DWB
  *   return: io_page_p on success, NULL on failure
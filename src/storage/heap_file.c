@@ -45,6 +45,8 @@
 #include "locator_sr.h"
 #include "btree.h"
 #include "btree_unique.hpp"
+#include "heap_free_space_map.hpp"
+#include "heap_zone_map.hpp"
 #include "transform.h"		/* for CT_SERIAL_NAME */
 #include "serial.h"
 #include "object_primitive.h"
@@ -488,6 +490,8 @@ struct heap_show_scan_ctx
 static int heap_Maxslotted_reclength;
 static int heap_Slotted_overhead = 4;	/* sizeof (SPAGE_SLOT) */
 static const int heap_Find_best_page_limit = 100;
+static const int heap_Fsm_walk_pages = 32;	/* pages of the heap chain walked at once for the free space map */
+static const int heap_Fsm_search_max_count = 20;	/* candidate pages tried by one search */
 
 static HEAP_CLASSREPR_CACHE *heap_Classrepr = NULL;
 static HEAP_CHNGUESS heap_Guesschn_area = { NULL, NULL, NULL, false, 0,
@@ -628,6 +632,10 @@ static HEAP_FINDSPACE heap_stats_find_page_in_bestspace (THREAD_ENTRY * thread_p
 							 HEAP_BESTSPACE * bestspace, int *idx_badspace,
 							 int record_length, int needed_space,
 							 HEAP_SCANCACHE * scan_cache, PGBUF_WATCHER * pg_watcher);
+static HEAP_FINDSPACE heap_stats_find_page_in_fsm (THREAD_ENTRY * thread_p, const HFID * hfid, int record_length,
+						   int needed_space, HEAP_SCANCACHE * scan_cache,
+						   PGBUF_WATCHER * pg_watcher);
+static int heap_stats_walk_fsm (THREAD_ENTRY * thread_p, const HFID * hfid, int max_pages);
 static PAGE_PTR heap_stats_find_best_page (THREAD_ENTRY * thread_p, const HFID * hfid, int needed_space, bool isnew_rec,
 					   int newrec_size, HEAP_SCANCACHE * space_cache, PGBUF_WATCHER * pg_watcher);
 static int heap_stats_sync_bestspace (THREAD_ENTRY * thread_p, const HFID * hfid, HEAP_HDR_STATS * heap_hdr,
@@ -2941,6 +2949,8 @@ heap_stats_update (THREAD_ENTRY * thread_p, PAGE_PTR pgptr, const HFID * hfid, i
   bool need_update;
 
   freespace = spage_get_free_space_without_saving (thread_p, pgptr, &need_update);
+  heap_fsm_set_free_space (hfid, pgbuf_get_vpid_ptr (pgptr), freespace);
+
   if (prm_get_integer_value (PRM_ID_HF_MAX_BESTSPACE_ENTRIES) > 0)
     {
       if (prev_freespace < freespace)
@@ -3408,6 +3418,7 @@ heap_stats_find_page_in_bestspace (THREAD_ENTRY * thread_p, const HFID * hfid, H
 	      /* Add or refresh the free space of the page */
 	      (void) heap_stats_add_bestspace (thread_p, hfid, &best.vpid, best.freespace);
 	    }
+	  heap_fsm_set_free_space (hfid, &best.vpid, best.freespace);
 
 	  if (best_hint_is_used == true)
 	    {
@@ -3469,6 +3480,182 @@ heap_stats_find_page_in_bestspace (THREAD_ENTRY * thread_p, const HFID * hfid, H
   return found;
 }
 
+/*
+ * heap_stats_find_page_in_fsm () - Find a page with the needed space using the free space map of the heap
+ *   return: HEAP_FINDSPACE (found, not found, or error)
+ *   hfid(in): Object heap file identifier
+ *   record_length(in): Length of the record to insert
+ *   needed_space(in): The needed space
+ *   scan_cache(in): Scan cache if any
+ *   pg_watcher(out): Page with enough space, fixed for write, or unfixed if not found
+ *
+ * Note: Pages suggested by the free space map are checked after they are fixed and their real free space is saved
+ *       back to the map. No pages are read other than the suggested ones.
+ *       The caller must hold the heap header page in exclusive mode.
+ */
+static HEAP_FINDSPACE
+heap_stats_find_page_in_fsm (THREAD_ENTRY * thread_p, const HFID * hfid, int record_length, int needed_space,
+			     HEAP_SCANCACHE * scan_cache, PGBUF_WATCHER * pg_watcher)
+{
+  HEAP_FINDSPACE found = HEAP_FINDSPACE_NOTFOUND;
+  VPID vpid;
+  int old_wait_msecs;
+  int free_space;
+  int search_count = 0;
+
+  assert (PGBUF_IS_CLEAN_WATCHER (pg_watcher));
+
+  /* Do not wait for busy pages; look for other pages in the map instead. */
+  /* LK_FORCE_ZERO_WAIT doesn't set error when deadlock occurs */
+  old_wait_msecs = xlogtb_reset_wait_msecs (thread_p, LK_FORCE_ZERO_WAIT);
+
+  VPID_SET_NULL (&vpid);
+  while (found == HEAP_FINDSPACE_NOTFOUND && search_count < heap_Fsm_search_max_count)
+    {
+      if (!heap_fsm_find_page (hfid, needed_space, &vpid))
+	{
+	  break;
+	}
+      search_count++;
+
+      /* If page could not be fixed, we will interrogate er_errid () to see the error type. Make sure an error is not
+       * set. */
+      if (er_errid () != NO_ERROR)
+	{
+	  if (er_errid () == ER_INTERRUPTED)
+	    {
+	      /* interrupt arrives at any time */
+	      break;
+	    }
+#if defined (SERVER_MODE)
+	  // ignores a warning and expects no other errors
+	  assert (er_errid_if_has_error () == NO_ERROR);
+#endif /* SERVER_MODE */
+	  er_clear ();
+	}
+
+      pg_watcher->pgptr = heap_scan_pb_lock_and_fetch (thread_p, &vpid, OLD_PAGE, X_LOCK, scan_cache, pg_watcher);
+      if (pg_watcher->pgptr == NULL)
+	{
+	  switch (er_errid ())
+	    {
+	    case NO_ERROR:
+	      /* latch timeout; continue with the next page of the map */
+	      break;
+
+	    case ER_INTERRUPTED:
+	      found = HEAP_FINDSPACE_ERROR;
+	      break;
+
+	    default:
+	      /* Something went wrong, we are unable to fetch this page. */
+	      heap_fsm_remove_page (hfid, &vpid);
+	      found = HEAP_FINDSPACE_ERROR;
+
+	      /* Do not allow unexpected errors. */
+	      assert (false);
+	      break;
+	    }
+	  continue;
+	}
+
+      free_space = spage_max_space_for_new_record (thread_p, pg_watcher->pgptr);
+      if (free_space >= needed_space)
+	{
+	  /* Decrement by only the amount space needed by the caller. Don't include the unfill factor */
+	  free_space -= record_length + heap_Slotted_overhead;
+	  found = HEAP_FINDSPACE_FOUND;
+	}
+      else
+	{
+	  pgbuf_ordered_unfix (thread_p, pg_watcher);
+	}
+
+      /* correct the map with the real free space of the page */
+      heap_fsm_set_free_space (hfid, &vpid, free_space);
+    }
+
+  /* Reset back the timeout value of the transaction */
+  (void) xlogtb_reset_wait_msecs (thread_p, old_wait_msecs);
+
+  return found;
+}
+
+/*
+ * heap_stats_walk_fsm () - Walk pages of the heap chain to save their free space into the free space map
+ *   return: NO_ERROR or error code
+ *   hfid(in): Object heap file identifier
+ *   max_pages(in): Maximum number of pages to walk
+ *
+ * Note: The walk starts where the previous walk of the heap stopped. When it reaches the end of the chain, the map
+ *       is complete and the next walk starts again from the header page, refreshing the map.
+ *       The caller must hold the heap header page in exclusive mode. This function does not do any logging.
+ */
+static int
+heap_stats_walk_fsm (THREAD_ENTRY * thread_p, const HFID * hfid, int max_pages)
+{
+  VPID vpid, next_vpid;
+  PGBUF_WATCHER pg_watcher;
+  PGBUF_WATCHER old_pg_watcher;
+  int num_pages = 0;
+  int error_code = NO_ERROR;
+
+  PGBUF_INIT_WATCHER (&pg_watcher, PGBUF_ORDERED_HEAP_NORMAL, hfid);
+  PGBUF_INIT_WATCHER (&old_pg_watcher, PGBUF_ORDERED_HEAP_NORMAL, hfid);
+
+  heap_fsm_get_walk_position (hfid, &next_vpid);
+  if (VPID_ISNULL (&next_vpid))
+    {
+      next_vpid.volid = hfid->vfid.volid;
+      next_vpid.pageid = hfid->hpgid;
+    }
+
+  /* Keep the previous page fixed until the next one is fixed, so the chain cannot change under the walk. The pages
+   * are not locked since the map is only a hint. */
+  while (!VPID_ISNULL (&next_vpid) && num_pages < max_pages)
+    {
+      vpid = next_vpid;
+      error_code = pgbuf_ordered_fix (thread_p, &vpid, OLD_PAGE_PREVENT_DEALLOC, PGBUF_LATCH_READ, &pg_watcher);
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  break;
+	}
+      (void) pgbuf_check_page_ptype (thread_p, pg_watcher.pgptr, PAGE_HEAP);
+
+      if (old_pg_watcher.pgptr != NULL)
+	{
+	  pgbuf_ordered_unfix (thread_p, &old_pg_watcher);
+	}
+
+      error_code = heap_vpid_next (thread_p, hfid, pg_watcher.pgptr, &next_vpid);
+      if (error_code != NO_ERROR)
+	{
+	  assert (false);
+	  pgbuf_ordered_unfix (thread_p, &pg_watcher);
+	  break;
+	}
+
+      heap_fsm_set_free_space (hfid, &vpid, spage_max_space_for_new_record (thread_p, pg_watcher.pgptr));
+      num_pages++;
+
+      pgbuf_replace_watcher (thread_p, &pg_watcher, &old_pg_watcher);
+    }
+
+  assert (pg_watcher.pgptr == NULL);
+  if (old_pg_watcher.pgptr != NULL)
+    {
+      pgbuf_ordered_unfix (thread_p, &old_pg_watcher);
+    }
+
+  if (error_code == NO_ERROR)
+    {
+      heap_fsm_set_walk_position (hfid, &next_vpid);
+    }
+
+  return error_code;
+}
+
 /*
  * heap_stats_find_best_page () - Find a page with the needed space.
  *   return: pointer to page with enough space or NULL
@@ -3499,6 +3686,7 @@ heap_stats_find_best_page (THREAD_ENTRY * thread_p, const HFID * hfid, int neede
   float other_high_best_ratio;
   PGBUF_WATCHER hdr_page_watcher;
   int error_code = NO_ERROR;
+  bool is_fsm_complete = false;
   PERF_UTIME_TRACKER time_find_best_page = PERF_UTIME_TRACKER_INITIALIZER;
 
   PERF_UTIME_TRACKER_START (thread_p, &time_find_best_page);
@@ -3563,8 +3751,24 @@ heap_stats_find_best_page (THREAD_ENTRY * thread_p, const HFID * hfid, int neede
       total_space = needed_space + heap_Slotted_overhead;
     }
 
+  if (prm_get_bool_value (PRM_ID_HEAP_FREE_SPACE_MAP))
+    {
+      if (heap_stats_find_page_in_fsm (thread_p, hfid, needed_space, total_space, scan_cache, pg_watcher)
+	  == HEAP_FINDSPACE_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  assert (pg_watcher->pgptr == NULL);
+	  pgbuf_ordered_unfix (thread_p, &hdr_page_watcher);
+	  goto error;
+	}
+
+      /* Once the free space map has learned all pages, it is the only source of pages with free space. Until then
+       * the best space hints are also searched. */
+      is_fsm_complete = heap_fsm_is_complete (hfid);
+    }
+
   try_find = 0;
-  while (true)
+  while (pg_watcher->pgptr == NULL && !is_fsm_complete)
     {
       try_find++;
       assert (pg_watcher->pgptr == NULL);
@@ -3642,6 +3846,21 @@ heap_stats_find_best_page (THREAD_ENTRY * thread_p, const HFID * hfid, int neede
 	}
     }
 
+  if (pg_watcher->pgptr == NULL && heap_fsm_need_walk (hfid))
+    {
+      /* Before growing the heap, now and then learn more pages of the chain and search the map once more. Walks are
+       * spread over the allocations, so most of them do not read any page. */
+      if (heap_stats_walk_fsm (thread_p, hfid, heap_Fsm_walk_pages) != NO_ERROR
+	  || heap_stats_find_page_in_fsm (thread_p, hfid, needed_space, total_space, scan_cache, pg_watcher)
+	  == HEAP_FINDSPACE_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  assert (pg_watcher->pgptr == NULL);
+	  pgbuf_ordered_unfix (thread_p, &hdr_page_watcher);
+	  goto error;
+	}
+    }
+
   if (pg_watcher->pgptr == NULL)
     {
       /*
@@ -3885,6 +4104,7 @@ heap_stats_sync_bestspace (THREAD_ENTRY * thread_p, const HFID * hfid, HEAP_HDR_
 	  recs_sumlen += rec_length;
 
 	  free_space = spage_max_space_for_new_record (thread_p, pg_watcher.pgptr);
+	  heap_fsm_set_free_space (hfid, &vpid, free_space);
 
 	  if (free_space >= min_freespace && free_space > HEAP_DROP_FREE_SPACE)
 	    {
@@ -4341,6 +4561,7 @@ heap_vpid_alloc (THREAD_ENTRY * thread_p, const HFID * hfid, PAGE_PTR hdr_pgptr,
     {
       (void) heap_stats_add_bestspace (thread_p, hfid, &vpid, heap_hdr->estimates.best[best].freespace);
     }
+  heap_fsm_set_free_space (hfid, &vpid, heap_hdr->estimates.best[best].freespace);
 
   /* we really have nothing to lose from logging stats here and also it is good to have a certain last VPID. */
   addr.pgptr = hdr_pgptr;
@@ -4612,6 +4833,7 @@ heap_vpid_remove (THREAD_ENTRY * thread_p, const HFID * hfid, HEAP_HDR_STATS * h
     }
 
   (void) heap_stats_del_bestspace_by_vpid (thread_p, rm_vpid);
+  heap_fsm_remove_page (hfid, rm_vpid);
 
   return rm_vpid;
 
@@ -4913,8 +5135,9 @@ heap_remove_page_on_vacuum (THREAD_ENTRY * thread_p, PAGE_PTR * page_ptr, HFID *
       goto error;
     }
 
-  /* Remove page from best space cached statistics. */
+  /* Remove page from best space cached statistics and from free space map. */
   (void) heap_stats_del_bestspace_by_vpid (thread_p, &page_vpid);
+  heap_fsm_remove_page (hfid, &page_vpid);
 
   /* Finished. */
   log_sysop_commit (thread_p);
@@ -5131,6 +5354,7 @@ heap_manager_finalize (void)
       return ret;
     }
 
+  heap_fsm_finalize ();
   heap_finalize_hfid_table ();
 
   return ret;
@@ -5278,6 +5502,7 @@ heap_create_internal (THREAD_ENTRY * thread_p, HFID * hfid, const OID * class_oi
     }
 
   (void) heap_stats_del_bestspace_by_hfid (thread_p, hfid);
+  heap_fsm_remove (hfid);
 
   pgbuf_set_page_ptype (thread_p, addr_hdr.pgptr, PAGE_HEAP);
 
@@ -5516,6 +5741,9 @@ heap_reuse (THREAD_ENTRY * thread_p, const HFID * hfid, const OID * class_oid, c
   VPID_SET_NULL (&last_vpid);
   addr.vfid = &hfid->vfid;
 
+  /* all pages are emptied; the free space map is learned again */
+  heap_fsm_remove (hfid);
+
   /*
    * Read the header page.
    * We lock the header page in exclusive mode.
@@ -5787,6 +6015,9 @@ xheap_destroy (THREAD_ENTRY * thread_p, const HFID * hfid, const OID * class_oid
   file_postpone_destroy (thread_p, &hfid->vfid);
 
   (void) heap_stats_del_bestspace_by_hfid (thread_p, hfid);
+  heap_fsm_remove (hfid);
+  heap_zone_map_remove (hfid);
+  vacuum_stats_remove_heap (hfid);
 
   return NO_ERROR;
 }
@@ -5830,6 +6061,7 @@ xheap_destroy_newly_created (THREAD_ENTRY * thread_p, const HFID * hfid, const O
   log_append_postpone (thread_p, RVHF_MARK_DELETED, &addr, sizeof (hfid->vfid), &hfid->vfid);
 
   (void) heap_stats_del_bestspace_by_hfid (thread_p, hfid);
+  heap_fsm_remove (hfid);
 
   return ret;
 }
@@ -6761,6 +6993,8 @@ heap_scancache_start_internal (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_ca
   scan_cache->start_area ();
   scan_cache->num_btids = 0;
   scan_cache->m_index_stats = NULL;
+  scan_cache->m_index_insert_batch = NULL;
+  scan_cache->m_zone_filter = NULL;
   scan_cache->debug_initpattern = HEAP_DEBUG_SCANCACHE_INITPATTERN;
   scan_cache->mvcc_snapshot = mvcc_snapshot;
   scan_cache->partition_list = NULL;
@@ -6778,6 +7012,8 @@ exit_on_error:
   PGBUF_INIT_WATCHER (&(scan_cache->page_watcher), PGBUF_ORDERED_RANK_UNDEFINED, PGBUF_ORDERED_NULL_HFID);
   scan_cache->num_btids = 0;
   scan_cache->m_index_stats = NULL;
+  scan_cache->m_index_insert_batch = NULL;
+  scan_cache->m_zone_filter = NULL;
   scan_cache->file_type = FILE_UNKNOWN_TYPE;
   scan_cache->debug_initpattern = 0;
   scan_cache->mvcc_snapshot = NULL;
@@ -7060,6 +7296,8 @@ heap_scancache_quick_start_internal (HEAP_SCANCACHE * scan_cache, const HFID * h
   scan_cache->start_area ();
   scan_cache->num_btids = 0;
   scan_cache->m_index_stats = NULL;
+  scan_cache->m_index_insert_batch = NULL;
+  scan_cache->m_zone_filter = NULL;
   scan_cache->file_type = FILE_UNKNOWN_TYPE;
   scan_cache->debug_initpattern = HEAP_DEBUG_SCANCACHE_INITPATTERN;
   scan_cache->mvcc_snapshot = NULL;
@@ -7092,6 +7330,10 @@ heap_scancache_quick_end (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache)
     {
       delete scan_cache->m_index_stats;
       scan_cache->m_index_stats = NULL;
+      delete scan_cache->m_index_insert_batch;
+      scan_cache->m_index_insert_batch = NULL;
+      heap_zone_filter_destroy (thread_p, scan_cache->m_zone_filter);
+      scan_cache->m_zone_filter = NULL;
       scan_cache->num_btids = 0;
 
       if (scan_cache->cache_last_fix_page == true)
@@ -7865,7 +8107,13 @@ heap_next_internal (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid,
 		}
 	    }
 
-	  if (get_rec_info)
+	  if (scan_cache->m_zone_filter != NULL && !get_rec_info && !reversed_direction && oid.slotid <= 0
+	      && heap_zone_filter_can_skip_page (thread_p, scan_cache->m_zone_filter, curr_page_watcher.pgptr))
+	    {
+	      /* zone map tells no record of this page can satisfy the scan filter */
+	      scan = S_END;
+	    }
+	  else if (get_rec_info)
 	    {
 	      /* Getting record information means that we need to scan all slots even if they store no object. */
 	      if (reversed_direction)
@@ -9439,6 +9687,7 @@ heap_attrinfo_start (THREAD_ENTRY * thread_p, const OID * class_oid, int request
   attr_info->inst_chn = NULL_CHN;
   attr_info->values = NULL;
   attr_info->num_values = -1;	/* initialize attr_info */
+  attr_info->num_deferred = 0;
 
   /*
    * Find the most recent representation of the instances of the class, and
@@ -10028,6 +10277,7 @@ heap_attrinfo_clear_dbvalues (HEAP_CACHE_ATTRINFO * attr_info)
     }
   OID_SET_NULL (&attr_info->inst_oid);
   attr_info->inst_chn = NULL_CHN;
+  attr_info->num_deferred = 0;
 
   return ret;
 }
@@ -10351,6 +10601,7 @@ heap_attrinfo_read_dbvalues (THREAD_ENTRY * thread_p, const OID * inst_oid, RECD
 	  goto exit_on_error;
 	}
     }
+  attr_info->num_deferred = 0;
 
   /*
    * Cache the information of the instance
@@ -10414,6 +10665,7 @@ heap_attrinfo_read_dbvalues_without_oid (THREAD_ENTRY * thread_p, RECDES * recde
 	  goto exit_on_error;
 	}
     }
+  attr_info->num_deferred = 0;
 
   return ret;
 
@@ -10422,6 +10674,161 @@ exit_on_error:
   return (ret == NO_ERROR && (ret = er_errid ()) == NO_ERROR) ? ER_FAILED : ret;
 }
 
+/*
+ * heap_attrinfo_read_dbvalues_deferred () - Prepare the desired attributes of given instance to be decoded on demand
+ *   return: NO_ERROR
+ *   inst_oid(in): The instance oid
+ *   recdes(in): The instance Record descriptor
+ *   attr_info(in/out): The attribute information structure which describe the
+ *                      desired attributes
+ *
+ * Note: Same as heap_attrinfo_read_dbvalues, except that no attribute is decoded here. Each value is only marked as
+ *       deferred and is decoded the first time it is accessed through heap_attrinfo_read_deferred_value or
+ *       heap_attrinfo_access. This lets a predicate evaluation skip the decoding of the attributes referenced only by
+ *       the terms it short-circuits. The record descriptor must remain valid until the values are decoded or the
+ *       next instance is read.
+ */
+int
+heap_attrinfo_read_dbvalues_deferred (THREAD_ENTRY * thread_p, const OID * inst_oid, RECDES * recdes,
+				      HEAP_CACHE_ATTRINFO * attr_info)
+{
+  int i;
+  REPR_ID reprid;		/* The disk representation of the object */
+  HEAP_ATTRVALUE *value;	/* Disk value Attr info for a particular attr */
+  int ret = NO_ERROR;
+
+  /* check to make sure the attr_info has been used */
+  if (attr_info->num_values == -1)
+    {
+      return NO_ERROR;
+    }
+
+  assert (inst_oid != NULL && recdes != NULL && recdes->data != NULL);
+
+  reprid = or_rep_id (recdes);
+  if (attr_info->read_classrepr == NULL || attr_info->read_classrepr->id != reprid)
+    {
+      /* Get the needed representation */
+      ret = heap_attrinfo_recache (thread_p, reprid, attr_info);
+      if (ret != NO_ERROR)
+	{
+	  return (ret == NO_ERROR && (ret = er_errid ()) == NO_ERROR) ? ER_FAILED : ret;
+	}
+    }
+
+  for (i = 0; i < attr_info->num_values; i++)
+    {
+      value = &attr_info->values[i];
+      if (value->state != HEAP_UNINIT_ATTRVALUE)
+	{
+	  (void) pr_clear_value (&value->dbvalue);
+	}
+      value->state = HEAP_DEFERRED_ATTRVALUE;
+    }
+
+  attr_info->deferred_recdes = *recdes;
+  attr_info->num_deferred = attr_info->num_values;
+
+  attr_info->inst_chn = or_chn (recdes);
+  attr_info->inst_oid = *inst_oid;
+
+  return NO_ERROR;
+}
+
+/*
+ * heap_attrinfo_read_deferred_value () - Decode an attribute value whose decoding has been deferred
+ *   return: NO_ERROR
+ *   attrid(in): The desired attribute identifier
+ *   attr_info(in/out): The attribute information structure
+ *
+ * Note: Nothing is done if the attribute is not part of attr_info or has already been decoded.
+ */
+int
+heap_attrinfo_read_deferred_value (ATTR_ID attrid, HEAP_CACHE_ATTRINFO * attr_info)
+{
+  HEAP_ATTRVALUE *value;	/* Disk value Attr info for a particular attr */
+
+  if (attr_info->num_deferred <= 0)
+    {
+      return NO_ERROR;
+    }
+
+  value = heap_attrvalue_locate (attrid, attr_info);
+  if (value == NULL || value->state != HEAP_DEFERRED_ATTRVALUE)
+    {
+      return NO_ERROR;
+    }
+
+  attr_info->num_deferred--;
+  return heap_attrvalue_read (&attr_info->deferred_recdes, value, attr_info);
+}
+
+/*
+ * heap_attrinfo_read_deferred_dbvalues () - Decode all attribute values whose decoding has been deferred
+ *   return: NO_ERROR
+ *   attr_info(in/out): The attribute information structure
+ */
+int
+heap_attrinfo_read_deferred_dbvalues (HEAP_CACHE_ATTRINFO * attr_info)
+{
+  int i;
+  HEAP_ATTRVALUE *value;	/* Disk value Attr info for a particular attr */
+  int ret = NO_ERROR;
+
+  for (i = 0; i < attr_info->num_values && attr_info->num_deferred > 0; i++)
+    {
+      value = &attr_info->values[i];
+      if (value->state != HEAP_DEFERRED_ATTRVALUE)
+	{
+	  continue;
+	}
+
+      attr_info->num_deferred--;
+      ret = heap_attrvalue_read (&attr_info->deferred_recdes, value, attr_info);
+      if (ret != NO_ERROR)
+	{
+	  return ret;
+	}
+    }
+
+  assert (attr_info->num_deferred == 0);
+  return NO_ERROR;
+}
+
+/*
+ * heap_attrinfo_reset_deferred_dbvalues () - Drop the attribute values whose decoding has been deferred
+ *   return: void
+ *   attr_info(in/out): The attribute information structure
+ *
+ * Note: The deferred values return to the unread state and the deferred record is forgotten. This must be called
+ *       when the record the values were located in may not stay valid, e.g. when its page is unfixed after the
+ *       instance is rejected by a filter.
+ */
+void
+heap_attrinfo_reset_deferred_dbvalues (HEAP_CACHE_ATTRINFO * attr_info)
+{
+  int i;
+  HEAP_ATTRVALUE *value;	/* Disk value Attr info for a particular attr */
+
+  for (i = 0; i < attr_info->num_values && attr_info->num_deferred > 0; i++)
+    {
+      value = &attr_info->values[i];
+      if (value->state != HEAP_DEFERRED_ATTRVALUE)
+	{
+	  continue;
+	}
+
+      attr_info->num_deferred--;
+      value->state = HEAP_UNINIT_ATTRVALUE;
+      db_make_null (&value->dbvalue);
+    }
+
+  assert (attr_info->num_deferred == 0);
+  attr_info->num_deferred = 0;
+  attr_info->deferred_recdes.data = NULL;
+  attr_info->deferred_recdes.length = 0;
+}
+
 /*
  * heap_attrinfo_delete_lob ()
  *   return: NO_ERROR
@@ -10651,6 +11058,15 @@ heap_attrinfo_access (ATTR_ID attrid, HEAP_CACHE_ATTRINFO * attr_info)
       return NULL;
     }
 
+  if (value->state == HEAP_DEFERRED_ATTRVALUE)
+    {
+      attr_info->num_deferred--;
+      if (heap_attrvalue_read (&attr_info->deferred_recdes, value, attr_info) != NO_ERROR)
+	{
+	  return NULL;
+	}
+    }
+
   return &value->dbvalue;
 }
 
@@ -12037,6 +12453,7 @@ heap_attrinfo_start_with_index (THREAD_ENTRY * thread_p, OID * class_oid, RECDES
       OID_SET_NULL (&attr_info->inst_oid);
       attr_info->inst_chn = NULL_CHN;
       attr_info->num_values = num_found_attrs;
+      attr_info->num_deferred = 0;
 
       if (num_found_attrs <= 0)
 	{
@@ -22465,6 +22882,11 @@ heap_insert_logical (THREAD_ENTRY * thread_p, HEAP_OPERATION_CONTEXT * context,
       perfmon_inc_stat (thread_p, PSTAT_HEAP_ASSIGN_INSERTS);
     }
 
+  if (is_mvcc_op)
+    {
+      vacuum_stats_add_dml (thread_p, &context->hfid, &context->class_oid, VACUUM_STATS_DML_INSERT);
+    }
+
 error:
 
 #if defined(ENABLE_SYSTEMTAP)
@@ -22618,6 +23040,11 @@ heap_delete_logical (THREAD_ENTRY * thread_p, HEAP_OPERATION_CONTEXT * context)
       goto error;
     }
 
+  if (rc == NO_ERROR && is_mvcc_op)
+    {
+      vacuum_stats_add_dml (thread_p, &context->hfid, &context->class_oid, VACUUM_STATS_DML_DELETE);
+    }
+
 error:
 
   /* unfix or keep home page */
@@ -22819,6 +23246,11 @@ heap_update_logical (THREAD_ENTRY * thread_p, HEAP_OPERATION_CONTEXT * context)
       goto exit;
     }
 
+  if (is_mvcc_op)
+    {
+      vacuum_stats_add_dml (thread_p, &context->hfid, &context->class_oid, VACUUM_STATS_DML_UPDATE);
+    }
+
   /*
    * Class update case
    */
@@ -42,6 +42,8 @@
 #include "thread_compat.hpp"
 
 // forward declarations
+class btree_insert_batch;
+class heap_zone_filter;
 class multi_index_unique_stats;
 class record_descriptor;
 
@@ -149,6 +151,8 @@ struct heap_scancache
     PGBUF_WATCHER page_watcher;
     int num_btids;		/* Total number of indexes defined on the scanning class */
     multi_index_unique_stats *m_index_stats;	// does this really belong to scan cache??
+    btree_insert_batch *m_index_insert_batch;	/* keys of multi-row insert that are inserted in indexes later */
+    heap_zone_filter *m_zone_filter;	/* skips heap pages that cannot satisfy the scan filter */
     FILE_TYPE file_type;		/* The file type of the heap file being scanned. Can be FILE_HEAP or
 				         * FILE_HEAP_REUSE_SLOTS */
     MVCC_SNAPSHOT *mvcc_snapshot;	/* mvcc snapshot */
@@ -473,6 +477,11 @@ extern int heap_attrinfo_read_dbvalues (THREAD_ENTRY * thread_p, const OID * ins
 					HEAP_SCANCACHE * scan_cache, HEAP_CACHE_ATTRINFO * attr_info);
 extern int heap_attrinfo_read_dbvalues_without_oid (THREAD_ENTRY * thread_p, RECDES * recdes,
 						    HEAP_CACHE_ATTRINFO * attr_info);
+extern int heap_attrinfo_read_dbvalues_deferred (THREAD_ENTRY * thread_p, const OID * inst_oid, RECDES * recdes,
+						 HEAP_CACHE_ATTRINFO * attr_info);
+extern int heap_attrinfo_read_deferred_value (ATTR_ID attrid, HEAP_CACHE_ATTRINFO * attr_info);
+extern int heap_attrinfo_read_deferred_dbvalues (HEAP_CACHE_ATTRINFO * attr_info);
+extern void heap_attrinfo_reset_deferred_dbvalues (HEAP_CACHE_ATTRINFO * attr_info);
 extern int heap_attrinfo_delete_lob (THREAD_ENTRY * thread_p, RECDES * recdes, HEAP_CACHE_ATTRINFO * attr_info);
 extern DB_VALUE *heap_attrinfo_access (ATTR_ID attrid, HEAP_CACHE_ATTRINFO * attr_info);
 extern int heap_attrinfo_set (const OID * inst_oid, ATTR_ID attrid, DB_VALUE * attr_val,
@@ -0,0 +1,528 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+//
+// Heap free space map - free space of heap pages organized for fast search of a page to insert into
+//
+
+#include "heap_free_space_map.hpp"
+
+#include "system_parameter.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+  const int FSM_CATEGORY_BITS = 4;
+  const int FSM_CATEGORY_MAX = (1 << FSM_CATEGORY_BITS) - 1;
+  const int FSM_PAGES_PER_BYTE = 8 / FSM_CATEGORY_BITS;
+  const std::size_t FSM_SECTOR_BYTES = DISK_SECTOR_NPAGES / FSM_PAGES_PER_BYTE;
+  const std::size_t FSM_NOT_FOUND = std::numeric_limits<std::size_t>::max ();
+  const std::size_t FSM_SHARD_COUNT = 64;
+  const int FSM_BUILD_WALK_INTERVAL = 4;	// failed searches between two walks while the map is incomplete
+  const int FSM_REFRESH_WALK_INTERVAL = 64;	// failed searches between two walks once the map is complete
+
+  int
+  fsm_category_unit ()
+  {
+    return DB_PAGESIZE / (FSM_CATEGORY_MAX + 1);
+  }
+
+  // category of a page with free_space bytes; the page has at least category * unit bytes free
+  int
+  fsm_free_space_category (int free_space)
+  {
+    if (free_space <= 0)
+      {
+	return 0;
+      }
+    return std::min (free_space / fsm_category_unit (), FSM_CATEGORY_MAX);
+  }
+
+  // lowest category of the pages that may have needed_space bytes free
+  int
+  fsm_needed_space_category (int needed_space)
+  {
+    int unit = fsm_category_unit ();
+    int category = (needed_space + unit - 1) / unit;
+
+    return std::max (std::min (category, FSM_CATEGORY_MAX), 1);
+  }
+
+  std::int64_t
+  fsm_make_key (short volid, int id)
+  {
+    return (((std::int64_t) volid) << 32) | (std::uint32_t) id;
+  }
+
+  // free space categories of the pages of one heap file
+  class free_space_map
+  {
+    public:
+      free_space_map ()
+	: m_walk_vpid VPID_INITIALIZER
+	, m_is_complete (false)
+	, m_miss_count (0)
+	, m_sectors ()
+	, m_sector_keys ()
+	, m_categories ()
+	, m_tree (2, 0)
+	, m_capacity (1)
+      {
+      }
+
+      void set_page (const VPID &vpid, int category);
+      void clear_page (const VPID &vpid);
+      bool find (int category, VPID &vpid) const;
+
+      VPID m_walk_vpid;		// next page of the heap chain to walk; null to start from the header page
+      bool m_is_complete;	// true if all pages of the heap have been walked at least once
+      int m_miss_count;		// failed searches since the last walk
+
+    private:
+      int get_category (std::size_t sector, int page) const;
+      std::size_t add_sector (std::int64_t sector_key);
+      void update_tree (std::size_t sector);
+      std::size_t find_sector (std::size_t first_sector, int category) const;
+
+      std::unordered_map<std::int64_t, std::size_t> m_sectors;	// sector key (volume and sector id) to sector index
+      std::vector<std::int64_t> m_sector_keys;			// sector index to sector key
+      std::vector<std::uint8_t> m_categories;			// FSM_SECTOR_BYTES for each sector
+      std::vector<std::uint8_t> m_tree;		// highest category of subtrees; leaves are sectors, starting at m_capacity
+      std::size_t m_capacity;			// number of leaves of m_tree, a power of two
+  };
+
+  // maps are spread over shards, each with its own mutex, so heaps do not serialize each other
+  struct fsm_shard
+  {
+    std::mutex m_mutex;
+    std::unordered_map<std::int64_t, free_space_map> m_maps;	// key is volume and file id of heap file
+  };
+  fsm_shard fsm_Shards[FSM_SHARD_COUNT];
+
+  int
+  free_space_map::get_category (std::size_t sector, int page) const
+  {
+    std::uint8_t byte = m_categories[sector * FSM_SECTOR_BYTES + page / FSM_PAGES_PER_BYTE];
+
+    return (byte >> ((page % FSM_PAGES_PER_BYTE) * FSM_CATEGORY_BITS)) & FSM_CATEGORY_MAX;
+  }
+
+  void
+  free_space_map::set_page (const VPID &vpid, int category)
+  {
+    std::int64_t sector_key = fsm_make_key (vpid.volid, SECTOR_FROM_PAGEID (vpid.pageid));
+    std::size_t sector;
+    int page = vpid.pageid % DISK_SECTOR_NPAGES;
+    int shift = (page % FSM_PAGES_PER_BYTE) * FSM_CATEGORY_BITS;
+    std::uint8_t *byte;
+
+    auto it = m_sectors.find (sector_key);
+    if (it != m_sectors.end ())
+      {
+	sector = it->second;
+      }
+    else if (category > 0)
+      {
+	sector = add_sector (sector_key);
+      }
+    else
+      {
+	// nothing to remember
+	return;
+      }
+
+    byte = &m_categories[sector * FSM_SECTOR_BYTES + page / FSM_PAGES_PER_BYTE];
+    if (((*byte >> shift) & FSM_CATEGORY_MAX) == category)
+      {
+	return;
+      }
+    *byte = (std::uint8_t) ((*byte & ~(FSM_CATEGORY_MAX << shift)) | (category << shift));
+    update_tree (sector);
+  }
+
+  void
+  free_space_map::clear_page (const VPID &vpid)
+  {
+    set_page (vpid, 0);
+  }
+
+  bool
+  free_space_map::find (int category, VPID &vpid) const
+  {
+    std::size_t sector = 0;
+    std::size_t found_sector;
+    int page = 0;
+
+    if (!VPID_ISNULL (&vpid))
+      {
+	// continue after given page
+	auto it = m_sectors.find (fsm_make_key (vpid.volid, SECTOR_FROM_PAGEID (vpid.pageid)));
+	if (it != m_sectors.end ())
+	  {
+	    sector = it->second;
+	    page = vpid.pageid % DISK_SECTOR_NPAGES + 1;
+	  }
+      }
+
+    while ((found_sector = find_sector (sector, category)) != FSM_NOT_FOUND)
+      {
+	if (found_sector != sector)
+	  {
+	    // the pages of a later sector are all searched
+	    sector = found_sector;
+	    page = 0;
+	  }
+	for (; page < DISK_SECTOR_NPAGES; page++)
+	  {
+	    if (get_category (sector, page) >= category)
+	      {
+		vpid.volid = (VOLID) (m_sector_keys[sector] >> 32);
+		vpid.pageid = (PAGEID) (m_sector_keys[sector] & 0xFFFFFFFF) * DISK_SECTOR_NPAGES + page;
+		return true;
+	      }
+	  }
+	sector++;
+	page = 0;
+      }
+
+    return false;
+  }
+
+  std::size_t
+  free_space_map::add_sector (std::int64_t sector_key)
+  {
+    std::size_t sector = m_sector_keys.size ();
+
+    m_sectors.emplace (sector_key, sector);
+    m_sector_keys.push_back (sector_key);
+    m_categories.resize (m_categories.size () + FSM_SECTOR_BYTES, 0);
+
+    if (sector >= m_capacity)
+      {
+	// double the leaves and rebuild the inner nodes
+	std::vector<std::uint8_t> tree (4 * m_capacity, 0);
+
+	std::copy (m_tree.begin () + m_capacity, m_tree.end (), tree.begin () + 2 * m_capacity);
+	m_capacity *= 2;
+	for (std::size_t node = m_capacity - 1; node > 0; node--)
+	  {
+	    tree[node] = std::max (tree[2 * node], tree[2 * node + 1]);
+	  }
+	m_tree.swap (tree);
+      }
+
+    return sector;
+  }
+
+  void
+  free_space_map::update_tree (std::size_t sector)
+  {
+    std::size_t node = m_capacity + sector;
+    std::uint8_t max_category = 0;
+
+    for (int page = 0; page < DISK_SECTOR_NPAGES && max_category < FSM_CATEGORY_MAX; page++)
+      {
+	max_category = std::max (max_category, (std::uint8_t) get_category (sector, page));
+      }
+
+    m_tree[node] = max_category;
+    for (node /= 2; node > 0; node /= 2)
+      {
+	std::uint8_t max_children = std::max (m_tree[2 * node], m_tree[2 * node + 1]);
+	if (m_tree[node] == max_children)
+	  {
+	    break;
+	  }
+	m_tree[node] = max_children;
+      }
+  }
+
+  // first sector starting with first_sector that has a page of given category or higher
+  std::size_t
+  free_space_map::find_sector (std::size_t first_sector, int category) const
+  {
+    std::size_t node;
+
+    if (first_sector >= m_sector_keys.size ())
+      {
+	return FSM_NOT_FOUND;
+      }
+
+    // climb until a subtree on the right of first_sector has the category
+    node = m_capacity + first_sector;
+    while (m_tree[node] < category)
+      {
+	while (node % 2 == 1)
+	  {
+	    node /= 2;
+	    if (node == 0)
+	      {
+		return FSM_NOT_FOUND;
+	      }
+	  }
+	node++;
+      }
+
+    // descend to its leftmost leaf with the category
+    while (node < m_capacity)
+      {
+	node *= 2;
+	if (m_tree[node] < category)
+	  {
+	    node++;
+	  }
+      }
+
+    return node - m_capacity;
+  }
+
+  std::int64_t
+  fsm_hfid_key (const HFID *hfid)
+  {
+    return fsm_make_key (hfid->vfid.volid, hfid->vfid.fileid);
+  }
+
+  fsm_shard &
+  fsm_get_shard (std::int64_t key)
+  {
+    return fsm_Shards[(std::uint64_t) (key ^ (key >> 32)) % FSM_SHARD_COUNT];
+  }
+}
+
+/*
+ * heap_fsm_set_free_space () - save the free space of a heap page
+ *
+ * return          : void
+ * hfid (in)       : heap file
+ * vpid (in)       : heap page
+ * free_space (in) : free space of page
+ */
+void
+heap_fsm_set_free_space (const HFID *hfid, const VPID *vpid, int free_space)
+{
+  if (!prm_get_bool_value (PRM_ID_HEAP_FREE_SPACE_MAP))
+    {
+      return;
+    }
+
+  std::int64_t key = fsm_hfid_key (hfid);
+  fsm_shard &shard = fsm_get_shard (key);
+  std::lock_guard<std::mutex> lock (shard.m_mutex);
+
+  shard.m_maps[key].set_page (*vpid, fsm_free_space_category (free_space));
+}
+
+/*
+ * heap_fsm_remove_page () - forget a heap page that is deallocated
+ *
+ * return    : void
+ * hfid (in) : heap file
+ * vpid (in) : heap page
+ */
+void
+heap_fsm_remove_page (const HFID *hfid, const VPID *vpid)
+{
+  if (!prm_get_bool_value (PRM_ID_HEAP_FREE_SPACE_MAP))
+    {
+      return;
+    }
+
+  std::int64_t key = fsm_hfid_key (hfid);
+  fsm_shard &shard = fsm_get_shard (key);
+  std::lock_guard<std::mutex> lock (shard.m_mutex);
+
+  auto it = shard.m_maps.find (key);
+  if (it != shard.m_maps.end ())
+    {
+      it->second.clear_page (*vpid);
+      if (VPID_EQ (&it->second.m_walk_vpid, vpid))
+	{
+	  // the walk cannot continue from a deallocated page; restart it from the header page
+	  VPID_SET_NULL (&it->second.m_walk_vpid);
+	}
+    }
+}
+
+/*
+ * heap_fsm_find_page () - find a heap page that may have the needed space
+ *
+ * return            : true if a page was found
+ * hfid (in)         : heap file
+ * needed_space (in) : needed space
+ * vpid (in/out)     : as input, the page to continue the search after or null to search from the start; as output,
+ *                     the page found
+ */
+bool
+heap_fsm_find_page (const HFID *hfid, int needed_space, VPID *vpid)
+{
+  if (!prm_get_bool_value (PRM_ID_HEAP_FREE_SPACE_MAP))
+    {
+      return false;
+    }
+
+  std::int64_t key = fsm_hfid_key (hfid);
+  fsm_shard &shard = fsm_get_shard (key);
+  std::lock_guard<std::mutex> lock (shard.m_mutex);
+
+  auto it = shard.m_maps.find (key);
+  if (it == shard.m_maps.end ())
+    {
+      return false;
+    }
+  return it->second.find (fsm_needed_space_category (needed_space), *vpid);
+}
+
+/*
+ * heap_fsm_is_complete () - has the free space map of heap file learned all its pages?
+ *
+ * return    : true if all pages of heap were walked at least once
+ * hfid (in) : heap file
+ */
+bool
+heap_fsm_is_complete (const HFID *hfid)
+{
+  if (!prm_get_bool_value (PRM_ID_HEAP_FREE_SPACE_MAP))
+    {
+      return false;
+    }
+
+  std::int64_t key = fsm_hfid_key (hfid);
+  fsm_shard &shard = fsm_get_shard (key);
+  std::lock_guard<std::mutex> lock (shard.m_mutex);
+
+  auto it = shard.m_maps.find (key);
+  return it != shard.m_maps.end () && it->second.m_is_complete;
+}
+
+/*
+ * heap_fsm_need_walk () - count a failed search and tell if the heap chain should be walked to learn more pages
+ *
+ * return    : true if it is time for a walk
+ * hfid (in) : heap file
+ *
+ * note: walks are spread over failed searches so that inserters do not walk the chain each time they allocate a page.
+ *       they are more frequent while the map is still incomplete.
+ */
+bool
+heap_fsm_need_walk (const HFID *hfid)
+{
+  if (!prm_get_bool_value (PRM_ID_HEAP_FREE_SPACE_MAP))
+    {
+      return false;
+    }
+
+  std::int64_t key = fsm_hfid_key (hfid);
+  fsm_shard &shard = fsm_get_shard (key);
+  std::lock_guard<std::mutex> lock (shard.m_mutex);
+  free_space_map &map = shard.m_maps[key];
+
+  map.m_miss_count++;
+  return map.m_miss_count >= (map.m_is_complete ? FSM_REFRESH_WALK_INTERVAL : FSM_BUILD_WALK_INTERVAL);
+}
+
+/*
+ * heap_fsm_get_walk_position () - get the next page of the heap chain to walk
+ *
+ * return     : void
+ * hfid (in)  : heap file
+ * vpid (out) : next page to walk or null to start from the header page
+ */
+void
+heap_fsm_get_walk_position (const HFID *hfid, VPID *vpid)
+{
+  std::int64_t key = fsm_hfid_key (hfid);
+  fsm_shard &shard = fsm_get_shard (key);
+  std::lock_guard<std::mutex> lock (shard.m_mutex);
+
+  auto it = shard.m_maps.find (key);
+  if (it == shard.m_maps.end ())
+    {
+      VPID_SET_NULL (vpid);
+    }
+  else
+    {
+      *vpid = it->second.m_walk_vpid;
+    }
+}
+
+/*
+ * heap_fsm_set_walk_position () - save the next page of the heap chain to walk
+ *
+ * return    : void
+ * hfid (in) : heap file
+ * vpid (in) : next page to walk; null if the walk reached the end of the chain
+ */
+void
+heap_fsm_set_walk_position (const HFID *hfid, const VPID *vpid)
+{
+  if (!prm_get_bool_value (PRM_ID_HEAP_FREE_SPACE_MAP))
+    {
+      return;
+    }
+
+  std::int64_t key = fsm_hfid_key (hfid);
+  fsm_shard &shard = fsm_get_shard (key);
+  std::lock_guard<std::mutex> lock (shard.m_mutex);
+  free_space_map &map = shard.m_maps[key];
+
+  map.m_walk_vpid = *vpid;
+  map.m_miss_count = 0;
+  if (VPID_ISNULL (vpid))
+    {
+      map.m_is_complete = true;
+    }
+}
+
+/*
+ * heap_fsm_remove () - remove the free space map of a heap file
+ *
+ * return    : void
+ * hfid (in) : heap file
+ */
+void
+heap_fsm_remove (const HFID *hfid)
+{
+  std::int64_t key = fsm_hfid_key (hfid);
+  fsm_shard &shard = fsm_get_shard (key);
+  std::lock_guard<std::mutex> lock (shard.m_mutex);
+
+  shard.m_maps.erase (key);
+}
+
+/*
+ * heap_fsm_finalize () - remove all free space maps
+ *
+ * return : void
+ */
+void
+heap_fsm_finalize (void)
+{
+  for (fsm_shard &shard : fsm_Shards)
+    {
+      std::lock_guard<std::mutex> lock (shard.m_mutex);
+
+      shard.m_maps.clear ();
+    }
+}
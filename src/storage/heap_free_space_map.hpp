@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+//
+// Heap free space map - free space of heap pages organized for fast search of a page to insert into
+//
+// Each heap file has a free space map that keeps a 4-bit category of the free space of each of its pages. Pages are
+// grouped by the disk sectors of the file; a tree over sectors keeps the highest category found in each subtree, so
+// the first page with enough free space is found in O(log n).
+//
+// The map is updated whenever the free space of a page is learned: when records are inserted and deleted, when vacuum
+// cleans a page and when pages are allocated or deallocated. It is kept in memory; after a restart it is rebuilt
+// gradually by the inserters themselves, which walk the page chain of the heap in small steps before some of the page
+// allocations; once complete, the same walk refreshes the map, less often. The map is only a hint: the free space of a
+// page is always checked after the page is fixed.
+//
+
+#ifndef _HEAP_FREE_SPACE_MAP_HPP_
+#define _HEAP_FREE_SPACE_MAP_HPP_
+
+#if !defined (SERVER_MODE) && !defined (SA_MODE)
+#error Belongs to server module
+#endif /* !defined (SERVER_MODE) && !defined (SA_MODE) */
+
+#include "storage_common.h"
+
+void heap_fsm_set_free_space (const HFID *hfid, const VPID *vpid, int free_space);
+void heap_fsm_remove_page (const HFID *hfid, const VPID *vpid);
+bool heap_fsm_find_page (const HFID *hfid, int needed_space, VPID *vpid);
+
+bool heap_fsm_is_complete (const HFID *hfid);
+bool heap_fsm_need_walk (const HFID *hfid);
+void heap_fsm_get_walk_position (const HFID *hfid, VPID *vpid);
+void heap_fsm_set_walk_position (const HFID *hfid, const VPID *vpid);
+
+void heap_fsm_remove (const HFID *hfid);
+void heap_fsm_finalize (void);
+
+#endif // _HEAP_FREE_SPACE_MAP_HPP_
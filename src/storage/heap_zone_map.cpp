@@ -0,0 +1,636 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+//
+// Heap zone maps - min/max summaries of heap pages used by heap scans to skip pages
+//
+
+#include "heap_zone_map.hpp"
+
+#include "dbtype.h"
+#include "error_manager.h"
+#include "fetch.h"
+#include "heap_file.h"
+#include "log_lsa.hpp"
+#include "object_domain.h"
+#include "object_representation_sr.h"
+#include "page_buffer.h"
+#include "regu_var.hpp"
+#include "slotted_page.h"
+#include "system_parameter.h"
+#include "xasl_predicate.hpp"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class heap_zone_filter
+{
+  public:
+    // attribute <op> constant
+    struct term
+    {
+      ATTR_ID m_attrid;
+      REL_OP m_op;
+      DB_VALUE m_value;
+    };
+
+    // summary of one attribute over all records of a heap page. only fixed size types are summarized, so values are
+    // copied without cloning.
+    struct page_summary
+    {
+      LOG_LSA m_lsa;		// page LSA the summary was computed for; null if page was never summarized
+      bool m_is_summarized;	// false if page has records that are not stored in the page
+      bool m_has_values;	// false if all values are null
+      int m_null_count;
+      DB_VALUE m_min;
+      DB_VALUE m_max;
+    };
+
+    HFID m_hfid;
+    std::vector<term> m_terms;
+    std::vector<ATTR_ID> m_attrids;	// distinct attributes of terms
+    std::vector<DB_TYPE> m_types;	// types of m_attrids
+    std::vector<page_summary> m_page_summaries;	// summaries of current page, one for each of m_attrids
+    HEAP_CACHE_ATTRINFO m_attr_info;
+    bool m_is_attr_info_started;
+
+    heap_zone_filter ()
+      : m_hfid ()
+      , m_terms ()
+      , m_attrids ()
+      , m_types ()
+      , m_page_summaries ()
+      , m_attr_info ()
+      , m_is_attr_info_started (false)
+    {
+    }
+};
+
+namespace
+{
+  using page_summary = heap_zone_filter::page_summary;
+
+  struct zone_range
+  {
+    page_summary m_pages[HEAP_ZONE_RANGE_PAGES];
+
+    zone_range ()
+    {
+      for (page_summary &page : m_pages)
+	{
+	  LSA_SET_NULL (&page.m_lsa);
+	}
+    }
+  };
+
+  struct zone_map
+  {
+    DB_TYPE m_type;
+    std::unordered_map<std::int64_t, zone_range> m_ranges;	// key is volume and first page of range
+  };
+
+  struct zone_map_key
+  {
+    HFID m_hfid;
+    ATTR_ID m_attrid;
+  };
+
+  struct zone_map_key_less
+  {
+    bool operator() (const zone_map_key &a, const zone_map_key &b) const
+    {
+      if (a.m_hfid.vfid.fileid != b.m_hfid.vfid.fileid)
+	{
+	  return a.m_hfid.vfid.fileid < b.m_hfid.vfid.fileid;
+	}
+      if (a.m_hfid.vfid.volid != b.m_hfid.vfid.volid)
+	{
+	  return a.m_hfid.vfid.volid < b.m_hfid.vfid.volid;
+	}
+      return a.m_attrid < b.m_attrid;
+    }
+  };
+
+  std::mutex zone_Maps_mutex;
+  std::map<zone_map_key, zone_map, zone_map_key_less> zone_Maps;
+  std::size_t zone_Range_count = 0;
+
+  bool
+  zone_is_supported_type (DB_TYPE type)
+  {
+    switch (type)
+      {
+      case DB_TYPE_INTEGER:
+      case DB_TYPE_SHORT:
+      case DB_TYPE_BIGINT:
+      case DB_TYPE_FLOAT:
+      case DB_TYPE_DOUBLE:
+      case DB_TYPE_DATE:
+      case DB_TYPE_TIME:
+      case DB_TYPE_TIMESTAMP:
+      case DB_TYPE_DATETIME:
+	return true;
+      default:
+	return false;
+      }
+  }
+
+  // operator of "constant <op> attribute" rewritten as "attribute <op> constant"
+  REL_OP
+  zone_flip_op (REL_OP op)
+  {
+    switch (op)
+      {
+      case R_GT:
+	return R_LT;
+      case R_GE:
+	return R_LE;
+      case R_LT:
+	return R_GT;
+      case R_LE:
+	return R_GE;
+      default:
+	return op;
+      }
+  }
+
+  std::int64_t
+  zone_range_key (const VPID *vpid)
+  {
+    return (((std::int64_t) vpid->volid) << 32) | (std::int64_t) (vpid->pageid / HEAP_ZONE_RANGE_PAGES);
+  }
+
+  void
+  zone_add_term (THREAD_ENTRY *thread_p, const REGU_VARIABLE *attr, const REGU_VARIABLE *constant, REL_OP op,
+		 val_descr *vd, heap_zone_filter &filter)
+  {
+    heap_zone_filter::term term;
+    DB_VALUE *peek_value = NULL;
+    DB_TYPE type;
+
+    if (attr == NULL || attr->type != TYPE_ATTR_ID)
+      {
+	return;
+      }
+    type = attr->value.attr_descr.type;
+    if (!zone_is_supported_type (type))
+      {
+	return;
+      }
+
+    term.m_attrid = attr->value.attr_descr.id;
+    term.m_op = op;
+    db_make_null (&term.m_value);
+
+    if (op != R_NULL)
+      {
+	if (constant == NULL || (constant->type != TYPE_DBVAL && constant->type != TYPE_POS_VALUE))
+	  {
+	    return;
+	  }
+	if (fetch_peek_dbval (thread_p, const_cast<REGU_VARIABLE *> (constant), vd, NULL, NULL, NULL,
+			      &peek_value) != NO_ERROR)
+	  {
+	    // let the scan report it
+	    er_clear ();
+	    return;
+	  }
+	if (peek_value == NULL || DB_IS_NULL (peek_value) || DB_VALUE_DOMAIN_TYPE (peek_value) != type)
+	  {
+	    return;
+	  }
+	term.m_value = *peek_value;
+	term.m_value.need_clear = false;
+      }
+
+    filter.m_terms.push_back (term);
+
+    for (ATTR_ID attrid : filter.m_attrids)
+      {
+	if (attrid == term.m_attrid)
+	  {
+	    return;
+	  }
+      }
+    filter.m_attrids.push_back (term.m_attrid);
+    filter.m_types.push_back (type);
+  }
+
+  // collect the terms of the top level conjunction of predicate
+  void
+  zone_collect_terms (THREAD_ENTRY *thread_p, const PRED_EXPR *pred, val_descr *vd, heap_zone_filter &filter)
+  {
+    if (pred == NULL)
+      {
+	return;
+      }
+
+    if (pred->type == T_PRED)
+      {
+	if (pred->pe.m_pred.bool_op == B_AND)
+	  {
+	    zone_collect_terms (thread_p, pred->pe.m_pred.lhs, vd, filter);
+	    zone_collect_terms (thread_p, pred->pe.m_pred.rhs, vd, filter);
+	  }
+	return;
+      }
+
+    if (pred->type != T_EVAL_TERM || pred->pe.m_eval_term.et_type != T_COMP_EVAL_TERM)
+      {
+	return;
+      }
+
+    const COMP_EVAL_TERM &comp = pred->pe.m_eval_term.et.et_comp;
+    switch (comp.rel_op)
+      {
+      case R_NULL:
+	zone_add_term (thread_p, comp.lhs, NULL, R_NULL, vd, filter);
+	break;
+
+      case R_EQ:
+      case R_GT:
+      case R_GE:
+      case R_LT:
+      case R_LE:
+	if (comp.lhs != NULL && comp.lhs->type == TYPE_ATTR_ID)
+	  {
+	    zone_add_term (thread_p, comp.lhs, comp.rhs, comp.rel_op, vd, filter);
+	  }
+	else
+	  {
+	    zone_add_term (thread_p, comp.rhs, comp.lhs, zone_flip_op (comp.rel_op), vd, filter);
+	  }
+	break;
+
+      default:
+	break;
+      }
+  }
+
+  void
+  zone_set_not_summarized (heap_zone_filter &filter)
+  {
+    for (page_summary &summary : filter.m_page_summaries)
+      {
+	summary.m_is_summarized = false;
+      }
+  }
+
+  // summarize filter attributes over all records of heap page
+  void
+  zone_summarize_page (THREAD_ENTRY *thread_p, heap_zone_filter &filter, PAGE_PTR pgptr, const LOG_LSA *page_lsa)
+  {
+    PGSLOTID slotid = NULL_SLOTID;
+    RECDES recdes;
+    MVCC_REC_HEADER mvcc_header;
+    DB_VALUE *value;
+
+    for (page_summary &summary : filter.m_page_summaries)
+      {
+	summary.m_lsa = *page_lsa;
+	summary.m_is_summarized = true;
+	summary.m_has_values = false;
+	summary.m_null_count = 0;
+	db_make_null (&summary.m_min);
+	db_make_null (&summary.m_max);
+      }
+
+    while (spage_next_record (pgptr, &slotid, &recdes, PEEK) == S_SUCCESS)
+      {
+	if (slotid == HEAP_HEADER_AND_CHAIN_SLOTID)
+	  {
+	    continue;
+	  }
+	if (recdes.type == REC_RELOCATION || recdes.type == REC_BIGONE)
+	  {
+	    // record data is not in this page
+	    zone_set_not_summarized (filter);
+	    return;
+	  }
+	if (recdes.type != REC_HOME)
+	  {
+	    continue;
+	  }
+
+	if (or_mvcc_get_header (&recdes, &mvcc_header) != NO_ERROR)
+	  {
+	    er_clear ();
+	    zone_set_not_summarized (filter);
+	    return;
+	  }
+	if (MVCC_IS_FLAG_SET (&mvcc_header, OR_MVCC_FLAG_VALID_PREV_VERSION))
+	  {
+	    // older versions may be visible to scans
+	    zone_set_not_summarized (filter);
+	    return;
+	  }
+
+	if (heap_attrinfo_read_dbvalues_without_oid (thread_p, &recdes, &filter.m_attr_info) != NO_ERROR)
+	  {
+	    er_clear ();
+	    zone_set_not_summarized (filter);
+	    return;
+	  }
+
+	for (std::size_t i = 0; i < filter.m_attrids.size (); i++)
+	  {
+	    page_summary &summary = filter.m_page_summaries[i];
+
+	    value = heap_attrinfo_access (filter.m_attrids[i], &filter.m_attr_info);
+	    if (value == NULL)
+	      {
+		er_clear ();
+		zone_set_not_summarized (filter);
+		return;
+	      }
+	    if (DB_IS_NULL (value))
+	      {
+		summary.m_null_count++;
+		continue;
+	      }
+	    if (DB_VALUE_DOMAIN_TYPE (value) != filter.m_types[i])
+	      {
+		zone_set_not_summarized (filter);
+		return;
+	      }
+
+	    if (!summary.m_has_values)
+	      {
+		summary.m_min = *value;
+		summary.m_max = *value;
+		summary.m_has_values = true;
+	      }
+	    else if (tp_value_compare (value, &summary.m_min, 0, 1) == DB_LT)
+	      {
+		summary.m_min = *value;
+	      }
+	    else if (tp_value_compare (value, &summary.m_max, 0, 1) == DB_GT)
+	      {
+		summary.m_max = *value;
+	      }
+	    summary.m_min.need_clear = false;
+	    summary.m_max.need_clear = false;
+	  }
+      }
+  }
+
+  // true if no record summarized by summary can satisfy term
+  bool
+  zone_term_excludes_page (const heap_zone_filter::term &term, const page_summary &summary)
+  {
+    DB_VALUE_COMPARE_RESULT cmp_min, cmp_max;
+
+    if (!summary.m_is_summarized)
+      {
+	return false;
+      }
+    if (term.m_op == R_NULL)
+      {
+	return summary.m_null_count == 0;
+      }
+    if (!summary.m_has_values)
+      {
+	// comparison with null is never true
+	return true;
+      }
+
+    cmp_min = tp_value_compare (&summary.m_min, &term.m_value, 0, 1);
+    cmp_max = tp_value_compare (&summary.m_max, &term.m_value, 0, 1);
+    if (cmp_min == DB_UNK || cmp_max == DB_UNK)
+      {
+	return false;
+      }
+
+    switch (term.m_op)
+      {
+      case R_EQ:
+	return cmp_min == DB_GT || cmp_max == DB_LT;
+      case R_GT:
+	return cmp_max != DB_GT;
+      case R_GE:
+	return cmp_max == DB_LT;
+      case R_LT:
+	return cmp_min != DB_LT;
+      case R_LE:
+	return cmp_min == DB_GT;
+      default:
+	return false;
+      }
+  }
+
+  // look for valid summaries of page in zone maps; return true if all filter attributes are summarized
+  bool
+  zone_find_summaries (heap_zone_filter &filter, const VPID *vpid, const LOG_LSA *page_lsa)
+  {
+    std::int64_t range_key = zone_range_key (vpid);
+    int page_index = vpid->pageid % HEAP_ZONE_RANGE_PAGES;
+
+    std::lock_guard<std::mutex> lock (zone_Maps_mutex);
+
+    for (std::size_t i = 0; i < filter.m_attrids.size (); i++)
+      {
+	auto map_it = zone_Maps.find ({ filter.m_hfid, filter.m_attrids[i] });
+	if (map_it == zone_Maps.end () || map_it->second.m_type != filter.m_types[i])
+	  {
+	    return false;
+	  }
+	auto range_it = map_it->second.m_ranges.find (range_key);
+	if (range_it == map_it->second.m_ranges.end ())
+	  {
+	    return false;
+	  }
+	const page_summary &summary = range_it->second.m_pages[page_index];
+	if (!LSA_EQ (&summary.m_lsa, page_lsa))
+	  {
+	    return false;
+	  }
+	filter.m_page_summaries[i] = summary;
+      }
+    return true;
+  }
+
+  void
+  zone_save_summaries (const heap_zone_filter &filter, const VPID *vpid)
+  {
+    std::int64_t range_key = zone_range_key (vpid);
+    int page_index = vpid->pageid % HEAP_ZONE_RANGE_PAGES;
+    std::size_t max_ranges = (std::size_t) prm_get_integer_value (PRM_ID_HEAP_ZONE_MAP_MAX_RANGES);
+
+    std::lock_guard<std::mutex> lock (zone_Maps_mutex);
+
+    for (std::size_t i = 0; i < filter.m_attrids.size (); i++)
+      {
+	zone_map &map = zone_Maps[ { filter.m_hfid, filter.m_attrids[i]}];
+	if (map.m_ranges.empty () || map.m_type != filter.m_types[i])
+	  {
+	    // new map or attribute type was changed
+	    zone_Range_count -= map.m_ranges.size ();
+	    map.m_ranges.clear ();
+	    map.m_type = filter.m_types[i];
+	  }
+
+	auto range_it = map.m_ranges.find (range_key);
+	if (range_it == map.m_ranges.end ())
+	  {
+	    if (zone_Range_count >= max_ranges)
+	      {
+		// zone maps are relearned by next scans
+		zone_Maps.clear ();
+		zone_Range_count = 0;
+		return;
+	      }
+	    range_it = map.m_ranges.emplace (range_key, zone_range ()).first;
+	    zone_Range_count++;
+	  }
+	range_it->second.m_pages[page_index] = filter.m_page_summaries[i];
+      }
+  }
+}
+
+/*
+ * heap_zone_filter_create () - create zone filter of a heap scan
+ *
+ * return        : zone filter or NULL if predicate has no terms that can use zone maps
+ * thread_p (in) : thread entry
+ * hfid (in)     : scanned heap file
+ * class_oid (in): class of scanned objects
+ * pred (in)     : data filter of heap scan
+ * vd (in)       : value descriptor for host variables
+ */
+heap_zone_filter *
+heap_zone_filter_create (THREAD_ENTRY *thread_p, const HFID *hfid, const OID *class_oid,
+			 const cubxasl::pred_expr *pred, val_descr *vd)
+{
+  heap_zone_filter *filter;
+
+  if (pred == NULL || prm_get_integer_value (PRM_ID_HEAP_ZONE_MAP_MAX_RANGES) <= 0)
+    {
+      return NULL;
+    }
+
+  filter = new heap_zone_filter ();
+  zone_collect_terms (thread_p, pred, vd, *filter);
+  if (filter->m_terms.empty ())
+    {
+      delete filter;
+      return NULL;
+    }
+
+  if (heap_attrinfo_start (thread_p, class_oid, (int) filter->m_attrids.size (), filter->m_attrids.data (),
+			   &filter->m_attr_info) != NO_ERROR)
+    {
+      // scan works without zone filter
+      er_clear ();
+      delete filter;
+      return NULL;
+    }
+  filter->m_is_attr_info_started = true;
+
+  filter->m_hfid = *hfid;
+  filter->m_page_summaries.resize (filter->m_attrids.size ());
+
+  return filter;
+}
+
+/*
+ * heap_zone_filter_destroy () - destroy zone filter of a heap scan
+ *
+ * return        : void
+ * thread_p (in) : thread entry
+ * filter (in)   : zone filter
+ */
+void
+heap_zone_filter_destroy (THREAD_ENTRY *thread_p, heap_zone_filter *filter)
+{
+  if (filter == NULL)
+    {
+      return;
+    }
+  if (filter->m_is_attr_info_started)
+    {
+      heap_attrinfo_end (thread_p, &filter->m_attr_info);
+    }
+  delete filter;
+}
+
+/*
+ * heap_zone_filter_can_skip_page () - check zone map of heap page to find out if any of its records can satisfy
+ *				       the scan filter
+ *
+ * return        : true if no record of page can satisfy the filter
+ * thread_p (in) : thread entry
+ * filter (in)   : zone filter
+ * pgptr (in)    : heap page fixed for read
+ *
+ * note: page is summarized if its zone map is missing or outdated.
+ */
+bool
+heap_zone_filter_can_skip_page (THREAD_ENTRY *thread_p, heap_zone_filter *filter, PAGE_PTR pgptr)
+{
+  const VPID *vpid = pgbuf_get_vpid_ptr (pgptr);
+  const LOG_LSA *page_lsa = pgbuf_get_lsa (pgptr);
+
+  assert (filter != NULL);
+
+  if (!zone_find_summaries (*filter, vpid, page_lsa))
+    {
+      zone_summarize_page (thread_p, *filter, pgptr, page_lsa);
+      zone_save_summaries (*filter, vpid);
+    }
+
+  for (const heap_zone_filter::term &term : filter->m_terms)
+    {
+      for (std::size_t i = 0; i < filter->m_attrids.size (); i++)
+	{
+	  if (filter->m_attrids[i] == term.m_attrid && zone_term_excludes_page (term, filter->m_page_summaries[i]))
+	    {
+	      return true;
+	    }
+	}
+    }
+  return false;
+}
+
+/*
+ * heap_zone_map_remove () - remove zone maps of heap file
+ *
+ * return    : void
+ * hfid (in) : heap file
+ */
+void
+heap_zone_map_remove (const HFID *hfid)
+{
+  std::lock_guard<std::mutex> lock (zone_Maps_mutex);
+
+  for (auto it = zone_Maps.begin (); it != zone_Maps.end ();)
+    {
+      if (HFID_EQ (&it->first.m_hfid, hfid))
+	{
+	  zone_Range_count -= it->second.m_ranges.size ();
+	  it = zone_Maps.erase (it);
+	}
+      else
+	{
+	  ++it;
+	}
+    }
+}
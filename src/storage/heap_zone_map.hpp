@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+//
+// Heap zone maps - min/max summaries of heap pages used by heap scans to skip pages
+//
+// Zone maps are kept in memory and are learned by heap scans: the first scan that reaches a page with a filter on
+// attribute A summarizes A over all records of the page (minimum, maximum and null count). Summaries are grouped in
+// ranges of HEAP_ZONE_RANGE_PAGES pages and each page summary is stamped with the page LSA it was computed for, so any
+// change of the page (insert, update, delete, vacuum) invalidates its summary without any hook on the write path.
+//
+// A scan with a conjunction of "attribute <op> constant" terms skips a page when one of the terms cannot be true for
+// any record of the page.
+//
+
+#ifndef _HEAP_ZONE_MAP_HPP_
+#define _HEAP_ZONE_MAP_HPP_
+
+#if !defined (SERVER_MODE) && !defined (SA_MODE)
+#error Belongs to server module
+#endif /* !defined (SERVER_MODE) && !defined (SA_MODE) */
+
+#include "storage_common.h"
+#include "thread_compat.hpp"
+
+// forward definitions
+namespace cubxasl
+{
+  struct pred_expr;
+}
+struct val_descr;
+
+class heap_zone_filter;
+
+const int HEAP_ZONE_RANGE_PAGES = 32;
+
+heap_zone_filter *heap_zone_filter_create (THREAD_ENTRY *thread_p, const HFID *hfid, const OID *class_oid,
+    const cubxasl::pred_expr *pred, val_descr *vd);
+void heap_zone_filter_destroy (THREAD_ENTRY *thread_p, heap_zone_filter *filter);
+bool heap_zone_filter_can_skip_page (THREAD_ENTRY *thread_p, heap_zone_filter *filter, PAGE_PTR pgptr);
+
+void heap_zone_map_remove (const HFID *hfid);
+
+#endif // _HEAP_ZONE_MAP_HPP_
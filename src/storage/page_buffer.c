@@ -9961,6 +9961,48 @@ pgbuf_get_check_page_validation_level (int page_validation_level)
 #endif /* NDEBUG */
 }
 
+/*
+ * pgbuf_prefetch_pages () - ask for the pages that are not in the page buffer to be read in the background
+ *   return: number of pages requested
+ *   vpids(in): Page identifiers, preferably in ascending order
+ *   n_vpids(in): Number of pages
+ *
+ * Note: Pages are not fixed; a following pgbuf_fix finds them in the file system cache if the read ended. Pages that
+ *       are not valid anymore are harmless since only the operating system reads them.
+ */
+int
+pgbuf_prefetch_pages (THREAD_ENTRY * thread_p, const VPID * vpids, int n_vpids)
+{
+  PGBUF_BUFFER_HASH *hash_anchor;
+  PGBUF_BCB *bufptr;
+  int vol_fd;
+  int n_requested = 0;
+  int i;
+
+  for (i = 0; i < n_vpids; i++)
+    {
+      hash_anchor = &pgbuf_Pool.buf_hash_table[PGBUF_HASH_VALUE (&vpids[i])];
+      bufptr = pgbuf_search_hash_chain (thread_p, hash_anchor, &vpids[i]);
+      if (bufptr != NULL)
+	{
+	  /* already in buffer */
+	  PGBUF_BCB_UNLOCK (bufptr);
+	  continue;
+	}
+      pthread_mutex_unlock (&hash_anchor->hash_mutex);
+
+      vol_fd = fileio_get_volume_descriptor (vpids[i].volid);
+      if (vol_fd == NULL_VOLDES)
+	{
+	  continue;
+	}
+      fileio_prefetch (vol_fd, vpids[i].pageid, IO_PAGESIZE);
+      n_requested++;
+    }
+
+  return n_requested;
+}
+
 /*
  * pgbuf_is_valid_page () - Verify if given page is a valid one
  *   return: either: DISK_INVALID, DISK_VALID, DISK_ERROR
@@ -325,6 +325,7 @@ extern int pgbuf_invalidate (THREAD_ENTRY * thread_p, PAGE_PTR pgptr);
 #endif /* NDEBUG */
 extern PAGE_PTR pgbuf_flush_with_wal (THREAD_ENTRY * thread_p, PAGE_PTR pgptr);
 extern void pgbuf_flush_if_requested (THREAD_ENTRY * thread_p, PAGE_PTR page);
+extern int pgbuf_prefetch_pages (THREAD_ENTRY * thread_p, const VPID * vpids, int n_vpids);
 extern int pgbuf_flush_victim_candidates (THREAD_ENTRY * thread_p, float flush_ratio,
 					  PERF_UTIME_TRACKER * time_tracker, bool * stop);
 extern int pgbuf_flush_checkpoint (THREAD_ENTRY * thread_p, const LOG_LSA * flush_upto_lsa,
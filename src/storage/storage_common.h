@@ -181,6 +181,7 @@ typedef enum
   (MAX (ISCAN_OID_BUFFER_MIN_CAPACITY, ISCAN_OID_BUFFER_SIZE))
 
 typedef UINT64 MVCCID;		/* MVCC ID */
+typedef UINT64 MVCC_CSN;	/* MVCC commit sequence number */
 
 
 
@@ -354,6 +355,8 @@ typedef int TRANID;		/* Transaction identifier */
     } \
   while ((id) < MVCCID_FIRST)
 
+#define MVCC_CSN_NULL	      ((MVCC_CSN) 0)	/* snapshot is not based on commit sequence numbers */
+
 
 #define COMPOSITE_LOCK(scan_op_type)	(scan_op_type != S_SELECT)
 #define READONLY_SCAN(scan_op_type)	(scan_op_type == S_SELECT)
@@ -1052,6 +1055,9 @@ typedef enum
   SHOWSTMT_FULL_TIMEZONES,
   SHOWSTMT_TRAN_TABLES,
   SHOWSTMT_THREADS,
+  SHOWSTMT_VACUUM_STATUS,
+  SHOWSTMT_VACUUM_TABLES,
+  SHOWSTMT_VACUUM_THREADS,
 
   /* append the new show statement types in here */
 
@@ -1254,7 +1260,8 @@ typedef enum
 {
   HS_NONE = 0,			/* no hash aggregation */
   HS_ACCEPT_ALL,		/* accept tuples in hash table */
-  HS_REJECT_ALL			/* reject tuples, use normal sort-based aggregation */
+  HS_REJECT_ALL,		/* reject tuples, use normal sort-based aggregation */
+  HS_PARTITIONED		/* accept tuples, groups spilled to hash partitions aggregated one by one */
 } AGGREGATE_HASH_STATE;
 
 #endif /* _STORAGE_COMMON_H_ */
@@ -199,6 +199,9 @@ static DISK_ISVALID locator_check_unique_btree_entries (THREAD_ENTRY * thread_p,
 static int locator_eval_filter_predicate (THREAD_ENTRY * thread_p, BTID * btid, OR_PREDICATE * or_pred, OID * class_oid,
 					  OID ** inst_oids, int num_insts, RECDES ** recs, DB_LOGICAL * results);
 static bool locator_was_index_already_applied (HEAP_CACHE_ATTRINFO * index_attrinfo, BTID * btid, int pos);
+static bool locator_index_has_updated_attr (const OR_INDEX * index, const ATTR_ID * att_id, int n_att_id);
+static bool locator_is_heap_only_update (THREAD_ENTRY * thread_p, const OR_CLASSREP * classrepr,
+					 const ATTR_ID * att_id, int n_att_id, const REPL_INFO * repl_info);
 static LC_FIND_CLASSNAME xlocator_reserve_class_name (THREAD_ENTRY * thread_p, const char *classname, OID * class_oid);
 
 static int locator_filter_errid (THREAD_ENTRY * thread_p, int num_ignore_error_count, int *ignore_error_list);
@@ -7514,6 +7517,85 @@ locator_was_index_already_applied (HEAP_CACHE_ATTRINFO * index_attrinfo, BTID *
   return false;
 }
 
+/*
+ * locator_index_has_updated_attr () - Check if an index key has one of the updated attributes
+ *
+ * return: true if one of the updated attributes is part of the index key
+ *
+ *   index(in): index
+ *   att_id(in): updated attribute identifiers
+ *   n_att_id(in): number of updated attributes
+ */
+static bool
+locator_index_has_updated_attr (const OR_INDEX * index, const ATTR_ID * att_id, int n_att_id)
+{
+  int i, j;
+
+  for (i = 0; i < n_att_id; i++)
+    {
+      for (j = 0; j < index->n_atts; j++)
+	{
+	  if (att_id[i] == (ATTR_ID) (index->atts[j]->id))
+	    {
+	      return true;
+	    }
+	}
+    }
+
+  return false;
+}
+
+/*
+ * locator_is_heap_only_update () - Check if an update can leave all index entries of the object untouched
+ *
+ * return: true if no index has to be checked or changed by the update
+ *
+ *   classrepr(in): last representation of the class
+ *   att_id(in): updated attribute identifiers
+ *   n_att_id(in): number of updated attributes
+ *   repl_info(in): replication info
+ *
+ * Note: Updates keep the OID of the object, so an index whose key has none of the updated attributes keeps the same
+ *	 entry for the object. Filtered indexes are not skipped (the filter may use other attributes) and neither is a
+ *	 primary key referred by foreign keys or a primary key that gives the key of the replication log.
+ */
+static bool
+locator_is_heap_only_update (THREAD_ENTRY * thread_p, const OR_CLASSREP * classrepr, const ATTR_ID * att_id,
+			     int n_att_id, const REPL_INFO * repl_info)
+{
+  const OR_INDEX *index;
+  bool need_repl_key;
+  int i;
+
+  if (att_id == NULL)
+    {
+      /* updated attributes are not known */
+      return false;
+    }
+
+  need_repl_key = (repl_info != NULL && repl_info->need_replication && !LOG_CHECK_LOG_APPLIER (thread_p)
+		   && log_does_allow_replication ());
+
+  for (i = 0; i < classrepr->n_indexes; i++)
+    {
+      index = &classrepr->indexes[i];
+      if (index->filter_predicate != NULL)
+	{
+	  return false;
+	}
+      if (index->type == BTREE_PRIMARY_KEY && (index->fk != NULL || need_repl_key))
+	{
+	  return false;
+	}
+      if (locator_index_has_updated_attr (index, att_id, n_att_id))
+	{
+	  return false;
+	}
+    }
+
+  return true;
+}
+
 /*
  * locator_add_or_remove_index () - Add or remove index entries
  *
@@ -7543,6 +7625,103 @@ locator_add_or_remove_index (THREAD_ENTRY * thread_p, RECDES * recdes, OID * ins
 					       has_BU_lock, skip_checking_fk);
 }
 
+/*
+ * locator_start_index_insert_batch () - Start collecting the index keys of objects inserted with given scan cache.
+ *
+ * return: NO_ERROR if all OK, ER_ status otherwise
+ *
+ *   scan_cache(in/out): Scan cache of a multi-row insert
+ *
+ * Note: The keys are inserted sorted, index by index, when the batch is full and when locator_flush_index_insert_batch
+ *       is called at the end of insert. Nothing is done if the class has a foreign key, since it may reference the
+ *       class itself and the key of a previous row must be found when checking the next one.
+ */
+int
+locator_start_index_insert_batch (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache)
+{
+  OR_CLASSREP *classrepr = NULL;
+  int classrepr_cacheindex = -1;
+  bool has_fk = false;
+  int i;
+  int error_code = NO_ERROR;
+
+  assert (scan_cache != NULL && scan_cache->m_index_insert_batch == NULL);
+
+  if (prm_get_integer_value (PRM_ID_INDEX_INSERT_BATCH_SIZE) <= 0 || scan_cache->m_index_stats == NULL)
+    {
+      /* Disabled, or this is not a multi-row operation on a class with indexes. */
+      return NO_ERROR;
+    }
+
+  classrepr = heap_classrepr_get (thread_p, &scan_cache->node.class_oid, NULL, NULL_REPRID, &classrepr_cacheindex);
+  if (classrepr == NULL)
+    {
+      ASSERT_ERROR_AND_SET (error_code);
+      return error_code;
+    }
+  for (i = 0; i < classrepr->n_indexes; i++)
+    {
+      if (classrepr->indexes[i].type == BTREE_FOREIGN_KEY)
+	{
+	  has_fk = true;
+	  break;
+	}
+    }
+  heap_classrepr_free_and_init (classrepr, &classrepr_cacheindex);
+
+  if (!has_fk)
+    {
+      scan_cache->m_index_insert_batch = new btree_insert_batch ();
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * locator_flush_index_insert_batch () - Insert the index keys collected by the scan cache of a multi-row insert.
+ *
+ * return: NO_ERROR if all OK, ER_ status otherwise
+ *
+ *   scan_cache(in/out): Scan cache of a multi-row insert
+ *
+ * Note: Unique constraints are checked while the keys are inserted, so this must be called before the unique
+ *       statistics of the insert are verified.
+ */
+int
+locator_flush_index_insert_batch (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache)
+{
+  MVCC_REC_HEADER mvcc_rec_header[2];
+  MVCC_REC_HEADER *p_mvcc_rec_header = NULL;
+  MVCCID mvccid;
+  int error_code = NO_ERROR;
+
+  if (scan_cache == NULL || scan_cache->m_index_insert_batch == NULL
+      || scan_cache->m_index_insert_batch->get_key_count () == 0)
+    {
+      return NO_ERROR;
+    }
+
+#if defined(SERVER_MODE)
+  if (!mvcc_is_mvcc_disabled_class (&scan_cache->node.class_oid)
+      && lock_has_lock_on_object (&scan_cache->node.class_oid, oid_Root_class_oid, BU_LOCK) <= 0)
+    {
+      /* Same insert MVCCID as locator_add_or_remove_index_internal would use. */
+      mvccid = logtb_get_current_mvccid (thread_p);
+      btree_set_mvcc_header_ids_for_update (thread_p, false, true, &mvccid, mvcc_rec_header);
+      p_mvcc_rec_header = mvcc_rec_header;
+    }
+#endif /* SERVER_MODE */
+
+  error_code =
+    scan_cache->m_index_insert_batch->flush (thread_p, MULTI_ROW_INSERT, scan_cache->m_index_stats, p_mvcc_rec_header);
+  if (error_code != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+    }
+
+  return error_code;
+}
+
 /*
  * locator_add_or_remove_index_for_moving () - Add or remove index entries
  *                                             To move record between partitions.
@@ -7784,6 +7963,18 @@ locator_add_or_remove_index_internal (THREAD_ENTRY * thread_p, RECDES * recdes,
 		    btree_online_index_dispatcher (thread_p, &btid, key_dbvalue, class_oid, inst_oid, unique_pk,
 						   BTREE_OP_ONLINE_INDEX_TRAN_INSERT, NULL);
 		}
+	      else if (scan_cache != NULL && scan_cache->m_index_insert_batch != NULL && !DB_IS_NULL (key_dbvalue)
+		       && !btree_multicol_key_is_null (key_dbvalue))
+		{
+		  /* Multi-row insert. Key is inserted with the other keys of the index when the batch is flushed. */
+		  error_code =
+		    scan_cache->m_index_insert_batch->add_key (thread_p, btid, *class_oid, key_dbvalue, *inst_oid);
+		  if (error_code == NO_ERROR && (int) scan_cache->m_index_insert_batch->get_key_count ()
+		      >= prm_get_integer_value (PRM_ID_INDEX_INSERT_BATCH_SIZE))
+		    {
+		      error_code = locator_flush_index_insert_batch (thread_p, scan_cache);
+		    }
+		}
 	      else
 		{
 		  error_code =
@@ -8151,7 +8342,7 @@ locator_update_index (THREAD_ENTRY * thread_p, RECDES * new_recdes, RECDES * old
   bool new_isnull, old_isnull;
   PR_TYPE *pr_type;
   OR_INDEX *index = NULL;
-  int i, j, k, num_btids, old_num_btids, unique_pk;
+  int i, num_btids, old_num_btids, unique_pk;
   bool found_btid = true;
   btree_unique_stats *unique_stat_info;
   HEAP_IDX_ELEMENTS_INFO new_idx_info;
@@ -8250,6 +8441,27 @@ locator_update_index (THREAD_ENTRY * thread_p, RECDES * new_recdes, RECDES * old
       return NO_ERROR;
     }
 
+  /*
+   * Heap-only update: none of the updated attributes is part of an index key, so the keys of the old and new
+   * versions are the same and there is no need to read them.
+   */
+  if (locator_is_heap_only_update (thread_p, new_attrinfo->last_classrepr, att_id, n_att_id, repl_info))
+    {
+      /* same as no primary key below: clear repl_insert_lsa and do not replicate the record */
+      tdes = LOG_FIND_CURRENT_TDES (thread_p);
+      LSA_SET_NULL (&tdes->repl_insert_lsa);
+      if (repl_info != NULL)
+	{
+	  repl_info->need_replication = false;
+	}
+
+      heap_attrinfo_end (thread_p, new_attrinfo);
+      heap_attrinfo_end (thread_p, old_attrinfo);
+
+      perfmon_inc_stat (thread_p, PSTAT_HEAP_HOT_UPDATES);
+      return NO_ERROR;
+    }
+
   /*
    * There are indices and the index attrinfo has been initialized
    * Indices must be updated when the indexed attributes have changed in value
@@ -8299,21 +8511,11 @@ locator_update_index (THREAD_ENTRY * thread_p, RECDES * new_recdes, RECDES * old
 	  pk_btid_index = i;
 	}
 
-      /* check for specified update attributes */
-      if ((att_id != NULL) && ((use_mvcc == false) || (index->type == BTREE_PRIMARY_KEY && index->fk != NULL)))
+      /* check for specified update attributes; the object keeps its OID, so the entry of an index whose key has no
+       * updated attribute does not change */
+      if (att_id != NULL)
 	{
-	  found_btid = false;	/* guess as not found */
-
-	  for (j = 0; j < n_att_id && !found_btid; j++)
-	    {
-	      for (k = 0; k < index->n_atts && !found_btid; k++)
-		{
-		  if (att_id[j] == (ATTR_ID) (index->atts[k]->id))
-		    {		/* the index key_type has updated attr */
-		      found_btid = true;
-		    }
-		}
-	    }
+	  found_btid = locator_index_has_updated_attr (index, att_id, n_att_id);
 
 	  /* in MVCC, in case of BTREE_PRIMARY_KEY having FK need to update PK index but skip foreign key restrictions
 	   * checking */
@@ -13726,6 +13928,25 @@ locator_multi_insert_force (THREAD_ENTRY * thread_p, HFID * hfid, OID * class_oi
 
   *force_count = 0;
 
+  if (has_index && dont_check_fk)
+    {
+      if (scan_cache->m_index_insert_batch == NULL)
+	{
+	  // Collect the index keys of all records and insert them sorted at the end.
+	  error_code = locator_start_index_insert_batch (thread_p, scan_cache);
+	  if (error_code != NO_ERROR)
+	    {
+	      ASSERT_ERROR ();
+	      return error_code;
+	    }
+	}
+      else
+	{
+	  // Keys left by a failed call belong to records that were rolled back.
+	  scan_cache->m_index_insert_batch->clear ();
+	}
+    }
+
   // Take into account the unfill factor of the heap file.
   heap_max_page_size = heap_nonheader_page_capacity () * (1.0f - prm_get_float_value (PRM_ID_HF_UNFILL_FACTOR));
 
@@ -13834,6 +14055,14 @@ locator_multi_insert_force (THREAD_ENTRY * thread_p, HFID * hfid, OID * class_oi
 	}
     }
 
+  // Insert the index keys of this batch of records.
+  error_code = locator_flush_index_insert_batch (thread_p, scan_cache);
+  if (error_code != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      return error_code;
+    }
+
   // Log the postpone operation
   heap_log_postpone_heap_append_pages (thread_p, hfid, class_oid, heap_pages_array);
 
@@ -104,6 +104,8 @@ extern int locator_add_or_remove_index (THREAD_ENTRY * thread_p, RECDES * recdes
 					int is_insert, int op_type, HEAP_SCANCACHE * scan_cache, bool datayn,
 					bool replyn, HFID * hfid, FUNC_PRED_UNPACK_INFO * func_preds, bool has_BU_lock,
 					bool skip_checking_fk);
+extern int locator_start_index_insert_batch (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache);
+extern int locator_flush_index_insert_batch (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache);
 extern int locator_update_index (THREAD_ENTRY * thread_p, RECDES * new_recdes, RECDES * old_recdes, ATTR_ID * att_id,
 				 int n_att_id, OID * oid, OID * class_oid, int op_type,
 				 HEAP_SCANCACHE * scan_cache, REPL_INFO * repl_info);
@@ -41,6 +41,9 @@
 #include "locator.h"
 #include "lock_free.h"
 #include "lock_manager.h"
+#if defined (SERVER_MODE)
+#include "lock_wait.hpp"
+#endif /* SERVER_MODE */
 #include "log_impl.h"
 #include "log_manager.h"
 #include "memory_alloc.h"
@@ -311,6 +314,45 @@ struct lk_res_block
 /*
  * Transaction Lock Entry Structure
  */
+/*
+ * Fast path of weak class locks
+ *
+ * IS and IX class locks are compatible with each other, so they are kept in per-transaction slots instead of the
+ * shared lock table, as long as no transaction asks for a conflicting (strong) lock on the class. A strong lock request
+ * increments a counter of the partition of its class and moves all fast path locks of the class to the shared table
+ * before checking conflicts. The fast path entry has a private resource, so it looks like any other class lock entry
+ * in the transaction hold list.
+ */
+#define LK_FASTPATH_SLOT_COUNT 16
+#define LK_FASTPATH_STRONG_PARTITIONS 1024
+
+typedef struct lk_fastpath_slot LK_FASTPATH_SLOT;
+struct lk_fastpath_slot
+{
+  LK_RES res;			/* private resource of the class lock; its only holder is entry */
+  LK_ENTRY *entry;		/* lock entry; NULL if the slot is free */
+};
+
+/*
+ * Lock entry arena of a transaction
+ *
+ * Lock entries of a transaction are carved out of blocks owned by the transaction and freed entries go back to the
+ * free list of the arena, so neither needs any synchronization. When the transaction releases all its locks, the arena
+ * keeps only its first block and gives the others back at once. The memory of all arenas is accounted against
+ * lock_memory_budget_in_mbytes, which drives lock escalation (see lock_get_escalation_threshold).
+ */
+#define LK_ARENA_BLOCK_ENTRIES 256
+
+typedef struct lk_arena_block LK_ARENA_BLOCK;
+struct lk_arena_block
+{
+  LK_ARENA_BLOCK *next;		/* next (older) block */
+  LK_ENTRY entries[LK_ARENA_BLOCK_ENTRIES];
+};
+
+/* Lock escalation threshold under memory pressure never goes below this number of granules. */
+#define LK_ESCALATION_MIN_GRANULES 1000
+
 typedef struct lk_tran_lock LK_TRAN_LOCK;
 struct lk_tran_lock
 {
@@ -319,8 +361,11 @@ struct lk_tran_lock
   LK_ENTRY *inst_hold_list;	/* instance lock hold list */
   LK_ENTRY *class_hold_list;	/* class lock hold list */
   LK_ENTRY *root_class_hold;	/* root class lock hold */
-  LK_ENTRY *lk_entry_pool;	/* local pool of lock entries which can be used with no synchronization. */
-  int lk_entry_pool_count;	/* Current count of lock entries in local pool. */
+  LK_ENTRY *lk_entry_pool;	/* free entries of the arena, which can be used with no synchronization. */
+  LK_ARENA_BLOCK *arena_blocks;	/* blocks of the arena; entries are carved from the first one */
+  int arena_block_count;	/* # of blocks in the arena */
+  int arena_carved_count;	/* # of entries carved from the first block */
+  int arena_used_count;		/* # of arena entries in use */
   int inst_hold_count;		/* # of entries in inst_hold_list */
   int class_hold_count;		/* # of entries in class_hold_list */
 
@@ -336,9 +381,12 @@ struct lk_tran_lock
 
   /* locking on manual duration */
   bool is_instant_duration;
+
+  /* fast path class locks */
+  pthread_mutex_t fastpath_mutex;	/* mutex for fast path slots */
+  LK_FASTPATH_SLOT *fastpath_slots;	/* LK_FASTPATH_SLOT_COUNT slots */
+  int fastpath_count;		/* # of used fast path slots */
 };
-/* Max size of transaction local pool of lock entries. */
-#define LOCK_TRAN_LOCAL_POOL_MAX_SIZE 10
 
 /*
  * Lock Manager Global Data Structure
@@ -380,6 +428,32 @@ struct lk_global_data
   bool dump_level;
 #endif				/* LK_DUMP */
 
+  /* fast path of weak class locks */
+  bool fastpath_enabled;
+  // *INDENT-OFF*
+  std::atomic<int> fastpath_strong_count[LK_FASTPATH_STRONG_PARTITIONS];	/* strong class locks by partition */
+  // *INDENT-ON*
+
+  /* deadlock probe of lock waiters */
+  bool deadlock_probe_enabled;
+  pthread_mutex_t DL_probe_mutex;
+  // *INDENT-OFF*
+  std::atomic<bool> deadlock_probe_missed;	/* a probe gave up; the full scan must not be delayed */
+  // *INDENT-ON*
+
+  /* lock entry memory and escalation */
+  // *INDENT-OFF*
+  std::atomic<INT64> entry_memory;	/* bytes of lock entry arenas */
+  std::atomic<INT64> entry_memory_peak;	/* peak of entry_memory */
+  std::atomic<INT64> num_escalations;	/* # of lock escalations */
+  std::atomic<INT64> num_pressure_escalations;	/* # of lock escalations before lock_escalation granules */
+  // *INDENT-ON*
+
+  /* spin-then-park waiting of lock requesters */
+  // *INDENT-OFF*
+  lock_wait_spinner wait_spinner;
+  // *INDENT-ON*
+
   // *INDENT-OFF*
   lk_global_data ()
     : max_obj_locks (0)
@@ -400,6 +474,15 @@ struct lk_global_data
 #if defined(LK_DUMP)
     , dump_level (0)
 #endif
+    , fastpath_enabled (false)
+    , deadlock_probe_enabled (false)
+    , DL_probe_mutex PTHREAD_MUTEX_INITIALIZER
+    , deadlock_probe_missed { false }
+    , entry_memory { 0 }
+    , entry_memory_peak { 0 }
+    , num_escalations { 0 }
+    , num_pressure_escalations { 0 }
+    , wait_spinner ()
   {
   }
   // *INDENT-ON*
@@ -444,6 +527,13 @@ static const int LK_MIN_TWFG_EDGE_COUNT = 200;
 /* TODO : change const */
 #define LK_MAX_TWFG_EDGE_COUNT (MAX_NTRANS * MAX_NTRANS)
 
+/* deadlock probe of lock waiters related constants */
+#define LK_DEADLOCK_PROBE_MAX_DEPTH 16	/* max # of transactions in a cycle found by the probe */
+#define LK_DEADLOCK_PROBE_MAX_EDGES 16	/* max # of wait-for edges followed from a transaction */
+#define LK_DEADLOCK_PROBE_MAX_VISITS 64	/* max # of transactions visited by a probe */
+/* the full wait-for graph scan is run this many times less often while lock waiters probe for deadlocks */
+static const int LK_DEADLOCK_BACKSTOP_FACTOR = 10;
+
 #define DEFAULT_WAIT_USERS	10
 static const int LK_COMPOSITE_LOCK_OID_INCREMENT = 100;
 #endif /* SERVER_MODE */
@@ -451,6 +541,24 @@ static const int LK_COMPOSITE_LOCK_OID_INCREMENT = 100;
 #if defined(SERVER_MODE)
 
 static LK_WFG_EDGE TWFG_edge_block[LK_MID_TWFG_EDGE_COUNT];
+
+/* wait-for edge followed by the deadlock probe of a lock waiter */
+typedef struct lk_probe_edge LK_PROBE_EDGE;
+struct lk_probe_edge
+{
+  int to_tran_index;		/* the transaction waited for */
+  bool holder_flag;		/* true if it holds the lock; false if it is a waiter ahead */
+};
+
+/* transaction on the path of the deadlock probe */
+typedef struct lk_probe_frame LK_PROBE_FRAME;
+struct lk_probe_frame
+{
+  int tran_index;
+  int edge_count;		/* # of wait-for edges of the transaction */
+  int next_edge;		/* next edge to follow */
+  LK_PROBE_EDGE edges[LK_DEADLOCK_PROBE_MAX_EDGES];
+};
 static LK_DEADLOCK_VICTIM victims[LK_MAX_VICTIM_COUNT];
 static int victim_count;
 #else /* !SERVER_MODE */
@@ -489,12 +597,35 @@ static int lock_delete_from_tran_hold_list (LK_ENTRY * entry_ptr, int owner_tran
 static void lock_insert_into_tran_non2pl_list (LK_ENTRY * non2pl, int owner_tran_index);
 static int lock_delete_from_tran_non2pl_list (LK_ENTRY * non2pl, int owner_tran_index);
 static LK_ENTRY *lock_find_tran_hold_entry (THREAD_ENTRY * thread_p, int tran_index, const OID * oid, bool is_class);
+static bool lock_fastpath_is_weak_mode (LOCK lock);
+static bool lock_fastpath_is_strong_mode (LOCK lock);
+static int lock_fastpath_get_partition (const OID * class_oid);
+static LK_ENTRY *lock_fastpath_acquire (THREAD_ENTRY * thread_p, int tran_index, const OID * class_oid, LOCK lock,
+				       LK_ENTRY * class_entry, bool is_instant_duration);
+static bool lock_fastpath_convert (THREAD_ENTRY * thread_p, LK_ENTRY * entry_ptr, LOCK new_mode);
+static bool lock_fastpath_release (THREAD_ENTRY * thread_p, LK_ENTRY * entry_ptr, bool release_flag,
+				   bool move_to_non2pl);
+static void lock_fastpath_transfer_slot (THREAD_ENTRY * thread_p, LK_TRAN_LOCK * tran_lock, LK_FASTPATH_SLOT * slot);
+static LK_RES *lock_fastpath_transfer_entry (THREAD_ENTRY * thread_p, LK_ENTRY * entry_ptr);
+static void lock_fastpath_transfer_class (THREAD_ENTRY * thread_p, const OID * class_oid);
+static bool lock_fastpath_begin_strong (THREAD_ENTRY * thread_p, int tran_index, const OID * class_oid);
+static void lock_fastpath_end_strong (const OID * class_oid);
 static bool lock_force_timeout_expired_wait_transactions (void *thrd_entry);
 static bool lock_is_local_deadlock_detection_interval_up (void);
+#if defined(SERVER_MODE)
+static int lock_probe_add_edge (LK_PROBE_EDGE * edges, int edge_count, int to_tran_index, bool holder_flag);
+static int lock_probe_get_waits_for (int tran_index, LK_PROBE_EDGE * edges);
+static bool lock_probe_find_cycle (int tran_index, int *cycle, int *cycle_len, bool * is_complete);
+static LOCK_WAIT_STATE lock_probe_deadlock (THREAD_ENTRY * thread_p, LK_ENTRY * entry_ptr, int *cycle,
+					    int *cycle_len);
+static void lock_probe_report_deadlock (THREAD_ENTRY * thread_p, const int *cycle, int cycle_len);
+#endif /* SERVER_MODE */
 static void lock_detect_local_deadlock (THREAD_ENTRY * thread_p);
 static bool lock_is_class_lock_escalated (LOCK class_lock, LOCK lock_escalation);
 static LK_ENTRY *lock_add_non2pl_lock (THREAD_ENTRY * thread_p, LK_RES * res_ptr, int tran_index, LOCK lock);
 static void lock_position_holder_entry (LK_RES * res_ptr, LK_ENTRY * entry_ptr);
+static void lock_append_waiter (LK_RES * res_ptr, LK_ENTRY * entry_ptr);
+static void lock_remove_waiter (LK_RES * res_ptr, LK_ENTRY * prev_ptr, LK_ENTRY * entry_ptr);
 static void lock_set_error_for_timeout (THREAD_ENTRY * thread_p, LK_ENTRY * entry_ptr);
 static void lock_set_error_for_aborted (LK_ENTRY * entry_ptr);
 static void lock_set_tran_abort_reason (int tran_index, TRAN_ABORT_REASON abort_reason);
@@ -505,7 +636,9 @@ static bool lock_wakeup_deadlock_victim_aborted (int tran_index);
 static void lock_grant_blocked_holder (THREAD_ENTRY * thread_p, LK_RES * res_ptr);
 static int lock_grant_blocked_waiter (THREAD_ENTRY * thread_p, LK_RES * res_ptr);
 static void lock_grant_blocked_waiter_partial (THREAD_ENTRY * thread_p, LK_RES * res_ptr, LK_ENTRY * from_whom);
-static bool lock_check_escalate (THREAD_ENTRY * thread_p, LK_ENTRY * class_entry, LK_TRAN_LOCK * tran_lock);
+static int lock_get_escalation_threshold (void);
+static bool lock_check_escalate (THREAD_ENTRY * thread_p, LK_ENTRY * class_entry, LK_TRAN_LOCK * tran_lock,
+				 int threshold);
 static int lock_escalate_if_needed (THREAD_ENTRY * thread_p, LK_ENTRY * class_entry, int tran_index);
 static int lock_internal_hold_lock_object_instant (THREAD_ENTRY * thread_p, int tran_index, const OID * oid,
 						   const OID * class_oid, LOCK lock);
@@ -546,10 +679,14 @@ static void lock_event_set_xasl_id_to_entry (int tran_index, LK_ENTRY * entry);
 static LK_RES_KEY lock_create_search_key (OID * oid, OID * class_oid);
 #if defined (SERVER_MODE)
 static bool lock_is_safe_lock_with_page (THREAD_ENTRY * thread_p, LK_ENTRY * entry_ptr);
+static bool lock_can_skip_read_only_class_lock (THREAD_ENTRY * thread_p, int tran_index, const OID * class_oid,
+						LOCK lock);
 #endif /* SERVER_MODE */
 
 static LK_ENTRY *lock_get_new_entry (int tran_index, LF_TRAN_ENTRY * tran_entry, LF_FREELIST * freelist);
 static void lock_free_entry (int tran_index, LF_TRAN_ENTRY * tran_entry, LF_FREELIST * freelist, LK_ENTRY * lock_entry);
+static int lock_arena_add_block (LK_TRAN_LOCK * tran_lock);
+static void lock_arena_release (LK_TRAN_LOCK * tran_lock, bool keep_first);
 
 static void lock_victimize_first_thread_mapfunc (THREAD_ENTRY & thread_ref, bool & stop_mapper);
 static void lock_check_timeout_expired_and_count_suspended_mapfunc (THREAD_ENTRY & thread_ref, bool & stop_mapper,
@@ -764,6 +901,7 @@ lock_init_resource (void *res)
   res_ptr->total_waiters_mode = NULL_LOCK;
   res_ptr->holder = NULL;
   res_ptr->waiter = NULL;
+  res_ptr->waiter_tail = NULL;
   res_ptr->non2pl = NULL;
   res_ptr->hash_next = NULL;
 
@@ -782,6 +920,7 @@ lock_uninit_resource (void *res)
 
   assert (res_ptr->holder == NULL);
   assert (res_ptr->waiter == NULL);
+  assert (res_ptr->waiter_tail == NULL);
   assert (res_ptr->non2pl == NULL);
 
   /* TO BE FILLED IN AS NECESSARY */
@@ -897,6 +1036,8 @@ lock_initialize_entry (LK_ENTRY * entry_ptr)
   entry_ptr->class_entry = NULL;
   entry_ptr->ngranules = 0;
   entry_ptr->instant_lock_count = 0;
+  entry_ptr->is_fastpath = false;
+  entry_ptr->is_strong_counted = false;
   entry_ptr->bind_index_in_tran = -1;
   XASL_ID_SET_NULL (&entry_ptr->xasl_id);
 }
@@ -917,6 +1058,8 @@ lock_initialize_entry_as_granted (LK_ENTRY * entry_ptr, int tran_index, LK_RES *
   entry_ptr->class_entry = NULL;
   entry_ptr->ngranules = 0;
   entry_ptr->instant_lock_count = 0;
+  entry_ptr->is_fastpath = false;
+  entry_ptr->is_strong_counted = false;
 
   lock_event_set_xasl_id_to_entry (tran_index, entry_ptr);
 }
@@ -938,6 +1081,8 @@ lock_initialize_entry_as_blocked (LK_ENTRY * entry_ptr, THREAD_ENTRY * thread_p,
   entry_ptr->class_entry = NULL;
   entry_ptr->ngranules = 0;
   entry_ptr->instant_lock_count = 0;
+  entry_ptr->is_fastpath = false;
+  entry_ptr->is_strong_counted = false;
 
   lock_event_set_xasl_id_to_entry (tran_index, entry_ptr);
 }
@@ -958,6 +1103,8 @@ lock_initialize_entry_as_non2pl (LK_ENTRY * entry_ptr, int tran_index, LK_RES *
   entry_ptr->class_entry = NULL;
   entry_ptr->ngranules = 0;
   entry_ptr->instant_lock_count = 0;
+  entry_ptr->is_fastpath = false;
+  entry_ptr->is_strong_counted = false;
 }
 
 /* initialize lock resource as free state */
@@ -972,6 +1119,7 @@ lock_initialize_resource (LK_RES * res_ptr)
   res_ptr->total_waiters_mode = NULL_LOCK;
   res_ptr->holder = NULL;
   res_ptr->waiter = NULL;
+  res_ptr->waiter_tail = NULL;
   res_ptr->non2pl = NULL;
   res_ptr->hash_next = NULL;
 }
@@ -984,6 +1132,7 @@ lock_initialize_resource_as_allocated (LK_RES * res_ptr, LOCK lock)
   res_ptr->total_waiters_mode = NULL_LOCK;
   res_ptr->holder = NULL;
   res_ptr->waiter = NULL;
+  res_ptr->waiter_tail = NULL;
   res_ptr->non2pl = NULL;
 }
 
@@ -1045,7 +1194,6 @@ lock_initialize_tran_lock_table (void)
 {
   LK_TRAN_LOCK *tran_lock;	/* pointer to transaction hold entry */
   int i, j;			/* loop variable */
-  LK_ENTRY *entry = NULL;
 
   /* initialize the number of transactions */
   lk_Gl.num_trans = MAX_NTRANS;
@@ -1067,14 +1215,27 @@ lock_initialize_tran_lock_table (void)
       pthread_mutex_init (&tran_lock->hold_mutex, NULL);
       pthread_mutex_init (&tran_lock->non2pl_mutex, NULL);
 
-      for (j = 0; j < LOCK_TRAN_LOCAL_POOL_MAX_SIZE; j++)
+      pthread_mutex_init (&tran_lock->fastpath_mutex, NULL);
+      tran_lock->fastpath_slots = (LK_FASTPATH_SLOT *) malloc (sizeof (LK_FASTPATH_SLOT) * LK_FASTPATH_SLOT_COUNT);
+      if (tran_lock->fastpath_slots == NULL)
 	{
-	  entry = (LK_ENTRY *) malloc (sizeof (LK_ENTRY));
-	  lock_initialize_entry (entry);
-	  entry->next = tran_lock->lk_entry_pool;
-	  tran_lock->lk_entry_pool = entry;
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
+		  sizeof (LK_FASTPATH_SLOT) * LK_FASTPATH_SLOT_COUNT);
+	  return ER_OUT_OF_VIRTUAL_MEMORY;
+	}
+      for (j = 0; j < LK_FASTPATH_SLOT_COUNT; j++)
+	{
+	  lock_initialize_resource (&tran_lock->fastpath_slots[j].res);
+	  tran_lock->fastpath_slots[j].entry = NULL;
 	}
-      tran_lock->lk_entry_pool_count = LOCK_TRAN_LOCAL_POOL_MAX_SIZE;
+      tran_lock->fastpath_count = 0;
+
+      /* the first block of the arena is allocated by the first lock of the transaction */
+      tran_lock->lk_entry_pool = NULL;
+      tran_lock->arena_blocks = NULL;
+      tran_lock->arena_block_count = 0;
+      tran_lock->arena_carved_count = 0;
+      tran_lock->arena_used_count = 0;
     }
 
   return NO_ERROR;
@@ -1151,6 +1312,7 @@ lock_initialize_deadlock_detection (void)
   int i;
 
   pthread_mutex_init (&lk_Gl.DL_detection_mutex, NULL);
+  pthread_mutex_init (&lk_Gl.DL_probe_mutex, NULL);
   gettimeofday (&lk_Gl.last_deadlock_run, NULL);
 
   /* allocate transaction WFG node table */
@@ -1600,6 +1762,379 @@ lock_find_class_entry (int tran_index, const OID * class_oid)
 }
 #endif /* SERVER_MODE */
 
+/*
+ *  Private Functions Group: fast path of weak class locks
+ *   - lock_fastpath_acquire()
+ *   - lock_fastpath_convert()
+ *   - lock_fastpath_release()
+ *   - lock_fastpath_transfer_class()
+ *   - lock_fastpath_begin_strong()
+ *   - lock_fastpath_end_strong()
+ */
+
+#if defined(SERVER_MODE)
+/*
+ * lock_fastpath_is_weak_mode - Can the class lock mode be held in a fast path slot?
+ *
+ * return: true for IS_LOCK and IX_LOCK
+ *
+ *   lock(in): lock mode
+ */
+static bool
+lock_fastpath_is_weak_mode (LOCK lock)
+{
+  return lock == IS_LOCK || lock == IX_LOCK;
+}
+
+/*
+ * lock_fastpath_is_strong_mode - Does the class lock mode conflict with fast path locks?
+ *
+ * return: true if the lock mode is not compatible with IS_LOCK or IX_LOCK
+ *
+ *   lock(in): lock mode
+ */
+static bool
+lock_fastpath_is_strong_mode (LOCK lock)
+{
+  return lock_Comp[lock][IS_LOCK] != LOCK_COMPAT_YES || lock_Comp[lock][IX_LOCK] != LOCK_COMPAT_YES;
+}
+
+/*
+ * lock_fastpath_get_partition - Get the strong lock counter partition of a class
+ *
+ * return: partition index
+ *
+ *   class_oid(in): class identifier
+ */
+static int
+lock_fastpath_get_partition (const OID * class_oid)
+{
+  return (int) LK_OBJ_LOCK_HASH (class_oid, LK_FASTPATH_STRONG_PARTITIONS);
+}
+
+/*
+ * lock_fastpath_acquire - Grant a weak class lock in a fast path slot of the transaction
+ *
+ * return: the new lock entry, or NULL if the lock must be requested in the shared lock table
+ *
+ *   tran_index(in): transaction index
+ *   class_oid(in): class identifier
+ *   lock(in): IS_LOCK or IX_LOCK
+ *   class_entry(in): root class lock entry of the transaction
+ *   is_instant_duration(in): true if the transaction is locking on instant duration
+ *
+ * Note: The transaction must not hold any lock on the class.
+ */
+static LK_ENTRY *
+lock_fastpath_acquire (THREAD_ENTRY * thread_p, int tran_index, const OID * class_oid, LOCK lock,
+		       LK_ENTRY * class_entry, bool is_instant_duration)
+{
+  LK_TRAN_LOCK *tran_lock = &lk_Gl.tran_lock_table[tran_index];
+  LK_FASTPATH_SLOT *slot = NULL;
+  LK_ENTRY *entry_ptr;
+  int i;
+
+  assert (lock_fastpath_is_weak_mode (lock));
+
+  /* a strong locker increments the counter before it looks at the slots of each transaction under their mutex, so
+   * either it finds the new slot or we find the counter incremented */
+  pthread_mutex_lock (&tran_lock->fastpath_mutex);
+
+  if (tran_lock->fastpath_count >= LK_FASTPATH_SLOT_COUNT
+      || lk_Gl.fastpath_strong_count[lock_fastpath_get_partition (class_oid)] > 0)
+    {
+      pthread_mutex_unlock (&tran_lock->fastpath_mutex);
+      return NULL;
+    }
+
+  for (i = 0; i < LK_FASTPATH_SLOT_COUNT; i++)
+    {
+      if (tran_lock->fastpath_slots[i].entry == NULL)
+	{
+	  slot = &tran_lock->fastpath_slots[i];
+	  break;
+	}
+    }
+  assert (slot != NULL);
+
+  entry_ptr = lock_get_new_entry (tran_index, thread_get_tran_entry (thread_p, THREAD_TS_OBJ_LOCK_ENT),
+				  &lk_Gl.obj_free_entry_list);
+  if (entry_ptr == NULL)
+    {
+      /* let the shared lock table handle it */
+      pthread_mutex_unlock (&tran_lock->fastpath_mutex);
+      return NULL;
+    }
+
+  slot->res.key = lock_create_search_key ((OID *) class_oid, NULL);
+  lock_initialize_resource_as_allocated (&slot->res, lock);
+  lock_initialize_entry_as_granted (entry_ptr, tran_index, &slot->res, lock);
+  entry_ptr->is_fastpath = true;
+  if (is_instant_duration)
+    {
+      entry_ptr->instant_lock_count++;
+      assert (entry_ptr->instant_lock_count > 0);
+    }
+  slot->res.holder = entry_ptr;
+  slot->entry = entry_ptr;
+  tran_lock->fastpath_count++;
+
+  /* to manage granules */
+  entry_ptr->class_entry = class_entry;
+  lock_increment_class_granules (class_entry);
+
+  lock_insert_into_tran_hold_list (entry_ptr, tran_index);
+
+  pthread_mutex_unlock (&tran_lock->fastpath_mutex);
+
+  return entry_ptr;
+}
+
+/*
+ * lock_fastpath_convert - Convert a fast path class lock to another weak lock mode
+ *
+ * return: true if converted, false if the lock entry is now in the shared lock table
+ *
+ *   entry_ptr(in): fast path lock entry of current transaction
+ *   new_mode(in): weak lock mode
+ */
+static bool
+lock_fastpath_convert (THREAD_ENTRY * thread_p, LK_ENTRY * entry_ptr, LOCK new_mode)
+{
+  LK_TRAN_LOCK *tran_lock = &lk_Gl.tran_lock_table[entry_ptr->tran_index];
+  bool converted = false;
+
+  assert (lock_fastpath_is_weak_mode (new_mode));
+
+  pthread_mutex_lock (&tran_lock->fastpath_mutex);
+
+  if (entry_ptr->is_fastpath)
+    {
+      if (lk_Gl.fastpath_strong_count[lock_fastpath_get_partition (&entry_ptr->res_head->key.oid)] == 0)
+	{
+	  entry_ptr->granted_mode = new_mode;
+	  entry_ptr->res_head->total_holders_mode = new_mode;
+	  converted = true;
+	}
+      else
+	{
+	  /* a strong lock may be waiting for the class; convert the lock in the shared table */
+	  lock_fastpath_transfer_slot (thread_p, tran_lock, (LK_FASTPATH_SLOT *) entry_ptr->res_head);
+	}
+    }
+
+  pthread_mutex_unlock (&tran_lock->fastpath_mutex);
+
+  return converted;
+}
+
+/*
+ * lock_fastpath_release - Release a fast path class lock
+ *
+ * return: true if released, false if the lock entry is now in the shared lock table
+ *
+ *   entry_ptr(in): lock entry of current transaction
+ *   release_flag(in): see lock_internal_perform_unlock_object
+ *   move_to_non2pl(in): see lock_internal_perform_unlock_object
+ */
+static bool
+lock_fastpath_release (THREAD_ENTRY * thread_p, LK_ENTRY * entry_ptr, bool release_flag, bool move_to_non2pl)
+{
+  LK_TRAN_LOCK *tran_lock = &lk_Gl.tran_lock_table[entry_ptr->tran_index];
+  LK_FASTPATH_SLOT *slot;
+
+  pthread_mutex_lock (&tran_lock->fastpath_mutex);
+
+  if (!entry_ptr->is_fastpath)
+    {
+      /* moved to shared lock table meanwhile */
+      pthread_mutex_unlock (&tran_lock->fastpath_mutex);
+      return false;
+    }
+
+  slot = (LK_FASTPATH_SLOT *) entry_ptr->res_head;
+  assert (slot->entry == entry_ptr);
+
+  if (release_flag == false && move_to_non2pl == true)
+    {
+      /* non2pl locks are kept by the shared lock table */
+      lock_fastpath_transfer_slot (thread_p, tran_lock, slot);
+      pthread_mutex_unlock (&tran_lock->fastpath_mutex);
+      return false;
+    }
+
+  (void) lock_delete_from_tran_hold_list (entry_ptr, entry_ptr->tran_index);
+
+  /* to manage granules */
+  lock_decrement_class_granules (entry_ptr->class_entry);
+
+  slot->res.holder = NULL;
+  slot->entry = NULL;
+  tran_lock->fastpath_count--;
+
+  pthread_mutex_unlock (&tran_lock->fastpath_mutex);
+
+  lock_free_entry (entry_ptr->tran_index, thread_get_tran_entry (thread_p, THREAD_TS_OBJ_LOCK_ENT),
+		   &lk_Gl.obj_free_entry_list, entry_ptr);
+
+  return true;
+}
+
+/*
+ * lock_fastpath_transfer_slot - Move the lock of a fast path slot to the shared lock table
+ *
+ * return: nothing
+ *
+ *   tran_lock(in): owner of the slot
+ *   slot(in): used fast path slot
+ *
+ * Note: The caller holds the fast path mutex of the owner. The lock entry keeps its place in the transaction hold
+ *       list; only its resource changes.
+ */
+static void
+lock_fastpath_transfer_slot (THREAD_ENTRY * thread_p, LK_TRAN_LOCK * tran_lock, LK_FASTPATH_SLOT * slot)
+{
+  LK_ENTRY *entry_ptr = slot->entry;
+  LK_RES_KEY search_key;
+  LK_RES *res_ptr;
+
+  assert (entry_ptr != NULL && entry_ptr->is_fastpath);
+
+  search_key = lock_create_search_key (&slot->res.key.oid, NULL);
+  (void) lk_Gl.m_obj_hash_table.find_or_insert (thread_p, search_key, res_ptr);
+  if (res_ptr == NULL)
+    {
+      assert_release (false);
+      return;
+    }
+  /* Find or insert also locks the resource mutex. */
+
+  if (res_ptr->holder == NULL && res_ptr->waiter == NULL && res_ptr->non2pl == NULL)
+    {
+      lock_initialize_resource_as_allocated (res_ptr, NULL_LOCK);
+    }
+
+  entry_ptr->res_head = res_ptr;
+  entry_ptr->next = NULL;
+  /* the owner may read is_fastpath without the fast path mutex; the new resource must be visible first */
+  MEMORY_BARRIER ();
+  entry_ptr->is_fastpath = false;
+  lock_position_holder_entry (res_ptr, entry_ptr);
+
+  assert (entry_ptr->granted_mode >= NULL_LOCK && res_ptr->total_holders_mode >= NULL_LOCK);
+  res_ptr->total_holders_mode = lock_Conv[entry_ptr->granted_mode][res_ptr->total_holders_mode];
+  assert (res_ptr->total_holders_mode != NA_LOCK);
+
+  pthread_mutex_unlock (&res_ptr->res_mutex);
+
+  slot->res.holder = NULL;
+  slot->entry = NULL;
+  tran_lock->fastpath_count--;
+}
+
+/*
+ * lock_fastpath_transfer_entry - Move a class lock of current transaction to the shared lock table
+ *
+ * return: resource of the entry in the shared lock table
+ *
+ *   entry_ptr(in): class lock entry
+ */
+static LK_RES *
+lock_fastpath_transfer_entry (THREAD_ENTRY * thread_p, LK_ENTRY * entry_ptr)
+{
+  LK_TRAN_LOCK *tran_lock = &lk_Gl.tran_lock_table[entry_ptr->tran_index];
+  LK_RES *res_ptr;
+
+  pthread_mutex_lock (&tran_lock->fastpath_mutex);
+  if (entry_ptr->is_fastpath)
+    {
+      lock_fastpath_transfer_slot (thread_p, tran_lock, (LK_FASTPATH_SLOT *) entry_ptr->res_head);
+    }
+  res_ptr = entry_ptr->res_head;
+  pthread_mutex_unlock (&tran_lock->fastpath_mutex);
+
+  return res_ptr;
+}
+
+/*
+ * lock_fastpath_transfer_class - Move the fast path locks of all transactions on a class to the shared lock table
+ *
+ * return: nothing
+ *
+ *   class_oid(in): class identifier
+ */
+static void
+lock_fastpath_transfer_class (THREAD_ENTRY * thread_p, const OID * class_oid)
+{
+  LK_TRAN_LOCK *tran_lock;
+  LK_FASTPATH_SLOT *slot;
+  int tran_index, i;
+
+  for (tran_index = 0; tran_index < lk_Gl.num_trans; tran_index++)
+    {
+      tran_lock = &lk_Gl.tran_lock_table[tran_index];
+
+      pthread_mutex_lock (&tran_lock->fastpath_mutex);
+      for (i = 0; i < LK_FASTPATH_SLOT_COUNT && tran_lock->fastpath_count > 0; i++)
+	{
+	  slot = &tran_lock->fastpath_slots[i];
+	  if (slot->entry != NULL && OID_EQ (&slot->res.key.oid, class_oid))
+	    {
+	      lock_fastpath_transfer_slot (thread_p, tran_lock, slot);
+	    }
+	}
+      pthread_mutex_unlock (&tran_lock->fastpath_mutex);
+    }
+}
+
+/*
+ * lock_fastpath_begin_strong - Disable the fast path for a class before requesting a strong lock on it
+ *
+ * return: true if the strong lock counter was incremented
+ *
+ *   tran_index(in): transaction index
+ *   class_oid(in): class identifier
+ *
+ * Note: If the lock is granted, the counter stays incremented until the lock entry is released (see
+ *       lock_fastpath_end_strong). Otherwise the caller decrements it.
+ */
+static bool
+lock_fastpath_begin_strong (THREAD_ENTRY * thread_p, int tran_index, const OID * class_oid)
+{
+  LK_ENTRY *entry_ptr;
+
+  entry_ptr = lock_find_class_entry (tran_index, class_oid);
+  if (entry_ptr != NULL && entry_ptr->is_strong_counted)
+    {
+      /* already counted */
+      return false;
+    }
+
+  ++lk_Gl.fastpath_strong_count[lock_fastpath_get_partition (class_oid)];
+
+  /* no new fast path locks can be granted on the class from now on; move the existing ones */
+  lock_fastpath_transfer_class (thread_p, class_oid);
+
+  return true;
+}
+
+/*
+ * lock_fastpath_end_strong - Enable the fast path for a class after a strong lock is released or not granted
+ *
+ * return: nothing
+ *
+ *   class_oid(in): class identifier
+ */
+static void
+lock_fastpath_end_strong (const OID * class_oid)
+{
+  int prev_count;
+
+  prev_count = lk_Gl.fastpath_strong_count[lock_fastpath_get_partition (class_oid)]--;
+  assert (prev_count > 0);
+}
+#endif /* SERVER_MODE */
+
 #if defined(SERVER_MODE)
 /*
  * lock_add_non2pl_lock - Add a release lock which has never been acquired
@@ -1812,6 +2347,66 @@ lock_position_holder_entry (LK_RES * res_ptr, LK_ENTRY * entry_ptr)
 }
 #endif /* SERVER_MODE */
 
+#if defined(SERVER_MODE)
+/*
+ * lock_append_waiter - Append given lock entry at the end of the waiter list of given lock resource
+ *
+ * return:
+ *
+ *   res_ptr(in):
+ *   entry_ptr(in):
+ *
+ * Note: The waiter list is a FIFO queue; lock waiters are granted in the order of their requests.
+ *     The caller is holding the resource mutex.
+ */
+static void
+lock_append_waiter (LK_RES * res_ptr, LK_ENTRY * entry_ptr)
+{
+  assert ((res_ptr->waiter == NULL) == (res_ptr->waiter_tail == NULL));
+
+  entry_ptr->next = NULL;
+  if (res_ptr->waiter_tail == NULL)
+    {
+      res_ptr->waiter = entry_ptr;
+    }
+  else
+    {
+      res_ptr->waiter_tail->next = entry_ptr;
+    }
+  res_ptr->waiter_tail = entry_ptr;
+}
+
+/*
+ * lock_remove_waiter - Remove given lock entry from the waiter list of given lock resource
+ *
+ * return:
+ *
+ *   res_ptr(in):
+ *   prev_ptr(in): the waiter before entry_ptr, NULL if entry_ptr is the first waiter
+ *   entry_ptr(in):
+ *
+ * Note: The caller is holding the resource mutex.
+ */
+static void
+lock_remove_waiter (LK_RES * res_ptr, LK_ENTRY * prev_ptr, LK_ENTRY * entry_ptr)
+{
+  assert ((prev_ptr == NULL && res_ptr->waiter == entry_ptr) || (prev_ptr != NULL && prev_ptr->next == entry_ptr));
+
+  if (prev_ptr == NULL)
+    {
+      res_ptr->waiter = entry_ptr->next;
+    }
+  else
+    {
+      prev_ptr->next = entry_ptr->next;
+    }
+  if (res_ptr->waiter_tail == entry_ptr)
+    {
+      res_ptr->waiter_tail = prev_ptr;
+    }
+}
+#endif /* SERVER_MODE */
+
 
 /*
  *  Private Functions Group: timeout related functions
@@ -2136,6 +2731,9 @@ lock_suspend (THREAD_ENTRY * thread_p, LK_ENTRY * entry_ptr, int wait_msecs)
   struct timeval tv;
   int client_id;
   LOG_TDES *tdes;
+  LOCK_WAIT_STATE probe_state = LOCK_SUSPENDED;
+  int cycle[LK_DEADLOCK_PROBE_MAX_DEPTH];
+  int cycle_len = 0;
 
   /* The threads must not hold a page latch to be blocked on a lock request. */
   assert (lock_is_safe_lock_with_page (thread_p, entry_ptr) || !pgbuf_has_perm_pages_fixed (thread_p));
@@ -2181,8 +2779,32 @@ lock_suspend (THREAD_ENTRY * thread_p, LK_ENTRY * entry_ptr, int wait_msecs)
 
   lock_event_set_tran_wait_entry (entry_ptr->tran_index, entry_ptr);
 
-  /* suspend the worker thread (transaction) */
-  thread_suspend_wakeup_and_unlock_entry (entry_ptr->thrd_entry, THREAD_LOCK_SUSPENDED);
+  if (lk_Gl.deadlock_probe_enabled)
+    {
+      probe_state = lock_probe_deadlock (thread_p, entry_ptr, cycle, &cycle_len);
+    }
+
+  if (probe_state != LOCK_SUSPENDED)
+    {
+      /* The lock request closes a deadlock cycle and the transaction is the victim. Resume it at once instead of
+       * suspending; this also releases the thread entry mutex. */
+      lock_resume (entry_ptr, probe_state);
+      lock_probe_report_deadlock (thread_p, cycle, cycle_len);
+    }
+  else
+    {
+      /* suspend the worker thread (transaction); it spins for a while before it parks, since many lock waits end
+       * sooner than a sleep and a wakeup would take */
+      if (lk_Gl.wait_spinner.wait (*entry_ptr->thrd_entry, (int) LOCK_SUSPENDED,
+				   prm_get_integer_value (PRM_ID_LK_WAIT_SPIN_USECS)))
+	{
+	  perfmon_inc_stat (thread_p, PSTAT_LK_NUM_WAITS_PARKED);
+	}
+      else
+	{
+	  perfmon_inc_stat (thread_p, PSTAT_LK_NUM_WAITS_SPUN);
+	}
+    }
 
   lk_Gl.deadlock_and_timeout_detector--;
   lk_Gl.TWFG_node[entry_ptr->tran_index].thrd_wait_stime = 0;
@@ -2338,14 +2960,11 @@ lock_resume (LK_ENTRY * entry_ptr, int state)
       fflush (stdout);
     }
 
-  /* Before wake up the thread, clears lockwait field and set lockwait_state with the given state. */
-  entry_ptr->thrd_entry->lockwait = NULL;
-  entry_ptr->thrd_entry->lockwait_state = (int) state;
-
-  /* wakes up the thread and release the thread entry mutex */
-  entry_ptr->thrd_entry->resume_status = THREAD_LOCK_RESUMED;
-  pthread_cond_signal (&entry_ptr->thrd_entry->wakeup_cond);
-  thread_unlock_entry (entry_ptr->thrd_entry);
+  /* Clears lockwait field, sets lockwait_state with the given state, wakes up the thread whether it is still spinning
+   * or parked, and releases the thread entry mutex. */
+  // *INDENT-OFF*
+  lock_wait_spinner::resume (*entry_ptr->thrd_entry, state);
+  // *INDENT-ON*
 }
 #endif /* SERVER_MODE */
 
@@ -2469,7 +3088,383 @@ lock_wakeup_deadlock_victim_aborted (int tran_index)
 	  thread_unlock_entry (thrd_ptr);
 	}
     }
-  return wakeup_first;
+  return wakeup_first;
+}
+#endif /* SERVER_MODE */
+
+#if defined(SERVER_MODE)
+/*
+ * lock_probe_add_edge - Add a wait-for edge found by the deadlock probe
+ *
+ * return: new # of edges or -1 if there is no room for the edge
+ *
+ *   edges(in/out): wait-for edges of a transaction
+ *   edge_count(in): # of edges
+ *   to_tran_index(in): the transaction waited for
+ *   holder_flag(in): true if the transaction holds the lock
+ */
+static int
+lock_probe_add_edge (LK_PROBE_EDGE * edges, int edge_count, int to_tran_index, bool holder_flag)
+{
+  int i;
+
+  for (i = 0; i < edge_count; i++)
+    {
+      if (edges[i].to_tran_index == to_tran_index)
+	{
+	  edges[i].holder_flag = edges[i].holder_flag || holder_flag;
+	  return edge_count;
+	}
+    }
+
+  if (edge_count >= LK_DEADLOCK_PROBE_MAX_EDGES)
+    {
+      return -1;
+    }
+
+  edges[edge_count].to_tran_index = to_tran_index;
+  edges[edge_count].holder_flag = holder_flag;
+  return edge_count + 1;
+}
+#endif /* SERVER_MODE */
+
+#if defined(SERVER_MODE)
+/*
+ * lock_probe_get_waits_for - Get the transactions a lock waiting transaction waits for
+ *
+ * return: # of wait-for edges or -1 if they cannot be read without blocking
+ *
+ *   tran_index(in): transaction
+ *   edges(out): wait-for edges of the transaction
+ *
+ * Note: The edges are computed like the full wait-for graph scan does, from the lock entry the transaction is waiting
+ *     for. Only try locks are used, so the probe never waits for a mutex while its caller holds the mutex of its own
+ *     thread entry.
+ */
+static int
+lock_probe_get_waits_for (int tran_index, LK_PROBE_EDGE * edges)
+{
+  LK_TRAN_LOCK *tran_lock;
+  LK_ENTRY *wait_entry, *i;
+  LK_RES *res_ptr;
+  bool is_waiter, is_ahead;
+  int edge_count = 0;
+
+  tran_lock = &lk_Gl.tran_lock_table[tran_index];
+  if (pthread_mutex_trylock (&tran_lock->hold_mutex) != 0)
+    {
+      return -1;
+    }
+
+  /* The waiting entry is cleared under the hold mutex before the waiter frees it. */
+  wait_entry = tran_lock->waiting;
+  if (wait_entry == NULL)
+    {
+      pthread_mutex_unlock (&tran_lock->hold_mutex);
+      return 0;
+    }
+
+  res_ptr = wait_entry->res_head;
+  if (pthread_mutex_trylock (&res_ptr->res_mutex) != 0)
+    {
+      pthread_mutex_unlock (&tran_lock->hold_mutex);
+      return -1;
+    }
+
+  if (wait_entry->blocked_mode == NULL_LOCK)
+    {
+      /* granted in the meantime */
+      pthread_mutex_unlock (&res_ptr->res_mutex);
+      pthread_mutex_unlock (&tran_lock->hold_mutex);
+      return 0;
+    }
+
+  for (i = res_ptr->waiter; i != NULL && i != wait_entry; i = i->next)
+    {
+      ;
+    }
+  is_waiter = (i == wait_entry);
+
+  /* from the entry to holders; a blocked holder also waits for the blocked modes of the holders ahead of it */
+  is_ahead = true;
+  for (i = res_ptr->holder; i != NULL && edge_count >= 0; i = i->next)
+    {
+      if (i == wait_entry)
+	{
+	  is_ahead = false;
+	  continue;
+	}
+      if (i->tran_index == tran_index)
+	{
+	  continue;
+	}
+
+      if (lock_Comp[wait_entry->blocked_mode][i->granted_mode] == LOCK_COMPAT_NO
+	  || ((is_waiter || is_ahead) && lock_Comp[wait_entry->blocked_mode][i->blocked_mode] == LOCK_COMPAT_NO))
+	{
+	  edge_count = lock_probe_add_edge (edges, edge_count, i->tran_index, true);
+	}
+    }
+
+  /* from the entry to the waiters ahead of it */
+  if (is_waiter)
+    {
+      for (i = res_ptr->waiter; i != wait_entry && edge_count >= 0; i = i->next)
+	{
+	  if (i->tran_index != tran_index && lock_Comp[wait_entry->blocked_mode][i->blocked_mode] == LOCK_COMPAT_NO)
+	    {
+	      edge_count = lock_probe_add_edge (edges, edge_count, i->tran_index, false);
+	    }
+	}
+    }
+
+  pthread_mutex_unlock (&res_ptr->res_mutex);
+  pthread_mutex_unlock (&tran_lock->hold_mutex);
+
+  return edge_count;
+}
+#endif /* SERVER_MODE */
+
+#if defined(SERVER_MODE)
+/*
+ * lock_probe_find_cycle - Search a deadlock cycle through a lock waiting transaction
+ *
+ * return: true if a cycle through the transaction was found
+ *
+ *   tran_index(in): transaction about to suspend
+ *   cycle(out): transactions of the cycle, starting with tran_index
+ *   cycle_len(out): # of transactions in the cycle
+ *   is_complete(out): false if the search gave up on some path
+ *
+ * Note: A bounded depth first search from the new wait-for edges of the transaction. Only a cycle closed by the
+ *     lock request of the transaction can be new, so other cycles are not searched. The caller holds DL_probe_mutex.
+ */
+static bool
+lock_probe_find_cycle (int tran_index, int *cycle, int *cycle_len, bool * is_complete)
+{
+  LK_PROBE_FRAME path[LK_DEADLOCK_PROBE_MAX_DEPTH];
+  LK_PROBE_FRAME *frame, *next_frame;
+  LK_PROBE_EDGE *edge;
+  int visited[LK_DEADLOCK_PROBE_MAX_VISITS];
+  int visit_count = 0;
+  int depth, i;
+
+  *is_complete = true;
+
+  path[0].tran_index = tran_index;
+  path[0].edge_count = lock_probe_get_waits_for (tran_index, path[0].edges);
+  path[0].next_edge = 0;
+  if (path[0].edge_count < 0)
+    {
+      *is_complete = false;
+      return false;
+    }
+  visited[visit_count++] = tran_index;
+
+  depth = 1;
+  while (depth > 0)
+    {
+      frame = &path[depth - 1];
+      if (frame->next_edge >= frame->edge_count)
+	{
+	  depth--;
+	  continue;
+	}
+      edge = &frame->edges[frame->next_edge++];
+
+      if (edge->to_tran_index == tran_index)
+	{
+	  if (!edge->holder_flag)
+	    {
+	      /* the transaction does not hold a lock of the cycle, it cannot be the victim */
+	      *is_complete = false;
+	      continue;
+	    }
+
+	  for (i = 0; i < depth; i++)
+	    {
+	      cycle[i] = path[i].tran_index;
+	    }
+	  *cycle_len = depth;
+	  return true;
+	}
+
+      for (i = 0; i < visit_count && visited[i] != edge->to_tran_index; i++)
+	{
+	  ;
+	}
+      if (i < visit_count)
+	{
+	  /* already searched or on the path */
+	  continue;
+	}
+
+      if (depth >= LK_DEADLOCK_PROBE_MAX_DEPTH || visit_count >= LK_DEADLOCK_PROBE_MAX_VISITS)
+	{
+	  *is_complete = false;
+	  continue;
+	}
+      visited[visit_count++] = edge->to_tran_index;
+
+      next_frame = &path[depth];
+      next_frame->tran_index = edge->to_tran_index;
+      next_frame->edge_count = lock_probe_get_waits_for (edge->to_tran_index, next_frame->edges);
+      next_frame->next_edge = 0;
+      if (next_frame->edge_count < 0)
+	{
+	  *is_complete = false;
+	  continue;
+	}
+      depth++;
+    }
+
+  return false;
+}
+#endif /* SERVER_MODE */
+
+#if defined(SERVER_MODE)
+/*
+ * lock_probe_deadlock - Check if a lock request closes a deadlock cycle before suspending its thread
+ *
+ * return: LOCK_SUSPENDED if the thread must be suspended, otherwise the resume state of the deadlock victim
+ *
+ *   entry_ptr(in): lock entry for lock waiting
+ *   cycle(out): transactions of the deadlock cycle
+ *   cycle_len(out): # of transactions in the deadlock cycle
+ *
+ * Note: The transaction closing the cycle is its victim, unless it has deadlock priority over another transaction of
+ *     the cycle. Cycles the probe gives up on are left to the full wait-for graph scan, which is then run at its
+ *     regular interval. So are the cycles of a probe that finds another probe running. The caller is holding the
+ *     thread entry mutex.
+ */
+static LOCK_WAIT_STATE
+lock_probe_deadlock (THREAD_ENTRY * thread_p, LK_ENTRY * entry_ptr, int *cycle, int *cycle_len)
+{
+  LOCK_WAIT_STATE state = LOCK_SUSPENDED;
+  int tran_index = entry_ptr->tran_index;
+  bool is_complete;
+  int i;
+
+  /* Serialize the probes, so that two transactions closing the same cycle do not both become victims. The caller
+   * holds its thread entry mutex, so a busy probe mutex is not waited for; the cycle, if any, is left to the full
+   * scan. */
+  if (pthread_mutex_trylock (&lk_Gl.DL_probe_mutex) != 0)
+    {
+      lk_Gl.deadlock_probe_missed = true;
+      return LOCK_SUSPENDED;
+    }
+
+  if (lock_probe_find_cycle (tran_index, cycle, cycle_len, &is_complete))
+    {
+      state = LOCK_RESUMED_ABORTED_FIRST;
+      if (!logtb_is_current_active (thread_p))
+	{
+	  state = LOCK_SUSPENDED;
+	}
+      else if (logtb_has_deadlock_priority (tran_index))
+	{
+	  for (i = 1; i < *cycle_len; i++)
+	    {
+	      if (!logtb_has_deadlock_priority (cycle[i]))
+		{
+		  state = LOCK_SUSPENDED;
+		  break;
+		}
+	    }
+	}
+
+      if (state == LOCK_SUSPENDED)
+	{
+	  is_complete = false;
+	}
+      else
+	{
+	  if (LK_CAN_TIMEOUT (logtb_find_wait_msecs (tran_index)))
+	    {
+	      state = LOCK_RESUMED_DEADLOCK_TIMEOUT;
+	    }
+	  else
+	    {
+	      lk_Gl.TWFG_node[tran_index].DL_victim = true;
+	    }
+
+	  /* the cycle is broken once the transaction does not wait anymore */
+	  lock_event_set_tran_wait_entry (tran_index, NULL);
+	}
+    }
+
+  if (!is_complete)
+    {
+      lk_Gl.deadlock_probe_missed = true;
+    }
+
+  pthread_mutex_unlock (&lk_Gl.DL_probe_mutex);
+
+  return state;
+}
+#endif /* SERVER_MODE */
+
+#if defined(SERVER_MODE)
+/*
+ * lock_probe_report_deadlock - Report a deadlock cycle found by the deadlock probe
+ *
+ * return:
+ *
+ *   cycle(in): transactions of the deadlock cycle
+ *   cycle_len(in): # of transactions in the deadlock cycle
+ */
+static void
+lock_probe_report_deadlock (THREAD_ENTRY * thread_p, const int *cycle, int cycle_len)
+{
+  char *cycle_info_string;
+  char *ptr;
+  int unit_size = LOG_USERNAME_MAX + CUB_MAXHOSTNAMELEN + PATH_MAX + 10;
+  const char *client_prog_name, *client_user_name, *client_host_name;
+  int client_pid;
+  FILE *log_fp;
+  int i, n;
+
+  cycle_info_string = (char *) malloc (unit_size * cycle_len);
+  if (cycle_info_string != NULL)
+    {
+      ptr = cycle_info_string;
+      for (i = 0; i < cycle_len; i++)
+	{
+	  (void) logtb_find_client_name_host_pid (cycle[i], &client_prog_name, &client_user_name, &client_host_name,
+						  &client_pid);
+
+	  n =
+	    snprintf (ptr, unit_size, "%s%s@%s|%s(%d)", ((i == 0) ? "" : ", "), client_user_name, client_host_name,
+		      client_prog_name, client_pid);
+	  ptr += n;
+	  assert_release (ptr < cycle_info_string + unit_size * cycle_len);
+	}
+    }
+
+  er_set (ER_NOTIFICATION_SEVERITY, ARG_FILE_LINE, ER_LK_DEADLOCK_CYCLE_DETECTED, 1,
+	  (cycle_info_string) ? cycle_info_string : "");
+
+  if (cycle_info_string != NULL)
+    {
+      free_and_init (cycle_info_string);
+    }
+
+#if defined(ENABLE_SYSTEMTAP)
+  CUBRID_TRAN_DEADLOCK ();
+#endif /* ENABLE_SYSTEMTAP */
+
+  /* dump deadlock cycle to event log file */
+  log_fp = event_log_start (thread_p, "DEADLOCK");
+  if (log_fp != NULL)
+    {
+      for (i = 0; i < cycle_len; i++)
+	{
+	  event_log_print_client_info (cycle[i], 0);
+	  lock_event_log_tran_locks (thread_p, log_fp, cycle[i]);
+	}
+
+      event_log_end (thread_p);
+    }
 }
 #endif /* SERVER_MODE */
 
@@ -2647,14 +3642,7 @@ lock_grant_blocked_waiter (THREAD_ENTRY * thread_p, LK_RES * res_ptr)
 	  change_total_waiters_mode = true;
 
 	  /* remove the lock entry from the waiter */
-	  if (prev_waiter == NULL)
-	    {
-	      res_ptr->waiter = waiter->next;
-	    }
-	  else
-	    {
-	      prev_waiter->next = waiter->next;
-	    }
+	  lock_remove_waiter (res_ptr, prev_waiter, waiter);
 
 	  /* change granted_mode and blocked_mode of the entry */
 	  waiter->granted_mode = waiter->blocked_mode;
@@ -2799,14 +3787,7 @@ lock_grant_blocked_waiter_partial (THREAD_ENTRY * thread_p, LK_RES * res_ptr, LK
 
 	  /* the thread is waiting on a lock */
 	  /* remove the lock entry from the waiter */
-	  if (prev_check == NULL)
-	    {
-	      res_ptr->waiter = check->next;
-	    }
-	  else
-	    {
-	      prev_check->next = check->next;
-	    }
+	  lock_remove_waiter (res_ptr, prev_check, check);
 
 	  /* change granted_mode and blocked_mode of the entry */
 	  check->granted_mode = check->blocked_mode;
@@ -2888,6 +3869,45 @@ lock_grant_blocked_waiter_partial (THREAD_ENTRY * thread_p, LK_RES * res_ptr, LK
 #endif /* SERVER_MODE */
 
 #if defined(SERVER_MODE)
+/*
+ * lock_get_escalation_threshold - get the number of instance locks of a class that triggers lock escalation
+ *
+ *   return: escalation threshold
+ *
+ * Note: Below half of lock_memory_budget_in_mbytes, the threshold is lock_escalation. Above it, the threshold drops
+ *       linearly with the lock entry memory, down to LK_ESCALATION_MIN_GRANULES when the budget is used up, so
+ *       classes with many instance locks are escalated only when lock memory is scarce.
+ */
+static int
+lock_get_escalation_threshold (void)
+{
+  int escalation_at = prm_get_integer_value (PRM_ID_LK_ESCALATION_AT);
+  INT64 budget = (INT64) prm_get_integer_value (PRM_ID_LK_MEMORY_BUDGET_IN_MB) * ONE_M;
+  INT64 used, low_water;
+  int min_granules;
+
+  if (budget <= 0)
+    {
+      /* no budget */
+      return escalation_at;
+    }
+
+  used = lk_Gl.entry_memory.load (std::memory_order_relaxed);
+  low_water = budget / 2;
+  if (used <= low_water)
+    {
+      return escalation_at;
+    }
+
+  min_granules = MIN (escalation_at, LK_ESCALATION_MIN_GRANULES);
+  if (used >= budget)
+    {
+      return min_granules;
+    }
+
+  return (int) (escalation_at - (escalation_at - min_granules) * (used - low_water) / (budget - low_water));
+}
+
 /*
  * lock_check_escalate- check if lcok counts over escalation limits or not
  *
@@ -2895,10 +3915,11 @@ lock_grant_blocked_waiter_partial (THREAD_ENTRY * thread_p, LK_RES * res_ptr, LK
  *   thread_p(in):
  *   class_entry(in):
  *   tran_lock(in):
+ *   threshold(in): escalation threshold (see lock_get_escalation_threshold)
  *
  */
 static bool
-lock_check_escalate (THREAD_ENTRY * thread_p, LK_ENTRY * class_entry, LK_TRAN_LOCK * tran_lock)
+lock_check_escalate (THREAD_ENTRY * thread_p, LK_ENTRY * class_entry, LK_TRAN_LOCK * tran_lock, int threshold)
 {
   LK_ENTRY *superclass_entry = NULL;
 
@@ -2928,12 +3949,12 @@ lock_check_escalate (THREAD_ENTRY * thread_p, LK_ENTRY * class_entry, LK_TRAN_LO
     {
       /* Superclass_entry points to a root class in a class hierarchy. Escalate locks only if the criteria for the
        * superclass is met. Superclass keeps a counter for all locks set in the hierarchy. */
-      if (superclass_entry->ngranules < prm_get_integer_value (PRM_ID_LK_ESCALATION_AT))
+      if (superclass_entry->ngranules < threshold)
 	{
 	  return false;
 	}
     }
-  else if (class_entry->ngranules < prm_get_integer_value (PRM_ID_LK_ESCALATION_AT))
+  else if (class_entry->ngranules < threshold)
     {
       return false;
     }
@@ -2957,7 +3978,8 @@ lock_check_escalate (THREAD_ENTRY * thread_p, LK_ENTRY * class_entry, LK_TRAN_LO
  * Note:This function check if lock escalation is needed at first.
  *     If lock escalation is needed, that is, an escalation threshold is over,
  *     this function converts instance lock(s) to a class lock and
- *     releases unnecessary instance locks.
+ *     releases unnecessary instance locks. The threshold depends on the
+ *     lock entry memory (see lock_get_escalation_threshold).
  */
 static int
 lock_escalate_if_needed (THREAD_ENTRY * thread_p, LK_ENTRY * class_entry, int tran_index)
@@ -2966,13 +3988,16 @@ lock_escalate_if_needed (THREAD_ENTRY * thread_p, LK_ENTRY * class_entry, int tr
   LOCK max_class_lock = NULL_LOCK;	/* escalated class lock mode */
   int granted;
   int wait_msecs;
+  int threshold;
   int rv;
 
+  threshold = lock_get_escalation_threshold ();
+
   /* check lock escalation count */
   tran_lock = &lk_Gl.tran_lock_table[tran_index];
   rv = pthread_mutex_lock (&tran_lock->hold_mutex);
 
-  if (lock_check_escalate (thread_p, class_entry, tran_lock) == false)
+  if (lock_check_escalate (thread_p, class_entry, tran_lock, threshold) == false)
     {
       pthread_mutex_unlock (&tran_lock->hold_mutex);
       return LK_NOTGRANTED;
@@ -2981,8 +4006,7 @@ lock_escalate_if_needed (THREAD_ENTRY * thread_p, LK_ENTRY * class_entry, int tr
   /* abort lock escalation if lock_escalation_abort = yes */
   if (prm_get_bool_value (PRM_ID_LK_ROLLBACK_ON_LOCK_ESCALATION) == true)
     {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_ROLLBACK_ON_LOCK_ESCALATION, 1,
-	      prm_get_integer_value (PRM_ID_LK_ESCALATION_AT));
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_LK_ROLLBACK_ON_LOCK_ESCALATION, 1, threshold);
 
       lock_set_error_for_aborted (class_entry);
       lock_set_tran_abort_reason (class_entry->tran_index, TRAN_ABORT_DUE_ROLLBACK_ON_ESCALATION);
@@ -3038,6 +4062,15 @@ lock_escalate_if_needed (THREAD_ENTRY * thread_p, LK_ENTRY * class_entry, int tr
 	  return granted;
 	}
 
+      lk_Gl.num_escalations++;
+      perfmon_inc_stat (thread_p, PSTAT_LK_NUM_ESCALATIONS);
+      if (threshold < prm_get_integer_value (PRM_ID_LK_ESCALATION_AT))
+	{
+	  /* escalated because of lock entry memory */
+	  lk_Gl.num_pressure_escalations++;
+	  perfmon_inc_stat (thread_p, PSTAT_LK_NUM_PRESSURE_ESCALATIONS);
+	}
+
       /* 2. release original class lock only one time in order to maintain original class lock count */
       lock_internal_perform_unlock_object (thread_p, class_entry, false, true);
     }
@@ -3082,6 +4115,8 @@ lock_internal_hold_lock_object_instant (THREAD_ENTRY * thread_p, int tran_index,
   LOCK new_mode;
   LOCK group_mode;
   int compat1, compat2;
+  bool fastpath_strong_added = false;
+  int ret_val;
 
 #if defined(LK_DUMP)
   if (lk_Gl.dump_level >= 1)
@@ -3103,6 +4138,12 @@ lock_internal_hold_lock_object_instant (THREAD_ENTRY * thread_p, int tran_index,
 	  return LK_GRANTED;
 	}
     }
+  else if (lk_Gl.fastpath_enabled && !OID_IS_ROOTOID (oid) && lock_fastpath_is_strong_mode (lock))
+    {
+      /* fast path locks conflict with the lock; check them in the lock table, and keep new ones out of the fast
+       * path until the check is done */
+      fastpath_strong_added = lock_fastpath_begin_strong (thread_p, tran_index, oid);
+    }
 
   /* search hash table */
   search_key = lock_create_search_key ((OID *) oid, (OID *) class_oid);
@@ -3111,7 +4152,8 @@ lock_internal_hold_lock_object_instant (THREAD_ENTRY * thread_p, int tran_index,
     {
       /* the lockable object is NOT in the hash chain */
       /* the request can be granted */
-      return LK_GRANTED;
+      ret_val = LK_GRANTED;
+      goto end;
     }
 
   /* the lockable object exists in the hash chain */
@@ -3137,14 +4179,14 @@ lock_internal_hold_lock_object_instant (THREAD_ENTRY * thread_p, int tran_index,
 
       if (compat1 == LOCK_COMPAT_YES && compat2 == LOCK_COMPAT_YES)
 	{
-	  pthread_mutex_unlock (&res_ptr->res_mutex);
-	  return LK_GRANTED;
+	  ret_val = LK_GRANTED;
 	}
       else
 	{
-	  pthread_mutex_unlock (&res_ptr->res_mutex);
-	  return LK_NOTGRANTED;
+	  ret_val = LK_NOTGRANTED;
 	}
+      pthread_mutex_unlock (&res_ptr->res_mutex);
+      goto end;
     }
 
   /* I am a lock holder of the lockable object. */
@@ -3155,8 +4197,7 @@ lock_internal_hold_lock_object_instant (THREAD_ENTRY * thread_p, int tran_index,
   if (new_mode == entry_ptr->granted_mode)
     {
       /* a request with either a less exclusive or an equal mode of lock */
-      pthread_mutex_unlock (&res_ptr->res_mutex);
-      return LK_GRANTED;
+      ret_val = LK_GRANTED;
     }
   else
     {
@@ -3178,15 +4219,23 @@ lock_internal_hold_lock_object_instant (THREAD_ENTRY * thread_p, int tran_index,
 
       if (compat1 == LOCK_COMPAT_YES)
 	{
-	  pthread_mutex_unlock (&res_ptr->res_mutex);
-	  return LK_GRANTED;
+	  ret_val = LK_GRANTED;
 	}
       else
 	{
-	  pthread_mutex_unlock (&res_ptr->res_mutex);
-	  return LK_NOTGRANTED;
+	  ret_val = LK_NOTGRANTED;
 	}
     }
+  pthread_mutex_unlock (&res_ptr->res_mutex);
+
+end:
+  if (fastpath_strong_added)
+    {
+      /* nothing is held with instant duration; enable the fast path again */
+      lock_fastpath_end_strong (oid);
+    }
+
+  return ret_val;
 }
 #endif /* SERVER_MODE */
 
@@ -3236,6 +4285,7 @@ lock_internal_perform_lock_object (THREAD_ENTRY * thread_p, int tran_index, cons
   TSC_TICKS start_tick, end_tick;
   TSCTIMEVAL tv_diff;
   UINT64 lock_wait_time;
+  bool fastpath_strong_added = false;
 
 #if defined(ENABLE_SYSTEMTAP)
   const OID *class_oid_for_marker_p;
@@ -3328,13 +4378,37 @@ start:
   else
     {
       /* Class lock request. */
+      if (lk_Gl.fastpath_enabled && !fastpath_strong_added && !OID_IS_ROOTOID (oid)
+	  && lock_fastpath_is_strong_mode (lock))
+	{
+	  /* fast path locks of the class must be in the lock table before checking conflicts */
+	  fastpath_strong_added = lock_fastpath_begin_strong (thread_p, tran_index, oid);
+	}
+
       /* Try to find class lock entry if it already exists to avoid using the expensive resource mutex. */
       entry_ptr = lock_find_class_entry (tran_index, oid);
       if (entry_ptr != NULL)
 	{
-	  res_ptr = entry_ptr->res_head;
+	  /* a fast path entry can be moved to the lock table at any time; its resource is read under the fast path
+	   * mutex before it is used */
+	  res_ptr = lk_Gl.fastpath_enabled ? NULL : entry_ptr->res_head;
 	  goto lock_tran_lk_entry;
 	}
+
+      if (lk_Gl.fastpath_enabled && !OID_IS_ROOTOID (oid) && lock_fastpath_is_weak_mode (lock))
+	{
+	  /* Try to avoid the resource mutex altogether. */
+	  entry_ptr = lock_fastpath_acquire (thread_p, tran_index, oid, lock, class_entry, is_instant_duration);
+	  if (entry_ptr != NULL)
+	    {
+	      /* Record number of acquired locks */
+	      perfmon_inc_stat (thread_p, PSTAT_LK_NUM_ACQUIRED_ON_OBJECTS);
+
+	      *entry_addr_ptr = entry_ptr;
+	      ret_val = LK_GRANTED;
+	      goto end;
+	    }
+	}
     }
 
   /* find or add the lockable object in the lock table */
@@ -3343,7 +4417,8 @@ start:
   if (res_ptr == NULL)
     {
       assert (false);
-      return ER_FAILED;
+      ret_val = ER_FAILED;
+      goto end;
     }
   /* Find or insert also locks the resource mutex. */
   is_res_mutex_locked = true;
@@ -3596,19 +4671,7 @@ start:
 	}
 
       /* append the lock request at the end of the waiter */
-      prev = NULL;
-      for (i = res_ptr->waiter; i != NULL; i = i->next)
-	{
-	  prev = i;
-	}
-      if (prev == NULL)
-	{
-	  res_ptr->waiter = entry_ptr;
-	}
-      else
-	{
-	  prev->next = entry_ptr;
-	}
+      lock_append_waiter (res_ptr, entry_ptr);
 
       /* change total_waiters_mode (total mode of waiting waiter) */
       assert (lock >= NULL_LOCK && res_ptr->total_waiters_mode >= NULL_LOCK);
@@ -3660,6 +4723,25 @@ lock_tran_lk_entry:
       goto end;
     }
 
+  if (!is_res_mutex_locked && lk_Gl.fastpath_enabled)
+    {
+      /* class entry found without the resource mutex; it may be in a fast path slot */
+      if (lock_fastpath_is_weak_mode (new_mode) && lock_fastpath_convert (thread_p, entry_ptr, new_mode))
+	{
+	  entry_ptr->count += 1;
+	  if (is_instant_duration)
+	    {
+	      entry_ptr->instant_lock_count++;
+	      assert (entry_ptr->instant_lock_count > 0);
+	    }
+
+	  goto lock_conversion_treatement;
+	}
+
+      /* convert the lock in the lock table */
+      res_ptr = lock_fastpath_transfer_entry (thread_p, entry_ptr);
+    }
+
   if (!is_res_mutex_locked)
     {
       /* We need to lock resource mutex. */
@@ -3918,6 +5000,19 @@ lock_conversion_treatement:
   ret_val = LK_GRANTED;
 
 end:
+  if (fastpath_strong_added)
+    {
+      if (ret_val == LK_GRANTED && *entry_addr_ptr != NULL)
+	{
+	  /* keep the fast path disabled for the class until the lock is released */
+	  (*entry_addr_ptr)->is_strong_counted = true;
+	}
+      else
+	{
+	  lock_fastpath_end_strong (oid);
+	}
+    }
+
 #if defined(ENABLE_SYSTEMTAP)
   CUBRID_LOCK_ACQUIRE_END (oid_for_marker_p, class_oid_for_marker_p, lock, ret_val != LK_GRANTED);
 #endif /* ENABLE_SYSTEMTAP */
@@ -3997,6 +5092,13 @@ lock_internal_perform_unlock_object (THREAD_ENTRY * thread_p, LK_ENTRY * entry_p
 	}
     }
 
+  if (entry_ptr->is_fastpath && lock_fastpath_release (thread_p, entry_ptr, release_flag, move_to_non2pl))
+    {
+      return;
+    }
+  /* pairs with the barrier of lock_fastpath_transfer_slot */
+  MEMORY_BARRIER ();
+
   /* hold resource mutex */
   res_ptr = entry_ptr->res_head;
   rv = pthread_mutex_lock (&res_ptr->res_mutex);
@@ -4035,14 +5137,7 @@ lock_internal_perform_unlock_object (THREAD_ENTRY * thread_p, LK_ENTRY * entry_p
 	  from_whom = curr->next;
 
 	  /* remove the lock entry from the waiter */
-	  if (prev == NULL)
-	    {
-	      res_ptr->waiter = curr->next;
-	    }
-	  else
-	    {
-	      prev->next = curr->next;
-	    }
+	  lock_remove_waiter (res_ptr, prev, curr);
 
 	  /* free the lock entry */
 	  lock_free_entry (tran_index, t_entry, &lk_Gl.obj_free_entry_list, curr);
@@ -4109,6 +5204,10 @@ lock_internal_perform_unlock_object (THREAD_ENTRY * thread_p, LK_ENTRY * entry_p
 	{
 	  (void) lock_add_non2pl_lock (thread_p, res_ptr, tran_index, curr->granted_mode);
 	}
+      if (curr->is_strong_counted)
+	{
+	  lock_fastpath_end_strong (&res_ptr->key.oid);
+	}
       /* free the lock entry */
       lock_free_entry (tran_index, t_entry, &lk_Gl.obj_free_entry_list, curr);
     }
@@ -4209,7 +5308,14 @@ lock_internal_demote_class_lock (THREAD_ENTRY * thread_p, LK_ENTRY * entry_ptr,
   /* The caller is not holding any mutex */
   assert (entry_ptr != NULL);
 
-  res_ptr = entry_ptr->res_head;
+  if (lk_Gl.fastpath_enabled)
+    {
+      res_ptr = lock_fastpath_transfer_entry (thread_p, entry_ptr);
+    }
+  else
+    {
+      res_ptr = entry_ptr->res_head;
+    }
 
   // expects a class lock entry
   assert (res_ptr->key.type == LOCK_RESOURCE_CLASS);
@@ -5610,6 +6716,7 @@ lock_initialize (void)
 #else /* !SERVER_MODE */
   const char *env_value;
   int error_code = NO_ERROR;
+  int i;
 
   error_code = lock_initialize_tran_lock_table ();
   if (error_code != NO_ERROR)
@@ -5658,6 +6765,15 @@ lock_initialize (void)
     }
 #endif /* LK_DUMP */
 
+  lk_Gl.fastpath_enabled = prm_get_bool_value (PRM_ID_LK_FAST_PATH);
+  for (i = 0; i < LK_FASTPATH_STRONG_PARTITIONS; i++)
+    {
+      lk_Gl.fastpath_strong_count[i] = 0;
+    }
+
+  lk_Gl.deadlock_probe_enabled = prm_get_bool_value (PRM_ID_LK_DEADLOCK_DETECT_ON_WAIT);
+  lk_Gl.deadlock_probe_missed = false;
+
   lock_deadlock_detect_daemon_init ();
 
   return error_code;
@@ -5801,7 +6917,7 @@ lock_finalize (void)
   lk_Standalone_has_xlock = false;
 #else /* !SERVER_MODE */
   LK_TRAN_LOCK *tran_lock;
-  int i;
+  int i, j;
 
   /* Release all the locks and awake all transactions */
   /* TODO: Why ? */
@@ -5821,18 +6937,23 @@ lock_finalize (void)
 	  tran_lock = &lk_Gl.tran_lock_table[i];
 	  pthread_mutex_destroy (&tran_lock->hold_mutex);
 	  pthread_mutex_destroy (&tran_lock->non2pl_mutex);
-	  while (tran_lock->lk_entry_pool != NULL)
+	  pthread_mutex_destroy (&tran_lock->fastpath_mutex);
+	  if (tran_lock->fastpath_slots != NULL)
 	    {
-	      LK_ENTRY *entry = tran_lock->lk_entry_pool;
-	      tran_lock->lk_entry_pool = tran_lock->lk_entry_pool->next;
-	      free (entry);
+	      for (j = 0; j < LK_FASTPATH_SLOT_COUNT; j++)
+		{
+		  pthread_mutex_destroy (&tran_lock->fastpath_slots[j].res.res_mutex);
+		}
+	      free_and_init (tran_lock->fastpath_slots);
 	    }
+	  lock_arena_release (tran_lock, false);
 	}
       free_and_init (lk_Gl.tran_lock_table);
     }
   /* reset the number of transactions */
   lk_Gl.num_trans = 0;
   pthread_mutex_destroy (&lk_Gl.DL_detection_mutex);
+  pthread_mutex_destroy (&lk_Gl.DL_probe_mutex);
 
   /* reset max number of object locks */
   lk_Gl.max_obj_locks = 0;
@@ -6021,6 +7142,13 @@ lock_object (THREAD_ENTRY * thread_p, const OID * oid, const OID * class_oid, LO
 
   if (OID_IS_ROOTOID (class_oid))
     {
+      if (lock_can_skip_read_only_class_lock (thread_p, tran_index, oid, lock))
+	{
+	  /* the snapshot of the read-only transaction is enough */
+	  granted = LK_GRANTED;
+	  goto end;
+	}
+
       if (old_class_lock < new_class_lock)
 	{
 	  granted = lock_internal_perform_lock_object (thread_p, tran_index, class_oid, NULL, new_class_lock,
@@ -6307,6 +7435,12 @@ lock_scan (THREAD_ENTRY * thread_p, const OID * class_oid, int cond_flag, LOCK c
     }
   isolation = logtb_find_isolation (tran_index);
 
+  if (lock_can_skip_read_only_class_lock (thread_p, tran_index, class_oid, class_lock))
+    {
+      /* the snapshot of the read-only transaction is enough */
+      return LK_GRANTED;
+    }
+
   /* acquire the lock on the class */
   /* NOTE that in case of acquiring a lock on a class object, the higher lock granule of the class object is not given. */
   root_class_entry = lock_get_class_lock (thread_p, oid_Root_class_oid);
@@ -6648,6 +7782,13 @@ lock_unlock_object (THREAD_ENTRY * thread_p, const OID * oid, const OID * class_
 
       entry_ptr = lock_find_tran_hold_entry (thread_p, tran_index, oid, is_class);
 
+      if (entry_ptr != NULL && OID_IS_ROOTOID (class_oid)
+	  && lock_can_skip_read_only_class_lock (thread_p, tran_index, oid, lock))
+	{
+	  /* lock_object skipped this IS_LOCK; the SCH_S_LOCK held on the class must not be released in its place */
+	  entry_ptr = NULL;
+	}
+
       if (entry_ptr != NULL)
 	{
 	  lock_internal_perform_unlock_object (thread_p, entry_ptr, false, true);
@@ -6896,6 +8037,9 @@ lock_unlock_all (THREAD_ENTRY * thread_p)
       lock_remove_non2pl (thread_p, entry_ptr, tran_index);
     }
 
+  /* all lock entries are free now; give back the arena blocks at once */
+  lock_arena_release (tran_lock, true);
+
   lock_clear_deadlock_victim (tran_index);
 
   pgbuf_unfix_all (thread_p);
@@ -7611,19 +8755,28 @@ lock_is_local_deadlock_detection_interval_up (void)
 #if defined (SERVER_MODE)
   struct timeval now, elapsed;
   double elapsed_sec;
+  double interval_sec;
 
   /* check deadlock detection interval */
   gettimeofday (&now, NULL);
   perfmon_diff_timeval (&elapsed, &lk_Gl.last_deadlock_run, &now);
   elapsed_sec = elapsed.tv_sec + (elapsed.tv_usec / 1000000.0);
 
-  if (elapsed_sec < prm_get_float_value (PRM_ID_LK_RUN_DEADLOCK_INTERVAL))
+  interval_sec = prm_get_float_value (PRM_ID_LK_RUN_DEADLOCK_INTERVAL);
+  if (lk_Gl.deadlock_probe_enabled && !lk_Gl.deadlock_probe_missed)
+    {
+      /* lock waiters detect the deadlocks they close; the full scan is only a backstop */
+      interval_sec *= LK_DEADLOCK_BACKSTOP_FACTOR;
+    }
+
+  if (elapsed_sec < interval_sec)
     {
       return false;
     }
 
   /* update the last deadlock run time */
   lk_Gl.last_deadlock_run = now;
+  lk_Gl.deadlock_probe_missed = false;
 
   return true;
 #else /* !SERVER_MODE */
@@ -8508,7 +9661,15 @@ xlock_dump (THREAD_ENTRY * thread_p, FILE * outfp)
   /* dump object lock table */
   fprintf (outfp, "Object Lock Table:\n");
   fprintf (outfp, "\tCurrent number of objects which are locked    = %d\n", num_locked);
-  fprintf (outfp, "\tMaximum number of objects which can be locked = %d\n\n", lk_Gl.max_obj_locks);
+  fprintf (outfp, "\tMaximum number of objects which can be locked = %d\n", lk_Gl.max_obj_locks);
+  fprintf (outfp, "\tLock entry memory = %lld bytes (peak = %lld bytes, budget = %d MB)\n",
+	   (long long) lk_Gl.entry_memory.load (), (long long) lk_Gl.entry_memory_peak.load (),
+	   prm_get_integer_value (PRM_ID_LK_MEMORY_BUDGET_IN_MB));
+  fprintf (outfp, "\tCurrent lock escalation threshold = %d\n", lock_get_escalation_threshold ());
+  fprintf (outfp, "\tNumber of lock escalations = %lld (%lld because of lock entry memory)\n",
+	   (long long) lk_Gl.num_escalations.load (), (long long) lk_Gl.num_pressure_escalations.load ());
+  fprintf (outfp, "\tCurrent lock wait spin = %d usecs (maximum = %d usecs)\n\n", lk_Gl.wait_spinner.get_spin_usecs (),
+	   prm_get_integer_value (PRM_ID_LK_WAIT_SPIN_USECS));
 
   // *INDENT-OFF*
   lk_hashmap_iterator iterator { thread_p, lk_Gl.m_obj_hash_table };
@@ -8518,6 +9679,29 @@ xlock_dump (THREAD_ENTRY * thread_p, FILE * outfp)
       lock_dump_resource (thread_p, outfp, res_ptr);
     }
 
+  /* dump fast path class locks */
+  fprintf (outfp, "Fast Path Class Locks:\n");
+  for (tran_index = 0; tran_index < lk_Gl.num_trans; tran_index++)
+    {
+      LK_TRAN_LOCK *tran_lock = &lk_Gl.tran_lock_table[tran_index];
+      int i;
+
+      pthread_mutex_lock (&tran_lock->fastpath_mutex);
+      for (i = 0; i < LK_FASTPATH_SLOT_COUNT; i++)
+	{
+	  LK_ENTRY *entry_ptr = tran_lock->fastpath_slots[i].entry;
+
+	  if (entry_ptr != NULL)
+	    {
+	      fprintf (outfp, "\tTran_index = %3d, Class OID = %d|%d|%d, Granted_mode = %s, Count = %d\n", tran_index,
+		       OID_AS_ARGS (&entry_ptr->res_head->key.oid), LOCK_TO_LOCKMODE_STRING (entry_ptr->granted_mode),
+		       entry_ptr->count);
+	    }
+	}
+      pthread_mutex_unlock (&tran_lock->fastpath_mutex);
+    }
+  fprintf (outfp, "\n");
+
   /* Reset the wait back to the way it was */
   (void) xlogtb_reset_wait_msecs (thread_p, old_wait_msecs);
 #endif /* !SERVER_MODE */
@@ -8825,6 +10009,49 @@ lock_is_class_lock_escalated (LOCK class_lock, LOCK lock_escalation)
 #endif
 }
 
+
+#if defined (SERVER_MODE)
+/*
+ * lock_can_skip_read_only_class_lock - can a read-only transaction read the class without the IS_LOCK?
+ *
+ * return: true if the IS_LOCK on the class is not needed
+ *
+ *   tran_index(in): transaction index
+ *   class_oid(in): class to be locked
+ *   lock(in): lock requested on the class
+ *
+ * Note: A read-only transaction reads the instances of an MVCC class through its snapshot, so the IS_LOCK only keeps
+ *       the schema stable. When the transaction already holds SCH_S_LOCK on the class, which it does for the classes
+ *       of the queries it compiled, the schema cannot change anyway and the IS_LOCK would only queue the reader
+ *       behind the X_LOCK holders of the class.
+ */
+static bool
+lock_can_skip_read_only_class_lock (THREAD_ENTRY * thread_p, int tran_index, const OID * class_oid, LOCK lock)
+{
+  LOG_TDES *tdes;
+  LK_ENTRY *class_entry;
+
+  if (lock != IS_LOCK)
+    {
+      return false;
+    }
+
+  tdes = LOG_FIND_TDES (tran_index);
+  if (tdes == NULL || !tdes->is_read_only || tdes->isolation == TRAN_SERIALIZABLE)
+    {
+      return false;
+    }
+
+  if (OID_IS_ROOTOID (class_oid) || mvcc_is_mvcc_disabled_class (class_oid))
+    {
+      return false;
+    }
+
+  class_entry = lock_get_class_lock (thread_p, class_oid);
+
+  return class_entry != NULL && class_entry->granted_mode == SCH_S_LOCK;
+}
+#endif /* SERVER_MODE */
 /*
  * lock_get_number_object_locks - Number of object lock entries
  *
@@ -8843,6 +10070,23 @@ lock_get_number_object_locks (void)
 #endif
 }
 
+/*
+ * lock_peek_stats - Peek lock manager statistics
+ *
+ * return: nothing
+ *
+ *   entry_memory(out): bytes of lock entry arenas
+ */
+void
+lock_peek_stats (UINT64 * entry_memory)
+{
+#if defined(SA_MODE)
+  *entry_memory = 0;
+#else
+  *entry_memory = (UINT64) lk_Gl.entry_memory.load (std::memory_order_relaxed);
+#endif
+}
+
 /*
  * lock_start_instant_lock_mode -
  *
@@ -9657,9 +10901,11 @@ lock_is_safe_lock_with_page (THREAD_ENTRY * thread_p, LK_ENTRY * entry_ptr)
 
 #if defined (SERVER_MODE)
 /*
- * lock_get_new_entry () - Get new lock entry. Local pool of free entries is
- *			   first used. When this pool is depleted, a new
- *			   entry is claimed from shared list of lock entries.
+ * lock_get_new_entry () - Get new lock entry. Free entries of the
+ *			   transaction arena are first used, then a new entry
+ *			   is carved from the arena. Only if the arena cannot
+ *			   grow, the entry is claimed from shared list of lock
+ *			   entries.
  *
  * return	   : New lock entry.
  * tran_index (in) : Transaction index of requester.
@@ -9672,24 +10918,40 @@ lock_get_new_entry (int tran_index, LF_TRAN_ENTRY * tran_entry, LF_FREELIST * fr
   LK_TRAN_LOCK *tran_lock = &lk_Gl.tran_lock_table[tran_index];
   LK_ENTRY *lock_entry;
 
-  /* Check if local pool has free entries. */
-  if (tran_lock->lk_entry_pool)
+  /* Check if the arena has free entries. */
+  if (tran_lock->lk_entry_pool != NULL)
     {
-      assert (tran_lock->lk_entry_pool_count > 0);
       lock_entry = tran_lock->lk_entry_pool;
-      tran_lock->lk_entry_pool = tran_lock->lk_entry_pool->next;
-      tran_lock->lk_entry_pool_count--;
+      tran_lock->lk_entry_pool = lock_entry->next;
+      tran_lock->arena_used_count++;
+      return lock_entry;
+    }
+
+  /* Carve a new entry from the arena. */
+  if ((tran_lock->arena_blocks != NULL && tran_lock->arena_carved_count < LK_ARENA_BLOCK_ENTRIES)
+      || lock_arena_add_block (tran_lock) == NO_ERROR)
+    {
+      lock_entry = &tran_lock->arena_blocks->entries[tran_lock->arena_carved_count++];
+      lock_initialize_entry (lock_entry);
+      lock_entry->arena_tran_index = tran_index;
+      tran_lock->arena_used_count++;
       return lock_entry;
     }
 
   /* Claim from shared freelist. */
-  return (LK_ENTRY *) lf_freelist_claim (tran_entry, freelist);
+  lock_entry = (LK_ENTRY *) lf_freelist_claim (tran_entry, freelist);
+  if (lock_entry != NULL)
+    {
+      lock_entry->arena_tran_index = -1;
+    }
+  return lock_entry;
 }
 
 /*
- * lock_free_entry () - Free lock entry. Local pool has high priority if its
- *			maximum size is not reached. Otherwise, the entry
- *			is "retired" to shared list of free lock entries.
+ * lock_free_entry () - Free lock entry. An entry of the transaction arena
+ *			goes back to the free entries of the arena. Otherwise,
+ *			the entry is "retired" to shared list of free lock
+ *			entries.
  *
  * return	   : Error code.
  * tran_index (in) : Transaction index.
@@ -9700,22 +10962,104 @@ lock_get_new_entry (int tran_index, LF_TRAN_ENTRY * tran_entry, LF_FREELIST * fr
 static void
 lock_free_entry (int tran_index, LF_TRAN_ENTRY * tran_entry, LF_FREELIST * freelist, LK_ENTRY * lock_entry)
 {
-  LK_TRAN_LOCK *tran_lock = &lk_Gl.tran_lock_table[tran_index];
+  LK_TRAN_LOCK *tran_lock;
+
+  if (lock_entry->arena_tran_index == -1)
+    {
+      lf_freelist_retire (tran_entry, freelist, lock_entry);
+      return;
+    }
+
+  assert (lock_entry->arena_tran_index == tran_index);
+  tran_lock = &lk_Gl.tran_lock_table[lock_entry->arena_tran_index];
+
+  lock_uninit_entry (lock_entry);
+  lock_entry->next = tran_lock->lk_entry_pool;
+  tran_lock->lk_entry_pool = lock_entry;
+  tran_lock->arena_used_count--;
+  assert (tran_lock->arena_used_count >= 0);
+}
+
+/*
+ * lock_arena_add_block () - Add a new block to the lock entry arena of a
+ *			     transaction.
+ *
+ * return	   : Error code.
+ * tran_lock (in)  : Transaction lock entry.
+ *
+ * Note: No error is set; the caller falls back to the shared list of lock
+ *	 entries.
+ */
+static int
+lock_arena_add_block (LK_TRAN_LOCK * tran_lock)
+{
+  LK_ARENA_BLOCK *block;
+  INT64 memory, peak;
+
+  block = (LK_ARENA_BLOCK *) malloc (sizeof (LK_ARENA_BLOCK));
+  if (block == NULL)
+    {
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+
+  block->next = tran_lock->arena_blocks;
+  tran_lock->arena_blocks = block;
+  tran_lock->arena_block_count++;
+  tran_lock->arena_carved_count = 0;
+
+  memory = lk_Gl.entry_memory.fetch_add (sizeof (LK_ARENA_BLOCK)) + sizeof (LK_ARENA_BLOCK);
+  peak = lk_Gl.entry_memory_peak.load ();
+  while (memory > peak && !lk_Gl.entry_memory_peak.compare_exchange_weak (peak, memory))
+    {
+      ;
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * lock_arena_release () - Release the lock entry arena of a transaction,
+ *			   which must have no entry in use.
+ *
+ * return	   : Nothing.
+ * tran_lock (in)  : Transaction lock entry.
+ * keep_first (in) : Keep the first block for the next transaction.
+ */
+static void
+lock_arena_release (LK_TRAN_LOCK * tran_lock, bool keep_first)
+{
+  LK_ARENA_BLOCK *block, *next_block;
 
-  assert (tran_lock->lk_entry_pool_count >= 0 && tran_lock->lk_entry_pool_count <= LOCK_TRAN_LOCAL_POOL_MAX_SIZE);
+  if (tran_lock->arena_used_count != 0)
+    {
+      /* an entry is still in use; keep the arena as it is */
+      assert (false);
+      return;
+    }
 
-  /* "Free" entry to local pool or shared list. */
-  if (tran_lock->lk_entry_pool_count < LOCK_TRAN_LOCAL_POOL_MAX_SIZE)
+  /* the first block is the last one added */
+  if (keep_first && tran_lock->arena_blocks != NULL)
     {
-      lock_uninit_entry (lock_entry);
-      lock_entry->next = tran_lock->lk_entry_pool;
-      tran_lock->lk_entry_pool = lock_entry;
-      tran_lock->lk_entry_pool_count++;
+      block = tran_lock->arena_blocks->next;
+      tran_lock->arena_blocks->next = NULL;
     }
   else
     {
-      lf_freelist_retire (tran_entry, freelist, lock_entry);
+      block = tran_lock->arena_blocks;
+      tran_lock->arena_blocks = NULL;
     }
+
+  for (; block != NULL; block = next_block)
+    {
+      next_block = block->next;
+      free (block);
+      tran_lock->arena_block_count--;
+      lk_Gl.entry_memory -= sizeof (LK_ARENA_BLOCK);
+    }
+
+  /* all entries of the remaining block are free */
+  tran_lock->lk_entry_pool = NULL;
+  tran_lock->arena_carved_count = 0;
 }
 #endif
 
@@ -96,6 +96,9 @@ struct lk_entry
   int instant_lock_count;	/* number of instant lock requests */
   int bind_index_in_tran;
   XASL_ID xasl_id;
+  bool is_fastpath;		/* weak class lock held in a fast path slot of the transaction */
+  bool is_strong_counted;	/* strong class lock counted in the fast path strong lock counters */
+  int arena_tran_index;		/* transaction owning the arena block of the entry; -1 if from the shared freelist */
 #else				/* not SERVER_MODE */
   int dummy;
 #endif				/* not SERVER_MODE */
@@ -180,6 +183,7 @@ struct lk_res
   LOCK total_waiters_mode;	/* total mode of the waiters */
   LK_ENTRY *holder;		/* lock holder list */
   LK_ENTRY *waiter;		/* lock waiter list */
+  LK_ENTRY *waiter_tail;	/* last lock waiter, for FIFO append */
   LK_ENTRY *non2pl;		/* non2pl list */
   pthread_mutex_t res_mutex;	/* resource mutex */
   LK_RES *hash_next;		/* for hash chain */
@@ -231,6 +235,7 @@ extern void lock_stop_instant_lock_mode (THREAD_ENTRY * thread_p, int tran_index
 extern bool lock_is_instant_lock_mode (int tran_index);
 extern void lock_clear_deadlock_victim (int tran_index);
 extern unsigned int lock_get_number_object_locks (void);
+extern void lock_peek_stats (UINT64 * entry_memory);
 extern int lock_initialize_composite_lock (THREAD_ENTRY * thread_p, LK_COMPOSITE_LOCK * comp_lock);
 extern int lock_add_composite_lock (THREAD_ENTRY * thread_p, LK_COMPOSITE_LOCK * comp_lock, const OID * oid,
 				    const OID * class_oid);
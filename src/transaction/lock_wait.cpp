@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+//
+// Lock wait - spin-then-park waiting of lock requesters
+//
+
+#include "lock_wait.hpp"
+
+#include "thread_entry.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#if defined (WINDOWS)
+#include <windows.h>
+#endif
+
+// pauses between two checks of the thread entry, at most
+static const int LOCK_WAIT_MAX_BACKOFF = 64;
+// the spin budget never shrinks under max / LOCK_WAIT_SPIN_FLOOR_RATIO, so it can grow again if waits get shorter
+static const int LOCK_WAIT_SPIN_FLOOR_RATIO = 16;
+
+static void
+lock_wait_cpu_relax (void)
+{
+#if defined (WINDOWS)
+  YieldProcessor ();
+#elif defined (__i386__) || defined (__x86_64__)
+  __builtin_ia32_pause ();
+#else
+  std::atomic_signal_fence (std::memory_order_seq_cst);
+#endif
+}
+
+lock_wait_spinner::lock_wait_spinner ()
+  : m_spin_usecs (-1)
+  , m_can_spin (std::thread::hardware_concurrency () > 1)
+{
+}
+
+bool
+lock_wait_spinner::wait (cubthread::entry &thread_ref, int suspended_state, int max_spin_usecs)
+{
+  int spin_usecs = 0;
+  bool parked;
+
+  // wakers that do not know about lock waits check resume_status; it must be set before the mutex is released
+  thread_ref.resume_status = THREAD_LOCK_SUSPENDED;
+
+  if (m_can_spin && max_spin_usecs > 0)
+    {
+      spin_usecs = m_spin_usecs.load (std::memory_order_relaxed);
+      if (spin_usecs < 0 || spin_usecs > max_spin_usecs)
+	{
+	  spin_usecs = max_spin_usecs;
+	}
+
+      thread_unlock_entry (&thread_ref);
+      spin (thread_ref, suspended_state, spin_usecs);
+      thread_lock_entry (&thread_ref);
+    }
+
+  // decide under the mutex; a resume that happened while spinning has nobody to signal
+  if (thread_ref.lockwait_state == suspended_state && thread_ref.resume_status == THREAD_LOCK_SUSPENDED)
+    {
+      thread_suspend_wakeup_and_unlock_entry (&thread_ref, THREAD_LOCK_SUSPENDED);
+      parked = true;
+    }
+  else
+    {
+      thread_unlock_entry (&thread_ref);
+      parked = false;
+    }
+
+  if (spin_usecs > 0)
+    {
+      adapt (parked, max_spin_usecs);
+    }
+
+  return parked;
+}
+
+void
+lock_wait_spinner::resume (cubthread::entry &thread_ref, int state)
+{
+  // the waiter watches lockwait_state and resume_status, whether it is still spinning or already parked
+  thread_ref.lockwait = NULL;
+  thread_ref.lockwait_state = state;
+  thread_ref.resume_status = THREAD_LOCK_RESUMED;
+
+  pthread_cond_signal (&thread_ref.wakeup_cond);
+  thread_unlock_entry (&thread_ref);
+}
+
+int
+lock_wait_spinner::get_spin_usecs () const
+{
+  return std::max (m_spin_usecs.load (std::memory_order_relaxed), 0);
+}
+
+void
+lock_wait_spinner::spin (cubthread::entry &thread_ref, int suspended_state, int spin_usecs)
+{
+  volatile int *state_p = &thread_ref.lockwait_state;
+  volatile thread_resume_suspend_status *resume_p = &thread_ref.resume_status;
+  std::chrono::steady_clock::time_point deadline;
+  int backoff = 1;
+  int i;
+
+  deadline = std::chrono::steady_clock::now () + std::chrono::microseconds (spin_usecs);
+  while (true)
+    {
+      for (i = 0; i < backoff; i++)
+	{
+	  lock_wait_cpu_relax ();
+	}
+
+      if (*state_p != suspended_state || *resume_p != THREAD_LOCK_SUSPENDED)
+	{
+	  return;
+	}
+      if (std::chrono::steady_clock::now () >= deadline)
+	{
+	  return;
+	}
+      if (backoff < LOCK_WAIT_MAX_BACKOFF)
+	{
+	  backoff *= 2;
+	}
+    }
+}
+
+void
+lock_wait_spinner::adapt (bool parked, int max_spin_usecs)
+{
+  int cur_usecs = m_spin_usecs.load (std::memory_order_relaxed);
+  int new_usecs;
+
+  if (cur_usecs < 0 || cur_usecs > max_spin_usecs)
+    {
+      cur_usecs = max_spin_usecs;
+    }
+
+  if (parked)
+    {
+      // spinning was wasted; halve the budget
+      new_usecs = std::max (cur_usecs / 2, std::max (max_spin_usecs / LOCK_WAIT_SPIN_FLOOR_RATIO, 1));
+    }
+  else
+    {
+      // the wait ended while spinning; let the budget grow back
+      new_usecs = std::min (cur_usecs + cur_usecs / 4 + 1, max_spin_usecs);
+    }
+
+  // racy on purpose: concurrent waiters may overwrite each other's adjustment
+  m_spin_usecs.store (new_usecs, std::memory_order_relaxed);
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+//
+// Lock wait - spin-then-park waiting of lock requesters
+//
+// A lock requester that cannot be granted registers the wait on its thread entry (lockwait_state) and waits until the
+// transaction that grants it the lock, the deadlock detector, the timeout checker or an interrupt resumes it. Many
+// waits on hot rows are as short as the holder's remaining work; parking the thread on its condition variable costs
+// a sleep and a wakeup that can take longer than the wait itself.
+//
+// The waiter therefore spins first, watching its thread entry with exponentially growing pauses between checks, and
+// parks on the condition variable only when the spin budget runs out. The budget adapts to the workload: it grows
+// when waits end while spinning and shrinks when they end parked, down to a small probing floor.
+//
+
+#ifndef _LOCK_WAIT_HPP_
+#define _LOCK_WAIT_HPP_
+
+#if !defined (SERVER_MODE)
+#error Belongs to server module
+#endif /* !defined (SERVER_MODE) */
+
+#include <atomic>
+
+// forward definitions
+namespace cubthread
+{
+  class entry;
+}
+
+class lock_wait_spinner
+{
+  public:
+    lock_wait_spinner ();
+
+    lock_wait_spinner (const lock_wait_spinner &other) = delete;
+    lock_wait_spinner &operator= (const lock_wait_spinner &other) = delete;
+
+    // Wait until the thread is resumed. Called holding the thread entry mutex, with thread_ref.lockwait_state set to
+    // suspended_state; returns with the mutex released. Spins for at most max_spin_usecs before parking.
+    // Returns true if the thread had to park.
+    bool wait (cubthread::entry &thread_ref, int suspended_state, int max_spin_usecs);
+
+    // Resume a waiting thread with the given state. Called holding the thread entry mutex; releases it.
+    static void resume (cubthread::entry &thread_ref, int state);
+
+    int get_spin_usecs () const;
+
+  private:
+    void spin (cubthread::entry &thread_ref, int suspended_state, int spin_usecs);
+    void adapt (bool parked, int max_spin_usecs);
+
+    std::atomic<int> m_spin_usecs;	// current spin budget
+    bool m_can_spin;			// false on single processor machines
+};
+
+#endif // _LOCK_WAIT_HPP_
@@ -522,6 +522,7 @@ struct log_tdes
   XASL_ID xasl_id;		/* xasl id of current query */
   LK_RES *waiting_for_res;	/* resource that i'm waiting for */
   int disable_modifications;	/* db_Disable_modification for each tran */
+  bool is_read_only;		/* read-only transactions of the client; see xlogtb_set_read_only */
 
   TRAN_ABORT_REASON tran_abort_reason;
 
@@ -5037,6 +5037,19 @@ log_commit (THREAD_ENTRY * thread_p, int tran_index, bool retain_lock)
 
   tdes->m_multiupd_stats.clear ();
 
+  if (tdes->is_read_only && !MVCCID_IS_VALID (tdes->mvccinfo.id) && LSA_ISNULL (&tdes->tail_lsa)
+      && tdes->gtrid == LOG_2PC_NULL_GTRID && tdes->coord == NULL && !log_No_logging)
+    {
+      /* A read-only transaction that got no MVCCID and logged nothing is neither distributed nor has anything to
+       * flush: release its snapshot, temporary files and locks and finish. */
+      (void) log_commit_local (thread_p, tdes, retain_lock, true);
+      logtb_clear_tdes (thread_p, tdes);
+
+      perfmon_inc_stat (thread_p, PSTAT_TRAN_NUM_COMMITS);
+
+      return TRAN_UNACTIVE_COMMITTED;
+    }
+
   if (log_2pc_clear_and_is_tran_distributed (tdes))
     {
       /* This is the coordinator of a distributed transaction If we are in prepare to commit mode. I cannot be the
@@ -869,6 +869,7 @@ logtb_set_tdes (THREAD_ENTRY * thread_p, LOG_TDES * tdes, const BOOT_CLIENT_CRED
 #endif /* SERVER_MODE */
   tdes->wait_msecs = wait_msecs;
   tdes->isolation = isolation;
+  tdes->is_read_only = false;
   tdes->isloose_end = false;
   tdes->interrupt = false;
   tdes->topops.stack = NULL;
@@ -1029,7 +1030,7 @@ logtb_is_tran_modification_disabled (THREAD_ENTRY * thread_p)
       return db_Disable_modifications;
     }
 
-  return tdes->disable_modifications;
+  return tdes->disable_modifications || tdes->is_read_only;
 }
 
 /*
@@ -1647,6 +1648,7 @@ logtb_initialize_tdes (LOG_TDES * tdes, int tran_index)
   XASL_ID_SET_NULL (&tdes->xasl_id);
   tdes->waiting_for_res = NULL;
   tdes->disable_modifications = db_Disable_modifications;
+  tdes->is_read_only = false;
   tdes->tran_abort_reason = TRAN_NORMAL;
   tdes->num_exec_queries = 0;
 
@@ -2633,6 +2635,41 @@ xlogtb_reset_isolation (THREAD_ENTRY * thread_p, TRAN_ISOLATION isolation)
   return error_code;
 }
 
+/*
+ * xlogtb_set_read_only - set or clear the read-only mode of the transactions of current client
+ *
+ * return: error code.
+ *
+ *   read_only(in): true if the next transactions are read-only
+ *
+ * Note: A read-only transaction is refused all requests that modify the database (see
+ *       logtb_is_tran_modification_disabled), so it never gets an MVCCID and never logs. It reads MVCC classes
+ *       without IS_LOCK when it already holds their SCH_S_LOCK (see lock_can_skip_read_only_class_lock), has no
+ *       unique statistics to reflect when its MVCC info is completed, and log_commit finishes it without the
+ *       two-phase commit and checkpoint checks.
+ *
+ * Note/Warning: Like the isolation level, it should be changed when the current transaction has not done any work
+ *               (i.e, just after restart, commit, or abort).
+ */
+int
+xlogtb_set_read_only (THREAD_ENTRY * thread_p, bool read_only)
+{
+  LOG_TDES *tdes;		/* Transaction descriptor */
+  int tran_index;
+
+  tran_index = LOG_FIND_THREAD_TRAN_INDEX (thread_p);
+  tdes = LOG_FIND_TDES (tran_index);
+  if (tdes == NULL)
+    {
+      er_set (ER_FATAL_ERROR_SEVERITY, ARG_FILE_LINE, ER_LOG_UNKNOWN_TRANINDEX, 1, tran_index);
+      return ER_LOG_UNKNOWN_TRANINDEX;
+    }
+
+  tdes->is_read_only = read_only;
+
+  return NO_ERROR;
+}
+
 /*
  * logtb_find_isolation - find the isolation level for given trans
  *
@@ -4005,6 +4042,11 @@ logtb_complete_mvcc (THREAD_ENTRY * thread_p, LOG_TDES * tdes, bool committed)
     {
       mvcc_table->complete_mvcc (tran_index, mvccid, committed);
     }
+  else if (tdes->is_read_only)
+    {
+      /* a read-only transaction has no unique statistics to reflect, it only has to release its snapshot */
+      log_Gl.mvcc_table.reset_transaction_lowest_active (tran_index);
+    }
   else
     {
 #if defined(SA_MODE)
@@ -4585,6 +4627,12 @@ logtb_complete_sub_mvcc (THREAD_ENTRY * thread_p, LOG_TDES * tdes)
     {
       /* adjust snapshot to reflect committed sub-transaction, since the parent transaction didn't finished yet */
       MVCC_SNAPSHOT *snapshot = &tdes->mvccinfo.snapshot;
+      if (snapshot->csn != MVCC_CSN_NULL)
+	{
+	  /* the sub-transaction got a CSN greater than the snapshot CSN */
+	  snapshot->completed_sub_ids.push_back (mvcc_sub_id);
+	  return;
+	}
       if (mvcc_sub_id >= snapshot->highest_completed_mvccid)
 	{
 	  snapshot->highest_completed_mvccid = mvcc_sub_id;
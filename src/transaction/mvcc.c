@@ -32,6 +32,8 @@
 #include "porting_inline.hpp"
 #include "vacuum.h"
 
+#include <algorithm>
+
 #define MVCC_IS_REC_INSERTER_ACTIVE(thread_p, rec_header_p) \
   (mvcc_is_active_id (thread_p, (rec_header_p)->mvcc_ins_id))
 
@@ -87,12 +89,28 @@ mvcc_is_id_in_snapshot (THREAD_ENTRY * thread_p, MVCCID mvcc_id, MVCC_SNAPSHOT *
       return false;
     }
 
+  // *INDENT-OFF*
+  if (snapshot->csn != MVCC_CSN_NULL && !snapshot->completed_sub_ids.empty ()
+      && std::find (snapshot->completed_sub_ids.begin (), snapshot->completed_sub_ids.end (), mvcc_id)
+	 != snapshot->completed_sub_ids.end ())
+    {
+      /* sub-transactions completed by the owner of the snapshot are visible to it */
+      return false;
+    }
+  // *INDENT-ON*
+
   if (MVCC_ID_FOLLOW_OR_EQUAL (mvcc_id, snapshot->highest_completed_mvccid))
     {
       /* MVCC id is active */
       return true;
     }
 
+  if (snapshot->csn != MVCC_CSN_NULL)
+    {
+      /* active unless it was completed before the snapshot */
+      return log_Gl.mvcc_table.is_active_for_csn (mvcc_id, snapshot->csn);
+    }
+
   return snapshot->m_active_mvccs.is_active (mvcc_id);
 }
 
@@ -645,6 +663,8 @@ mvcc_snapshot::mvcc_snapshot ()
   : lowest_active_mvccid (MVCCID_NULL)
   , highest_completed_mvccid (MVCCID_NULL)
   , m_active_mvccs ()
+  , csn (MVCC_CSN_NULL)
+  , completed_sub_ids ()
   , snapshot_fnc (NULL)
   , valid (false)
 {
@@ -658,6 +678,8 @@ mvcc_snapshot::reset ()
   highest_completed_mvccid = MVCCID_NULL;
 
   m_active_mvccs.reset ();
+  csn = MVCC_CSN_NULL;
+  completed_sub_ids.clear ();
 
   valid = false;
 }
@@ -670,6 +692,8 @@ mvcc_snapshot::copy_to (mvcc_snapshot & dest) const
 
   dest.lowest_active_mvccid = lowest_active_mvccid;
   dest.highest_completed_mvccid = highest_completed_mvccid;
+  dest.csn = csn;
+  dest.completed_sub_ids = completed_sub_ids;
   dest.snapshot_fnc = snapshot_fnc;
   dest.valid = valid;
 }
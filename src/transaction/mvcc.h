@@ -174,6 +174,13 @@ struct mvcc_snapshot
 
   mvcc_active_tran m_active_mvccs;
 
+  /* commit sequence number of a CSN snapshot; MVCCIDs completed with a greater CSN are active for the snapshot. if
+   * not MVCC_CSN_NULL, m_active_mvccs is not used */
+  MVCC_CSN csn;
+  // *INDENT-OFF*
+  std::vector<MVCCID> completed_sub_ids;	/* sub-transactions of the owner completed after a CSN snapshot */
+  // *INDENT-ON*
+
   MVCC_SNAPSHOT_FUNC snapshot_fnc;	/* the snapshot function */
 
   bool valid;			/* true, if the snapshot is valid */
@@ -27,9 +27,16 @@
 #include "log_impl.h"
 #include "mvcc.h"
 #include "perf_monitor.h"
+#include "system_parameter.h"
 #include "thread_manager.hpp"
 
 #include <cassert>
+#include <thread>
+
+// states of an MVCCID in the CSN table, before it gets its commit sequence number
+const MVCC_CSN MVCC_CSN_ACTIVE = 1;
+const MVCC_CSN MVCC_CSN_COMPLETING = 2;   // the CSN is being generated; readers wait for it
+const MVCC_CSN MVCC_CSN_FIRST = 3;
 
 // help debugging oldest active by following all changes
 struct oldest_active_event
@@ -171,6 +178,12 @@ mvcctable::mvcctable ()
   , m_active_trans_mutex ()
   , m_oldest_visible (MVCCID_NULL)
   , m_ov_lock_count (0)
+  , m_csn_enabled (false)
+  , m_last_csn (MVCC_CSN_FIRST)
+  , m_csn_next_mvccid (MVCCID_NULL)
+  , m_csn_slots (NULL)
+  , m_csn_overflow ()
+  , m_csn_overflow_mutex ()
 {
 }
 
@@ -178,6 +191,7 @@ mvcctable::~mvcctable ()
 {
   delete [] m_transaction_lowest_visible_mvccids;
   delete [] m_trans_status_history;
+  delete [] m_csn_slots;
 }
 
 void
@@ -192,6 +206,18 @@ mvcctable::initialize ()
   m_trans_status_history_position = 0;
   m_current_status_lowest_active_mvccid = MVCCID_FIRST;
 
+#if defined (SERVER_MODE)
+  m_csn_enabled = prm_get_bool_value (PRM_ID_MVCC_CSN_SNAPSHOT);
+#else
+  m_csn_enabled = false;
+#endif
+  if (m_csn_enabled)
+    {
+      m_csn_slots = new csn_slot[CSN_TABLE_SIZE] ();
+      // all are 0 = MVCCID_NULL
+    }
+  m_last_csn = MVCC_CSN_FIRST;
+
   alloc_transaction_lowest_active ();
 }
 
@@ -219,6 +245,10 @@ mvcctable::finalize ()
   delete [] m_transaction_lowest_visible_mvccids;
   m_transaction_lowest_visible_mvccids = NULL;
   m_transaction_lowest_visible_mvccids_size = 0;
+
+  delete [] m_csn_slots;
+  m_csn_slots = NULL;
+  m_csn_overflow.clear ();
 }
 
 void
@@ -290,6 +320,12 @@ mvcctable::build_mvcc_info (log_tdes &tdes)
 				     oldest_active_event::BUILD_MVCC_INFO);
 	}
 
+      if (m_csn_enabled)
+	{
+	  // a CSN snapshot does not copy the transaction status
+	  break;
+	}
+
       index = m_trans_status_history_position.load ();
       assert (index < HISTORY_MAX_SIZE);
 
@@ -321,11 +357,23 @@ mvcctable::build_mvcc_info (log_tdes &tdes)
 	}
     }
 
-  // tdes.mvccinfo.snapshot.m_active_mvccs was not checked because it was not safe; now it is
-  tdes.mvccinfo.snapshot.m_active_mvccs.check_valid ();
+  if (m_csn_enabled)
+    {
+      // MVCCIDs below the lowest active are completed; the CSN is read after it, so it covers them all. MVCCIDs that
+      // are not yet given when the CSN is read are active for the snapshot.
+      tdes.mvccinfo.snapshot.csn = m_last_csn.load ();
+      tdes.mvccinfo.snapshot.completed_sub_ids.clear ();
+      highest_completed_mvccid = m_csn_next_mvccid.load ();
+    }
+  else
+    {
+      // tdes.mvccinfo.snapshot.m_active_mvccs was not checked because it was not safe; now it is
+      tdes.mvccinfo.snapshot.m_active_mvccs.check_valid ();
 
-  highest_completed_mvccid = tdes.mvccinfo.snapshot.m_active_mvccs.compute_highest_completed_mvccid ();
-  MVCCID_FORWARD (highest_completed_mvccid);
+      highest_completed_mvccid = tdes.mvccinfo.snapshot.m_active_mvccs.compute_highest_completed_mvccid ();
+      MVCCID_FORWARD (highest_completed_mvccid);
+      tdes.mvccinfo.snapshot.csn = MVCC_CSN_NULL;
+    }
 
   /* update lowest active mvccid computed for the most recent snapshot */
   tdes.mvccinfo.recent_snapshot_lowest_active_mvccid = crt_status_lowest_active;
@@ -427,6 +475,12 @@ mvcctable::is_active (MVCCID mvccid) const
   size_t index = 0;
   mvcc_trans_status::version_type version;
   bool ret_active = false;
+
+  if (m_csn_enabled)
+    {
+      // the transaction status history is not kept
+      return get_csn (mvccid) == MVCC_CSN_ACTIVE;
+    }
   // trans status must be same before and after computing is_active. if it is not, we need to repeat the computation.
   do
     {
@@ -468,6 +522,12 @@ mvcctable::complete_mvcc (int tran_index, MVCCID mvccid, bool committed)
 {
   assert (MVCCID_IS_VALID (mvccid));
 
+  if (m_csn_enabled)
+    {
+      complete_mvcc_csn (tran_index, mvccid, committed);
+      return;
+    }
+
   // only one can change status at a time
   std::unique_lock<std::mutex> ulock (m_active_trans_mutex);
 
@@ -489,6 +549,37 @@ mvcctable::complete_mvcc (int tran_index, MVCCID mvccid, bool committed)
   // finish next trans status
   next_tran_status_finish (next_status, next_index);
 
+  complete_transaction_lowest_visible (tran_index, mvccid, committed);
+
+  ulock.unlock ();
+
+  // update lowest active in current transactions status. can be done outside lock
+  // this doesn't have to be 100% accurate; it is used as indicative by vacuum to clean up the database. however, it
+  // shouldn't be left too much behind, or vacuum can't advance
+  // so we try to limit recalculation when mvccid matches current global_lowest_active; since we are not locked, it is
+  // not guaranteed to be always updated; therefore we add the second condition to go below trans status
+  // bit area starting MVCCID; the recalculation will happen on each iteration if there are long transactions.
+  MVCCID global_lowest_active = m_current_status_lowest_active_mvccid;
+  if (global_lowest_active == mvccid
+      || MVCC_ID_PRECEDES (mvccid, next_status.m_active_mvccs.get_bit_area_start_mvccid ()))
+    {
+      MVCCID new_lowest_active = next_status.m_active_mvccs.compute_lowest_active_mvccid ();
+#if !defined (NDEBUG)
+      oldest_active_add_event (new_lowest_active, (int) next_index, oldest_active_event::GET_LOWEST_ACTIVE,
+			       oldest_active_event::COMPLETE_MVCC);
+#endif // !NDEBUG
+      // we need to recheck version to validate result
+      if (next_status.m_version.load () == next_version)
+	{
+	  // advance
+	  advance_oldest_active (new_lowest_active);
+	}
+    }
+}
+
+void
+mvcctable::complete_transaction_lowest_visible (int tran_index, MVCCID mvccid, bool committed)
+{
   if (committed)
     {
       /* be sure that transaction modifications can't be vacuumed up to LOG_COMMIT. Otherwise, the following
@@ -512,30 +603,44 @@ mvcctable::complete_mvcc (int tran_index, MVCCID mvccid, bool committed)
       oldest_active_set (m_transaction_lowest_visible_mvccids[tran_index], tran_index, MVCCID_NULL,
 			 oldest_active_event::COMPLETE_MVCC);
     }
+}
+
+void
+mvcctable::complete_mvcc_csn (int tran_index, MVCCID mvccid, bool committed)
+{
+  MVCCID new_lowest_active = MVCCID_NULL;
+
+  // the current status is still needed to compute the lowest active MVCCID; no history is kept since snapshots and
+  // is_active use the CSN table
+  std::unique_lock<std::mutex> ulock (m_active_trans_mutex);
+
+  // unique statistics are applied before the transaction becomes visible, like in complete_mvcc
+  if (committed && logtb_tran_update_all_global_unique_stats (thread_get_thread_entry_info ()) != NO_ERROR)
+    {
+      assert (false);
+    }
+
+  // from here on, the MVCCID is completed for new snapshots
+  complete_csn (mvccid);
+
+  m_current_trans_status.m_active_mvccs.set_inactive_mvccid (mvccid);
+  m_current_trans_status.m_last_completed_mvccid = mvccid;
+  m_current_trans_status.m_event_type = committed ? mvcc_trans_status::COMMIT : mvcc_trans_status::ROLLBACK;
+
+  complete_transaction_lowest_visible (tran_index, mvccid, committed);
+
+  // same condition as complete_mvcc, but the lowest active is computed under lock since there is no history entry
+  if (m_current_status_lowest_active_mvccid.load () == mvccid
+      || MVCC_ID_PRECEDES (mvccid, m_current_trans_status.m_active_mvccs.get_bit_area_start_mvccid ()))
+    {
+      new_lowest_active = m_current_trans_status.m_active_mvccs.compute_lowest_active_mvccid ();
+    }
 
   ulock.unlock ();
 
-  // update lowest active in current transactions status. can be done outside lock
-  // this doesn't have to be 100% accurate; it is used as indicative by vacuum to clean up the database. however, it
-  // shouldn't be left too much behind, or vacuum can't advance
-  // so we try to limit recalculation when mvccid matches current global_lowest_active; since we are not locked, it is
-  // not guaranteed to be always updated; therefore we add the second condition to go below trans status
-  // bit area starting MVCCID; the recalculation will happen on each iteration if there are long transactions.
-  MVCCID global_lowest_active = m_current_status_lowest_active_mvccid;
-  if (global_lowest_active == mvccid
-      || MVCC_ID_PRECEDES (mvccid, next_status.m_active_mvccs.get_bit_area_start_mvccid ()))
+  if (new_lowest_active != MVCCID_NULL)
     {
-      MVCCID new_lowest_active = next_status.m_active_mvccs.compute_lowest_active_mvccid ();
-#if !defined (NDEBUG)
-      oldest_active_add_event (new_lowest_active, (int) next_index, oldest_active_event::GET_LOWEST_ACTIVE,
-			       oldest_active_event::COMPLETE_MVCC);
-#endif // !NDEBUG
-      // we need to recheck version to validate result
-      if (next_status.m_version.load () == next_version)
-	{
-	  // advance
-	  advance_oldest_active (new_lowest_active);
-	}
+      advance_oldest_active (new_lowest_active);
     }
 }
 
@@ -544,6 +649,16 @@ mvcctable::complete_sub_mvcc (MVCCID mvccid)
 {
   assert (MVCCID_IS_VALID (mvccid));
 
+  if (m_csn_enabled)
+    {
+      complete_csn (mvccid);
+
+      std::unique_lock<std::mutex> ulock (m_active_trans_mutex);
+      m_current_trans_status.m_active_mvccs.set_inactive_mvccid (mvccid);
+      m_current_trans_status.m_last_completed_mvccid = mvccid;
+      return;
+    }
+
   // only one can change status at a time
   std::unique_lock<std::mutex> ulock (m_active_trans_mutex);
 
@@ -572,6 +687,11 @@ mvcctable::get_new_mvccid ()
   m_new_mvccid_lock.lock ();
   id = log_Gl.hdr.mvcc_next_id;
   MVCCID_FORWARD (log_Gl.hdr.mvcc_next_id);
+  if (m_csn_enabled)
+    {
+      register_csn_mvccid (id);
+      m_csn_next_mvccid.store (log_Gl.hdr.mvcc_next_id);
+    }
   m_new_mvccid_lock.unlock ();
 
   return id;
@@ -588,6 +708,13 @@ mvcctable::get_two_new_mvccid (MVCCID &first, MVCCID &second)
   second = log_Gl.hdr.mvcc_next_id;
   MVCCID_FORWARD (log_Gl.hdr.mvcc_next_id);
 
+  if (m_csn_enabled)
+    {
+      register_csn_mvccid (first);
+      register_csn_mvccid (second);
+      m_csn_next_mvccid.store (log_Gl.hdr.mvcc_next_id);
+    }
+
   m_new_mvccid_lock.unlock ();
 }
 
@@ -607,6 +734,9 @@ mvcctable::reset_start_mvccid ()
   m_trans_status_history[m_trans_status_history_position].m_active_mvccs.reset_start_mvccid (log_Gl.hdr.mvcc_next_id);
 
   m_current_status_lowest_active_mvccid.store (log_Gl.hdr.mvcc_next_id);
+
+  // MVCCIDs before restart are all completed and below the lowest active
+  m_csn_next_mvccid.store (log_Gl.hdr.mvcc_next_id);
 }
 
 MVCCID
@@ -648,3 +778,139 @@ mvcctable::is_global_oldest_visible_locked () const
 {
   return m_ov_lock_count != 0;
 }
+
+//
+// find_oldest_visible_holder - find the transaction with the lowest visible MVCCID; this is the transaction that holds
+//                              back the global oldest visible MVCCID, unless all transactions are past it
+//
+// return              : transaction index or NULL_TRAN_INDEX if no transaction has a lowest visible MVCCID
+// lowest_visible (out) : lowest visible MVCCID of the transaction
+//
+int
+mvcctable::find_oldest_visible_holder (MVCCID &lowest_visible) const
+{
+  int holder = NULL_TRAN_INDEX;
+  MVCCID loaded_tran_mvccid;
+
+  lowest_visible = MVCCID_NULL;
+  for (size_t idx = 0; idx < m_transaction_lowest_visible_mvccids_size; idx++)
+    {
+      loaded_tran_mvccid = m_transaction_lowest_visible_mvccids[idx].load ();
+      if (loaded_tran_mvccid == MVCCID_NULL || loaded_tran_mvccid == MVCCID_ALL_VISIBLE)
+	{
+	  // no snapshot or snapshot being built
+	  continue;
+	}
+      if (holder == NULL_TRAN_INDEX || MVCC_ID_PRECEDES (loaded_tran_mvccid, lowest_visible))
+	{
+	  holder = (int) idx;
+	  lowest_visible = loaded_tran_mvccid;
+	}
+    }
+  return holder;
+}
+
+//
+// Commit sequence numbers
+//
+// An MVCCID gets a commit sequence number (CSN) from a global counter when it is completed (committed, rolled back or
+// sub-transaction ended). A CSN snapshot is the last CSN given plus the lowest active MVCCID and the next MVCCID: an
+// MVCCID between them is active for the snapshot unless its CSN is lower or equal to the snapshot CSN. Snapshots are
+// built without copying the transaction status, and visibility checks look the CSN up in a lock-free table indexed by
+// MVCCID.
+//
+// A slot of the table is given to a new MVCCID only if its MVCCID is older than the oldest visible MVCCID, since such
+// MVCCID is below the lowest active MVCCID of any snapshot and is never looked up. Otherwise, the new MVCCID goes to
+// an overflow map protected by a mutex; this happens only while a transaction stays active during CSN_TABLE_SIZE newer
+// MVCCIDs.
+//
+
+void
+mvcctable::register_csn_mvccid (MVCCID mvccid)
+{
+  // called while holding m_new_mvccid_lock
+  csn_slot &slot = m_csn_slots[mvccid & CSN_INDEX_MASK];
+  MVCCID slot_mvccid = slot.m_mvccid.load ();
+
+  if (slot_mvccid == MVCCID_NULL || MVCC_ID_PRECEDES (slot_mvccid, m_oldest_visible.load ()))
+    {
+      // readers of the old MVCCID must not see the new state
+      slot.m_mvccid.store (MVCCID_NULL);
+      slot.m_csn.store (MVCC_CSN_ACTIVE);
+      slot.m_mvccid.store (mvccid);
+      return;
+    }
+
+  std::unique_lock<std::mutex> ulock (m_csn_overflow_mutex);
+
+  // remove completed MVCCIDs that are not looked up anymore
+  m_csn_overflow.erase (m_csn_overflow.begin (), m_csn_overflow.lower_bound (m_oldest_visible.load ()));
+  m_csn_overflow[mvccid] = MVCC_CSN_ACTIVE;
+}
+
+void
+mvcctable::complete_csn (MVCCID mvccid)
+{
+  csn_slot &slot = m_csn_slots[mvccid & CSN_INDEX_MASK];
+
+  if (slot.m_mvccid.load () == mvccid)
+    {
+      // the slot cannot be given to another MVCCID while this one is active
+      // a reader that finds the MVCCID completing waits for its CSN, so a snapshot that is built after the CSN is
+      // generated never sees the MVCCID active
+      slot.m_csn.store (MVCC_CSN_COMPLETING);
+      slot.m_csn.store (++m_last_csn);
+      return;
+    }
+
+  std::unique_lock<std::mutex> ulock (m_csn_overflow_mutex);
+  std::map<MVCCID, MVCC_CSN>::iterator it = m_csn_overflow.find (mvccid);
+
+  assert (it != m_csn_overflow.end ());
+  if (it != m_csn_overflow.end ())
+    {
+      it->second = ++m_last_csn;
+    }
+}
+
+MVCC_CSN
+mvcctable::get_csn (MVCCID mvccid) const
+{
+  const csn_slot &slot = m_csn_slots[mvccid & CSN_INDEX_MASK];
+  MVCC_CSN csn;
+
+  while (slot.m_mvccid.load () == mvccid)
+    {
+      csn = slot.m_csn.load ();
+      if (slot.m_mvccid.load () != mvccid)
+	{
+	  // slot given to another MVCCID
+	  break;
+	}
+      if (csn != MVCC_CSN_COMPLETING)
+	{
+	  return csn;
+	}
+      std::this_thread::yield ();
+    }
+
+  std::unique_lock<std::mutex> ulock (m_csn_overflow_mutex);
+  std::map<MVCCID, MVCC_CSN>::const_iterator it = m_csn_overflow.find (mvccid);
+
+  if (it != m_csn_overflow.end ())
+    {
+      return it->second;
+    }
+
+  // not registered: completed before the oldest visible MVCCID or before the server started
+  return MVCC_CSN_FIRST;
+}
+
+bool
+mvcctable::is_active_for_csn (MVCCID mvccid, MVCC_CSN snapshot_csn) const
+{
+  assert (m_csn_enabled && snapshot_csn != MVCC_CSN_NULL);
+
+  MVCC_CSN csn = get_csn (mvccid);
+  return csn == MVCC_CSN_ACTIVE || csn > snapshot_csn;
+}
@@ -32,6 +32,7 @@
 #include "storage_common.h"
 
 #include <atomic>
+#include <map>
 #include <mutex>
 
 // forward declarations
@@ -84,6 +85,7 @@ class mvcctable
     void get_two_new_mvccid (MVCCID &first, MVCCID &second);
 
     bool is_active (MVCCID mvccid) const;
+    bool is_active_for_csn (MVCCID mvccid, MVCC_CSN snapshot_csn) const;
 
     void reset_start_mvccid ();     // not thread safe
 
@@ -92,12 +94,24 @@ class mvcctable
     void lock_global_oldest_visible ();
     void unlock_global_oldest_visible ();
     bool is_global_oldest_visible_locked () const;
+    int find_oldest_visible_holder (MVCCID &lowest_visible) const;
 
   private:
 
     static const size_t HISTORY_MAX_SIZE = 2048;  // must be a power of 2
     static const size_t HISTORY_INDEX_MASK = HISTORY_MAX_SIZE - 1;
 
+    static const size_t CSN_TABLE_SIZE = 64 * 1024;  // must be a power of 2
+    static const size_t CSN_INDEX_MASK = CSN_TABLE_SIZE - 1;
+
+    // commit sequence number of an MVCCID; the MVCCID is written last when the slot is given to a new MVCCID, so a
+    // reader that finds the same MVCCID before and after reading the CSN has read the CSN of that MVCCID
+    struct csn_slot
+    {
+      std::atomic<MVCCID> m_mvccid;
+      std::atomic<MVCC_CSN> m_csn;
+    };
+
     /* lowest active MVCCIDs - array of size NUM_TOTAL_TRAN_INDICES */
     lowest_active_mvccid_type *m_transaction_lowest_visible_mvccids;
     size_t m_transaction_lowest_visible_mvccids_size;
@@ -119,10 +133,27 @@ class mvcctable
     std::atomic<MVCCID> m_oldest_visible;
     std::atomic<size_t> m_ov_lock_count;
 
+    /* commit sequence number snapshots (mvcc_csn_snapshot); a snapshot is the last CSN given to a completed MVCCID */
+    bool m_csn_enabled;
+    std::atomic<MVCC_CSN> m_last_csn;
+    /* a copy of log_Gl.hdr.mvcc_next_id published after the new MVCCIDs are registered */
+    std::atomic<MVCCID> m_csn_next_mvccid;
+    /* lock-free MVCCID to CSN table - array of size CSN_TABLE_SIZE */
+    csn_slot *m_csn_slots;
+    /* MVCCIDs whose slot still holds an MVCCID that may be needed by a snapshot; only long transactions get here */
+    std::map<MVCCID, MVCC_CSN> m_csn_overflow;
+    mutable std::mutex m_csn_overflow_mutex;
+
     mvcc_trans_status &next_trans_status_start (mvcc_trans_status::version_type &next_version, size_t &next_index);
     void next_tran_status_finish (mvcc_trans_status &next_trans_status, size_t next_index);
     void advance_oldest_active (MVCCID next_oldest_active);
     MVCCID compute_oldest_visible_mvccid () const;
+
+    void register_csn_mvccid (MVCCID mvccid);
+    void complete_csn (MVCCID mvccid);
+    MVCC_CSN get_csn (MVCCID mvccid) const;
+    void complete_mvcc_csn (int tran_index, MVCCID mvccid, bool committed);
+    void complete_transaction_lowest_visible (int tran_index, MVCCID mvccid, bool committed);
 };
 
 #endif // !_MVCC_TABLE_H_
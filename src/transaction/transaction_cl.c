@@ -67,6 +67,7 @@
 int tm_Tran_index = NULL_TRAN_INDEX;
 TRAN_ISOLATION tm_Tran_isolation = TRAN_UNKNOWN_ISOLATION;
 bool tm_Tran_async_ws = false;
+bool tm_Tran_read_only = false;
 int tm_Tran_wait_msecs = TRAN_LOCK_INFINITE_WAIT;
 bool tm_Tran_check_interrupt = false;
 int tm_Tran_ID = -1;
@@ -125,6 +126,16 @@ tran_cache_tran_settings (int tran_index, int lock_timeout, TRAN_ISOLATION tran_
   tm_Tran_wait_msecs = lock_timeout;
   tm_Tran_isolation = tran_isolation;
 
+  /* a newly assigned transaction index starts in read-write mode */
+  if (tm_Tran_read_only)
+    {
+      tm_Tran_read_only = false;
+      if (db_Disable_modifications > 0)
+	{
+	  (void) db_enable_modification ();
+	}
+    }
+
   /* This is a dirty, but quick, method by which we can flag that the database connection has been terminated. This
    * flag is used by the C API calls to determine if a database connection exists. */
   if (tm_Tran_index == NULL_TRAN_INDEX)
@@ -223,6 +234,62 @@ tran_reset_isolation (TRAN_ISOLATION isolation, bool async_ws)
   return error_code;
 }
 
+/*
+ * tran_reset_read_only - Set the access mode of client session (transaction index)
+ *
+ * return:  NO_ERROR if all OK, ER_ status otherwise
+ *
+ *   read_only(in): true for READ ONLY, false for READ WRITE
+ *
+ * NOTE: A read-only transaction cannot modify the database, neither here nor on the server. Like the isolation
+ *       level, the access mode should be changed at the beginning of a transaction.
+ */
+int
+tran_reset_read_only (bool read_only)
+{
+  int error_code = NO_ERROR;
+
+  if (tm_Tran_read_only == read_only)
+    {
+      return NO_ERROR;
+    }
+
+  if (read_only && tran_has_updated ())
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_DB_NO_MODIFICATIONS, 0);
+      return ER_DB_NO_MODIFICATIONS;
+    }
+
+  error_code = log_set_read_only (read_only);
+  if (error_code != NO_ERROR)
+    {
+      return error_code;
+    }
+
+  tm_Tran_read_only = read_only;
+  if (read_only)
+    {
+      (void) db_disable_modification ();
+    }
+  else
+    {
+      (void) db_enable_modification ();
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * tran_is_read_only - Is the client session in read-only mode?
+ *
+ * return: true if the transactions of the session cannot modify the database
+ */
+bool
+tran_is_read_only (void)
+{
+  return tm_Tran_read_only;
+}
+
 /* only loaddb changes this setting */
 bool tm_Use_OID_preflush = true;
 
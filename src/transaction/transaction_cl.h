@@ -56,6 +56,7 @@ typedef enum savepoint_type
 extern int tm_Tran_index;
 extern TRAN_ISOLATION tm_Tran_isolation;
 extern bool tm_Tran_async_ws;
+extern bool tm_Tran_read_only;
 extern int tm_Tran_wait_msecs;
 extern int tm_Tran_ID;
 extern bool tm_Tran_check_interrupt;
@@ -68,6 +69,8 @@ extern void tran_cache_tran_settings (int tran_index, int lock_timeout, TRAN_ISO
 extern void tran_get_tran_settings (int *lock_timeout_in_msecs, TRAN_ISOLATION * tran_isolation, bool * async_ws);
 extern int tran_reset_wait_times (int wait_in_msecs);
 extern int tran_reset_isolation (TRAN_ISOLATION isolation, bool async_ws);
+extern int tran_reset_read_only (bool read_only);
+extern bool tran_is_read_only (void);
 extern int tran_flush_to_commit (void);
 extern int tran_commit (bool retain_lock);
 extern int tran_abort (void);
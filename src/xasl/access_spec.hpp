@@ -52,6 +52,13 @@ typedef enum			/* range search option */
   NEQ_NA			/* key != v1 */
 } RANGE;
 
+typedef enum			/* how the OID sets of a bitmap index scan are combined */
+{
+  BITMAP_OP_NONE,		/* plain index scan */
+  BITMAP_OP_AND,		/* intersect the OID sets of all chained indexes */
+  BITMAP_OP_OR			/* unite the OID sets of all chained indexes */
+} BITMAP_OP;
+
 typedef struct key_val_range KEY_VAL_RANGE;
 struct key_val_range
 {
@@ -99,6 +106,8 @@ struct indx_info
   int func_idx_col_id;		/* function expression column position, if the index is a function index */
   KEY_RANGE iss_range;		/* placeholder range used for ISS; must be created on the broker */
   int ils_prefix_len;		/* index loose scan prefix length */
+  int bitmap_op;		/* BITMAP_OP; combine with the OID sets of bitmap_next */
+  indx_info *bitmap_next;	/* next index of a bitmap index scan */
 };				/* index information structure */
 
 // TODO - move access specification code here; note - this is supposed to be common to both client and server.
@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+/*
+ * test_heap_free_space_map.cpp - unit tests of the free space map of heap files
+ *
+ *  The map is tested through its interface: free space categories, the search for pages with enough space across
+ *  sectors, continued searches, removed pages and the bookkeeping of the walks of the heap chain.
+ */
+
+#include "test_heap_free_space_map.hpp"
+
+#include "heap_free_space_map.hpp"
+
+#include <iostream>
+#include <vector>
+
+namespace test_heap_free_space_map
+{
+  static const VOLID TEST_VOLID = 0;
+
+  static int
+  check (bool condition, const char *what)
+  {
+    if (!condition)
+      {
+	std::cout << "  failed: " << what << std::endl;
+	return 1;
+      }
+    return 0;
+  }
+
+  static HFID
+  make_hfid (int fileid)
+  {
+    HFID hfid;
+
+    hfid.vfid.volid = TEST_VOLID;
+    hfid.vfid.fileid = fileid;
+    hfid.hpgid = 0;
+    return hfid;
+  }
+
+  static VPID
+  make_vpid (int sector, int page)
+  {
+    VPID vpid;
+
+    vpid.volid = TEST_VOLID;
+    vpid.pageid = sector * DISK_SECTOR_NPAGES + page;
+    return vpid;
+  }
+
+  static int
+  category_unit ()
+  {
+    return DB_PAGESIZE / 16;
+  }
+
+  static void
+  set_free_space (const HFID &hfid, VPID vpid, int free_space)
+  {
+    heap_fsm_set_free_space (&hfid, &vpid, free_space);
+  }
+
+  static void
+  remove_page (const HFID &hfid, VPID vpid)
+  {
+    heap_fsm_remove_page (&hfid, &vpid);
+  }
+
+  static bool
+  is_vpid (const VPID &vpid, VPID expected_vpid)
+  {
+    return VPID_EQ (&vpid, &expected_vpid);
+  }
+
+  // search from the start of the map
+  static bool
+  find_first (const HFID &hfid, int needed_space, VPID &vpid)
+  {
+    VPID_SET_NULL (&vpid);
+    return heap_fsm_find_page (&hfid, needed_space, &vpid);
+  }
+
+  static int
+  test_categories ()
+  {
+    HFID hfid = make_hfid (1);
+    VPID vpid;
+    int err = 0;
+
+    std::cout << " test categories" << std::endl;
+
+    // a page with less than one unit free is never suggested
+    set_free_space (hfid, make_vpid (1, 0), category_unit () - 1);
+    err |= check (!find_first (hfid, 1, vpid), "page with less than a unit free is suggested");
+
+    // a page is suggested only if its category guarantees the needed space
+    set_free_space (hfid, make_vpid (1, 1), 3 * category_unit () - 1);
+    err |= check (find_first (hfid, 2 * category_unit (), vpid) && is_vpid (vpid, make_vpid (1, 1)),
+		  "page of category 2 is not suggested for two units");
+    err |= check (!find_first (hfid, 2 * category_unit () + 1, vpid), "page of category 2 is suggested for more");
+
+    // the highest category covers all needs above it
+    set_free_space (hfid, make_vpid (1, 2), DB_PAGESIZE);
+    err |= check (find_first (hfid, DB_PAGESIZE, vpid) && is_vpid (vpid, make_vpid (1, 2)),
+		  "empty page is not suggested for the largest need");
+
+    // updating the free space of a page replaces its category
+    set_free_space (hfid, make_vpid (1, 2), 0);
+    err |= check (!find_first (hfid, 3 * category_unit (), vpid), "full page is still suggested");
+
+    heap_fsm_remove (&hfid);
+    return err;
+  }
+
+  static int
+  test_search ()
+  {
+    const int SECTOR_COUNT = 300;
+    HFID hfid = make_hfid (2);
+    VPID vpid;
+    std::vector<VPID> expected;
+    int err = 0;
+
+    std::cout << " test search" << std::endl;
+
+    // many sectors so the tree over sectors grows a few times; every seventh sector has two pages with space
+    for (int sector = 0; sector < SECTOR_COUNT; sector++)
+      {
+	for (int page = 0; page < DISK_SECTOR_NPAGES; page++)
+	  {
+	    bool has_space = sector % 7 == 0 && (page == 3 || page == DISK_SECTOR_NPAGES - 1);
+
+	    set_free_space (hfid, make_vpid (sector, page), has_space ? DB_PAGESIZE / 2 : category_unit ());
+	    if (has_space)
+	      {
+		expected.push_back (make_vpid (sector, page));
+	      }
+	  }
+      }
+
+    // continued searches return all pages with space, in order, and then nothing
+    VPID_SET_NULL (&vpid);
+    for (const VPID &expected_vpid : expected)
+      {
+	if (check (heap_fsm_find_page (&hfid, DB_PAGESIZE / 4, &vpid) && is_vpid (vpid, expected_vpid),
+		   "continued search missed a page") != 0)
+	  {
+	    err = 1;
+	    break;
+	  }
+      }
+    err |= check (!heap_fsm_find_page (&hfid, DB_PAGESIZE / 4, &vpid), "continued search found too many pages");
+
+    // pages filled up are no longer suggested, the next ones are
+    set_free_space (hfid, expected[0], 0);
+    set_free_space (hfid, expected[1], 0);
+    err |= check (find_first (hfid, DB_PAGESIZE / 4, vpid) && is_vpid (vpid, expected[2]),
+		  "search after pages were filled did not find the next page");
+
+    // the last page with space of the map
+    for (std::size_t i = 2; i + 1 < expected.size (); i++)
+      {
+	remove_page (hfid, expected[i]);
+      }
+    err |= check (find_first (hfid, DB_PAGESIZE / 4, vpid) && is_vpid (vpid, expected.back ()),
+		  "search did not find the last page");
+
+    heap_fsm_remove (&hfid);
+    err |= check (!find_first (hfid, 1, vpid), "removed map still suggests pages");
+    return err;
+  }
+
+  static int
+  test_search_next_sector ()
+  {
+    HFID hfid = make_hfid (3);
+    VPID vpid;
+    int err = 0;
+
+    std::cout << " test search continued in the next sector" << std::endl;
+
+    // the search continues after a page whose sector has no other page with the needed space; the next sector with
+    // space must be searched from its first page
+    set_free_space (hfid, make_vpid (10, 20), category_unit ());
+    set_free_space (hfid, make_vpid (11, 2), DB_PAGESIZE);
+    set_free_space (hfid, make_vpid (12, 40), DB_PAGESIZE);
+
+    vpid = make_vpid (10, 20);
+    err |= check (heap_fsm_find_page (&hfid, DB_PAGESIZE / 2, &vpid) && is_vpid (vpid, make_vpid (11, 2)),
+		  "page before the start offset of the next sector was skipped");
+    err |= check (heap_fsm_find_page (&hfid, DB_PAGESIZE / 2, &vpid) && is_vpid (vpid, make_vpid (12, 40)),
+		  "search did not continue to the following sector");
+
+    heap_fsm_remove (&hfid);
+    return err;
+  }
+
+  static int
+  test_walk ()
+  {
+    HFID hfid = make_hfid (4);
+    VPID vpid;
+    int walk_count = 0;
+    int err = 0;
+
+    std::cout << " test walk" << std::endl;
+
+    err |= check (!heap_fsm_is_complete (&hfid), "new map is complete");
+    heap_fsm_get_walk_position (&hfid, &vpid);
+    err |= check (VPID_ISNULL (&vpid), "new map does not walk from the header page");
+
+    // walks are spread over failed searches, more often while the map is incomplete
+    for (int i = 0; i < 64; i++)
+      {
+	if (heap_fsm_need_walk (&hfid))
+	  {
+	    walk_count++;
+	    vpid = make_vpid (5, 0);
+	    heap_fsm_set_walk_position (&hfid, &vpid);
+	  }
+      }
+    err |= check (walk_count > 1 && walk_count < 64, "walks of an incomplete map are not spread");
+
+    // a walk position that is deallocated restarts the walk from the header page
+    remove_page (hfid, make_vpid (5, 0));
+    heap_fsm_get_walk_position (&hfid, &vpid);
+    err |= check (VPID_ISNULL (&vpid), "walk position was not reset by the removal of its page");
+
+    // reaching the end of the chain completes the map; refreshes are rarer
+    VPID_SET_NULL (&vpid);
+    heap_fsm_set_walk_position (&hfid, &vpid);
+    err |= check (heap_fsm_is_complete (&hfid), "map walked to the end of chain is not complete");
+
+    int refresh_count = 0;
+    for (int i = 0; i < 64; i++)
+      {
+	if (heap_fsm_need_walk (&hfid))
+	  {
+	    refresh_count++;
+	    heap_fsm_set_walk_position (&hfid, &vpid);
+	  }
+      }
+    err |= check (refresh_count < walk_count, "complete map is refreshed as often as it is built");
+
+    heap_fsm_remove (&hfid);
+    return err;
+  }
+
+  int
+  test_heap_free_space_map ()
+  {
+    int err = 0;
+
+    std::cout << "test heap free space map" << std::endl;
+
+    err |= test_categories ();
+    err |= test_search ();
+    err |= test_search_next_sector ();
+    err |= test_walk ();
+
+    heap_fsm_finalize ();
+
+    std::cout << (err == 0 ? "test heap free space map passed" : "test heap free space map failed") << std::endl;
+    return err;
+  }
+} // namespace test_heap_free_space_map
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+/*
+ * test_join_filter.cpp - unit tests of the choice of merge join inputs whose scan gets a runtime join filter
+ *
+ *  A join filter drops rows of the scan before the rest of the query sees them. It must not be attached when that
+ *  changes the result of the input: grouping, analytic functions, ROWNUM, orderby_num (), LIMIT or CONNECT BY.
+ */
+
+#include "test_join_filter.hpp"
+
+#include "dbtype.h"
+#include "query_executor.h"
+#include "xasl.h"
+#include "xasl_analytic.hpp"
+#include "xasl_predicate.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace test_join_filter
+{
+  static int
+  check (bool condition, const char *what)
+  {
+    if (!condition)
+      {
+	std::cout << "  failed: " << what << std::endl;
+	return 1;
+      }
+    return 0;
+  }
+
+  // XASL nodes are unpacked into zeroed memory; some have union members that cannot be default constructed
+  class node_pool
+  {
+    public:
+      ~node_pool ()
+      {
+	for (void *node : m_nodes)
+	  {
+	    free (node);
+	  }
+      }
+
+      template <typename T>
+      T *
+      alloc ()
+      {
+	void *node = calloc (1, sizeof (T));
+	m_nodes.push_back (node);
+	return static_cast<T *> (node);
+      }
+
+    private:
+      std::vector<void *> m_nodes;
+  };
+
+  // build list input scanning one class through the heap: SELECT a, b FROM t
+  static XASL_NODE *
+  make_probe_input (node_pool &pool)
+  {
+    XASL_NODE *xasl = pool.alloc<XASL_NODE> ();
+    ACCESS_SPEC_TYPE *spec = pool.alloc<ACCESS_SPEC_TYPE> ();
+
+    spec->type = TARGET_CLASS;
+    spec->access = ACCESS_METHOD_SEQUENTIAL;
+    spec->pruning_type = DB_NOT_PARTITIONED_CLASS;
+
+    xasl->type = BUILDLIST_PROC;
+    xasl->spec_list = spec;
+    xasl->outptr_list = pool.alloc<OUTPTR_LIST> ();
+    return xasl;
+  }
+
+  static int
+  test_plain_scan ()
+  {
+    node_pool pool;
+    XASL_NODE *heap_input = make_probe_input (pool);
+    XASL_NODE *index_input = make_probe_input (pool);
+    int err = 0;
+
+    err |= check (qexec_can_filter_join_probe (heap_input), "heap scan input is filtered");
+
+    index_input->spec_list->access = ACCESS_METHOD_INDEX;
+    err |= check (qexec_can_filter_join_probe (index_input), "index scan input is filtered");
+
+    return err;
+  }
+
+  static int
+  test_not_a_class_scan ()
+  {
+    node_pool pool;
+    XASL_NODE *partitioned = make_probe_input (pool);
+    XASL_NODE *two_specs = make_probe_input (pool);
+    XASL_NODE *list_scan = make_probe_input (pool);
+    int err = 0;
+
+    partitioned->spec_list->pruning_type = DB_PARTITIONED_CLASS;
+    err |= check (!qexec_can_filter_join_probe (partitioned), "partitioned class is not filtered");
+
+    two_specs->spec_list->next = pool.alloc<ACCESS_SPEC_TYPE> ();
+    err |= check (!qexec_can_filter_join_probe (two_specs), "input of two classes is not filtered");
+
+    list_scan->spec_list->type = TARGET_LIST;
+    err |= check (!qexec_can_filter_join_probe (list_scan), "list file scan is not filtered");
+
+    return err;
+  }
+
+  // SELECT a, COUNT (*) FROM t GROUP BY a
+  static int
+  test_group_by ()
+  {
+    node_pool pool;
+    XASL_NODE *input = make_probe_input (pool);
+
+    input->proc.buildlist.groupby_list = pool.alloc<SORT_LIST> ();
+    return check (!qexec_can_filter_join_probe (input), "GROUP BY input is not filtered");
+  }
+
+  // SELECT a, RANK () OVER (ORDER BY b) FROM t
+  static int
+  test_analytic ()
+  {
+    node_pool pool;
+    XASL_NODE *input = make_probe_input (pool);
+
+    input->proc.buildlist.a_eval_list = pool.alloc<ANALYTIC_EVAL_TYPE> ();
+    return check (!qexec_can_filter_join_probe (input), "analytic input is not filtered");
+  }
+
+  // SELECT a, b FROM t WHERE ROWNUM <= 10 and SELECT ROWNUM, a FROM t
+  static int
+  test_rownum ()
+  {
+    node_pool pool;
+    XASL_NODE *rownum_pred = make_probe_input (pool);
+    XASL_NODE *rownum_value = make_probe_input (pool);
+    int err = 0;
+
+    rownum_pred->instnum_pred = pool.alloc<PRED_EXPR> ();
+    err |= check (!qexec_can_filter_join_probe (rownum_pred), "ROWNUM predicate input is not filtered");
+
+    rownum_value->instnum_val = pool.alloc<DB_VALUE> ();
+    db_make_null (rownum_value->instnum_val);
+    err |= check (!qexec_can_filter_join_probe (rownum_value), "ROWNUM value input is not filtered");
+
+    return err;
+  }
+
+  // SELECT a, b FROM t ORDER BY b FOR ORDERBY_NUM () <= 10 and SELECT a, b FROM t LIMIT 10
+  static int
+  test_orderby_num_and_limit ()
+  {
+    node_pool pool;
+    XASL_NODE *orderby_num = make_probe_input (pool);
+    XASL_NODE *limit = make_probe_input (pool);
+    int err = 0;
+
+    orderby_num->ordbynum_pred = pool.alloc<PRED_EXPR> ();
+    err |= check (!qexec_can_filter_join_probe (orderby_num), "ORDERBY_NUM input is not filtered");
+
+    limit->limit_row_count = pool.alloc<REGU_VARIABLE> ();
+    err |= check (!qexec_can_filter_join_probe (limit), "LIMIT input is not filtered");
+
+    return err;
+  }
+
+  int
+  test_join_filter ()
+  {
+    int err = 0;
+
+    err |= test_plain_scan ();
+    err |= test_not_a_class_scan ();
+    err |= test_group_by ();
+    err |= test_analytic ();
+    err |= test_rownum ();
+    err |= test_orderby_num_and_limit ();
+
+    if (err == 0)
+      {
+	std::cout << "  join filter tests passed" << std::endl;
+      }
+    return err;
+  }
+} // namespace test_join_filter
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2008 Search Solution Corporation. All rights reserved by Search Solution.
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ */
+
+/*
+ * test_lock_wait.cpp - microbenchmark of lock waits: spin-then-park compared to park only
+ *
+ *  Threads contend on one resource with a FIFO queue of waiters, like the waiter list of a lock resource. A thread
+ *  that finds the resource held queues its thread entry and waits with lock_wait_spinner; the holder hands the
+ *  resource off directly to the first waiter and resumes it.
+ */
+
+#include "test_lock_wait.hpp"
+
+#include "test_perf_compare.hpp"
+#include "test_string_collection.hpp"
+#include "test_timers.hpp"
+
+#include "lock_wait.hpp"
+#include "thread_entry.hpp"
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace test_lock_wait
+{
+  static const int WAIT_SUSPENDED = 1;
+  static const int WAIT_RESUMED = 2;
+
+  static const int SPIN_USECS = 40;		// default of lock_wait_spin_usecs
+  static const size_t OP_COUNT = 20000;		// lock/unlock operations of each thread
+  static const size_t HOLD_WORK = 200;		// work while holding the resource
+  static const size_t THINK_WORK = 400;		// work between two requests
+
+  // resource with a FIFO queue of waiting threads and direct handoff to the first waiter
+  class test_resource
+  {
+    public:
+      test_resource ()
+	: m_mutex ()
+	, m_held (false)
+	, m_waiters ()
+	, m_parked_count { 0 }
+      {
+      }
+
+      void
+      lock (cubthread::entry &thread_ref, lock_wait_spinner &spinner, int max_spin_usecs)
+      {
+	std::unique_lock<std::mutex> ulock (m_mutex);
+
+	if (!m_held)
+	  {
+	    m_held = true;
+	    return;
+	  }
+
+	// register the wait holding the thread entry mutex, before the holder can see it
+	thread_lock_entry (&thread_ref);
+	thread_ref.lockwait = this;
+	thread_ref.lockwait_state = WAIT_SUSPENDED;
+	m_waiters.push_back (&thread_ref);
+	ulock.unlock ();
+
+	if (spinner.wait (thread_ref, WAIT_SUSPENDED, max_spin_usecs))
+	  {
+	    ++m_parked_count;
+	  }
+	// the resource was handed off; m_held is still true
+      }
+
+      void
+      unlock ()
+      {
+	std::lock_guard<std::mutex> lg (m_mutex);
+	cubthread::entry *next;
+
+	if (m_waiters.empty ())
+	  {
+	    m_held = false;
+	    return;
+	  }
+
+	next = m_waiters.front ();
+	m_waiters.pop_front ();
+
+	thread_lock_entry (next);
+	lock_wait_spinner::resume (*next, WAIT_RESUMED);
+      }
+
+      size_t
+      get_parked_count () const
+      {
+	return m_parked_count;
+      }
+
+    private:
+      std::mutex m_mutex;
+      bool m_held;
+      std::deque<cubthread::entry *> m_waiters;
+      std::atomic<size_t> m_parked_count;
+  };
+
+  static void
+  busy_work (size_t count)
+  {
+    volatile size_t dummy = 0;
+
+    for (size_t i = 0; i < count; i++)
+      {
+	dummy = dummy + i;
+      }
+  }
+
+  static void
+  contend (test_resource &resource, lock_wait_spinner &spinner, int max_spin_usecs, std::atomic<int> &inside,
+	   std::atomic<bool> &failed)
+  {
+    cubthread::entry thread_ref;
+
+    // lock waits expect a running thread
+    thread_ref.m_status = cubthread::entry::status::TS_RUN;
+
+    for (size_t op = 0; op < OP_COUNT; op++)
+      {
+	resource.lock (thread_ref, spinner, max_spin_usecs);
+	if (thread_ref.lockwait != NULL && thread_ref.lockwait_state == WAIT_SUSPENDED)
+	  {
+	    // wait returned without a resume
+	    failed = true;
+	  }
+	if (++inside != 1)
+	  {
+	    // two owners at once
+	    failed = true;
+	  }
+	busy_work (HOLD_WORK);
+	--inside;
+	resource.unlock ();
+
+	busy_work (THINK_WORK);
+      }
+  }
+
+  static int
+  run_scenario (test_common::perf_compare &compare, size_t scenario_index, int max_spin_usecs,
+		const std::vector<size_t> &thread_counts)
+  {
+    int err = 0;
+
+    for (size_t step = 0; step < thread_counts.size (); step++)
+      {
+	test_resource resource;
+	lock_wait_spinner spinner;
+	std::atomic<int> inside { 0 };
+	std::atomic<bool> failed { false };
+	std::vector<std::thread> threads;
+	test_common::us_timer timer;
+
+	for (size_t i = 0; i < thread_counts[step]; i++)
+	  {
+	    threads.emplace_back (contend, std::ref (resource), std::ref (spinner), max_spin_usecs, std::ref (inside),
+				  std::ref (failed));
+	  }
+	for (auto &th : threads)
+	  {
+	    th.join ();
+	  }
+	compare.register_time (timer, scenario_index, step);
+
+	std::cout << "    max spin = " << max_spin_usecs << " usecs, " << thread_counts[step] << " threads: "
+		  << resource.get_parked_count () << " of " << OP_COUNT * thread_counts[step] << " requests parked"
+		  << ", final spin = " << spinner.get_spin_usecs () << " usecs" << std::endl;
+	if (failed)
+	  {
+	    std::cout << "    error: the resource was not handed off correctly" << std::endl;
+	    err = 1;
+	  }
+      }
+
+    return err;
+  }
+
+  int
+  test_lock_wait_performance ()
+  {
+    std::vector<size_t> thread_counts = { 2, 4, 8, 16 };
+    test_common::string_collection scenario_names ("Spin-then-park", "Park");
+    test_common::string_collection step_names ("2 threads", "4 threads", "8 threads", "16 threads");
+    test_common::perf_compare compare (scenario_names, step_names);
+    int err = 0;
+
+    std::cout << std::endl << "  start lock wait performance test" << std::endl;
+
+    err = err | run_scenario (compare, 0, SPIN_USECS, thread_counts);
+    err = err | run_scenario (compare, 1, 0, thread_counts);
+
+    std::cout << std::endl;
+    compare.print_results_and_warnings (std::cout);
+
+    return err;
+  }
+} // namespace test_lock_wait